@@ -369,6 +369,8 @@ namespace PluginHost {
                 , HardKillCheckWaitTime(4)
                 , IPV6(false)
                 , LegacyInitialize(false)
+                , WorkStealing(false)
+                , Reactors(1)
                 , DefaultMessagingCategories(false)
                 , Process()
                 , Input()
@@ -407,6 +409,8 @@ namespace PluginHost {
                 Add(_T("hardkillcheckwaittime"), &HardKillCheckWaitTime);
                 Add(_T("ipv6"), &IPV6);
                 Add(_T("legacyinitialize"), &LegacyInitialize);
+                Add(_T("workstealing"), &WorkStealing);
+                Add(_T("reactors"), &Reactors);
                 Add(_T("messaging"), &DefaultMessagingCategories);
                 Add(_T("redirect"), &Redirect);
                 Add(_T("process"), &Process);
@@ -452,6 +456,8 @@ namespace PluginHost {
             Core::JSON::DecUInt8 HardKillCheckWaitTime;
             Core::JSON::Boolean IPV6;
             Core::JSON::Boolean LegacyInitialize;
+            Core::JSON::Boolean WorkStealing;
+            Core::JSON::DecUInt8 Reactors;
             Core::JSON::String DefaultMessagingCategories; 
             ProcessSet Process;
             InputConfig Input;
@@ -613,6 +619,8 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
             , _portNumber(0)
             , _IPV6()
             , _legacyInitialize(false)
+            , _workStealing(false)
+            , _reactors(1)
             , _idleTime(180)
             , _softKillCheckWaitTime(3)
             , _hardKillCheckWaitTime(10)
@@ -666,6 +674,8 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 _hardKillCheckWaitTime = config.HardKillCheckWaitTime.Value();
                 _IPV6 = config.IPV6.Value();
                 _legacyInitialize = config.LegacyInitialize.Value();
+                _workStealing = config.WorkStealing.Value();
+                _reactors = (config.Reactors.Value() == 0 ? 1 : (config.Reactors.Value() > Core::ResourceMonitor::MaxReactors ? Core::ResourceMonitor::MaxReactors : config.Reactors.Value()));
                 _binding = config.Binding.Value();
                 _interface = config.Interface.Value();
                 _portNumber = config.Port.Value();
@@ -890,6 +900,12 @@ POP_WARNING()
         inline bool LegacyInitialize() const {
             return (_legacyInitialize);
         }
+        inline bool WorkStealing() const {
+            return (_workStealing);
+        }
+        inline uint8_t Reactors() const {
+            return (_reactors);
+        }
 
         const Plugin::Config* Plugin(const string& name) const {
             Core::JSON::ArrayType<Plugin::Config>::ConstIterator index(_plugins.Elements());
@@ -1044,6 +1060,8 @@ POP_WARNING()
         uint16_t _portNumber;
         bool _IPV6;
         bool _legacyInitialize;
+        bool _workStealing;
+        uint8_t _reactors;
         uint16_t _idleTime;
         uint8_t _softKillCheckWaitTime;
         uint8_t _hardKillCheckWaitTime;
@@ -458,10 +458,18 @@ namespace Plugin {
                 result->Body(Core::ProxyType<Web::IBody>(response));
             }
         } else if (index.Current() == _T ("Monitor")) {
-            Core::NumberType<uint8_t> threadIndex(index.Current());
-            Core::ProxyType<Web::JSONBodyType<Core::JSON::ArrayType<PluginHost::CallstackData>>> response = jsonBodyCallstackFactory.Element();
-            Callstack(Core::ResourceMonitor::Instance().Id(), *response);
-            result->Body(Core::ProxyType<Web::IBody>(response));
+            // Optionally followed by the index of the reactor, the first one by default.
+            Core::NumberType<uint8_t> threadIndex(index.Next() == true ? index.Current() : Core::TextFragment(_T("0")));
+
+            if (threadIndex.Value() >= Core::ResourceMonitor::Instance().Reactors()) {
+                result->ErrorCode = Web::STATUS_BAD_REQUEST;
+                result->Message = _T("There is no monitor with this index!");
+            }
+            else {
+                Core::ProxyType<Web::JSONBodyType<Core::JSON::ArrayType<PluginHost::CallstackData>>> response = jsonBodyCallstackFactory.Element();
+                Callstack(Core::ResourceMonitor::Instance().Id(threadIndex.Value()), *response);
+                result->Body(Core::ProxyType<Web::IBody>(response));
+            }
         } else if (index.Current() == _T("Discovery")) {
 
             if (_probe == nullptr) {
@@ -1168,6 +1176,22 @@ ASSERT(_service != nullptr);
         return Core::ERROR_NONE;
     }
 
+    Core::hresult Controller::Locks(string& response) const
+    {
+        Core::JSON::ArrayType<PluginHost::MetaData::Lock> jsonResponse;
+        std::list<Core::CriticalSection::Metadata> locks;
+
+        Core::CriticalSection::Snapshot(locks);
+
+        for (const Core::CriticalSection::Metadata& lock : locks) {
+            jsonResponse.Add() = lock;
+        }
+
+        jsonResponse.ToString(response);
+
+        return Core::ERROR_NONE;
+    }
+
     void Controller::StateChange(const string& callsign, const PluginHost::IShell::state& state, const PluginHost::IShell::reason& reason)
     {
         Exchange::IController::JLifeTime::Event::StateChange(*this, callsign, state, reason);
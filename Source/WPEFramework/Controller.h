@@ -350,6 +350,7 @@ namespace Plugin {
         Core::hresult ProcessInfo(string& response) const override;
         Core::hresult Subsystems(string& response) const override;
         Core::hresult Version(string& response) const override;
+        Core::hresult Locks(string& response) const override;
 
         void StateChange(const string& callsign, const PluginHost::IShell::state& state, const PluginHost::IShell::reason& reason) override;
 
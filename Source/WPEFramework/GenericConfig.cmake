@@ -33,6 +33,8 @@ set(POSTMORTEM_PATH "/opt/minidumps" CACHE STRING "Core file path to do the post
 set(CONFIG_INSTALL_PATH "/etc/${NAMESPACE}" CACHE STRING "Install location of the configuration")
 set(IPV6_SUPPORT false CACHE STRING "Controls if should application supports ipv6")
 set(LEGACY_INITIALZE false CACHE STRING "Enables legacy Plugin Initialize behaviour (Deinit not called on failed Init)")
+set(WORK_STEALING false CACHE STRING "Let the workerpool threads use local queues and steal work from each other")
+set(REACTORS 1 CACHE STRING "Number of ResourceMonitor threads the sockets are spread over")
 set(PRIORITY 0 CACHE STRING "Change the nice level [-20 - 20]")
 set(POLICY "OTHER" CACHE STRING "NA")
 set(OOMADJUST 0 CACHE STRING "Adapt the OOM score [-15 - 15]")
@@ -70,6 +72,12 @@ map_set(${CONFIG} ipv6 ${IPV6_SUPPORT})
 if(LEGACY_INITIALZE)
     map_set(${CONFIG} legacyinitialize true)
 endif()
+if(WORK_STEALING)
+    map_set(${CONFIG} workstealing true)
+endif()
+if(REACTORS GREATER 1)
+    map_set(${CONFIG} reactors ${REACTORS})
+endif()
 map_set(${CONFIG} idletime ${IDLE_TIME})
 map_set(${CONFIG} softkillcheckwaittime ${SOFT_KILL_CHECK_WAIT_TIME})
 map_set(${CONFIG} hardkillcheckwaittime ${HARD_KILL_CHECK_WAIT_TIME})
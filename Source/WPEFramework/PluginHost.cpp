@@ -540,6 +540,10 @@ POP_WARNING()
                     Core::Thread::DefaultStackSize(_config->StackSize()); 
                 }
 
+                if (_config->Reactors() > 1) {
+                    Core::ResourceMonitor::Instance().Reactors(_config->Reactors());
+                }
+
 #ifndef __WINDOWS__
                 if (_config->Process().UMask().IsSet() == true) {
                     ::umask(_config->Process().UMask().Value());
@@ -900,6 +904,9 @@ POP_WARNING()
                         printf("============================================================\n");
                         Core::ResourceMonitor& monitor = Core::ResourceMonitor::Instance();
                         printf("Currently monitoring: %d resources\n", monitor.Count());
+                        for (uint8_t reactor = 0; reactor < monitor.Reactors(); reactor++) {
+                            printf("Reactor [%d]: %d resources, %d runs\n", reactor, monitor.Count(reactor), monitor.Runs(reactor));
+                        }
                         uint32_t index = 0;
                         Core::ResourceMonitor::Metadata info;
 
@@ -907,6 +914,7 @@ POP_WARNING()
                         info.descriptor = ~0;
                         info.events = 0;
                         info.monitor = 0;
+                        info.reactor = 0;
 
                         while (monitor.Info(index, info) == true) {
 #ifdef __WINDOWS__
@@ -935,7 +943,7 @@ POP_WARNING()
                             flags[7] = '\0';
 #endif
                       
-                            printf ("%6d %s[%s]: %s\n", info.descriptor, info.filename, flags, Core::ClassNameOnly(info.classname).Text().c_str());
+                            printf ("%6d %s[%s]: %s <%d>\n", info.descriptor, info.filename, flags, Core::ClassNameOnly(info.classname).Text().c_str(), info.reactor);
                             index++;
                         }
                         break;
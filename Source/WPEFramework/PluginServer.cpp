@@ -226,6 +226,13 @@ namespace PluginHost
                 newInfo.Name = name;
             }
 
+            Web::WebSocket::Deflate::Metadata compression;
+
+            if ((client->Compression(compression) == true) && (compression.Plain != 0)) {
+                newInfo.Compression = static_cast<uint8_t>(std::min(static_cast<uint64_t>(100), (compression.Deflated * 100) / compression.Plain));
+                newInfo.CompressionTime = compression.Deflating + compression.Inflating;
+            }
+
             metaData.Add(newInfo);
         }
     }
@@ -253,6 +260,8 @@ namespace PluginHost
             index = _services.erase(index);
         }
 
+        Publish();
+
         _adminLock.Unlock();
 
         TRACE_L1("Destructing %d plugins.", static_cast<uint32_t>(_services.size()));
@@ -936,7 +945,7 @@ namespace PluginHost
 PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
 
     Server::Server(Config& configuration, const bool background)
-        : _dispatcher(configuration.StackSize())
+        : _dispatcher(configuration.StackSize(), configuration.WorkStealing())
         , _connections(*this, configuration.Binder(), configuration.IdleTime())
         , _config(configuration)
         , _services(*this)
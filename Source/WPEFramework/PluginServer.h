@@ -122,8 +122,8 @@ namespace PluginHost {
             WorkerPoolImplementation(const WorkerPoolImplementation&) = delete;
             WorkerPoolImplementation& operator=(const WorkerPoolImplementation&) = delete;
 
-            WorkerPoolImplementation(const uint32_t stackSize)
-                : Core::WorkerPool(THREADPOOL_COUNT, stackSize, 16, &_dispatch, this)
+            WorkerPoolImplementation(const uint32_t stackSize, const bool workStealing)
+                : Core::WorkerPool(THREADPOOL_COUNT, stackSize, 16, &_dispatch, this, (workStealing == true ? Core::ThreadPool::STEALING : Core::ThreadPool::QUEUED))
                 , _dispatch()
             {
                 Run();
@@ -1201,7 +1201,7 @@ namespace PluginHost {
             Service(const PluginHost::Config& server, const Plugin::Config& plugin, ServiceMap& administrator, const mode type, const Core::ProxyType<RPC::InvokeServer>& handler)
                 : PluginHost::Service(plugin, server.WebPrefix(), server.PersistentPath(), server.DataPath(), server.VolatilePath())
                 , _mode(type)
-                , _pluginHandling()
+                , _pluginHandling(_T("PluginHost::Service"))
                 , _handler(nullptr)
                 , _extended(nullptr)
                 , _webRequest(nullptr)
@@ -1384,7 +1384,7 @@ namespace PluginHost {
                     result = _unavailableHandler;
                 } else if (IsWebServerRequest(request.Path) == true) {
                     result = IFactories::Instance().Response();
-                    FileToServe(request.Path, *result, false);
+                    FileToServe(request, *result, false);
                 } else if (request.Verb == Web::Request::HTTP_OPTIONS) {
 
                     result = IFactories::Instance().Response();
@@ -1466,6 +1466,10 @@ namespace PluginHost {
                     Core::InterlockedIncrement(_activity);
                     uint32_t result;
                     string method(message.Designator.Value());
+                    string buffer;
+
+                    // The parameters are handed on as they were received, they are not copied for every use.
+                    const string& parameters(message.Parameters.Value(buffer));
 
                     if (message.Id.IsSet() == true) {
                         response = Core::ProxyType<Core::JSONRPC::Message>(IFactories::Instance().JSONRPC());
@@ -1482,7 +1486,7 @@ namespace PluginHost {
                         response->Error.SetError(Core::ERROR_PARSE_FAILURE);
                         response->Error.Text = _T("Parsing of the method failed");
                     }
-                    else if ((result = _jsonrpc->Validate(token, method, message.Parameters.Value())) == Core::ERROR_PRIVILIGED_REQUEST) {
+                    else if ((result = _jsonrpc->Validate(token, method, parameters)) == Core::ERROR_PRIVILIGED_REQUEST) {
                         if (response.IsValid() == true) {
                             response->Error.SetError(Core::ERROR_PRIVILIGED_REQUEST);
                             response->Error.Text = _T("method invokation not allowed.");
@@ -1502,7 +1506,7 @@ namespace PluginHost {
                     }
                     else {
                         string output;
-                        result = _jsonrpc->Invoke(channelId, message.Id.Value(), token, method, message.Parameters.Value(), output);
+                        result = _jsonrpc->Invoke(channelId, message.Id.Value(), token, method, parameters, output);
 
                         if (result == Core::ERROR_PARSE_FAILURE) {
                             if (response.IsValid() == false) {
@@ -1520,7 +1524,7 @@ namespace PluginHost {
                                     response->Result.Null(true);
                                 }
                                 else {
-                                    response->Result = output;
+                                    response->Result = std::move(output);
                                 }
                                 break;
                             case Core::ERROR_INVALID_RANGE:
@@ -2857,6 +2861,81 @@ POP_WARNING()
                 string _observerPath;
             };
 
+            // An immutable copy of the services, hashed on callsign, for FromIdentifier. Whenever a service is added
+            // or removed, a new one is built and swapped in, so a lookup takes no lock and copies no entries. The
+            // copy it replaces, and the services only it still refers to, are released once its readers are done.
+            class Routes {
+            private:
+                struct Entry {
+                    uint32_t Hash;
+                    string Callsign;
+                    Core::ProxyType<Service> Target;
+                };
+
+            public:
+                Routes() = delete;
+                Routes(const Routes&) = delete;
+                Routes& operator=(const Routes&) = delete;
+
+                Routes(const ServiceContainer& services)
+                    : _entries()
+                    , _mask(0)
+                {
+                    // Keep at least half of the slots empty, so a probe always ends.
+                    uint32_t size = 8;
+                    while (size < (services.size() * 2)) {
+                        size <<= 1;
+                    }
+
+                    _entries.resize(size);
+                    _mask = size - 1;
+
+                    for (const std::pair<const string, Core::ProxyType<Service>>& service : services) {
+                        const uint32_t hash = Hash(service.first.c_str(), static_cast<uint32_t>(service.first.length()));
+                        uint32_t slot = (hash & _mask);
+
+                        while (_entries[slot].Target.IsValid() == true) {
+                            slot = ((slot + 1) & _mask);
+                        }
+
+                        _entries[slot].Hash = hash;
+                        _entries[slot].Callsign = service.first;
+                        _entries[slot].Target = service.second;
+                    }
+                }
+                ~Routes() = default;
+
+            public:
+                const Core::ProxyType<Service>* Find(const TCHAR callsign[], const uint32_t length) const
+                {
+                    const uint32_t hash = Hash(callsign, length);
+                    uint32_t slot = (hash & _mask);
+
+                    while ((_entries[slot].Target.IsValid() == true) && ((_entries[slot].Hash != hash) || (_entries[slot].Callsign.length() != length) || (_entries[slot].Callsign.compare(0, length, callsign, length) != 0))) {
+                        slot = ((slot + 1) & _mask);
+                    }
+
+                    return (_entries[slot].Target.IsValid() == true ? &(_entries[slot].Target) : nullptr);
+                }
+
+            private:
+                static uint32_t Hash(const TCHAR text[], const uint32_t length)
+                {
+                    // FNV-1a
+                    uint32_t result = 2166136261u;
+
+                    for (uint32_t index = 0; index < length; index++) {
+                        result = (result ^ static_cast<uint8_t>(text[index])) * 16777619u;
+                    }
+
+                    return (result);
+                }
+
+            private:
+                std::vector<Entry> _entries;
+                uint32_t _mask;
+            };
+
         public:
             ServiceMap() = delete;
             ServiceMap(const ServiceMap&) = delete;
@@ -2865,9 +2944,10 @@ POP_WARNING()
             PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
             ServiceMap(Server& server)
                 : _server(server)
-                , _adminLock()
+                , _adminLock(_T("PluginHost::ServiceMap"))
                 , _notificationLock()
                 , _services()
+                , _routes(new Routes(_services))
                 , _notifiers()
                 , _engine(Core::ProxyType<RPC::InvokeServer>::Create(&(server._dispatcher)))
                 , _processAdministrator(
@@ -3134,6 +3214,7 @@ POP_WARNING()
 
                     // Fire up the interface. Let it handle the messages.
                     _services.insert(std::pair<const string, Core::ProxyType<Service>>(configuration.Callsign.Value(), newService));
+                    Publish();
 
                     _adminLock.Unlock();
                 }
@@ -3164,6 +3245,7 @@ POP_WARNING()
                             std::piecewise_construct,
                             std::forward_as_tuple(newConfiguration.Callsign.Value()),
                             std::forward_as_tuple(clone));
+                        Publish();
 
                         clone->Evaluate();
                         newService = Core::ProxyType<IShell>(clone);
@@ -3186,6 +3268,7 @@ POP_WARNING()
                 if (index != _services.end()) {
                     index->second->Destroy();
                     _services.erase(index);
+                    Publish();
                 }
 
                 _adminLock.Unlock();
@@ -3280,36 +3363,43 @@ POP_WARNING()
                     _adminLock.Unlock();
                 }
                 else {
-                    _adminLock.Lock();
+                    // The shortest callsign that matches wins, the remainder, if any, is the requested version.
+                    Core::ProxyType<Service> found;
+                    size_t length = callSign.find('.');
 
-                    for (auto index : _services) {
-                        const string& source(index.first);
-                        uint32_t length = static_cast<uint32_t>(source.length());
+                    {
+                        Core::SnapshotType<Routes>::Reader routes(_routes);
+                        const Core::ProxyType<Service>* entry = nullptr;
 
-                        if (callSign.compare(0, source.length(), source) == 0) {
-                            if (callSign.length() == length) {
-                                // Service found, did not requested specific version
-                                service = index.second;
-                                result = Core::ERROR_NONE;
-                                break;
-                            }
-                            else if (callSign[length] == '.') {
-                                // Requested specific version of a plugin
-                                if (index.second->HasVersionSupport(callSign.substr(length + 1)) == true) {
-                                    // Requested version of service is supported!
-                                    service = index.second;
-                                    result = Core::ERROR_NONE;
-                                }
-                                else {
-                                    // Requested version is not supported
-                                    result = Core::ERROR_INVALID_SIGNATURE;
-                                }
-                                break;
+                        while ((entry == nullptr) && (length != string::npos)) {
+                            if ((entry = routes->Find(callSign.c_str(), static_cast<uint32_t>(length))) == nullptr) {
+                                length = callSign.find('.', length + 1);
                             }
                         }
+                        if ((entry == nullptr) && ((entry = routes->Find(callSign.c_str(), static_cast<uint32_t>(callSign.length()))) != nullptr)) {
+                            length = string::npos;
+                        }
+                        if (entry != nullptr) {
+                            found = *entry;
+                        }
                     }
 
-                    _adminLock.Unlock();
+                    if (found.IsValid() == true) {
+                        if (length == string::npos) {
+                            // Service found, did not requested specific version
+                            service = found;
+                            result = Core::ERROR_NONE;
+                        }
+                        else if (found->HasVersionSupport(callSign.substr(length + 1)) == true) {
+                            // Requested version of service is supported!
+                            service = found;
+                            result = Core::ERROR_NONE;
+                        }
+                        else {
+                            // Requested version is not supported
+                            result = Core::ERROR_INVALID_SIGNATURE;
+                        }
+                    }
                 }
 
                 return (result);
@@ -3453,6 +3543,11 @@ POP_WARNING()
 
                 return (result);
             }
+            // Must be called with the _adminLock taken, after the services changed.
+            void Publish()
+            {
+                _routes.Replace(new Routes(_services));
+            }
             void RecursiveNotification(ServiceContainer::iterator& index)
             {
                 if (index != _services.end()) {
@@ -3483,6 +3578,7 @@ POP_WARNING()
             mutable Core::CriticalSection _adminLock;
             Core::CriticalSection _notificationLock;
             ServiceContainer _services;
+            Core::SnapshotType<Routes> _routes;
             mutable RemoteInstantiators _instantiators;
             Notifiers _notifiers;
             Core::ProxyType<RPC::InvokeServer> _engine;
@@ -4255,24 +4351,35 @@ POP_WARNING()
 
             // We are in an upgraded mode, we are a websocket. Time to "deserialize and serialize
             // INBOUND and OUTBOUND information.
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
             {
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 if (State() == RAW) {
-                    result = _service->Outbound(Id(), dataFrame, maxSendSize);
+                    // The plugins handle the raw data in chunks of at most 64KB.
+                    result = _service->Outbound(Id(), dataFrame, static_cast<uint16_t>(std::min(maxSendSize, static_cast<uint32_t>(0xFFFF))));
                 } else {
                     result = PluginHost::Channel::Serialize(dataFrame, maxSendSize);
                 }
 
                 return (result);
             }
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
             {
-                uint16_t result = receivedSize;
+                uint32_t result = receivedSize;
 
                 if (State() == RAW) {
-                    result = _service->Inbound(Id(), dataFrame, receivedSize);
+                    uint32_t loaded;
+                    uint16_t chunk;
+
+                    result = 0;
+
+                    do {
+                        chunk = static_cast<uint16_t>(std::min(receivedSize - result, static_cast<uint32_t>(0xFFFF)));
+                        loaded = _service->Inbound(Id(), &(dataFrame[result]), chunk);
+                        result += loaded;
+
+                    } while ((loaded == chunk) && (result < receivedSize));
                 } else {
                     result = PluginHost::Channel::Deserialize(dataFrame, receivedSize);
                 }
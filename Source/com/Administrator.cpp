@@ -24,11 +24,14 @@ namespace WPEFramework {
 namespace RPC {
 
     Administrator::Administrator()
-        : _adminLock()
+        : _adminLock(_T("RPC::Administrator"))
         , _stubs()
         , _proxy()
         , _factory(8)
         , _channelProxyMap()
+        , _channelReferenceMap()
+        , _arenaLock()
+        , _channelArenaMap()
     {
     }
 
@@ -131,17 +134,26 @@ namespace RPC {
     void Administrator::Invoke(Core::ProxyType<Core::IPCChannel>& channel, Core::ProxyType<InvokeMessage>& message)
     {
         uint32_t interfaceId(message->Parameters().InterfaceId());
+        Core::ProxyType<SharedArena> outbound;
+        Core::ProxyType<SharedArena> inbound;
+        const bool shared = Shared(channel.operator->(), outbound, inbound);
 
         // stub are loaded before any action is taken and destructed if the process closes down, so no need to lock..
         std::map<uint32_t, ProxyStub::UnknownStub*>::iterator index(_stubs.find(interfaceId));
 
-        if (index != _stubs.end()) {
+        if ((shared == true) && (message->Parameters().Resolve(inbound) == false)) {
+            TRACE_L1("Could not resolve the frame for interface. %d", interfaceId);
+        } else if (index != _stubs.end()) {
             uint32_t methodId(message->Parameters().MethodId());
             REPORT_DURATION_WARNING({ index->second->Handle(methodId, channel, message); },  WarningReporting::TooLongInvokeRPC, interfaceId, methodId);
         } else {
             // Oops this is an unknown interface, Do not think this could happen.
             TRACE_L1("Unknown interface. %d", interfaceId);
         }
+
+        if (shared == true) {
+            message->Response().Share(*outbound);
+        }
     }
 
     bool Administrator::IsValid(const Core::ProxyType<Core::IPCChannel>& channel, const Core::instance_id& impl, const uint32_t id) const
@@ -383,6 +395,49 @@ namespace RPC {
         }
 
         _adminLock.Unlock();
+
+        Unshare(channel.operator->());
+    }
+
+    void Administrator::Share(const Core::IPCChannel* channel, const Core::ProxyType<SharedArena>& outbound, const Core::ProxyType<SharedArena>& inbound)
+    {
+        ASSERT((outbound.IsValid() == true) && (inbound.IsValid() == true));
+
+        _arenaLock.Lock();
+
+        _channelArenaMap[channel] = std::make_pair(outbound, inbound);
+
+        _arenaLock.Unlock();
+    }
+
+    void Administrator::Unshare(const Core::IPCChannel* channel)
+    {
+        _arenaLock.Lock();
+
+        _channelArenaMap.erase(channel);
+
+        _arenaLock.Unlock();
+    }
+
+    bool Administrator::Shared(const Core::IPCChannel* channel, Core::ProxyType<SharedArena>& outbound, Core::ProxyType<SharedArena>& inbound) const
+    {
+        bool result = false;
+
+        _arenaLock.Lock();
+
+        if (_channelArenaMap.empty() == false) {
+            ArenaMap::const_iterator index(_channelArenaMap.find(channel));
+
+            if (index != _channelArenaMap.end()) {
+                outbound = index->second.first;
+                inbound = index->second.second;
+                result = true;
+            }
+        }
+
+        _arenaLock.Unlock();
+
+        return (result);
     }
 
     /* static */ Administrator& Job::_administrator= Administrator::Instance();
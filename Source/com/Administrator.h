@@ -96,6 +96,7 @@ namespace RPC {
 
         using ChannelMap = std::map<const Core::IPCChannel*, Proxies>;
         using ReferenceMap = std::map<const Core::IPCChannel*, std::list< RecoverySet > >;
+        using ArenaMap = std::map<const Core::IPCChannel*, std::pair< Core::ProxyType<SharedArena>, Core::ProxyType<SharedArena> > >;
 
         struct EXTERNAL IMetadata {
             virtual ~IMetadata() = default;
@@ -199,6 +200,12 @@ namespace RPC {
 
         void DeleteChannel(const Core::ProxyType<Core::IPCChannel>& channel, Proxies& pendingProxies);
 
+        // Large frames travel through shared memory on channels where both sides agreed to do so. The
+        // outbound arena is where this side puts its frames, the inbound arena is where the other side does.
+        void Share(const Core::IPCChannel* channel, const Core::ProxyType<SharedArena>& outbound, const Core::ProxyType<SharedArena>& inbound);
+        void Unshare(const Core::IPCChannel* channel);
+        bool Shared(const Core::IPCChannel* channel, Core::ProxyType<SharedArena>& outbound, Core::ProxyType<SharedArena>& inbound) const;
+
         template <typename ACTUALINTERFACE>
         ACTUALINTERFACE* ProxyFind(const Core::ProxyType<Core::IPCChannel>& channel, const Core::instance_id& impl)
         {
@@ -296,6 +303,8 @@ namespace RPC {
         Core::ProxyPoolType<InvokeMessage> _factory;
         ChannelMap _channelProxyMap;
         ReferenceMap _channelReferenceMap;
+        mutable Core::CriticalSection _arenaLock;
+        ArenaMap _channelArenaMap;
     };
 
     class EXTERNAL Job : public Core::IDispatch {
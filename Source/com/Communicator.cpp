@@ -405,6 +405,7 @@ namespace RPC {
         , _announceMessage()
         , _announceEvent(false, true)
         , _connectionId(~0)
+        , _arena()
     {
         _announceMessage.AddRef();
 
@@ -421,6 +422,7 @@ namespace RPC {
         , _announceMessage()
         , _announceEvent(false, true)
         , _connectionId(~0)
+        , _arena()
     {
         _announceMessage.AddRef();
 
@@ -505,6 +507,20 @@ namespace RPC {
         BaseClass::StateChange();
 
         if (BaseClass::Source().IsOpen()) {
+            const Core::NodeId& remote(BaseClass::Source().RemoteNode());
+
+            // On the same machine, large frames can go through shared memory, offer the arena we would use for that.
+            if (remote.Type() == Core::NodeId::TYPE_DOMAIN) {
+                if (_arena.IsValid() == false) {
+                    static std::atomic<uint32_t> sequence(0);
+
+                    _arena = Core::ProxyType<SharedArena>::Create(SharedArena::Offer(remote.QualifiedName(), Core::ProcessInfo().Id(), ++sequence), CommunicationArenaSize);
+                }
+                if (_arena->IsValid() == true) {
+                    _announceMessage.Parameters().Shared(_arena->Name());
+                }
+            }
+
             TRACE_L1("Invoking the Announce message to the server. %d", __LINE__);
             uint32_t result = Invoke<RPC::AnnounceMessage>(Core::ProxyType<RPC::AnnounceMessage>(_announceMessage), this);
 
@@ -524,6 +540,12 @@ namespace RPC {
             }
         } else {
             TRACE_L1("Connection to the server is down");
+
+            Administrator::Instance().Unshare(this);
+
+            if (_arena.IsValid() == true) {
+                _arena.Release();
+            }
         }
     }
 
@@ -545,6 +567,19 @@ namespace RPC {
 #endif
             _connectionId = announceMessage->Response().SequenceNumber();
 
+            if (announceMessage->Response().IsMultiplexed() == true) {
+                BaseClass::Multiplexed(true);
+            }
+
+            const string arena(announceMessage->Response().Arena());
+            if ((arena.empty() == false) && (_arena.IsValid() == true)) {
+                Core::ProxyType<SharedArena> inbound(Core::ProxyType<SharedArena>::Create(arena));
+
+                if (inbound->IsValid() == true) {
+                    Administrator::Instance().Share(this, _arena, inbound);
+                }
+            }
+
             string proxyStubPath(announceMessage->Response().ProxyStubPath());
             if (proxyStubPath.empty() == false) {
                 // Also load the ProxyStubs before we do anything else
@@ -349,7 +349,8 @@ namespace RPC {
             ChannelLink& operator=(const ChannelLink&) = delete;
 
             ChannelLink(Core::IPCChannelType<Core::SocketPort, ChannelLink>* channel)
-                : _channel(channel->Source())
+                : _parent(*channel)
+                , _channel(channel->Source())
                 , _connectionMap(nullptr)
                 , _id(0)
             {
@@ -367,8 +368,11 @@ namespace RPC {
             void StateChange()
             {
                 // If the connection closes, we need to clean up....
-                if ((_channel.IsOpen() == false) && (_connectionMap != nullptr)) {
-                    _connectionMap->Closed(_id);
+                if (_channel.IsOpen() == false) {
+                    if (_connectionMap != nullptr) {
+                        _connectionMap->Closed(_id);
+                    }
+                    Administrator::Instance().Unshare(&_parent);
                 }
             }
             bool IsRegistered() const
@@ -382,6 +386,7 @@ namespace RPC {
 
         private:
             // Non ref-counted reference to our parent, of which we are a composit :-)
+            const Core::IPCChannel& _parent;
             Core::SocketPort& _channel;
             RemoteConnectionMap* _connectionMap;
             uint32_t _id;
@@ -1344,11 +1349,46 @@ namespace RPC {
 
                         message->Response().Set(instance_cast<void*>(result), proxyChannel->Extension().Id(), _parent.ProxyStubPath(), jsonDefaultMessagingSettings, jsonDefaultWarningReportingSettings);
 
+                        // If the other side can handle multiplexed calls, so can we, no need to wait for each other.
+                        if (message->Parameters().IsMultiplexed() == true) {
+                            message->Response().Multiplexed();
+                            channel.Multiplexed(true);
+                        }
+
+                        // If the other side offers shared memory for large frames, we offer it as well.
+                        const string arena(message->Parameters().Arena());
+                        if (arena.empty() == false) {
+                            Share(channel, arena, proxyChannel->Extension().Id(), message->Response());
+                        }
+
                         // We are done, report completion
                         channel.ReportResponse(data);
                     }
                 }
 
+            private:
+                void Share(const Core::IPCChannel& channel, const string& offer, const uint32_t id, Data::Setup& response)
+                {
+                    const string& connector(_parent.Connector());
+
+                    // Only open an arena of a client of ours, named after our connector, the name rebuilt from its
+                    // process and sequence number.
+                    const string arena(SharedArena::Offered(connector, offer));
+
+                    if (arena.empty() == false) {
+                        Core::ProxyType<SharedArena> inbound(Core::ProxyType<SharedArena>::Create(arena));
+
+                        if (inbound->IsValid() == true) {
+                            Core::ProxyType<SharedArena> outbound(Core::ProxyType<SharedArena>::Create(Core::Format(_T("%s.%d.%u.server"), connector.c_str(), Core::ProcessInfo().Id(), id), CommunicationArenaSize));
+
+                            if (outbound->IsValid() == true) {
+                                response.Shared(outbound->Name());
+                                Administrator::Instance().Share(&channel, outbound, inbound);
+                            }
+                        }
+                    }
+                }
+
             private:
                 ChannelServer& _parent;
             };
@@ -1789,6 +1829,7 @@ POP_WARNING()
         Core::ProxyObject<RPC::AnnounceMessage> _announceMessage;
         Core::Event _announceEvent;
         uint32_t _connectionId;
+        Core::ProxyType<SharedArena> _arena;
     };
 }
 }
@@ -292,8 +292,20 @@ namespace ProxyStub {
         {
             ASSERT(_channel.IsValid() == true);
 
+            Core::ProxyType<RPC::SharedArena> outbound;
+            Core::ProxyType<RPC::SharedArena> inbound;
+            const bool shared = RPC::Administrator::Instance().Shared(_channel.operator->(), outbound, inbound);
+
+            if (shared == true) {
+                message->Parameters().Share(*outbound);
+            }
+
             uint32_t result = _channel->Invoke(message, waitTime);
 
+            if ((result == Core::ERROR_NONE) && (shared == true) && (message->Response().Resolve(inbound) == false)) {
+                result = Core::ERROR_ILLEGAL_STATE;
+            }
+
             if (result != Core::ERROR_NONE) {
                 result |= COM_ERROR;
 
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Module.h"
+#include "SharedArena.h"
 
 namespace WPEFramework {
 namespace RPC {
@@ -37,19 +38,40 @@ namespace RPC {
         private:
             using BaseClass = Core::FrameType<IPC_BLOCK_SIZE, true, uint32_t>;
 
+            // On a channel that has a SharedArena, the last byte of a frame tells how the content travels.
+            enum storage : uint8_t {
+                INLINE = 0x00,
+                ARENA = 0x01
+            };
+
+            static constexpr uint8_t HandleSize = (sizeof(uint32_t) + sizeof(uint32_t) + sizeof(storage));
+
         public:
             Frame(Frame&) = delete;
             Frame& operator=(const Frame&) = delete;
 
-            Frame() : BaseClass() {
+            Frame()
+                : BaseClass()
+                , _arena()
+                , _offset(0)
+                , _length(0)
+            {
+            }
+            ~Frame()
+            {
+                Release();
             }
-            ~Frame() = default;
 
         public:
             friend class Input;
             friend class Output;
             friend class ObjectInterface;
 
+            void Clear()
+            {
+                Release();
+                BaseClass::Clear();
+            }
             uint16_t Serialize(const uint32_t offset, uint8_t stream[], const uint16_t maxLength) const
             {
                 uint16_t copiedBytes((Size() - offset) > maxLength ? maxLength : (Size() - offset));
@@ -60,12 +82,84 @@ namespace RPC {
             }
             uint16_t Deserialize(const uint32_t offset, const uint8_t stream[], const uint16_t maxLength)
             {
+                if (offset == 0) {
+                    Release();
+                }
+
                 Size(offset + maxLength);
 
                 ::memcpy(&(operator[](offset)), stream, maxLength);
 
                 return (maxLength);
             }
+
+        private:
+            // Right before sending: if the frame is large enough, copy it to the arena and only keep the
+            // first inlined bytes (for those that inspect the frame before it is resolved) and where it is.
+            void Share(SharedArena& arena, const uint32_t inlined)
+            {
+                const uint32_t length = Size();
+                uint32_t offset = 0;
+                uint8_t* block = ((length >= CommunicationArenaThreshold) && (length >= inlined) ? arena.Allocate(length, offset) : nullptr);
+
+                if (block == nullptr) {
+                    SetNumber<storage>(length, INLINE);
+                } else {
+                    ::memcpy(block, Data(), length);
+
+                    Size(inlined);
+                    SetNumber<uint32_t>(inlined, offset);
+                    SetNumber<uint32_t>(inlined + sizeof(uint32_t), length);
+                    SetNumber<storage>(inlined + sizeof(uint32_t) + sizeof(uint32_t), ARENA);
+                }
+            }
+            // Right after receiving: undo what Share() did, if the content is in the arena, it is read from there.
+            bool Resolve(const Core::ProxyType<SharedArena>& arena, const uint32_t inlined)
+            {
+                bool result = (Size() == 0);
+
+                if (result == false) {
+                    storage how = INLINE;
+
+                    GetNumber<storage>(Size() - 1, how);
+
+                    if (how == INLINE) {
+                        Size(Size() - 1);
+                        result = true;
+                    } else if ((how == ARENA) && (Size() == (inlined + HandleSize)) && (arena.IsValid() == true)) {
+                        uint32_t offset = 0;
+                        uint32_t length = 0;
+
+                        GetNumber<uint32_t>(inlined, offset);
+                        GetNumber<uint32_t>(inlined + sizeof(uint32_t), length);
+
+                        const uint8_t* block = arena->Block(offset, length);
+
+                        if ((block != nullptr) && (length >= inlined)) {
+                            Attach(block, length);
+                            _arena = arena;
+                            _offset = offset;
+                            _length = length;
+                            result = true;
+                        }
+                    }
+                }
+
+                return (result);
+            }
+            void Release()
+            {
+                if (_arena.IsValid() == true) {
+                    BaseClass::Clear();
+                    _arena->Release(_offset, _length);
+                    _arena.Release();
+                }
+            }
+
+        private:
+            Core::ProxyType<SharedArena> _arena;
+            uint32_t _offset;
+            uint32_t _length;
         };
 
         class Input {
@@ -128,6 +222,15 @@ namespace RPC {
             {
                 return (Frame::Reader(_data, (sizeof(Core::instance_id) + sizeof(uint32_t) + sizeof(uint8_t))));
             }
+            // The header stays inline, so the receiving side can inspect it before the frame is resolved.
+            inline void Share(SharedArena& arena)
+            {
+                _data.Share(arena, (sizeof(Core::instance_id) + sizeof(uint32_t) + sizeof(uint8_t)));
+            }
+            inline bool Resolve(const Core::ProxyType<SharedArena>& arena)
+            {
+                return (_data.Resolve(arena, (sizeof(Core::instance_id) + sizeof(uint32_t) + sizeof(uint8_t))));
+            }
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, const uint32_t offset) const
             {
                 return (_data.Serialize(offset, stream, maxLength));
@@ -180,6 +283,14 @@ namespace RPC {
             {
                 return (static_cast<uint32_t>(_data.Size()));
             }
+            inline void Share(SharedArena& arena)
+            {
+                _data.Share(arena, 0);
+            }
+            inline bool Resolve(const Core::ProxyType<SharedArena>& arena)
+            {
+                return (_data.Resolve(arena, 0));
+            }
             inline uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, const uint32_t offset) const
             {
                 return (_data.Serialize(offset, stream, maxLength));
@@ -193,6 +304,12 @@ namespace RPC {
             Frame _data;
         };
 
+        // Capabilities of a peer. These follow the fields known to older peers, which simply ignore them.
+        enum capability : uint8_t {
+            MULTIPLEXED = 0x01,
+            SHARED = 0x02 // Followed by the name of the SharedArena the sending side allocates from.
+        };
+
         class Init {
         public:
             enum type : uint8_t {
@@ -269,7 +386,29 @@ namespace RPC {
                 _data.SetNumber<uint32_t>(VERSIONID_OFFSET, versionId);
                 _data.SetNumber<type>(TYPE_OFFSET, whatKind);
                 const uint16_t classNameLength = _data.SetText(STRINGS_OFFSET, className);
-                _data.SetText((STRINGS_OFFSET + classNameLength), callsign);
+                const uint16_t callsignLength = _data.SetText((STRINGS_OFFSET + classNameLength), callsign);
+                _data.SetNumber<uint8_t>((STRINGS_OFFSET + classNameLength + callsignLength), MULTIPLEXED);
+            }
+            uint16_t CapabilitiesOffset() const
+            {
+                string value;
+
+                uint16_t length = STRINGS_OFFSET;
+                length += _data.GetText(length, value); // skip class name
+                length += _data.GetText(length, value); // skip callsign
+
+                return (length);
+            }
+            uint8_t Capabilities() const
+            {
+                uint8_t result = 0;
+                const uint16_t offset = CapabilitiesOffset();
+
+                if (_data.Size() > offset) {
+                    _data.GetNumber<uint8_t>(offset, result);
+                }
+
+                return (result);
             }
 
         private:
@@ -340,6 +479,28 @@ namespace RPC {
             {
                 return GetText(STRINGS_OFFSET);
             }
+            bool IsMultiplexed() const
+            {
+                return ((Capabilities() & MULTIPLEXED) != 0);
+            }
+            // Only to be called after Set(), it follows the fields set there.
+            void Shared(const string& arena)
+            {
+                const uint16_t offset = CapabilitiesOffset();
+
+                _data.SetNumber<uint8_t>(offset, (Capabilities() | SHARED));
+                _data.SetText(offset + sizeof(uint8_t), arena);
+            }
+            string Arena() const
+            {
+                string result;
+
+                if ((Capabilities() & SHARED) != 0) {
+                    _data.GetText(CapabilitiesOffset() + sizeof(uint8_t), result);
+                }
+
+                return (result);
+            }
 
         public:
             void Clear()
@@ -449,6 +610,33 @@ namespace RPC {
             {
                 _data.SetNumber<Core::instance_id>(0, implementation);
             }
+            // Only to be called after Set(), it follows the fields set there.
+            void Multiplexed()
+            {
+                _data.SetNumber<uint8_t>(CapabilitiesOffset(), (Capabilities() | MULTIPLEXED));
+            }
+            bool IsMultiplexed() const
+            {
+                return ((Capabilities() & MULTIPLEXED) != 0);
+            }
+            // Only to be called after Set(), it follows the fields set there.
+            void Shared(const string& arena)
+            {
+                const uint16_t offset = CapabilitiesOffset();
+
+                _data.SetNumber<uint8_t>(offset, (Capabilities() | SHARED));
+                _data.SetText(offset + sizeof(uint8_t), arena);
+            }
+            string Arena() const
+            {
+                string result;
+
+                if ((Capabilities() & SHARED) != 0) {
+                    _data.GetText(CapabilitiesOffset() + sizeof(uint8_t), result);
+                }
+
+                return (result);
+            }
             uint32_t Length() const
             {
                 return (_data.Size());
@@ -462,6 +650,30 @@ namespace RPC {
                 return (_data.Deserialize(offset, stream, maxLength));
             }
 
+        private:
+            uint16_t CapabilitiesOffset() const
+            {
+                string value;
+
+                uint16_t length = sizeof(Core::instance_id) + sizeof(uint32_t) + sizeof(Output::mode); // skip implementation and sequence number
+                length += _data.GetText(length, value); // skip proxyStub path
+                length += _data.GetText(length, value); // skip messaging categories
+                length += _data.GetText(length, value); // skip warning reporting categories
+
+                return (length);
+            }
+            uint8_t Capabilities() const
+            {
+                uint8_t result = 0;
+                const uint16_t offset = CapabilitiesOffset();
+
+                if (_data.Size() > offset) {
+                    _data.GetNumber<uint8_t>(offset, result);
+                }
+
+                return (result);
+            }
+
         private:
             Frame _data;
         };
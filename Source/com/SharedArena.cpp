@@ -0,0 +1,216 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SharedArena.h"
+
+namespace WPEFramework {
+namespace RPC {
+
+    /* static */ constexpr uint32_t SharedArena::ArenaMagic;
+    /* static */ constexpr uint32_t SharedArena::Continued;
+    /* static */ constexpr uint32_t SharedArena::PageSize;
+
+    namespace {
+
+        // Reads the decimal number at offset, up to the next '.', nothing but digits.
+        bool Number(const string& text, size_t& offset, uint32_t& value)
+        {
+            const size_t start = offset;
+            uint64_t result = 0;
+
+            while ((offset < text.length()) && (text[offset] >= '0') && (text[offset] <= '9') && (result <= 0xFFFFFFFF)) {
+                result = (result * 10) + (text[offset] - '0');
+                offset++;
+            }
+
+            value = static_cast<uint32_t>(result);
+
+            return ((offset != start) && (offset < text.length()) && (text[offset] == '.') && (result <= 0xFFFFFFFF));
+        }
+
+    }
+
+    /* static */ string SharedArena::Offer(const string& connector, const uint32_t process, const uint32_t sequence)
+    {
+        return (Core::Format(_T("%s.%u.%u.client"), connector.c_str(), process, sequence));
+    }
+
+    /* static */ string SharedArena::Offered(const string& connector, const string& offer)
+    {
+        string result;
+
+        if ((offer.length() > connector.length()) && (offer.compare(0, connector.length(), connector) == 0) && (offer[connector.length()] == '.')) {
+            size_t offset = connector.length() + 1;
+            uint32_t process = 0;
+            uint32_t sequence = 0;
+
+            if ((Number(offer, offset, process) == true) && (Number(offer, ++offset, sequence) == true)) {
+                // Rebuilt from the numbers alone, whatever else the client put in it, is not used.
+                const string rebuilt(Offer(connector, process, sequence));
+
+                if (rebuilt == offer) {
+                    result = rebuilt;
+                }
+            }
+        }
+
+        return (result);
+    }
+
+    SharedArena::SharedArena(const string& name, const uint32_t size)
+        : _storage(name, Core::File::USER_READ | Core::File::USER_WRITE | Core::File::GROUP_READ | Core::File::GROUP_WRITE | Core::File::SHAREABLE | Core::File::CREATE, AdministrationSize(Pages(size)) + (Pages(size) * PageSize))
+        , _owner(true)
+        , _administration(nullptr)
+        , _data(nullptr)
+        , _pages(Pages(size))
+        , _cursor(0)
+        , _lock()
+    {
+        if ((_storage.IsValid() == true) && (_storage.Size() >= (AdministrationSize(_pages) + (_pages * PageSize)))) {
+            Administration* administration = reinterpret_cast<Administration*>(_storage.Buffer());
+
+            for (uint32_t index = 0; index < _pages; index++) {
+                new (&(administration->State[index])) std::atomic<uint32_t>(0);
+            }
+            administration->Pages = _pages;
+            administration->Magic = ArenaMagic;
+
+            _data = &(_storage.Buffer()[AdministrationSize(_pages)]);
+            _administration = administration;
+        } else {
+            TRACE_L1("Could not create the shared arena %s", name.c_str());
+            _pages = 0;
+        }
+    }
+
+    SharedArena::SharedArena(const string& name)
+        : _storage(name, Core::File::USER_READ | Core::File::USER_WRITE | Core::File::SHAREABLE, 0)
+        , _owner(false)
+        , _administration(nullptr)
+        , _data(nullptr)
+        , _pages(0)
+        , _cursor(0)
+        , _lock()
+    {
+        // Do not trust what we find, it should be an arena and it should fit in what was mapped.
+        if ((_storage.IsValid() == true) && (_storage.Size() >= sizeof(Administration))) {
+            Administration* administration = reinterpret_cast<Administration*>(_storage.Buffer());
+
+            // Read once, the other side can change it while we look at it.
+            const uint32_t pages = administration->Pages;
+
+            if ((administration->Magic == ArenaMagic) && (_storage.Size() >= (static_cast<uint64_t>(AdministrationSize(pages)) + (static_cast<uint64_t>(pages) * PageSize)))) {
+                _pages = pages;
+                _data = &(_storage.Buffer()[AdministrationSize(_pages)]);
+                _administration = administration;
+            }
+        }
+
+        if (_administration == nullptr) {
+            TRACE_L1("Could not open the shared arena %s", name.c_str());
+        }
+    }
+
+    SharedArena::~SharedArena()
+    {
+        if (_owner == true) {
+            _storage.Destroy();
+        }
+    }
+
+    uint8_t* SharedArena::Allocate(const uint32_t length, uint32_t& offset)
+    {
+        uint8_t* result = nullptr;
+        const uint32_t pages = Pages(length);
+
+        ASSERT(_owner == true);
+
+        if ((_administration != nullptr) && (pages != 0) && (pages <= _pages)) {
+            uint32_t first = 0;
+            uint32_t run = 0;
+
+            _lock.Lock();
+
+            // Look for a run of free pages, starting where the last allocation ended. A run does not wrap.
+            for (uint32_t count = 0; (count < (_pages + pages)) && (run < pages); count++) {
+                const uint32_t page = (_cursor + count) % _pages;
+
+                if (page == 0) {
+                    run = 0;
+                }
+                if (_administration->State[page].load(std::memory_order_acquire) == 0) {
+                    if (run++ == 0) {
+                        first = page;
+                    }
+                } else {
+                    run = 0;
+                }
+            }
+
+            if (run == pages) {
+                for (uint32_t index = 1; index < pages; index++) {
+                    _administration->State[first + index].store(Continued, std::memory_order_relaxed);
+                }
+                _administration->State[first].store(pages, std::memory_order_release);
+
+                _cursor = (first + pages) % _pages;
+                offset = first * PageSize;
+                result = &(_data[offset]);
+            }
+
+            _lock.Unlock();
+        }
+
+        return (result);
+    }
+
+    const uint8_t* SharedArena::Block(const uint32_t offset, const uint32_t length) const
+    {
+        const uint8_t* result = nullptr;
+        const uint32_t pages = Pages(length);
+
+        ASSERT(_owner == false);
+
+        if ((_administration != nullptr) && ((offset % PageSize) == 0) && (pages != 0) && (((offset / PageSize) + static_cast<uint64_t>(pages)) <= _pages)) {
+            if (_administration->State[offset / PageSize].load(std::memory_order_acquire) == pages) {
+                result = &(_data[offset]);
+            }
+        }
+
+        return (result);
+    }
+
+    void SharedArena::Release(const uint32_t offset, const uint32_t length)
+    {
+        const uint32_t first = offset / PageSize;
+        const uint32_t pages = Pages(length);
+
+        ASSERT(_owner == false);
+        ASSERT(Block(offset, length) != nullptr);
+
+        if ((_administration != nullptr) && ((first + static_cast<uint64_t>(pages)) <= _pages)) {
+            for (uint32_t index = 1; index < pages; index++) {
+                _administration->State[first + index].store(0, std::memory_order_relaxed);
+            }
+            _administration->State[first].store(0, std::memory_order_release);
+        }
+    }
+
+}
+}
@@ -0,0 +1,113 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+
+namespace WPEFramework {
+namespace RPC {
+
+    enum { CommunicationArenaSize = (4 * 1024 * 1024) }; // 4M, for each direction of a connection
+    enum { CommunicationArenaThreshold = (8 * 1024) }; // 8K, smaller frames are cheaper to copy through the socket
+
+    // -------------------------------------------------------------------
+    // A block of shared memory that one side of a connection (the owner)
+    // allocates from and the other side reads from. The owner copies a
+    // large frame in here and only sends where it is, the other side reads
+    // it in place and hands the pages back once it is done with it.
+    // The state of the pages lives in the shared memory as well, so
+    // handing back is a simple store, no message needs to be sent.
+    // -------------------------------------------------------------------
+    class EXTERNAL SharedArena {
+    private:
+        struct Administration {
+            uint32_t Magic;
+            uint32_t Pages;
+            std::atomic<uint32_t> State[1];
+        };
+
+        static constexpr uint32_t ArenaMagic = 0x414E5241; // ARNA
+        static constexpr uint32_t Continued = ~0u;
+
+    public:
+        static constexpr uint32_t PageSize = 4096;
+
+    public:
+        SharedArena() = delete;
+        SharedArena(SharedArena&&) = delete;
+        SharedArena(const SharedArena&) = delete;
+        SharedArena& operator=(SharedArena&&) = delete;
+        SharedArena& operator=(const SharedArena&) = delete;
+
+        // Create the arena this side allocates from.
+        SharedArena(const string& name, const uint32_t size);
+        // Open the arena of the other side.
+        SharedArena(const string& name);
+        ~SharedArena();
+
+    public:
+        // The name of the arena a client, in the given process, offers to the server that listens on connector.
+        static string Offer(const string& connector, const uint32_t process, const uint32_t sequence);
+        // The name of the arena a client offered, rebuilt by the server from the process and sequence number in
+        // it. Empty if it is not an offer for this connector, so a client can not have any other file opened.
+        static string Offered(const string& connector, const string& offer);
+
+        bool IsValid() const
+        {
+            return (_administration != nullptr);
+        }
+        const string& Name() const
+        {
+            return (_storage.Name());
+        }
+        uint32_t Size() const
+        {
+            return (_pages * PageSize);
+        }
+
+        // Owner: claim room for length bytes, nullptr if there is not enough room (at the moment).
+        uint8_t* Allocate(const uint32_t length, uint32_t& offset);
+
+        // Other side: the block that was claimed at offset, nullptr if that is not what the owner did.
+        const uint8_t* Block(const uint32_t offset, const uint32_t length) const;
+        // Other side: hand the block back to the owner.
+        void Release(const uint32_t offset, const uint32_t length);
+
+    private:
+        static uint32_t Pages(const uint32_t length)
+        {
+            return ((length + PageSize - 1) / PageSize);
+        }
+        static uint32_t AdministrationSize(const uint32_t pages)
+        {
+            return ((((sizeof(Administration) + (sizeof(std::atomic<uint32_t>) * pages)) + PageSize - 1) / PageSize) * PageSize);
+        }
+
+    private:
+        Core::DataElementFile _storage;
+        const bool _owner;
+        Administration* _administration;
+        uint8_t* _data;
+        uint32_t _pages;
+        uint32_t _cursor;
+        Core::CriticalSection _lock;
+    };
+}
+}
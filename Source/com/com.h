@@ -33,6 +33,7 @@
 #include "IValueIterator.h"
 #include "ICOM.h"
 #include "Messages.h"
+#include "SharedArena.h"
 
 #if defined(__WINDOWS__) && !defined(COM_EXPORTS)
 #pragma comment(lib, "com.lib")
@@ -111,6 +111,8 @@ namespace Core {
             AllocatorType()
                 : _bufferSize(STARTSIZE)
                 , _data(reinterpret_cast<uint8_t*>(::malloc(_bufferSize)))
+                , _ownSize(0)
+                , _own(nullptr)
             {
                 // It looks like there is a bug in the windows compiler. It prepares a default/copy constructor
                 // if if the template being instantiated is not really utilizing it!
@@ -121,6 +123,8 @@ namespace Core {
             AllocatorType(const AllocatorType<STARTSIZE, SIZETYPE>& copy)
                 : _bufferSize(copy._bufferSize)
                 , _data(reinterpret_cast<uint8_t*>(::malloc(_bufferSize)))
+                , _ownSize(0)
+                , _own(nullptr)
             {
                 // It looks like there is a bug in the windows compiler. It prepares a default/copy constructor
                 // if if the template being instantiated is not really utilizing it!
@@ -133,11 +137,15 @@ namespace Core {
             AllocatorType(uint8_t buffer[], const SIZETYPE length)
                 : _bufferSize(length)
                 , _data(buffer)
+                , _ownSize(0)
+                , _own(nullptr)
             {
                 static_assert(STARTSIZE == 0, "This method can only be called if you specify an initial blocksize of 0");
             }
             ~AllocatorType()
             {
+                Detach();
+
                 if ((STARTSIZE != 0) && (_data != nullptr)) {
                     ::free(_data);
                 }
@@ -146,6 +154,11 @@ namespace Core {
         public:
             inline uint8_t& operator[](const SIZETYPE index)
             {
+                // Writing never goes to an attached buffer, the owner of it may still be using it.
+                if (_own != nullptr) {
+                    Private();
+                }
+
                 ASSERT(_data != nullptr);
                 ASSERT(index < _bufferSize);
                 return (_data[index]);
@@ -160,14 +173,52 @@ namespace Core {
             {
                 RealAllocate(requiredSize, TemplateIntToType<STARTSIZE == 0 ? false : true>());
             }
+            inline bool IsAttached() const
+            {
+                return (_own != nullptr);
+            }
+            void Attach(const uint8_t buffer[], const SIZETYPE length)
+            {
+                #ifndef __WINDOWS__
+                static_assert(STARTSIZE != 0, "This method can only be called if the allocator owns a buffer to return to");
+                #endif
+
+                if (_own == nullptr) {
+                    _own = _data;
+                    _ownSize = _bufferSize;
+                }
+                _data = const_cast<uint8_t*>(buffer);
+                _bufferSize = length;
+            }
+            inline void Detach()
+            {
+                if (_own != nullptr) {
+                    _data = _own;
+                    _bufferSize = _ownSize;
+                    _own = nullptr;
+                }
+            }
 
         private:
             inline void RealAllocate(const SIZETYPE requiredSize VARIABLE_IS_NOT_USED, const TemplateIntToType<false>& /* For compile time diffrentiation */)
             {
                 ASSERT(requiredSize <= _bufferSize);
             }
+            // Continue on our own buffer, with a copy of what is attached.
+            void Private()
+            {
+                const uint8_t* attached = _data;
+                const SIZETYPE length = _bufferSize;
+
+                Detach();
+                RealAllocate(length, TemplateIntToType<true>());
+                ::memcpy(_data, attached, length);
+            }
             inline void RealAllocate(const SIZETYPE requiredSize, const TemplateIntToType<true>& /* For compile time diffrentiation */)
             {
+                if (_own != nullptr) {
+                    Private();
+                }
                 if (requiredSize > _bufferSize) {
 
                     SIZETYPE bufferSize = static_cast<uint32_t>(((requiredSize / (STARTSIZE ? STARTSIZE : 1)) + 1) * STARTSIZE);
@@ -185,6 +236,8 @@ namespace Core {
         private:
             SIZETYPE _bufferSize;
             uint8_t* _data;
+            SIZETYPE _ownSize;
+            uint8_t* _own;
         };
 
     public:
@@ -228,6 +281,11 @@ namespace Core {
                 _offset += _container->GetNumber<TYPENAME>(_offset, result);
                 buffer = &(_container->operator[](_offset));
 
+                // The length is read once and only what is in the frame is handed out, whatever it says.
+                if (result > Length()) {
+                    result = static_cast<TYPENAME>(Length());
+                }
+
                 return (result);
             }
             template <typename TYPENAME>
@@ -459,8 +517,22 @@ namespace Core {
     public:
         inline void Clear()
         {
+            _data.Detach();
             _size = 0;
         }
+        // Let the frame present the given buffer as its content, without copying it. The buffer
+        // must remain valid until the frame is cleared, any change makes the frame continue on a
+        // copy in its own buffer. The buffer is read in place, so every length or offset in it is
+        // read once and checked against the size of the frame before it is used.
+        void Attach(const uint8_t buffer[], const SIZE_CONTEXT length)
+        {
+            _data.Attach(buffer, length);
+            _size = length;
+        }
+        inline bool IsAttached() const
+        {
+            return (_data.IsAttached());
+        }
         inline SIZE_CONTEXT Size() const
         {
             return (_size);
@@ -613,9 +685,13 @@ namespace Core {
 
         SIZE_CONTEXT GetNullTerminatedText(const SIZE_CONTEXT offset, string& result) const
         {
+            ASSERT(offset < _size);
+
+            // Never beyond the end of the frame, also if the terminator is missing.
             const char* text = reinterpret_cast<const char*>(&(_data[offset]));
-            result = text;
-            return (static_cast<SIZE_CONTEXT>(result.length() + 1));
+            const SIZE_CONTEXT length = static_cast<SIZE_CONTEXT>(::strnlen(text, _size - offset));
+            result = string(text, length);
+            return (static_cast<SIZE_CONTEXT>(length + 1));
         }
 
         SIZE_CONTEXT SetBoolean(const SIZE_CONTEXT offset, const bool value)
@@ -679,7 +755,7 @@ namespace Core {
                 index++;
             }
 
-            return ((_data[offset + index] & 0x80) == 0 ? index + 1 : 0);
+            return (((offset + index) < _size) && ((_data[offset + index] & 0x80) == 0) ? index + 1 : 0);
         }
 
         static uint8_t VariableNumberLength(const uint64_t value) {
@@ -702,12 +778,13 @@ namespace Core {
 
             ASSERT(offset < _size);
 
-            while (((offset + index) < _size) && ((_data[offset + index] & 0x80) != 0)) {
+            while (((offset + index + 1) < _size) && ((_data[offset + index] & 0x80) != 0)) {
                 index++;
             }
 
             ASSERT(((index * 7) / 8) <= Frame::RealSize<TYPENAME>());
 
+            // The last byte is the one that ends the number or the last one of the frame, never beyond it.
             ++index;
 
             if (BIG_ENDIAN_ORDERING == false) {
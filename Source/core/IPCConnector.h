@@ -473,11 +473,136 @@ POP_WARNING()
         private:
             friend IPCChannel;
 
+            // A multiplexed call carries a sequence number in front of the payload of its messages, the
+            // response to it carries the same number. The label of such a message has this flag set on
+            // top of the label of the message that is carried. Sequence number 0 is reserved for the one
+            // call that can be in progress in the classic (not multiplexed) way.
+            static constexpr uint32_t SequenceFlag = 0x10000000;
+
+            struct Outbound {
+                Outbound(const Core::ProxyType<IIPC>& message, IDispatchType<IIPC>* callback)
+                    : Message(message)
+                    , Callback(callback)
+                {
+                }
+
+                Core::ProxyType<IIPC> Message;
+                IDispatchType<IIPC>* Callback;
+            };
+
+            using OutboundMap = std::unordered_map<uint32_t, Outbound>;
+            using ReplyMap = std::unordered_map<const IIPC*, uint32_t>;
+
+            class Sequenced : public IMessage {
+            public:
+                Sequenced(const Sequenced&) = delete;
+                Sequenced& operator=(const Sequenced&) = delete;
+
+                Sequenced()
+                    : _factory(nullptr)
+                    , _label(0)
+                    , _sequence(0)
+                    , _message()
+                {
+                }
+                ~Sequenced() override = default;
+
+            public:
+                // Carry an outbound message
+                void Set(const uint32_t sequence, const Core::ProxyType<IMessage>& message)
+                {
+                    _label = message->Label();
+                    _sequence = sequence;
+                    _message = message;
+                }
+                // Receive an inbound message, what it carries is known once the sequence is received.
+                void Set(IPCFactory& factory, const uint32_t label)
+                {
+                    _factory = &factory;
+                    _label = label;
+                }
+                void Clear()
+                {
+                    _factory = nullptr;
+                    _label = 0;
+                    _sequence = 0;
+
+                    if (_message.IsValid() == true) {
+                        _message.Release();
+                    }
+                }
+                uint32_t Sequence() const
+                {
+                    return (_sequence);
+                }
+                const Core::ProxyType<IMessage>& Message() const
+                {
+                    return (_message);
+                }
+                uint32_t Label() const override
+                {
+                    return (_label | SequenceFlag);
+                }
+                uint32_t Length() const override
+                {
+                    return (sizeof(_sequence) + (_message.IsValid() == true ? _message->Length() : 0));
+                }
+                uint16_t Serialize(uint8_t stream[], const uint16_t maxLength, const uint32_t offset) const override
+                {
+                    uint16_t result = 0;
+
+                    while (((offset + result) < sizeof(_sequence)) && (result < maxLength)) {
+                        stream[result] = static_cast<uint8_t>(_sequence >> (8 * (offset + result)));
+                        result++;
+                    }
+
+                    if (result < maxLength) {
+                        result += _message->Serialize(&stream[result], maxLength - result, offset + result - sizeof(_sequence));
+                    }
+
+                    return (result);
+                }
+                uint16_t Deserialize(const uint8_t stream[], const uint16_t maxLength, const uint32_t offset) override
+                {
+                    uint16_t result = 0;
+
+                    while (((offset + result) < sizeof(_sequence)) && (result < maxLength)) {
+                        _sequence |= (static_cast<uint32_t>(stream[result]) << (8 * (offset + result)));
+                        result++;
+
+                        if ((offset + result) == sizeof(_sequence)) {
+                            ASSERT(_factory != nullptr);
+                            _message = _factory->Element(_label, _sequence);
+                        }
+                    }
+
+                    if (result < maxLength) {
+                        if (_message.IsValid() == true) {
+                            result += _message->Deserialize(&stream[result], maxLength - result, offset + result - sizeof(_sequence));
+                        } else {
+                            // Nobody is waiting for this one, drop it..
+                            result = maxLength;
+                        }
+                    }
+
+                    return (result);
+                }
+
+            private:
+                IPCFactory* _factory;
+                uint32_t _label;
+                uint32_t _sequence;
+                Core::ProxyType<IMessage> _message;
+            };
+
             IPCFactory()
                 : _lock()
                 , _inbound()
+                , _inboundSequence(0)
                 , _outbound()
-                , _callback(nullptr)
+                , _replies()
+                , _sequence(0)
+                , _sequenced(2)
                 , _factory()
                 , _handlers()
             {
@@ -496,8 +621,11 @@ POP_WARNING()
             IPCFactory(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
                 : _lock()
                 , _inbound()
+                , _inboundSequence(0)
                 , _outbound()
-                , _callback(nullptr)
+                , _replies()
+                , _sequence(0)
+                , _sequenced(2)
                 , _factory(factory)
                 , _handlers()
             {
@@ -550,37 +678,29 @@ POP_WARNING()
 
             bool InProgress() const
             {
-                return (_outbound.IsValid());
+                _lock.Lock();
+
+                bool result = (_outbound.empty() == false);
+
+                _lock.Unlock();
+
+                return (result);
             }
 
             ProxyType<IMessage> Element(const uint32_t& identifier)
             {
                 ProxyType<IMessage> result;
-                uint32_t searchIdentifier(identifier >> 1);
 
-                _lock.Lock();
+                if ((identifier & SequenceFlag) != 0) {
+                    Core::ProxyType<Sequenced> element(_sequenced.Element());
 
-                if (identifier & 0x01) {
-                    if ((_outbound.IsValid() == true) && (_outbound->Label() == searchIdentifier)) {
-                        result = _outbound->IResponse();
-                    } else {
-                        TRACE_L1("Unexpected response message for ID [%d].\n", searchIdentifier);
-                    }
-                } else {
-                    ASSERT(_inbound.IsValid() == false);
+                    element->Set(*this, (identifier & (~SequenceFlag)));
 
-                    ProxyType<IIPC> rpcCall(_factory->Element(searchIdentifier));
-
-                    if (rpcCall.IsValid() == true) {
-                        _inbound = rpcCall;
-                        result = rpcCall->IParameters();
-                    } else {
-                        TRACE_L1("No RPC method definition for ID [%d].\n", searchIdentifier);
-                    }
+                    result = Core::ProxyType<IMessage>(element);
+                } else {
+                    result = Element(identifier, 0);
                 }
 
-                _lock.Unlock();
-
                 return (result);
             }
 
@@ -590,11 +710,9 @@ POP_WARNING()
 
                 TRACE_L1("Flushing the IPC mechanims. %d", __LINE__);
 
-                _callback = nullptr;
+                _outbound.clear();
+                _replies.clear();
 
-                if (_outbound.IsValid() == true) {
-                    _outbound.Release();
-                }
                 if (_inbound.IsValid() == true) {
                     _inbound.Release();
                 }
@@ -605,34 +723,56 @@ POP_WARNING()
             ProxyType<IIPCServer> ReceivedMessage(const Core::ProxyType<IMessage>& rhs, Core::ProxyType<IIPC>& inbound)
             {
                 ProxyType<IIPCServer> procedure;
+                Core::ProxyType<IMessage> message(rhs);
+                uint32_t sequence = 0;
+
+                if ((rhs->Label() & SequenceFlag) != 0) {
+                    const Sequenced& carrier(static_cast<const Sequenced&>(*rhs));
+
+                    sequence = carrier.Sequence();
+                    message = carrier.Message();
+                }
 
                 _lock.Lock();
 
-                if ((_outbound.IsValid() == true) && (_outbound->IResponse() == rhs)) {
+                OutboundMap::iterator index(message.IsValid() == true ? _outbound.find(sequence) : _outbound.end());
+
+                if ((index != _outbound.end()) && (index->second.Message->IResponse() == message)) {
 
-                    ASSERT(_callback != nullptr);
+                    ASSERT(index->second.Callback != nullptr);
 
-                    ProxyType<IIPC> handledObject(_outbound);
+                    ProxyType<IIPC> handledObject(index->second.Message);
+                    IDispatchType<IIPC>* callback(index->second.Callback);
 
-                    _outbound.Release();
-                    _callback->Dispatch(*handledObject);
-                    _callback = nullptr;
+                    _outbound.erase(index);
+                    callback->Dispatch(*handledObject);
                 }
                 // If this is *NOT* the outbound call, it is inbound and thus it must have been registered
                 else if (_inbound.IsValid() == true) {
 
-                    std::map<uint32_t, ProxyType<IIPCServer>>::iterator index(_handlers.find(_inbound->Label()));
+                    ASSERT(_inboundSequence == sequence);
 
-					ASSERT(index != _handlers.end());
+                    std::map<uint32_t, ProxyType<IIPCServer>>::iterator handler(_handlers.find(_inbound->Label()));
 
-                    if (index != _handlers.end()) {
-                        procedure = (*index).second;
+					ASSERT(handler != _handlers.end());
+
+                    if (handler != _handlers.end()) {
+                        procedure = (*handler).second;
                         inbound = _inbound;
+
+                        // Remember how to respond to this call, a multiplexed call gets its sequence back.
+                        if (sequence != 0) {
+                            _replies[&(*_inbound)] = sequence;
+                        } else {
+                            _replies.erase(&(*_inbound));
+                        }
                     } else {
                         TRACE_L1("No handler defined to handle the incoming frames. [%d]", _inbound->Label());
                     }
 
                     _inbound.Release();
+                } else if (message.IsValid() == false) {
+                    TRACE_L1("Dropped a multiplexed message nobody is waiting for. [%d]", sequence);
                 } else {
                     ASSERT(false && "Received something that is neither an inbound nor on outbound!!!");
                 }
@@ -647,32 +787,136 @@ POP_WARNING()
                 _lock.Lock();
 
                 ASSERT((outbound.IsValid() == true) && (callback != nullptr));
-                ASSERT((_outbound.IsValid() == false) && (_callback == nullptr));
+                ASSERT(_outbound.find(0) == _outbound.end());
 
-                _outbound = outbound;
-                _callback = callback;
+                _outbound.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(0),
+                    std::forward_as_tuple(outbound, callback));
 
                 _lock.Unlock();
             }
 
-            bool AbortOutbound()
+            // Multiplexed variant of the SetOutbound, returns the sequence number to send the call with.
+            uint32_t AddOutbound(const Core::ProxyType<IIPC>& outbound, IDispatchType<IIPC>* callback)
+            {
+                _lock.Lock();
+
+                ASSERT((outbound.IsValid() == true) && (callback != nullptr));
+
+                do {
+                    _sequence++;
+                } while ((_sequence == 0) || (_outbound.find(_sequence) != _outbound.end()));
+
+                uint32_t result = _sequence;
+
+                _outbound.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(result),
+                    std::forward_as_tuple(outbound, callback));
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+            bool AbortOutbound(const uint32_t sequence)
             {
                 bool result = false;
 
                 _lock.Lock();
 
-                if (_outbound.IsValid() == true) {
+                OutboundMap::iterator index(_outbound.find(sequence));
+
+                if (index != _outbound.end()) {
 
                     result = true;
 
-                    if (_callback != nullptr) {
-                        _callback->Dispatch(*_outbound);
-                        _callback = nullptr;
+                    ProxyType<IIPC> abortedObject(index->second.Message);
+                    IDispatchType<IIPC>* callback(index->second.Callback);
+
+                    _outbound.erase(index);
+
+                    if (callback != nullptr) {
+                        callback->Dispatch(*abortedObject);
                     }
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+            bool AbortOutbound()
+            {
+                bool result = false;
+
+                _lock.Lock();
+
+                while (_outbound.empty() == false) {
+                    result |= AbortOutbound(_outbound.begin()->first);
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+            // Wrap a message to be send as part of the multiplexed call with the given sequence.
+            Core::ProxyType<IMessage> Sequence(const uint32_t sequence, const Core::ProxyType<IMessage>& message)
+            {
+                Core::ProxyType<Sequenced> element(_sequenced.Element());
+
+                element->Set(sequence, message);
+
+                return (Core::ProxyType<IMessage>(element));
+            }
+
+            // The sequence to send the response to this inbound call with, 0 if it was not multiplexed.
+            uint32_t Reply(const Core::ProxyType<IIPC>& inbound)
+            {
+                uint32_t result = 0;
+
+                _lock.Lock();
+
+                ReplyMap::iterator index(_replies.find(&(*inbound)));
+
+                if (index != _replies.end()) {
+                    result = index->second;
+                    _replies.erase(index);
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+
+        private:
+            ProxyType<IMessage> Element(const uint32_t identifier, const uint32_t sequence)
+            {
+                ProxyType<IMessage> result;
+                uint32_t searchIdentifier(identifier >> 1);
+
+                _lock.Lock();
 
-                    _outbound.Release();
+                if (identifier & 0x01) {
+                    OutboundMap::const_iterator index(_outbound.find(sequence));
+
+                    if ((index != _outbound.end()) && (index->second.Message->Label() == searchIdentifier)) {
+                        result = index->second.Message->IResponse();
+                    } else {
+                        TRACE_L1("Unexpected response message for ID [%d].\n", searchIdentifier);
+                    }
                 } else {
-                    ASSERT(_callback == nullptr);
+                    ASSERT(_inbound.IsValid() == false);
+
+                    ProxyType<IIPC> rpcCall(_factory->Element(searchIdentifier));
+
+                    if (rpcCall.IsValid() == true) {
+                        _inbound = rpcCall;
+                        _inboundSequence = sequence;
+                        result = rpcCall->IParameters();
+                    } else {
+                        TRACE_L1("No RPC method definition for ID [%d].\n", searchIdentifier);
+                    }
                 }
 
                 _lock.Unlock();
@@ -683,8 +927,11 @@ POP_WARNING()
         private:
             mutable CriticalSection _lock;
             Core::ProxyType<IIPC> _inbound;
-            mutable Core::ProxyType<IIPC> _outbound;
-            IDispatchType<IIPC>* _callback;
+            uint32_t _inboundSequence;
+            OutboundMap _outbound;
+            ReplyMap _replies;
+            uint32_t _sequence;
+            Core::ProxyPoolType<Sequenced> _sequenced;
             Core::ProxyType<FactoryType<IIPC, uint32_t>> _factory;
             std::map<uint32_t, ProxyType<IIPCServer>> _handlers;
         };
@@ -692,6 +939,7 @@ POP_WARNING()
     protected:
         IPCChannel()
             : _administration()
+            , _multiplexed(false)
             , _customData(nullptr)
         {
         }
@@ -708,6 +956,7 @@ POP_WARNING()
 
         IPCChannel(Core::ProxyType<FactoryType<IIPC, uint32_t>>& factory)
             : _administration(factory)
+            , _multiplexed(false)
             , _customData(nullptr)
         {
         }
@@ -728,6 +977,17 @@ POP_WARNING()
         {
             _administration.AbortOutbound();
         }
+        // Calls on a multiplexed channel do not wait for each other, each carries a sequence number
+        // the response is matched on. Only enable it if the other side is known to support it, the
+        // receiving side always does. It is reset once the channel closes.
+        bool Multiplexed() const
+        {
+            return (_multiplexed);
+        }
+        void Multiplexed(const bool enabled)
+        {
+            _multiplexed = enabled;
+        }
         template <typename ACTUALELEMENT>
         uint32_t Invoke(const ProxyType<ACTUALELEMENT>& command, IDispatchType<IIPC>* completed)
         {
@@ -766,6 +1026,7 @@ POP_WARNING()
         IPCFactory _administration;
 
     private:
+        std::atomic<bool> _multiplexed;
         const void* _customData;
     };
 
@@ -796,7 +1057,9 @@ POP_WARNING()
                 ASSERT(inbound.IsValid() == true);
 
                 // This is an inbound call, Report what we have processed !!!
-                return (BaseClass::Submit(inbound->IResponse()));
+                const uint32_t sequence = _factory.Reply(inbound);
+
+                return (BaseClass::Submit(sequence == 0 ? inbound->IResponse() : _factory.Sequence(sequence, inbound->IResponse())));
             }
 
             // Notification of a INBOUND element received.
@@ -822,6 +1085,7 @@ POP_WARNING()
             {
                 if (_parent.Source().IsOpen() == false) {
                     // Whatever s hapening, Flush what we were doing..
+                    _parent.Multiplexed(false);
                     _parent.Abort();
                     _factory.Flush();
                 }
@@ -842,21 +1106,26 @@ POP_WARNING()
             IPCTrigger(IPCFactory& administration)
                 : _administration(administration)
                 , _signal(false, true)
+                , _sequence(0)
             {
             }
             ~IPCTrigger() override = default;
 
         public:
+            void Sequence(const uint32_t sequence)
+            {
+                _sequence = sequence;
+            }
             uint32_t Wait(const uint32_t waitTime)
             {
                 uint32_t result = Core::ERROR_NONE;
 
                 // Now we wait for ever, to get a signal that we are done :-)
                 if (_signal.Lock(waitTime) != Core::ERROR_NONE) {
-                    _administration.AbortOutbound();
+                    _administration.AbortOutbound(_sequence);
 
                     result = Core::ERROR_TIMEDOUT;
-                } else if (_administration.AbortOutbound() == true) {
+                } else if (_administration.AbortOutbound(_sequence) == true) {
                     result = Core::ERROR_ASYNC_FAILED;
                 }
 
@@ -870,6 +1139,7 @@ POP_WARNING()
         private:
             IPCFactory& _administration;
             Event _signal;
+            uint32_t _sequence;
         };
 
     public:
@@ -949,22 +1219,33 @@ POP_WARNING()
         {
             uint32_t success = Core::ERROR_UNAVAILABLE;
 
-            _serialize.Lock();
+            if (Multiplexed() == true) {
+                // No need to serialize, the response is matched on the sequence number.
+                if (_link.IsOpen() == true) {
+                    const uint32_t sequence = _administration.AddOutbound(command, completed);
 
-            if (_administration.InProgress() == true) {
-                success = Core::ERROR_INPROGRESS;
-            } else if (_link.IsOpen() == true) {
-                // We need to accept a CONST object to avoid an additional object creation
-                // proxy casted objects.
-                _administration.SetOutbound(command, completed);
+                    _link.Submit(_administration.Sequence(sequence, command->IParameters()));
 
-                // Send out the
-                _link.Submit(command->IParameters());
+                    success = Core::ERROR_NONE;
+                }
+            } else {
+                _serialize.Lock();
 
-                success = Core::ERROR_NONE;
-            }
+                if (_administration.InProgress() == true) {
+                    success = Core::ERROR_INPROGRESS;
+                } else if (_link.IsOpen() == true) {
+                    // We need to accept a CONST object to avoid an additional object creation
+                    // proxy casted objects.
+                    _administration.SetOutbound(command, completed);
+
+                    // Send out the
+                    _link.Submit(command->IParameters());
 
-            _serialize.Unlock();
+                    success = Core::ERROR_NONE;
+                }
+
+                _serialize.Unlock();
+            }
 
             return (success);
         }
@@ -972,22 +1253,36 @@ POP_WARNING()
         {
             uint32_t success = Core::ERROR_CONNECTION_CLOSED;
 
-            _serialize.Lock();
+            if (Multiplexed() == true) {
+                // No need to serialize, the response is matched on the sequence number.
+                if (_link.IsOpen() == true) {
+                    IPCTrigger sink(_administration);
+                    const uint32_t sequence = _administration.AddOutbound(command, &sink);
 
-            if (_link.IsOpen() == true) {
-                IPCTrigger sink(_administration);
+                    sink.Sequence(sequence);
 
-                // We need to accept a CONST object to avoid an additional object creation
-                // proxy casted objects.
-                _administration.SetOutbound(command, &sink);
+                    _link.Submit(_administration.Sequence(sequence, command->IParameters()));
 
-                // Send out the
-                _link.Submit(command->IParameters());
+                    success = sink.Wait(waitTime);
+                }
+            } else {
+                _serialize.Lock();
 
-                success = sink.Wait(waitTime);
-            }
+                if (_link.IsOpen() == true) {
+                    IPCTrigger sink(_administration);
 
-            _serialize.Unlock();
+                    // We need to accept a CONST object to avoid an additional object creation
+                    // proxy casted objects.
+                    _administration.SetOutbound(command, &sink);
+
+                    // Send out the
+                    _link.Submit(command->IParameters());
+
+                    success = sink.Wait(waitTime);
+                }
+
+                _serialize.Unlock();
+            }
 
             return (success);
         }
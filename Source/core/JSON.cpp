@@ -21,6 +21,15 @@
 #include <iomanip>
 #include <sstream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define __JSON_SCANNER_SSE2__
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __JSON_SCANNER_AVX2__
+#include <immintrin.h>
+#endif
+#endif
+
 namespace WPEFramework {
 namespace Core {
     namespace JSON {
@@ -37,6 +46,276 @@ namespace Core {
         }
 
 
+        namespace {
+
+            // The characters each of the scans stops at, as a single character and as a block of them.
+            struct TextStop {
+                static bool Is(const char character)
+                {
+                    // Signed, like the element parsers look at it, so anything above 0x7F stops as well.
+                    return ((character == '\"') || (character == '\\') || (static_cast<signed char>(character) < 0x20));
+                }
+#ifdef __JSON_SCANNER_SSE2__
+                static __m128i Is(const __m128i block)
+                {
+                    return (_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\"')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'))), _mm_cmplt_epi8(block, _mm_set1_epi8(0x20))));
+                }
+#endif
+#ifdef __JSON_SCANNER_AVX2__
+                __attribute__((target("avx2"))) static __m256i Is(const __m256i block)
+                {
+                    return (_mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\"')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\\'))), _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), block)));
+                }
+#endif
+            };
+
+            struct QuotedStop {
+                static bool Is(const char character)
+                {
+                    return (character == '\"');
+                }
+#ifdef __JSON_SCANNER_SSE2__
+                static __m128i Is(const __m128i block)
+                {
+                    return (_mm_cmpeq_epi8(block, _mm_set1_epi8('\"')));
+                }
+#endif
+#ifdef __JSON_SCANNER_AVX2__
+                __attribute__((target("avx2"))) static __m256i Is(const __m256i block)
+                {
+                    return (_mm256_cmpeq_epi8(block, _mm256_set1_epi8('\"')));
+                }
+#endif
+            };
+
+            struct SpaceStop {
+                static bool Is(const char character)
+                {
+                    return ((character == ' ') || ((character >= '\t') && (character <= '\r')));
+                }
+#ifdef __JSON_SCANNER_SSE2__
+                static __m128i Is(const __m128i block)
+                {
+                    // '\t' up to '\r' are the only bytes that, moved down by '\t', end up at 4 or less.
+                    const __m128i shifted = _mm_sub_epi8(block, _mm_set1_epi8('\t'));
+                    return (_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)), shifted)));
+                }
+#endif
+#ifdef __JSON_SCANNER_AVX2__
+                __attribute__((target("avx2"))) static __m256i Is(const __m256i block)
+                {
+                    const __m256i shifted = _mm256_sub_epi8(block, _mm256_set1_epi8('\t'));
+                    return (_mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, _mm256_set1_epi8(4)), shifted)));
+                }
+#endif
+            };
+
+            struct OpaqueStop {
+                static bool Is(const char character)
+                {
+                    return ((character == '{') || (character == '}') || (character == '[') || (character == ']') || (character == ',') || (character == '\"') || (character == '\0') || (SpaceStop::Is(character) == true));
+                }
+#ifdef __JSON_SCANNER_SSE2__
+                static __m128i Is(const __m128i block)
+                {
+                    // '[' and ']' as well as '{' and '}' only differ in one bit.
+                    const __m128i brackets = _mm_or_si128(block, _mm_set1_epi8(0x20));
+                    __m128i result = _mm_or_si128(_mm_cmpeq_epi8(brackets, _mm_set1_epi8('{')), _mm_cmpeq_epi8(brackets, _mm_set1_epi8('}')));
+                    result = _mm_or_si128(result, _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(',')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\"'))));
+                    return (_mm_or_si128(result, _mm_or_si128(_mm_cmpeq_epi8(block, _mm_setzero_si128()), SpaceStop::Is(block))));
+                }
+#endif
+#ifdef __JSON_SCANNER_AVX2__
+                __attribute__((target("avx2"))) static __m256i Is(const __m256i block)
+                {
+                    const __m256i brackets = _mm256_or_si256(block, _mm256_set1_epi8(0x20));
+                    __m256i result = _mm256_or_si256(_mm256_cmpeq_epi8(brackets, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(brackets, _mm256_set1_epi8('}')));
+                    result = _mm256_or_si256(result, _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(',')), _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\"'))));
+                    return (_mm256_or_si256(result, _mm256_or_si256(_mm256_cmpeq_epi8(block, _mm256_setzero_si256()), SpaceStop::Is(block))));
+                }
+#endif
+            };
+
+#ifdef __JSON_SCANNER_SSE2__
+            inline uint16_t FirstBit(const uint32_t mask)
+            {
+#ifdef _MSC_VER
+                unsigned long index;
+                _BitScanForward(&index, mask);
+                return (static_cast<uint16_t>(index));
+#else
+                return (static_cast<uint16_t>(__builtin_ctz(mask)));
+#endif
+            }
+#endif
+
+            // Runs while STOP says so, for the whitespace it is the other way around.
+            template <typename STOP, const bool UNTIL>
+            uint16_t ScanScalar(const char stream[], const uint16_t length, uint16_t index)
+            {
+                while ((index < length) && (STOP::Is(stream[index]) != UNTIL)) {
+                    index++;
+                }
+                return (index);
+            }
+
+#ifdef __JSON_SCANNER_SSE2__
+            template <typename STOP, const bool UNTIL>
+            uint16_t ScanSSE2(const char stream[], const uint16_t length)
+            {
+                uint16_t index = 0;
+
+                while ((index + 16) <= length) {
+                    uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(STOP::Is(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&(stream[index]))))));
+
+                    if (UNTIL == false) {
+                        mask ^= 0xFFFF;
+                    }
+                    if (mask != 0) {
+                        return (index + FirstBit(mask));
+                    }
+                    index += 16;
+                }
+
+                return (ScanScalar<STOP, UNTIL>(stream, length, index));
+            }
+#endif
+
+#ifdef __JSON_SCANNER_AVX2__
+            template <typename STOP, const bool UNTIL>
+            __attribute__((target("avx2"))) uint16_t ScanAVX2(const char stream[], const uint16_t length)
+            {
+                uint16_t index = 0;
+
+                while ((index + 32) <= length) {
+                    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(STOP::Is(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&(stream[index]))))));
+
+                    if (UNTIL == false) {
+                        mask = ~mask;
+                    }
+                    if (mask != 0) {
+                        return (index + FirstBit(mask));
+                    }
+                    index += 32;
+                }
+
+                if ((index + 16) <= length) {
+                    return (index + ScanSSE2<STOP, UNTIL>(&(stream[index]), length - index));
+                }
+
+                return (ScanScalar<STOP, UNTIL>(stream, length, index));
+            }
+#endif
+
+            template <typename STOP, const bool UNTIL>
+            uint16_t Scan(const char stream[], const uint16_t length)
+            {
+                uint16_t result;
+
+                // Short runs (keys, numbers, a single whitespace) are not worth setting up a block for.
+                if ((length < 16) || (STOP::Is(stream[0]) == UNTIL)) {
+                    result = ScanScalar<STOP, UNTIL>(stream, length, 0);
+                }
+#ifdef __JSON_SCANNER_AVX2__
+                else if (length >= 32) {
+                    static const bool avx2 = (__builtin_cpu_supports("avx2") != 0);
+                    result = (avx2 == true ? ScanAVX2<STOP, UNTIL>(stream, length) : ScanSSE2<STOP, UNTIL>(stream, length));
+                }
+#endif
+                else {
+#ifdef __JSON_SCANNER_SSE2__
+                    result = ScanSSE2<STOP, UNTIL>(stream, length);
+#else
+                    result = ScanScalar<STOP, UNTIL>(stream, length, 0);
+#endif
+                }
+
+                return (result);
+            }
+        }
+
+        /* static */ uint16_t Scanner::Text(const char stream[], const uint16_t length)
+        {
+            return (Scan<TextStop, true>(stream, length));
+        }
+
+        /* static */ uint16_t Scanner::Quoted(const char stream[], const uint16_t length)
+        {
+            return (Scan<QuotedStop, true>(stream, length));
+        }
+
+        /* static */ uint16_t Scanner::Opaque(const char stream[], const uint16_t length)
+        {
+            return (Scan<OpaqueStop, true>(stream, length));
+        }
+
+        /* static */ uint16_t Scanner::Whitespace(const char stream[], const uint16_t length)
+        {
+            return (Scan<SpaceStop, false>(stream, length));
+        }
+
+        Container::FieldTable::FieldTable(std::initializer_list<Field> fields)
+            : _fields()
+            , _slots()
+            , _seed(0)
+            , _mask(0)
+        {
+            _fields.reserve(fields.size());
+
+            for (const Field& field : fields) {
+                std::vector<Field>::const_iterator index(_fields.begin());
+
+                while ((index != _fields.end()) && (::strcmp(index->Label, field.Label) != 0)) {
+                    index++;
+                }
+
+                // Like with Add, the first field with a label is the one that is found.
+                ASSERT(index == _fields.end());
+
+                if (index == _fields.end()) {
+                    _fields.push_back(field);
+                }
+            }
+
+            // Look for a seed that gives every label a slot of its own, in a table of at least twice the fields.
+            // If none of the seeds tried does, the table is doubled. This is done once per container type.
+            uint32_t size = 4;
+
+            while (size < (_fields.size() * 2)) {
+                size <<= 1;
+            }
+
+            bool perfect = false;
+
+            while (perfect == false) {
+                _slots.assign(size, 0);
+                _mask = size - 1;
+
+                _seed = 0;
+
+                while ((perfect == false) && (_seed < 256)) {
+                    uint16_t index = 0;
+
+                    std::fill(_slots.begin(), _slots.end(), 0);
+
+                    while ((index < _fields.size()) && (_slots[Hash(_fields[index].Label, _seed) & _mask] == 0)) {
+                        _slots[Hash(_fields[index].Label, _seed) & _mask] = (index + 1);
+                        index++;
+                    }
+
+                    perfect = (index == _fields.size());
+
+                    if (perfect == false) {
+                        _seed++;
+                    }
+                }
+
+                if (perfect == false) {
+                    size <<= 1;
+                }
+            }
+        }
+
         /* static */ char IElement::NullTag[5] = { 'n', 'u', 'l', 'l', '\0' };
         /* static */ char IElement::TrueTag[5] = { 't', 'r', 'u', 'e', '\0' };
         /* static */ char IElement::FalseTag[6] = { 'f', 'a', 'l', 's', 'e', '\0' };
@@ -82,6 +82,20 @@ namespace Core {
 
         string EXTERNAL ErrorDisplayMessage(const Error& err);
 
+        // Looks, a block at a time (SSE2/AVX2 where available), for the next character the element
+        // parsers have to act upon. Everything in between can be taken over as is. Each returns the
+        // number of characters, from the start of the stream, that can be skipped or copied.
+        struct EXTERNAL Scanner {
+            // Up to a quote, a backslash or a control character (the end of plain text in a string).
+            static uint16_t Text(const char stream[], const uint16_t length);
+            // Up to a quote (the end of a quoted area in an opaque string).
+            static uint16_t Quoted(const char stream[], const uint16_t length);
+            // Up to a bracket, a brace, a comma, a quote, a whitespace or a '\0' (opaque string content).
+            static uint16_t Opaque(const char stream[], const uint16_t length);
+            // Up to the first character that is not a whitespace.
+            static uint16_t Whitespace(const char stream[], const uint16_t length);
+        };
+
         struct EXTERNAL IElement {
 
             static TCHAR NullTag[5];
@@ -1576,6 +1590,19 @@ namespace Core {
                 return (*this);
             }
 
+            // Takes over the text, e.g. a result that is only produced to be sent.
+            String& operator=(string&& RHS)
+            {
+#ifdef _UNICODE
+                Core::ToString(RHS.c_str(), _value);
+#else
+                _value = std::move(RHS);
+#endif
+                _flagsAndCounters |= SetBit;
+
+                return (*this);
+            }
+
             String& operator=(const char RHS[])
             {
                 Core::ToString(RHS, _value);
@@ -1674,6 +1701,20 @@ namespace Core {
                 return (((_flagsAndCounters & (SetBit | NullBit)) == SetBit) ? Core::ToString(_value.c_str()) : Core::ToString(_default.c_str()));
             }
 
+            // The same as Value(), but without copying the text, as long as it is kept as it was parsed or set.
+            // Only if it has to be converted (e.g. requoted, or it is the default), the given buffer is used. The
+            // reference is valid as long as this String and the buffer are left as they are.
+            inline const string& Value(string& buffer) const
+            {
+#ifndef _UNICODE
+                if (((_flagsAndCounters & (SetBit | NullBit)) == SetBit) && ((_flagsAndCounters & (QuoteFoundBit | QuotedSerializeBit)) != QuoteFoundBit)) {
+                    return (_value);
+                }
+#endif
+                buffer = Value();
+                return (buffer);
+            }
+
             inline const string& Default() const
             {
                 return (_default);
@@ -1885,7 +1926,14 @@ namespace Core {
                     // What are we deserializing a string, or an opaque JSON object!!!
                     if ((_flagsAndCounters & QuoteFoundBit) == 0) {
 
-                        if ((_flagsAndCounters & QuotedAreaBit) == 0) {
+                        // Whatever does not change the scope or the quoting, is taken over in one go.
+                        const uint16_t run = ((_flagsAndCounters & QuotedAreaBit) != 0 ? Scanner::Quoted(&(stream[result]), maxLength - result) : Scanner::Opaque(&(stream[result]), maxLength - result));
+
+                        if (run != 0) {
+                            _value.append(&(stream[result]), run);
+                            result += run;
+                        }
+                        else if ((_flagsAndCounters & QuotedAreaBit) == 0) {
                             // It's an opaque structure, so *no* decoding required. Leave as is !
                             if (current == '{') {
                                 if (InScope(ScopeBracket::CURLY_BRACKET) == false) {
@@ -1913,7 +1961,7 @@ namespace Core {
                             }
                         }
 
-                        if (finished == false) {
+                        if ((run == 0) && (finished == false)) {
                             if ((_flagsAndCounters & QuotedAreaBit) != 0) {
                                 // Write the amount we possibly can..
                                 _value += current;
@@ -1940,20 +1988,28 @@ namespace Core {
                     }
                     // Since it is a "real" string translate back all escaped stuff.. are we in an unescaping mode?
                     else if ((_flagsAndCounters & SpecialSequenceBit) == 0x00) {
-                        // Nope we are not, so see if we need to start it and otherwise, just copy...
-                        if (current == '\\') {
-                            // And we need to start it.
-                            _flagsAndCounters |= SpecialSequenceBit;
-                        } else if (current == '\"') {
-                            // We are done! leave this element.
-                            finished = true;
-                        } else if (current <= 0x1F) {
-                            error = Error{ "Unescaped control character detected" };
+                        // Nope we are not, copy all plain text up to the next character that needs attention.
+                        const uint16_t run = Scanner::Text(&(stream[result]), maxLength - result);
+
+                        if (run != 0) {
+                            _value.append(&(stream[result]), run);
+                            result += run;
                         } else {
-                            // Just copy and onto the next;
-                            _value += current;
+                            // See if we need to start it and otherwise, just copy...
+                            if (current == '\\') {
+                                // And we need to start it.
+                                _flagsAndCounters |= SpecialSequenceBit;
+                            } else if (current == '\"') {
+                                // We are done! leave this element.
+                                finished = true;
+                            } else if (current <= 0x1F) {
+                                error = Error{ "Unescaped control character detected" };
+                            } else {
+                                // Just copy and onto the next;
+                                _value += current;
+                            }
+                            result++;
                         }
-                        result++;
                     }
                     else if ((_flagsAndCounters & 0xFF) == 0x00) {
 
@@ -3267,9 +3323,7 @@ namespace Core {
                 uint16_t loaded = 0;
                 // Run till we find opening bracket..
                 if (offset == FIND_MARKER) {
-                    while ((loaded < maxLength) && ::isspace(stream[loaded])) {
-                        loaded++;
-                    }
+                    loaded += Scanner::Whitespace(&(stream[loaded]), maxLength - loaded);
                 }
 
                 if (loaded == maxLength) {
@@ -3298,9 +3352,7 @@ namespace Core {
                 while ((offset != FIND_MARKER) && (loaded < maxLength)) {
                     if ((offset == SKIP_BEFORE) || (offset == SKIP_AFTER)) {
                         // Run till we find a character not a whitespace..
-                        while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
-                            loaded++;
-                        }
+                        loaded += Scanner::Whitespace(&(stream[loaded]), maxLength - loaded);
 
                         if (loaded < maxLength) {
                             switch (stream[loaded]) {
@@ -3457,6 +3509,82 @@ namespace Core {
             typedef std::pair<const TCHAR*, IElement*> JSONLabelValue;
             typedef std::list<JSONLabelValue> JSONElementList;
 
+        public:
+            /**
+            * @brief The fields of a container type, declared once and shared by all its instances. A container that
+            *        is constructed with a table, does not Add these fields, and finds the labels it parses through a
+            *        perfect hash. Fields that are Added on top of it, come after the ones in the table.
+            */
+            class EXTERNAL FieldTable {
+            public:
+                using Accessor = IElement* (*)(Container&);
+
+                struct Field {
+                    const TCHAR* Label;
+                    Accessor Element;
+                };
+
+            public:
+                FieldTable() = delete;
+                FieldTable(const FieldTable&) = delete;
+                FieldTable& operator=(const FieldTable&) = delete;
+
+                FieldTable(std::initializer_list<Field> fields);
+                ~FieldTable() = default;
+
+            public:
+                uint16_t Count() const
+                {
+                    return (static_cast<uint16_t>(_fields.size()));
+                }
+                const TCHAR* Label(const uint16_t index) const
+                {
+                    ASSERT(index < Count());
+
+                    return (_fields[index].Label);
+                }
+                IElement* Element(Container& parent, const uint16_t index) const
+                {
+                    ASSERT(index < Count());
+
+                    return (_fields[index].Element(parent));
+                }
+                // Returns Count() if the label is not in the table.
+                uint16_t Index(const TCHAR label[]) const
+                {
+                    const uint16_t slot = _slots[Hash(label, _seed) & _mask];
+
+                    return (((slot != 0) && (::strcmp(_fields[slot - 1].Label, label) == 0)) ? (slot - 1) : Count());
+                }
+
+            private:
+                static uint32_t Hash(const TCHAR label[], const uint32_t seed)
+                {
+                    // FNV-1a, seeded, with the high bits folded in as only the low ones select a slot.
+                    uint32_t result = (2166136261u ^ seed);
+
+                    while (*label != '\0') {
+                        result = (result ^ static_cast<uint8_t>(*label++)) * 16777619u;
+                    }
+
+                    return (result ^ (result >> 16));
+                }
+
+            private:
+                std::vector<Field> _fields;
+                std::vector<uint16_t> _slots;
+                uint32_t _seed;
+                uint32_t _mask;
+            };
+
+            // The accessor of a field in the table, use JSON_CONTAINER_FIELD to declare one.
+            template <typename CONTAINER, typename TYPE, TYPE CONTAINER::*MEMBER>
+            static IElement* Member(Container& parent)
+            {
+                return (&(static_cast<CONTAINER&>(parent).*MEMBER));
+            }
+
+        private:
             class Iterator {
             private:
                 enum State {
@@ -3533,8 +3661,19 @@ namespace Core {
             Container()
                 : _state(0)
                 , _count(0)
+                , _fields(nullptr)
                 , _data()
-                , _iterator()
+                , _position()
+                , _fieldName(true)
+            {
+                ::memset(&_current, 0, sizeof(_current));
+            }
+            Container(const FieldTable& fields)
+                : _state(0)
+                , _count(0)
+                , _fields(&fields)
+                , _data()
+                , _position()
                 , _fieldName(true)
             {
                 ::memset(&_current, 0, sizeof(_current));
@@ -3553,19 +3692,21 @@ namespace Core {
                     index++;
                 }
 
-                return (index != _data.end());
+                return ((index != _data.end()) || ((TableSize() != 0) && (_fields->Index(label.c_str()) < TableSize())));
             }
 
             // IElement and IMessagePack iface:
             bool IsSet() const override
             {
-                JSONElementList::const_iterator index = _data.begin();
+                Position position;
+
+                Begin(position);
                 // As long as we did not find a set element, continue..
-                while ((index != _data.end()) && (index->second->IsSet() == false)) {
-                    index++;
+                while ((IsValid(position) == true) && (Element(position)->IsSet() == false)) {
+                    Next(position);
                 }
 
-                return (index != _data.end());
+                return (IsValid(position));
             }
 
             bool IsNull() const override
@@ -3576,12 +3717,12 @@ namespace Core {
 
             void Clear() override
             {
-                JSONElementList::const_iterator index = _data.begin();
+                Position position;
 
-                // As long as we did not find a set element, continue..
-                while (index != _data.end()) {
-                    index->second->Clear();
-                    index++;
+                Begin(position);
+                while (IsValid(position) == true) {
+                    Element(position)->Clear();
+                    Next(position);
                 }
                 _state = 0;
             }
@@ -3593,6 +3734,15 @@ namespace Core {
 
             void Remove(const TCHAR label[])
             {
+                const uint16_t field = (TableSize() != 0 ? _fields->Index(label) : 0);
+
+                if (field < TableSize()) {
+                    // Rarely done, so rather than keeping track of removed table fields in every instance,
+                    // this instance continues with its table fields added, and drops the one to remove.
+                    label = _fields->Label(field);
+                    Detach();
+                }
+
                 JSONElementList::iterator index(_data.begin());
 
                 while ((index != _data.end()) && (index->first != label)) {
@@ -3610,12 +3760,12 @@ namespace Core {
                 uint16_t loaded = 0;
 
                 if (offset == FIND_MARKER) {
-                    _iterator = _data.begin();
+                    Begin(_position);
                     stream[loaded++] = '{';
 
-                    offset = (_iterator == _data.end() ? ~0 : ((_iterator->second->IsSet() == false) && (FindNext() == false)) ? ~0 : BEGIN_MARKER);
+                    offset = (IsValid(_position) == false ? ~0 : ((Element(_position)->IsSet() == false) && (FindNext() == false)) ? ~0 : BEGIN_MARKER);
                     if (offset == BEGIN_MARKER) {
-                        _fieldName = string(_iterator->first);
+                        _fieldName = string(Label(_position));
                         _current.json = &_fieldName;
                         offset = PARSE;
                     }
@@ -3631,12 +3781,12 @@ namespace Core {
                     } else if (offset == BEGIN_MARKER) {
                         if (_current.json == &_fieldName) {
                             stream[loaded++] = ':';
-                            _current.json = _iterator->second;
+                            _current.json = Element(_position);
                             offset = PARSE;
                         } else {
                             if (FindNext() != false) {
                                 stream[loaded++] = ',';
-                                _fieldName = string(_iterator->first);
+                                _fieldName = string(Label(_position));
                                 _current.json = &_fieldName;
                                 offset = PARSE;
                             } else {
@@ -3663,9 +3813,7 @@ namespace Core {
                 uint16_t loaded = 0;
                 // Run till we find opening bracket..
                 if (offset == FIND_MARKER) {
-                    while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
-                        loaded++;
-                    }
+                    loaded += Scanner::Whitespace(&(stream[loaded]), maxLength - loaded);
                 }
 
                 if (loaded == maxLength) {
@@ -3695,14 +3843,12 @@ namespace Core {
                 while ((offset != FIND_MARKER) && (loaded < maxLength)) {
                     if ((offset == SKIP_BEFORE) || (offset == SKIP_AFTER) || offset == SKIP_BEFORE_VALUE || offset == SKIP_AFTER_KEY) {
                         // Run till we find a character not a whitespace..
-                        while ((loaded < maxLength) && (::isspace(stream[loaded]))) {
-                            loaded++;
-                        }
+                        loaded += Scanner::Whitespace(&(stream[loaded]), maxLength - loaded);
 
                         if (loaded < maxLength) {
                             switch (stream[loaded]) {
                             case '}':
-                                if (offset == SKIP_BEFORE && !_data.empty()) {
+                                if (offset == SKIP_BEFORE && ((TableSize() != 0) || (!_data.empty()))) {
                                     _state = ERROR;
                                     error = Error{ "Expected new element, \"}\" found." };
                                 } else if (offset == SKIP_BEFORE_VALUE || offset == SKIP_AFTER_KEY) {
@@ -3820,10 +3966,10 @@ namespace Core {
 
                 uint16_t elementSize = Size();
                 if (offset == 0) {
-                    _iterator = _data.begin();
+                    Begin(_position);
                     if (elementSize <= 15) {
                         stream[loaded++] = (0x80 | static_cast<uint8_t>(Size()));
-                        if (_iterator != _data.end()) {
+                        if (IsValid(_position) == true) {
                             offset = PARSE;
                         }
                     } else {
@@ -3831,10 +3977,10 @@ namespace Core {
                         offset = 1;
                     }
                     if (offset != 0) {
-                        if ((_iterator->second->IsSet() == false) && (FindNext() == false)) {
+                        if ((Element(_position)->IsSet() == false) && (FindNext() == false)) {
                             offset = 0;
                         } else {
-                            _fieldName = string(_iterator->first);
+                            _fieldName = string(Label(_position));
                         }
                     }
                 }
@@ -3856,7 +4002,7 @@ namespace Core {
                         }
                         offset += PARSE;
                     } else {
-                        const IMessagePack* element = dynamic_cast<const IMessagePack*>(_iterator->second);
+                        const IMessagePack* element = dynamic_cast<const IMessagePack*>(Element(_position));
                         if (element != nullptr) {
                             loaded += element->Serialize(&(stream[loaded]), maxLength - loaded, offset);
                             if (offset == 0) {
@@ -3868,7 +4014,7 @@ namespace Core {
                         offset += PARSE;
                         if (offset == PARSE) {
                             if (FindNext() != false) {
-                                _fieldName = string(_iterator->first);
+                                _fieldName = string(Label(_position));
                             } else {
                                offset = 0;
                                _fieldName.Clear();
@@ -3942,28 +4088,35 @@ namespace Core {
             void Reset()
             {
                 _data.clear();
+                _fields = nullptr;
             }
 
             IElement* Find(const char label[])
             {
                 IElement* result = nullptr;
+                const uint16_t field = (_fields != nullptr ? _fields->Index(label) : 0);
 
-                JSONElementList::iterator index = _data.begin();
-
-                while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
-                    index++;
+                if (field < TableSize()) {
+                    result = _fields->Element(*this, field);
                 }
+                else {
+                    JSONElementList::iterator index = _data.begin();
 
-                if (index != _data.end()) {
-                    result = index->second;
-                }
-                else if (Request(label) == true) {
-                    index = _data.end();
+                    while ((index != _data.end()) && (strcmp(label, index->first) != 0)) {
+                        index++;
+                    }
 
-                    while ((result == nullptr) && (index != _data.begin())) {
-                        index--;
-                        if (strcmp(label, index->first) == 0) {
-                            result = index->second;
+                    if (index != _data.end()) {
+                        result = index->second;
+                    }
+                    else if (Request(label) == true) {
+                        index = _data.end();
+
+                        while ((result == nullptr) && (index != _data.begin())) {
+                            index--;
+                            if (strcmp(label, index->first) == 0) {
+                                result = index->second;
+                            }
                         }
                     }
                 }
@@ -3972,24 +4125,24 @@ namespace Core {
 
             bool FindNext() const
             {
-                _iterator++;
-                while ((_iterator != _data.end()) && (_iterator->second->IsSet() == false)) {
-                    _iterator++;
+                Next(_position);
+                while ((IsValid(_position) == true) && (Element(_position)->IsSet() == false)) {
+                    Next(_position);
                 }
-                return (_iterator != _data.end());
+                return (IsValid(_position));
             }
 
             uint16_t Size() const
             {
                 uint16_t count = 0;
-                if (_data.size() > 0) {
-                    JSONElementList::const_iterator iterator = _data.begin();
-                    while (iterator != _data.end()) {
-                        if (iterator->second->IsSet() != false) {
-                            count++;
-                        }
-                        iterator++;
+                Position position;
+
+                Begin(position);
+                while (IsValid(position) == true) {
+                    if (Element(position)->IsSet() != false) {
+                        count++;
                     }
+                    Next(position);
                 }
                 return count;
             }
@@ -3999,6 +4152,55 @@ namespace Core {
                 return (false);
             }
 
+        private:
+            // Walks all fields, the ones in the table first, than the ones that were added.
+            struct Position {
+                uint16_t Index;
+                JSONElementList::const_iterator Iterator;
+            };
+
+            uint16_t TableSize() const
+            {
+                return (_fields != nullptr ? _fields->Count() : 0);
+            }
+            // Turns the table fields into added ones, in front of the fields that were added already.
+            void Detach()
+            {
+                const JSONElementList::iterator added(_data.begin());
+
+                for (uint16_t index = 0; index < TableSize(); index++) {
+                    _data.insert(added, JSONLabelValue(_fields->Label(index), _fields->Element(*this, index)));
+                }
+
+                _fields = nullptr;
+            }
+            void Begin(Position& position) const
+            {
+                position.Index = 0;
+                position.Iterator = _data.begin();
+            }
+            bool IsValid(const Position& position) const
+            {
+                return ((position.Index < TableSize()) || (position.Iterator != _data.end()));
+            }
+            void Next(Position& position) const
+            {
+                if (position.Index < TableSize()) {
+                    position.Index++;
+                }
+                else {
+                    position.Iterator++;
+                }
+            }
+            const TCHAR* Label(const Position& position) const
+            {
+                return (position.Index < TableSize() ? _fields->Label(position.Index) : position.Iterator->first);
+            }
+            IElement* Element(const Position& position) const
+            {
+                return (position.Index < TableSize() ? _fields->Element(const_cast<Container&>(*this), position.Index) : position.Iterator->second);
+            }
+
         private:
             uint8_t _state;
             uint16_t _count;
@@ -4006,8 +4208,9 @@ namespace Core {
                 mutable IElement* json;
                 mutable IMessagePack* pack;
             } _current;
+            const FieldTable* _fields;
             JSONElementList _data;
-            mutable JSONElementList::const_iterator _iterator;
+            mutable Position _position;
             mutable String _fieldName;
         };
 
@@ -4837,6 +5040,10 @@ namespace Core {
 } // namespace Core
 } // namespace WPEFramework
 
+// Declares a field in a Core::JSON::Container::FieldTable, e.g. JSON_CONTAINER_FIELD(Message, _T("id"), Id)
+#define JSON_CONTAINER_FIELD(CONTAINER, LABEL, MEMBER) \
+    { LABEL, &WPEFramework::Core::JSON::Container::Member<CONTAINER, decltype(CONTAINER::MEMBER), &CONTAINER::MEMBER> }
+
 using JsonObject = WPEFramework::Core::JSON::VariantContainer;
 using JsonValue = WPEFramework::Core::JSON::Variant;
 using JsonArray = WPEFramework::Core::JSON::ArrayType<JsonValue>;
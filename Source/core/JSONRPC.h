@@ -38,24 +38,18 @@ namespace Core {
             class Info : public Core::JSON::Container {
             public:
                 Info()
-                    : Core::JSON::Container()
+                    : Core::JSON::Container(Fields())
                     , Code(0)
                     , Text()
                     , Data(false)
                 {
-                    Add(_T("code"), &Code);
-                    Add(_T("message"), &Text);
-                    Add(_T("data"), &Data);
                 }
                 Info(const Info& copy)
-                    : Core::JSON::Container()
+                    : Core::JSON::Container(Fields())
                     , Code(0)
                     , Text()
                     , Data(false)
                 {
-                    Add(_T("code"), &Code);
-                    Add(_T("message"), &Text);
-                    Add(_T("data"), &Data);
                     Code = copy.Code;
                     Text = copy.Text;
                     Data = copy.Data;
@@ -106,6 +100,18 @@ namespace Core {
                         break;
                     }
                 }
+            private:
+                static const Core::JSON::Container::FieldTable& Fields()
+                {
+                    static const Core::JSON::Container::FieldTable fields({
+                        JSON_CONTAINER_FIELD(Info, _T("code"), Code),
+                        JSON_CONTAINER_FIELD(Info, _T("message"), Text),
+                        JSON_CONTAINER_FIELD(Info, _T("data"), Data) });
+
+                    return (fields);
+                }
+
+            public:
                 Core::JSON::DecSInt32 Code;
                 Core::JSON::String Text;
                 Core::JSON::String Data;
@@ -117,7 +123,7 @@ namespace Core {
             Message& operator=(const Message&) = delete;
 
             Message()
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , JSONRPC(DefaultVersion)
                 , Id(~0)
                 , Designator()
@@ -126,17 +132,10 @@ namespace Core {
                 , Error()
                 , _implicitCallsign()
             {
-                Add(_T("jsonrpc"), &JSONRPC);
-                Add(_T("id"), &Id);
-                Add(_T("method"), &Designator);
-                Add(_T("params"), &Parameters);
-                Add(_T("result"), &Result);
-                Add(_T("error"), &Error);
-
                 Clear();
             }
             Message(const Message& copy)
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , JSONRPC(copy.JSONRPC)
                 , Id(copy.Id)
                 , Designator(copy.Designator)
@@ -145,12 +144,6 @@ namespace Core {
                 , Error(copy.Error)
                 , _implicitCallsign(copy._implicitCallsign)
             {
-                Add(_T("jsonrpc"), &JSONRPC);
-                Add(_T("id"), &Id);
-                Add(_T("method"), &Designator);
-                Add(_T("params"), &Parameters);
-                Add(_T("result"), &Result);
-                Add(_T("error"), &Error);
             }
             ~Message() override = default;
 
@@ -318,6 +311,20 @@ namespace Core {
             Core::JSON::String Result;
             Info Error;
 
+        private:
+            static const Core::JSON::Container::FieldTable& Fields()
+            {
+                static const Core::JSON::Container::FieldTable fields({
+                    JSON_CONTAINER_FIELD(Message, _T("jsonrpc"), JSONRPC),
+                    JSON_CONTAINER_FIELD(Message, _T("id"), Id),
+                    JSON_CONTAINER_FIELD(Message, _T("method"), Designator),
+                    JSON_CONTAINER_FIELD(Message, _T("params"), Parameters),
+                    JSON_CONTAINER_FIELD(Message, _T("result"), Result),
+                    JSON_CONTAINER_FIELD(Message, _T("error"), Error) });
+
+                return (fields);
+            }
+
         private:
             string _implicitCallsign;
         };
@@ -162,12 +162,12 @@ namespace Core {
 
         public:
             // Methods to extract and insert data into the socket buffers
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
 
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -268,12 +268,12 @@ POP_WARNING()
         {
             _channel.Trigger();
         }
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
             // Serialize Response
             return (_serializerImpl.Serialize(dataFrame, maxSendSize));
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
             // Deserialize Request
             return (_deserialiserImpl.Deserialize(dataFrame, receivedSize));
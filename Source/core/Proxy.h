@@ -23,9 +23,12 @@
  // ---- Include system wide include files ----
 #include <memory>
 #include <atomic>
+#include <thread>
+#include <vector>
 
 // ---- Include local include files ----
 #include "Portability.h"
+#include "SlabAllocator.h"
 #include "StateTrigger.h"
 #include "Sync.h"
 #include "TypeTraits.h"
@@ -64,26 +67,20 @@ PUSH_WARNING(DISABLE_WARNING_MULTPILE_INHERITENCE_OF_BASE_CLASS)
             }
 
         public:
-            // Here we claim the buffer, plus some size for the buffer.
+            // Here we claim the buffer, plus some size for the buffer. The additional size is always
+            // kept, the allocator needs to know the size of the block again when it is freed.
             void*
                 operator new(
                     size_t stAllocateBlock,
                     unsigned int AdditionalSize)
             {
-                uint8_t* Space = nullptr;
-
                 // memory alignment
                 size_t alignedSize = ((stAllocateBlock + (sizeof(void*) - 1)) & (static_cast<size_t>(~(sizeof(void*) - 1))));
 
-                if (AdditionalSize != 0) {
-                    Space = reinterpret_cast<uint8_t*>(::malloc(alignedSize + sizeof(void*) + AdditionalSize));
+                uint8_t* Space = reinterpret_cast<uint8_t*>(ProxyAllocatorType<CONTEXT>::Allocate(alignedSize + sizeof(void*) + AdditionalSize));
 
-                    if (Space != nullptr) {
-                        *(reinterpret_cast<uint32_t*>(&Space[alignedSize])) = AdditionalSize;
-                    }
-                }
-                else {
-                    Space = reinterpret_cast<uint8_t*>(::malloc(alignedSize));
+                if (Space != nullptr) {
+                    *(reinterpret_cast<uint32_t*>(&Space[alignedSize])) = AdditionalSize;
                 }
 
                 return Space;
@@ -93,8 +90,11 @@ PUSH_WARNING(DISABLE_WARNING_MULTPILE_INHERITENCE_OF_BASE_CLASS)
                 operator delete(
                     void* stAllocateBlock)
             {
-                reinterpret_cast<ProxyObject<CONTEXT>*>(stAllocateBlock)->__Destructed();
-                ::free(stAllocateBlock);
+                size_t alignedSize = ((sizeof(ProxyObject<CONTEXT>) + (sizeof(void*) - 1)) & (static_cast<size_t>(~(sizeof(void*) - 1))));
+                ProxyObject<CONTEXT>* object = reinterpret_cast<ProxyObject<CONTEXT>*>(stAllocateBlock);
+
+                object->__Destructed();
+                ProxyAllocatorType<CONTEXT>::Free(stAllocateBlock, alignedSize + sizeof(void*) + object->Size());
             }
 
         public:
@@ -1420,7 +1420,110 @@ POP_WARNING()
         class ProxyPoolType {
         private:
             using ContainerElement = ProxyContainerType< ProxyPoolType<PROXYELEMENT>, PROXYELEMENT, PROXYELEMENT>;
-            using ContainerList = std::list< Core::ProxyType<ContainerElement> >;
+            using ContainerList = std::vector< Core::ProxyType<ContainerElement> >;
+
+            // The elements are handed out and taken back through magazines: small stacks, one per thread (or a few
+            // threads sharing one), that are only used by the thread that claimed it, so they need no lock. Only if
+            // the magazine runs empty, or full, the shared queue (the depot) is visited, and then for half a magazine
+            // at once.
+            static constexpr uint8_t Magazines = 8;
+            static constexpr uint8_t Capacity = 8;
+
+            class Magazine {
+            public:
+                Magazine(const Magazine&) = delete;
+                Magazine& operator=(const Magazine&) = delete;
+
+                Magazine()
+                    : _claimed(false)
+                    , _count(0)
+                    , _hits(0)
+                    , _elements()
+                {
+                }
+                ~Magazine() = default;
+
+            public:
+                bool Claim()
+                {
+                    return (_claimed.exchange(true, std::memory_order_acquire) == false);
+                }
+                void Vacate()
+                {
+                    _claimed.store(false, std::memory_order_release);
+                }
+                // Can be read by anyone, all others are only allowed by the one that claimed the magazine.
+                uint8_t Count() const
+                {
+                    return (_count.load(std::memory_order_relaxed));
+                }
+                uint32_t Hits() const
+                {
+                    return (_hits.load(std::memory_order_relaxed));
+                }
+                void Hit()
+                {
+                    _hits.store(_hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                }
+                bool IsFull() const
+                {
+                    return (Count() == Capacity);
+                }
+                bool Contains(const Core::ProxyType<ContainerElement>& element) const
+                {
+                    return (std::find(&(_elements[0]), &(_elements[Count()]), element) != &(_elements[Count()]));
+                }
+                void Push(Core::ProxyType<ContainerElement>&& element)
+                {
+                    const uint8_t count = Count();
+
+                    ASSERT(count < Capacity);
+
+                    _elements[count] = std::move(element);
+                    _count.store(count + 1, std::memory_order_relaxed);
+                }
+                bool Pop(Core::ProxyType<ContainerElement>& element)
+                {
+                    const uint8_t count = Count();
+
+                    if (count != 0) {
+                        element = std::move(_elements[count - 1]);
+                        _count.store(count - 1, std::memory_order_relaxed);
+                    }
+
+                    return (count != 0);
+                }
+                // Moves the oldest half to the depot, the most recently used ones are kept.
+                void Drain(ContainerList& depot)
+                {
+                    const uint8_t count = Count();
+                    const uint8_t half = (count / 2);
+
+                    for (uint8_t index = 0; index < half; index++) {
+                        depot.emplace_back(std::move(_elements[index]));
+                    }
+                    for (uint8_t index = half; index < count; index++) {
+                        _elements[index - half] = std::move(_elements[index]);
+                    }
+
+                    _count.store(count - half, std::memory_order_relaxed);
+                }
+
+            private:
+                std::atomic<bool> _claimed;
+                std::atomic<uint8_t> _count;
+                std::atomic<uint32_t> _hits;
+                Core::ProxyType<ContainerElement> _elements[Capacity];
+            };
+
+        public:
+            struct Metadata {
+                uint32_t Created;
+                uint32_t Queued;
+                uint32_t HighWater;
+                uint32_t Hits;
+                uint32_t Misses;
+            };
 
         public:
             ProxyPoolType(const ProxyPoolType<PROXYELEMENT>&) = delete;
@@ -1429,8 +1532,14 @@ POP_WARNING()
             template <typename... Args>
             ProxyPoolType(const uint32_t initialQueueSize, Args&&... args)
                 : _createdElements(initialQueueSize)
+                , _highWater(0)
+                , _misses(0)
+                , _queue()
+                , _magazines()
                 , _lock()
             {
+                _queue.reserve(initialQueueSize);
+
                 for (uint32_t index = 0; index < initialQueueSize; index++) {
                     Core::ProxyType<ContainerElement> newElement;
 
@@ -1444,13 +1553,30 @@ POP_WARNING()
                 // Clear the created objects..
                 uint16_t attempt = 500;
                 do {
+                    _lock.Lock();
+
+                    // Whatever is kept in the magazines, goes back to the depot first.
+                    for (Magazine& magazine : _magazines) {
+                        if (magazine.Claim() == true) {
+                            Core::ProxyType<ContainerElement> element;
+
+                            while (magazine.Pop(element) == true) {
+                                _queue.emplace_back(std::move(element));
+                            }
+
+                            magazine.Vacate();
+                        }
+                    }
+
+                    _lock.Unlock();
+
                     while (_queue.size() != 0) {
 
                         _lock.Lock();
 
-                        Core::ProxyType<ContainerElement> expendable(std::move(_queue.front()));
+                        Core::ProxyType<ContainerElement> expendable(std::move(_queue.back()));
                         expendable->Unlink();
-                        _queue.pop_front();
+                        _queue.pop_back();
                         _createdElements--;
 
                         _lock.Unlock();
@@ -1477,29 +1603,54 @@ POP_WARNING()
             {
                 Core::ProxyType<PROXYELEMENT> result;
                 Core::ProxyType<ContainerElement> element;
+                Magazine& magazine(_magazines[Slot()]);
+                const bool claimed = magazine.Claim();
 
-                _lock.Lock();
+                if ((claimed == true) && (magazine.Pop(element) == true)) {
+                    magazine.Hit();
+                }
+                else {
+                    _lock.Lock();
 
-                if (_queue.size() == 0) {
+                    _misses++;
 
-                    _createdElements++;
+                    if (_queue.size() == 0) {
+                        _createdElements++;
+                    }
+                    else {
+                        element = std::move(_queue.back());
+                        _queue.pop_back();
+
+                        if (claimed == true) {
+                            // Take a batch along, so the next ones are found in the magazine.
+                            while ((_queue.size() != 0) && (magazine.Count() < (Capacity / 2))) {
+                                magazine.Push(std::move(_queue.back()));
+                                _queue.pop_back();
+                            }
+                        }
+                    }
 
-                    _lock.Unlock();
+                    // Sampled on every visit to the depot, so it is exact whenever the pool has to grow.
+                    const uint32_t used = _createdElements - Queued();
+                    if (used > _highWater) {
+                        _highWater = used;
+                    }
 
-                    Core::ProxyType<ContainerElement>::template CreateMove(element, 0, *this, std::forward<Args>(args)...);
+                    _lock.Unlock();
+                }
 
-                    result = Core::ProxyType<PROXYELEMENT>(element);
+                if (claimed == true) {
+                    magazine.Vacate();
                 }
-                else {
-                    element = _queue.front();
-                    result = Core::ProxyType<PROXYELEMENT>(element);
-                    _queue.pop_front();
 
-                    _lock.Unlock();
+                if (element.IsValid() == false) {
+                    Core::ProxyType<ContainerElement>::template CreateMove(element, 0, *this, std::forward<Args>(args)...);
                 }
 
                 ASSERT(element.IsValid());
 
+                result = Core::ProxyType<PROXYELEMENT>(element);
+
                 // As it is removed from the queue, we will keep a "flying reference", this
                 // way if the user of ths object releases it, it will trigger the last
                 // refernce notification (Relinquish) prior to the user dropping the
@@ -1517,7 +1668,31 @@ POP_WARNING()
             }
             inline uint32_t QueuedElements() const
             {
-                return (static_cast<uint32_t>(_queue.size()));
+                _lock.Lock();
+                uint32_t result = Queued();
+                _lock.Unlock();
+
+                return (result);
+            }
+            Metadata Snapshot() const
+            {
+                Metadata result;
+
+                _lock.Lock();
+
+                result.Created = _createdElements;
+                result.Queued = Queued();
+                result.HighWater = _highWater;
+                result.Misses = _misses;
+                result.Hits = 0;
+
+                for (const Magazine& magazine : _magazines) {
+                    result.Hits += magazine.Hits();
+                }
+
+                _lock.Unlock();
+
+                return (result);
             }
             void Notify(Core::ProxyType<ContainerElement>& source)
             {
@@ -1526,25 +1701,70 @@ POP_WARNING()
                 // lets skip it for now..
                 // TODO: Call source->Relinquish(Core::ProxyType<PROXYELEMENT>&);
 
-                _lock.Lock();
-
+                // No one but us holds it, so it can be cleared before it is queued again.
                 source->Clear();
 
-                // Lets see if the source is already in there :-)
-                ASSERT(std::find(_queue.begin(), _queue.end(), source) == _queue.end());
+                Magazine& magazine(_magazines[Slot()]);
 
-                // TRACE_L1("Returned an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*element));
-                _queue.emplace_back(std::move(source));
+                if (magazine.Claim() == true) {
 
-                _lock.Unlock();
+                    if (magazine.IsFull() == true) {
+                        // Make room for the next ones, the oldest half goes back to the depot.
+                        _lock.Lock();
+
+                        magazine.Drain(_queue);
+
+                        _lock.Unlock();
+                    }
+
+                    // Lets see if the source is already in there :-)
+                    ASSERT(magazine.Contains(source) == false);
+
+                    magazine.Push(std::move(source));
+                    magazine.Vacate();
+                }
+                else {
+                    _lock.Lock();
+
+                    // Lets see if the source is already in there :-)
+                    ASSERT(std::find(_queue.begin(), _queue.end(), source) == _queue.end());
+
+                    // TRACE_L1("Returned an element for: %s [%p]\n", typeid(PROXYPOOLELEMENT).name(), &static_cast<PROXYPOOLELEMENT&>(*element));
+                    _queue.emplace_back(std::move(source));
+
+                    _lock.Unlock();
+                }
             }
             uint32_t Count() const {
                 return (_createdElements);
             }
 
+        private:
+            static uint8_t Slot()
+            {
+                // Spread the threads over the magazines, the (fibonacci) hash takes the top bits of the id.
+                const uint64_t id = static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+                return (static_cast<uint8_t>(((id * 0x9E3779B97F4A7C15ULL) >> 32) % Magazines));
+            }
+            // Only with the lock taken.
+            uint32_t Queued() const
+            {
+                uint32_t result = static_cast<uint32_t>(_queue.size());
+
+                for (const Magazine& magazine : _magazines) {
+                    result += magazine.Count();
+                }
+
+                return (result);
+            }
+
         private:
             uint32_t _createdElements;
+            uint32_t _highWater;
+            uint32_t _misses;
             ContainerList _queue;
+            Magazine _magazines[Magazines];
             mutable Core::CriticalSection _lock;
         };
 
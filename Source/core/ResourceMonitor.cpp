@@ -18,12 +18,15 @@
  */
  
 #include "ResourceMonitor.h"
+#include "Number.h"
 #include "Singleton.h"
 
 namespace WPEFramework {
 
 namespace Core {
 
+    /* static */ constexpr uint8_t ResourceMonitor::MaxReactors;
+
     /* static */ ResourceMonitor& ResourceMonitor::Instance()
     {
         // Tests build/destroy the ResourceMonitor for each test. In production the
@@ -37,5 +40,219 @@ namespace Core {
         return (_instance);
 #endif
     }
+
+    ResourceMonitor::ResourceMonitor()
+        : _adminLock()
+        , _reactorCount(1)
+        , _reactors()
+        , _load()
+        , _assignments()
+    {
+        _reactors[0] = new ResourceMonitorBase();
+    }
+
+    ResourceMonitor::~ResourceMonitor()
+    {
+        uint8_t index = _reactorCount.load(Core::memory_order::memory_order_acquire);
+
+        while (index != 0) {
+            index--;
+            delete _reactors[index];
+        }
+    }
+
+    void ResourceMonitor::Reactors(const uint8_t count)
+    {
+        ASSERT((count != 0) && (count <= MaxReactors));
+
+        _adminLock.Lock();
+
+        uint8_t index = _reactorCount.load(Core::memory_order::memory_order_relaxed);
+
+        ASSERT(count >= index);
+
+        for (; (index < count) && (index < MaxReactors); index++) {
+            _reactors[index] = new ResourceMonitorBase(_reactors[0]->Name() + (_T("::") + Core::NumberType<uint8_t>(index).Text()));
+            _load[index] = 0;
+
+            // Only now the new reactor can be seen by the ones that do not take the lock.
+            _reactorCount.store(index + 1, Core::memory_order::memory_order_release);
+        }
+
+        _adminLock.Unlock();
+    }
+
+    uint32_t ResourceMonitor::Runs() const
+    {
+        uint32_t result = 0;
+        const uint8_t count = Reactors();
+
+        for (uint8_t index = 0; index < count; index++) {
+            result += _reactors[index]->Runs();
+        }
+
+        return (result);
+    }
+
+    bool ResourceMonitor::IsReactor(const ::ThreadId id) const
+    {
+        uint8_t index = Reactors();
+
+        while ((index != 0) && (_reactors[index - 1]->Id() != id)) {
+            index--;
+        }
+
+        return (index != 0);
+    }
+
+    uint32_t ResourceMonitor::Count() const
+    {
+        uint32_t result = 0;
+        const uint8_t count = Reactors();
+
+        for (uint8_t index = 0; index < count; index++) {
+            result += _reactors[index]->Count();
+        }
+
+        return (result);
+    }
+
+    bool ResourceMonitor::Info(const uint32_t position, Metadata& info) const
+    {
+        bool found = false;
+        uint32_t offset = position;
+        const uint8_t count = Reactors();
+
+        for (uint8_t index = 0; (found == false) && (index < count); index++) {
+            const uint32_t entries = _reactors[index]->Count();
+
+            if (offset >= entries) {
+                offset -= entries;
+            }
+            else {
+                found = _reactors[index]->Info(offset, info);
+                info.reactor = index;
+            }
+        }
+
+        return (found);
+    }
+
+    void ResourceMonitor::Register(IResource& resource)
+    {
+        _adminLock.Lock();
+
+        uint8_t reactor = 0;
+        std::unordered_map<const IResource*, uint8_t>::const_iterator index(_assignments.find(&resource));
+
+        if (index != _assignments.cend()) {
+            // Registering twice is allowed, it should end up on the same reactor.
+            reactor = index->second;
+        }
+        else {
+            const uint8_t count = _reactorCount.load(Core::memory_order::memory_order_relaxed);
+
+            for (uint8_t entry = 1; entry < count; entry++) {
+                if (_load[entry] < _load[reactor]) {
+                    reactor = entry;
+                }
+            }
+
+            _load[reactor]++;
+            _assignments.emplace(&resource, reactor);
+        }
+
+        _adminLock.Unlock();
+
+        // Do not hold our lock while entering the reactor, the reactor holds its own
+        // lock while calling out to the resources, which might (un)register others.
+        Forward(reactor, resource, true);
+    }
+
+    void ResourceMonitor::Unregister(IResource& resource)
+    {
+        _adminLock.Lock();
+
+        std::unordered_map<const IResource*, uint8_t>::iterator index(_assignments.find(&resource));
+
+        if (index != _assignments.end()) {
+            const uint8_t reactor = index->second;
+
+            _load[reactor]--;
+            _assignments.erase(index);
+
+            _adminLock.Unlock();
+
+            Forward(reactor, resource, false);
+        }
+        else {
+            _adminLock.Unlock();
+        }
+    }
+
+    void ResourceMonitor::Break(IResource& resource)
+    {
+        _adminLock.Lock();
+
+        std::unordered_map<const IResource*, uint8_t>::const_iterator index(_assignments.find(&resource));
+        const uint8_t reactor = (index != _assignments.cend() ? index->second : MaxReactors);
+
+        _adminLock.Unlock();
+
+        if (reactor == MaxReactors) {
+            // Not (yet) assigned, no idea who is interested, so tell them all.
+            Break();
+        }
+        else if (_reactors[reactor]->Id() != 0) {
+            _reactors[reactor]->Break(resource);
+        }
+    }
+
+    void ResourceMonitor::Break()
+    {
+        const uint8_t count = Reactors();
+
+        for (uint8_t index = 0; index < count; index++) {
+            // A reactor that never had a resource to monitor, has no thread to break yet.
+            if (_reactors[index]->Id() != 0) {
+                _reactors[index]->Break();
+            }
+        }
+    }
+
+    void ResourceMonitor::Forward(const uint8_t reactor, IResource& resource, const bool subscribe)
+    {
+        ResourceMonitorBase& target = *_reactors[reactor];
+        const ::ThreadId caller = Thread::ThreadId();
+
+        uint8_t index = Reactors();
+
+        while ((index != 0) && (_reactors[index - 1]->Id() != caller)) {
+            index--;
+        }
+
+        if ((index == 0) || (index == (reactor + 1)) || (target.Id() == 0)) {
+            // Not called from within another reactor, so whatever lock the target reactor
+            // holds, it will release it without waiting for us.
+            if (subscribe == true) {
+                target.Register(resource);
+            }
+            else {
+                target.Unregister(resource);
+            }
+        }
+        else {
+            // The calling reactor holds its own lock, the target reactor might be waiting for it
+            // to (un)register a resource of its own. Hand this over and block until the target is
+            // done, or until another reactor hands something over to us, which we take care of.
+            ResourceMonitorBase& own = *_reactors[index - 1];
+            const uint32_t ticket = target.Post(resource, subscribe, own);
+
+            while (target.Handled(ticket) == false) {
+                own.Await();
+                own.Process();
+            }
+        }
+    }
 }
 } // namespace WPEFramework::Core
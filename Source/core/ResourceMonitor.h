@@ -27,6 +27,10 @@
 #include "Trace.h"
 #include "Timer.h"
 
+#if defined(__LINUX__) && !defined(__APPLE__) && defined(__CORE_RESOURCE_MONITOR_EPOLL__)
+#define __RESOURCE_MONITOR_EPOLL__
+#endif
+
 namespace WPEFramework {
 
 namespace Core {
@@ -49,6 +53,22 @@ namespace Core {
 
         typedef ResourceMonitorType<RESOURCE, WATCHDOG> Parent;
 
+#ifdef __RESOURCE_MONITOR_EPOLL__
+        static_assert((POLLIN == EPOLLIN) && (POLLPRI == EPOLLPRI) && (POLLOUT == EPOLLOUT) && (POLLERR == EPOLLERR) && (POLLHUP == EPOLLHUP) && (POLLRDHUP == EPOLLRDHUP),
+            "The events of an IResource are handed to epoll as is");
+
+        // The kernel holds the interest of each resource, this is what we
+        // need to know about it to detect changes and dispatch the result.
+        struct Registration {
+            RESOURCE* Resource;
+            uint16_t Monitor;
+            uint16_t Events;
+            uint32_t Run;
+        };
+
+        using Registrations = std::unordered_map<IResource::handle, Registration>;
+#endif
+
         ResourceMonitorType(const ResourceMonitorType&) = delete;
         ResourceMonitorType& operator=(const ResourceMonitorType&) = delete;
 
@@ -98,17 +118,39 @@ namespace Core {
 
     public:
         ResourceMonitorType()
+            : ResourceMonitorType(_T("Monitor::") + ClassNameOnly(typeid(RESOURCE).name()).Text())
+        {
+        }
+        explicit ResourceMonitorType(const string& name)
             : _monitor(nullptr)
-            , _adminLock()
+            , _adminLock(_T("Core::ResourceMonitor"))
             , _resourceList()
+            , _pendingLock()
+            , _pending()
+            , _waiting()
+            , _progress(false, false)
+#ifdef __RESOURCE_MONITOR_EPOLL__
+            , _dirty()
+            , _evaluate(false)
+#endif
+            , _posted(0)
+            , _handled(0)
             , _monitorRuns(0)
-            , _name(_T("Monitor::") + ClassNameOnly(typeid(RESOURCE).name()).Text())
+            , _name(name)
             , _watchDog(1024 * 512, _name.c_str())
 #ifdef __WINDOWS__
             , _action(WSACreateEvent())
 #else
             , _descriptorArrayLength(FileDescriptorAllocation)
+#ifdef __RESOURCE_MONITOR_EPOLL__
+            , _descriptorArray(static_cast<struct epoll_event*>(::malloc(sizeof(struct epoll_event) * _descriptorArrayLength)))
+            , _registrations()
+            , _epollDescriptor(-1)
+            , _update(true)
+            , _removed(false)
+#else
             , _descriptorArray(static_cast<struct pollfd*>(::malloc(sizeof(::pollfd) * (_descriptorArrayLength + 1))))
+#endif
             , _signalDescriptor(-1)
 #endif
         {
@@ -145,6 +187,11 @@ namespace Core {
             if (_signalDescriptor != -1) {
                 ::close(_signalDescriptor);
             }
+#ifdef __RESOURCE_MONITOR_EPOLL__
+            if (_epollDescriptor != -1) {
+                ::close(_epollDescriptor);
+            }
+#endif
 #endif
 #ifdef __WINDOWS__
             WSACloseEvent(_action);
@@ -179,13 +226,32 @@ namespace Core {
 
             bool found = (index != _resourceList.cend());
 
-            if (found == true) {
+            if ((found == true) && (*index == nullptr)) {
+                // Unregistered, but not yet taken out of the list by the monitor thread.
+                info.descriptor = IResource::INVALID;
+                info.classname = _T("");
+                info.monitor = 0;
+                info.events = 0;
+                info.filename[0] = '\0';
+            } else if (found == true) {
                 info.descriptor = (*index)->Descriptor();
                 info.classname  = typeid(*(*index)).name();
 
 #ifdef __LINUX__
+#ifdef __RESOURCE_MONITOR_EPOLL__
+                typename Registrations::const_iterator entry(_registrations.find(info.descriptor));
+
+                if ((entry != _registrations.cend()) && (entry->second.Resource == (*index))) {
+                    info.monitor = entry->second.Monitor;
+                    info.events  = (entry->second.Run == _monitorRuns ? entry->second.Events : 0);
+                } else {
+                    info.monitor = 0;
+                    info.events  = 0;
+                }
+#else
                 info.monitor = _descriptorArray[position + 1].events;
                 info.events  = _descriptorArray[position + 1].revents;
+#endif
 
                 char procfn[64];
                 sprintf(procfn, "/proc/self/fd/%d", info.descriptor);
@@ -208,23 +274,8 @@ namespace Core {
         {
             _adminLock.Lock();
 
-            // Make sure this entry is only registered once !!!
-            if (std::find(_resourceList.begin(), _resourceList.end(), &resource) == _resourceList.end()) {
-                _resourceList.push_back(&resource);
-            }
-
-            if (_resourceList.size() == 1) {
-                if (_monitor == nullptr) {
-                    _monitor = new MonitorWorker(*this);
-
-                    // Wait till we are at least initialized
-                    _monitor->Wait(Thread::BLOCKED | Thread::STOPPED);
-                }
-
-                _monitor->Run();
-            } else {
-                Break();
-            }
+            Flush();
+            Add(resource);
 
             _adminLock.Unlock();
         }
@@ -232,19 +283,82 @@ namespace Core {
         {
             _adminLock.Lock();
 
-            // Make sure this entry does not exist, only register resources once !!!
-            typename std::list<RESOURCE*>::iterator index(std::find(_resourceList.begin(), _resourceList.end(), &resource));
+            Flush();
+            Remove(resource);
 
-            if (index != _resourceList.end()) {
-                *index = nullptr;
-                Break();
-            }
+            _adminLock.Unlock();
+        }
+        // For the thread of another reactor. It holds its own lock while handling its resources, our
+        // thread might be waiting for that lock, so leave the (un)registration to our thread. The
+        // returned ticket tells, through Handled(), when it is done, the poster is woken up from its
+        // Await() as soon as that is the case.
+        uint32_t Post(RESOURCE& resource, const bool subscribe, ResourceMonitorType<RESOURCE, WATCHDOG>& poster)
+        {
+            ASSERT(_monitor != nullptr);
+
+            _pendingLock.Lock();
+
+            _pending.emplace_back(&resource, subscribe);
+            _waiting.push_back(&(poster._progress));
+
+            const uint32_t ticket = _posted.load(Core::memory_order::memory_order_relaxed) + 1;
+            _posted.store(ticket, Core::memory_order::memory_order_release);
+
+            // Still holding the pending lock, so our thread can not decide to block in the mean time.
+            _monitor->Run();
+            Signal();
+
+            // Our thread might be waiting in Await() for a reactor that waits for us.
+            _progress.SetEvent();
+
+            _pendingLock.Unlock();
+
+            return (ticket);
+        }
+        bool Handled(const uint32_t ticket) const
+        {
+            return (static_cast<int32_t>(_handled.load(Core::memory_order::memory_order_acquire) - ticket) >= 0);
+        }
+        // Blocks until something got posted to us, or something we posted got handled.
+        void Await()
+        {
+            _progress.Lock(Core::infinite);
+        }
+        // Take care of what other reactors posted, without waiting for our own thread to do so.
+        void Process()
+        {
+            _adminLock.Lock();
+
+            Flush();
 
             _adminLock.Unlock();
         }
+        // Offer all resources a chance to act.
         inline void Break()
         {
+#ifdef __RESOURCE_MONITOR_EPOLL__
+            _evaluate.store(true, Core::memory_order::memory_order_release);
+#endif
+            Signal();
+        }
+        // Offer only this resource a chance to act.
+        void Break(RESOURCE& resource)
+        {
+#ifdef __RESOURCE_MONITOR_EPOLL__
+            _pendingLock.Lock();
+            _dirty.push_back(&resource);
+            _pendingLock.Unlock();
+
+            Signal();
+#else
+            DEBUG_VARIABLE(resource);
+            Break();
+#endif
+        }
 
+    private:
+        inline void Signal()
+        {
             ASSERT(_monitor != nullptr);
 
 #ifdef __APPLE__
@@ -254,14 +368,16 @@ namespace Core {
                 sizeof(data), 0,
                 _signalNode,
                 _signalNode.Size());
+#elif defined(__RESOURCE_MONITOR_EPOLL__)
+            const uint64_t value = 1;
+            ssize_t VARIABLE_IS_NOT_USED length = ::write(_signalDescriptor, &value, sizeof(value));
 #elif defined(__LINUX__)
             _monitor->Signal(SIGUSR2);
 #elif defined(__WINDOWS__)
             ::WSASetEvent(_action);
 #endif
-        };
+        }
 
-    private:
         IS_MEMBER_AVAILABLE(Arm, hasArm);
 
         template <typename TYPE=WATCHDOG>
@@ -313,6 +429,16 @@ namespace Core {
                 }
             }
 
+#elif defined(__RESOURCE_MONITOR_EPOLL__)
+
+            _signalDescriptor = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            _epollDescriptor = ::epoll_create1(EPOLL_CLOEXEC);
+
+            if ((_epollDescriptor == -1) || (_signalDescriptor == -1) || (Subscribe(_signalDescriptor, POLLIN, false) == false)) {
+                TRACE_L1("Error on creating the epoll instance. Error %d", errno);
+                _signalDescriptor = -1;
+            }
+
 #else
 
             sigset_t sigset;
@@ -334,15 +460,128 @@ namespace Core {
 
             ASSERT(_signalDescriptor != -1);
 
+#ifndef __RESOURCE_MONITOR_EPOLL__
             _descriptorArray[0].fd = _signalDescriptor;
             _descriptorArray[0].events = POLLIN;
             _descriptorArray[0].revents = 0;
+#endif
 
             return (_signalDescriptor != -1 ? Core::ERROR_NONE : Core::ERROR_UNAVAILABLE);
         }
 #endif
 
-#ifdef __LINUX__
+#ifdef __RESOURCE_MONITOR_EPOLL__
+        uint32_t Worker()
+        {
+            uint32_t delay = 0;
+
+            _monitorRuns++;
+
+            _adminLock.Lock();
+
+            Flush();
+
+            // Coming out of a Block, all interests need to be collected again..
+            if (_update == true) {
+                _update = false;
+                Evaluate(false);
+            }
+
+            if (_resourceList.empty() == false) {
+                _adminLock.Unlock();
+
+                int result = ::epoll_wait(_epollDescriptor, _descriptorArray, _descriptorArrayLength, -1);
+
+                _adminLock.Lock();
+
+                Flush();
+
+                if (result == -1) {
+                    TRACE_L1("epoll_wait failed with error <%d>", errno);
+
+                } else {
+                    bool breakIssued = false;
+
+                    for (int slot = 0; slot < result; slot++) {
+                        const IResource::handle descriptor = _descriptorArray[slot].data.fd;
+
+                        if (descriptor == _signalDescriptor) {
+                            uint64_t value;
+                            ssize_t VARIABLE_IS_NOT_USED length = ::read(_signalDescriptor, &value, sizeof(value));
+                            breakIssued = true;
+                        } else {
+                            typename Registrations::iterator entry(_registrations.find(descriptor));
+
+                            // The entry might have been removed from observing in the mean time...
+                            if (entry != _registrations.end()) {
+                                entry->second.Events = static_cast<uint16_t>(_descriptorArray[slot].events);
+                                entry->second.Run = _monitorRuns;
+                            }
+                        }
+                    }
+
+                    if (_evaluate.exchange(false, Core::memory_order::memory_order_acq_rel) == true) {
+                        // A plain Break does not tell which resource wants attention. Just like the poll
+                        // loop, collect all interests and offer all resources a chance to act on it.
+                        _pendingLock.Lock();
+                        _dirty.clear();
+                        _pendingLock.Unlock();
+
+                        _removed = false;
+
+                        Evaluate(true);
+                    } else {
+                        // Only the descriptors that are ready are offered. Handling them might
+                        // change what they are interested in, so that is all we need to re-evaluate.
+                        for (int slot = 0; slot < result; slot++) {
+                            const IResource::handle descriptor = _descriptorArray[slot].data.fd;
+                            typename Registrations::iterator entry(_registrations.find(descriptor));
+
+                            if ((entry != _registrations.end()) && (entry->second.Run == _monitorRuns)) {
+                                RESOURCE* resource = entry->second.Resource;
+
+                                Arm();
+
+                                resource->Handle(entry->second.Events);
+
+                                Reset();
+
+                                // Do not trust the iterator, the handling might have unregistered resources.
+                                entry = _registrations.find(descriptor);
+
+                                if ((entry != _registrations.end()) && (entry->second.Resource == resource)) {
+                                    uint16_t events = resource->Events();
+
+                                    if (events == 0) {
+                                        Withdraw(*resource);
+                                        _resourceList.remove(resource);
+                                    } else if ((events != entry->second.Monitor) && (Subscribe(descriptor, events, true) == true)) {
+                                        entry->second.Monitor = events;
+                                    }
+                                }
+                            }
+                        }
+
+                        if (breakIssued == true) {
+                            Dirty();
+                        }
+
+                        if (_removed == true) {
+                            _removed = false;
+                            _resourceList.remove(nullptr);
+                        }
+                    }
+                }
+            } else if (Idle() == true) {
+                _update = true;
+                delay = Core::infinite;
+            }
+
+            _adminLock.Unlock();
+
+            return (delay);
+        }
+#elif defined(__LINUX__)
         uint32_t Worker()
         {
             uint32_t delay = 0;
@@ -352,6 +591,8 @@ namespace Core {
             // Add entries not in the Array before we start !!!
             _adminLock.Lock();
 
+            Flush();
+
             // Do we have enough space to allocate all file descriptors ?
             if ((_resourceList.size() + 1) > _descriptorArrayLength) {
                 _descriptorArrayLength = ((((_resourceList.size() + 1) / FileDescriptorAllocation) + 1) * FileDescriptorAllocation);
@@ -393,6 +634,8 @@ namespace Core {
 
                 _adminLock.Lock();
 
+                Flush();
+
                 if (result == -1) {
                     TRACE_L1("poll failed with error <%d>", errno);
 
@@ -437,8 +680,7 @@ namespace Core {
                     index++;
                     fd_index++;
                 }
-            } else {
-                _monitor->Block();
+            } else if (Idle() == true) {
                 delay = Core::infinite;
             }
 
@@ -458,6 +700,8 @@ namespace Core {
 
             _adminLock.Lock();
 
+            Flush();
+
             // Now iterate over the sockets and determine their states..
             index = _resourceList.begin();
 
@@ -485,6 +729,8 @@ namespace Core {
 
                 _adminLock.Lock();
 
+                Flush();
+
                 // Find all "pending" sockets and signal them..
                 index = _resourceList.begin();
 
@@ -511,9 +757,8 @@ namespace Core {
                     }
                     index++;
                 }
-            } else {
+            } else if (Idle() == true) {
                 delay = Core::infinite;
-                _monitor->Block();
             }
 
             _adminLock.Unlock();
@@ -522,17 +767,265 @@ namespace Core {
         }
 #endif
 
+    private:
+        void Add(RESOURCE& resource)
+        {
+            // Make sure this entry is only registered once !!!
+            if (std::find(_resourceList.begin(), _resourceList.end(), &resource) == _resourceList.end()) {
+                _resourceList.push_back(&resource);
+            }
+
+            if (_resourceList.size() == 1) {
+                if (_monitor == nullptr) {
+                    _monitor = new MonitorWorker(*this);
+
+                    // Wait till we are at least initialized
+                    _monitor->Wait(Thread::BLOCKED | Thread::STOPPED);
+                }
+
+                _monitor->Run();
+            }
+#ifdef __RESOURCE_MONITOR_EPOLL__
+            // Only the new resource needs to be looked at.
+            Break(resource);
+#else
+            else {
+                Break();
+            }
+#endif
+        }
+        void Remove(RESOURCE& resource)
+        {
+            // Make sure this entry does not exist, only register resources once !!!
+            typename std::list<RESOURCE*>::iterator index(std::find(_resourceList.begin(), _resourceList.end(), &resource));
+
+            if (index != _resourceList.end()) {
+                *index = nullptr;
+#ifdef __RESOURCE_MONITOR_EPOLL__
+                Withdraw(resource);
+
+                // Nothing to evaluate, our thread just has to drop the entry from the list.
+                _removed = true;
+                Signal();
+#else
+                Break();
+#endif
+            }
+        }
+        // Apply the posted (un)registrations, in the order they were posted. Called with our lock taken.
+        void Flush()
+        {
+            const uint32_t posted = _posted.load(Core::memory_order::memory_order_acquire);
+
+            if (posted != _handled.load(Core::memory_order::memory_order_relaxed)) {
+                std::vector<std::pair<RESOURCE*, bool>> pending;
+                std::vector<Core::Event*> waiting;
+
+                _pendingLock.Lock();
+                pending.swap(_pending);
+                waiting.swap(_waiting);
+                const uint32_t last = _posted.load(Core::memory_order::memory_order_relaxed);
+                _pendingLock.Unlock();
+
+                for (const std::pair<RESOURCE*, bool>& entry : pending) {
+                    if (entry.second == true) {
+                        Add(*entry.first);
+                    } else {
+                        Remove(*entry.first);
+                    }
+                }
+
+                _handled.store(last, Core::memory_order::memory_order_release);
+
+                for (Core::Event* poster : waiting) {
+                    poster->SetEvent();
+                }
+            }
+        }
+        // Nothing left to monitor, block unless something got posted in the mean time.
+        bool Idle()
+        {
+            _pendingLock.Lock();
+
+            const bool idle = _pending.empty();
+
+            if (idle == true) {
+                _monitor->Block();
+            }
+
+            _pendingLock.Unlock();
+
+            return (idle);
+        }
+
+#ifdef __RESOURCE_MONITOR_EPOLL__
+    private:
+        // Collect the interest of all resources and hand the changes over to the kernel. If
+        // requested, each resource is handled with whatever was reported for it this run.
+        void Evaluate(const bool dispatch)
+        {
+            typename std::list<RESOURCE*>::iterator index(_resourceList.begin());
+
+            while (index != _resourceList.end()) {
+                index = Update(index, dispatch);
+            }
+
+            Reserve();
+        }
+        // Offer the resources that asked for it through a Break, a chance to act. Those already
+        // handled this run had that chance, the rest are handled with nothing reported.
+        void Dirty()
+        {
+            std::vector<RESOURCE*> dirty;
+
+            _pendingLock.Lock();
+            dirty.swap(_dirty);
+            _pendingLock.Unlock();
+
+            std::sort(dirty.begin(), dirty.end());
+            dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+            for (RESOURCE* resource : dirty) {
+                // Might be unregistered, or even destructed, by now. Only touch it if it is still in the list.
+                typename std::list<RESOURCE*>::iterator index(std::find(_resourceList.begin(), _resourceList.end(), resource));
+
+                if (index != _resourceList.end()) {
+                    typename Registrations::const_iterator entry(_registrations.find(resource->Descriptor()));
+
+                    if ((entry == _registrations.cend()) || (entry->second.Resource != resource) || (entry->second.Run != _monitorRuns)) {
+                        Update(index, true);
+                    }
+                }
+            }
+
+            Reserve();
+        }
+        // Hand the interest of the resource at the given position over to the kernel, if it changed,
+        // and handle it if requested. A resource without interest is dropped. Returns the next position.
+        typename std::list<RESOURCE*>::iterator Update(typename std::list<RESOURCE*>::iterator index, const bool dispatch)
+        {
+            RESOURCE* entry = (*index);
+
+            uint16_t events;
+
+            if ((entry == nullptr) || ((events = entry->Events()) == 0)) {
+                if (entry != nullptr) {
+                    Withdraw(*entry);
+                }
+                index = _resourceList.erase(index);
+            } else {
+                const IResource::handle descriptor = entry->Descriptor();
+                typename Registrations::iterator registration(_registrations.find(descriptor));
+
+                if (registration == _registrations.end()) {
+                    if (Subscribe(descriptor, events, false) == true) {
+                        _registrations.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(descriptor),
+                            std::forward_as_tuple(Registration { entry, events, 0, 0 }));
+                    }
+                } else {
+                    if ((registration->second.Resource != entry) || (registration->second.Monitor != events)) {
+                        // Either the interest changed, or the descriptor got reused by a new resource
+                        // before the old one was unregistered. Both cases result in the same update.
+                        if (Subscribe(descriptor, events, true) == true) {
+                            registration->second.Resource = entry;
+                            registration->second.Monitor = events;
+                        }
+                    }
+
+                    if ((dispatch == true) && (registration->second.Resource == entry)) {
+                        Arm();
+
+                        // Event if the flagsSet == 0, call handle, maybe a break was issued by this RESOURCE..
+                        entry->Handle(registration->second.Run == _monitorRuns ? registration->second.Events : 0);
+
+                        Reset();
+                    }
+                }
+                index++;
+            }
+
+            return (index);
+        }
+        void Reserve()
+        {
+            // Do we have enough space to receive all file descriptors ?
+            if ((_registrations.size() + 1) > _descriptorArrayLength) {
+                _descriptorArrayLength = ((((_registrations.size() + 1) / FileDescriptorAllocation) + 1) * FileDescriptorAllocation);
+
+                ::free(_descriptorArray);
+
+                _descriptorArray = static_cast<struct epoll_event*>(::malloc(sizeof(struct epoll_event) * _descriptorArrayLength));
+            }
+        }
+        bool Subscribe(const IResource::handle descriptor, const uint16_t events, const bool known)
+        {
+            struct epoll_event event;
+
+            event.events = events;
+            event.data.u64 = 0;
+            event.data.fd = descriptor;
+
+            int result = ::epoll_ctl(_epollDescriptor, (known ? EPOLL_CTL_MOD : EPOLL_CTL_ADD), descriptor, &event);
+
+            if ((result != 0) && (errno == (known ? ENOENT : EEXIST))) {
+                // A closed descriptor drops out of the kernel set, a duplicated one stays in. Our view might be off..
+                result = ::epoll_ctl(_epollDescriptor, (known ? EPOLL_CTL_ADD : EPOLL_CTL_MOD), descriptor, &event);
+            }
+
+            if (result != 0) {
+                TRACE_L1("epoll_ctl failed on descriptor %d with error <%d>", descriptor, errno);
+            }
+
+            return (result == 0);
+        }
+        void Withdraw(const RESOURCE& resource)
+        {
+            // Descriptors are closed before the resource is unregistered, so look for the resource
+            // and not for the descriptor. The descriptor might already be in use by someone else.
+            typename Registrations::iterator index(_registrations.find(resource.Descriptor()));
+
+            if ((index == _registrations.end()) || (index->second.Resource != &resource)) {
+                index = std::find_if(_registrations.begin(), _registrations.end(),
+                    [&resource](const typename Registrations::value_type& entry) { return (entry.second.Resource == &resource); });
+            }
+
+            if (index != _registrations.end()) {
+                ::epoll_ctl(_epollDescriptor, EPOLL_CTL_DEL, index->first, nullptr);
+                _registrations.erase(index);
+            }
+        }
+
+#endif
     private:
         MonitorWorker* _monitor;
         mutable Core::CriticalSection _adminLock;
         std::list<RESOURCE*> _resourceList;
+        Core::CriticalSection _pendingLock;
+        std::vector<std::pair<RESOURCE*, bool>> _pending;
+        std::vector<Core::Event*> _waiting;
+        Core::Event _progress;
+#ifdef __RESOURCE_MONITOR_EPOLL__
+        std::vector<RESOURCE*> _dirty;
+        std::atomic<bool> _evaluate;
+#endif
+        std::atomic<uint32_t> _posted;
+        std::atomic<uint32_t> _handled;
         uint32_t _monitorRuns;
         string _name;
         WATCHDOG _watchDog;
 
 #ifdef __LINUX__
         uint32_t _descriptorArrayLength;
+#ifdef __RESOURCE_MONITOR_EPOLL__
+        struct ::epoll_event* _descriptorArray;
+        Registrations _registrations;
+        int _epollDescriptor;
+        bool _update;
+        bool _removed;
+#else
         struct ::pollfd* _descriptorArray;
+#endif
         int _signalDescriptor;
 #endif
 
@@ -571,12 +1064,22 @@ namespace Core {
     typedef ResourceMonitorType<IResource, Void> ResourceMonitorBase;
 #endif
 
-    class EXTERNAL ResourceMonitor : public ResourceMonitorBase {
+    // The ResourceMonitor spreads the resources over one or more reactors, each
+    // running its own monitor thread. A resource is assigned to the least loaded
+    // reactor when it is registered and stays there, so all its callbacks come
+    // from the same thread. A reactor handles its resources with its own lock
+    // taken, so a resource (un)registered from within another reactor is handed
+    // over to the thread of its reactor instead of waiting for that lock.
+    class EXTERNAL ResourceMonitor {
+    public:
+        static constexpr uint8_t MaxReactors = 16;
+
+        struct Metadata : public ResourceMonitorBase::Metadata {
+            uint8_t reactor;
+        };
+
     private:
-        ResourceMonitor()
-            : ResourceMonitorBase()
-        {
-        }
+        ResourceMonitor();
         ResourceMonitor(const ResourceMonitor&) = delete;
         ResourceMonitor& operator=(const ResourceMonitor&) = delete;
 
@@ -584,7 +1087,57 @@ namespace Core {
 
     public:
         static ResourceMonitor& Instance();
-        ~ResourceMonitor() {}
+        ~ResourceMonitor();
+
+    public:
+        // Resources stick to their reactor, so the number of reactors can only grow.
+        void Reactors(const uint8_t count);
+        uint8_t Reactors() const
+        {
+            return (_reactorCount.load(Core::memory_order::memory_order_acquire));
+        }
+        const TCHAR* Name() const
+        {
+            return (_reactors[0]->Name());
+        }
+        uint32_t Runs() const;
+        uint32_t Runs(const uint8_t reactor) const
+        {
+            ASSERT(reactor < Reactors());
+            return (_reactors[reactor]->Runs());
+        }
+        ::ThreadId Id() const
+        {
+            return (_reactors[0]->Id());
+        }
+        ::ThreadId Id(const uint8_t reactor) const
+        {
+            ASSERT(reactor < Reactors());
+            return (_reactors[reactor]->Id());
+        }
+        bool IsReactor(const ::ThreadId id) const;
+        uint32_t Count() const;
+        uint32_t Count(const uint8_t reactor) const
+        {
+            ASSERT(reactor < Reactors());
+            return (_reactors[reactor]->Count());
+        }
+        bool Info(const uint32_t position, Metadata& info) const;
+        void Register(IResource& resource);
+        void Unregister(IResource& resource);
+        // Only wakes the reactor the resource is assigned to.
+        void Break(IResource& resource);
+        void Break();
+
+    private:
+        void Forward(const uint8_t reactor, IResource& resource, const bool subscribe);
+
+    private:
+        mutable CriticalSection _adminLock;
+        std::atomic<uint8_t> _reactorCount;
+        ResourceMonitorBase* _reactors[MaxReactors];
+        uint32_t _load[MaxReactors];
+        std::unordered_map<const IResource*, uint8_t> _assignments;
     };
 }
 } // namespace WPEFramework::Core
@@ -610,7 +610,7 @@ namespace Core {
             // subscribtion.
             _state |= SerialPort::EXCEPTION;
             _state &= ~SerialPort::OPEN;
-            ResourceMonitor::Instance().Break();
+            ResourceMonitor::Instance().Break(*this);
         } 
 #endif
 
@@ -642,7 +642,7 @@ namespace Core {
             // Right, a wait till connection is closed is requested..
             while ((waiting > 0) && (_state != 0)) {
                 // Make sure we aren't in the monitor thread waiting for close completion.
-                ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+                ASSERT(ResourceMonitor::Instance().IsReactor(Core::Thread::ThreadId()) == false);
 
                 uint32_t sleepSlot = (waiting > SLEEPSLOT_POLLING_TIME ? SLEEPSLOT_POLLING_TIME : waiting);
 
@@ -676,7 +676,7 @@ namespace Core {
 #else
     if ((_state & (SerialPort::OPEN | SerialPort::EXCEPTION | SerialPort::WRITESLOT)) == SerialPort::OPEN) {
         _state |= SerialPort::WRITESLOT;
-        ResourceMonitor::Instance().Break();
+        ResourceMonitor::Instance().Break(*this);
     }
 #endif
 
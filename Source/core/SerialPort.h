@@ -207,8 +207,8 @@ namespace Core {
         void Trigger();
 
         // Methods to extract and insert data into the socket buffers
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
         virtual void StateChange() = 0;
 
         uint32_t Configuration(
@@ -0,0 +1,538 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SlabAllocator.h"
+#include "Thread.h"
+
+#ifdef __POSIX__
+#include <sys/mman.h>
+#endif
+
+namespace WPEFramework {
+namespace Core {
+
+    /* static */ constexpr uint32_t SlabAllocator::SlabSize;
+    /* static */ constexpr uint16_t SlabAllocator::Largest;
+    /* static */ constexpr uint8_t SlabAllocator::Classes;
+    /* static */ constexpr uint8_t SlabAllocator::Arenas;
+
+    // Sits at the start of every slab, the blocks follow after the first Header bytes.
+    struct SlabAllocator::Slab {
+        SlabAllocator* Owner;
+        Slab* Next;
+        Slab* Previous;
+        void* Free;
+        uint16_t Fresh;
+        uint16_t Used;
+        uint16_t Blocks;
+        uint8_t Class;
+    };
+
+    namespace {
+
+        constexpr uint16_t Header = 64;
+
+        // The arenas that have a cache in every thread, by index. Zero initialized, so usable before any constructor ran.
+        std::atomic<SlabAllocator*> g_arenas[SlabAllocator::Arenas];
+        std::atomic<uint32_t> g_registered(0);
+
+        void* Reserve()
+        {
+#ifdef __WINDOWS__
+            // The allocation granularity of windows is 64KB, so it is aligned already.
+            return (::VirtualAlloc(nullptr, SlabAllocator::SlabSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+            // Map twice the size, and cut off what is not needed to get to an aligned slab.
+            void* area = ::mmap(nullptr, 2 * SlabAllocator::SlabSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            uint8_t* result = nullptr;
+
+            if (area != MAP_FAILED) {
+                const uintptr_t start = reinterpret_cast<uintptr_t>(area);
+                const uintptr_t aligned = (start + SlabAllocator::SlabSize - 1) & ~static_cast<uintptr_t>(SlabAllocator::SlabSize - 1);
+                const size_t head = (aligned - start);
+
+                if (head != 0) {
+                    ::munmap(area, head);
+                }
+                if (head != SlabAllocator::SlabSize) {
+                    ::munmap(reinterpret_cast<void*>(aligned + SlabAllocator::SlabSize), SlabAllocator::SlabSize - head);
+                }
+
+                result = reinterpret_cast<uint8_t*>(aligned);
+            }
+
+            return (result);
+#endif
+        }
+        void Release(void* slab)
+        {
+#ifdef __WINDOWS__
+            ::VirtualFree(slab, 0, MEM_RELEASE);
+#else
+            ::munmap(slab, SlabAllocator::SlabSize);
+#endif
+        }
+
+    }
+
+    // The blocks a thread keeps for itself, per class of each arena.
+    class SlabCache {
+    private:
+        static constexpr uint16_t Deepest = 32;
+
+        struct Bin {
+            void* Head;
+            // Only changed by the owning thread, read by anyone taking a snapshot.
+            std::atomic<uint16_t> Count;
+        };
+
+        static CriticalSection& AdminLock()
+        {
+            static CriticalSection& lock = *(new CriticalSection());
+
+            return (lock);
+        }
+        static std::list<SlabCache*>& Caches()
+        {
+            static std::list<SlabCache*>& caches = *(new std::list<SlabCache*>());
+
+            return (caches);
+        }
+
+    public:
+        SlabCache(const SlabCache&) = delete;
+        SlabCache& operator=(const SlabCache&) = delete;
+
+        SlabCache()
+            : _bins()
+        {
+            AdminLock().Lock();
+            Caches().push_back(this);
+            AdminLock().Unlock();
+        }
+        ~SlabCache()
+        {
+            AdminLock().Lock();
+
+            Caches().remove(this);
+
+            for (uint8_t arena = 0; arena < SlabAllocator::Arenas; arena++) {
+                if (_bins[arena] != nullptr) {
+                    SlabAllocator* owner = g_arenas[arena].load(std::memory_order_acquire);
+
+                    if (owner != nullptr) {
+                        Flush(*owner);
+                    }
+
+                    delete[] _bins[arena];
+                }
+            }
+
+            AdminLock().Unlock();
+        }
+
+        static SlabCache& Instance()
+        {
+            return (ThreadLocalStorageType<SlabCache>::Instance().Context());
+        }
+        static bool IsSet()
+        {
+            return (ThreadLocalStorageType<SlabCache>::Instance().IsSet());
+        }
+
+    public:
+        void* Allocate(SlabAllocator& arena, const uint8_t index)
+        {
+            Bin& bin(Bins(arena._index)[index]);
+
+            if (bin.Head == nullptr) {
+                void* blocks[Deepest / 2];
+                const uint16_t count = arena.Take(index, blocks, Depth(index) / 2);
+
+                for (uint16_t entry = 0; entry < count; entry++) {
+                    *reinterpret_cast<void**>(blocks[entry]) = bin.Head;
+                    bin.Head = blocks[entry];
+                }
+
+                bin.Count.store(count, std::memory_order_relaxed);
+            }
+
+            void* result = bin.Head;
+
+            if (result != nullptr) {
+                bin.Head = *reinterpret_cast<void**>(result);
+                bin.Count.store(bin.Count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            }
+
+            return (result);
+        }
+        void Free(SlabAllocator& arena, const uint8_t index, void* block)
+        {
+            Bin& bin(Bins(arena._index)[index]);
+            uint16_t count = bin.Count.load(std::memory_order_relaxed);
+
+            if (count == Depth(index)) {
+                // Full, give the oldest half back at once. The recent ones are kept, they are still hot and
+                // the old ones would otherwise keep their slabs from being released.
+                void* blocks[Deepest / 2];
+                const uint16_t half = (count / 2);
+                void* last = bin.Head;
+
+                for (uint16_t entry = 1; entry < (count - half); entry++) {
+                    last = *reinterpret_cast<void**>(last);
+                }
+
+                void* older = *reinterpret_cast<void**>(last);
+                *reinterpret_cast<void**>(last) = nullptr;
+
+                for (uint16_t entry = 0; entry < half; entry++) {
+                    blocks[entry] = older;
+                    older = *reinterpret_cast<void**>(older);
+                }
+
+                arena.Give(index, blocks, half);
+                count -= half;
+            }
+
+            *reinterpret_cast<void**>(block) = bin.Head;
+            bin.Head = block;
+            bin.Count.store(count + 1, std::memory_order_relaxed);
+        }
+        // Gives all blocks of the arena back.
+        void Flush(SlabAllocator& arena)
+        {
+            Bin* bins = _bins[arena._index];
+
+            if (bins != nullptr) {
+                for (uint8_t index = 0; index < SlabAllocator::Classes; index++) {
+                    while (bins[index].Head != nullptr) {
+                        void* block = bins[index].Head;
+                        bins[index].Head = *reinterpret_cast<void**>(block);
+                        arena.Give(index, &block, 1);
+                    }
+                    bins[index].Count.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+        static uint32_t Cached(const uint8_t arena, const uint8_t index)
+        {
+            uint32_t result = 0;
+
+            AdminLock().Lock();
+
+            for (const SlabCache* cache : Caches()) {
+                if (cache->_bins[arena] != nullptr) {
+                    result += cache->_bins[arena][index].Count.load(std::memory_order_relaxed);
+                }
+            }
+
+            AdminLock().Unlock();
+
+            return (result);
+        }
+
+    private:
+        // The larger the blocks, the fewer are kept, at most 8KB per class.
+        static uint16_t Depth(const uint8_t index)
+        {
+            return (static_cast<uint16_t>(std::max(4, std::min(static_cast<int>(Deepest), 8192 / SlabAllocator::Size(index)))));
+        }
+        Bin* Bins(const uint8_t arena)
+        {
+            ASSERT(arena < SlabAllocator::Arenas);
+
+            if (_bins[arena] == nullptr) {
+                Bin* bins = new Bin[SlabAllocator::Classes];
+
+                for (uint8_t index = 0; index < SlabAllocator::Classes; index++) {
+                    bins[index].Head = nullptr;
+                    bins[index].Count.store(0, std::memory_order_relaxed);
+                }
+
+                // Others might be taking a snapshot.
+                AdminLock().Lock();
+                _bins[arena] = bins;
+                AdminLock().Unlock();
+            }
+
+            return (_bins[arena]);
+        }
+
+    private:
+        Bin* _bins[SlabAllocator::Arenas];
+    };
+
+    SlabAllocator::SlabAllocator(const string& name)
+        : _name(name)
+        , _index(static_cast<uint8_t>(std::min(g_registered.fetch_add(1), static_cast<uint32_t>(Arenas))))
+        , _buckets()
+        , _large(0)
+        , _largeBytes(0)
+        , _adminLock()
+    {
+        static_assert(sizeof(Slab) <= Header, "The slab administration does not fit in its header");
+        static_assert(((SlabSize - Header) / Largest) >= 2, "A slab should at least hold two of the largest blocks");
+
+        for (Bucket& bucket : _buckets) {
+            bucket.Partial = nullptr;
+            bucket.Slabs = 0;
+            bucket.Empty = 0;
+            bucket.Objects = 0;
+        }
+
+        if (_index < Arenas) {
+            g_arenas[_index].store(this, std::memory_order_release);
+        }
+    }
+
+    SlabAllocator::~SlabAllocator()
+    {
+        if (_index < Arenas) {
+            // What this thread keeps can be given back, the blocks kept by other threads are lost.
+            if (SlabCache::IsSet() == true) {
+                SlabCache::Instance().Flush(*this);
+            }
+
+            g_arenas[_index].store(nullptr, std::memory_order_release);
+        }
+
+        for (uint8_t index = 0; index < Classes; index++) {
+            Slab* slab = _buckets[index].Partial;
+
+            while (slab != nullptr) {
+                Slab* next = slab->Next;
+
+                if (slab->Used == 0) {
+                    _buckets[index].Slabs--;
+                    Release(slab);
+                }
+
+                slab = next;
+            }
+
+            if (_buckets[index].Slabs != 0) {
+                TRACE_L1("Slabs of %d bytes still in use in %s, they are not released.", Size(index), _name.c_str());
+            }
+        }
+    }
+
+    /* static */ SlabAllocator& SlabAllocator::Instance()
+    {
+        // Never destructed, ProxyType objects might still be released after the statics are gone.
+        static SlabAllocator& instance = *(new SlabAllocator(_T("ProxyType")));
+
+        return (instance);
+    }
+
+    void* SlabAllocator::Allocate(const size_t size)
+    {
+        void* result = nullptr;
+
+        if (size > Largest) {
+            result = ::malloc(size);
+
+            if (result != nullptr) {
+                _large.fetch_add(1, std::memory_order_relaxed);
+                _largeBytes.fetch_add(size, std::memory_order_relaxed);
+            }
+        }
+        else if (_index < Arenas) {
+            result = SlabCache::Instance().Allocate(*this, Class(size));
+        }
+        else if (Take(Class(size), &result, 1) == 0) {
+            result = nullptr;
+        }
+
+        return (result);
+    }
+
+    void SlabAllocator::Free(void* block, const size_t size)
+    {
+        if (block != nullptr) {
+            if (size > Largest) {
+                _large.fetch_sub(1, std::memory_order_relaxed);
+                _largeBytes.fetch_sub(size, std::memory_order_relaxed);
+
+                ::free(block);
+            }
+            else {
+                const uint8_t index = Class(size);
+
+                ASSERT(reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(block) & ~static_cast<uintptr_t>(SlabSize - 1))->Owner == this);
+                ASSERT(reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(block) & ~static_cast<uintptr_t>(SlabSize - 1))->Class == index);
+
+                if (_index < Arenas) {
+                    SlabCache::Instance().Free(*this, index, block);
+                }
+                else {
+                    Give(index, &block, 1);
+                }
+            }
+        }
+    }
+
+    void SlabAllocator::Snapshot(Metadata& metadata) const
+    {
+        metadata.Name = _name;
+        metadata.Reserved = 0;
+        metadata.Used = 0;
+
+        for (uint8_t index = 0; index < Classes; index++) {
+            Metadata::Class& entry(metadata.Classes[index]);
+
+            entry.Cached = (_index < Arenas ? SlabCache::Cached(_index, index) : 0);
+
+            _adminLock.Lock();
+            entry.Slabs = _buckets[index].Slabs;
+            // Blocks move between the caches and the arena while we count, do not go below zero.
+            entry.Objects = (_buckets[index].Objects > entry.Cached ? _buckets[index].Objects - entry.Cached : 0);
+            _adminLock.Unlock();
+
+            entry.Size = Size(index);
+
+            metadata.Reserved += (static_cast<uint64_t>(entry.Slabs) * SlabSize);
+            metadata.Used += (static_cast<uint64_t>(entry.Objects) * entry.Size);
+        }
+
+        metadata.Large = _large.load(std::memory_order_relaxed);
+        metadata.LargeBytes = _largeBytes.load(std::memory_order_relaxed);
+        metadata.Fragmentation = (metadata.Reserved == 0 ? 0 : static_cast<uint8_t>(100 - ((metadata.Used * 100) / metadata.Reserved)));
+    }
+
+    uint16_t SlabAllocator::Take(const uint8_t index, void* blocks[], const uint16_t count)
+    {
+        Bucket& bucket(_buckets[index]);
+        const uint16_t size = Size(index);
+        uint16_t result = 0;
+
+        _adminLock.Lock();
+
+        while (result < count) {
+            Slab* slab = bucket.Partial;
+
+            if (slab == nullptr) {
+                slab = reinterpret_cast<Slab*>(Reserve());
+
+                if (slab == nullptr) {
+                    break;
+                }
+
+                slab->Owner = this;
+                slab->Next = nullptr;
+                slab->Previous = nullptr;
+                slab->Free = nullptr;
+                slab->Fresh = 0;
+                slab->Used = 0;
+                slab->Blocks = static_cast<uint16_t>((SlabSize - Header) / size);
+                slab->Class = index;
+
+                bucket.Partial = slab;
+                bucket.Slabs++;
+            }
+            else if (slab->Used == 0) {
+                bucket.Empty--;
+            }
+
+            while ((result < count) && (slab->Used < slab->Blocks)) {
+                void* block;
+
+                if (slab->Free != nullptr) {
+                    block = slab->Free;
+                    slab->Free = *reinterpret_cast<void**>(block);
+                }
+                else {
+                    block = &(reinterpret_cast<uint8_t*>(slab)[Header + (slab->Fresh * size)]);
+                    slab->Fresh++;
+                }
+
+                slab->Used++;
+                blocks[result++] = block;
+            }
+
+            if (slab->Used == slab->Blocks) {
+                // Full, only when a block comes back it is a candidate again.
+                bucket.Partial = slab->Next;
+                if (slab->Next != nullptr) {
+                    slab->Next->Previous = nullptr;
+                }
+                slab->Next = nullptr;
+            }
+        }
+
+        bucket.Objects += result;
+
+        _adminLock.Unlock();
+
+        return (result);
+    }
+
+    void SlabAllocator::Give(const uint8_t index, void* const blocks[], const uint16_t count)
+    {
+        Bucket& bucket(_buckets[index]);
+
+        _adminLock.Lock();
+
+        for (uint16_t entry = 0; entry < count; entry++) {
+            Slab* slab = reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(blocks[entry]) & ~static_cast<uintptr_t>(SlabSize - 1));
+
+            ASSERT((slab->Owner == this) && (slab->Class == index) && (slab->Used != 0));
+
+            if (slab->Used == slab->Blocks) {
+                // It was full, so it is not in the list.
+                slab->Previous = nullptr;
+                slab->Next = bucket.Partial;
+                if (bucket.Partial != nullptr) {
+                    bucket.Partial->Previous = slab;
+                }
+                bucket.Partial = slab;
+            }
+
+            *reinterpret_cast<void**>(blocks[entry]) = slab->Free;
+            slab->Free = blocks[entry];
+            slab->Used--;
+
+            if (slab->Used == 0) {
+                if (bucket.Empty == 0) {
+                    // Keep one around, so a class that comes and goes does not map and unmap all the time.
+                    bucket.Empty++;
+                }
+                else {
+                    if (slab->Previous != nullptr) {
+                        slab->Previous->Next = slab->Next;
+                    }
+                    else {
+                        bucket.Partial = slab->Next;
+                    }
+                    if (slab->Next != nullptr) {
+                        slab->Next->Previous = slab->Previous;
+                    }
+
+                    bucket.Slabs--;
+                    Release(slab);
+                }
+            }
+        }
+
+        bucket.Objects -= count;
+
+        _adminLock.Unlock();
+    }
+
+} // namespace Core
+} // namespace WPEFramework
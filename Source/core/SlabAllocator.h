@@ -0,0 +1,201 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "Portability.h"
+#include "Sync.h"
+
+namespace WPEFramework {
+namespace Core {
+
+    // -------------------------------------------------------------------
+    // An arena that hands out blocks of a fixed set of size classes, cut
+    // from slabs of 64KB that are taken from (and given back to) the OS
+    // directly. Every thread keeps a few free blocks per class of each
+    // arena, so most allocations and frees do not take the lock of the
+    // arena. Blocks larger than the largest class are passed on to the
+    // heap.
+    // The size of a block has to be passed in on Free, it is not kept in
+    // front of the block. Slabs of which all blocks are free are given
+    // back, except for one per class, to avoid the RSS growing over time.
+    // -------------------------------------------------------------------
+    class EXTERNAL SlabAllocator {
+    private:
+        struct Slab;
+
+        struct Bucket {
+            Slab* Partial;
+            uint32_t Slabs;
+            uint32_t Empty;
+            uint32_t Objects;
+        };
+
+    public:
+        static constexpr uint32_t SlabSize = (64 * 1024);
+        static constexpr uint16_t Largest = 4096;
+        static constexpr uint8_t Classes = 32;
+        // Arenas beyond this number do not get a cache in every thread.
+        static constexpr uint8_t Arenas = 8;
+
+        struct Metadata {
+            struct Class {
+                uint32_t Size;
+                uint32_t Slabs;
+                uint32_t Objects;
+                uint32_t Cached;
+            };
+
+            string Name;
+            uint64_t Reserved;
+            uint64_t Used;
+            uint32_t Large;
+            uint64_t LargeBytes;
+            // Percentage of the reserved bytes that is not in use.
+            uint8_t Fragmentation;
+            Class Classes[SlabAllocator::Classes];
+        };
+
+    public:
+        SlabAllocator(const SlabAllocator&) = delete;
+        SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+        SlabAllocator(const string& name);
+        ~SlabAllocator();
+
+        // The arena used by all ProxyType objects, if built with PROXY_SLAB_ALLOCATOR.
+        static SlabAllocator& Instance();
+
+    public:
+        inline const string& Name() const
+        {
+            return (_name);
+        }
+        static uint8_t Class(const size_t size)
+        {
+            ASSERT(size <= Largest);
+
+            uint8_t result;
+
+            if (size <= 256) {
+                // Steps of 16 bytes up to 256..
+                result = static_cast<uint8_t>((size != 0 ? size - 1 : 0) >> 4);
+            }
+            else {
+                // .. and from there on, 4 classes for each power of 2.
+                size_t limit = 512;
+                result = 16;
+
+                while (size > limit) {
+                    limit <<= 1;
+                    result += 4;
+                }
+
+                result += static_cast<uint8_t>((size - 1 - (limit >> 1)) / (limit >> 3));
+            }
+
+            return (result);
+        }
+        static uint16_t Size(const uint8_t index)
+        {
+            ASSERT(index < Classes);
+
+            uint16_t result;
+
+            if (index < 16) {
+                result = ((index + 1) << 4);
+            }
+            else {
+                const uint16_t limit = (512 << ((index - 16) >> 2));
+                result = (limit >> 1) + ((((index - 16) & 0x3) + 1) * (limit >> 3));
+            }
+
+            return (result);
+        }
+
+        void* Allocate(const size_t size);
+        void Free(void* block, const size_t size);
+        void Snapshot(Metadata& metadata) const;
+
+    private:
+        friend class SlabCache;
+
+        uint16_t Take(const uint8_t index, void* blocks[], const uint16_t count);
+        void Give(const uint8_t index, void* const blocks[], const uint16_t count);
+
+    private:
+        const string _name;
+        const uint8_t _index;
+        Bucket _buckets[Classes];
+        std::atomic<uint32_t> _large;
+        std::atomic<uint64_t> _largeBytes;
+        mutable CriticalSection _adminLock;
+    };
+
+    // -------------------------------------------------------------------
+    // How a ProxyObject<CONTEXT> gets its memory. By default this is the
+    // heap, or the shared slab arena if built with PROXY_SLAB_ALLOCATOR.
+    // A type can be given an arena of its own, e.g. to keep long living
+    // objects away from the short living ones, by specializing it:
+    //
+    //     template <>
+    //     struct ProxyAllocatorType<MyType> : public ProxyArenaType<MyType> {};
+    // -------------------------------------------------------------------
+    template <typename CONTEXT>
+    struct ProxyAllocatorType {
+        static void* Allocate(const size_t size)
+        {
+#ifdef __CORE_PROXY_SLAB_ALLOCATOR__
+            return (SlabAllocator::Instance().Allocate(size));
+#else
+            return (::malloc(size));
+#endif
+        }
+        static void Free(void* block, const size_t size VARIABLE_IS_NOT_USED)
+        {
+#ifdef __CORE_PROXY_SLAB_ALLOCATOR__
+            SlabAllocator::Instance().Free(block, size);
+#else
+            ::free(block);
+#endif
+        }
+    };
+
+    template <typename CONTEXT>
+    struct ProxyArenaType {
+        static SlabAllocator& Arena()
+        {
+            // Never destructed, objects might still be released after the statics are gone.
+            static SlabAllocator& arena = *(new SlabAllocator(typeid(CONTEXT).name()));
+
+            return (arena);
+        }
+        static void* Allocate(const size_t size)
+        {
+            return (Arena().Allocate(size));
+        }
+        static void Free(void* block, const size_t size)
+        {
+            Arena().Free(block, size);
+        }
+    };
+
+} // namespace Core
+} // namespace WPEFramework
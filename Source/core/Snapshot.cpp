@@ -0,0 +1,131 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Snapshot.h"
+
+namespace WPEFramework {
+namespace Core {
+
+    /* static */ constexpr uint64_t Epochs::Idle;
+
+    namespace {
+
+        // Only written by the thread that claimed it, padded so two of them never share a cache line.
+        struct Slot {
+            std::atomic<uint64_t> Epoch;
+            Slot* Next;
+            uint32_t Depth;
+            std::atomic<bool> Claimed;
+            uint8_t Padding[64 - sizeof(std::atomic<uint64_t>) - sizeof(Slot*) - sizeof(uint32_t) - sizeof(std::atomic<bool>)];
+        };
+
+        std::atomic<uint64_t> current(Epochs::Idle + 1);
+        std::atomic<Slot*> slots(nullptr);
+
+        // Claims a slot for the thread on its first read and hands it back when the thread ends.
+        class Claim {
+        public:
+            Claim(const Claim&) = delete;
+            Claim& operator=(const Claim&) = delete;
+
+            Claim()
+                : _slot(slots.load())
+            {
+                bool expected = false;
+
+                while ((_slot != nullptr) && (_slot->Claimed.compare_exchange_strong(expected, true) == false)) {
+                    expected = false;
+                    _slot = _slot->Next;
+                }
+
+                if (_slot == nullptr) {
+                    _slot = new Slot();
+                    _slot->Epoch.store(Epochs::Idle);
+                    _slot->Claimed.store(true);
+                    _slot->Next = slots.load();
+
+                    while (slots.compare_exchange_weak(_slot->Next, _slot) == false) {
+                    }
+                }
+
+                _slot->Depth = 0;
+            }
+            ~Claim()
+            {
+                ASSERT(_slot->Depth == 0);
+                _slot->Claimed.store(false, Core::memory_order::memory_order_release);
+            }
+
+        public:
+            Slot& operator*()
+            {
+                return (*_slot);
+            }
+
+        private:
+            Slot* _slot;
+        };
+
+        thread_local Claim claim;
+    }
+
+    /* static */ void Epochs::Enter()
+    {
+        Slot& slot = *claim;
+
+        if (slot.Depth++ == 0) {
+            // Announced before the reader loads what it reads, so a writer that replaced it in the mean
+            // time either sees this epoch, or the reader gets the replacement.
+            slot.Epoch.store(current.load());
+        }
+    }
+
+    /* static */ void Epochs::Leave()
+    {
+        Slot& slot = *claim;
+
+        ASSERT(slot.Depth != 0);
+
+        if (--slot.Depth == 0) {
+            slot.Epoch.store(Idle);
+        }
+    }
+
+    /* static */ uint64_t Epochs::Advance()
+    {
+        return (current.fetch_add(1));
+    }
+
+    /* static */ uint64_t Epochs::Oldest()
+    {
+        uint64_t result = ~0;
+
+        for (Slot* slot = slots.load(); slot != nullptr; slot = slot->Next) {
+            const uint64_t epoch = slot->Epoch.load();
+
+            if ((epoch != Idle) && (epoch < result)) {
+                result = epoch;
+            }
+        }
+
+        return (result);
+    }
+
+}
+} // namespace Core
@@ -0,0 +1,190 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "Portability.h"
+#include "Sync.h"
+
+namespace WPEFramework {
+namespace Core {
+
+    // -------------------------------------------------------------------
+    // Epoch based reclamation. A reader announces the epoch it starts in,
+    // in a slot of its own thread, so reading takes no lock and writes no
+    // cache line shared with other readers. Whatever is replaced, is
+    // retired in the current epoch, after which the epoch moves on. It can
+    // be deleted as soon as no slot announces that epoch or an older one.
+    // Slots are claimed per thread, handed back when the thread ends and
+    // reused by the next thread, they are never freed.
+    // -------------------------------------------------------------------
+    class EXTERNAL Epochs {
+    public:
+        static constexpr uint64_t Idle = 0;
+
+        Epochs() = delete;
+        Epochs(const Epochs&) = delete;
+        Epochs& operator=(const Epochs&) = delete;
+
+    public:
+        // Nested reads, on the same thread, keep the epoch of the outer read.
+        static void Enter();
+        static void Leave();
+
+        // Returns the epoch that was current, so what is replaced in it can be retired.
+        static uint64_t Advance();
+
+        // The oldest epoch a reader is in, ~0 if there are no readers.
+        static uint64_t Oldest();
+    };
+
+    // -------------------------------------------------------------------
+    // An immutable copy of some data, that is replaced as a whole when the
+    // data changes. Readers access the current copy without taking a lock.
+    // Replaced copies are deleted, through the Epochs, as soon as the last
+    // reader that could have seen them is done. That is checked on every
+    // Replace and by a reader that leaves while copies are waiting, so a
+    // replaced copy does not linger under steady read traffic.
+    // -------------------------------------------------------------------
+    template <typename TYPE>
+    class SnapshotType {
+    public:
+        class Reader {
+        public:
+            Reader() = delete;
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            explicit Reader(const SnapshotType<TYPE>& parent)
+                : _parent(parent)
+                , _snapshot(nullptr)
+            {
+                Epochs::Enter();
+                _snapshot = _parent._current.load();
+            }
+            ~Reader()
+            {
+                Epochs::Leave();
+
+                // Either the Replace that retired a copy saw us reading, and we see it retiring, or it saw us gone.
+                if (_parent._retiring.load() == true) {
+                    const_cast<SnapshotType<TYPE>&>(_parent).Reclaim();
+                }
+            }
+
+        public:
+            const TYPE* operator->() const
+            {
+                return (_snapshot);
+            }
+            const TYPE& operator*() const
+            {
+                return (*_snapshot);
+            }
+
+        private:
+            const SnapshotType<TYPE>& _parent;
+            const TYPE* _snapshot;
+        };
+
+    public:
+        SnapshotType() = delete;
+        SnapshotType(const SnapshotType<TYPE>&) = delete;
+        SnapshotType<TYPE>& operator=(const SnapshotType<TYPE>&) = delete;
+
+        explicit SnapshotType(TYPE* initial)
+            : _adminLock()
+            , _current(initial)
+            , _retired()
+            , _retiring(false)
+        {
+            ASSERT(initial != nullptr);
+        }
+        ~SnapshotType()
+        {
+            for (const std::pair<uint64_t, TYPE*>& entry : _retired) {
+                delete entry.second;
+            }
+            delete _current.load();
+        }
+
+    public:
+        void Replace(TYPE* replacement)
+        {
+            ASSERT(replacement != nullptr);
+
+            _adminLock.Lock();
+
+            TYPE* replaced = _current.exchange(replacement);
+            _retired.emplace_back(Epochs::Advance(), replaced);
+            _retiring.store(true);
+
+            _adminLock.Unlock();
+
+            Reclaim();
+        }
+        // The replaced copies that are still waiting for their readers.
+        uint32_t Retired() const
+        {
+            _adminLock.Lock();
+            const uint32_t result = static_cast<uint32_t>(_retired.size());
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        void Reclaim()
+        {
+            std::vector<TYPE*> expired;
+
+            _adminLock.Lock();
+
+            const uint64_t oldest = Epochs::Oldest();
+            typename std::vector<std::pair<uint64_t, TYPE*>>::iterator index(_retired.begin());
+
+            while (index != _retired.end()) {
+                if (index->first < oldest) {
+                    expired.push_back(index->second);
+                    index = _retired.erase(index);
+                } else {
+                    index++;
+                }
+            }
+
+            _retiring.store(_retired.empty() == false);
+
+            _adminLock.Unlock();
+
+            // Not under our lock, deleting a copy might release what it refers to.
+            for (TYPE* entry : expired) {
+                delete entry;
+            }
+        }
+
+    private:
+        mutable CriticalSection _adminLock;
+        std::atomic<TYPE*> _current;
+        std::vector<std::pair<uint64_t, TYPE*>> _retired;
+        std::atomic<bool> _retiring;
+    };
+
+}
+} // namespace Core
@@ -42,8 +42,10 @@
 #ifdef __APPLE__
 #include <sys/event.h>
 #elif defined(__LINUX__)
+#define __SOCKET_MULTI_MESSAGE__
 #include <signal.h>
 #include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/signalfd.h>
 #ifdef SYSTEMD_FOUND
 #include <systemd/sd-daemon.h>
@@ -206,6 +208,27 @@ namespace WPEFramework {
 
 #else
 
+        static void PacketInterface(struct msghdr& mh, const struct sockaddr* remote, uint32_t& interfaceId) {
+            if ((mh.msg_flags & MSG_CTRUNC) == 0) {
+                for ( // iterate through the control headers
+                    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&mh);
+                    cmsg != NULL;
+                    cmsg = CMSG_NXTHDR(&mh, cmsg))
+                {
+                    if ((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_PKTINFO) && (remote->sa_family == AF_INET)) {
+                        const struct in_pktinfo* info = reinterpret_cast<const struct in_pktinfo*>CMSG_DATA(cmsg);
+                        interfaceId = info->ipi_ifindex;
+                        break;
+                    }
+                    else if ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_PKTINFO) && (remote->sa_family == AF_INET6)) {
+                        const struct in6_pktinfo* info = reinterpret_cast<const struct in6_pktinfo*>CMSG_DATA(cmsg);
+                        interfaceId = info->ipi6_ifindex;
+                        break;
+                    }
+                }
+            }
+        }
+
         static uint32_t ReceiveFrom(SOCKET handle, char* buffer, int bufferSize, struct sockaddr* remote, socklen_t* remoteLength, uint32_t& interfaceId) {
             uint32_t result;
 
@@ -227,29 +250,233 @@ namespace WPEFramework {
             mh.msg_flags = 0;
 
             result = recvmsg(handle, &mh, 0);
-            if ((static_cast<signed int>(result) != SOCKET_ERROR) && ((mh.msg_flags & MSG_CTRUNC) == 0)) {
-                for ( // iterate through the control headers
-                    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&mh);
-                    cmsg != NULL;
-                    cmsg = CMSG_NXTHDR(&mh, cmsg))
-                {
-                    if ((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_PKTINFO) && (remote->sa_family == AF_INET)) {
-                        const struct in_pktinfo* info = reinterpret_cast<const struct in_pktinfo*>CMSG_DATA(cmsg);
-                        interfaceId = info->ipi_ifindex;
+            if (static_cast<signed int>(result) != SOCKET_ERROR) {
+                PacketInterface(mh, remote, interfaceId);
+            }
+
+            return (result);
+        }
+
+#endif
+
+        //////////////////////////////////////////////////////////////////////
+        // SocketPort::Ring
+        //////////////////////////////////////////////////////////////////////
+
+        // The slots of a batched datagram socket. Where recvmmsg/sendmmsg are available, the
+        // message headers are set up once, so a batch costs a single system call.
+        class SocketPort::Ring {
+        private:
+            // Room for the IP_PKTINFO/IPV6_PKTINFO control message of a datagram.
+            static constexpr uint16_t ControlSize = 64;
+
+        public:
+            Ring() = delete;
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+            Ring(const uint16_t slots, const uint32_t sendSize, const uint32_t receiveSize)
+                : _slots(slots)
+                , _sendSize(sendSize)
+                , _receiveSize(receiveSize)
+                , _loaded(0)
+                , _sent(0)
+                , _memory(static_cast<uint8_t*>(::malloc((static_cast<size_t>(sendSize) + receiveSize) * slots)))
+                , _incoming(slots)
+                , _outgoing(slots)
+#ifdef __SOCKET_MULTI_MESSAGE__
+                , _headers(slots)
+                , _vectors(slots)
+                , _addresses(slots)
+                , _control(static_cast<size_t>(ControlSize) * slots)
+#endif
+            {
+                ASSERT(_memory != nullptr);
+
+                for (uint16_t index = 0; index < _slots; index++) {
+                    _incoming[index].Data = &(_memory[static_cast<size_t>(index) * receiveSize]);
+                    _incoming[index].Size = 0;
+                    _incoming[index].Interface = ~0;
+                    _outgoing[index].Size = 0;
+                    _outgoing[index].Interface = ~0;
+                }
+            }
+            ~Ring()
+            {
+                ::free(_memory);
+            }
+
+        public:
+            inline uint16_t Slots() const
+            {
+                return (_slots);
+            }
+            inline bool IsPending() const
+            {
+                return (_sent < _loaded);
+            }
+            // The slots to fill for the next batch, pointing to their own memory again.
+            Datagram* Outgoing()
+            {
+                uint8_t* memory = &(_memory[static_cast<size_t>(_receiveSize) * _slots]);
+
+                for (uint16_t index = 0; index < _slots; index++) {
+                    _outgoing[index].Data = &(memory[static_cast<size_t>(index) * _sendSize]);
+                    _outgoing[index].Size = 0;
+                }
+
+                _loaded = 0;
+                _sent = 0;
+
+                return (_outgoing.data());
+            }
+            inline void Load(const uint16_t count)
+            {
+                ASSERT(count <= _slots);
+
+                _loaded = count;
+                _sent = 0;
+            }
+            inline const Datagram* Incoming() const
+            {
+                return (_incoming.data());
+            }
+
+            // Returns the number of datagrams received, or SOCKET_ERROR if none could be.
+            int32_t Receive(SOCKET socket)
+            {
+                int32_t result;
+
+#ifdef __SOCKET_MULTI_MESSAGE__
+                for (uint16_t index = 0; index < _slots; index++) {
+                    struct msghdr& header(_headers[index].msg_hdr);
+
+                    _vectors[index].iov_base = _incoming[index].Data;
+                    _vectors[index].iov_len = _receiveSize;
+
+                    header.msg_name = &(_addresses[index]);
+                    header.msg_namelen = sizeof(NodeId::SocketInfo);
+                    header.msg_iov = &(_vectors[index]);
+                    header.msg_iovlen = 1;
+                    header.msg_control = &(_control[static_cast<size_t>(index) * ControlSize]);
+                    header.msg_controllen = ControlSize;
+                    header.msg_flags = 0;
+                }
+
+                result = ::recvmmsg(socket, _headers.data(), _slots, MSG_DONTWAIT, nullptr);
+
+                for (int32_t index = 0; index < result; index++) {
+                    Datagram& entry(_incoming[index]);
+
+                    entry.Size = _headers[index].msg_len;
+                    entry.Remote = _addresses[index];
+                    entry.Interface = ~0;
+
+                    PacketInterface(_headers[index].msg_hdr, reinterpret_cast<const struct sockaddr*>(&(_addresses[index])), entry.Interface);
+                }
+#else
+                result = 0;
+
+                while (result < _slots) {
+                    Datagram& entry(_incoming[result]);
+                    NodeId::SocketInfo remote;
+                    socklen_t length = sizeof(remote);
+
+                    entry.Interface = ~0;
+
+                    const uint32_t size = ReceiveFrom(socket, reinterpret_cast<char*>(entry.Data), _receiveSize, reinterpret_cast<struct sockaddr*>(&remote), &length, entry.Interface);
+
+                    if (size == static_cast<uint32_t>(SOCKET_ERROR)) {
                         break;
                     }
-                    else if ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_PKTINFO) && (remote->sa_family == AF_INET6)) {
-                        const struct in6_pktinfo* info = reinterpret_cast<const struct in6_pktinfo*>CMSG_DATA(cmsg);
-                        interfaceId = info->ipi6_ifindex;
+
+                    entry.Size = size;
+                    entry.Remote = remote;
+                    result++;
+                }
+
+                if (result == 0) {
+                    result = SOCKET_ERROR;
+                }
+#endif
+
+                return (result);
+            }
+
+            // Returns the number of datagrams sent, or SOCKET_ERROR if none could be.
+            int32_t Send(SOCKET socket)
+            {
+                int32_t result;
+
+                ASSERT(_sent < _loaded);
+
+#ifdef __SOCKET_MULTI_MESSAGE__
+                for (uint16_t index = _sent; index < _loaded; index++) {
+                    struct msghdr& header(_headers[index].msg_hdr);
+                    const Datagram& entry(_outgoing[index]);
+
+                    _vectors[index].iov_base = entry.Data;
+                    _vectors[index].iov_len = entry.Size;
+
+                    ::memset(&header, 0, sizeof(header));
+                    if (entry.Remote.IsValid() == true) {
+                        header.msg_name = const_cast<NodeId::SocketInfo*>(&(static_cast<const NodeId::SocketInfo&>(entry.Remote)));
+                        header.msg_namelen = entry.Remote.Size();
+                    }
+                    header.msg_iov = &(_vectors[index]);
+                    header.msg_iovlen = 1;
+                }
+
+                result = ::sendmmsg(socket, &(_headers[_sent]), _loaded - _sent, MSG_DONTWAIT | MSG_NOSIGNAL);
+#else
+                result = 0;
+
+                while ((_sent + result) < _loaded) {
+                    const Datagram& entry(_outgoing[_sent + result]);
+                    int32_t size;
+
+                    if (entry.Remote.IsValid() == true) {
+                        size = ::sendto(socket, reinterpret_cast<const char*>(entry.Data), entry.Size, 0, static_cast<const NodeId&>(entry.Remote), entry.Remote.Size());
+                    }
+                    else {
+                        size = ::send(socket, reinterpret_cast<const char*>(entry.Data), entry.Size, 0);
+                    }
+
+                    if (size < 0) {
                         break;
                     }
+
+                    result++;
                 }
-            }
 
-            return (result);
-        }
+                if (result == 0) {
+                    result = SOCKET_ERROR;
+                }
+#endif
 
+                if (result > 0) {
+                    _sent += static_cast<uint16_t>(result);
+                }
+
+                return (result);
+            }
+
+        private:
+            const uint16_t _slots;
+            const uint32_t _sendSize;
+            const uint32_t _receiveSize;
+            uint16_t _loaded;
+            uint16_t _sent;
+            uint8_t* _memory;
+            std::vector<Datagram> _incoming;
+            std::vector<Datagram> _outgoing;
+#ifdef __SOCKET_MULTI_MESSAGE__
+            std::vector<struct mmsghdr> _headers;
+            std::vector<struct iovec> _vectors;
+            std::vector<NodeId::SocketInfo> _addresses;
+            std::vector<uint8_t> _control;
 #endif
+        };
 
         //////////////////////////////////////////////////////////////////////
         // SocketPort::SocketMonitor
@@ -314,8 +541,8 @@ namespace WPEFramework {
             const enumType socketType,
             const NodeId& refLocalNode,
             const NodeId& refRemoteNode,
-            const uint16_t nSendBufferSize,
-            const uint16_t nReceiveBufferSize)
+            const uint32_t nSendBufferSize,
+            const uint32_t nReceiveBufferSize)
             : SocketPort(socketType, refLocalNode, refRemoteNode, nSendBufferSize, nReceiveBufferSize, nSendBufferSize, nReceiveBufferSize)
         {
         }
@@ -324,14 +551,20 @@ namespace WPEFramework {
             const enumType socketType,
             const NodeId& refLocalNode,
             const NodeId& refremoteNode,
-            const uint16_t nSendBufferSize,
-            const uint16_t nReceiveBufferSize,
+            const uint32_t nSendBufferSize,
+            const uint32_t nReceiveBufferSize,
             const uint32_t nSocketSendBufferSize,
             const uint32_t nSocketReceiveBufferSize)
             : m_LocalNode(refLocalNode)
             , m_RemoteNode(refremoteNode)
             , m_ReceiveBufferSize(nReceiveBufferSize)
             , m_SendBufferSize(nSendBufferSize)
+            , m_ReceiveBufferConfigured(nReceiveBufferSize)
+            , m_SendBufferConfigured(nSendBufferSize)
+            , m_ReceiveBufferBase(0)
+            , m_SendBufferBase(0)
+            , m_ReceiveBufferLimit(0)
+            , m_SendBufferLimit(0)
             , m_SocketReceiveBufferSize(nSocketReceiveBufferSize)
             , m_SocketSendBufferSize(nSocketSendBufferSize)
             , m_SocketType(socketType)
@@ -341,6 +574,15 @@ namespace WPEFramework {
             , m_ReceivedNode()
             , m_SendBuffer(nullptr)
             , m_ReceiveBuffer(nullptr)
+            , m_ReadBytes(0)
+            , m_SendBytes(0)
+            , m_SendOffset(0)
+            , m_Segments(0)
+            , m_SegmentIndex(0)
+            , m_SegmentOffset(0)
+            , m_File()
+            , m_Batch(0)
+            , m_Ring(nullptr)
             , m_Interface(~0)
             , m_SystemdSocket(false)
         {
@@ -351,8 +593,8 @@ namespace WPEFramework {
             const enumType socketType,
             const SOCKET& refConnector,
             const NodeId& remoteNode,
-            const uint16_t nSendBufferSize,
-            const uint16_t nReceiveBufferSize)
+            const uint32_t nSendBufferSize,
+            const uint32_t nReceiveBufferSize)
             : SocketPort(socketType, refConnector, remoteNode, nSendBufferSize, nReceiveBufferSize, nSendBufferSize, nReceiveBufferSize)
         {
         }
@@ -361,14 +603,20 @@ namespace WPEFramework {
             const enumType socketType,
             const SOCKET& refConnector,
             const NodeId& remoteNode,
-            const uint16_t nSendBufferSize,
-            const uint16_t nReceiveBufferSize,
+            const uint32_t nSendBufferSize,
+            const uint32_t nReceiveBufferSize,
             const uint32_t nSocketSendBufferSize,
             const uint32_t nSocketReceiveBufferSize)
             : m_LocalNode(remoteNode.AnyInterface())
             , m_RemoteNode(remoteNode)
             , m_ReceiveBufferSize(nReceiveBufferSize)
             , m_SendBufferSize(nSendBufferSize)
+            , m_ReceiveBufferConfigured(nReceiveBufferSize)
+            , m_SendBufferConfigured(nSendBufferSize)
+            , m_ReceiveBufferBase(0)
+            , m_SendBufferBase(0)
+            , m_ReceiveBufferLimit(0)
+            , m_SendBufferLimit(0)
             , m_SocketReceiveBufferSize(nSocketSendBufferSize)
             , m_SocketSendBufferSize(nSocketReceiveBufferSize)
             , m_SocketType(socketType)
@@ -378,6 +626,15 @@ namespace WPEFramework {
             , m_ReceivedNode()
             , m_SendBuffer(nullptr)
             , m_ReceiveBuffer(nullptr)
+            , m_ReadBytes(0)
+            , m_SendBytes(0)
+            , m_SendOffset(0)
+            , m_Segments(0)
+            , m_SegmentIndex(0)
+            , m_SegmentOffset(0)
+            , m_File()
+            , m_Batch(0)
+            , m_Ring(nullptr)
             , m_Interface(~0)
             , m_SystemdSocket(false)
         {
@@ -417,6 +674,9 @@ namespace WPEFramework {
             }
 
             ::free(m_SendBuffer);
+            ::free(m_ReceiveBuffer);
+
+            delete m_Ring;
         }
 
         //////////////////////////////////////////////////////////////////////
@@ -479,6 +739,10 @@ namespace WPEFramework {
             m_ReadBytes = 0;
             m_SendBytes = 0;
             m_SendOffset = 0;
+            m_Segments = 0;
+            m_SegmentIndex = 0;
+            m_SegmentOffset = 0;
+            m_File.Size = 0;
 
             if ((m_State.load(Core::memory_order::memory_order_relaxed) & (SocketPort::LINK | SocketPort::OPEN | SocketPort::MONITOR)) == (SocketPort::LINK | SocketPort::OPEN)) {
                 // Open up an accepted socket, but not yet added to the monitor.
@@ -607,7 +871,7 @@ namespace WPEFramework {
 #endif
                     }
 
-                    ResourceMonitor::Instance().Break();
+                    ResourceMonitor::Instance().Break(*this);
                 } else {
                     TRACE_L3("Socket is already closed or being closed");
                 }
@@ -621,7 +885,7 @@ namespace WPEFramework {
 
                         // We probably did not get a response from the otherside on the close
                         // sloppy but let's forcefully close it
-                        ResourceMonitor::Instance().Break();
+                        ResourceMonitor::Instance().Break(*this);
 
                         closed = (WaitForClosure(Core::infinite) == Core::ERROR_NONE);
 
@@ -644,7 +908,7 @@ namespace WPEFramework {
             if ((m_State & (SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) {
 
                 m_State |= SocketPort::WRITESLOT;
-                ResourceMonitor::Instance().Break();
+                ResourceMonitor::Instance().Break(*this);
             }
             m_syncAdmin.Unlock();
         }
@@ -657,6 +921,10 @@ namespace WPEFramework {
         {
             socklen_t valueLength = sizeof(int);
 
+            // Adaptive buffers might have grown while the previous socket was open, start over from what was asked for.
+            m_ReceiveBufferSize = m_ReceiveBufferConfigured;
+            m_SendBufferSize = m_SendBufferConfigured;
+
             const uint32_t origSocketReceiveBufferSize = m_SocketReceiveBufferSize;
 
             if (m_SocketReceiveBufferSize != static_cast<uint32_t>(~0)) {
@@ -673,10 +941,8 @@ namespace WPEFramework {
                 TRACE_L3("Adjusted socket receive buffer size (%u->%u)", origSocketReceiveBufferSize, m_SocketReceiveBufferSize);
             }
 
-            if (m_ReceiveBufferSize == static_cast<uint16_t>(~0)) {
-                if (m_SocketReceiveBufferSize < 0xFFFF) {
-                    m_ReceiveBufferSize = static_cast<uint16_t>(m_SocketReceiveBufferSize);
-                }
+            if (m_ReceiveBufferSize == AutoBufferSize) {
+                m_ReceiveBufferSize = m_SocketReceiveBufferSize;
 
                 TRACE_L2("Chosen user receive buffer size (%u)", m_ReceiveBufferSize);
             }
@@ -695,27 +961,31 @@ namespace WPEFramework {
                 TRACE_L3("Adjusted socket send buffer size (%u->%u)", origSocketSendBufferSize, m_SocketSendBufferSize);
             }
 
-            if (m_SendBufferSize == static_cast<uint16_t>(~0)) {
-                if (m_SocketSendBufferSize < 0xFFFF) {
-                    m_SendBufferSize = static_cast<uint16_t>(m_SocketSendBufferSize);
-                }
+            if (m_SendBufferSize == AutoBufferSize) {
+                m_SendBufferSize = m_SocketSendBufferSize;
 
                 TRACE_L2("Chosen user send buffer size (%u)", m_SendBufferSize);
             }
 
-            if ((m_ReceiveBufferSize != 0) || (m_SendBufferSize != 0)) {
-                uint8_t* allocatedMemory = static_cast<uint8_t*>(::calloc(m_SendBufferSize + m_ReceiveBufferSize, 1));
-                ASSERT(allocatedMemory != nullptr);
+            // The size they were set up with is where adaptive buffers return to (see AdaptiveBuffers).
+            m_SendBufferBase = m_SendBufferSize;
+            m_ReceiveBufferBase = m_ReceiveBufferSize;
 
-                if (m_SendBuffer != nullptr) {
-                    ::free(m_SendBuffer);
-                }
-                else if (m_ReceiveBuffer != nullptr) {
-                    ::free(m_ReceiveBuffer);
-                }
+            // Separate allocations, so each of them can grow and shrink on its own.
+            ::free(m_SendBuffer);
+            ::free(m_ReceiveBuffer);
+
+            m_SendBuffer = (m_SendBufferSize != 0 ? static_cast<uint8_t*>(::calloc(m_SendBufferSize, 1)) : nullptr);
+            m_ReceiveBuffer = (m_ReceiveBufferSize != 0 ? static_cast<uint8_t*>(::calloc(m_ReceiveBufferSize, 1)) : nullptr);
+
+            ASSERT((m_SendBufferSize == 0) || (m_SendBuffer != nullptr));
+            ASSERT((m_ReceiveBufferSize == 0) || (m_ReceiveBuffer != nullptr));
 
-                m_SendBuffer = (m_SendBufferSize != 0 ? allocatedMemory : nullptr);
-                m_ReceiveBuffer = (m_ReceiveBufferSize != 0 ? &(allocatedMemory[m_SendBufferSize]) : nullptr);
+            delete m_Ring;
+            m_Ring = nullptr;
+
+            if ((m_Batch > 1) && ((m_SocketType == DATAGRAM) || (m_SocketType == RAW)) && (m_LocalNode.Type() != NodeId::TYPE_NETLINK)) {
+                m_Ring = new Ring(m_Batch, m_SendBufferSize, m_ReceiveBufferSize);
             }
         }
 
@@ -893,7 +1163,7 @@ namespace WPEFramework {
             // Right, a wait till connection is closed is requested..
             while ((waiting > 0) && (IsOpen() == false)) {
                 // Make sure we aren't in the monitor thread waiting for close completion.
-                ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+                ASSERT(ResourceMonitor::Instance().IsReactor(Core::Thread::ThreadId()) == false);
 
                 uint32_t sleepSlot = (waiting > SLEEPSLOT_POLLING_TIME ? SLEEPSLOT_POLLING_TIME : waiting);
 
@@ -928,7 +1198,7 @@ namespace WPEFramework {
                     break;
                 }
                 // Make sure we aren't in the monitor thread waiting for close completion.
-                ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+                ASSERT(ResourceMonitor::Instance().IsReactor(Core::Thread::ThreadId()) == false);
 
                 uint32_t sleepSlot = (waiting > SLEEPSLOT_POLLING_TIME ? SLEEPSLOT_POLLING_TIME : waiting);
 
@@ -956,7 +1226,7 @@ namespace WPEFramework {
             // Right, a wait till connection is closed is requested..
             while ((waiting > 0) && (IsClosed() == false)) {
                 // Make sure we aren't in the monitor thread waiting for close completion.
-                ASSERT(Core::Thread::ThreadId() != ResourceMonitor::Instance().Id());
+                ASSERT(ResourceMonitor::Instance().IsReactor(Core::Thread::ThreadId()) == false);
 
                 uint32_t sleepSlot = (waiting > SLEEPSLOT_POLLING_TIME ? SLEEPSLOT_POLLING_TIME : waiting);
 
@@ -1096,14 +1366,157 @@ namespace WPEFramework {
             }
         }
 
-        /* virtual */ int32_t SocketPort::Read(uint8_t buffer[], const uint16_t length) const {
+        /* virtual */ int32_t SocketPort::Read(uint8_t buffer[], const uint32_t length) const {
             return (::recv(m_Socket, reinterpret_cast<char*>(buffer), length, 0));
         }
 
-        /* virtual */ int32_t SocketPort::Write(const uint8_t buffer[], const uint16_t length) {
+        /* virtual */ int32_t SocketPort::Write(const uint8_t buffer[], const uint32_t length) {
             return (::send(m_Socket, reinterpret_cast<const char*>(buffer), length, 0));
         }
 
+        /* virtual */ int32_t SocketPort::Write(const Segment segments[], const uint8_t count) {
+#ifdef __WINDOWS__
+            WSABUF vector[MaxSegments];
+            DWORD sent = 0;
+
+            ASSERT(count <= MaxSegments);
+
+            for (uint8_t index = 0; index < count; index++) {
+                vector[index].buf = reinterpret_cast<CHAR*>(const_cast<uint8_t*>(segments[index].Data));
+                vector[index].len = segments[index].Size;
+            }
+
+            return (::WSASend(m_Socket, vector, count, &sent, 0, nullptr, nullptr) == 0 ? static_cast<int32_t>(sent) : SOCKET_ERROR);
+#else
+            struct iovec vector[MaxSegments];
+            struct msghdr message;
+
+            ASSERT(count <= MaxSegments);
+
+            for (uint8_t index = 0; index < count; index++) {
+                vector[index].iov_base = const_cast<uint8_t*>(segments[index].Data);
+                vector[index].iov_len = segments[index].Size;
+            }
+
+            ::memset(&message, 0, sizeof(message));
+            message.msg_iov = vector;
+            message.msg_iovlen = count;
+
+            return (::sendmsg(m_Socket, &message, MSG_NOSIGNAL));
+#endif
+        }
+
+        /* virtual */ int32_t SocketPort::Write(const Region& region) {
+#if defined(__LINUX__) && !defined(__APPLE__)
+            off_t offset = static_cast<off_t>(region.Offset);
+
+            // Linux does not send more than this in one go anyway.
+            return (static_cast<int32_t>(::sendfile(m_Socket, region.Descriptor, &offset, static_cast<size_t>(std::min(region.Size, static_cast<uint64_t>(0x7FFFF000))))));
+#else
+            return (Copy(region));
+#endif
+        }
+
+        // Sends (the start of) a region through the send buffer, which is empty by the time the region
+        // is sent. The data is read again if it is not sent completely, the file position is not used.
+        int32_t SocketPort::Copy(const Region& region) {
+            const uint32_t size = static_cast<uint32_t>(std::min(region.Size, static_cast<uint64_t>(m_SendBufferSize)));
+            int32_t result;
+
+            ASSERT(m_SendBuffer != nullptr);
+
+#ifdef __WINDOWS__
+            OVERLAPPED position;
+            DWORD loaded = 0;
+
+            ::memset(&position, 0, sizeof(position));
+            position.Offset = static_cast<DWORD>(region.Offset & 0xFFFFFFFF);
+            position.OffsetHigh = static_cast<DWORD>(region.Offset >> 32);
+
+            result = (::ReadFile(region.Descriptor, m_SendBuffer, size, &loaded, &position) != FALSE ? static_cast<int32_t>(loaded) : -1);
+#else
+            result = static_cast<int32_t>(::pread(region.Descriptor, m_SendBuffer, size, static_cast<off_t>(region.Offset)));
+#endif
+
+            if (result > 0) {
+                result = Write(m_SendBuffer, static_cast<uint32_t>(result));
+            }
+
+            return (result);
+        }
+
+        // Gather everything that is waiting to be sent: keep asking for data as long as it fits the
+        // send buffer, so small messages do not each take a system call, and pick up the segments.
+        void SocketPort::Fill()
+        {
+            uint32_t size;
+
+            m_SendOffset = 0;
+            m_SendBytes = 0;
+
+            do {
+                size = SendData(&(m_SendBuffer[m_SendBytes]), m_SendBufferSize - m_SendBytes);
+                m_SendBytes += size;
+
+                ASSERT(m_SendBytes <= m_SendBufferSize);
+
+            } while ((size != 0) && (m_SendBytes < m_SendBufferSize));
+
+            m_SegmentIndex = 0;
+            m_SegmentOffset = 0;
+            m_Segments = SendSegments(m_Segment, MaxSegments);
+
+            ASSERT(m_Segments <= MaxSegments);
+
+            m_File.Size = 0;
+
+            if ((SendFile(m_File) == true) && (m_File.Size == 0)) {
+                FileSent();
+            }
+        }
+
+        // Resize one of the buffers, keeping the data it holds. If there is not enough memory, it just stays
+        // the way it is.
+        void SocketPort::Adapt(uint8_t*& buffer, uint32_t& size, const uint32_t required, const uint32_t keep)
+        {
+            if ((required != size) && (required != 0) && (required >= keep) && (buffer != nullptr)) {
+                uint8_t* resized = static_cast<uint8_t*>(::realloc(buffer, required));
+
+                if (resized != nullptr) {
+                    TRACE_L3("Socket %u buffer resized (%u->%u)", static_cast<uint32_t>(m_Socket), size, required);
+
+                    buffer = resized;
+                    size = required;
+                }
+            }
+        }
+
+        void SocketPort::Sent(uint32_t size)
+        {
+            const uint32_t buffered = std::min(size, m_SendBytes - m_SendOffset);
+            const uint8_t first = m_SegmentIndex;
+
+            m_SendOffset += buffered;
+            size -= buffered;
+
+            while (m_SegmentIndex < m_Segments) {
+                const uint32_t left = m_Segment[m_SegmentIndex].Size - m_SegmentOffset;
+
+                if (size < left) {
+                    m_SegmentOffset += size;
+                    break;
+                }
+
+                size -= left;
+                m_SegmentOffset = 0;
+                m_SegmentIndex++;
+            }
+
+            if (m_SegmentIndex != first) {
+                SegmentsSent(m_SegmentIndex - first);
+            }
+        }
+
         void SocketPort::Write()
         {
             bool dataLeftToSend = true;
@@ -1112,21 +1525,73 @@ namespace WPEFramework {
 
             m_State &= (~(SocketPort::WRITE | SocketPort::WRITESLOT));
 
+            if (m_Ring != nullptr) {
+                WriteBatch();
+                dataLeftToSend = false;
+            }
+
             while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
-                if (m_SendOffset == m_SendBytes) {
-                    m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
-                    m_SendOffset = 0;
-                    dataLeftToSend = (m_SendOffset != m_SendBytes);
+                if ((m_SendOffset == m_SendBytes) && (m_SegmentIndex == m_Segments) && (m_File.Size == 0)) {
+                    if ((m_State & SocketPort::LINK) != 0) {
+                        // The last round filled up the buffer completely, a bulk transfer is going on.
+                        if ((m_SendBufferLimit > m_SendBufferSize) && (m_SendBytes == m_SendBufferSize)) {
+                            Adapt(m_SendBuffer, m_SendBufferSize, std::min(m_SendBufferLimit, 2 * m_SendBufferSize), 0);
+                        }
+
+                        Fill();
+
+                        // Nothing to send anymore, back to the size we started with.
+                        if ((m_SendBytes == 0) && (m_SendBufferLimit != 0) && (m_SendBufferSize != m_SendBufferBase)) {
+                            Adapt(m_SendBuffer, m_SendBufferSize, m_SendBufferBase, 0);
+                        }
+                    }
+                    else {
+                        // Every SendData is a datagram of its own.
+                        m_SendBytes = SendData(m_SendBuffer, m_SendBufferSize);
+                        m_SendOffset = 0;
 
-                    ASSERT(m_SendBytes <= m_SendBufferSize);
+                        ASSERT(m_SendBytes <= m_SendBufferSize);
+                    }
+
+                    dataLeftToSend = ((m_SendOffset != m_SendBytes) || (m_SegmentIndex != m_Segments) || (m_File.Size != 0));
                 }
 
                 if (dataLeftToSend == true) {
+                    const bool region = ((m_SendOffset == m_SendBytes) && (m_SegmentIndex == m_Segments));
                     int32_t sendSize;
 
                     // Sockets are non blocking the Send buffer size is equal to the buffer size. We only send
                     // if the buffer free (SEND flag) is active, so the buffer should always fit.
-                    if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
+                    if (m_SegmentIndex != m_Segments) {
+                        Segment vector[MaxSegments];
+                        uint8_t count = 0;
+
+                        if (m_SendOffset != m_SendBytes) {
+                            vector[count].Data = &(m_SendBuffer[m_SendOffset]);
+                            vector[count].Size = m_SendBytes - m_SendOffset;
+                            count++;
+                        }
+
+                        for (uint8_t index = m_SegmentIndex; (index < m_Segments) && (count < MaxSegments); index++, count++) {
+                            const uint32_t skip = (index == m_SegmentIndex ? m_SegmentOffset : 0);
+
+                            vector[count].Data = &(m_Segment[index].Data[skip]);
+                            vector[count].Size = m_Segment[index].Size - skip;
+                        }
+
+                        sendSize = Write(vector, count);
+                    }
+                    else if (region == true) {
+                        sendSize = Write(m_File);
+
+                        if (sendSize == 0) {
+                            // The file is shorter than promised, the other side would wait forever.
+                            TRACE_L1("File region on socket %u ends prematurely", static_cast<uint32_t>(m_Socket));
+                            m_State |= SocketPort::EXCEPTION;
+                            StateChange();
+                        }
+                    }
+                    else if (((m_State & SocketPort::LINK) == 0) && (m_RemoteNode.IsValid() == true)) {
                         ASSERT(m_RemoteNode.IsValid() == true);
 
                         sendSize = ::sendto(m_Socket,
@@ -1141,7 +1606,20 @@ namespace WPEFramework {
                     }
 
                     if (sendSize >= 0) {
-                        m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+                        if (region == true) {
+                            m_File.Offset += sendSize;
+                            m_File.Size -= sendSize;
+
+                            if (m_File.Size == 0) {
+                                FileSent();
+                            }
+                        }
+                        else if (m_SegmentIndex != m_Segments) {
+                            Sent(static_cast<uint32_t>(sendSize));
+                        }
+                        else {
+                            m_SendOffset = ((m_State & SocketPort::LINK) != 0 ? m_SendOffset + sendSize : m_SendBytes);
+                        }
                     }
                     else {
                         uint32_t l_Result = __ERRORRESULT__;
@@ -1163,11 +1641,17 @@ namespace WPEFramework {
 
         void SocketPort::Read()
         {
+            bool bulk = false;
+
             m_syncAdmin.Lock();
 
             m_State &= (~SocketPort::READ);
 
-            while ((m_State & (SocketPort::READ | SocketPort::EXCEPTION | SocketPort::OPEN)) == SocketPort::OPEN) {
+            if (m_Ring != nullptr) {
+                ReadBatch();
+            }
+
+            while ((m_Ring == nullptr) && (m_State & (SocketPort::READ | SocketPort::EXCEPTION | SocketPort::OPEN)) == SocketPort::OPEN) {
                 uint32_t l_Size;
 
                 if (m_ReadBytes == m_ReceiveBufferSize) {
@@ -1197,6 +1681,12 @@ namespace WPEFramework {
                 }
                 else if (l_Size != static_cast<uint32_t>(SOCKET_ERROR)) {
                     m_ReadBytes += l_Size;
+
+                    // The read filled up the buffer completely, there is more where that came from.
+                    if ((m_ReadBytes == m_ReceiveBufferSize) && ((m_State & SocketPort::LINK) != 0) && (m_ReceiveBufferLimit > m_ReceiveBufferSize)) {
+                        Adapt(m_ReceiveBuffer, m_ReceiveBufferSize, std::min(m_ReceiveBufferLimit, 2 * m_ReceiveBufferSize), m_ReadBytes);
+                        bulk = true;
+                    }
                 }
                 else {
                     uint32_t l_Result = __ERRORRESULT__;
@@ -1215,7 +1705,7 @@ namespace WPEFramework {
                 }
 
                 if (m_ReadBytes != 0) {
-                    uint16_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
+                    uint32_t handledBytes = ReceiveData(m_ReceiveBuffer, m_ReadBytes);
 
                     ASSERT(m_ReadBytes >= handledBytes);
 
@@ -1228,9 +1718,102 @@ namespace WPEFramework {
                 }
             }
 
+            // Everything that came in was handled, back to the size we started with.
+            if ((bulk == false) && (m_ReadBytes == 0) && (m_ReceiveBufferLimit != 0) && (m_ReceiveBufferSize != m_ReceiveBufferBase)) {
+                Adapt(m_ReceiveBuffer, m_ReceiveBufferSize, m_ReceiveBufferBase, 0);
+            }
+
             m_syncAdmin.Unlock();
         }
 
+        /* virtual */ void SocketPort::ReceiveBatch(const Datagram datagrams[], const uint16_t count)
+        {
+            for (uint16_t index = 0; index < count; index++) {
+                m_ReceivedNode = datagrams[index].Remote;
+                m_Interface = datagrams[index].Interface;
+
+                ReceiveData(datagrams[index].Data, datagrams[index].Size);
+            }
+        }
+
+        /* virtual */ uint16_t SocketPort::SendBatch(Datagram datagrams[], const uint16_t slots)
+        {
+            uint16_t count = 0;
+
+            while (count < slots) {
+                Datagram& entry(datagrams[count]);
+
+                entry.Size = SendData(entry.Data, m_SendBufferSize);
+
+                if (entry.Size == 0) {
+                    break;
+                }
+
+                ASSERT(entry.Size <= m_SendBufferSize);
+
+                entry.Remote = m_RemoteNode;
+                count++;
+            }
+
+            return (count);
+        }
+
+        // Called with the m_syncAdmin taken, on a datagram socket that has batch slots.
+        void SocketPort::ReadBatch()
+        {
+            while ((m_State & (SocketPort::READ | SocketPort::EXCEPTION | SocketPort::OPEN)) == SocketPort::OPEN) {
+                const int32_t count = m_Ring->Receive(m_Socket);
+
+                if (count > 0) {
+                    ReceiveBatch(m_Ring->Incoming(), static_cast<uint16_t>(count));
+                }
+                else if (count == 0) {
+                    m_State |= SocketPort::READ;
+                }
+                else {
+                    uint32_t l_Result = __ERRORRESULT__;
+
+                    if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__) || (l_Result == 0)) {
+                        m_State |= SocketPort::READ;
+                    }
+                    else {
+                        printf("Read exception %d: %s\n", l_Result, strerror(__ERRORRESULT__));
+                        m_State |= SocketPort::EXCEPTION;
+                        StateChange();
+                    }
+                }
+            }
+        }
+
+        // Called with the m_syncAdmin taken, on a datagram socket that has batch slots.
+        void SocketPort::WriteBatch()
+        {
+            bool dataLeftToSend = true;
+
+            while (((m_State & (SocketPort::WRITE | SocketPort::SHUTDOWN | SocketPort::OPEN | SocketPort::EXCEPTION)) == SocketPort::OPEN) && (dataLeftToSend == true)) {
+                if (m_Ring->IsPending() == false) {
+                    Datagram* slots = m_Ring->Outgoing();
+
+                    m_Ring->Load(SendBatch(slots, m_Ring->Slots()));
+
+                    dataLeftToSend = m_Ring->IsPending();
+                }
+
+                if ((dataLeftToSend == true) && (m_Ring->Send(m_Socket) < 0)) {
+                    uint32_t l_Result = __ERRORRESULT__;
+
+                    if ((l_Result == __ERROR_WOULDBLOCK__) || (l_Result == __ERROR_AGAIN__) || (l_Result == __ERROR_INPROGRESS__)) {
+                        m_State |= SocketPort::WRITE;
+                    }
+                    else {
+                        printf("Write exception %d: %s\n", l_Result, strerror(__ERRORRESULT__));
+                        m_State |= SocketPort::EXCEPTION;
+                        StateChange();
+                    }
+                }
+            }
+        }
+
         bool SocketPort::Closed()
         {
             bool result = true;
@@ -24,6 +24,7 @@
 #ifndef __SOCKETPORT_H
 #define __SOCKETPORT_H
 
+#include "FileSystem.h"
 #include "Module.h"
 #include "NodeId.h"
 #include "Portability.h"
@@ -81,32 +82,58 @@ namespace WPEFramework {
 
             } enumType;
 
+            struct Segment {
+                const uint8_t* Data;
+                uint32_t Size;
+            };
+
+            // The number of segments that is handed to the kernel at once.
+            static constexpr uint8_t MaxSegments = 32;
+
+            // As send or receive buffer size, the buffer gets the size the kernel chose for the socket buffer.
+            static constexpr uint32_t AutoBufferSize = static_cast<uint32_t>(~0);
+
+            // A part of an open file, to be sent without reading it first.
+            struct Region {
+                File::Handle Descriptor;
+                uint64_t Offset;
+                uint64_t Size;
+            };
+
+            // A slot of the ring a batched datagram socket receives in and sends from.
+            struct Datagram {
+                uint8_t* Data;
+                uint32_t Size;
+                NodeId Remote;
+                uint32_t Interface;
+            };
+
         public:
             SocketPort(const enumType socketType,
                 const NodeId& localNode,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize);
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize);
 
             SocketPort(const enumType socketType,
                 const NodeId& localNode,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize,
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize,
                 const uint32_t socketSendBufferSize,
                 const uint32_t socketReceiveBufferSize);
 
             SocketPort(const enumType socketType,
                 const SOCKET& connector,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize);
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize);
 
             SocketPort(const enumType socketType,
                 const SOCKET& connector,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize,
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize,
                 const uint32_t socketSendBufferSize,
                 const uint32_t socketReceiveBufferSize);
 
@@ -193,11 +220,11 @@ namespace WPEFramework {
             inline uint32_t ReceivedInterface() const {
                 return (m_Interface);
             }
-            inline uint16_t SendBufferSize() const
+            inline uint32_t SendBufferSize() const
             {
                 return (m_SendBufferSize);
             }
-            inline uint16_t ReceiveBufferSize() const
+            inline uint32_t ReceiveBufferSize() const
             {
                 return (m_ReceiveBufferSize);
             }
@@ -215,6 +242,16 @@ namespace WPEFramework {
                 m_ReadBytes = 0;
                 m_SendBytes = 0;
                 m_SendOffset = 0;
+                if (m_SegmentIndex != m_Segments) {
+                    SegmentsSent(m_Segments - m_SegmentIndex);
+                }
+                m_Segments = 0;
+                m_SegmentIndex = 0;
+                m_SegmentOffset = 0;
+                if (m_File.Size != 0) {
+                    m_File.Size = 0;
+                    FileSent();
+                }
                 m_syncAdmin.Unlock();
             }
 
@@ -236,8 +273,44 @@ namespace WPEFramework {
             void Trigger();
 
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
+
+            // Data that is already serialized somewhere else, e.g. a frame header and a body that
+            // is shared with other channels, can be handed over as segments instead of copying it
+            // into the send buffer. On a stream socket, whatever SendData put in the send buffer and
+            // all segments handed over here go out in a single writev(). The segments should stay
+            // valid until SegmentsSent reports them done, in the order they were handed over.
+            virtual uint8_t SendSegments(Segment /* segments */[], const uint8_t /* maxSegments */)
+            {
+                return (0);
+            }
+            virtual void SegmentsSent(const uint8_t /* count */)
+            {
+            }
+
+            // After the send buffer and the segments, a stream socket asks for a part of a file to
+            // send. It is passed to the kernel directly (sendfile), or read in chunks through the
+            // send buffer where that is not possible, e.g. on a secure socket. FileSent reports that
+            // the region is done with, the descriptor should stay open until then.
+            virtual bool SendFile(Region& /* region */)
+            {
+                return (false);
+            }
+            virtual void FileSent()
+            {
+            }
+
+            // A datagram socket set up with a number of batch slots (see SocketDatagram::Batch)
+            // receives and sends up to that many datagrams in a single system call. The received
+            // datagrams are handed over in one go, every datagram is consumed as a whole. By default
+            // they are passed on one by one to ReceiveData, with the ReceivedNode set accordingly.
+            virtual void ReceiveBatch(const Datagram datagrams[], const uint16_t count);
+            // To send, the Data of each slot points to SendBufferSize bytes that can be filled, or
+            // can be pointed elsewhere as long as that stays valid until the next call. Fill in the
+            // Size and the Remote of each datagram and return the number of slots used. By default,
+            // the slots are filled by SendData and sent to the RemoteNode.
+            virtual uint16_t SendBatch(Datagram datagrams[], const uint16_t slots);
 
             // Signal a state change, Opened, Closed or Accepted
             virtual void StateChange() = 0;
@@ -253,8 +326,24 @@ namespace WPEFramework {
 
         protected:
             virtual uint32_t Initialize();
-            virtual int32_t Read(uint8_t buffer[], const uint16_t length) const;
-            virtual int32_t Write(const uint8_t buffer[], const uint16_t length);
+            virtual int32_t Read(uint8_t buffer[], const uint32_t length) const;
+            virtual int32_t Write(const uint8_t buffer[], const uint32_t length);
+            virtual int32_t Write(const Segment segments[], const uint8_t count);
+            virtual int32_t Write(const Region& region);
+            int32_t Copy(const Region& region);
+            void Batch(const uint16_t slots)
+            {
+                ASSERT(IsClosed() == true);
+
+                m_Batch = slots;
+            }
+            void AdaptiveBuffers(const uint32_t maxSendBufferSize, const uint32_t maxReceiveBufferSize)
+            {
+                m_syncAdmin.Lock();
+                m_SendBufferLimit = maxSendBufferSize;
+                m_ReceiveBufferLimit = maxReceiveBufferSize;
+                m_syncAdmin.Unlock();
+            }
             void SetError() {
                 m_State |= SocketPort::EXCEPTION;
             }
@@ -266,6 +355,8 @@ namespace WPEFramework {
             }
 
         private:
+            class Ring;
+
             IResource::handle Descriptor() const override
             {
                 return (static_cast<IResource::handle>(m_Socket));
@@ -286,12 +377,23 @@ namespace WPEFramework {
             uint32_t WaitForOpen(const uint32_t time) const;
             uint32_t WaitForClosure(const uint32_t time) const;
             uint32_t WaitForWriteComplete(const uint32_t time) const;
+            void Fill();
+            void Sent(uint32_t size);
+            void Adapt(uint8_t*& buffer, uint32_t& size, const uint32_t required, const uint32_t keep);
+            void ReadBatch();
+            void WriteBatch();
 
         private:
             NodeId m_LocalNode;
             NodeId m_RemoteNode;
-            uint16_t m_ReceiveBufferSize;
-            uint16_t m_SendBufferSize;
+            uint32_t m_ReceiveBufferSize;
+            uint32_t m_SendBufferSize;
+            uint32_t m_ReceiveBufferConfigured;
+            uint32_t m_SendBufferConfigured;
+            uint32_t m_ReceiveBufferBase;
+            uint32_t m_SendBufferBase;
+            uint32_t m_ReceiveBufferLimit;
+            uint32_t m_SendBufferLimit;
             uint32_t m_SocketReceiveBufferSize;
             uint32_t m_SocketSendBufferSize;
             enumType m_SocketType;
@@ -301,9 +403,16 @@ namespace WPEFramework {
             NodeId m_ReceivedNode;
             uint8_t* m_SendBuffer;
             uint8_t* m_ReceiveBuffer;
-            uint16_t m_ReadBytes;
-            uint16_t m_SendBytes;
-            uint16_t m_SendOffset;
+            uint32_t m_ReadBytes;
+            uint32_t m_SendBytes;
+            uint32_t m_SendOffset;
+            Segment m_Segment[MaxSegments];
+            uint8_t m_Segments;
+            uint8_t m_SegmentIndex;
+            uint32_t m_SegmentOffset;
+            Region m_File;
+            uint16_t m_Batch;
+            Ring* m_Ring;
             uint32_t m_Interface;
             bool m_SystemdSocket;
         };
@@ -318,8 +427,8 @@ namespace WPEFramework {
             SocketStream(const bool rawSocket,
                 const NodeId& localNode,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize)
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize)
                 : SocketStream(rawSocket, localNode, remoteNode, sendBufferSize, receiveBufferSize, sendBufferSize, receiveBufferSize)
             {
             }
@@ -327,8 +436,8 @@ namespace WPEFramework {
             SocketStream(const bool rawSocket,
                 const NodeId& localNode,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize,
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize,
                 const uint32_t socketSendBufferSize,
                 const uint32_t socketReceiveBufferSize)
                 : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::STREAM), localNode, remoteNode, sendBufferSize, receiveBufferSize, socketSendBufferSize, socketReceiveBufferSize)
@@ -338,8 +447,8 @@ namespace WPEFramework {
             SocketStream(const bool rawSocket,
                 const SOCKET& connector,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize)
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize)
                 : SocketStream(rawSocket, connector, remoteNode, sendBufferSize, receiveBufferSize, sendBufferSize, receiveBufferSize)
             {
             }
@@ -347,8 +456,8 @@ namespace WPEFramework {
             SocketStream(const bool rawSocket,
                 const SOCKET& connector,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize,
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize,
                 const uint32_t socketSendBufferSize,
                 const uint32_t socketReceiveBufferSize)
                 : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::STREAM), connector, remoteNode, sendBufferSize, receiveBufferSize, socketSendBufferSize, socketReceiveBufferSize)
@@ -358,9 +467,17 @@ namespace WPEFramework {
             ~SocketStream() override = default;
 
         public:
+            // Let the send and receive buffers grow, doubling up to the given sizes, while a bulk transfer
+            // fills them up completely, so a large message takes less rounds (and less WebSocket frames).
+            // They go back to their original size once the link is idle again. 0 keeps a buffer as is.
+            inline void AdaptiveBuffers(const uint32_t maxSendBufferSize, const uint32_t maxReceiveBufferSize)
+            {
+                SocketPort::AdaptiveBuffers(maxSendBufferSize, maxReceiveBufferSize);
+            }
+
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
             // Signal a state change, Opened, Closed or Accepted
             virtual void StateChange() = 0;
@@ -376,8 +493,8 @@ namespace WPEFramework {
             SocketDatagram(const bool rawSocket,
                 const NodeId& localNode,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize)
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize)
                 : SocketDatagram(rawSocket, localNode, remoteNode, sendBufferSize, receiveBufferSize, sendBufferSize, receiveBufferSize)
             {
             }
@@ -385,8 +502,8 @@ namespace WPEFramework {
             SocketDatagram(const bool rawSocket,
                 const NodeId& localNode,
                 const NodeId& remoteNode,
-                const uint16_t sendBufferSize,
-                const uint16_t receiveBufferSize,
+                const uint32_t sendBufferSize,
+                const uint32_t receiveBufferSize,
                 const uint32_t socketSendBufferSize,
                 const uint32_t socketReceiveBufferSize)
                 : SocketPort((rawSocket ? SocketPort::RAW : SocketPort::DATAGRAM), localNode, remoteNode, sendBufferSize, receiveBufferSize, socketSendBufferSize, socketReceiveBufferSize)
@@ -398,9 +515,17 @@ namespace WPEFramework {
             }
 
         public:
+            // Receive and send up to the given number of datagrams per system call (recvmmsg/sendmmsg
+            // where available), see ReceiveBatch and SendBatch. Takes effect on the next Open, 0 or 1
+            // turns it off.
+            inline void Batch(const uint16_t slots)
+            {
+                SocketPort::Batch(slots);
+            }
+
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
             // Signal a state change, Opened, Closed or Accepted
             virtual void StateChange() = 0;
@@ -434,14 +559,14 @@ namespace WPEFramework {
                 {
                     SocketPort::LocalNode(localNode);
                 }
-                virtual uint16_t SendData(uint8_t* /* dataFrame */, const uint16_t /* maxSendSize */)
+                virtual uint32_t SendData(uint8_t* /* dataFrame */, const uint32_t /* maxSendSize */)
                 {
                     // This should not happen on this socket !!!!!
                     ASSERT(false);
 
                     return (0);
                 }
-                virtual uint16_t ReceiveData(uint8_t* /* dataFrame */, const uint16_t /* receivedSize */)
+                virtual uint32_t ReceiveData(uint8_t* /* dataFrame */, const uint32_t /* receivedSize */)
                 {
                     // This should not happen on this socket !!!!!
                     ASSERT(false);
@@ -0,0 +1,241 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "Portability.h"
+
+namespace WPEFramework {
+namespace Core {
+
+    // -------------------------------------------------------------------
+    // A bounded, lock-free ring that can be filled and drained by multiple
+    // threads at the same time. It is used by the ThreadPool as the local
+    // queue of a worker: the owner pushes the work it generates, the owner
+    // and idle workers (thieves) pop from the head. No memory is allocated
+    // after construction.
+    // Next to Push/Pop, an entry can be Revoked (or Visited) in place. To
+    // make that possible, each slot carries a small state that guards the
+    // content of the slot. A slot that is revoked is simply skipped by the
+    // next Pop that lands on it.
+    // -------------------------------------------------------------------
+    template <typename CONTEXT, const uint16_t CAPACITY = 64>
+    class StealingQueueType {
+    private:
+        static_assert((CAPACITY != 0) && ((CAPACITY & (CAPACITY - 1)) == 0), "CAPACITY of a StealingQueueType should be a power of 2");
+
+        enum state : uint8_t {
+            EMPTY,
+            LOADED,
+            LOCKED
+        };
+
+        struct Slot {
+            std::atomic<uint32_t> Sequence;
+            std::atomic<state> State;
+            CONTEXT Element;
+        };
+
+    public:
+        StealingQueueType(const StealingQueueType<CONTEXT, CAPACITY>&) = delete;
+        StealingQueueType<CONTEXT, CAPACITY>& operator=(const StealingQueueType<CONTEXT, CAPACITY>&) = delete;
+
+        StealingQueueType()
+            : _head(0)
+            , _tail(0)
+            , _revoked(0)
+        {
+            for (uint32_t index = 0; index < CAPACITY; index++) {
+                _slots[index].Sequence.store(index, Core::memory_order::memory_order_relaxed);
+                _slots[index].State.store(EMPTY, Core::memory_order::memory_order_relaxed);
+            }
+        }
+        ~StealingQueueType()
+        {
+            Clear();
+        }
+
+    public:
+        static constexpr uint16_t Capacity()
+        {
+            return (CAPACITY);
+        }
+        bool Push(const CONTEXT& element)
+        {
+            bool result = false;
+            Slot* slot = nullptr;
+            uint32_t position = _tail.load(Core::memory_order::memory_order_relaxed);
+
+            while (slot == nullptr) {
+                Slot& entry(_slots[position & (CAPACITY - 1)]);
+                int32_t delta = static_cast<int32_t>(entry.Sequence.load(Core::memory_order::memory_order_acquire) - position);
+
+                if (delta < 0) {
+                    // The ring is full, the caller should find another place for this entry.
+                    break;
+                } else if (delta > 0) {
+                    position = _tail.load(Core::memory_order::memory_order_relaxed);
+                } else if (_tail.compare_exchange_weak(position, position + 1, Core::memory_order::memory_order_relaxed) == true) {
+                    slot = &entry;
+                }
+            }
+
+            if (slot != nullptr) {
+                slot->Element = element;
+                slot->State.store(LOADED, Core::memory_order::memory_order_release);
+                slot->Sequence.store(position + 1, Core::memory_order::memory_order_release);
+                result = true;
+            }
+
+            return (result);
+        }
+        bool Pop(CONTEXT& element)
+        {
+            bool result = false;
+            uint32_t position = _head.load(Core::memory_order::memory_order_relaxed);
+
+            while (result == false) {
+                Slot& entry(_slots[position & (CAPACITY - 1)]);
+                int32_t delta = static_cast<int32_t>(entry.Sequence.load(Core::memory_order::memory_order_acquire) - (position + 1));
+
+                if (delta < 0) {
+                    // Nothing (left) to pop..
+                    break;
+                } else if (delta > 0) {
+                    position = _head.load(Core::memory_order::memory_order_relaxed);
+                } else if (_head.compare_exchange_weak(position, position + 1, Core::memory_order::memory_order_relaxed) == true) {
+                    // This slot is ours now. If it was revoked in the mean time, just move on to the next one.
+                    if (Lock(entry) == true) {
+                        element = entry.Element;
+                        entry.Element = CONTEXT();
+                        result = true;
+                    } else {
+                        _revoked.fetch_sub(1, Core::memory_order::memory_order_relaxed);
+                    }
+                    entry.State.store(EMPTY, Core::memory_order::memory_order_release);
+                    entry.Sequence.store(position + CAPACITY, Core::memory_order::memory_order_release);
+                    position++;
+                }
+            }
+
+            return (result);
+        }
+        bool Revoke(const CONTEXT& element)
+        {
+            bool found = false;
+            uint32_t position = _head.load(Core::memory_order::memory_order_acquire);
+            uint32_t count = Window(position);
+
+            while ((found == false) && (count-- != 0)) {
+                Slot& entry(_slots[position & (CAPACITY - 1)]);
+                state expected = LOADED;
+
+                if (entry.State.compare_exchange_strong(expected, LOCKED, Core::memory_order::memory_order_acquire) == true) {
+                    if (entry.Element == element) {
+                        entry.Element = CONTEXT();
+                        // Counted before the slot is given up, so the Pop that skips it never sees it uncounted.
+                        _revoked.fetch_add(1, Core::memory_order::memory_order_relaxed);
+                        entry.State.store(EMPTY, Core::memory_order::memory_order_release);
+                        found = true;
+                    } else {
+                        entry.State.store(LOADED, Core::memory_order::memory_order_release);
+                    }
+                }
+                position++;
+            }
+
+            return (found);
+        }
+        // void action(const CONTEXT& element)
+        template <typename ACTION>
+        void Visit(ACTION&& action) const
+        {
+            uint32_t position = _head.load(Core::memory_order::memory_order_acquire);
+            uint32_t count = Window(position);
+
+            while (count-- != 0) {
+                Slot& entry(_slots[position & (CAPACITY - 1)]);
+                state expected = LOADED;
+
+                if (entry.State.compare_exchange_strong(expected, LOCKED, Core::memory_order::memory_order_acquire) == true) {
+                    action(static_cast<const CONTEXT&>(entry.Element));
+                    entry.State.store(LOADED, Core::memory_order::memory_order_release);
+                }
+                position++;
+            }
+        }
+        bool HasEntry(const CONTEXT& element) const
+        {
+            bool found = false;
+            Visit([&](const CONTEXT& entry) { found = found || (entry == element); });
+            return (found);
+        }
+        // Note: this is a snapshot, revoked entries that are not yet skipped are left out.
+        uint32_t Length() const
+        {
+            const uint32_t length = Window(_head.load(Core::memory_order::memory_order_relaxed));
+            const uint32_t revoked = _revoked.load(Core::memory_order::memory_order_relaxed);
+
+            return (length > revoked ? length - revoked : 0);
+        }
+        bool IsEmpty() const
+        {
+            return (Length() == 0);
+        }
+        void Clear()
+        {
+            CONTEXT element;
+            while (Pop(element) == true) {
+                element = CONTEXT();
+            }
+        }
+
+    private:
+        uint32_t Window(const uint32_t head) const
+        {
+            uint32_t length = _tail.load(Core::memory_order::memory_order_acquire) - head;
+            return (static_cast<int32_t>(length) < 0 ? 0 : std::min(length, static_cast<uint32_t>(CAPACITY)));
+        }
+        bool Lock(Slot& entry) const
+        {
+            state expected = LOADED;
+
+            // Someone might be inspecting this slot (Revoke/Visit), that is a short
+            // operation, wait for it to complete.
+            while (entry.State.compare_exchange_weak(expected, LOCKED, Core::memory_order::memory_order_acquire) == false) {
+                if (expected == EMPTY) {
+                    break;
+                }
+                expected = LOADED;
+                std::this_thread::yield();
+            }
+
+            return (expected != EMPTY);
+        }
+
+    private:
+        std::atomic<uint32_t> _head;
+        std::atomic<uint32_t> _tail;
+        std::atomic<uint32_t> _revoked;
+        mutable Slot _slots[CAPACITY];
+    };
+
+}
+} // namespace Core
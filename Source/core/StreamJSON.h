@@ -188,12 +188,12 @@ namespace Core {
 
         public:
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
 
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -280,16 +280,29 @@ POP_WARNING()
         {
             return ((_serializer.IsIdle() == true) && (_deserializer.IsIdle() == true));
         }
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            return (_serializer.Serialize(dataFrame, maxSendSize));
+            uint32_t result = 0;
+            uint16_t loaded;
+            uint16_t chunk;
+
+            // The serializer works in chunks of at most 64KB, keep going until the frame is full or the
+            // message is complete.
+            do {
+                chunk = static_cast<uint16_t>(std::min(maxSendSize - result, static_cast<uint32_t>(0xFFFF)));
+                loaded = _serializer.Serialize(&(dataFrame[result]), chunk);
+                result += loaded;
+
+            } while ((loaded == chunk) && (result < maxSendSize));
+
+            return (result);
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            uint16_t handled = 0;
+            uint32_t handled = 0;
 
             do {
-                handled += _deserializer.Deserialize(&dataFrame[handled], (receivedSize - handled));
+                handled += _deserializer.Deserialize(&dataFrame[handled], static_cast<uint16_t>(std::min(receivedSize - handled, static_cast<uint32_t>(0xFFFF))));
 
                 // The dataframe can hold more items....
             } while (handled < receivedSize);
@@ -231,12 +231,12 @@ namespace Core {
 
         public:
             // Methods to extract and insert data into the socket buffers
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
 
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -439,9 +439,9 @@ POP_WARNING()
         {
             return (_sendQueue.size() == 0);
         }
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _adminLock.Lock();
 
@@ -468,7 +468,8 @@ POP_WARNING()
                 if ((maxSendSize != result) && (_offset >= (sendObject.size() * sizeof(TCHAR))) && (_offset < ((sendObject.size() + (_terminator.SizeOf())) * sizeof(TCHAR)))) {
                     uint8_t markerSize = (static_cast<uint8_t>(_terminator.SizeOf()) * sizeof(TCHAR));
                     uint8_t markerOffset = ((sendObject.size() * sizeof(TCHAR)) - _offset);
-                    uint16_t size = ((markerSize - markerOffset) > (maxSendSize - result) ? (maxSendSize - result) : (markerSize - markerOffset));
+                    const uint32_t marker = static_cast<uint32_t>(markerSize - markerOffset);
+                    uint32_t size = (marker > (maxSendSize - result) ? (maxSendSize - result) : marker);
 
                     _offset += SendCharacters(&(dataFrame[result]), &(_terminator.Marker()[(markerOffset / sizeof(TCHAR))]), (markerOffset % sizeof(TCHAR)), size);
                     result += size;
@@ -495,9 +496,9 @@ POP_WARNING()
         {
             entry = (dataFrame[0]);
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            for (uint16_t index = 0; index < receivedSize; index += sizeof(TCHAR)) {
+            for (uint32_t index = 0; index < receivedSize; index += sizeof(TCHAR)) {
                 TCHAR character;
                 Convert(&dataFrame[index], character);
 
@@ -529,7 +530,7 @@ POP_WARNING()
             }
             return (receivedSize);
         }
-        inline uint16_t SendCharacters(uint8_t* dataFrame, const TCHAR stream[], const uint8_t delta, const uint16_t total)
+        inline uint32_t SendCharacters(uint8_t* dataFrame, const TCHAR stream[], const uint8_t delta, const uint32_t total)
         {
             // TODO: Align in case we are not a multibyte character string..
             // For now we assume that this never happens, only multibyte support for now.
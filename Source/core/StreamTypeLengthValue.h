@@ -300,11 +300,11 @@ namespace Core {
             {
                 _parent.StateChange();
             }
-            virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
-            virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+            virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -487,9 +487,9 @@ POP_WARNING()
         }
 
         // Methods to extract and insert data into the socket buffers
-        uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            uint16_t result = 0;
+            uint32_t result = 0;
 
             _responses.Lock();
 
@@ -507,7 +507,7 @@ POP_WARNING()
 
             return (result);
         }
-        uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData)
+        uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableData)
         {
             _responses.Lock();
 
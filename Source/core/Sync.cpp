@@ -48,6 +48,11 @@
 #include <unistd.h>
 #endif
 
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 // GLOBAL INTERLOCKED METHODS
@@ -136,6 +141,226 @@ namespace Core {
 //----------------------------------------------------------------------------
 // CONSTRUCTOR & DESTRUCTOR
 //----------------------------------------------------------------------------
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+    namespace {
+
+        // Like the adaptive pthread mutex: spin at most this many times before sleeping on the futex.
+        constexpr uint16_t MaxSpins = 100;
+
+        inline void Relax()
+        {
+#if defined(__i386__) || defined(__x86_64__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__ARM_ARCH) && (__ARM_ARCH >= 7))
+            asm volatile("yield" ::: "memory");
+#else
+            asm volatile("" ::: "memory");
+#endif
+        }
+
+        inline void Futex(std::atomic<uint32_t>& word, const int operation, const uint32_t value)
+        {
+            ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), operation, value, nullptr, nullptr, 0);
+        }
+
+        inline void Maximum(std::atomic<uint64_t>& maximum, const uint64_t value)
+        {
+            if (value > maximum.load(std::memory_order_relaxed)) {
+                maximum.store(value, std::memory_order_relaxed);
+            }
+        }
+
+        inline void Add(std::atomic<uint64_t>& total, const uint64_t value)
+        {
+            total.store(total.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+    }
+
+    // All named CriticalSections, never destructed as these can be statics too.
+    class CriticalSection::Registry {
+    public:
+        Registry(const Registry&) = delete;
+        Registry& operator=(const Registry&) = delete;
+
+        Registry() = default;
+        ~Registry() = default;
+
+        static Registry& Instance()
+        {
+            static Registry& singleton = *(new Registry());
+
+            return (singleton);
+        }
+
+    public:
+        void Add(Profile* profile)
+        {
+            _adminLock.Lock();
+            _profiles.push_back(profile);
+            _adminLock.Unlock();
+        }
+        void Remove(Profile* profile)
+        {
+            _adminLock.Lock();
+            _profiles.remove(profile);
+            _adminLock.Unlock();
+        }
+        void Snapshot(std::list<Metadata>& locks) const
+        {
+            std::map<string, Metadata> names;
+
+            _adminLock.Lock();
+
+            for (const Profile* profile : _profiles) {
+                std::map<string, Metadata>::iterator index(names.find(profile->Name));
+
+                if (index == names.end()) {
+                    Metadata metadata{};
+                    metadata.Name = profile->Name;
+                    index = names.emplace(metadata.Name, metadata).first;
+                }
+
+                Metadata& entry(index->second);
+                entry.Instances++;
+                entry.Locks += profile->Locks.load(std::memory_order_relaxed);
+                entry.Contended += profile->Contended.load(std::memory_order_relaxed);
+                entry.WaitTime += profile->WaitTime.load(std::memory_order_relaxed);
+                entry.MaxWaitTime = std::max(entry.MaxWaitTime, profile->MaxWaitTime.load(std::memory_order_relaxed));
+                entry.HoldSamples += profile->HoldSamples.load(std::memory_order_relaxed);
+                entry.HoldTime += profile->HoldTime.load(std::memory_order_relaxed);
+                entry.MaxHoldTime = std::max(entry.MaxHoldTime, profile->MaxHoldTime.load(std::memory_order_relaxed));
+            }
+
+            _adminLock.Unlock();
+
+            for (std::pair<const string, Metadata>& entry : names) {
+                entry.second.WaitTime /= Time::NanoSecondsPerMicroSecond;
+                entry.second.MaxWaitTime /= Time::NanoSecondsPerMicroSecond;
+                entry.second.HoldTime /= Time::NanoSecondsPerMicroSecond;
+                entry.second.MaxHoldTime /= Time::NanoSecondsPerMicroSecond;
+                locks.push_back(entry.second);
+            }
+        }
+
+    private:
+        mutable CriticalSection _adminLock;
+        std::list<Profile*> _profiles;
+    };
+
+    CriticalSection::CriticalSection()
+        : _state(0)
+        , _spins(0)
+        , _depth(0)
+        , _owner(pthread_t())
+        , _profile(nullptr)
+    {
+        TRACE_L5("Constructor CriticalSection <%p>", (this));
+    }
+
+    CriticalSection::CriticalSection(const TCHAR name[])
+        : _state(0)
+        , _spins(0)
+        , _depth(0)
+        , _owner(pthread_t())
+        , _profile(new Profile(name))
+    {
+        TRACE_L5("Constructor CriticalSection <%p> named %s", (this), name);
+
+        Registry::Instance().Add(_profile);
+    }
+
+    CriticalSection::~CriticalSection()
+    {
+        TRACE_L5("Destructor CriticalSection <%p>", (this));
+
+        if (_state.load(std::memory_order_relaxed) != 0) {
+            TRACE_L1("Probably trying to delete a used CriticalSection <%d>.", _state.load(std::memory_order_relaxed));
+        }
+
+        if (_profile != nullptr) {
+            Registry::Instance().Remove(_profile);
+            delete _profile;
+        }
+    }
+
+    /* static */ void CriticalSection::Snapshot(std::list<Metadata>& locks)
+    {
+        Registry::Instance().Snapshot(locks);
+    }
+
+    // The lock is taken by another thread, spin for a while if that paid off before, otherwise sleep until it is released.
+    void CriticalSection::Wait()
+    {
+        static const bool multiCore = (std::thread::hardware_concurrency() > 1);
+
+        const uint64_t start = (_profile != nullptr ? Now() : 0);
+        bool acquired = false;
+
+        if (multiCore == true) {
+            const uint16_t spins = _spins.load(std::memory_order_relaxed);
+            const uint16_t limit = std::min(MaxSpins, static_cast<uint16_t>((spins * 2) + 10));
+            uint16_t spin = 0;
+
+            while ((acquired == false) && (spin < limit)) {
+                uint32_t expected = 0;
+
+                if ((_state.load(std::memory_order_relaxed) == 0) && (_state.compare_exchange_weak(expected, 1, std::memory_order_acquire, std::memory_order_relaxed) == true)) {
+                    acquired = true;
+                }
+                else {
+                    Relax();
+                    spin++;
+                }
+            }
+
+            _spins.store(static_cast<uint16_t>(spins + ((static_cast<int32_t>(spin) - spins) / 8)), std::memory_order_relaxed);
+        }
+
+        if (acquired == false) {
+            REPORT_DURATION_WARNING({
+                while (_state.exchange(2, std::memory_order_acquire) != 0) {
+                    Futex(_state, FUTEX_WAIT_PRIVATE, 2);
+                }
+            }, WarningReporting::TooLongWaitingForLock);
+        }
+
+        if (_profile != nullptr) {
+            const uint64_t waited = Now() - start;
+
+            Add(_profile->Contended, 1);
+            Add(_profile->WaitTime, waited);
+            Maximum(_profile->MaxWaitTime, waited);
+        }
+    }
+
+    void CriticalSection::Wake()
+    {
+        Futex(_state, FUTEX_WAKE_PRIVATE, 1);
+    }
+
+    void CriticalSection::Held()
+    {
+        const uint64_t held = Now() - _profile->Since;
+
+        _profile->Since = 0;
+
+        Add(_profile->HoldSamples, 1);
+        Add(_profile->HoldTime, held);
+        Maximum(_profile->MaxHoldTime, held);
+    }
+
+    /* static */ uint64_t CriticalSection::Now()
+    {
+        struct timespec now;
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return ((static_cast<uint64_t>(now.tv_sec) * 1000000000) + now.tv_nsec);
+    }
+
+#else
+
 #ifdef __WINDOWS__
     CriticalSection::CriticalSection()
     {
@@ -263,6 +488,18 @@ namespace Core {
 #endif
     }
 
+    CriticalSection::CriticalSection(const TCHAR name[] VARIABLE_IS_NOT_USED)
+        : CriticalSection()
+    {
+    }
+
+    // Only the futex based CriticalSection keeps statistics.
+    /* static */ void CriticalSection::Snapshot(std::list<Metadata>& locks VARIABLE_IS_NOT_USED)
+    {
+    }
+
+#endif // __CORE_CRITICAL_SECTION_FUTEX__
+
     //----------------------------------------------------------------------------
     //----------------------------------------------------------------------------
     // BinairySemaphore class
@@ -1024,6 +1261,8 @@ namespace Core {
 #endif
     }
 
+    /* static */ constexpr uint16_t CriticalSection::HoldSampling;
+
 #ifndef __WINDOWS__
 #if defined(__CORE_CRITICAL_SECTION_LOG__)
     CriticalSection CriticalSection::_StdErrDumpMutex;
@@ -38,18 +38,98 @@ namespace Core {
     // class CriticalSection
     // ===========================================================================
 
+#if defined(__LINUX__) && !defined(__APPLE__) && !defined(__CORE_CRITICAL_SECTION_LOG__)
+#define __CORE_CRITICAL_SECTION_FUTEX__
+#endif
+
+    // On Linux, a CriticalSection is a futex with a short adaptive spin in
+    // front of it, the recursion counter is only touched if the owner locks
+    // it again. A CriticalSection can be given a name, the locks with a name
+    // keep track of how often they are contended, how long it takes to get
+    // them and (sampled) how long they are held. Snapshot reports these per
+    // name, so the ones that are hot can be found in any build.
     class EXTERNAL CriticalSection {
+    public:
+        struct Metadata {
+            string Name;
+            uint32_t Instances;
+            uint64_t Locks;
+            uint64_t Contended;
+            // All times in microseconds.
+            uint64_t WaitTime;
+            uint64_t MaxWaitTime;
+            // Taken from one out of every HoldSampling locks.
+            uint64_t HoldSamples;
+            uint64_t HoldTime;
+            uint64_t MaxHoldTime;
+        };
+
+        static constexpr uint16_t HoldSampling = 64;
+
     private:
         CriticalSection(const CriticalSection&) = delete;
         CriticalSection& operator=(const CriticalSection&) = delete;
 
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+        // Only changed by the thread that holds the lock.
+        struct Profile {
+            Profile(const TCHAR name[])
+                : Name(name)
+                , Locks(0)
+                , Contended(0)
+                , WaitTime(0)
+                , MaxWaitTime(0)
+                , HoldSamples(0)
+                , HoldTime(0)
+                , MaxHoldTime(0)
+                , Since(0)
+            {
+            }
+
+            const TCHAR* Name;
+            std::atomic<uint64_t> Locks;
+            std::atomic<uint64_t> Contended;
+            std::atomic<uint64_t> WaitTime;
+            std::atomic<uint64_t> MaxWaitTime;
+            std::atomic<uint64_t> HoldSamples;
+            std::atomic<uint64_t> HoldTime;
+            std::atomic<uint64_t> MaxHoldTime;
+            uint64_t Since;
+        };
+#endif
+
     public: // Methods
         CriticalSection();
+        explicit CriticalSection(const TCHAR name[]);
         ~CriticalSection();
 
+        // The statistics of all named CriticalSections, added up per name.
+        static void Snapshot(std::list<Metadata>& locks);
+
         inline void Lock()
         {
-#ifdef __LINUX__
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+            const pthread_t self = pthread_self();
+            uint32_t expected = 0;
+
+            if (_state.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed) == false) {
+                if (_owner.load(std::memory_order_relaxed) == self) {
+                    _depth++;
+                    return;
+                }
+                Wait();
+            }
+
+            _owner.store(self, std::memory_order_relaxed);
+
+            if (_profile != nullptr) {
+                const uint64_t locks = _profile->Locks.load(std::memory_order_relaxed) + 1;
+                _profile->Locks.store(locks, std::memory_order_relaxed);
+                if ((locks % HoldSampling) == 0) {
+                    _profile->Since = Now();
+                }
+            }
+#elif defined(__LINUX__)
 #if defined(__CORE_CRITICAL_SECTION_LOG__)
             TryLock();
 #else
@@ -71,7 +151,26 @@ namespace Core {
 
         inline void Unlock()
         {
-#ifdef __POSIX__
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+            if (_owner.load(std::memory_order_relaxed) != pthread_self()) {
+                TRACE_L1("Probably does the calling thread not own this CriticalSection. <%d>", _state.load(std::memory_order_relaxed));
+            }
+            else if (_depth != 0) {
+                _depth--;
+            }
+            else {
+                if ((_profile != nullptr) && (_profile->Since != 0)) {
+                    Held();
+                }
+
+                _owner.store(pthread_t(), std::memory_order_relaxed);
+
+                if (_state.fetch_sub(1, std::memory_order_release) != 1) {
+                    _state.store(0, std::memory_order_release);
+                    Wake();
+                }
+            }
+#elif defined(__POSIX__)
             int result = pthread_mutex_unlock(&m_syncMutex);
             if (result != 0) {
                 TRACE_L1("Probably does the calling thread not own this CriticalSection or unlock on already destroyed mutex. <%d>", result);
@@ -84,7 +183,14 @@ namespace Core {
         }
 
     protected: // Members
-#ifdef __POSIX__
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+        // 0: free, 1: locked, 2: locked and there might be threads waiting for it.
+        std::atomic<uint32_t> _state;
+        std::atomic<uint16_t> _spins;
+        uint16_t _depth;
+        std::atomic<pthread_t> _owner;
+        Profile* _profile;
+#elif defined(__POSIX__)
         pthread_mutex_t m_syncMutex;
 #endif
 #ifdef __WINDOWS__
@@ -92,6 +198,14 @@ namespace Core {
 #endif
 
     private:
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+        class Registry;
+
+        void Wait();
+        void Wake();
+        void Held();
+        static uint64_t Now();
+#endif
 #ifdef __LINUX__
 #if defined(__CORE_CRITICAL_SECTION_LOG__)
         void TryLock();
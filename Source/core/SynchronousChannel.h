@@ -108,7 +108,7 @@ namespace Core {
             {
                 return (_response);
             }
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize)
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize)
             {
                 uint16_t result = _message.Serialize(dataFrame, maxSendSize);
 
@@ -117,7 +117,7 @@ namespace Core {
                 }
                 return (result);
             }
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData)
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableData)
             {
                 uint16_t result = 0;
 
@@ -336,7 +336,7 @@ namespace Core {
         }
 
         // Methods to extract and insert data into the socket buffers
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
         {
             uint16_t result = 0;
 
@@ -366,7 +366,7 @@ namespace Core {
 
             return (result);
         }
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t availableData) override
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableData) override
         {
             uint16_t result = 0;
 
@@ -22,6 +22,7 @@
 #include "Thread.h"
 #include "ResourceMonitor.h"
 #include "Number.h"
+#include "StealingQueue.h"
 
 namespace WPEFramework {
 
@@ -29,6 +30,16 @@ namespace Core {
 
     class EXTERNAL ThreadPool {
     public:
+        // QUEUED:   All workers take their work from one, shared, queue.
+        // STEALING: Work submitted by a worker lands on its own (lock-free) local queue,
+        //           work submitted from outside the pool on the shared (injection) queue.
+        //           Workers without work take it from the injection queue or steal it
+        //           from the local queue of another worker.
+        enum scheduling : uint8_t {
+            QUEUED,
+            STEALING
+        };
+
         struct EXTERNAL ICallback {
             virtual ~ICallback() = default;
             virtual void Idle() = 0;
@@ -167,6 +178,7 @@ namespace Core {
         #endif
 
         using MessageQueue = QueueType< QueueElement >;
+        using LocalQueue = StealingQueueType< QueueElement, 64 >;
 
     public:   
         template<typename IMPLEMENTATION>
@@ -380,6 +392,10 @@ POP_WARNING()
                 , _interestCount(0)
                 , _currentRequest()
                 , _runs(0)
+                , _local()
+                , _wakeup(false, true)
+                , _parked(false)
+                , _threadId(0)
             {
                 ASSERT(dispatcher != nullptr);
             }
@@ -422,9 +438,11 @@ POP_WARNING()
             }
             void Process()
             {
+                _threadId = Thread::ThreadId();
+
                 _dispatcher->Initialize();
 
-                while (_parent._queue.Extract(_currentRequest, infinite) == true) {
+                while (_parent.Next(*this, _currentRequest) == true) {
 
                     ASSERT(_currentRequest.IsValid() == true);
 
@@ -444,7 +462,7 @@ POP_WARNING()
 
                     if (job != nullptr) {
                         // Maybe we need to reschedule this request....
-                        _parent.Closure(*job);
+                        _parent.Closure(*this, *job);
                     }
                     #else
                     IDispatch* request = &(*_currentRequest);
@@ -455,7 +473,7 @@ POP_WARNING()
 
                     if (job != nullptr) {
                         // Maybe we need to reschedule this request....
-                        _parent.Closure(*job);
+                        _parent.Closure(*this, *job);
                     }
 
                     #endif
@@ -482,6 +500,22 @@ POP_WARNING()
                 }
 
                 _dispatcher->Deinitialize();
+
+                _threadId = 0;
+            }
+
+        private:
+            friend class ThreadPool;
+
+            bool Wake()
+            {
+                bool parked = true;
+
+                if (_parked.compare_exchange_strong(parked, false) == true) {
+                    _wakeup.SetEvent();
+                }
+
+                return (parked);
             }
 
         private:
@@ -496,6 +530,10 @@ POP_WARNING()
             ProxyType<IDispatch> _currentRequest;
             #endif
             uint32_t _runs;
+            LocalQueue _local;
+            Event _wakeup;
+            std::atomic<bool> _parked;
+            std::atomic<::ThreadId> _threadId;
         };
 
     private:
@@ -550,8 +588,10 @@ POP_WARNING()
         ThreadPool(const ThreadPool& a_Copy) = delete;
         ThreadPool& operator=(const ThreadPool& a_RHS) = delete;
 
-        ThreadPool(const uint8_t count, const uint32_t stackSize, const uint32_t queueSize, IDispatcher* dispatcher, IScheduler* scheduler, Minion* external, ICallback* callback) 
+        ThreadPool(const uint8_t count, const uint32_t stackSize, const uint32_t queueSize, IDispatcher* dispatcher, IScheduler* scheduler, Minion* external, ICallback* callback, const scheduling mode = QUEUED)
             : _queue(queueSize)
+            , _scheduling(mode)
+            , _running(false)
             , _scheduler(scheduler)
             #ifdef __CORE_WARNING_REPORTING__
             , _dispatchedJobMonitor(nullptr)
@@ -574,8 +614,18 @@ POP_WARNING()
         {
             return (static_cast<uint8_t>(_units.size()));
         }
+        scheduling Scheduling() const
+        {
+            return (_scheduling);
+        }
         uint32_t Pending() const {
-            return (_queue.Length());
+            uint32_t result = _queue.Length();
+
+            if (_scheduling == STEALING) {
+                VisitMinions([&](const Minion& minion) { result += minion._local.Length(); });
+            }
+
+            return (result);
         }
         void Snapshot(const uint8_t length, Metadata* entries, std::vector<string>& jobs) const
         {
@@ -594,6 +644,14 @@ POP_WARNING()
                 jobs.emplace_back(element->Identifier());
                 });
 
+            if (_scheduling == STEALING) {
+                VisitMinions([&](const Minion& minion) {
+                    minion._local.Visit([&](const QueueElement& element) {
+                        jobs.emplace_back(element->Identifier());
+                    });
+                });
+            }
+
             _queue.Unlock();
         }
         ::ThreadId Id(const uint8_t index) const
@@ -611,13 +669,30 @@ POP_WARNING()
             ASSERT(job.IsValid() == true);
             ASSERT(_queue.HasEntry(job) == false);
 
-            if (Thread::ThreadId() == ResourceMonitor::Instance().Id()) {
-                _queue.Post(job);
+            if (_scheduling == QUEUED) {
+                if (ResourceMonitor::Instance().IsReactor(Thread::ThreadId()) == true) {
+                    _queue.Post(job);
+                }
+                else {
+                    _queue.Insert(job, waitTime);
+                }
             }
             else {
-                _queue.Insert(job, waitTime);
-            }
+                Minion* local = Local();
 
+                // Work created by one of our own minions, stays with that minion (if it has room for it),
+                // the rest is injected into the shared queue.
+                if ((local == nullptr) || (local->_local.Push(job) == false)) {
+                    if ((local != nullptr) || (ResourceMonitor::Instance().IsReactor(Thread::ThreadId()) == true)) {
+                        _queue.Post(job);
+                    }
+                    else {
+                        _queue.Insert(job, waitTime);
+                    }
+                }
+
+                Wake();
+            }
         }
         uint32_t Revoke(const ProxyType<IDispatch>& job, const uint32_t waitTime)
         {
@@ -625,7 +700,7 @@ POP_WARNING()
 
             ASSERT(job.IsValid() == true);
 
-            if (_queue.Remove(job) == true) {
+            if ((_queue.Remove(job) == true) || ((_scheduling == STEALING) && (Unqueue(job) == true))) {
                 result = ERROR_NONE;
             }
             else {
@@ -652,6 +727,7 @@ POP_WARNING()
         }
         void Run()
         {
+            _running = true;
             _queue.Enable();
             std::list<Executor>::iterator index = _units.begin();
             while (index != _units.end()) {
@@ -661,7 +737,15 @@ POP_WARNING()
         }
         void Stop()
         {
+            _running = false;
             _queue.Disable();
+
+            if (_scheduling == STEALING) {
+                // Get all parked minions out of their slumber, they need to see we are stopping.
+                std::atomic_thread_fence(Core::memory_order::memory_order_seq_cst);
+                VisitMinions([](Minion& minion) { minion._wakeup.SetEvent(); });
+            }
+
             std::list<Executor>::iterator index = _units.begin();
             while (index != _units.end()) {
                 index->Stop();
@@ -694,7 +778,7 @@ POP_WARNING()
         void Idle() {
             if (_callback != nullptr) {
                 _queue.Lock();
-                if ((_queue.IsEmpty() == false) || ((_external != nullptr) && (_external->IsActive() == true))) {
+                if ((_queue.IsEmpty() == false) || ((_external != nullptr) && (_external->IsActive() == true)) || (LocalPending() == true)) {
                     _queue.Unlock();
                 }
                 else {
@@ -710,13 +794,17 @@ POP_WARNING()
                 }
             }
         }
-        void Closure(IJob& job) {
+        void Closure(Minion& minion, IJob& job) {
             Time scheduleTime;
+            bool posted = false;
             _queue.Lock();
             ProxyType<IDispatch> resubmit = job.Resubmit(scheduleTime);
             if (resubmit.IsValid() == true) {
                 if ((scheduleTime.IsValid() == false) || (_scheduler == nullptr) || (scheduleTime < Time::Now()) ) {
-                    _queue.Post(resubmit);
+                    if ((_scheduling == QUEUED) || (minion._local.Push(resubmit) == false)) {
+                        _queue.Post(resubmit);
+                    }
+                    posted = true;
                 }
                 else {
                     // See if we have a hook that can process scheduled entries :-)
@@ -724,10 +812,132 @@ POP_WARNING()
                 }
             }
             _queue.Unlock();
+
+            if ((posted == true) && (_scheduling == STEALING)) {
+                Wake();
+            }
+        }
+        bool Next(Minion& minion, QueueElement& job) {
+            return (_scheduling == QUEUED ? _queue.Extract(job, infinite) : Steal(minion, job));
+        }
+
+        // -----------------------------------------------------
+        // Work stealing support
+        // -----------------------------------------------------
+        template <typename ACTION>
+        void VisitMinions(ACTION&& action) const {
+            for (const Executor& unit : _units) {
+                action(const_cast<Executor&>(unit).Me());
+            }
+            if (_external != nullptr) {
+                action(*_external);
+            }
+        }
+        Minion* Local() {
+            Minion* result = nullptr;
+            ::ThreadId id = Thread::ThreadId();
+
+            VisitMinions([&](Minion& minion) {
+                if ((result == nullptr) && (minion._threadId == id)) {
+                    result = &minion;
+                }
+            });
+
+            return (result);
+        }
+        bool LocalPending() const {
+            bool result = false;
+            if (_scheduling == STEALING) {
+                VisitMinions([&](const Minion& minion) { result = result || (minion._local.IsEmpty() == false); });
+            }
+            return (result);
+        }
+        bool Unqueue(const ProxyType<IDispatch>& job) {
+            bool result = false;
+            VisitMinions([&](Minion& minion) { result = result || minion._local.Revoke(job); });
+            return (result);
+        }
+        void Wake() {
+            bool woken = false;
+
+            // Make sure the work that was just queued is visible to a minion that is about to park.
+            std::atomic_thread_fence(Core::memory_order::memory_order_seq_cst);
+
+            VisitMinions([&](Minion& minion) { woken = woken || minion.Wake(); });
+        }
+        bool Inject(Minion& minion, QueueElement& job) {
+            bool result = false;
+
+            _queue.Lock();
+
+            if (_queue.IsEmpty() == false) {
+                // Take our fair share of the injected work along to our local queue. This keeps the
+                // other minions from hitting the shared queue, they can steal it from us, lock-free.
+                uint32_t batch = std::min(static_cast<uint32_t>(_queue.Length() / (_units.size() + 1)), static_cast<uint32_t>(LocalQueue::Capacity() / 2));
+
+                result = _queue.Extract(job, 0);
+
+                QueueElement entry;
+                while ((batch-- != 0) && (_queue.Extract(entry, 0) == true)) {
+                    if (minion._local.Push(entry) == false) {
+                        _queue.Post(entry);
+                        break;
+                    }
+                }
+            }
+
+            _queue.Unlock();
+
+            return (result);
+        }
+        bool Rob(Minion& thief, QueueElement& job) {
+            bool result = false;
+
+            VisitMinions([&](Minion& victim) {
+                result = result || ((&victim != &thief) && (victim._local.Pop(job) == true));
+            });
+
+            return (result);
+        }
+        bool Find(Minion& minion, QueueElement& job) {
+            return ((minion._local.Pop(job) == true) || (Inject(minion, job) == true) || (Rob(minion, job) == true));
+        }
+        bool Steal(Minion& minion, QueueElement& job) {
+            bool found = false;
+
+            while ((found == false) && (_running == true)) {
+
+                found = Find(minion, job);
+
+                if (found == false) {
+                    // Nothing to do, announce that we are going to park, and check once more to avoid
+                    // missing work that was queued in the mean time.
+                    minion._wakeup.ResetEvent();
+                    minion._parked = true;
+
+                    std::atomic_thread_fence(Core::memory_order::memory_order_seq_cst);
+
+                    found = Find(minion, job);
+
+                    if ((found == false) && (_running == true)) {
+                        minion._wakeup.Lock(infinite);
+                    }
+
+                    minion._parked = false;
+                }
+                else if (minion._local.IsEmpty() == false) {
+                    // We have more work than we can handle right now, let an idle minion help us out.
+                    Wake();
+                }
+            }
+
+            return (found);
         }
 
     private:
         MessageQueue _queue;
+        const scheduling _scheduling;
+        std::atomic<bool> _running;
         std::list<Executor> _units;
         IScheduler* _scheduler;
         #ifdef __CORE_WARNING_REPORTING__
@@ -153,21 +153,94 @@ namespace Core {
         };
 
         using TimeInfoBlocks = TimedInfo<CONTENT>;
-        using SubscriberList = typename std::list<TimeInfoBlocks>;
+
+        // The pending timers are kept in a hierarchical timing wheel. The lowest level has a slot
+        // per millisecond, each next level has slots that span a full turn of the level below it.
+        // A timer is put in the slot of its expiry time, on the lowest level that can hold it. Once
+        // a level below turns over, the timers in the next slot of the level above are spread over
+        // the levels below (cascade). Timers in a slot of the lowest level that is due, are moved to
+        // the expired list as a whole. Timers too far out for the highest level, wait in overflow.
+        static constexpr uint8_t SlotBits = 8;
+        static constexpr uint16_t Slots = (1 << SlotBits);
+        static constexpr uint16_t SlotMask = (Slots - 1);
+        static constexpr uint8_t Levels = 4;
+        static constexpr uint16_t Expired = (Levels * Slots);
+        static constexpr uint16_t Overflow = (Expired + 1);
+        static constexpr uint16_t Lists = (Overflow + 1);
+        static constexpr uint64_t Resolution = Time::TicksPerMillisecond;
+
+        struct Link {
+            Link* Previous;
+            Link* Next;
+        };
+
+        class Entry : public Link {
+        public:
+            Entry() = delete;
+            Entry(const Entry&) = delete;
+            Entry& operator=(const Entry&) = delete;
+
+            Entry(TimeInfoBlocks&& info)
+                : Link()
+                , Info(std::move(info))
+                , Key(Hash(Info.Content()))
+                , Tick(0)
+                , Slot(Lists)
+            {
+            }
+            ~Entry() = default;
+
+        public:
+            TimeInfoBlocks Info;
+            const size_t Key;
+            uint64_t Tick;
+            uint16_t Slot;
+        };
+
+        using Index = std::unordered_multimap<size_t, Entry*>;
+
+        // If the content can tell its hash (size_t Hash() const, equal contents have equal hashes), the
+        // timers are indexed so they can be found without walking the wheel, e.g. on a Revoke.
+        IS_MEMBER_AVAILABLE(Hash, hasHash);
+
+        template <typename TYPE = CONTENT>
+        static inline typename Core::TypeTraits::enable_if<hasHash<const TYPE, size_t>::value, size_t>::type
+        Hash(const TYPE& content)
+        {
+            return (content.Hash());
+        }
+
+        template <typename TYPE = CONTENT>
+        static inline typename Core::TypeTraits::enable_if<!hasHash<const TYPE, size_t>::value, size_t>::type
+        Hash(const TYPE&)
+        {
+            return (0);
+        }
+
+        static constexpr bool Indexed = hasHash<const CONTENT, size_t>::value;
 
     public:
         TimerType(const TimerType&) = delete;
         TimerType& operator=(const TimerType&) = delete;
 
         TimerType(const uint32_t stackSize, const TCHAR* timerName)
-            : _pendingQueue()
+            : _lists()
+            , _levelCount()
+            , _pending(0)
+            , _index()
+            , _current(Time::Now().Ticks() / Resolution)
             , _timerThread(*this, stackSize, timerName)
-            , _adminLock()
+            , _adminLock(_T("Core::Timer"))
             , _nextTrigger(NUMBER_MAX_UNSIGNED(uint64_t))
             , _waitForCompletion(true, true)
             , _executing(nullptr)
 
         {
+            for (Link& list : _lists) {
+                list.Previous = &list;
+                list.Next = &list;
+            }
+
             // Everything is initialized, go...
             _timerThread.Block();
         }
@@ -178,7 +251,7 @@ namespace Core {
             _timerThread.Stop();
 
             // Force kill on all pending stuff...
-            _pendingQueue.clear();
+            Clear();
 
             _adminLock.Unlock();
 
@@ -211,7 +284,7 @@ namespace Core {
             _timerThread.Block();
 
             // Force kill on all pending stuff...
-            _pendingQueue.clear();
+            Clear();
             _adminLock.Unlock();
 
             _timerThread.Wait(Thread::BLOCKED, Core::infinite);
@@ -222,14 +295,7 @@ namespace Core {
             // This needs to be atomic. Make sure it is.
             _adminLock.Lock();
 
-            typename SubscriberList::const_iterator index = _pendingQueue.cbegin();
-
-            // Clear all entries !!
-            while ((index != _pendingQueue.cend()) && (*index != element)) {
-                index++;
-            }
-
-            bool found = (index != _pendingQueue.cend());
+            bool found = (Find(element) != nullptr);
 
             // Done with the administration. Release the lock.
             _adminLock.Unlock();
@@ -242,7 +308,7 @@ namespace Core {
         {
             _adminLock.Lock();
 
-            if (ScheduleEntry(std::move(timeInfo)) == true) {
+            if (ScheduleEntry(new Entry(std::move(timeInfo))) == true) {
                 _timerThread.Run();
             }
 
@@ -256,17 +322,9 @@ namespace Core {
 
             _adminLock.Lock();
 
-            typename SubscriberList::iterator index = _pendingQueue.begin();
-
-            while ((index != _pendingQueue.end()) && ((*index).Content() != info)) {
-                ++index;
-            }
-
-            if (index != _pendingQueue.end()) {
-                _pendingQueue.erase(index);
-            }
+            Remove(info);
 
-            if (ScheduleEntry(std::move(newEntry)) == true) {
+            if (ScheduleEntry(new Entry(std::move(newEntry))) == true) {
                 _timerThread.Run();
             }
 
@@ -275,43 +333,25 @@ namespace Core {
 
         bool Revoke(const CONTENT& info)
         {
-            bool foundElement = false;
-
             _adminLock.Lock();
 
-            if (&info == _executing) {
+            if ((_executing != nullptr) && (*_executing == info)) {
 
                 // Seems like we are also executing this ocntext, wait till it is completed and signal that it should not reschedule !!!
                 _executing = nullptr;
 
-                _adminLock.Unlock();
-
-                _waitForCompletion.Lock();
-
-                _adminLock.Lock();
-            }
-
-            typename SubscriberList::iterator index = _pendingQueue.begin();
+                // Unless the context revokes itself, than there is nothing to wait for.
+                if (Thread::ThreadId() != _timerThread.Id()) {
+                    _adminLock.Unlock();
 
-            bool changedHead = false;
+                    _waitForCompletion.Lock();
 
-            while (index != _pendingQueue.end()) {
-                if (index->Content() == info) {
-                    changedHead |= (index == _pendingQueue.begin());
-                    foundElement = true;
-
-                    // Remove this... Found it, remove it.
-                    index = _pendingQueue.erase(index);
-                }
-                else {
-                    ++index;
+                    _adminLock.Lock();
                 }
             }
 
-            if (changedHead == true) {
-                // If we added the new time up front, retrigger the scheduler.
-                _timerThread.Run();
-            }
+            // No need to retrigger the scheduler, if it wakes up for this one, it will find nothing to do.
+            bool foundElement = (Remove(info) != 0);
 
             _adminLock.Unlock();
 
@@ -325,7 +365,7 @@ namespace Core {
 
         uint32_t Pending() const
         {
-            return (static_cast<uint32_t>(_pendingQueue.size()));
+            return (_pending);
         }
 
         ::ThreadId ThreadId() const
@@ -345,25 +385,32 @@ namespace Core {
             // Ranging from 0-Core::infinite
             _timerThread.Block();
 
-            while ((_pendingQueue.empty() == false) && (_pendingQueue.front().ScheduleTime() <= now)) {
-                TimedInfo<CONTENT> info(std::move(_pendingQueue.front()));
-                _executing = &(info.Content());
+            // Move all timers that are due to the expired list, a slot at a time.
+            Advance(now / Resolution);
+
+            while (IsEmpty(Expired) == false) {
+                Entry* entry = static_cast<Entry*>(_lists[Expired].Next);
 
                 // Make sure we loose the current one before we do the call, that one might add ;-)
-                _pendingQueue.pop_front();
+                Detach(entry);
+
+                _executing = &(entry->Info.Content());
                 _waitForCompletion.ResetEvent();
 
                 _adminLock.Unlock();
 
-                uint64_t reschedule = _executing->Timed(info.ScheduleTime());
+                uint64_t reschedule = _executing->Timed(entry->Info.ScheduleTime());
 
                 _adminLock.Lock();
 
                 if ((_executing != nullptr) && (reschedule != 0)) {
                     ASSERT(reschedule > now);
 
-                    info.ScheduleTime(reschedule);
-                    ScheduleEntry(std::move(info));
+                    entry->Info.ScheduleTime(reschedule);
+                    ScheduleEntry(entry);
+                }
+                else {
+                    delete entry;
                 }
 
                 _waitForCompletion.SetEvent();
@@ -371,20 +418,19 @@ namespace Core {
             }
 
             // Calculate the delay...
-            if (_pendingQueue.empty() == true) {
+            if (_pending == 0) {
                 _nextTrigger = NUMBER_MAX_UNSIGNED(uint64_t);
             } else {
                 // Refresh the time, just to be on the safe side...
                 uint64_t delta = Time::Now().Ticks();
+                uint64_t upcoming = (IsEmpty(Expired) == false ? _current : Upcoming());
 
-                if (delta >= _pendingQueue.front().ScheduleTime()) {
+                if (delta >= (upcoming * Resolution)) {
                     _nextTrigger = delta;
                     delayTime = 0;
                 } else {
-                    // The windows counter is in 100ns intervals dus we mmoeten even delen door  1000 (us) * 10 ns = 10.000
-                    // om de waarde in ms te krijgen.
-                    _nextTrigger = _pendingQueue.front().ScheduleTime();
-                    delayTime = static_cast<uint32_t>((_nextTrigger - delta) / Time::TicksPerMillisecond);
+                    _nextTrigger = upcoming * Resolution;
+                    delayTime = static_cast<uint32_t>((_nextTrigger - delta + Resolution - 1) / Resolution);
                 }
             }
 
@@ -394,31 +440,193 @@ namespace Core {
         }
 
     private:
-        bool ScheduleEntry(TimedInfo<CONTENT>&& infoBlock)
+        bool ScheduleEntry(Entry* entry)
         {
-            bool reevaluate = false;
-            typename SubscriberList::iterator index = _pendingQueue.begin();
+            // Never fire early, round up to the next slot.
+            entry->Tick = (entry->Info.ScheduleTime() + Resolution - 1) / Resolution;
 
-            while ((index != _pendingQueue.end()) && (infoBlock.ScheduleTime() >= (*index).ScheduleTime())) {
-                ++index;
+            Place(entry);
+
+            if (Indexed == true) {
+                _index.emplace(entry->Key, entry);
             }
 
-            if (index == _pendingQueue.begin()) {
-                _pendingQueue.push_front(std::move(infoBlock));
+            _pending++;
+
+            // If the new time is before the moment we planned to wake up, retrigger the scheduler.
+            return (entry->Info.ScheduleTime() < _nextTrigger);
+        }
+        void Place(Entry* entry)
+        {
+            uint16_t slot = Expired;
+
+            if (entry->Tick > _current) {
+                const uint64_t delta = entry->Tick - _current;
+                uint8_t level = 0;
+
+                while ((level < Levels) && (delta >= (1ULL << (SlotBits * (level + 1))))) {
+                    level++;
+                }
+
+                slot = (level == Levels ? Overflow : static_cast<uint16_t>((level * Slots) + ((entry->Tick >> (SlotBits * level)) & SlotMask)));
+            }
+
+            Link& list(_lists[slot]);
+
+            entry->Slot = slot;
+            entry->Previous = list.Previous;
+            entry->Next = &list;
+            list.Previous->Next = entry;
+            list.Previous = entry;
 
-                // If we added the new time up front, retrigger the scheduler.
-                reevaluate = true;
-            } else if (index == _pendingQueue.end()) {
-                _pendingQueue.push_back(std::move(infoBlock));
+            if (slot < Expired) {
+                _levelCount[slot >> SlotBits]++;
+            }
+        }
+        void Unlink(Entry* entry)
+        {
+            entry->Previous->Next = entry->Next;
+            entry->Next->Previous = entry->Previous;
+
+            if (entry->Slot < Expired) {
+                _levelCount[entry->Slot >> SlotBits]--;
+            }
+        }
+        void Detach(Entry* entry)
+        {
+            Unlink(entry);
+
+            if (Indexed == true) {
+                std::pair<typename Index::iterator, typename Index::iterator> range(_index.equal_range(entry->Key));
+
+                while ((range.first != range.second) && (range.first->second != entry)) {
+                    range.first++;
+                }
+
+                ASSERT(range.first != range.second);
+
+                _index.erase(range.first);
+            }
+
+            _pending--;
+        }
+        bool IsEmpty(const uint16_t slot) const
+        {
+            return (_lists[slot].Next == &_lists[slot]);
+        }
+        // The first tick after the current one, at which a slot on the lowest level is due, or a slot
+        // of a higher level needs to be cascaded.
+        uint64_t Upcoming() const
+        {
+            uint64_t result = NUMBER_MAX_UNSIGNED(uint64_t);
+
+            for (uint8_t level = 0; level < Levels; level++) {
+                if (_levelCount[level] != 0) {
+                    const uint8_t shift = (level * SlotBits);
+                    uint64_t tick = (((_current >> shift) + 1) << shift);
+
+                    for (uint16_t step = 0; (step < Slots) && (tick < result); step++, tick += (1ULL << shift)) {
+                        if (IsEmpty(static_cast<uint16_t>((level * Slots) + ((tick >> shift) & SlotMask))) == false) {
+                            result = tick;
+                        }
+                    }
+                }
+            }
+
+            if (IsEmpty(Overflow) == false) {
+                const uint8_t shift = (Levels * SlotBits);
+                result = std::min(result, ((_current >> shift) + 1) << shift);
+            }
+
+            return (result);
+        }
+        void Advance(const uint64_t target)
+        {
+            uint64_t tick;
+
+            while ((tick = Upcoming()) <= target) {
+                _current = tick;
+
+                // The levels that turned over at this tick, bring their timers closer.
+                for (uint8_t level = 1; (level <= Levels) && ((tick & ((1ULL << (level * SlotBits)) - 1)) == 0); level++) {
+                    Cascade(level == Levels ? Overflow : static_cast<uint16_t>((level * Slots) + ((tick >> (level * SlotBits)) & SlotMask)));
+                }
+
+                Cascade(static_cast<uint16_t>(tick & SlotMask));
+            }
+
+            if (target > _current) {
+                _current = target;
+            }
+        }
+        void Cascade(const uint16_t slot)
+        {
+            while (IsEmpty(slot) == false) {
+                Entry* entry = static_cast<Entry*>(_lists[slot].Next);
+
+                Unlink(entry);
+                Place(entry);
+            }
+        }
+        Entry* Find(const CONTENT& content) const
+        {
+            Entry* result = nullptr;
+
+            if (Indexed == true) {
+                std::pair<typename Index::const_iterator, typename Index::const_iterator> range(_index.equal_range(Hash(content)));
+
+                while ((result == nullptr) && (range.first != range.second)) {
+                    if (range.first->second->Info == content) {
+                        result = range.first->second;
+                    }
+                    range.first++;
+                }
             } else {
-                _pendingQueue.insert(index, std::move(infoBlock));
+                for (uint16_t slot = 0; (result == nullptr) && (slot < Lists); slot++) {
+                    for (Link* link = _lists[slot].Next; (result == nullptr) && (link != &_lists[slot]); link = link->Next) {
+                        if (static_cast<Entry*>(link)->Info == content) {
+                            result = static_cast<Entry*>(link);
+                        }
+                    }
+                }
+            }
+
+            return (result);
+        }
+        uint32_t Remove(const CONTENT& content)
+        {
+            uint32_t count = 0;
+            Entry* entry;
+
+            while ((entry = Find(content)) != nullptr) {
+                Detach(entry);
+                delete entry;
+                count++;
+            }
+
+            return (count);
+        }
+        void Clear()
+        {
+            for (uint16_t slot = 0; slot < Lists; slot++) {
+                while (IsEmpty(slot) == false) {
+                    Entry* entry = static_cast<Entry*>(_lists[slot].Next);
+
+                    Unlink(entry);
+                    delete entry;
+                }
             }
 
-            return (reevaluate);
+            _index.clear();
+            _pending = 0;
         }
 
     private:
-        SubscriberList _pendingQueue;
+        Link _lists[Lists];
+        uint32_t _levelCount[Levels];
+        uint32_t _pending;
+        Index _index;
+        uint64_t _current;
         TimeWorker _timerThread;
         mutable CriticalSection _adminLock;
         uint64_t _nextTrigger;
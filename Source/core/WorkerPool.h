@@ -144,6 +144,10 @@ namespace Core {
             {
                 return (!operator==(RHS));
             }
+            size_t Hash() const
+            {
+                return (_job.IsValid() == true ? reinterpret_cast<size_t>(_job.operator->()) : 0);
+            }
             uint64_t Timed(const uint64_t /* scheduledTime */)
             {
                 ASSERT(_pool != nullptr);
@@ -308,9 +312,9 @@ namespace Core {
         WorkerPool& operator=(const WorkerPool&) = delete;
 
 PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
-        WorkerPool(const uint8_t threadCount, const uint32_t stackSize, const uint32_t queueSize, ThreadPool::IDispatcher* dispatcher, ThreadPool::ICallback* callback = nullptr)
+        WorkerPool(const uint8_t threadCount, const uint32_t stackSize, const uint32_t queueSize, ThreadPool::IDispatcher* dispatcher, ThreadPool::ICallback* callback = nullptr, const ThreadPool::scheduling mode = ThreadPool::QUEUED)
             : _scheduler(this, _timer)
-            , _threadPool(threadCount, stackSize, queueSize, dispatcher, &_scheduler, &_external, callback)
+            , _threadPool(threadCount, stackSize, queueSize, dispatcher, &_scheduler, &_external, callback, mode)
             , _external(_threadPool, dispatcher)
             , _timer(1024 * 1024, _T("WorkerPoolType::Timer"))
             , _metadata()
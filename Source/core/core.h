@@ -73,9 +73,12 @@
 #include "Services.h"
 #include "SharedBuffer.h"
 #include "Singleton.h"
+#include "SlabAllocator.h"
+#include "Snapshot.h"
 #include "SocketPort.h"
 #include "SocketServer.h"
 #include "StateTrigger.h"
+#include "StealingQueue.h"
 #include "StopWatch.h"
 #include "Stream.h"
 #include "StreamJSON.h"
@@ -18,25 +18,280 @@
  */
  
 #include "AES.h"
+#include "AESAcceleration.h"
 
 namespace WPEFramework {
 namespace Crypto {
 
+    namespace {
+
+        // Encrypting and hashing go in pieces of this size, so what is hashed is still in the cache.
+        constexpr uint32_t Chunk = 4096;
+
+        inline uint32_t BigEndian(const uint8_t data[])
+        {
+            return ((static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]));
+        }
+        inline void BigEndian(uint8_t data[], const uint64_t value)
+        {
+            for (uint8_t index = 0; index < 8; index++) {
+                data[index] = static_cast<uint8_t>(value >> (56 - (index * 8)));
+            }
+        }
+
+        // The kernels count in the last 4 bytes of the counter block, as AES_GCM does. AES_CTR counts in all
+        // 16, so when those 4 bytes roll over, the carry goes into the ones in front of them.
+        void Carry(uint8_t counter[16])
+        {
+            if (BigEndian(&counter[12]) == 0) {
+                int8_t index = 11;
+
+                while ((index >= 0) && (++counter[index] == 0)) {
+                    index--;
+                }
+            }
+        }
+
+        // XORs the keystream over the message. The keystream of a block that is only partly used is kept for
+        // the next piece of the message, the offset is how much of it is used.
+        void Count(const mbedtls_aes_context& context, uint8_t counter[16], uint8_t stream[16], size_t& offset, const bool wide, const uint32_t length, const uint8_t input[], uint8_t output[])
+        {
+            const Kernels::Counter counting = Kernels::AESCounter();
+            uint32_t position = 0;
+
+            while ((offset != 0) && (position < length)) {
+                output[position] = input[position] ^ stream[offset];
+                offset = ((offset + 1) & 0x0F);
+                position++;
+            }
+
+            uint32_t blocks = ((length - position) / 16);
+
+            while (blocks > 0) {
+                uint32_t count = blocks;
+
+                if (wide == true) {
+                    const uint64_t room = (0x100000000ULL - BigEndian(&counter[12]));
+
+                    if (count > room) {
+                        count = static_cast<uint32_t>(room);
+                    }
+                }
+
+                counting(context, counter, &(input[position]), &(output[position]), count);
+                position += (count * 16);
+                blocks -= count;
+
+                if (wide == true) {
+                    Carry(counter);
+                }
+            }
+
+            if (position < length) {
+                const uint8_t zeroes[16] = {};
+
+                counting(context, counter, zeroes, stream, 1);
+
+                if (wide == true) {
+                    Carry(counter);
+                }
+
+                while (position < length) {
+                    output[position] = input[position] ^ stream[offset];
+                    offset++;
+                    position++;
+                }
+            }
+        }
+
+        // Adds data to the GHASH. A block that is not complete yet waits in the context for the rest of it, the
+        // total is the number of bytes that came before this data.
+        void Absorb(GCMContext& gcm, const uint64_t total, const uint32_t length, const uint8_t data[])
+        {
+            const Kernels::GHash hashing = Kernels::AESGHash();
+            uint8_t used = static_cast<uint8_t>(total & 0x0F);
+            uint32_t position = 0;
+
+            if (used != 0) {
+                position = std::min(static_cast<uint32_t>(16 - used), length);
+                ::memcpy(&(gcm.pending[used]), data, position);
+
+                if ((used + position) == 16) {
+                    hashing(gcm.hash, gcm, gcm.pending, 1);
+                }
+            }
+
+            const uint32_t blocks = ((length - position) / 16);
+
+            if (blocks > 0) {
+                hashing(gcm.hash, gcm, &(data[position]), blocks);
+                position += (blocks * 16);
+            }
+
+            if (position < length) {
+                ::memcpy(gcm.pending, &(data[position]), length - position);
+            }
+        }
+
+        // Hashes the block that waits, padded with zeroes.
+        void Flush(const GCMContext& gcm, const uint64_t total, uint8_t hash[16], uint8_t pending[16])
+        {
+            const uint8_t used = static_cast<uint8_t>(total & 0x0F);
+
+            if (used != 0) {
+                ::memset(&(pending[used]), 0, 16 - used);
+                Kernels::AESGHash()(hash, gcm, pending, 1);
+            }
+        }
+
+        void Prepare(const mbedtls_aes_context& context, GCMContext& gcm)
+        {
+            uint8_t h[16] = {};
+
+            mbedtls_aes_encrypt(const_cast<mbedtls_aes_context*>(&context), h, h);
+            Kernels::GHashKey(gcm, h);
+        }
+
+        uint32_t Start(const mbedtls_aes_context& context, GCMContext& gcm, uint8_t counter[16], const uint8_t length, const uint8_t nonce[])
+        {
+            uint32_t result = Core::ERROR_INVALID_INPUT_LENGTH;
+
+            if (length > 0) {
+                ::memset(gcm.hash, 0, sizeof(gcm.hash));
+
+                if (length == 12) {
+                    ::memcpy(counter, nonce, 12);
+                    counter[12] = 0;
+                    counter[13] = 0;
+                    counter[14] = 0;
+                    counter[15] = 1;
+                } else {
+                    // Any other length is hashed into the counter block, with its length in bits behind it.
+                    uint8_t lengths[16] = {};
+
+                    ::memset(counter, 0, 16);
+                    Absorb(gcm, 0, length, nonce);
+                    Flush(gcm, length, gcm.hash, gcm.pending);
+                    BigEndian(&lengths[8], static_cast<uint64_t>(length) * 8);
+                    Kernels::AESGHash()(gcm.hash, gcm, lengths, 1);
+                    ::memcpy(counter, gcm.hash, 16);
+                    ::memset(gcm.hash, 0, sizeof(gcm.hash));
+                }
+
+                // The first counter block encrypts the tag, the message starts at the next one.
+                const uint8_t zeroes[16] = {};
+                Kernels::AESCounter()(context, counter, zeroes, gcm.mask, 1);
+
+                gcm.authenticated = 0;
+                gcm.processed = 0;
+                result = Core::ERROR_NONE;
+            }
+
+            return (result);
+        }
+
+        uint32_t Authenticate(GCMContext& gcm, const uint32_t length, const uint8_t data[])
+        {
+            uint32_t result = Core::ERROR_ILLEGAL_STATE;
+
+            if (gcm.processed == 0) {
+                Absorb(gcm, gcm.authenticated, length, data);
+                gcm.authenticated += length;
+                result = Core::ERROR_NONE;
+            }
+
+            return (result);
+        }
+
+        // The additional data is padded to a whole block before the message comes in.
+        void Payload(GCMContext& gcm, const uint32_t length)
+        {
+            if ((gcm.processed == 0) && (length > 0)) {
+                Flush(gcm, gcm.authenticated, gcm.hash, gcm.pending);
+            }
+        }
+
+        uint32_t Tag(const GCMContext& gcm, const uint8_t length, uint8_t tag[])
+        {
+            uint32_t result = Core::ERROR_INVALID_INPUT_LENGTH;
+
+            if ((length >= 4) && (length <= 16)) {
+                uint8_t hash[16];
+                uint8_t pending[16];
+                uint8_t lengths[16];
+
+                ::memcpy(hash, gcm.hash, sizeof(hash));
+                ::memcpy(pending, gcm.pending, sizeof(pending));
+
+                // The context stays as it is, the tag of the message so far can be taken more than once.
+                Flush(gcm, (gcm.processed == 0 ? gcm.authenticated : gcm.processed), hash, pending);
+                BigEndian(&lengths[0], gcm.authenticated * 8);
+                BigEndian(&lengths[8], gcm.processed * 8);
+                Kernels::AESGHash()(hash, gcm, lengths, 1);
+
+                for (uint8_t index = 0; index < length; index++) {
+                    tag[index] = hash[index] ^ gcm.mask[index];
+                }
+
+                result = Core::ERROR_NONE;
+            }
+
+            return (result);
+        }
+
+    }
+
     AESEncryption::AESEncryption(const aesType type)
         : _type(type)
+        , _offset(0)
     {
         ::memset(_iv, 0, sizeof(_iv));
+        ::memset(_stream, 0, sizeof(_stream));
+        ::memset(&_gcm, 0, sizeof(_gcm));
     }
 
     AESEncryption::~AESEncryption()
     {
     }
 
+    uint32_t AESEncryption::InitialVector(const uint8_t length, const uint8_t iv[])
+    {
+        uint32_t result = Core::ERROR_INVALID_INPUT_LENGTH;
+
+        _offset = 0;
+
+        if (Type() == AES_GCM) {
+            result = Start(_context, _gcm, _iv, length, iv);
+        } else if (length == sizeof(_iv)) {
+            ::memcpy(_iv, iv, sizeof(_iv));
+            result = Core::ERROR_NONE;
+        }
+
+        return (result);
+    }
+
     uint32_t AESEncryption::Key(const uint8_t length, const uint8_t key[])
     {
         ASSERT((length == 16 /* 128 bits */) || (length == 24 /* 192 bits */) || (length == 32 /* 256 bits */));
         mbedtls_aes_init(&_context);
-        return (mbedtls_aes_setkey_enc(&_context, key, (length << 3)));
+
+        uint32_t result = mbedtls_aes_setkey_enc(&_context, key, (length << 3));
+
+        if ((result == 0) && (Type() == AES_GCM)) {
+            Prepare(_context, _gcm);
+        }
+
+        return (result);
+    }
+
+    uint32_t AESEncryption::Authenticate(const uint32_t length, const uint8_t data[])
+    {
+        return (Type() == AES_GCM ? Crypto::Authenticate(_gcm, length, data) : static_cast<uint32_t>(Core::ERROR_UNAVAILABLE));
+    }
+
+    uint32_t AESEncryption::Tag(const uint8_t length, uint8_t tag[])
+    {
+        return (Type() == AES_GCM ? Crypto::Tag(_gcm, length, tag) : static_cast<uint32_t>(Core::ERROR_UNAVAILABLE));
     }
 
     uint32_t AESEncryption::Encrypt(const uint32_t length, const uint8_t input[], uint8_t output[])
@@ -45,6 +300,25 @@ namespace Crypto {
         uint32_t result = Core::ERROR_UNAVAILABLE;
 
         switch (Type()) {
+        case AES_CTR: {
+            Count(_context, _iv, _stream, _offset, true, length, input, output);
+            result = Core::ERROR_NONE;
+            break;
+        }
+        case AES_GCM: {
+            Payload(_gcm, length);
+
+            for (uint32_t offset = 0; offset < length; offset += Chunk) {
+                const uint32_t size = std::min(Chunk, length - offset);
+
+                Count(_context, _iv, _stream, _offset, false, size, &(input[offset]), &(output[offset]));
+                Absorb(_gcm, _gcm.processed, size, &(output[offset]));
+                _gcm.processed += size;
+            }
+
+            result = Core::ERROR_NONE;
+            break;
+        }
         case AES_ECB: {
             uint32_t offset = 0;
             uint32_t blockSize = ((length / 16) * 16);
@@ -184,6 +458,8 @@ namespace Crypto {
         , _offset(0)
     {
         ::memset(_iv, 0, sizeof(_iv));
+        ::memset(_stream, 0, sizeof(_stream));
+        ::memset(&_gcm, 0, sizeof(_gcm));
     }
 
     AESDecryption::~AESDecryption()
@@ -201,7 +477,61 @@ namespace Crypto {
             // should ude the encryption key. Not sure !!!!!
             return (mbedtls_aes_setkey_dec(&_context, key, length << 3));
         }
-        return (mbedtls_aes_setkey_enc(&_context, key, (length << 3)));
+
+        uint32_t result = mbedtls_aes_setkey_enc(&_context, key, (length << 3));
+
+        if ((result == 0) && (Type() == AES_GCM)) {
+            Prepare(_context, _gcm);
+        }
+
+        return (result);
+    }
+
+    uint32_t AESDecryption::InitialVector(const uint8_t length, const uint8_t iv[])
+    {
+        uint32_t result = Core::ERROR_INVALID_INPUT_LENGTH;
+
+        _offset = 0;
+
+        if (Type() == AES_GCM) {
+            result = Start(_context, _gcm, _iv, length, iv);
+        } else if (length == sizeof(_iv)) {
+            if (_iv != iv) {
+                ::memcpy(_iv, iv, sizeof(_iv));
+            }
+            result = Core::ERROR_NONE;
+        }
+
+        return (result);
+    }
+
+    uint32_t AESDecryption::Authenticate(const uint32_t length, const uint8_t data[])
+    {
+        return (Type() == AES_GCM ? Crypto::Authenticate(_gcm, length, data) : static_cast<uint32_t>(Core::ERROR_UNAVAILABLE));
+    }
+
+    uint32_t AESDecryption::Verify(const uint8_t length, const uint8_t tag[])
+    {
+        uint32_t result = Core::ERROR_UNAVAILABLE;
+
+        if (Type() == AES_GCM) {
+            uint8_t expected[16];
+
+            result = Crypto::Tag(_gcm, length, expected);
+
+            if (result == Core::ERROR_NONE) {
+                // Compare all of it, how long it takes should not tell where the first difference is.
+                uint8_t difference = 0;
+
+                for (uint8_t index = 0; index < length; index++) {
+                    difference |= (expected[index] ^ tag[index]);
+                }
+
+                result = (difference == 0 ? Core::ERROR_NONE : Core::ERROR_INCORRECT_HASH);
+            }
+        }
+
+        return (result);
     }
 
     uint32_t AESDecryption::Decrypt(const uint32_t length, const uint8_t input[], uint8_t output[])
@@ -209,6 +539,26 @@ namespace Crypto {
         uint32_t result = Core::ERROR_UNAVAILABLE;
 
         switch (Type()) {
+        case AES_CTR: {
+            Count(_context, _iv, _stream, _offset, true, length, input, output);
+            result = Core::ERROR_NONE;
+            break;
+        }
+        case AES_GCM: {
+            Payload(_gcm, length);
+
+            // The ciphertext is hashed first, the output may be the same buffer as the input.
+            for (uint32_t offset = 0; offset < length; offset += Chunk) {
+                const uint32_t size = std::min(Chunk, length - offset);
+
+                Absorb(_gcm, _gcm.processed, size, &(input[offset]));
+                Count(_context, _iv, _stream, _offset, false, size, &(input[offset]), &(output[offset]));
+                _gcm.processed += size;
+            }
+
+            result = Core::ERROR_NONE;
+            break;
+        }
         case AES_ECB: {
             uint32_t offset = 0;
             uint32_t blockSize = ((length / 16) * 16);
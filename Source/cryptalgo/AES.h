@@ -31,7 +31,9 @@ namespace Crypto {
         AES_CBC,
         AES_CFB8,
         AES_CFB128,
-        AES_OFB
+        AES_OFB,
+        AES_CTR,
+        AES_GCM
     };
 
     enum bitLength : uint16_t {
@@ -40,6 +42,17 @@ namespace Crypto {
         BITLENGTH_256 = 256
     };
 
+    // What AES_GCM keeps of the hash key and of the message that is being processed.
+    struct EXTERNAL GCMContext {
+        uint64_t table[2][16];
+        uint8_t powers[8][16];
+        uint8_t mask[16];
+        uint8_t hash[16];
+        uint8_t pending[16];
+        uint64_t authenticated;
+        uint64_t processed;
+    };
+
     class EXTERNAL AESEncryption {
     private:
         AESEncryption() = delete;
@@ -61,18 +74,26 @@ namespace Crypto {
         }
         inline void InitialVector(const uint8_t iv[16])
         {
-            _offset = 0;
-            ::memcpy(_iv, iv, sizeof(_iv));
+            InitialVector(sizeof(_iv), iv);
         }
+        // AES_GCM takes a nonce of any length, 12 bytes is what it is made for, all others take 16 bytes. It
+        // starts a new message, for AES_CTR and AES_GCM with the keystream and the authentication.
+        uint32_t InitialVector(const uint8_t length, const uint8_t iv[]);
         uint32_t Key(const uint8_t length, const uint8_t key[]);
 
+        // AES_CTR and AES_GCM take the message in pieces of any length. For AES_GCM, the additional data that
+        // is only authenticated goes in first, through Authenticate(), and Tag() ends the message.
+        uint32_t Authenticate(const uint32_t length, const uint8_t data[]);
         uint32_t Encrypt(const uint32_t length, const uint8_t input[], uint8_t output[]);
+        uint32_t Tag(const uint8_t length, uint8_t tag[]);
 
     private:
         aesType _type;
         mbedtls_aes_context _context;
         uint8_t _iv[16];
         size_t _offset;
+        uint8_t _stream[16];
+        GCMContext _gcm;
     };
 
     class EXTERNAL AESDecryption {
@@ -96,20 +117,24 @@ namespace Crypto {
         }
         inline void InitialVector(const uint8_t iv[16])
         {
-            _offset = 0;
-            if (_iv != iv) {
-                ::memcpy(_iv, iv, sizeof(_iv));
-            }
+            InitialVector(sizeof(_iv), iv);
         }
+        uint32_t InitialVector(const uint8_t length, const uint8_t iv[]);
         uint32_t Key(const uint8_t length, const uint8_t key[]);
 
+        // AES_GCM checks the tag the message was sent with, Core::ERROR_INCORRECT_HASH if it does not match. The
+        // decrypted message can not be trusted before it has been checked.
+        uint32_t Authenticate(const uint32_t length, const uint8_t data[]);
         uint32_t Decrypt(const uint32_t length, const uint8_t input[], uint8_t output[]);
+        uint32_t Verify(const uint8_t length, const uint8_t tag[]);
 
     private:
         aesType _type;
         mbedtls_aes_context _context;
         uint8_t _iv[16];
         size_t _offset;
+        uint8_t _stream[16];
+        GCMContext _gcm;
     };
 }
 } // namespace Crypto
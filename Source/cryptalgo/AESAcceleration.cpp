@@ -0,0 +1,536 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AESAcceleration.h"
+#include "Hash.h"
+
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __CRYPTALGO_AES_NI__
+#include <immintrin.h>
+#elif (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)) && (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define __CRYPTALGO_AES_ARMV8__
+#include <arm_neon.h>
+#if defined(__LINUX__) && defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace WPEFramework {
+namespace Crypto {
+    namespace Kernels {
+
+        namespace {
+
+            // What falls off the end of the GHASH block when it is shifted 4 bits, reduced.
+            const uint64_t Remainders[16] = {
+                0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+                0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+            };
+
+            inline uint32_t BigEndian(const uint8_t data[])
+            {
+                return ((static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]));
+            }
+            inline void BigEndian(uint8_t data[], const uint32_t value)
+            {
+                data[0] = static_cast<uint8_t>(value >> 24);
+                data[1] = static_cast<uint8_t>(value >> 16);
+                data[2] = static_cast<uint8_t>(value >> 8);
+                data[3] = static_cast<uint8_t>(value);
+            }
+
+            // --------------------------------------------------------------------------------------------
+            // Portable C, for any CPU
+            // --------------------------------------------------------------------------------------------
+
+            // Multiplies the block with H, 4 bits at a time through the table of H times every 4 bits value.
+            void Multiply(uint8_t block[16], const GCMContext& key)
+            {
+                uint8_t nibble = (block[15] & 0x0F);
+                uint64_t high = key.table[0][nibble];
+                uint64_t low = key.table[1][nibble];
+
+                for (int8_t index = 15; index >= 0; index--) {
+                    for (uint8_t half = (index == 15 ? 1 : 0); half < 2; half++) {
+                        const uint8_t remainder = static_cast<uint8_t>(low & 0x0F);
+
+                        nibble = (half == 0 ? (block[index] & 0x0F) : (block[index] >> 4));
+                        low = (high << 60) | (low >> 4);
+                        high = (high >> 4) ^ (Remainders[remainder] << 48) ^ key.table[0][nibble];
+                        low ^= key.table[1][nibble];
+                    }
+                }
+
+                BigEndian(&block[0], static_cast<uint32_t>(high >> 32));
+                BigEndian(&block[4], static_cast<uint32_t>(high));
+                BigEndian(&block[8], static_cast<uint32_t>(low >> 32));
+                BigEndian(&block[12], static_cast<uint32_t>(low));
+            }
+
+            void CounterPortable(const mbedtls_aes_context& context, uint8_t counter[16], const uint8_t input[], uint8_t output[], const uint32_t blocks)
+            {
+                uint32_t number = BigEndian(&counter[12]);
+                uint8_t stream[16];
+
+                for (uint32_t block = 0; block < blocks; block++, input += 16, output += 16) {
+                    mbedtls_aes_encrypt(const_cast<mbedtls_aes_context*>(&context), counter, stream);
+
+                    for (uint8_t index = 0; index < 16; index++) {
+                        output[index] = input[index] ^ stream[index];
+                    }
+
+                    BigEndian(&counter[12], ++number);
+                }
+            }
+
+            void GHashPortable(uint8_t hash[16], const GCMContext& key, const uint8_t data[], const uint32_t blocks)
+            {
+                for (uint32_t block = 0; block < blocks; block++, data += 16) {
+                    for (uint8_t index = 0; index < 16; index++) {
+                        hash[index] ^= data[index];
+                    }
+
+                    Multiply(hash, key);
+                }
+            }
+
+#ifdef __CRYPTALGO_AES_NI__
+            // --------------------------------------------------------------------------------------------
+            // x86 AES-NI and PCLMULQDQ. An AES round takes a few cycles, but a new one can start every cycle,
+            // so 8 blocks go through the rounds together. GHASH multiplies 8 blocks with H^8 down to H and
+            // reduces their sum once.
+            // --------------------------------------------------------------------------------------------
+            __attribute__((target("aes,sse4.1"))) void CounterNI(const mbedtls_aes_context& context, uint8_t counter[16], const uint8_t input[], uint8_t output[], const uint32_t blocks)
+            {
+                const uint8_t rounds = static_cast<uint8_t>(context.nr);
+                const __m128i base = _mm_loadu_si128(reinterpret_cast<const __m128i*>(counter));
+                uint32_t number = BigEndian(&counter[12]);
+                uint32_t block = 0;
+                __m128i keys[15];
+
+                for (uint8_t index = 0; index <= rounds; index++) {
+                    keys[index] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&context.rk[index * 4]));
+                }
+
+                for (; (block + 8) <= blocks; block += 8, number += 8, input += 128, output += 128) {
+                    __m128i state[8];
+
+                    for (uint8_t lane = 0; lane < 8; lane++) {
+                        state[lane] = _mm_xor_si128(_mm_insert_epi32(base, static_cast<int>(__builtin_bswap32(number + lane)), 3), keys[0]);
+                    }
+                    for (uint8_t round = 1; round < rounds; round++) {
+                        for (uint8_t lane = 0; lane < 8; lane++) {
+                            state[lane] = _mm_aesenc_si128(state[lane], keys[round]);
+                        }
+                    }
+                    for (uint8_t lane = 0; lane < 8; lane++) {
+                        state[lane] = _mm_aesenclast_si128(state[lane], keys[rounds]);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[lane * 16]), _mm_xor_si128(state[lane], _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[lane * 16]))));
+                    }
+                }
+
+                for (; block < blocks; block++, number++, input += 16, output += 16) {
+                    __m128i state = _mm_xor_si128(_mm_insert_epi32(base, static_cast<int>(__builtin_bswap32(number)), 3), keys[0]);
+
+                    for (uint8_t round = 1; round < rounds; round++) {
+                        state = _mm_aesenc_si128(state, keys[round]);
+                    }
+
+                    state = _mm_aesenclast_si128(state, keys[rounds]);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_xor_si128(state, _mm_loadu_si128(reinterpret_cast<const __m128i*>(input))));
+                }
+
+                BigEndian(&counter[12], number);
+            }
+
+            __attribute__((target("pclmul,sse2"))) inline void Accumulate(const __m128i data, const __m128i power, __m128i& low, __m128i& middle, __m128i& high)
+            {
+                low = _mm_xor_si128(low, _mm_clmulepi64_si128(data, power, 0x00));
+                middle = _mm_xor_si128(middle, _mm_xor_si128(_mm_clmulepi64_si128(data, power, 0x10), _mm_clmulepi64_si128(data, power, 0x01)));
+                high = _mm_xor_si128(high, _mm_clmulepi64_si128(data, power, 0x11));
+            }
+
+            // From the 256 bits carry-less product, in three parts, back to 128 bits modulo x^128 + x^7 + x^2 + x + 1.
+            // The bits are reflected, so the product is first shifted one bit to the left.
+            __attribute__((target("sse2"))) inline __m128i Reduce(__m128i low, const __m128i middle, __m128i high)
+            {
+                low = _mm_xor_si128(low, _mm_slli_si128(middle, 8));
+                high = _mm_xor_si128(high, _mm_srli_si128(middle, 8));
+
+                __m128i lowCarry = _mm_srli_epi32(low, 31);
+                __m128i highCarry = _mm_srli_epi32(high, 31);
+                const __m128i across = _mm_srli_si128(lowCarry, 12);
+
+                lowCarry = _mm_slli_si128(lowCarry, 4);
+                highCarry = _mm_slli_si128(highCarry, 4);
+                low = _mm_or_si128(_mm_slli_epi32(low, 1), lowCarry);
+                high = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(high, 1), highCarry), across);
+
+                __m128i folded = _mm_xor_si128(_mm_xor_si128(_mm_slli_epi32(low, 31), _mm_slli_epi32(low, 30)), _mm_slli_epi32(low, 25));
+                const __m128i rest = _mm_srli_si128(folded, 4);
+
+                low = _mm_xor_si128(low, _mm_slli_si128(folded, 12));
+                folded = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi32(low, 1), _mm_srli_epi32(low, 2)), _mm_srli_epi32(low, 7));
+
+                return (_mm_xor_si128(high, _mm_xor_si128(low, _mm_xor_si128(folded, rest))));
+            }
+
+            __attribute__((target("pclmul,ssse3"))) void GHashCLMUL(uint8_t hash[16], const GCMContext& key, const uint8_t data[], const uint32_t blocks)
+            {
+                const __m128i order = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+                __m128i value = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hash)), order);
+                uint32_t block = 0;
+                __m128i powers[8];
+
+                for (uint8_t index = 0; index < 8; index++) {
+                    powers[index] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key.powers[index]));
+                }
+
+                for (; (block + 8) <= blocks; block += 8, data += 128) {
+                    __m128i low = _mm_setzero_si128();
+                    __m128i middle = _mm_setzero_si128();
+                    __m128i high = _mm_setzero_si128();
+
+                    for (uint8_t index = 0; index < 8; index++) {
+                        __m128i input = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index * 16])), order);
+
+                        if (index == 0) {
+                            input = _mm_xor_si128(input, value);
+                        }
+
+                        Accumulate(input, powers[7 - index], low, middle, high);
+                    }
+
+                    value = Reduce(low, middle, high);
+                }
+
+                for (; block < blocks; block++, data += 16) {
+                    __m128i low = _mm_setzero_si128();
+                    __m128i middle = _mm_setzero_si128();
+                    __m128i high = _mm_setzero_si128();
+
+                    Accumulate(_mm_xor_si128(value, _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data)), order)), powers[0], low, middle, high);
+
+                    value = Reduce(low, middle, high);
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(hash), _mm_shuffle_epi8(value, order));
+            }
+#endif
+
+#ifdef __CRYPTALGO_AES_ARMV8__
+            // --------------------------------------------------------------------------------------------
+            // ARMv8 AES and PMULL, the same pipelining and the same GHASH as for x86.
+            // --------------------------------------------------------------------------------------------
+#define ARMV8_SHIFT_LEFT(x, n) vreinterpretq_u8_u32(vshlq_n_u32(vreinterpretq_u32_u8(x), (n)))
+#define ARMV8_SHIFT_RIGHT(x, n) vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(x), (n)))
+
+            inline uint8x16_t CounterBlock(const uint8x16_t base, const uint32_t number)
+            {
+                return (vreinterpretq_u8_u32(vsetq_lane_u32(__builtin_bswap32(number), vreinterpretq_u32_u8(base), 3)));
+            }
+
+            inline uint8x16_t Encrypt(uint8x16_t state, const uint8x16_t keys[], const uint8_t rounds)
+            {
+                for (uint8_t round = 0; round < (rounds - 1); round++) {
+                    state = vaesmcq_u8(vaeseq_u8(state, keys[round]));
+                }
+
+                return (veorq_u8(vaeseq_u8(state, keys[rounds - 1]), keys[rounds]));
+            }
+
+            void CounterARMv8(const mbedtls_aes_context& context, uint8_t counter[16], const uint8_t input[], uint8_t output[], const uint32_t blocks)
+            {
+                const uint8_t rounds = static_cast<uint8_t>(context.nr);
+                const uint8x16_t base = vld1q_u8(counter);
+                uint32_t number = BigEndian(&counter[12]);
+                uint32_t block = 0;
+                uint8x16_t keys[15];
+
+                for (uint8_t index = 0; index <= rounds; index++) {
+                    keys[index] = vld1q_u8(reinterpret_cast<const uint8_t*>(&context.rk[index * 4]));
+                }
+
+                for (; (block + 8) <= blocks; block += 8, number += 8, input += 128, output += 128) {
+                    uint8x16_t state[8];
+
+                    for (uint8_t lane = 0; lane < 8; lane++) {
+                        state[lane] = CounterBlock(base, number + lane);
+                    }
+                    for (uint8_t round = 0; round < (rounds - 1); round++) {
+                        for (uint8_t lane = 0; lane < 8; lane++) {
+                            state[lane] = vaesmcq_u8(vaeseq_u8(state[lane], keys[round]));
+                        }
+                    }
+                    for (uint8_t lane = 0; lane < 8; lane++) {
+                        state[lane] = veorq_u8(vaeseq_u8(state[lane], keys[rounds - 1]), keys[rounds]);
+                        vst1q_u8(&output[lane * 16], veorq_u8(state[lane], vld1q_u8(&input[lane * 16])));
+                    }
+                }
+
+                for (; block < blocks; block++, number++, input += 16, output += 16) {
+                    vst1q_u8(output, veorq_u8(Encrypt(CounterBlock(base, number), keys, rounds), vld1q_u8(input)));
+                }
+
+                BigEndian(&counter[12], number);
+            }
+
+            inline uint8x16_t Product(const uint8x16_t left, const uint8_t leftLane, const uint8x16_t right, const uint8_t rightLane)
+            {
+                const uint64x2_t a = vreinterpretq_u64_u8(left);
+                const uint64x2_t b = vreinterpretq_u64_u8(right);
+
+                return (vreinterpretq_u8_p128(vmull_p64(static_cast<poly64_t>(leftLane == 0 ? vgetq_lane_u64(a, 0) : vgetq_lane_u64(a, 1)), static_cast<poly64_t>(rightLane == 0 ? vgetq_lane_u64(b, 0) : vgetq_lane_u64(b, 1)))));
+            }
+
+            inline void Accumulate(const uint8x16_t data, const uint8x16_t power, uint8x16_t& low, uint8x16_t& middle, uint8x16_t& high)
+            {
+                low = veorq_u8(low, Product(data, 0, power, 0));
+                middle = veorq_u8(middle, veorq_u8(Product(data, 0, power, 1), Product(data, 1, power, 0)));
+                high = veorq_u8(high, Product(data, 1, power, 1));
+            }
+
+            inline uint8x16_t Reduce(uint8x16_t low, const uint8x16_t middle, uint8x16_t high)
+            {
+                const uint8x16_t zero = vdupq_n_u8(0);
+
+                low = veorq_u8(low, vextq_u8(zero, middle, 8));
+                high = veorq_u8(high, vextq_u8(middle, zero, 8));
+
+                uint8x16_t lowCarry = ARMV8_SHIFT_RIGHT(low, 31);
+                uint8x16_t highCarry = ARMV8_SHIFT_RIGHT(high, 31);
+                const uint8x16_t across = vextq_u8(lowCarry, zero, 12);
+
+                lowCarry = vextq_u8(zero, lowCarry, 12);
+                highCarry = vextq_u8(zero, highCarry, 12);
+                low = vorrq_u8(ARMV8_SHIFT_LEFT(low, 1), lowCarry);
+                high = vorrq_u8(vorrq_u8(ARMV8_SHIFT_LEFT(high, 1), highCarry), across);
+
+                uint8x16_t folded = veorq_u8(veorq_u8(ARMV8_SHIFT_LEFT(low, 31), ARMV8_SHIFT_LEFT(low, 30)), ARMV8_SHIFT_LEFT(low, 25));
+                const uint8x16_t rest = vextq_u8(folded, zero, 4);
+
+                low = veorq_u8(low, vextq_u8(zero, folded, 4));
+                folded = veorq_u8(veorq_u8(ARMV8_SHIFT_RIGHT(low, 1), ARMV8_SHIFT_RIGHT(low, 2)), ARMV8_SHIFT_RIGHT(low, 7));
+
+                return (veorq_u8(high, veorq_u8(low, veorq_u8(folded, rest))));
+            }
+
+            inline uint8x16_t Reverse(const uint8x16_t value)
+            {
+                const uint8x16_t swapped = vrev64q_u8(value);
+
+                return (vextq_u8(swapped, swapped, 8));
+            }
+
+            void GHashPMULL(uint8_t hash[16], const GCMContext& key, const uint8_t data[], const uint32_t blocks)
+            {
+                const uint8x16_t zero = vdupq_n_u8(0);
+                uint8x16_t value = Reverse(vld1q_u8(hash));
+                uint32_t block = 0;
+                uint8x16_t powers[8];
+
+                for (uint8_t index = 0; index < 8; index++) {
+                    powers[index] = vld1q_u8(key.powers[index]);
+                }
+
+                for (; (block + 8) <= blocks; block += 8, data += 128) {
+                    uint8x16_t low = zero;
+                    uint8x16_t middle = zero;
+                    uint8x16_t high = zero;
+
+                    for (uint8_t index = 0; index < 8; index++) {
+                        uint8x16_t input = Reverse(vld1q_u8(&data[index * 16]));
+
+                        if (index == 0) {
+                            input = veorq_u8(input, value);
+                        }
+
+                        Accumulate(input, powers[7 - index], low, middle, high);
+                    }
+
+                    value = Reduce(low, middle, high);
+                }
+
+                for (; block < blocks; block++, data += 16) {
+                    uint8x16_t low = zero;
+                    uint8x16_t middle = zero;
+                    uint8x16_t high = zero;
+
+                    Accumulate(veorq_u8(value, Reverse(vld1q_u8(data))), powers[0], low, middle, high);
+
+                    value = Reduce(low, middle, high);
+                }
+
+                vst1q_u8(hash, Reverse(value));
+            }
+
+#undef ARMV8_SHIFT_LEFT
+#undef ARMV8_SHIFT_RIGHT
+#endif
+
+            bool Supported()
+            {
+                bool result = false;
+
+#ifdef __CRYPTALGO_AES_NI__
+                result = ((__builtin_cpu_supports("aes") != 0) && (__builtin_cpu_supports("pclmul") != 0) && (__builtin_cpu_supports("sse4.1") != 0));
+#endif
+#ifdef __CRYPTALGO_AES_ARMV8__
+#if defined(__LINUX__) && defined(__aarch64__)
+                const unsigned long capabilities = getauxval(AT_HWCAP);
+
+                result = (((capabilities & HWCAP_AES) != 0) && ((capabilities & HWCAP_PMULL) != 0));
+#else
+                // Built for a CPU that has them.
+                result = true;
+#endif
+#endif
+
+                return (result);
+            }
+
+            class Selection {
+            public:
+                Selection(const Selection&) = delete;
+                Selection& operator=(const Selection&) = delete;
+
+            private:
+                Selection()
+                    : _supported(Supported())
+                    , _selected(ACCELERATION_NONE)
+                    , _counter(&CounterPortable)
+                    , _ghash(&GHashPortable)
+                {
+                    Select(ACCELERATION_AES);
+                }
+
+            public:
+                static Selection& Instance()
+                {
+                    static Selection singleton;
+
+                    return (singleton);
+                }
+
+                uint8_t Selected() const
+                {
+                    return (_selected.load(std::memory_order_relaxed));
+                }
+                uint8_t Select(const uint8_t allowed)
+                {
+                    const uint8_t selected = ((_supported == true) ? (allowed & ACCELERATION_AES) : ACCELERATION_NONE);
+
+                    _counter.store(&CounterPortable, std::memory_order_relaxed);
+                    _ghash.store(&GHashPortable, std::memory_order_relaxed);
+
+                    if (selected != ACCELERATION_NONE) {
+#if defined(__CRYPTALGO_AES_NI__)
+                        _counter.store(&CounterNI, std::memory_order_relaxed);
+                        _ghash.store(&GHashCLMUL, std::memory_order_relaxed);
+#elif defined(__CRYPTALGO_AES_ARMV8__)
+                        _counter.store(&CounterARMv8, std::memory_order_relaxed);
+                        _ghash.store(&GHashPMULL, std::memory_order_relaxed);
+#endif
+                    }
+
+                    _selected.store(selected, std::memory_order_relaxed);
+
+                    return (selected);
+                }
+                Counter AESCounter() const
+                {
+                    return (_counter.load(std::memory_order_relaxed));
+                }
+                GHash AESGHash() const
+                {
+                    return (_ghash.load(std::memory_order_relaxed));
+                }
+
+            private:
+                const bool _supported;
+                std::atomic<uint8_t> _selected;
+                std::atomic<Counter> _counter;
+                std::atomic<GHash> _ghash;
+            };
+
+        }
+
+        void GHashKey(GCMContext& key, const uint8_t h[16])
+        {
+            uint64_t high = (static_cast<uint64_t>(BigEndian(&h[0])) << 32) | BigEndian(&h[4]);
+            uint64_t low = (static_cast<uint64_t>(BigEndian(&h[8])) << 32) | BigEndian(&h[12]);
+
+            // The bits are reflected: 8 is the 1 of GF(2^128), 4, 2 and 1 are H times x, x^2 and x^3, the
+            // others are sums of those.
+            key.table[0][0] = 0;
+            key.table[1][0] = 0;
+            key.table[0][8] = high;
+            key.table[1][8] = low;
+
+            for (uint8_t index = 4; index > 0; index >>= 1) {
+                const uint64_t reduction = (low & 1) * 0xe100000000000000ULL;
+
+                low = (high << 63) | (low >> 1);
+                high = (high >> 1) ^ reduction;
+                key.table[0][index] = high;
+                key.table[1][index] = low;
+            }
+            for (uint8_t index = 2; index <= 8; index <<= 1) {
+                for (uint8_t sum = 1; sum < index; sum++) {
+                    key.table[0][index + sum] = key.table[0][index] ^ key.table[0][sum];
+                    key.table[1][index + sum] = key.table[1][index] ^ key.table[1][sum];
+                }
+            }
+
+            // H^1 up to H^8 for the CPU implementations, with the bytes reversed, the way they are loaded.
+            uint8_t power[16];
+            ::memcpy(power, h, sizeof(power));
+
+            for (uint8_t index = 0; index < 8; index++) {
+                for (uint8_t offset = 0; offset < 16; offset++) {
+                    key.powers[index][offset] = power[15 - offset];
+                }
+
+                Multiply(power, key);
+            }
+        }
+
+        Counter AESCounter()
+        {
+            return (Selection::Instance().AESCounter());
+        }
+        GHash AESGHash()
+        {
+            return (Selection::Instance().AESGHash());
+        }
+        uint8_t Ciphers()
+        {
+            return (Selection::Instance().Selected());
+        }
+        uint8_t Ciphers(const uint8_t allowed)
+        {
+            return (Selection::Instance().Select(allowed));
+        }
+
+    } // namespace Crypto::Kernels
+}
+} // namespace WPEFramework::Crypto
@@ -0,0 +1,60 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __AESACCELERATION_H
+#define __AESACCELERATION_H
+
+// ---- Include system wide include files ----
+
+// ---- Include local include files ----
+#include "AES.h"
+#include "Module.h"
+
+// ---- Referenced classes and types ----
+
+// ---- Helper types and constants ----
+
+// ---- Helper functions ----
+namespace WPEFramework {
+namespace Crypto {
+    namespace Kernels {
+
+        // Encrypts a number of consecutive counter blocks and XORs them over the input. The last 4 bytes of the
+        // counter block are a big endian number that goes up by one for every block, the rest stays as it is.
+        typedef void (*Counter)(const mbedtls_aes_context& context, uint8_t counter[16], const uint8_t input[], uint8_t output[], const uint32_t blocks);
+
+        // Folds a number of consecutive blocks of 16 bytes into the GHASH of AES_GCM.
+        typedef void (*GHash)(uint8_t hash[16], const GCMContext& key, const uint8_t data[], const uint32_t blocks);
+
+        // Fills in the GHASH key, from H, the encrypted block of zeroes, for all the implementations.
+        void GHashKey(GCMContext& key, const uint8_t h[16]);
+
+        // The ones in use, see Crypto::Acceleration() to pick them.
+        Counter AESCounter();
+        GHash AESGHash();
+
+        // Picks the AES implementations, ACCELERATION_AES if the CPU ones are allowed and there.
+        uint8_t Ciphers();
+        uint8_t Ciphers(const uint8_t allowed);
+
+    } // namespace Crypto::Kernels
+}
+} // namespace WPEFramework::Crypto
+
+#endif // __AESACCELERATION_H
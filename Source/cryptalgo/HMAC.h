@@ -36,6 +36,12 @@ namespace Crypto {
     template <typename HASHALGORITHM>
     class HMACType {
     public:
+        // The state of the hash after the inner and after the outer key pad, so a MAC does not hash the key.
+        struct KeyContext {
+            typename HASHALGORITHM::Context Inner;
+            typename HASHALGORITHM::Context Outer;
+        };
+
         HMACType(const HMACType&) = delete;
         HMACType& operator=(const HMACType&) = delete;
 
@@ -45,6 +51,9 @@ namespace Crypto {
         HMACType(const string& key) : _algorithm() {
             Key(key);
         }
+        HMACType(const KeyContext& key) : _key(key), _algorithm() {
+            Reset();
+        }
        ~HMACType() = default;
 
     public:
@@ -52,11 +61,19 @@ namespace Crypto {
         static const uint8_t Length = HASHALGORITHM::Length;
 
         void Key(const string& key) {
+            Prepare(key, _key);
+
+            // Reset the algorithm. We start from scratch..
+            Reset();
+        }
+        static void Prepare(const string& key, KeyContext& context) {
             uint8_t keyLength;
             const uint8_t* encryptionKey;
+            uint8_t innerKeyPad[64];
+            uint8_t outerKeyPad[64];
             HASHALGORITHM hashKey;
 
-            if (key.length() > sizeof(_innerKeyPad)) {
+            if (key.length() > sizeof(innerKeyPad)) {
                 keyLength = HASHALGORITHM::Length;
 
                 // Calculate the Hash over the key to use that i.s.o. the actual key.
@@ -70,26 +87,33 @@ namespace Crypto {
             }
 
             // We have a suitable key, move it to the inner and outer pads
-            ::memset(&_innerKeyPad[keyLength], 0x36, sizeof(_innerKeyPad) - keyLength);
-            ::memset(&_outerKeyPad[keyLength], 0x5C, sizeof(_outerKeyPad) - keyLength);
+            ::memset(&innerKeyPad[keyLength], 0x36, sizeof(innerKeyPad) - keyLength);
+            ::memset(&outerKeyPad[keyLength], 0x5C, sizeof(outerKeyPad) - keyLength);
 
             /* XOR key with inner keypad and outer key pad values */
             for (uint8_t index = 0; index < keyLength; index++) {
-                _innerKeyPad[index] = encryptionKey[index] ^ 0x36;
-                _outerKeyPad[index] = encryptionKey[index] ^ 0x5c;
+                innerKeyPad[index] = encryptionKey[index] ^ 0x36;
+                outerKeyPad[index] = encryptionKey[index] ^ 0x5c;
             }
 
-            // Reset the algorithm. We start from scratch..
-            Reset();
+            // Hash the pads once, every MAC continues from there.
+            HASHALGORITHM pad;
+
+            pad.Input(innerKeyPad, sizeof(innerKeyPad));
+            context.Inner = pad.CurrentContext();
+
+            pad.Reset();
+            pad.Input(outerKeyPad, sizeof(outerKeyPad));
+            context.Outer = pad.CurrentContext();
         }
         inline static uint8_t BlockLength()
         {
-            return (sizeof(_innerKeyPad));
+            return (64);
         }
         void Reset()
         {
             _algorithm.Reset();
-            _algorithm.Input(_innerKeyPad, sizeof(_innerKeyPad));
+            _algorithm.Load(_key.Inner);
             _computed = false;
         }
         const uint8_t* Result()
@@ -103,7 +127,7 @@ namespace Crypto {
 
                 // Now use the newly generated key to calulate the outer value..
                 _algorithm.Reset();
-                _algorithm.Input(_outerKeyPad, sizeof(_outerKeyPad));
+                _algorithm.Load(_key.Outer);
                 _algorithm.Input(hashKey, sizeof(hashKey));
             }
 
@@ -140,8 +164,7 @@ namespace Crypto {
 
     private:
         bool _computed;
-        uint8_t _innerKeyPad[64];
-        uint8_t _outerKeyPad[64];
+        KeyContext _key;
         HASHALGORITHM _algorithm;
     };
 
@@ -49,6 +49,7 @@
         */
 
 #include "Hash.h"
+#include "HashAcceleration.h"
 
 #ifdef __LINUX__
 #include <arpa/inet.h>
@@ -125,11 +126,6 @@
 #define CH(x, y, z) ((x & y) ^ (~x & z))
 #define MAJ(x, y, z) ((x & y) ^ (x & z) ^ (y & z))
 
-#define SHA256_F1(x) (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
-#define SHA256_F2(x) (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
-#define SHA256_F3(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ SHFR(x, 3))
-#define SHA256_F4(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ SHFR(x, 10))
-
 #define SHA512_F1(x) (ROTR(x, 28) ^ ROTR(x, 34) ^ ROTR(x, 39))
 #define SHA512_F2(x) (ROTR(x, 14) ^ ROTR(x, 18) ^ ROTR(x, 41))
 #define SHA512_F3(x) (ROTR(x, 1) ^ ROTR(x, 8) ^ SHFR(x, 7))
@@ -177,27 +173,12 @@
 
 /* Macros used for loops unrolling */
 
-#define SHA256_SCR(i)                           \
-    {                                           \
-        w[i] = SHA256_F4(w[i - 2]) + w[i - 7]   \
-            + SHA256_F3(w[i - 15]) + w[i - 16]; \
-    }
-
 #define SHA512_SCR(i)                           \
     {                                           \
         w[i] = SHA512_F4(w[i - 2]) + w[i - 7]   \
             + SHA512_F3(w[i - 15]) + w[i - 16]; \
     }
 
-#define SHA256_EXP(a, b, c, d, e, f, g, h, j)                   \
-    {                                                           \
-        t1 = wv[h] + SHA256_F2(wv[e]) + CH(wv[e], wv[f], wv[g]) \
-            + sha256_k[j] + w[j];                               \
-        t2 = SHA256_F1(wv[a]) + MAJ(wv[a], wv[b], wv[c]);       \
-        wv[d] += t1;                                            \
-        wv[h] = t1 + t2;                                        \
-    }
-
 #define SHA512_EXP(a, b, c, d, e, f, g, h, j)                   \
     {                                                           \
         t1 = wv[h] + SHA512_F2(wv[e]) + CH(wv[e], wv[f], wv[g]) \
@@ -499,6 +480,87 @@ namespace Crypto {
         return *this;
     }
 
+    // --------------------------------------------------------------------------------------------
+    // SHA1/SHA224/SHA256 block handling
+    // --------------------------------------------------------------------------------------------
+    // Adds the data to the block of the context and runs the compression function over every block that is
+    // complete, straight from the data for those that are complete in there. Returns the number of blocks.
+    static uint32_t Absorb(Context& context, const uint8_t data[], const uint32_t length, const Kernels::Compression compression, const uint8_t words)
+    {
+        uint32_t state[8];
+        uint32_t offset = 0;
+        uint32_t result = 0;
+
+        for (uint8_t index = 0; index < words; index++) {
+            state[index] = static_cast<uint32_t>(context.h[index]);
+        }
+
+        if (context.index != 0) {
+            offset = std::min(length, (64 - context.index));
+
+            ::memcpy(&(context.block[context.index]), data, offset);
+            context.index += offset;
+
+            if (context.index == 64) {
+                compression(state, context.block, 1);
+                context.index = 0;
+                result = 1;
+            }
+        }
+
+        if (context.index == 0) {
+            const uint32_t blocks = ((length - offset) / 64);
+
+            if (blocks != 0) {
+                compression(state, &(data[offset]), blocks);
+                offset += (blocks * 64);
+                result += blocks;
+            }
+
+            context.index = (length - offset);
+            ::memcpy(context.block, &(data[offset]), context.index);
+        }
+
+        if (result != 0) {
+            for (uint8_t index = 0; index < words; index++) {
+                context.h[index] = state[index];
+            }
+        }
+
+        return (result);
+    }
+
+    // Pads the block of the context, with the message length in bits at the end, hashes it and leaves the
+    // first digestWords words of the state, big endian, at the start of the block.
+    static void Finish(Context& context, const uint64_t bits, const Kernels::Compression compression, const uint8_t words, const uint8_t digestWords)
+    {
+        uint32_t state[8];
+
+        for (uint8_t index = 0; index < words; index++) {
+            state[index] = static_cast<uint32_t>(context.h[index]);
+        }
+
+        context.block[context.index++] = 0x80;
+
+        if (context.index > 56) {
+            ::memset(&(context.block[context.index]), 0, (64 - context.index));
+            compression(state, context.block, 1);
+            context.index = 0;
+        }
+
+        ::memset(&(context.block[context.index]), 0, (56 - context.index));
+        UNPACK64(bits, &(context.block[56]));
+
+        compression(state, context.block, 1);
+
+        for (uint8_t index = 0; index < words; index++) {
+            context.h[index] = state[index];
+        }
+        for (uint8_t index = 0; index < digestWords; index++) {
+            UNPACK32(state[index], &(context.block[index * 4]));
+        }
+    }
+
     // --------------------------------------------------------------------------------------------
     // SHA1 functionality
     // --------------------------------------------------------------------------------------------
@@ -522,41 +584,14 @@ namespace Crypto {
      */
     void SHA1::Input(const uint8_t message_array[], const uint16_t length)
     {
-        uint16_t counter = length;
-        const uint8_t* current = &(message_array[0]);
-
-        /*
-         * Split lenght to lower and higher portion
-         */
-        uint32_t lengthLow = static_cast<uint32_t>(_context.length & 0xFFFFFFFF);
-        uint32_t lengthHigh = reinterpret_cast<uint32_t*>(&_context.length)[1];
-
         ASSERT((_computed == false) || (_corrupted == false));
 
-        while (counter-- && !_corrupted) {
-            _context.block[_context.index++] = *current;
-
-            lengthLow++;
-            if (lengthLow == 0x20000000) {
-                lengthLow = 0;
-                lengthHigh++;
-                if (lengthHigh == 0) {
-                    _corrupted = true; // Message is too long
-                }
-            }
+        if (_corrupted == false) {
+            Absorb(_context, message_array, length, Kernels::SHA1(), 5);
 
-            if (_context.index == 64) {
-                ProcessMessageBlock();
-                _context.index = 0;
-            }
-
-            current++;
+            // The length counts all bytes, also those still in the block.
+            _context.length += length;
         }
-
-        /*
-         * Combine lower and higher portion of length to single field
-         */
-        _context.length = (static_cast<uint64_t>(lengthHigh) << 32 | lengthLow);
     }
 
     /*
@@ -613,105 +648,6 @@ namespace Crypto {
         return *this;
     }
 
-    /*
-     *  ProcessMessageBlock
-     *
-     *  Description:
-     *      This function will process the next 512 bits of the message
-     *      stored in the _block array.
-     *
-     *  Parameters:
-     *      None.
-     *
-     *  Returns:
-     *      Nothing.
-     *
-     *  Comments:
-     *      Many of the variable names in this function, especially the single
-     *      character names, were used because those were the names used
-     *      in the publication.
-     *
-     */
-    void SHA1::ProcessMessageBlock()
-    {
-        const unsigned K[] = { // Constants defined for SHA-1
-            0x5A827999,
-            0x6ED9EBA1,
-            0x8F1BBCDC,
-            0xCA62C1D6
-        };
-        int t; // Loop counter
-        unsigned temp; // Temporary word value
-        unsigned W[80]; // Word sequence
-        unsigned A, B, C, D, E; // Word buffers
-
-        /*
-         *  Initialize the first 16 words in the array W
-         */
-        for (t = 0; t < 16; t++) {
-            W[t] = ((unsigned)_context.block[t * 4]) << 24;
-            W[t] |= ((unsigned)_context.block[t * 4 + 1]) << 16;
-            W[t] |= ((unsigned)_context.block[t * 4 + 2]) << 8;
-            W[t] |= ((unsigned)_context.block[t * 4 + 3]);
-        }
-
-        for (t = 16; t < 80; t++) {
-            W[t] = CircularShift(1, W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16]);
-        }
-
-        A = static_cast<unsigned int>(_context.h[0]);
-        B = static_cast<unsigned int>(_context.h[1]);
-        C = static_cast<unsigned int>(_context.h[2]);
-        D = static_cast<unsigned int>(_context.h[3]);
-        E = static_cast<unsigned int>(_context.h[4]);
-
-        for (t = 0; t < 20; t++) {
-            temp = CircularShift(5, A) + ((B & C) | ((~B) & D)) + E + W[t] + K[0];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
-
-        for (t = 20; t < 40; t++) {
-            temp = CircularShift(5, A) + (B ^ C ^ D) + E + W[t] + K[1];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
-
-        for (t = 40; t < 60; t++) {
-            temp = CircularShift(5, A) + ((B & C) | (B & D) | (C & D)) + E + W[t] + K[2];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
-
-        for (t = 60; t < 80; t++) {
-            temp = CircularShift(5, A) + (B ^ C ^ D) + E + W[t] + K[3];
-            temp &= 0xFFFFFFFF;
-            E = D;
-            D = C;
-            C = CircularShift(30, B);
-            B = A;
-            A = temp;
-        }
-
-        _context.h[0] = (_context.h[0] + A) & 0xFFFFFFFF;
-        _context.h[1] = (_context.h[1] + B) & 0xFFFFFFFF;
-        _context.h[2] = (_context.h[2] + C) & 0xFFFFFFFF;
-        _context.h[3] = (_context.h[3] + D) & 0xFFFFFFFF;
-        _context.h[4] = (_context.h[4] + E) & 0xFFFFFFFF;
-    }
-
     /*
      *  PadMessage
      *
@@ -721,8 +657,8 @@ namespace Crypto {
      *      represent the length of the original message.  All bits in between
      *      should be 0.  This function will pad the message according to those
      *      rules by filling the message_block array accordingly.  It will also
-     *      call ProcessMessageBlock() appropriately.  When it returns, it
-     *      can be assumed that the message digest has been computed.
+     *      hash the padded block(s).  When it returns, it can be assumed that
+     *      the message digest has been computed.
      *
      *  Parameters:
      *      None.
@@ -735,50 +671,7 @@ namespace Crypto {
      */
     void SHA1::PadMessage()
     {
-        /*
-         *  Check to see if the current message block is too small to hold
-         *  the initial padding bits and length.  If so, we will pad the
-         *  block, process it, and then continue padding into a second block.
-         */
-        if (_context.index > 55) {
-            _context.block[_context.index++] = 0x80;
-
-            ::memset(&(_context.block[_context.index]), 0, (64 - _context.index));
-
-            ProcessMessageBlock();
-
-            _context.index = 0;
-        } else {
-            _context.block[_context.index++] = 0x80;
-        }
-
-        ::memset(&(_context.block[_context.index]), 0, (56 - _context.index));
-
-        /*
-         * Split lenght to lower and higher portion
-         */
-        uint32_t lengthLow = static_cast<uint32_t>(_context.length & 0xFFFFFFFF);
-        uint32_t lengthHigh = reinterpret_cast<uint32_t*>(&_context.length)[1];
-
-        /*
-         *  Store the message length as the last 8 octets
-         */
-        _context.block[56] = (lengthHigh >> 24) & 0xFF;
-        _context.block[57] = (lengthHigh >> 16) & 0xFF;
-        _context.block[58] = (lengthHigh >> 8) & 0xFF;
-        _context.block[59] = (lengthHigh)&0xFF;
-        _context.block[60] = (lengthLow >> 21) & 0xFF;
-        _context.block[61] = (lengthLow >> 13) & 0xFF;
-        _context.block[62] = (lengthLow >> 5) & 0xFF;
-        _context.block[63] = (lengthLow << 3) & 0xFF;
-
-        ProcessMessageBlock();
-
-        uint32_t* writer = reinterpret_cast<uint32_t*>(&_context.block[0]);
-
-        for (uint8_t teller = 0; teller < 5; teller++) {
-            *writer++ = htonl(static_cast<uint32_t>(_context.h[teller]));
-        }
+        Finish(_context, (_context.length << 3), Kernels::SHA1(), 5, 5);
 
         _computed = true;
     }
@@ -810,25 +703,6 @@ namespace Crypto {
         0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
     };
 
-    static uint32_t sha256_k[64] = {
-        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
-        0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
-        0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
-        0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
-        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
-        0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
-        0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
-        0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
-        0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-    };
-
     static uint64_t sha512_k[80] = {
         0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL,
         0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
@@ -875,246 +749,6 @@ namespace Crypto {
     // --------------------------------------------------------------------------------------------
     // SHA256 functionality
     // --------------------------------------------------------------------------------------------
-    static void sha256_trans_block(SHA256::Context* ctx, const unsigned char* message, unsigned int block_nb)
-    {
-        uint32_t w[64];
-        uint32_t wv[8];
-        uint32_t t1, t2;
-        const unsigned char* sub_block;
-        int i;
-
-#ifndef UNROLL_LOOPS
-        int j;
-#endif
-
-        for (i = 0; i < (int)block_nb; i++) {
-            sub_block = message + (i << 6);
-
-#ifndef UNROLL_LOOPS
-            for (j = 0; j < 16; j++) {
-                PACK32(&sub_block[j << 2], &w[j]);
-            }
-
-            for (j = 16; j < 64; j++) {
-                SHA256_SCR(j);
-            }
-
-            for (j = 0; j < 8; j++) {
-                wv[j] = static_cast<uint32_t>(ctx->h[j]);
-            }
-
-            for (j = 0; j < 64; j++) {
-                t1 = wv[7] + SHA256_F2(wv[4]) + CH(wv[4], wv[5], wv[6])
-                    + sha256_k[j] + w[j];
-                t2 = SHA256_F1(wv[0]) + MAJ(wv[0], wv[1], wv[2]);
-                wv[7] = wv[6];
-                wv[6] = wv[5];
-                wv[5] = wv[4];
-                wv[4] = wv[3] + t1;
-                wv[3] = wv[2];
-                wv[2] = wv[1];
-                wv[1] = wv[0];
-                wv[0] = t1 + t2;
-            }
-
-            for (j = 0; j < 8; j++) {
-                ctx->h[j] += wv[j];
-            }
-#else
-            PACK32(&sub_block[0], &w[0]);
-            PACK32(&sub_block[4], &w[1]);
-            PACK32(&sub_block[8], &w[2]);
-            PACK32(&sub_block[12], &w[3]);
-            PACK32(&sub_block[16], &w[4]);
-            PACK32(&sub_block[20], &w[5]);
-            PACK32(&sub_block[24], &w[6]);
-            PACK32(&sub_block[28], &w[7]);
-            PACK32(&sub_block[32], &w[8]);
-            PACK32(&sub_block[36], &w[9]);
-            PACK32(&sub_block[40], &w[10]);
-            PACK32(&sub_block[44], &w[11]);
-            PACK32(&sub_block[48], &w[12]);
-            PACK32(&sub_block[52], &w[13]);
-            PACK32(&sub_block[56], &w[14]);
-            PACK32(&sub_block[60], &w[15]);
-
-            SHA256_SCR(16);
-            SHA256_SCR(17);
-            SHA256_SCR(18);
-            SHA256_SCR(19);
-            SHA256_SCR(20);
-            SHA256_SCR(21);
-            SHA256_SCR(22);
-            SHA256_SCR(23);
-            SHA256_SCR(24);
-            SHA256_SCR(25);
-            SHA256_SCR(26);
-            SHA256_SCR(27);
-            SHA256_SCR(28);
-            SHA256_SCR(29);
-            SHA256_SCR(30);
-            SHA256_SCR(31);
-            SHA256_SCR(32);
-            SHA256_SCR(33);
-            SHA256_SCR(34);
-            SHA256_SCR(35);
-            SHA256_SCR(36);
-            SHA256_SCR(37);
-            SHA256_SCR(38);
-            SHA256_SCR(39);
-            SHA256_SCR(40);
-            SHA256_SCR(41);
-            SHA256_SCR(42);
-            SHA256_SCR(43);
-            SHA256_SCR(44);
-            SHA256_SCR(45);
-            SHA256_SCR(46);
-            SHA256_SCR(47);
-            SHA256_SCR(48);
-            SHA256_SCR(49);
-            SHA256_SCR(50);
-            SHA256_SCR(51);
-            SHA256_SCR(52);
-            SHA256_SCR(53);
-            SHA256_SCR(54);
-            SHA256_SCR(55);
-            SHA256_SCR(56);
-            SHA256_SCR(57);
-            SHA256_SCR(58);
-            SHA256_SCR(59);
-            SHA256_SCR(60);
-            SHA256_SCR(61);
-            SHA256_SCR(62);
-            SHA256_SCR(63);
-
-            wv[0] = ctx->h[0];
-            wv[1] = ctx->h[1];
-            wv[2] = ctx->h[2];
-            wv[3] = ctx->h[3];
-            wv[4] = ctx->h[4];
-            wv[5] = ctx->h[5];
-            wv[6] = ctx->h[6];
-            wv[7] = ctx->h[7];
-
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 0);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 1);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 2);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 3);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 4);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 5);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 6);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 7);
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 8);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 9);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 10);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 11);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 12);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 13);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 14);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 15);
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 16);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 17);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 18);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 19);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 20);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 21);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 22);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 23);
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 24);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 25);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 26);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 27);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 28);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 29);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 30);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 31);
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 32);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 33);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 34);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 35);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 36);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 37);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 38);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 39);
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 40);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 41);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 42);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 43);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 44);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 45);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 46);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 47);
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 48);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 49);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 50);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 51);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 52);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 53);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 54);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 55);
-            SHA256_EXP(0, 1, 2, 3, 4, 5, 6, 7, 56);
-            SHA256_EXP(7, 0, 1, 2, 3, 4, 5, 6, 57);
-            SHA256_EXP(6, 7, 0, 1, 2, 3, 4, 5, 58);
-            SHA256_EXP(5, 6, 7, 0, 1, 2, 3, 4, 59);
-            SHA256_EXP(4, 5, 6, 7, 0, 1, 2, 3, 60);
-            SHA256_EXP(3, 4, 5, 6, 7, 0, 1, 2, 61);
-            SHA256_EXP(2, 3, 4, 5, 6, 7, 0, 1, 62);
-            SHA256_EXP(1, 2, 3, 4, 5, 6, 7, 0, 63);
-
-            ctx->h[0] += wv[0];
-            ctx->h[1] += wv[1];
-            ctx->h[2] += wv[2];
-            ctx->h[3] += wv[3];
-            ctx->h[4] += wv[4];
-            ctx->h[5] += wv[5];
-            ctx->h[6] += wv[6];
-            ctx->h[7] += wv[7];
-#endif /* !UNROLL_LOOPS */
-        }
-    }
-
-    static void sha256_trans(SHA256::Context* ctx, const unsigned char* message)
-    {
-       uint32_t a, b, c, d, e, f, g, h, i, j, t1, t2, m[64];
-        for (i = 0, j = 0; i < 16; ++i, j += 4) {
-             PACK32(&message[i << 2], &m[i]);
-        }
-        for ( ; i < 64; ++i) {
-                m[i] = SHA256_F4(m[i - 2]) + m[i - 7] + SHA256_F3(m[i - 15]) + m[i - 16];
-        }
-
-        a = static_cast<uint32_t>(ctx->h[0]);
-        b = static_cast<uint32_t>(ctx->h[1]);
-        c = static_cast<uint32_t>(ctx->h[2]);
-        d = static_cast<uint32_t>(ctx->h[3]);
-        e = static_cast<uint32_t>(ctx->h[4]);
-        f = static_cast<uint32_t>(ctx->h[5]);
-        g = static_cast<uint32_t>(ctx->h[6]);
-        h = static_cast<uint32_t>(ctx->h[7]);
-
-        for (i = 0; i < 64; ++i) {
-            t1 = h + SHA256_F2(e) + CH(e,f,g) + sha256_k[i] + m[i];
-            t2 = SHA256_F1(a) + MAJ(a,b,c);
-            h = g;
-            g = f;
-            f = e;
-            e = d + t1;
-            d = c;
-            c = b;
-            b = a;
-            a = t1 + t2;
-        }
-
-        ctx->h[0] += a;
-        ctx->h[1] += b;
-        ctx->h[2] += c;
-        ctx->h[3] += d;
-        ctx->h[4] += e;
-        ctx->h[5] += f;
-        ctx->h[6] += g;
-        ctx->h[7] += h;
-    }
-
     void SHA256::Reset()
     {
 #ifndef UNROLL_LOOPS
@@ -1138,81 +772,15 @@ namespace Crypto {
         _computed = false;
     }
 
-    static void sha256_update(SHA256::Context* ctx, const unsigned char* message, unsigned int len)
-    {
-        uint32_t i;
-
-        for (i = 0; i < len; ++i) {
-            ctx->block[ctx->index] = message[i];
-            ctx->index++;
-            if (ctx->index == 64) {
-                sha256_trans(ctx, ctx->block);
-                ctx->length += 512;
-                ctx->index = 0;
-            }
-        }
-    }
-
     void SHA256::CloseContext()
     {
-        uint32_t i = _context.index;
-
-        // Pad whatever block is left in the buffer.
-        if (_context.index < 56) {
-            _context.block[i++] = 0x80;
-            while (i < 56) {
-               _context.block[i++] = 0x00;
-            }
-        } else {
-            _context.block[i++] = 0x80;
-            while (i < 64) {
-                _context.block[i++] = 0x00;
-            }
-            sha256_trans(&_context, _context.block);
-            memset(_context.block, 0, 56);
-        }
-
-        // Append to the padding the total message's length in bits and transform.
-        _context.length += _context.index * 8;
-        _context.block[63] = static_cast<uint8_t>((_context.length) & 0xFF);
-        _context.block[62] = static_cast<uint8_t>((_context.length >> 8) & 0xFF);
-        _context.block[61] = static_cast<uint8_t>((_context.length >> 16) & 0xFF);
-        _context.block[60] = static_cast<uint8_t>((_context.length >> 24) & 0xFF);
-        _context.block[59] = static_cast<uint8_t>((_context.length >> 32) & 0xFF);
-        _context.block[58] = static_cast<uint8_t>((_context.length >> 40) & 0xFF);
-        _context.block[57] = static_cast<uint8_t>((_context.length >> 48) & 0xFF);
-        _context.block[56] = static_cast<uint8_t>((_context.length >> 56) & 0xFF);
-        sha256_trans(&_context, _context.block);
-
-        // Since this implementation uses little endian byte ordering and SHA uses big endian,
-        // reverse all the bytes when copying the final h to the output hash.
-        for (i = 0; i < 4; ++i) {
-            _context.block[i]      = (_context.h[0] >> (24 - i * 8)) & 0x000000ff;
-            _context.block[i + 4]  = (_context.h[1] >> (24 - i * 8)) & 0x000000ff;
-            _context.block[i + 8]  = (_context.h[2] >> (24 - i * 8)) & 0x000000ff;
-            _context.block[i + 12] = (_context.h[3] >> (24 - i * 8)) & 0x000000ff;
-            _context.block[i + 16] = (_context.h[4] >> (24 - i * 8)) & 0x000000ff;
-            _context.block[i + 20] = (_context.h[5] >> (24 - i * 8)) & 0x000000ff;
-            _context.block[i + 24] = (_context.h[6] >> (24 - i * 8)) & 0x000000ff;
-            _context.block[i + 28] = (_context.h[7] >> (24 - i * 8)) & 0x000000ff;
-        }
+        Finish(_context, (_context.length + (_context.index * 8)), Kernels::SHA256(), 8, 8);
     }
 
     void SHA256::Input(const uint8_t message_array[], const uint16_t length)
     {
-        uint16_t sizeToHandle = length;
-        const uint8_t* source = &message_array[0];
-
-        while (sizeToHandle > 0) {
-            if (sizeToHandle > SHA256_BLOCK_SIZE) {
-                sha256_update(&_context, source, SHA256_BLOCK_SIZE);
-                source += SHA256_BLOCK_SIZE;
-                sizeToHandle -= SHA256_BLOCK_SIZE;
-            } else {
-                sha256_update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
-        }
+        // The length counts the bits of the blocks that are hashed.
+        _context.length += (static_cast<uint64_t>(Absorb(_context, message_array, length, Kernels::SHA256(), 8)) << 9);
     }
 
     /*
@@ -1270,6 +838,95 @@ namespace Crypto {
         return *this;
     }
 
+    // Hashes up to 8 messages, one in each lane. The lanes that are left over, hash the first message again.
+    static void Interleave(const Kernels::Interleaved interleaved, const uint8_t count, const uint8_t* const messages[], const uint16_t lengths[], uint8_t digests[])
+    {
+        uint32_t state[8][8];
+        uint8_t tails[8][2 * SHA256_BLOCK_SIZE];
+        const uint8_t* data[8];
+        const uint8_t* blocks[8];
+        uint32_t full[8];
+        uint32_t total[8];
+        uint32_t rounds = 0;
+
+        for (uint8_t lane = 0; lane < 8; lane++) {
+            const uint8_t source = (lane < count ? lane : 0);
+            const uint16_t length = lengths[source];
+            const uint32_t remainder = (length % SHA256_BLOCK_SIZE);
+            const uint32_t tail = (remainder < (SHA256_BLOCK_SIZE - 8) ? SHA256_BLOCK_SIZE : (2 * SHA256_BLOCK_SIZE));
+
+            data[lane] = messages[source];
+            full[lane] = (length / SHA256_BLOCK_SIZE);
+            total[lane] = full[lane] + (tail / SHA256_BLOCK_SIZE);
+            rounds = std::max(rounds, total[lane]);
+
+            // The end of the message with the padding, so the blocks can be taken as they are.
+            ::memcpy(tails[lane], &(data[lane][full[lane] * SHA256_BLOCK_SIZE]), remainder);
+            tails[lane][remainder] = 0x80;
+            ::memset(&(tails[lane][remainder + 1]), 0, (tail - remainder - 1 - 8));
+            UNPACK64(static_cast<uint64_t>(length) << 3, &(tails[lane][tail - 8]));
+
+            for (uint8_t word = 0; word < 8; word++) {
+                state[word][lane] = sha256_h0[word];
+            }
+        }
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            for (uint8_t lane = 0; lane < 8; lane++) {
+                if (round < full[lane]) {
+                    blocks[lane] = &(data[lane][round * SHA256_BLOCK_SIZE]);
+                } else if (round < total[lane]) {
+                    blocks[lane] = &(tails[lane][(round - full[lane]) * SHA256_BLOCK_SIZE]);
+                } else {
+                    // Done, whatever it hashes is not used.
+                    blocks[lane] = tails[lane];
+                }
+            }
+
+            interleaved(state, blocks);
+
+            for (uint8_t lane = 0; lane < count; lane++) {
+                if ((round + 1) == total[lane]) {
+                    for (uint8_t word = 0; word < 8; word++) {
+                        UNPACK32(state[word][lane], &(digests[(lane * SHA256::Length) + (word * 4)]));
+                    }
+                }
+            }
+        }
+    }
+
+    /* static */ void SHA256::Batch(const uint16_t count, const uint8_t* const messages[], const uint16_t lengths[], uint8_t digests[])
+    {
+        const Kernels::Interleaved interleaved = Kernels::SHA256x8();
+
+        // The SHA instructions beat the lanes, but for messages that fit in a single block.
+        const uint16_t limit = ((Acceleration() & ACCELERATION_SHA) != 0 ? (SHA256_BLOCK_SIZE - 9) : 0xFFFF);
+        uint16_t index = 0;
+
+        while (index < count) {
+            const uint8_t size = static_cast<uint8_t>(std::min(count - index, 8));
+
+            // With fewer than 4 messages, too many lanes would be idle.
+            bool lanes = ((interleaved != nullptr) && (size >= 4));
+
+            for (uint8_t lane = 0; (lanes == true) && (lane < size); lane++) {
+                lanes = (lengths[index + lane] <= limit);
+            }
+
+            if (lanes == true) {
+                Interleave(interleaved, size, &(messages[index]), &(lengths[index]), &(digests[index * Length]));
+            } else {
+                for (uint8_t message = 0; message < size; message++) {
+                    SHA256 hash(messages[index + message], lengths[index + message]);
+
+                    ::memcpy(&(digests[(index + message) * Length]), hash.Result(), Length);
+                }
+            }
+
+            index += size;
+        }
+    }
+
     // --------------------------------------------------------------------------------------------
     // SHA224 functionality
     // --------------------------------------------------------------------------------------------
@@ -1296,90 +953,15 @@ namespace Crypto {
         _computed = false;
     }
 
-    static void sha224_update(SHA224::Context* ctx, const unsigned char* message, unsigned int len)
-    {
-        unsigned int block_nb;
-        unsigned int new_len, rem_len, tmp_len;
-        const unsigned char* shifted_message;
-
-        tmp_len = SHA224_BLOCK_SIZE - ctx->index;
-        rem_len = len < tmp_len ? len : tmp_len;
-
-        memcpy(&ctx->block[ctx->index], message, rem_len);
-
-        if (ctx->index + len < SHA224_BLOCK_SIZE) {
-            ctx->index += len;
-            return;
-        }
-
-        new_len = len - rem_len;
-        block_nb = new_len / SHA224_BLOCK_SIZE;
-
-        shifted_message = message + rem_len;
-
-        sha256_trans_block(ctx, ctx->block, 1);
-        sha256_trans_block(ctx, shifted_message, block_nb);
-
-        rem_len = new_len % SHA224_BLOCK_SIZE;
-
-        memcpy(ctx->block, &shifted_message[block_nb << 6],
-            rem_len);
-
-        ctx->index = rem_len;
-        ctx->length += (block_nb + 1) << 6;
-    }
-
     void SHA224::CloseContext()
     {
-        unsigned int block_nb;
-        unsigned int pm_len;
-        unsigned int len_b;
-
-#ifndef UNROLL_LOOPS
-        int i;
-#endif
-
-        block_nb = (1 + ((SHA224_BLOCK_SIZE - 9) < (_context.index % SHA224_BLOCK_SIZE)));
-
-        len_b = static_cast<unsigned int>((_context.length + _context.index) << 3);
-        pm_len = block_nb << 6;
-
-        memset(_context.block + _context.index, 0, pm_len - _context.index);
-        _context.block[_context.index] = 0x80;
-        UNPACK32(len_b, _context.block + pm_len - 4);
-
-        sha256_trans_block(&_context, _context.block, block_nb);
-
-#ifndef UNROLL_LOOPS
-        for (i = 0; i < 7; i++) {
-            UNPACK32(_context.h[i], &_context.block[i << 2]);
-        }
-#else
-        UNPACK32(_context.h[0], &_context.block[0]);
-        UNPACK32(_context.h[1], &_context.block[4]);
-        UNPACK32(_context.h[2], &_context.block[8]);
-        UNPACK32(_context.h[3], &_context.block[12]);
-        UNPACK32(_context.h[4], &_context.block[16]);
-        UNPACK32(_context.h[5], &_context.block[20]);
-        UNPACK32(_context.h[6], &_context.block[24]);
-#endif /* !UNROLL_LOOPS */
+        Finish(_context, ((_context.length + _context.index) << 3), Kernels::SHA256(), 8, 7);
     }
 
     void SHA224::Input(const uint8_t message_array[], const uint16_t length)
     {
-        uint16_t sizeToHandle = length;
-        const uint8_t* source = &message_array[0];
-
-        while (sizeToHandle > 0) {
-            if (sizeToHandle > SHA224_BLOCK_SIZE) {
-                sha224_update(&_context, source, SHA224_BLOCK_SIZE);
-                source += SHA224_BLOCK_SIZE;
-                sizeToHandle -= SHA224_BLOCK_SIZE;
-            } else {
-                sha224_update(&_context, source, sizeToHandle);
-                sizeToHandle = 0;
-            }
-        }
+        // The length counts the bytes of the blocks that are hashed.
+        _context.length += (static_cast<uint64_t>(Absorb(_context, message_array, length, Kernels::SHA256(), 8)) << 6);
     }
 
     /*
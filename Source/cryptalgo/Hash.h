@@ -90,6 +90,21 @@ namespace Crypto {
         HASH_SHA384 = 48,
         HASH_SHA512 = 64
     };
+
+    // SHA-1, SHA-224 and SHA-256 use the SHA instructions of the CPU, x86 SHA-NI or the ARMv8 crypto extensions,
+    // when it has them and SHA256::Batch() hashes 8 messages side by side with AVX2. AES_CTR and AES_GCM use
+    // AES-NI and PCLMULQDQ or the ARMv8 AES and PMULL instructions. All the CPU supports is used, unless
+    // Acceleration() narrows that down, e.g. to compare them. They all give the same results.
+    enum EnumAcceleration : uint8_t {
+        ACCELERATION_NONE = 0x00,
+        ACCELERATION_SHA = 0x01,
+        ACCELERATION_MULTIBUFFER = 0x02,
+        ACCELERATION_AES = 0x04
+    };
+
+    EXTERNAL uint8_t Acceleration();
+    EXTERNAL uint8_t Acceleration(const uint8_t allowed);
+
     typedef struct EXTERNAL Context {
         uint64_t length;
         uint64_t h[8];
@@ -256,39 +271,11 @@ namespace Crypto {
         SHA1& operator<<(const uint8_t message_element);
 
     private:
-        /*
-         *  Process the next 512 bits of the message
-         */
-        void ProcessMessageBlock();
-
         /*
          *  Pads the current message block to 512 bits
          */
         void PadMessage();
 
-        /*
-         *  CircularShift
-         *
-         *  Description:
-         *      This member function will perform a circular shifting operation.
-         *
-         *  Parameters:
-         *      bits: [in]
-         *          The number of bits to shift (1-31)
-         *      word: [in]
-         *          The value to shift (assumes a 32-bit integer)
-         *
-         *  Returns:
-         *      The shifted value.
-         *
-         *  Comments:
-         *
-         */
-        inline uint32_t CircularShift(const uint8_t bits, const uint32_t word)
-        {
-            return ((word << bits) & 0xFFFFFFFF) | ((word & 0xFFFFFFFF) >> (32 - bits));
-        }
-
         mutable bool _computed; // Is the digest computed?
         bool _corrupted; // Is the message digest corruped?
 
@@ -353,6 +340,11 @@ namespace Crypto {
         SHA256& operator<<(const uint8_t message_array[]);
         SHA256& operator<<(const uint8_t message_element);
 
+        /*
+         *  Hashes count messages, the digest of message n goes to digests[n * Length]
+         */
+        static void Batch(const uint16_t count, const uint8_t* const messages[], const uint16_t lengths[], uint8_t digests[]);
+
     private:
         void CloseContext();
 
@@ -0,0 +1,576 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HashAcceleration.h"
+#include "AESAcceleration.h"
+#include "Hash.h"
+
+#include <atomic>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __CRYPTALGO_SHA_NI__
+#define __CRYPTALGO_SHA_AVX2__
+#include <cpuid.h>
+#include <immintrin.h>
+#elif (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2)) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define __CRYPTALGO_SHA_ARMV8__
+#include <arm_neon.h>
+#if defined(__LINUX__) && defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace WPEFramework {
+namespace Crypto {
+    namespace Kernels {
+
+        namespace {
+
+            const uint32_t Constants1[4] = {
+                0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6
+            };
+
+            alignas(16) const uint32_t Constants256[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+            };
+
+            inline uint32_t BigEndian(const uint8_t data[])
+            {
+                return ((static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]));
+            }
+            inline uint32_t RotateLeft(const uint32_t word, const uint8_t bits)
+            {
+                return ((word << bits) | (word >> (32 - bits)));
+            }
+            inline uint32_t RotateRight(const uint32_t word, const uint8_t bits)
+            {
+                return ((word >> bits) | (word << (32 - bits)));
+            }
+
+            // --------------------------------------------------------------------------------------------
+            // Portable C, for any CPU
+            // --------------------------------------------------------------------------------------------
+            void SHA1Portable(uint32_t state[], const uint8_t data[], const uint32_t blocks)
+            {
+                for (uint32_t block = 0; block < blocks; block++, data += 64) {
+                    uint32_t w[80];
+                    uint8_t t;
+
+                    for (t = 0; t < 16; t++) {
+                        w[t] = BigEndian(&data[t * 4]);
+                    }
+                    for (; t < 80; t++) {
+                        w[t] = RotateLeft(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+                    }
+
+                    uint32_t a = state[0];
+                    uint32_t b = state[1];
+                    uint32_t c = state[2];
+                    uint32_t d = state[3];
+                    uint32_t e = state[4];
+
+                    for (t = 0; t < 80; t++) {
+                        uint32_t f;
+
+                        if (t < 20) {
+                            f = (b & c) | ((~b) & d);
+                        } else if ((t < 40) || (t >= 60)) {
+                            f = b ^ c ^ d;
+                        } else {
+                            f = (b & c) | (b & d) | (c & d);
+                        }
+
+                        const uint32_t temp = RotateLeft(a, 5) + f + e + w[t] + Constants1[t / 20];
+
+                        e = d;
+                        d = c;
+                        c = RotateLeft(b, 30);
+                        b = a;
+                        a = temp;
+                    }
+
+                    state[0] += a;
+                    state[1] += b;
+                    state[2] += c;
+                    state[3] += d;
+                    state[4] += e;
+                }
+            }
+
+            void SHA256Portable(uint32_t state[], const uint8_t data[], const uint32_t blocks)
+            {
+                for (uint32_t block = 0; block < blocks; block++, data += 64) {
+                    uint32_t w[64];
+                    uint8_t t;
+
+                    for (t = 0; t < 16; t++) {
+                        w[t] = BigEndian(&data[t * 4]);
+                    }
+                    for (; t < 64; t++) {
+                        const uint32_t s0 = RotateRight(w[t - 15], 7) ^ RotateRight(w[t - 15], 18) ^ (w[t - 15] >> 3);
+                        const uint32_t s1 = RotateRight(w[t - 2], 17) ^ RotateRight(w[t - 2], 19) ^ (w[t - 2] >> 10);
+
+                        w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+                    }
+
+                    uint32_t a = state[0];
+                    uint32_t b = state[1];
+                    uint32_t c = state[2];
+                    uint32_t d = state[3];
+                    uint32_t e = state[4];
+                    uint32_t f = state[5];
+                    uint32_t g = state[6];
+                    uint32_t h = state[7];
+
+                    for (t = 0; t < 64; t++) {
+                        const uint32_t t1 = h + (RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25)) + ((e & f) ^ ((~e) & g)) + Constants256[t] + w[t];
+                        const uint32_t t2 = (RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+
+                        h = g;
+                        g = f;
+                        f = e;
+                        e = d + t1;
+                        d = c;
+                        c = b;
+                        b = a;
+                        a = t1 + t2;
+                    }
+
+                    state[0] += a;
+                    state[1] += b;
+                    state[2] += c;
+                    state[3] += d;
+                    state[4] += e;
+                    state[5] += f;
+                    state[6] += g;
+                    state[7] += h;
+                }
+            }
+
+#ifdef __CRYPTALGO_SHA_NI__
+            // --------------------------------------------------------------------------------------------
+            // x86 SHA extensions (SHA-NI), four rounds per instruction
+            // --------------------------------------------------------------------------------------------
+            __attribute__((target("sha,sse4.1"))) void SHA1NI(uint32_t state[], const uint8_t data[], const uint32_t blocks)
+            {
+                // Word 0 of a block ends up in the highest lane, the way the instructions want it.
+                const __m128i order = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+                __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0x1B);
+                __m128i e = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+
+                for (uint32_t block = 0; block < blocks; block++, data += 64) {
+                    const __m128i savedABCD = abcd;
+                    const __m128i savedE = e;
+                    __m128i message[4];
+
+                    for (uint8_t index = 0; index < 4; index++) {
+                        message[index] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index * 16])), order);
+                    }
+
+                    for (uint8_t group = 0; group < 20; group++) {
+                        __m128i& words = message[group & 3];
+
+                        if (group >= 4) {
+                            // The 4 words of this group, from those of the 4 groups before it.
+                            words = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(words, message[(group + 1) & 3]), message[(group + 2) & 3]), message[(group + 3) & 3]);
+                        }
+
+                        const __m128i input = (group == 0 ? _mm_add_epi32(e, words) : _mm_sha1nexte_epu32(e, words));
+
+                        e = abcd;
+
+                        switch (group / 5) {
+                        case 0:
+                            abcd = _mm_sha1rnds4_epu32(abcd, input, 0);
+                            break;
+                        case 1:
+                            abcd = _mm_sha1rnds4_epu32(abcd, input, 1);
+                            break;
+                        case 2:
+                            abcd = _mm_sha1rnds4_epu32(abcd, input, 2);
+                            break;
+                        default:
+                            abcd = _mm_sha1rnds4_epu32(abcd, input, 3);
+                            break;
+                        }
+                    }
+
+                    e = _mm_sha1nexte_epu32(e, savedE);
+                    abcd = _mm_add_epi32(abcd, savedABCD);
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+                state[4] = static_cast<uint32_t>(_mm_extract_epi32(e, 3));
+            }
+
+            __attribute__((target("sha,sse4.1"))) void SHA256NI(uint32_t state[], const uint8_t data[], const uint32_t blocks)
+            {
+                const __m128i order = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+                __m128i temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+                __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+
+                // From ABCD and EFGH to the ABEF and CDGH the instructions work with.
+                __m128i state0 = _mm_alignr_epi8(temp, state1, 8);
+                state1 = _mm_blend_epi16(state1, temp, 0xF0);
+
+                for (uint32_t block = 0; block < blocks; block++, data += 64) {
+                    const __m128i saved0 = state0;
+                    const __m128i saved1 = state1;
+                    __m128i message[4];
+
+                    for (uint8_t index = 0; index < 4; index++) {
+                        message[index] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&data[index * 16])), order);
+                    }
+
+                    for (uint8_t group = 0; group < 16; group++) {
+                        __m128i& words = message[group & 3];
+
+                        if (group >= 4) {
+                            // The 4 words of this group, from those of the 4 groups before it.
+                            const __m128i previous = message[(group + 3) & 3];
+
+                            words = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(words, message[(group + 1) & 3]), _mm_alignr_epi8(previous, message[(group + 2) & 3], 4)), previous);
+                        }
+
+                        __m128i input = _mm_add_epi32(words, _mm_load_si128(reinterpret_cast<const __m128i*>(&Constants256[group * 4])));
+
+                        state1 = _mm_sha256rnds2_epu32(state1, state0, input);
+                        input = _mm_shuffle_epi32(input, 0x0E);
+                        state0 = _mm_sha256rnds2_epu32(state0, state1, input);
+                    }
+
+                    state0 = _mm_add_epi32(state0, saved0);
+                    state1 = _mm_add_epi32(state1, saved1);
+                }
+
+                // And back to ABCD and EFGH.
+                temp = _mm_shuffle_epi32(state0, 0x1B);
+                state1 = _mm_shuffle_epi32(state1, 0xB1);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(temp, state1, 0xF0));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(state1, temp, 8));
+            }
+#endif
+
+#ifdef __CRYPTALGO_SHA_AVX2__
+            // --------------------------------------------------------------------------------------------
+            // AVX2, 8 messages side by side, one in each 32 bits lane
+            // --------------------------------------------------------------------------------------------
+#define AVX2_ROTATE(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+            __attribute__((target("avx2"))) void SHA256AVX2(uint32_t state[8][8], const uint8_t* const blocks[8])
+            {
+                __m256i w[16];
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[0]));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[1]));
+                __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[2]));
+                __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[3]));
+                __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[4]));
+                __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[5]));
+                __m256i g = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[6]));
+                __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[7]));
+
+                for (uint8_t t = 0; t < 64; t++) {
+                    __m256i word;
+
+                    if (t < 16) {
+                        const uint8_t offset = (t * 4);
+
+                        word = _mm256_setr_epi32(
+                            static_cast<int>(BigEndian(&blocks[0][offset])), static_cast<int>(BigEndian(&blocks[1][offset])),
+                            static_cast<int>(BigEndian(&blocks[2][offset])), static_cast<int>(BigEndian(&blocks[3][offset])),
+                            static_cast<int>(BigEndian(&blocks[4][offset])), static_cast<int>(BigEndian(&blocks[5][offset])),
+                            static_cast<int>(BigEndian(&blocks[6][offset])), static_cast<int>(BigEndian(&blocks[7][offset])));
+                    } else {
+                        // w[t & 15] still holds the word of 16 rounds ago.
+                        const __m256i w15 = w[(t - 15) & 15];
+                        const __m256i w2 = w[(t - 2) & 15];
+                        const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTATE(w15, 7), AVX2_ROTATE(w15, 18)), _mm256_srli_epi32(w15, 3));
+                        const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTATE(w2, 17), AVX2_ROTATE(w2, 19)), _mm256_srli_epi32(w2, 10));
+
+                        word = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0), _mm256_add_epi32(w[(t - 7) & 15], s1));
+                    }
+
+                    w[t & 15] = word;
+
+                    const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTATE(e, 6), AVX2_ROTATE(e, 11)), AVX2_ROTATE(e, 25));
+                    const __m256i choose = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+                    const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, s1), _mm256_add_epi32(choose, _mm256_set1_epi32(static_cast<int>(Constants256[t])))), word);
+                    const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(AVX2_ROTATE(a, 2), AVX2_ROTATE(a, 13)), AVX2_ROTATE(a, 22));
+                    const __m256i majority = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+
+                    h = g;
+                    g = f;
+                    f = e;
+                    e = _mm256_add_epi32(d, t1);
+                    d = c;
+                    c = b;
+                    b = a;
+                    a = _mm256_add_epi32(t1, _mm256_add_epi32(s0, majority));
+                }
+
+                const __m256i result[8] = { a, b, c, d, e, f, g, h };
+
+                for (uint8_t index = 0; index < 8; index++) {
+                    __m256i* entry = reinterpret_cast<__m256i*>(state[index]);
+
+                    _mm256_storeu_si256(entry, _mm256_add_epi32(_mm256_loadu_si256(entry), result[index]));
+                }
+            }
+
+#undef AVX2_ROTATE
+#endif
+
+#ifdef __CRYPTALGO_SHA_ARMV8__
+            // --------------------------------------------------------------------------------------------
+            // ARMv8 crypto extensions, four rounds per instruction
+            // --------------------------------------------------------------------------------------------
+            void SHA1ARMv8(uint32_t state[], const uint8_t data[], const uint32_t blocks)
+            {
+                uint32x4_t abcd = vld1q_u32(state);
+                uint32_t e = state[4];
+
+                for (uint32_t block = 0; block < blocks; block++, data += 64) {
+                    const uint32x4_t savedABCD = abcd;
+                    const uint32_t savedE = e;
+                    uint32x4_t message[4];
+
+                    for (uint8_t index = 0; index < 4; index++) {
+                        message[index] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[index * 16])));
+                    }
+
+                    for (uint8_t group = 0; group < 20; group++) {
+                        uint32x4_t& words = message[group & 3];
+                        const uint32x4_t input = vaddq_u32(words, vdupq_n_u32(Constants1[group / 5]));
+
+                        if (group < 16) {
+                            // The 4 words of the group 4 further on, from those of this one and the 3 after it.
+                            words = vsha1su1q_u32(vsha1su0q_u32(words, message[(group + 1) & 3], message[(group + 2) & 3]), message[(group + 3) & 3]);
+                        }
+
+                        const uint32_t next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+                        switch (group / 5) {
+                        case 0:
+                            abcd = vsha1cq_u32(abcd, e, input);
+                            break;
+                        case 2:
+                            abcd = vsha1mq_u32(abcd, e, input);
+                            break;
+                        default:
+                            abcd = vsha1pq_u32(abcd, e, input);
+                            break;
+                        }
+
+                        e = next;
+                    }
+
+                    e += savedE;
+                    abcd = vaddq_u32(abcd, savedABCD);
+                }
+
+                vst1q_u32(state, abcd);
+                state[4] = e;
+            }
+
+            void SHA256ARMv8(uint32_t state[], const uint8_t data[], const uint32_t blocks)
+            {
+                uint32x4_t state0 = vld1q_u32(&state[0]);
+                uint32x4_t state1 = vld1q_u32(&state[4]);
+
+                for (uint32_t block = 0; block < blocks; block++, data += 64) {
+                    const uint32x4_t saved0 = state0;
+                    const uint32x4_t saved1 = state1;
+                    uint32x4_t message[4];
+
+                    for (uint8_t index = 0; index < 4; index++) {
+                        message[index] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&data[index * 16])));
+                    }
+
+                    for (uint8_t group = 0; group < 16; group++) {
+                        uint32x4_t& words = message[group & 3];
+                        const uint32x4_t input = vaddq_u32(words, vld1q_u32(&Constants256[group * 4]));
+
+                        if (group < 12) {
+                            // The 4 words of the group 4 further on, from those of this one and the 3 after it.
+                            words = vsha256su1q_u32(vsha256su0q_u32(words, message[(group + 1) & 3]), message[(group + 2) & 3], message[(group + 3) & 3]);
+                        }
+
+                        const uint32x4_t previous = state0;
+
+                        state0 = vsha256hq_u32(state0, state1, input);
+                        state1 = vsha256h2q_u32(state1, previous, input);
+                    }
+
+                    state0 = vaddq_u32(state0, saved0);
+                    state1 = vaddq_u32(state1, saved1);
+                }
+
+                vst1q_u32(&state[0], state0);
+                vst1q_u32(&state[4], state1);
+            }
+#endif
+
+            uint8_t Supported()
+            {
+                uint8_t result = ACCELERATION_NONE;
+
+#ifdef __CRYPTALGO_SHA_NI__
+                if (__get_cpuid_max(0, nullptr) >= 7) {
+                    unsigned int eax, ebx, ecx, edx;
+
+                    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+                    // EBX bit 29 of leaf 7 is SHA.
+                    if (((ebx & (1u << 29)) != 0) && (__builtin_cpu_supports("sse4.1") != 0)) {
+                        result |= ACCELERATION_SHA;
+                    }
+                }
+#endif
+#ifdef __CRYPTALGO_SHA_AVX2__
+                if (__builtin_cpu_supports("avx2") != 0) {
+                    result |= ACCELERATION_MULTIBUFFER;
+                }
+#endif
+#ifdef __CRYPTALGO_SHA_ARMV8__
+#if defined(__LINUX__) && defined(__aarch64__)
+                const unsigned long capabilities = getauxval(AT_HWCAP);
+
+                if (((capabilities & HWCAP_SHA1) != 0) && ((capabilities & HWCAP_SHA2) != 0)) {
+                    result |= ACCELERATION_SHA;
+                }
+#else
+                // Built for a CPU that has them.
+                result |= ACCELERATION_SHA;
+#endif
+#endif
+
+                return (result);
+            }
+
+            class Selection {
+            public:
+                Selection(const Selection&) = delete;
+                Selection& operator=(const Selection&) = delete;
+
+            private:
+                Selection()
+                    : _supported(Supported())
+                    , _selected(ACCELERATION_NONE)
+                    , _sha1(&SHA1Portable)
+                    , _sha256(&SHA256Portable)
+                    , _sha256x8(nullptr)
+                {
+                    Select(_supported);
+                }
+
+            public:
+                static Selection& Instance()
+                {
+                    static Selection singleton;
+
+                    return (singleton);
+                }
+
+                uint8_t Selected() const
+                {
+                    return (_selected.load(std::memory_order_relaxed));
+                }
+                uint8_t Select(const uint8_t allowed)
+                {
+                    const uint8_t selected = (allowed & _supported);
+
+                    _sha1.store(&SHA1Portable, std::memory_order_relaxed);
+                    _sha256.store(&SHA256Portable, std::memory_order_relaxed);
+                    _sha256x8.store(nullptr, std::memory_order_relaxed);
+
+                    if ((selected & ACCELERATION_SHA) != 0) {
+#if defined(__CRYPTALGO_SHA_NI__)
+                        _sha1.store(&SHA1NI, std::memory_order_relaxed);
+                        _sha256.store(&SHA256NI, std::memory_order_relaxed);
+#elif defined(__CRYPTALGO_SHA_ARMV8__)
+                        _sha1.store(&SHA1ARMv8, std::memory_order_relaxed);
+                        _sha256.store(&SHA256ARMv8, std::memory_order_relaxed);
+#endif
+                    }
+#ifdef __CRYPTALGO_SHA_AVX2__
+                    if ((selected & ACCELERATION_MULTIBUFFER) != 0) {
+                        _sha256x8.store(&SHA256AVX2, std::memory_order_relaxed);
+                    }
+#endif
+
+                    _selected.store(selected, std::memory_order_relaxed);
+
+                    return (selected);
+                }
+                Compression SHA1() const
+                {
+                    return (_sha1.load(std::memory_order_relaxed));
+                }
+                Compression SHA256() const
+                {
+                    return (_sha256.load(std::memory_order_relaxed));
+                }
+                Interleaved SHA256x8() const
+                {
+                    return (_sha256x8.load(std::memory_order_relaxed));
+                }
+
+            private:
+                const uint8_t _supported;
+                std::atomic<uint8_t> _selected;
+                std::atomic<Compression> _sha1;
+                std::atomic<Compression> _sha256;
+                std::atomic<Interleaved> _sha256x8;
+            };
+
+        }
+
+        Compression SHA1()
+        {
+            return (Selection::Instance().SHA1());
+        }
+        Compression SHA256()
+        {
+            return (Selection::Instance().SHA256());
+        }
+        Interleaved SHA256x8()
+        {
+            return (Selection::Instance().SHA256x8());
+        }
+
+    } // namespace Crypto::Kernels
+
+    uint8_t Acceleration()
+    {
+        return (Kernels::Selection::Instance().Selected() | Kernels::Ciphers());
+    }
+    uint8_t Acceleration(const uint8_t allowed)
+    {
+        return (Kernels::Selection::Instance().Select(allowed) | Kernels::Ciphers(allowed));
+    }
+}
+} // namespace WPEFramework::Crypto
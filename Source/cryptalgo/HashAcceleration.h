@@ -0,0 +1,54 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HASHACCELERATION_H
+#define __HASHACCELERATION_H
+
+// ---- Include system wide include files ----
+
+// ---- Include local include files ----
+#include "Module.h"
+
+// ---- Referenced classes and types ----
+
+// ---- Helper types and constants ----
+
+// ---- Helper functions ----
+namespace WPEFramework {
+namespace Crypto {
+    namespace Kernels {
+
+        // Runs the SHA-1 (5 words of state) or SHA-256 (8 words of state) compression function over a number
+        // of consecutive blocks of 64 bytes.
+        typedef void (*Compression)(uint32_t state[], const uint8_t data[], const uint32_t blocks);
+
+        // Runs the SHA-256 compression function over one block for each of 8 messages side by side. Word n of
+        // the state of lane l is in state[n][l].
+        typedef void (*Interleaved)(uint32_t state[8][8], const uint8_t* const blocks[8]);
+
+        // The ones in use, see Crypto::Acceleration() to pick them.
+        Compression SHA1();
+        Compression SHA256();
+        Interleaved SHA256x8();
+
+    } // namespace Crypto::Kernels
+}
+} // namespace WPEFramework::Crypto
+
+#endif // __HASHACCELERATION_H
@@ -22,6 +22,11 @@
 #include <openssl/ssl.h>
 #include <openssl/x509v3.h>
 
+// The kernel can do the record encryption (kTLS), if OpenSSL was built for it.
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define __SECURE_SOCKET_KTLS__
+#endif
+
 #ifndef __WINDOWS__
 namespace {
 
@@ -80,6 +85,180 @@ namespace Crypto {
         return (result);
     }
 
+namespace {
+
+    // The OpenSSL context is shared by all connections with the same configuration, so the certificate
+    // store is loaded only once. It also keeps the last session every server handed out, a new connection
+    // to that server (host and port) offers it again to resume it.
+    class Contexts {
+    private:
+        static constexpr uint8_t MaxSessions = 64;
+
+        struct Entry {
+            SSL_CTX* Context;
+            std::map<string, SSL_SESSION*> Sessions;
+        };
+
+    public:
+        Contexts(const Contexts&) = delete;
+        Contexts& operator=(const Contexts&) = delete;
+
+        Contexts()
+            : _adminLock()
+            , _entries()
+        {
+            for (Entry& entry : _entries) {
+                entry.Context = nullptr;
+            }
+        }
+        ~Contexts()
+        {
+            for (Entry& entry : _entries) {
+                for (auto& session : entry.Sessions) {
+                    SSL_SESSION_free(session.second);
+                }
+                if (entry.Context != nullptr) {
+                    SSL_CTX_free(entry.Context);
+                }
+            }
+        }
+
+        static Contexts& Instance()
+        {
+            static Contexts singleton;
+
+            return (singleton);
+        }
+
+    public:
+        // A reference to the context for this configuration, release it with SSL_CTX_free.
+        SSL_CTX* Context(const bool offload)
+        {
+            Entry& entry(_entries[offload == true ? 1 : 0]);
+
+            _adminLock.Lock();
+
+            if (entry.Context == nullptr) {
+                entry.Context = Create(offload);
+            }
+            if (entry.Context != nullptr) {
+                SSL_CTX_up_ref(entry.Context);
+            }
+
+            _adminLock.Unlock();
+
+            return (entry.Context);
+        }
+        void Resume(SSL* ssl, const string& peer)
+        {
+            _adminLock.Lock();
+
+            Entry* entry = Find(SSL_get_SSL_CTX(ssl));
+
+            if (entry != nullptr) {
+                std::map<string, SSL_SESSION*>::iterator index(entry->Sessions.find(peer));
+
+                if (index != entry->Sessions.end()) {
+                    if (SSL_SESSION_is_resumable(index->second) == 1) {
+                        SSL_set_session(ssl, index->second);
+                    } else {
+                        SSL_SESSION_free(index->second);
+                        entry->Sessions.erase(index);
+                    }
+                }
+            }
+
+            _adminLock.Unlock();
+        }
+
+    private:
+        SSL_CTX* Create(const bool offload)
+        {
+            SSL_CTX* context = SSL_CTX_new(TLS_method());
+
+            if (context != nullptr) {
+                uint64_t options = (SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+
+#ifdef __SECURE_SOCKET_KTLS__
+                options |= (offload == true ? SSL_OP_ENABLE_KTLS : 0);
+#else
+                DEBUG_VARIABLE(offload);
+#endif
+
+                SSL_CTX_set_options(context, options);
+
+                // Trust the same certificates as any other application
+                if (SSL_CTX_set_default_verify_paths(context) != 1) {
+                    TRACE_L1("OpenSSL failed to load certificate store");
+                    SSL_CTX_free(context);
+                    context = nullptr;
+                } else {
+                    // The sessions, or tickets, are kept here, the internal store of OpenSSL only works for servers.
+                    SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+                    SSL_CTX_sess_set_new_cb(context, NewSession);
+                }
+            }
+
+            return (context);
+        }
+        Entry* Find(const SSL_CTX* context)
+        {
+            Entry* result = nullptr;
+
+            for (Entry& entry : _entries) {
+                if (entry.Context == context) {
+                    result = &entry;
+                    break;
+                }
+            }
+
+            return (result);
+        }
+        // A session (TLS 1.2) or ticket (TLS 1.3) came in, the peer is only set if it should be resumed.
+        static int NewSession(SSL* ssl, SSL_SESSION* session)
+        {
+            const string* peer = static_cast<const string*>(SSL_get_app_data(ssl));
+
+            return (((peer != nullptr) && (peer->empty() == false)) ? Instance().Store(SSL_get_SSL_CTX(ssl), *peer, session) : 0);
+        }
+        int Store(const SSL_CTX* context, const string& peer, SSL_SESSION* session)
+        {
+            int result = 0;
+
+            _adminLock.Lock();
+
+            Entry* entry = Find(context);
+
+            if (entry != nullptr) {
+                std::map<string, SSL_SESSION*>::iterator index(entry->Sessions.find(peer));
+
+                if (index != entry->Sessions.end()) {
+                    SSL_SESSION_free(index->second);
+                    index->second = session;
+                } else {
+                    if (entry->Sessions.size() >= MaxSessions) {
+                        SSL_SESSION_free(entry->Sessions.begin()->second);
+                        entry->Sessions.erase(entry->Sessions.begin());
+                    }
+                    entry->Sessions.emplace(peer, session);
+                }
+
+                // We hold on to the reference OpenSSL handed over.
+                result = 1;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        Entry _entries[2];
+    };
+
+}
+
 string SecureSocketPort::Certificate::Issuer() const {
     char buffer[1024];
     buffer[0] = '\0';
@@ -131,24 +310,36 @@ SecureSocketPort::Handler::~Handler() {
 uint32_t SecureSocketPort::Handler::Initialize() {
     uint32_t success = Core::ERROR_NONE;
 
-    _context = SSL_CTX_new(TLS_method());
+    // Opened before, start over with a new connection.
+    if (_ssl != nullptr) {
+        SSL_free(static_cast<SSL*>(_ssl));
+        _ssl = nullptr;
+    }
+    if (_context != nullptr) {
+        SSL_CTX_free(static_cast<SSL_CTX*>(_context));
+    }
+
+    _context = Contexts::Instance().Context(_offload);
+    _offloaded = false;
 
-    _ssl = SSL_new(static_cast<SSL_CTX*>(_context));
-    SSL_set_fd(static_cast<SSL*>(_ssl), static_cast<Core::IResource&>(*this).Descriptor());
-    SSL_CTX_set_options(static_cast<SSL_CTX*>(_context), SSL_OP_ALL | SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+    if (_context != nullptr) {
+        _ssl = SSL_new(static_cast<SSL_CTX*>(_context));
+        SSL_set_fd(static_cast<SSL*>(_ssl), static_cast<Core::IResource&>(*this).Descriptor());
+        SSL_set_app_data(static_cast<SSL*>(_ssl), (_resumption == true ? &_peer : nullptr));
 
-    // Trust the same certificates as any other application
-    if (SSL_CTX_set_default_verify_paths(static_cast<SSL_CTX*>(_context)) == 1) {
         success = Core::SocketPort::Initialize();
     } else {
-        TRACE_L1("OpenSSL failed to load certificate store");
         success = Core::ERROR_GENERAL;
     }
 
     return success;
 }
 
-int32_t SecureSocketPort::Handler::Read(uint8_t buffer[], const uint16_t length) const {
+bool SecureSocketPort::Handler::IsResumed() const {
+    return ((_ssl != nullptr) && (SSL_session_reused(static_cast<SSL*>(_ssl)) == 1));
+}
+
+int32_t SecureSocketPort::Handler::Read(uint8_t buffer[], const uint32_t length) const {
     int32_t result = SSL_read(static_cast<SSL*>(_ssl), buffer, length);
 
     if (_handShaking != CONNECTED) {
@@ -157,10 +348,46 @@ int32_t SecureSocketPort::Handler::Read(uint8_t buffer[], const uint16_t length)
     return (result);
 }
 
-int32_t SecureSocketPort::Handler::Write(const uint8_t buffer[], const uint16_t length) {
+int32_t SecureSocketPort::Handler::Write(const uint8_t buffer[], const uint32_t length) {
     return (SSL_write(static_cast<SSL*>(_ssl), buffer, length));
 }
 
+// The segments go through SSL one by one, as far as they are accepted.
+int32_t SecureSocketPort::Handler::Write(const Segment segments[], const uint8_t count) {
+    int32_t result = 0;
+    uint8_t index = 0;
+
+    while (index < count) {
+        int32_t written = (segments[index].Size != 0 ? SSL_write(static_cast<SSL*>(_ssl), segments[index].Data, segments[index].Size) : 0);
+
+        if (written < 0) {
+            result = (result == 0 ? written : result);
+            break;
+        }
+
+        result += written;
+
+        if (static_cast<uint32_t>(written) != segments[index].Size) {
+            break;
+        }
+
+        index++;
+    }
+
+    return (result);
+}
+
+int32_t SecureSocketPort::Handler::Write(const Region& region) {
+#ifdef __SECURE_SOCKET_KTLS__
+    if (_offloaded == true) {
+        // The kernel encrypts, the file goes out without passing through user space.
+        return (static_cast<int32_t>(SSL_sendfile(static_cast<SSL*>(_ssl), region.Descriptor, static_cast<off_t>(region.Offset), static_cast<size_t>(std::min(region.Size, static_cast<uint64_t>(0x7FFFF000))), 0)));
+    }
+#endif
+
+    // The kernel can not encrypt it for us, so it has to pass through the send buffer.
+    return (Copy(region));
+}
 
 uint32_t SecureSocketPort::Handler::Open(const uint32_t waitTime) {
     return (Core::SocketPort::Open(waitTime));
@@ -175,6 +402,10 @@ uint32_t SecureSocketPort::Handler::Close(const uint32_t waitTime) {
 }
 
 void SecureSocketPort::Handler::ValidateHandShake() {
+#ifdef __SECURE_SOCKET_KTLS__
+    _offloaded = (BIO_get_ktls_send(SSL_get_wbio(static_cast<SSL*>(_ssl))) != 0);
+#endif
+
     // Step 1: verify a server certificate was presented during the negotiation
     X509* x509cert = SSL_get_peer_certificate(static_cast<SSL*>(_ssl));
     if (x509cert != nullptr) {
@@ -215,6 +446,12 @@ void SecureSocketPort::Handler::Update() {
 
         if (_handShaking == IDLE) {
             SSL_set_tlsext_host_name(static_cast<SSL*>(_ssl), RemoteNode().HostName().c_str());
+
+            if (_resumption == true) {
+                _peer = RemoteNode().QualifiedName();
+                Contexts::Instance().Resume(static_cast<SSL*>(_ssl), _peer);
+            }
+
             result = SSL_connect(static_cast<SSL*>(_ssl));
             if (result == 1) {
                 ValidateHandShake();
@@ -81,28 +81,42 @@ namespace Crypto {
                 , _context(nullptr)
                 , _ssl(nullptr)
                 , _callback(nullptr)
-                , _handShaking(IDLE) {
+                , _handShaking(IDLE)
+                , _resumption(true)
+                , _offload(false)
+                , _offloaded(false)
+                , _peer() {
             }
             ~Handler();
 
         public:
             uint32_t Initialize() override;
 
-            int32_t Read(uint8_t buffer[], const uint16_t length) const override;
-            int32_t Write(const uint8_t buffer[], const uint16_t length) override;
+            int32_t Read(uint8_t buffer[], const uint32_t length) const override;
+            int32_t Write(const uint8_t buffer[], const uint32_t length) override;
+            int32_t Write(const Segment segments[], const uint8_t count) override;
+            int32_t Write(const Region& region) override;
 
             uint32_t Open(const uint32_t waitTime);
             uint32_t Close(const uint32_t waitTime);
 
             // Methods to extract and insert data into the socket buffers
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override {
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
 
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override {
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
 
+            bool SendFile(Region& region) override {
+                return (_parent.SendFile(region));
+            }
+
+            void FileSent() override {
+                _parent.FileSent();
+            }
+
             // Signal a state change, Opened, Closed or Accepted
             void StateChange() override {
 
@@ -124,6 +138,16 @@ namespace Crypto {
 
                 return (result);
             }
+            inline void SessionResumption(const bool enabled) {
+                _resumption = enabled;
+            }
+            inline void KernelOffload(const bool enabled) {
+                _offload = enabled;
+            }
+            inline bool IsOffloaded() const {
+                return (_offloaded);
+            }
+            bool IsResumed() const;
 
         private:
             void Update();
@@ -135,6 +159,10 @@ namespace Crypto {
             void* _ssl;
             IValidator* _callback;
             mutable state _handShaking;
+            bool _resumption;
+            bool _offload;
+            bool _offloaded;
+            string _peer;
         };
 
     public:
@@ -199,6 +227,26 @@ namespace Crypto {
             return (_handler.Callback(callback));
         }
 
+        // All connections share the OpenSSL context of their configuration, which keeps the sessions
+        // (tickets) the servers handed out, per host and port. A new connection to the same server offers
+        // it, to resume the session with an abbreviated handshake. On by default.
+        inline void SessionResumption(const bool enabled) {
+            _handler.SessionResumption(enabled);
+        }
+        // Opt in to let the kernel encrypt what is sent (kTLS), if OpenSSL and the kernel support it. The
+        // parts of files (see SendFile) are then sent with sendfile, without passing through user space.
+        // Takes effect on the next Open, after the handshake IsOffloaded tells if the kernel took it.
+        inline void KernelOffload(const bool enabled) {
+            _handler.KernelOffload(enabled);
+        }
+        inline bool IsOffloaded() const {
+            return (_handler.IsOffloaded());
+        }
+        // The last handshake resumed an earlier session.
+        inline bool IsResumed() const {
+            return (_handler.IsResumed());
+        }
+
         //
         // Core::IResource interface
         // ------------------------------------------------------------------------
@@ -216,8 +264,17 @@ namespace Crypto {
         }
 
         // Methods to extract and insert data into the socket buffers
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
+
+        // Parts of a file are encrypted like any other data, see Core::SocketPort::SendFile.
+        virtual bool SendFile(Core::SocketPort::Region& /* region */)
+        {
+            return (false);
+        }
+        virtual void FileSent()
+        {
+        }
 
         // Signal a state change, Opened, Closed or Accepted
         virtual void StateChange() = 0;
@@ -50,6 +50,8 @@ namespace Messaging {
 
     public:
         using BaseCategory = BaseCategoryType<TYPE>;
+        // A category that formats its text differently, should set this to void, so its messages are not deferred.
+        using Deferrable = BaseCategoryType<TYPE>;
 
         static constexpr Core::Messaging::Metadata::type Type = TYPE;
 
@@ -79,6 +81,10 @@ namespace Messaging {
         using BaseClass = BASECATEGORY;                     \
     public:                                                 \
         using BaseClass::BaseClass;                         \
+        using Deferrable = typename std::conditional<       \
+            std::is_same<typename BaseClass::Deferrable,    \
+                typename BaseClass::BaseCategory>::value,   \
+            CATEGORY, void>::type;                          \
         CATEGORY() = default;                               \
         ~CATEGORY() = default;                              \
         CATEGORY(const CATEGORY&) = delete;                 \
@@ -0,0 +1,457 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DeferredMessage.h"
+
+namespace WPEFramework {
+
+namespace Messaging {
+
+    namespace {
+
+        // The format strings registered in this process, the id is the index + 1. If published, each
+        // format is appended to the file as [id][length][text], the id and length being 32 bits.
+        class Formats {
+        public:
+            static constexpr uint32_t HeaderSize = (2 * sizeof(uint32_t));
+
+            Formats(const Formats&) = delete;
+            Formats& operator=(const Formats&) = delete;
+
+            Formats()
+                : _adminLock()
+                , _formats()
+                , _file()
+            {
+            }
+            ~Formats() = default;
+
+            static Formats& Instance()
+            {
+                static Formats singleton;
+                return (singleton);
+            }
+
+        public:
+            uint32_t Add(const TCHAR format[])
+            {
+                _adminLock.Lock();
+                _formats.emplace_back(format);
+                uint32_t result = static_cast<uint32_t>(_formats.size());
+
+                if (_file.IsOpen() == true) {
+                    Write(result, _formats.back());
+                }
+                _adminLock.Unlock();
+
+                return (result);
+            }
+            void Publish(const string& fileName)
+            {
+                _adminLock.Lock();
+
+                if (_file.IsOpen() == true) {
+                    _file.Destroy();
+                }
+
+                if (fileName.empty() == false) {
+                    _file = fileName;
+
+                    if (_file.Create(Core::File::USER_READ | Core::File::USER_WRITE | Core::File::GROUP_READ | Core::File::OTHERS_READ) == true) {
+                        for (uint32_t index = 0; index < _formats.size(); index++) {
+                            Write(index + 1, _formats[index]);
+                        }
+                    }
+                    else {
+                        TRACE_L1("Could not publish the formats in %s", fileName.c_str());
+                    }
+                }
+
+                _adminLock.Unlock();
+            }
+            bool Get(const uint32_t id, string& format) const
+            {
+                bool result = false;
+
+                _adminLock.Lock();
+                if ((id != 0) && (id <= _formats.size())) {
+                    format = _formats[id - 1];
+                    result = true;
+                }
+                _adminLock.Unlock();
+
+                return (result);
+            }
+
+        private:
+            // One write per entry, so a reader can only find the last one incomplete.
+            void Write(const uint32_t id, const string& format)
+            {
+                const uint32_t length = static_cast<uint32_t>(format.length() * sizeof(TCHAR));
+                std::vector<uint8_t> entry(HeaderSize + length);
+
+                ::memcpy(&(entry[0]), &id, sizeof(id));
+                ::memcpy(&(entry[sizeof(id)]), &length, sizeof(length));
+                ::memcpy(&(entry[HeaderSize]), format.c_str(), length);
+
+                if (_file.Write(entry.data(), static_cast<uint32_t>(entry.size())) != entry.size()) {
+                    TRACE_L1("Could not publish format %u", id);
+                }
+            }
+
+        private:
+            mutable Core::CriticalSection _adminLock;
+            std::vector<string> _formats;
+            Core::File _file;
+        };
+
+        // One conversion specification, e.g. %-08.3lx
+        struct Specification {
+            string Options; // flags, width and precision, as they were given
+            char Length; // 0, 'H' (hh), 'h', 'l', 'L' (ll, L), 'j', 'z' or 't'
+            char Conversion;
+        };
+
+        // Returns false if the format is not understood (or uses what can not be deferred, like * or %n).
+        bool Parse(const TCHAR*& cursor, Specification& spec)
+        {
+            spec.Options.clear();
+            spec.Length = 0;
+            spec.Conversion = 0;
+
+            while ((*cursor != '\0') && (::strchr("-+ #0'", *cursor) != nullptr)) {
+                spec.Options += *cursor++;
+            }
+            while (::isdigit(*cursor)) {
+                spec.Options += *cursor++;
+            }
+            if (*cursor == '.') {
+                spec.Options += *cursor++;
+                while (::isdigit(*cursor)) {
+                    spec.Options += *cursor++;
+                }
+            }
+
+            if ((cursor[0] == 'h') && (cursor[1] == 'h')) {
+                spec.Length = 'H';
+                cursor += 2;
+            } else if ((cursor[0] == 'l') && (cursor[1] == 'l')) {
+                spec.Length = 'L';
+                cursor += 2;
+            } else if ((*cursor != '\0') && (::strchr("hlLqjzt", *cursor) != nullptr)) {
+                spec.Length = (*cursor == 'q' ? 'L' : *cursor);
+                cursor++;
+            }
+
+            if ((*cursor != '\0') && (::strchr("diouxXcfFeEgGaAsp", *cursor) != nullptr)) {
+                spec.Conversion = *cursor++;
+            }
+
+            return (spec.Conversion != 0);
+        }
+
+        uint8_t Expected(const Specification& spec)
+        {
+            uint8_t result = 0;
+
+            switch (spec.Conversion) {
+            case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+                result = DeferredMessage::argument::SIGNED;
+                break;
+            case 'c':
+                result = (spec.Length == 0 ? DeferredMessage::argument::SIGNED : 0);
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                result = DeferredMessage::argument::REAL;
+                break;
+            case 's':
+                result = (spec.Length == 0 ? DeferredMessage::argument::TEXT : 0);
+                break;
+            case 'p':
+                result = DeferredMessage::argument::POINTER;
+                break;
+            default:
+                break;
+            }
+
+            return (result);
+        }
+
+        // Narrow the value the way the original call would have: an int is an int, even if it is stored in 64 bits.
+        uint64_t Narrow(const uint64_t value, const Specification& spec)
+        {
+            const bool isSigned = ((spec.Conversion == 'd') || (spec.Conversion == 'i') || (spec.Conversion == 'c'));
+            uint64_t result = value;
+
+            switch (spec.Length) {
+            case 'H':
+                result = (isSigned ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<signed char>(value))) : static_cast<uint64_t>(static_cast<unsigned char>(value)));
+                break;
+            case 'h':
+                result = (isSigned ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<short>(value))) : static_cast<uint64_t>(static_cast<unsigned short>(value)));
+                break;
+            case 'l':
+                result = (isSigned ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<long>(value))) : static_cast<uint64_t>(static_cast<unsigned long>(value)));
+                break;
+            case 0:
+                result = (isSigned ? static_cast<uint64_t>(static_cast<int64_t>(static_cast<int>(value))) : static_cast<uint64_t>(static_cast<unsigned int>(value)));
+                break;
+            default:
+                break;
+            }
+
+            return (result);
+        }
+    }
+
+    /* static */ constexpr uint8_t DeferredMessage::Marker;
+    /* static */ constexpr uint16_t DeferredMessage::BufferSize;
+
+    /* static */ uint32_t DeferredMessage::Register(const TCHAR format[], const uint8_t signature[], const uint8_t count)
+    {
+        const TCHAR* cursor = format;
+        uint8_t index = 0;
+        bool valid = true;
+
+        while ((valid == true) && (*cursor != '\0')) {
+            if (*cursor++ == '%') {
+                Specification spec;
+
+                if (*cursor == '%') {
+                    cursor++;
+                } else if ((Parse(cursor, spec) == false) || (index >= count)) {
+                    valid = false;
+                } else {
+                    const uint8_t expected = Expected(spec);
+                    const uint8_t given = signature[index++];
+
+                    // Integers of either sign go with all integer conversions, like they do with printf.
+                    valid = ((expected == given) || ((expected == argument::SIGNED) && (given == argument::UNSIGNED)));
+                }
+            }
+        }
+
+        return (((valid == true) && (index == count)) ? Formats::Instance().Add(format) : 0);
+    }
+
+    /* static */ bool DeferredMessage::Lookup(const uint32_t id, string& format)
+    {
+        return (Formats::Instance().Get(id, format));
+    }
+
+    /* static */ void DeferredMessage::Publish(const string& fileName)
+    {
+        Formats::Instance().Publish(fileName);
+    }
+
+    /* static */ void DeferredMessage::Published(Core::File& file, uint64_t& offset, std::unordered_map<uint32_t, string>& formats)
+    {
+        if ((file.IsOpen() == true) && (file.Position(false, offset) == true)) {
+            std::vector<uint8_t> data;
+            uint8_t block[1024];
+            uint32_t size;
+
+            while ((size = file.Read(block, sizeof(block))) != 0) {
+                data.insert(data.end(), block, block + size);
+            }
+
+            size_t index = 0;
+
+            while ((data.size() - index) >= Formats::HeaderSize) {
+                uint32_t id;
+                uint32_t length;
+
+                ::memcpy(&id, &(data[index]), sizeof(id));
+                ::memcpy(&length, &(data[index + sizeof(id)]), sizeof(length));
+
+                if ((data.size() - index - Formats::HeaderSize) < length) {
+                    // Still being written.
+                    break;
+                }
+
+                formats[id].assign(reinterpret_cast<const TCHAR*>(&(data[index + Formats::HeaderSize])), (length / sizeof(TCHAR)));
+                index += (Formats::HeaderSize + length);
+            }
+
+            offset += index;
+        }
+    }
+
+    /* static */ bool DeferredMessage::Replaced(Core::File& file, const uint64_t offset)
+    {
+        const Core::File current(file.Name());
+        bool result = false;
+
+        // Gone is not replaced, the producer stopped publishing and what was read still applies.
+        if (current.Exists() == true) {
+            result = (current.Size() < offset);
+
+#ifdef __POSIX__
+            struct stat opened;
+            struct stat named;
+
+            if ((result == false) && (file.IsOpen() == true) && (::fstat(static_cast<Core::File::Handle>(file), &opened) == 0) && (::stat(file.Name().c_str(), &named) == 0)) {
+                result = ((opened.st_ino != named.st_ino) || (opened.st_dev != named.st_dev));
+            }
+#endif
+        }
+
+        return (result);
+    }
+
+    /* static */ bool DeferredMessage::Identify(const uint8_t payload[], const uint16_t length, uint32_t& id)
+    {
+        bool result = false;
+
+        if ((length > sizeof(id)) && (payload[0] == Marker)) {
+            ::memcpy(&id, &(payload[1]), sizeof(id));
+            result = true;
+        }
+
+        return (result);
+    }
+
+    /* static */ bool DeferredMessage::Format(const string& format, const uint8_t payload[], const uint16_t length, string& text)
+    {
+        const TCHAR* cursor = format.c_str();
+        uint16_t offset = 1 + sizeof(uint32_t);
+        bool valid = ((length >= offset) && (payload[0] == Marker));
+        string value;
+
+        text.clear();
+
+        while ((valid == true) && (*cursor != '\0')) {
+            if (*cursor != '%') {
+                text += *cursor++;
+            } else if (*(++cursor) == '%') {
+                text += *cursor++;
+            } else {
+                Specification spec;
+
+                valid = (Parse(cursor, spec) == true);
+
+                if (valid == false) {
+                } else if (Expected(spec) == argument::TEXT) {
+                    uint16_t size;
+
+                    if ((offset + sizeof(size)) > length) {
+                        valid = false;
+                    } else {
+                        ::memcpy(&size, &(payload[offset]), sizeof(size));
+                        offset += sizeof(size);
+
+                        if ((offset + size) > length) {
+                            valid = false;
+                        } else {
+                            const string argument(reinterpret_cast<const char*>(&(payload[offset])), size);
+                            const string conversion(_T("%") + spec.Options + _T("s"));
+
+                            offset += size;
+                            Core::Format(value, conversion.c_str(), argument.c_str());
+                            text += value;
+                        }
+                    }
+                } else if ((offset + sizeof(uint64_t)) > length) {
+                    valid = false;
+                } else if (Expected(spec) == argument::REAL) {
+                    double argument;
+                    const string conversion(_T("%") + spec.Options + spec.Conversion);
+
+                    ::memcpy(&argument, &(payload[offset]), sizeof(argument));
+                    offset += sizeof(argument);
+                    Core::Format(value, conversion.c_str(), argument);
+                    text += value;
+                } else {
+                    uint64_t argument;
+
+                    ::memcpy(&argument, &(payload[offset]), sizeof(argument));
+                    offset += sizeof(argument);
+
+                    if (spec.Conversion == 'p') {
+                        const string conversion(_T("%") + spec.Options + _T("p"));
+                        Core::Format(value, conversion.c_str(), reinterpret_cast<void*>(static_cast<uintptr_t>(argument)));
+                    } else if (spec.Conversion == 'c') {
+                        const string conversion(_T("%") + spec.Options + _T("c"));
+                        Core::Format(value, conversion.c_str(), static_cast<int>(argument));
+                    } else {
+                        const string conversion(_T("%") + spec.Options + _T("ll") + spec.Conversion);
+                        Core::Format(value, conversion.c_str(), static_cast<unsigned long long>(Narrow(argument, spec)));
+                    }
+                    text += value;
+                }
+            }
+        }
+
+        return (valid);
+    }
+
+    uint16_t DeferredMessage::Serialize(uint8_t buffer[], const uint16_t bufferSize) const
+    {
+        uint16_t result = 0;
+
+        if (IsDeferred() == false) {
+            TextMessage text(_text);
+            result = text.Serialize(buffer, bufferSize);
+        } else if (bufferSize >= _length) {
+            ::memcpy(buffer, _buffer, _length);
+            result = _length;
+        } else {
+            // Does not fit, send what it reads like.
+            TextMessage text(Data());
+            result = text.Serialize(buffer, bufferSize);
+        }
+
+        return (result);
+    }
+
+    uint16_t DeferredMessage::Deserialize(const uint8_t buffer[], const uint16_t bufferSize)
+    {
+        uint16_t result = 0;
+        uint32_t id;
+
+        if (Identify(buffer, bufferSize, id) == false) {
+            TextMessage text;
+            result = text.Deserialize(buffer, bufferSize);
+            Text(text.Data());
+        } else {
+            _length = std::min(bufferSize, static_cast<uint16_t>(sizeof(_buffer)));
+            ::memcpy(_buffer, buffer, _length);
+            _text.clear();
+            result = _length;
+        }
+
+        return (result);
+    }
+
+    const string& DeferredMessage::Data() const
+    {
+        if ((IsDeferred() == true) && (_text.empty() == true)) {
+            string format;
+            uint32_t id;
+
+            if ((Identify(_buffer, _length, id) == true) && (Lookup(id, format) == true)) {
+                Format(format, _buffer, _length, _text);
+            }
+        }
+
+        return (_text);
+    }
+
+} // namespace Messaging
+}
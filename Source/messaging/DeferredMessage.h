@@ -0,0 +1,350 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Module.h"
+#include "BaseCategory.h"
+#include "TextMessage.h"
+
+namespace WPEFramework {
+
+namespace Messaging {
+
+    /**
+    * @brief A message of which the formatting is left to whoever reads it. The producer only writes the id of the
+    *        format string and the raw values of the arguments. The format strings are registered once per call site
+    *        and are published in a file next to the message buffer, so the reading side can do the formatting, also
+    *        when the producing process is gone.
+    *        If a message can not be deferred (the category formats itself, a format that is not understood, an
+    *        argument that can not be encoded), it is formatted right away and carried as text, like a TextMessage.
+    */
+    class EXTERNAL DeferredMessage : public Core::Messaging::IEvent {
+    public:
+        // A deferred message starts with this byte, a text message never does.
+        static constexpr uint8_t Marker = 0x01;
+        static constexpr uint16_t BufferSize = 256;
+
+        enum argument : uint8_t {
+            SIGNED   = 1,
+            UNSIGNED = 2,
+            REAL     = 3,
+            TEXT     = 4,
+            POINTER  = 5
+        };
+
+        /**
+        * @brief One per TRACE/SYSLOG call site, it remembers the id of the format string used there.
+        */
+        class EXTERNAL Site {
+        private:
+            static constexpr uint32_t Undeferrable = ~0u;
+
+        public:
+            Site(const Site&) = delete;
+            Site& operator=(const Site&) = delete;
+
+            Site()
+                : _id(0)
+            {
+            }
+            ~Site() = default;
+
+        public:
+            // Returns 0 if messages from this site can not be deferred.
+            uint32_t Id(const TCHAR format[], const uint8_t signature[], const uint8_t count)
+            {
+                uint32_t result = _id.load(std::memory_order_relaxed);
+
+                if (result == 0) {
+                    result = Register(format, signature, count);
+                    _id.store((result == 0 ? Undeferrable : result), std::memory_order_relaxed);
+                }
+
+                return (result == Undeferrable ? 0 : result);
+            }
+
+        private:
+            std::atomic<uint32_t> _id;
+        };
+
+    private:
+        template <typename TYPE, typename = void>
+        struct Kind {
+            static constexpr uint8_t Value = 0;
+        };
+        template <typename TYPE>
+        struct Kind<TYPE, typename std::enable_if<(std::is_integral<TYPE>::value || std::is_enum<TYPE>::value) && std::is_signed<typename std::conditional<std::is_enum<TYPE>::value, int, TYPE>::type>::value>::type> {
+            static constexpr uint8_t Value = argument::SIGNED;
+        };
+        template <typename TYPE>
+        struct Kind<TYPE, typename std::enable_if<std::is_integral<TYPE>::value && !std::is_signed<TYPE>::value>::type> {
+            static constexpr uint8_t Value = argument::UNSIGNED;
+        };
+        template <typename TYPE>
+        struct Kind<TYPE, typename std::enable_if<std::is_floating_point<TYPE>::value>::type> {
+            static constexpr uint8_t Value = argument::REAL;
+        };
+        template <typename TYPE>
+        struct Kind<TYPE, typename std::enable_if<std::is_same<typename std::decay<TYPE>::type, const char*>::value || std::is_same<typename std::decay<TYPE>::type, char*>::value || std::is_same<TYPE, std::string>::value>::type> {
+            static constexpr uint8_t Value = argument::TEXT;
+        };
+        template <typename TYPE>
+        struct Kind<TYPE, typename std::enable_if<std::is_pointer<typename std::decay<TYPE>::type>::value && !std::is_same<typename std::decay<TYPE>::type, const char*>::value && !std::is_same<typename std::decay<TYPE>::type, char*>::value>::type> {
+            static constexpr uint8_t Value = argument::POINTER;
+        };
+
+        template <typename... ARGUMENTS>
+        struct Encodable;
+        template <typename FIRST, typename... ARGUMENTS>
+        struct Encodable<FIRST, ARGUMENTS...> {
+            static constexpr bool Value = (Kind<typename std::decay<FIRST>::type>::Value != 0) && Encodable<ARGUMENTS...>::Value;
+        };
+        template <typename... ARGUMENTS>
+        struct Encodable {
+            static constexpr bool Value = true;
+        };
+
+    protected:
+        // Only categories defined with DEFINE_MESSAGING_CATEGORY on a base that just formats, are deferred.
+        template <typename CATEGORY, typename = void>
+        struct IsDeferrable {
+            static constexpr bool Value = false;
+        };
+        template <typename CATEGORY>
+        struct IsDeferrable<CATEGORY, typename std::enable_if<std::is_same<typename CATEGORY::Deferrable, CATEGORY>::value>::type> {
+            static constexpr bool Value = true;
+        };
+
+        // Only a literal keeps its text for the lifetime of the process, a buffer (char[]) can be reused with
+        // another text, while its address would still find the format registered for the first one.
+        template <typename FORMAT>
+        struct IsLiteral {
+            static constexpr bool Value = std::is_array<typename std::remove_reference<FORMAT>::type>::value && std::is_same<typename std::remove_extent<typename std::remove_reference<FORMAT>::type>::type, const TCHAR>::value;
+        };
+
+        // A literal format with at least one argument, a lone text is not formatted by the category either.
+        template <typename CATEGORY, typename FORMAT, typename... ARGUMENTS>
+        struct IsEncoded {
+            static constexpr bool Value = IsDeferrable<CATEGORY>::Value && IsLiteral<FORMAT>::Value && (sizeof...(ARGUMENTS) > 0) && Encodable<ARGUMENTS...>::Value;
+        };
+
+    public:
+        DeferredMessage(const DeferredMessage&) = delete;
+        DeferredMessage& operator=(const DeferredMessage&) = delete;
+
+        DeferredMessage()
+            : _site(nullptr)
+            , _length(0)
+            , _text()
+        {
+        }
+        DeferredMessage(Site& site)
+            : _site(&site)
+            , _length(0)
+            , _text()
+        {
+        }
+        ~DeferredMessage() override = default;
+
+    public:
+        bool IsDeferred() const
+        {
+            return (_length != 0);
+        }
+
+        uint16_t Serialize(uint8_t buffer[], const uint16_t bufferSize) const override;
+        uint16_t Deserialize(const uint8_t buffer[], const uint16_t bufferSize) override;
+        const string& Data() const override;
+
+        /**
+        * @brief The reading side: is this payload a deferred message, and if so, with which format.
+        */
+        static bool Identify(const uint8_t payload[], const uint16_t length, uint32_t& id);
+        /**
+        * @brief The reading side: format the payload of a deferred message with the format that belongs to it.
+        */
+        static bool Format(const string& format, const uint8_t payload[], const uint16_t length, string& text);
+        /**
+        * @brief The format string registered for the given id, in this process.
+        */
+        static bool Lookup(const uint32_t id, string& format);
+        /**
+        * @brief The producing side: write the format strings registered so far, and all that follow, to the given
+        *        file. A format is in there before the first message using it is sent. An empty name stops publishing
+        *        and removes the file.
+        */
+        static void Publish(const string& fileName);
+        /**
+        * @brief The reading side: add the formats published in the file, from the given offset on, to the map. The
+        *        offset is moved past the last complete entry, one that is still being written is picked up next time.
+        */
+        static void Published(Core::File& file, uint64_t& offset, std::unordered_map<uint32_t, string>& formats);
+        /**
+        * @brief The reading side: true if the file by that name is not the one that is open anymore, or it holds less
+        *        than was read from it. The producer started publishing anew, the formats read so far do not apply.
+        */
+        static bool Replaced(Core::File& file, const uint64_t offset);
+
+    protected:
+        template <typename... ARGUMENTS>
+        void Encode(const TCHAR format[], ARGUMENTS&&... arguments)
+        {
+            const uint8_t signature[] = { Kind<typename std::decay<ARGUMENTS>::type>::Value..., 0 };
+            const uint32_t id = _site->Id(format, signature, sizeof...(ARGUMENTS));
+
+            _length = 0;
+
+            if (id != 0) {
+                _buffer[0] = Marker;
+                ::memcpy(&(_buffer[1]), &id, sizeof(id));
+                _length = 1 + sizeof(id);
+
+                Pack(std::forward<ARGUMENTS>(arguments)...);
+            }
+        }
+        void Text(const string& text)
+        {
+            _length = 0;
+            _text = text;
+        }
+
+    private:
+        static uint32_t Register(const TCHAR format[], const uint8_t signature[], const uint8_t count);
+
+        void Pack()
+        {
+        }
+        template <typename FIRST, typename... ARGUMENTS>
+        void Pack(FIRST&& first, ARGUMENTS&&... arguments)
+        {
+            if (_length != 0) {
+                Put(first);
+                Pack(std::forward<ARGUMENTS>(arguments)...);
+            }
+        }
+        template <typename TYPE>
+        typename std::enable_if<Kind<typename std::decay<TYPE>::type>::Value == argument::SIGNED>::type Put(const TYPE& value)
+        {
+            Put(static_cast<int64_t>(value));
+        }
+        template <typename TYPE>
+        typename std::enable_if<Kind<typename std::decay<TYPE>::type>::Value == argument::UNSIGNED>::type Put(const TYPE& value)
+        {
+            Put(static_cast<uint64_t>(value));
+        }
+        template <typename TYPE>
+        typename std::enable_if<Kind<typename std::decay<TYPE>::type>::Value == argument::REAL>::type Put(const TYPE& value)
+        {
+            Put(static_cast<double>(value));
+        }
+        template <typename TYPE>
+        typename std::enable_if<Kind<typename std::decay<TYPE>::type>::Value == argument::POINTER>::type Put(const TYPE& value)
+        {
+            Put(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        }
+        void Put(const char* value)
+        {
+            Put(value, (value != nullptr ? static_cast<uint32_t>(::strlen(value)) : 0));
+        }
+        void Put(const std::string& value)
+        {
+            Put(value.c_str(), static_cast<uint32_t>(value.length()));
+        }
+        void Put(const int64_t value)
+        {
+            Put(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+        }
+        void Put(const uint64_t value)
+        {
+            Put(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+        }
+        void Put(const double value)
+        {
+            Put(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+        }
+        void Put(const uint8_t value[], const uint8_t size)
+        {
+            if ((_length + size) <= sizeof(_buffer)) {
+                ::memcpy(&(_buffer[_length]), value, size);
+                _length += size;
+            }
+            else {
+                _length = 0;
+            }
+        }
+        void Put(const char value[], const uint32_t size)
+        {
+            if ((_length + sizeof(uint16_t) + size) <= sizeof(_buffer)) {
+                const uint16_t length = static_cast<uint16_t>(size);
+
+                ::memcpy(&(_buffer[_length]), &length, sizeof(length));
+                ::memcpy(&(_buffer[_length + sizeof(length)]), value, size);
+                _length += static_cast<uint16_t>(sizeof(length) + size);
+            }
+            else {
+                _length = 0;
+            }
+        }
+
+    private:
+        Site* _site;
+        uint16_t _length;
+        uint8_t _buffer[BufferSize];
+        mutable string _text;
+    };
+
+    /**
+    * @brief The message a TRACE or SYSLOG of the given category puts in the MessageUnit. If it can be deferred, it is
+    *        encoded, else the category is constructed, as it always was, and its text is taken.
+    */
+    template <typename CATEGORY>
+    class DeferredMessageType : public DeferredMessage {
+    public:
+        DeferredMessageType() = delete;
+        DeferredMessageType(const DeferredMessageType<CATEGORY>&) = delete;
+        DeferredMessageType<CATEGORY>& operator=(const DeferredMessageType<CATEGORY>&) = delete;
+
+        DeferredMessageType(Site& site)
+            : DeferredMessage(site)
+        {
+        }
+        ~DeferredMessageType() override = default;
+
+    public:
+        template <typename FORMAT, typename... ARGUMENTS>
+        typename std::enable_if<IsEncoded<CATEGORY, FORMAT, ARGUMENTS...>::Value>::type Set(FORMAT&& format, ARGUMENTS&&... arguments)
+        {
+            Encode(format, std::forward<ARGUMENTS>(arguments)...);
+
+            if (IsDeferred() == false) {
+                CATEGORY data(std::forward<FORMAT>(format), std::forward<ARGUMENTS>(arguments)...);
+                Text(data.Data());
+            }
+        }
+        template <typename... ARGUMENTS>
+        void Set(ARGUMENTS&&... arguments)
+        {
+            CATEGORY data(std::forward<ARGUMENTS>(arguments)...);
+            Text(data.Data());
+        }
+    };
+
+} // namespace Messaging
+}
@@ -23,6 +23,7 @@
 #include "Control.h"
 #include "TextMessage.h"
 #include "BaseCategory.h"
+#include "DeferredMessage.h"
 #include "MessageUnit.h"
 
 namespace WPEFramework {
@@ -90,13 +91,14 @@ namespace Logging {
     do {                                                                                                                                          \
         static_assert(std::is_base_of<WPEFramework::Logging::BaseLoggingType<CATEGORY>, CATEGORY>::value, "SYSLOG() only for Logging controls");  \
         if (CATEGORY::IsEnabled() == true) {                                                                                                      \
-            CATEGORY __data__ PARAMETERS;                                                                                                         \
             WPEFramework::Core::Messaging::MessageInfo __info__(                                                                                  \
                 CATEGORY::Metadata(),                                                                                                             \
                 WPEFramework::Core::Time::Now().Ticks()                                                                                           \
             );                                                                                                                                    \
             WPEFramework::Core::Messaging::IStore::Logging __log__(__info__);                                                                     \
-            WPEFramework::Messaging::TextMessage __message__(__data__.Data());                                                                    \
+            static WPEFramework::Messaging::DeferredMessage::Site __site__;                                                                       \
+            WPEFramework::Messaging::DeferredMessageType<CATEGORY> __message__(__site__);                                                         \
+            __message__.Set PARAMETERS;                                                                                                           \
             WPEFramework::Messaging::MessageUnit::Instance().Push(__log__, &__message__);                                                         \
         }                                                                                                                                         \
     } while(false)
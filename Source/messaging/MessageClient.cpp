@@ -191,6 +191,9 @@ namespace Messaging {
                     message = factory->second->GetMessage();
 
                     length = metadata->Deserialize(_readBuffer, size);
+
+                    Resolve(client.second, length, size);
+
                     length += message->Deserialize((&_readBuffer[length]), (size - length));
 
                     handler(metadata, message);
@@ -207,6 +210,37 @@ namespace Messaging {
         _adminLock.Unlock();
     }
 
+    /**
+     * @brief If the message at offset is a deferred one, format it here and put the text in its place. This way the
+     *        factories only ever see text messages.
+     *
+     * @param client the message came from, it knows the formats of that side
+     * @param offset where the message starts in the read buffer
+     * @param size of the data in the read buffer, updated to the new size
+     */
+    void MessageClient::Resolve(MessageUnit::Client& client, const uint16_t offset, uint16_t& size)
+    {
+        uint32_t id;
+
+        if ((offset < size) && (DeferredMessage::Identify(&(_readBuffer[offset]), (size - offset), id) == true)) {
+            string format;
+            string text;
+
+            if (client.Format(id, format) == false) {
+                text = _T("<unknown format>");
+            }
+            else if (DeferredMessage::Format(format, &(_readBuffer[offset]), (size - offset), text) == false) {
+                text = format;
+            }
+
+            const uint16_t length = std::min(static_cast<uint16_t>(text.length()), static_cast<uint16_t>(sizeof(_readBuffer) - offset - 1));
+
+            ::memcpy(&(_readBuffer[offset]), text.c_str(), length);
+            _readBuffer[offset + length] = '\0';
+            size = offset + length + 1;
+        }
+    }
+
     /**
      * @brief Register factory for a given message type. The factory will spawn a message suitable for deserializing received bytes
      *
@@ -61,6 +61,8 @@ namespace Messaging {
         using Factories = std::unordered_map<Core::Messaging::Metadata::type, IEventFactory*>;
         using Clients = std::map<uint32_t, MessageUnit::Client>;
 
+        void Resolve(MessageUnit::Client& client, const uint16_t offset, uint16_t& size);
+
         mutable Core::CriticalSection _adminLock;
         const string _identifier;
         const string _basePath;
@@ -106,6 +106,352 @@ namespace Messaging {
             Core::DoorBell _doorBell;
         };
 
+        /**
+        * @brief Single producer, single consumer ring in which one thread stages its messages. The entries have the
+        *        same layout as in the DataBuffer, so the flusher can move them in one go.
+        */
+        class StagingRing {
+        public:
+            static constexpr uint32_t Size = 32 * 1024; // Needs to be a power of 2
+
+        public:
+            StagingRing(const StagingRing&) = delete;
+            StagingRing& operator=(const StagingRing&) = delete;
+
+            StagingRing()
+                : _head(0)
+                , _buffer()
+                , _tail(0)
+                , _abandoned(false)
+            {
+            }
+            ~StagingRing() = default;
+
+        public:
+            bool IsEmpty() const
+            {
+                return (_head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire));
+            }
+            bool IsAbandoned() const
+            {
+                return (_abandoned.load(std::memory_order_acquire));
+            }
+            void Abandon()
+            {
+                _abandoned.store(true, std::memory_order_release);
+            }
+            uint32_t Used() const
+            {
+                return (_head.load(std::memory_order_relaxed) - _tail.load(std::memory_order_acquire));
+            }
+
+            // Producer side, only to be called from the thread owning the ring.
+            bool Push(const uint16_t length, const uint8_t value[])
+            {
+                const uint16_t fullLength = sizeof(length) + length;
+                const uint32_t head = _head.load(std::memory_order_relaxed);
+                const bool result = ((Size - (head - _tail.load(std::memory_order_acquire))) >= fullLength);
+
+                if (result == true) {
+                    Copy(head, reinterpret_cast<const uint8_t*>(&fullLength), sizeof(fullLength));
+                    Copy(head + sizeof(fullLength), value, length);
+                    _head.store(head + fullLength, std::memory_order_release);
+                }
+
+                return (result);
+            }
+
+            // Consumer side, copies as many complete entries as fit in the given space.
+            uint32_t Pop(uint8_t buffer[], const uint32_t space)
+            {
+                uint32_t tail = _tail.load(std::memory_order_relaxed);
+                const uint32_t head = _head.load(std::memory_order_acquire);
+                uint32_t result = 0;
+                uint16_t fullLength = 0;
+
+                while (tail != head) {
+                    Peek(tail, reinterpret_cast<uint8_t*>(&fullLength), sizeof(fullLength));
+
+                    if ((result + fullLength) > space) {
+                        break;
+                    }
+
+                    Peek(tail, &(buffer[result]), fullLength);
+                    tail += fullLength;
+                    result += fullLength;
+                }
+
+                _tail.store(tail, std::memory_order_release);
+
+                return (result);
+            }
+
+        private:
+            void Copy(const uint32_t position, const uint8_t source[], const uint32_t length)
+            {
+                const uint32_t offset = (position & (Size - 1));
+                const uint32_t first = std::min(length, Size - offset);
+
+                ::memcpy(&(_buffer[offset]), source, first);
+                ::memcpy(_buffer, &(source[first]), length - first);
+            }
+            void Peek(const uint32_t position, uint8_t destination[], const uint32_t length) const
+            {
+                const uint32_t offset = (position & (Size - 1));
+                const uint32_t first = std::min(length, Size - offset);
+
+                ::memcpy(destination, &(_buffer[offset]), first);
+                ::memcpy(&(destination[first]), _buffer, length - first);
+            }
+
+        private:
+            // The buffer keeps the producer and consumer positions on different cache lines.
+            std::atomic<uint32_t> _head;
+            uint8_t _buffer[Size];
+            std::atomic<uint32_t> _tail;
+            std::atomic<bool> _abandoned;
+        };
+
+        /**
+        * @brief Thread local administration of a producer. If the thread exits, its ring is abandoned and
+        *        dropped by the flusher once it is drained.
+        */
+        class StagingProducer {
+        public:
+            StagingProducer(const StagingProducer&) = delete;
+            StagingProducer& operator=(const StagingProducer&) = delete;
+
+            StagingProducer()
+                : Instance(0)
+                , Ring()
+            {
+            }
+            ~StagingProducer()
+            {
+                if (Ring.IsValid() == true) {
+                    Ring->Abandon();
+                }
+            }
+
+        public:
+            uint32_t Instance;
+            Core::ProxyType<StagingRing> Ring;
+        };
+
+        /**
+        * @brief Every producer thread stages its messages in its own ring, without taking a lock. This flusher
+        *        moves them in batches to the DataBuffer, with one reservation and one ring of the doorbell per batch.
+        *        The order of the messages of one thread is kept, between threads there is no order. A message waits
+        *        at most FlushLatency before it is moved.
+        */
+        class Staging : public Core::Thread {
+        public:
+            static constexpr uint32_t FlushLatency = 5; // ms
+            static constexpr uint32_t BatchSize = (DATA_BUFFER_SIZE / 2);
+            static constexpr uint32_t MaxStaged = (BatchSize < (StagingRing::Size / 2) ? BatchSize : (StagingRing::Size / 2));
+
+        private:
+            using Rings = std::list<Core::ProxyType<StagingRing>>;
+
+        public:
+            Staging() = delete;
+            Staging(const Staging&) = delete;
+            Staging& operator=(const Staging&) = delete;
+
+            Staging(MessageDataBufferType& parent)
+                : Core::Thread(Core::Thread::DefaultStackSize(), _T("MessageStaging"))
+                , _parent(parent)
+                , _lock()
+                , _rings()
+                , _wakeup(false, true)
+                , _idle(false)
+                , _instance(Sequence())
+                , _batch()
+            {
+                Thread::Run();
+            }
+            ~Staging() override
+            {
+                Thread::Stop();
+                _wakeup.SetEvent();
+                Wait(Thread::STOPPED, Core::infinite);
+
+                // Whatever is still staged, should not get lost.
+                Drain();
+            }
+
+        public:
+            uint32_t Push(const uint16_t length, const uint8_t value[])
+            {
+                uint32_t result = Core::ERROR_NONE;
+                StagingProducer& producer(Core::ThreadLocalStorageType<StagingProducer>::Instance().Context());
+
+                if (producer.Instance != _instance) {
+                    Register(producer);
+                }
+
+                if ((sizeof(length) + length) > MaxStaged) {
+                    // Too big to stage, so this one goes directly, but not before the ones before it.
+                    Room(*(producer.Ring), StagingRing::Size);
+                    result = _parent.Direct(length, value);
+                }
+                else if ((producer.Ring->Push(length, value) == false) && ((Room(*(producer.Ring), sizeof(length) + length) == false) || (producer.Ring->Push(length, value) == false))) {
+                    TRACE_L1("Staging ring is full, message dropped!");
+                    result = Core::ERROR_WRITE_ERROR;
+                }
+                else {
+                    // Wake up the flusher if it is sleeping, or if this ring just got half full.
+                    const uint32_t used = producer.Ring->Used();
+
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if (((_idle.load(std::memory_order_relaxed) == true) && (_idle.exchange(false) == true)) || ((used >= (StagingRing::Size / 2)) && ((used - (sizeof(length) + length)) < (StagingRing::Size / 2)))) {
+                        _wakeup.SetEvent();
+                    }
+                }
+
+                return (result);
+            }
+            void Settle()
+            {
+                Drain();
+            }
+
+        private:
+            uint32_t Worker() override
+            {
+                // Whoever signals from here on, while we drain, is not missed.
+                _wakeup.ResetEvent();
+
+                const uint32_t drained = Drain();
+
+                if (drained >= (BatchSize / 2)) {
+                    // The producers are busy, keep on going.
+                }
+                else if (drained != 0) {
+                    // Give the producers the time to fill the next batch, unless one of them runs out of room.
+                    _wakeup.Lock(FlushLatency);
+                }
+                else {
+                    _idle.store(true);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                    if ((IsEmpty() == true) && (Thread::IsRunning() == true)) {
+                        _wakeup.Lock(Core::infinite);
+                    }
+
+                    _idle.store(false);
+                }
+
+                return (0);
+            }
+            static uint32_t Sequence()
+            {
+                static std::atomic<uint32_t> sequence(0);
+
+                return (++sequence);
+            }
+            void Register(StagingProducer& producer)
+            {
+                if (producer.Ring.IsValid() == true) {
+                    producer.Ring->Abandon();
+                }
+
+                producer.Ring = Core::ProxyType<StagingRing>::Create();
+                producer.Instance = _instance;
+
+                _lock.Lock();
+                _rings.push_back(producer.Ring);
+                _lock.Unlock();
+            }
+            // Wait (a bounded time) for the flusher to make room in the ring of the calling thread.
+            bool Room(const StagingRing& ring, const uint32_t needed)
+            {
+                uint32_t retries = FlushLatency * 1000;
+
+                _wakeup.SetEvent();
+
+                while (((StagingRing::Size - ring.Used()) < needed) && (retries-- != 0)) {
+                    std::this_thread::yield();
+
+                    if ((retries % 1000) == 0) {
+                        SleepMs(1);
+                    }
+                }
+
+                return ((StagingRing::Size - ring.Used()) >= needed);
+            }
+            bool IsEmpty() const
+            {
+                bool result = true;
+
+                _lock.Lock();
+
+                typename Rings::const_iterator index(_rings.cbegin());
+                while ((result == true) && (index != _rings.cend())) {
+                    result = (*index)->IsEmpty();
+                    index++;
+                }
+
+                _lock.Unlock();
+
+                return (result);
+            }
+            uint32_t Drain()
+            {
+                uint32_t drained = 0;
+                uint32_t length = 0;
+
+                _lock.Lock();
+
+                typename Rings::iterator index(_rings.begin());
+
+                while (index != _rings.end()) {
+                    const bool abandoned = (*index)->IsAbandoned();
+                    uint32_t budget = StagingRing::Size;
+                    uint32_t loaded;
+
+                    // Do not get stuck on one busy producer, take at most what fits in its ring.
+                    while ((budget != 0) && ((loaded = (*index)->Pop(&(_batch[length]), BatchSize - length)) != 0)) {
+                        length += loaded;
+                        budget = (loaded < budget ? budget - loaded : 0);
+
+                        if ((*index)->IsEmpty() == false) {
+                            // The batch is full.
+                            _parent.Batch(_batch, length);
+                            drained += length;
+                            length = 0;
+                        }
+                    }
+
+                    if ((abandoned == true) && ((*index)->IsEmpty() == true)) {
+                        index = _rings.erase(index);
+                    }
+                    else {
+                        index++;
+                    }
+                }
+
+                if (length != 0) {
+                    _parent.Batch(_batch, length);
+                    drained += length;
+                }
+
+                _lock.Unlock();
+
+                return (drained);
+            }
+
+        private:
+            MessageDataBufferType& _parent;
+            mutable Core::CriticalSection _lock;
+            Rings _rings;
+            Core::Event _wakeup;
+            std::atomic<bool> _idle;
+            const uint32_t _instance;
+            uint8_t _batch[BatchSize];
+        };
+
     public:
         using MetadataFrame = Core::IPCMessageType<1, Core::IPC::BufferType<METADATA_SIZE>, Core::IPC::BufferType<METADATA_SIZE>>;
 
@@ -119,8 +465,10 @@ namespace Messaging {
          * @param instanceId number of the instance
          * @param baseDirectory where to place all the necessary files. This directory should exist before creating this class.
          * @param socketPort triggers the use of using a IP socket in stead of a domain socket if the port value is not 0.
+         * @param initialize should the buffer be created, done only once, on the server side
+         * @param staging stage the pushed messages per thread and move them to the buffer in batches
          */
-        MessageDataBufferType(const string& identifier, const uint32_t instanceId, const string& baseDirectory, const uint16_t socketPort = 0, const bool initialize = false)
+        MessageDataBufferType(const string& identifier, const uint32_t instanceId, const string& baseDirectory, const uint16_t socketPort = 0, const bool initialize = false, const bool staging = false)
             : _filenames(PrepareFilenames(baseDirectory, identifier, instanceId, socketPort))
             , _dataLock()
             , _initialize(initialize)
@@ -135,6 +483,7 @@ namespace Messaging {
                                                                  Core::File::SHAREABLE,
                                                                  (initialize == true ? DATA_BUFFER_SIZE : 0), true)
             // clang-format on
+            , _staging()
         {
             if (_dataBuffer.IsValid() == false) {
                 _dataBuffer.Validate();
@@ -149,9 +498,14 @@ namespace Messaging {
             else {
                 TRACE_L1("MessageDispatcher instance %d is not valid!", instanceId);
             }
+
+            if (staging == true) {
+                _staging.reset(new Staging(*this));
+            }
         }
         ~MessageDataBufferType()
         {
+            _staging.reset(nullptr);
             _dataBuffer.Relinquish();
 
             if (_initialize == true) {
@@ -177,32 +531,21 @@ namespace Messaging {
         */
         uint32_t PushData(const uint16_t length, const uint8_t* value)
         {
-            uint32_t result = Core::ERROR_WRITE_ERROR;
-            const uint16_t fullLength = sizeof(length) + length; // headerLength + informationLength
-
             ASSERT(length > 0);
             ASSERT(value != nullptr);
 
-            _dataLock.Lock();
-
-            if (_dataBuffer.IsValid() == true) {
-                const uint16_t reservedLength = _dataBuffer.Reserve(fullLength);
+            return (_staging != nullptr ? _staging->Push(length, value) : Direct(length, value));
+        }
 
-                if (reservedLength >= fullLength) {
-                    //no need to serialize because we can write to CyclicBuffer step by step
-                    _dataBuffer.Write(reinterpret_cast<const uint8_t*>(&fullLength), sizeof(fullLength)); //fullLength
-                    _dataBuffer.Write(value, length); //value
-                    _dataBuffer.Ring();
-                    result = Core::ERROR_NONE;
-                }
-                else {
-                    TRACE_L1("Buffer to small to fit message!");
-                }
+        /**
+         * @brief Staged messages are moved to the cyclic buffer by a separate thread. This waits till everything
+         *        that was staged before this call, is in the cyclic buffer.
+         */
+        void Settle()
+        {
+            if (_staging != nullptr) {
+                _staging->Settle();
             }
-
-            _dataLock.Unlock();
-
-            return (result);
         }
 
         /**
@@ -273,11 +616,61 @@ namespace Messaging {
             return (_filenames.metaData);
         }
 
+        const string& FormatsName() const {
+            return (_filenames.formats);
+        }
+
+    private:
+        uint32_t Direct(const uint16_t length, const uint8_t value[])
+        {
+            uint32_t result = Core::ERROR_WRITE_ERROR;
+            const uint16_t fullLength = sizeof(length) + length; // headerLength + informationLength
+
+            _dataLock.Lock();
+
+            if (_dataBuffer.IsValid() == true) {
+                const uint16_t reservedLength = _dataBuffer.Reserve(fullLength);
+
+                if (reservedLength >= fullLength) {
+                    //no need to serialize because we can write to CyclicBuffer step by step
+                    _dataBuffer.Write(reinterpret_cast<const uint8_t*>(&fullLength), sizeof(fullLength)); //fullLength
+                    _dataBuffer.Write(value, length); //value
+                    _dataBuffer.Ring();
+                    result = Core::ERROR_NONE;
+                }
+                else {
+                    TRACE_L1("Buffer to small to fit message!");
+                }
+            }
+
+            _dataLock.Unlock();
+
+            return (result);
+        }
+        // The batch holds complete entries (length + value), they all go in with one reservation.
+        void Batch(const uint8_t batch[], const uint32_t length)
+        {
+            _dataLock.Lock();
+
+            if (_dataBuffer.IsValid() == true) {
+                if (_dataBuffer.Reserve(length) >= length) {
+                    _dataBuffer.Write(batch, length);
+                    _dataBuffer.Ring();
+                }
+                else {
+                    TRACE_L1("Buffer to small to fit staged messages!");
+                }
+            }
+
+            _dataLock.Unlock();
+        }
+
     private:
         struct Filenames {
             string doorBell;
             string metaData;
             string data;
+            string formats;
         } _filenames;
 
         /**
@@ -291,6 +684,7 @@ namespace Messaging {
         *         0 - doorBellFilename
         *         1 - dataFileName
         *         2 - metaDataFilename
+        *         3 - formatsFilename
         */
         static Filenames PrepareFilenames(const string& baseDirectory, const string& identifier, const uint32_t instanceId, const uint16_t socketPort)
         {
@@ -311,14 +705,16 @@ namespace Messaging {
             }
 
             string dataFilename = instancePath + _T(".data");
+            string formatsFilename = instancePath + _T(".formats");
 
-            return { doorBellFilename, metaDataFilename, dataFilename };
+            return { doorBellFilename, metaDataFilename, dataFilename, formatsFilename };
         }
 
     private:
         mutable Core::CriticalSection _dataLock;
         bool _initialize;
         DataBuffer _dataBuffer;
+        std::unique_ptr<Staging> _staging;
     };
 
 } // namespace Messaging 
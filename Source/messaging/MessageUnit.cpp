@@ -164,7 +164,7 @@ namespace WPEFramework {
             // Store it on an environment variable so other instances can pick this info up..
             _settings.Save();
 
-            _dispatcher.reset(new MessageDispatcher(*this, identifier, 0, basePath, socketPort));
+            _dispatcher.reset(new MessageDispatcher(*this, identifier, 0, basePath, socketPort, _settings.IsStaged()));
             ASSERT(_dispatcher != nullptr);
 
             if ((_dispatcher != nullptr) && (_dispatcher->IsValid() == true)) {
@@ -196,7 +196,7 @@ namespace WPEFramework {
             if (instanceId != static_cast<uint32_t>(~0)) {
                 _settings.Load();
 
-                _dispatcher.reset(new MessageDispatcher(*this, _settings.Identifier(), instanceId, _settings.BasePath(), _settings.SocketPort()));
+                _dispatcher.reset(new MessageDispatcher(*this, _settings.Identifier(), instanceId, _settings.BasePath(), _settings.SocketPort(), _settings.IsStaged()));
                 ASSERT(_dispatcher != nullptr);
 
                 if ((_dispatcher != nullptr) && (_dispatcher->IsValid() == true)) {
@@ -23,6 +23,7 @@
 #include "MessageDispatcher.h"
 #include "TraceFactory.h"
 #include "DirectOutput.h"
+#include "DeferredMessage.h"
 
 namespace WPEFramework {
 
@@ -232,7 +233,8 @@ namespace WPEFramework {
                 enum mode : uint8_t {
                     BACKGROUND   = 0x01,
                     DIRECT       = 0x02,
-                    ABBREVIATED  = 0x04
+                    ABBREVIATED  = 0x04,
+                    STAGING      = 0x08
                 };
 
                 /**
@@ -333,10 +335,12 @@ namespace WPEFramework {
                         , Tracing()
                         , Logging()
                         , Reporting()
+                        , Staging(false)
                     {
                         Add(_T("tracing"), &Tracing);
                         Add(_T("logging"), &Logging);
                         Add(_T("reporting"), &Reporting);
+                        Add(_T("staging"), &Staging);
                     }
                     ~Config() = default;
                     Config(const Config& other) = delete;
@@ -346,6 +350,7 @@ namespace WPEFramework {
                     TracingSection Tracing;
                     LoggingSection Logging;
                     ReportingSection Reporting;
+                    Core::JSON::Boolean Staging;
                 };
 
             public:
@@ -384,6 +389,10 @@ namespace WPEFramework {
                     return ((_mode & mode::DIRECT) != 0);
                 }
 
+                bool IsStaged() const {
+                    return ((_mode & mode::STAGING) != 0);
+                }
+
                 Core::Messaging::MessageInfo::abbreviate IsAbbreviated() const {
                     Core::Messaging::MessageInfo::abbreviate abbreviate;
 
@@ -408,6 +417,10 @@ namespace WPEFramework {
                     Config jsonParsed;
                     jsonParsed.FromString(config);
                     FromConfig(jsonParsed);
+
+                    if (jsonParsed.Staging.Value() == true) {
+                        _mode |= mode::STAGING;
+                    }
                 }
 
                 /**
@@ -620,8 +633,14 @@ namespace WPEFramework {
 
                 Client(const string& identifier, const uint32_t instanceId, const string& baseDirectory, const uint16_t socketPort = 0)
                     : MessageDataBufferType < DataSize, MetadataSize>(identifier, instanceId, baseDirectory, socketPort, false)
-                    , _channel(Core::NodeId(MetadataName().c_str()), MetadataSize) {
+                    , _channel(Core::NodeId(MetadataName().c_str()), MetadataSize)
+                    , _formatsFile(FormatsName())
+                    , _formatsOffset(0)
+                    , _formats() {
                     _channel.Open(Core::infinite);
+
+                    // Keep it open, the formats stay readable after the other side removed the file.
+                    _formatsFile.Open(true);
                 }
                 ~Client() {
                     _channel.Close(100);
@@ -702,8 +721,47 @@ namespace WPEFramework {
                     }
                 }
 
+                /**
+                 * @brief The format string of a deferred message, as published by the other side. The file is only
+                 *        read, from where the previous read ended, if the format is not yet known.
+                 *
+                 * @param id of the format, as found in the message
+                 * @param format string to fill
+                 * @return true if the format is known
+                 */
+                bool Format(const uint32_t id, string& format)
+                {
+                    auto index = _formats.find(id);
+
+                    if (index == _formats.end()) {
+                        if (DeferredMessage::Replaced(_formatsFile, _formatsOffset) == true) {
+                            // The other side restarted, the ids it hands out now, are not the ones we know.
+                            _formatsFile.Close();
+                            _formatsOffset = 0;
+                            _formats.clear();
+                        }
+
+                        if ((_formatsFile.IsOpen() == true) || (_formatsFile.Open(true) == true)) {
+                            DeferredMessage::Published(_formatsFile, _formatsOffset, _formats);
+                        }
+
+                        index = _formats.find(id);
+                    }
+
+                    const bool found = (index != _formats.end());
+
+                    if (found == true) {
+                        format = index->second;
+                    }
+
+                    return (found);
+                }
+
             private:
                 mutable Core::IPCChannelClientType<Core::Void, false, true> _channel;
+                Core::File _formatsFile;
+                uint64_t _formatsOffset;
+                std::unordered_map<uint32_t, string> _formats;
             };
 
         private:
@@ -792,13 +850,18 @@ namespace WPEFramework {
                  * @param initialize should dispatcher be initialzied. Should be done only once, on the server side
                  * @param baseDirectory where to place all the necessary files. This directory should exist before creating this class.
                  * @param socketPort triggers the use of using a IP socket in stead of a domain socket if the port value is not 0.
+                 * @param staging stage the messages per thread and move them to the buffer in batches
                  */
-                MessageDispatcher(MessageUnit& parent, const string& identifier, const uint32_t instanceId, const string& basePath, const uint16_t socketPort)
-                    : BaseClass(identifier, instanceId, basePath, socketPort, true)
+                MessageDispatcher(MessageUnit& parent, const string& identifier, const uint32_t instanceId, const string& basePath, const uint16_t socketPort, const bool staging)
+                    : BaseClass(identifier, instanceId, basePath, socketPort, true, staging)
                     , _metaDataBuffer(parent, BaseClass::MetadataName())
                 {
+                    DeferredMessage::Publish(BaseClass::FormatsName());
+                }
+                virtual ~MessageDispatcher()
+                {
+                    DeferredMessage::Publish(string());
                 }
-                virtual ~MessageDispatcher() = default;
 
             public:
                 bool IsValid() const {
@@ -22,6 +22,7 @@
 #include "Module.h"
 #include "Control.h"
 #include "TextMessage.h"
+#include "DeferredMessage.h"
 
 #ifdef _THUNDER_PRODUCTION
 
@@ -44,7 +45,6 @@
     do {                                                                                     \
         using __control__ = TRACE_CONTROL(CATEGORY);                                         \
         if (__control__::IsEnabled() == true) {                                              \
-            CATEGORY __data__ PARAMETERS;                                                    \
             WPEFramework::Core::Messaging::MessageInfo __info__(                             \
                 __control__::Metadata(),                                                     \
                 WPEFramework::Core::Time::Now().Ticks()                                      \
@@ -55,7 +55,9 @@
                 __LINE__,                                                                    \
                 WPEFramework::Core::ClassNameOnly(typeid(*this).name()).Text()               \
             );                                                                               \
-            WPEFramework::Messaging::TextMessage __message__(__data__.Data());               \
+            static WPEFramework::Messaging::DeferredMessage::Site __site__;                  \
+            WPEFramework::Messaging::DeferredMessageType<CATEGORY> __message__(__site__);    \
+            __message__.Set PARAMETERS;                                                      \
             WPEFramework::Messaging::MessageUnit::Instance().Push(__trace__, &__message__);  \
         }                                                                                    \
     } while(false)
@@ -64,7 +66,6 @@
     do {                                                                                     \
         using __control__ = TRACE_CONTROL(CATEGORY);                                         \
         if (__control__::IsEnabled() == true) {                                              \
-            CATEGORY __data__ PARAMETERS;                                                    \
             WPEFramework::Core::Messaging::MessageInfo __info__(                             \
                 __control__::Metadata(),                                                     \
                 WPEFramework::Core::Time::Now().Ticks()                                      \
@@ -75,7 +76,9 @@
                 __LINE__,                                                                    \
                 __FUNCTION__                                                                 \
             );                                                                               \
-            WPEFramework::Messaging::TextMessage __message__(__data__.Data());               \
+            static WPEFramework::Messaging::DeferredMessage::Site __site__;                  \
+            WPEFramework::Messaging::DeferredMessageType<CATEGORY> __message__(__site__);    \
+            __message__.Set PARAMETERS;                                                      \
             WPEFramework::Messaging::MessageUnit::Instance().Push(__trace__, &__message__);  \
         }                                                                                    \
     } while(false)
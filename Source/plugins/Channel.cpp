@@ -36,6 +36,11 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
         , _offset(0)
         , _sendQueue()
     {
+        // JSON compresses well, the small messages are not worth it.
+        Compression(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+
+        // Large results go out (and large requests come in) in a single frame, instead of 1KB at a time.
+        Link().AdaptiveBuffers(1024 * 1024, 1024 * 1024);
     }
 POP_WARNING()
 
@@ -328,15 +328,24 @@ namespace PluginHost {
 
             BaseClass::Unlock();
         }
-        uint16_t Serialize(uint8_t* dataFrame, const uint16_t maxSendSize)
+        uint32_t Serialize(uint8_t* dataFrame, const uint32_t maxSendSize)
         {
-            uint16_t size = 0;
+            uint32_t size = 0;
 
             switch (State()) {
             case JSON:
             case JSONRPC: {
-                // Seems we are sending JSON structs
-                size = _serializer.Serialize(reinterpret_cast<char*>(dataFrame), maxSendSize);
+                uint16_t loaded;
+                uint16_t chunk;
+
+                // Seems we are sending JSON structs, the serializer works in chunks of at most 64KB, so
+                // keep going until the frame is full or the struct is complete.
+                do {
+                    chunk = static_cast<uint16_t>(std::min(maxSendSize - size, static_cast<uint32_t>(0xFFFF)));
+                    loaded = _serializer.Serialize(reinterpret_cast<char*>(&(dataFrame[size])), chunk);
+                    size += loaded;
+
+                } while ((loaded == chunk) && (size < maxSendSize) && (_serializer.IsIdle() == false));
 
                 if (_serializer.IsIdle() == false) {
                     ASSERT(size != 0);
@@ -367,7 +376,7 @@ namespace PluginHost {
 
                 if (_sendQueue.size() != 0) {
                     Package& data(_sendQueue.front());
-                    uint16_t neededBytes(static_cast<uint16_t>(data.Text().length() - _offset));
+                    uint32_t neededBytes(static_cast<uint32_t>(data.Text().length() - _offset));
 
                     if (neededBytes <= maxSendSize) {
                         ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), neededBytes);
@@ -378,7 +387,7 @@ namespace PluginHost {
                         _sendQueue.pop_front();
                     }
                     else {
-                        uint16_t addedBytes = maxSendSize - size;
+                        uint32_t addedBytes = maxSendSize - size;
                         ::memcpy(dataFrame, &(data.Text().c_str()[_offset]), addedBytes);
                         _offset += addedBytes;
                         size = addedBytes;
@@ -406,14 +415,26 @@ namespace PluginHost {
 
             return (size);
         }
-        uint16_t Deserialize(const uint8_t* dataFrame, const uint16_t receivedSize)
+        uint32_t Deserialize(const uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            uint16_t handled = receivedSize;
+            uint32_t handled = receivedSize;
 
             switch (State()) {
             case JSON:
             case JSONRPC: {
-                handled = _deserializer.Deserialize(reinterpret_cast<const char*>(dataFrame), receivedSize);
+                uint16_t loaded;
+                uint16_t chunk;
+
+                // The deserializer works in chunks of at most 64KB as well.
+                handled = 0;
+
+                do {
+                    chunk = static_cast<uint16_t>(std::min(receivedSize - handled, static_cast<uint32_t>(0xFFFF)));
+                    loaded = _deserializer.Deserialize(reinterpret_cast<const char*>(&(dataFrame[handled])), chunk);
+                    handled += loaded;
+
+                } while ((loaded == chunk) && (handled < receivedSize));
+
                 break;
             }
             case TEXT: {
@@ -456,8 +477,8 @@ namespace PluginHost {
 
         // We are in an upgraded mode, we are a websocket. Time to "deserialize and serialize
         // INBOUND and OUTBOUND information.
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
         // If it is a WebSocket, protocol TEXT, This is the feeding back virtual
         virtual void Received(const string& text) = 0;
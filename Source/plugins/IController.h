@@ -138,6 +138,9 @@ namespace IController {
         // @property
         // @brief callstack - Information the callstack associated with the given index 0 - <Max number of threads in the threadpool>
         virtual Core::hresult CallStack(const string& index /* @index */, string& callstack /* @out @opaque */) const = 0;
+        // @property
+        // @brief Provides the contention statistics of the named locks of the framework
+        virtual Core::hresult Locks(string& response /* @out @opaque */) const = 0;
     };
 }
 } // namespace Exchange
@@ -29,6 +29,7 @@ namespace WPEFramework {
             , _service(nullptr)
             , _callsign()
             , _validate()
+            , _notifications(2)
         {
             std::vector<uint8_t> versions = { 1 };
 
@@ -41,6 +42,7 @@ namespace WPEFramework {
             , _service(nullptr)
             , _callsign()
             , _validate()
+            , _notifications(2)
         {
             _handlers.emplace_back(versions);
         }
@@ -51,6 +53,7 @@ namespace WPEFramework {
             , _service(nullptr)
             , _callsign()
             , _validate(validation)
+            , _notifications(2)
         {
             std::vector<uint8_t> versions = { 1 };
 
@@ -63,6 +66,7 @@ namespace WPEFramework {
             , _service(nullptr)
             , _callsign()
             , _validate(validation)
+            , _notifications(2)
         {
             _handlers.emplace_back(versions);
         }
@@ -70,5 +74,35 @@ namespace WPEFramework {
         /* virtual */ JSONRPC::~JSONRPC()
         {
         }
+
+        void JSONRPC::Notify(const uint32_t channelId, const string& designator, const string& event, const string& parameters, Core::ProxyType<Notification::Body>& body)
+        {
+            ASSERT(_service != nullptr);
+
+            if (Notification::IsVerbatim(designator) == false) {
+                Notify(channelId, designator + '.' + event, parameters);
+            }
+            else {
+                if (body.IsValid() == false) {
+                    // The first subscriber serializes the message, with just a dot in front of the event name.
+                    Core::ProxyType<Core::JSONRPC::Message> message(Core::ProxyType<Core::JSONRPC::Message>(IFactories::Instance().JSONRPC()));
+
+                    if (!parameters.empty()) {
+                        message->Parameters = parameters;
+                    }
+
+                    message->Designator = '.' + event;
+                    message->JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+
+                    body = Core::ProxyType<Notification::Body>::Create(*message);
+                }
+
+                Core::ProxyType<Notification> notification(_notifications.Element());
+
+                notification->Set(body, designator);
+
+                _service->Submit(channelId, Core::ProxyType<Core::JSON::IElement>(notification));
+            }
+        }
     }
 }
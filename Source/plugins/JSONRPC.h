@@ -41,6 +41,145 @@ namespace PluginHost {
 
     class EXTERNAL JSONRPC : public ILocalDispatcher, public IDispatcher::ICallback {
     private:
+        // An event is serialized once, for all its subscribers. A Notification sends it to one of them: the
+        // designator of the subscriber is spliced in front of the method, the rest of the text is shared.
+        class Notification : public Core::JSON::IElement {
+        public:
+            class Body {
+            public:
+                Body() = delete;
+                Body(const Body&) = delete;
+                Body& operator=(const Body&) = delete;
+
+                Body(const Core::JSONRPC::Message& message)
+                    : _text()
+                    , _splice(0)
+                {
+                    static constexpr TCHAR Method[] = _T("\"method\":\"");
+
+                    message.ToString(_text);
+
+                    size_t position = _text.find(Method);
+
+                    ASSERT(position != string::npos);
+
+                    _splice = static_cast<uint32_t>(position != string::npos ? position + (sizeof(Method) / sizeof(TCHAR)) - 1 : _text.length());
+                }
+                ~Body() = default;
+
+            public:
+                const string& Text() const
+                {
+                    return (_text);
+                }
+                uint32_t Splice() const
+                {
+                    return (_splice);
+                }
+
+            private:
+                string _text;
+                uint32_t _splice;
+            };
+
+        public:
+            Notification(const Notification&) = delete;
+            Notification& operator=(const Notification&) = delete;
+
+            Notification()
+                : _body()
+                , _designator()
+            {
+            }
+            ~Notification() override = default;
+
+        public:
+            // The designator goes into the text as is, so it may not contain what a JSON string escapes.
+            static bool IsVerbatim(const string& designator)
+            {
+                string::const_iterator index(designator.begin());
+
+                while ((index != designator.end()) && (::isprint(static_cast<uint8_t>(*index))) && (*index != '\"') && (*index != '\\') && (*index != '/')) {
+                    index++;
+                }
+
+                return (index == designator.end());
+            }
+            void Set(const Core::ProxyType<Body>& body, const string& designator)
+            {
+                _body = body;
+                _designator = designator;
+            }
+
+            // IElement iface:
+            void Clear() override
+            {
+                _body.Release();
+                _designator.clear();
+            }
+            bool IsSet() const override
+            {
+                return (_body.IsValid());
+            }
+            bool IsNull() const override
+            {
+                return (false);
+            }
+            uint16_t Serialize(char stream[], const uint16_t maxLength, uint32_t& offset) const override
+            {
+                uint16_t result = 0;
+
+                ASSERT(_body.IsValid() == true);
+
+                const string& text(_body->Text());
+                const uint32_t splice(_body->Splice());
+                const uint32_t designator(static_cast<uint32_t>(_designator.length()));
+                const uint32_t total(static_cast<uint32_t>(text.length()) + designator);
+
+                while ((result < maxLength) && (offset < total)) {
+                    const TCHAR* source;
+                    uint32_t available;
+
+                    if (offset < splice) {
+                        source = &(text[offset]);
+                        available = splice - offset;
+                    }
+                    else if (offset < (splice + designator)) {
+                        source = &(_designator[offset - splice]);
+                        available = (splice + designator) - offset;
+                    }
+                    else {
+                        source = &(text[offset - designator]);
+                        available = total - offset;
+                    }
+
+                    const uint16_t size = static_cast<uint16_t>(std::min(available, static_cast<uint32_t>(maxLength - result)));
+
+                    ::memcpy(&(stream[result]), source, size * sizeof(TCHAR));
+                    result += size;
+                    offset += size;
+                }
+
+                if (offset >= total) {
+                    offset = 0;
+                }
+
+                return (result);
+            }
+            uint16_t Deserialize(const char[], const uint16_t, uint32_t& offset, Core::OptionalType<Core::JSON::Error>& error) override
+            {
+                // Notifications are only sent, never received.
+                offset = 0;
+                error = Core::JSON::Error{ "A notification can not be deserialized" };
+
+                return (0);
+            }
+
+        private:
+            Core::ProxyType<Body> _body;
+            string _designator;
+        };
+
         class Observer {
         private:
             using Destination = std::pair<uint32_t, string>;
@@ -141,9 +280,16 @@ namespace PluginHost {
                 }
             }
             void Event(JSONRPC& parent, const string event, const string& parameter, std::function<bool(const string&)>&& sendifmethod) {
+                Core::ProxyType<Notification::Body> body;
+
                 for (const Destination& entry : _designators) {
                     if (!sendifmethod || sendifmethod(entry.second)) {
+#if THUNDER_PERFORMANCE
+                        // The channel tracks the messages it sends, so each subscriber gets a message of its own.
                         parent.Notify(entry.first, entry.second + '.' + event, parameter);
+#else
+                        parent.Notify(entry.first, entry.second, event, parameter, body);
+#endif
                     }
                 }
                 for (IDispatcher::ICallback*& callback : _callbacks) {
@@ -741,6 +887,7 @@ namespace PluginHost {
 
             _service->Submit(channelId, Core::ProxyType<Core::JSON::IElement>(message));
         }
+        void Notify(const uint32_t channelId, const string& designator, const string& event, const string& parameters, Core::ProxyType<Notification::Body>& body);
 
     private:
         mutable Core::CriticalSection _adminLock;
@@ -750,6 +897,7 @@ namespace PluginHost {
         TokenCheckFunction _validate;
         VersionList _versions;
         ObserverMap _observers;
+        Core::ProxyPoolType<Notification> _notifications;
     };
 
     class EXTERNAL JSONRPCSupportsEventStatus : public PluginHost::JSONRPC {
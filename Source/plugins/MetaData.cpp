@@ -188,28 +188,34 @@ namespace PluginHost
         return (*this);
     }
 
+    /* static */ const Core::JSON::Container::FieldTable& MetaData::Channel::Fields()
+    {
+        static const Core::JSON::Container::FieldTable fields({
+            JSON_CONTAINER_FIELD(Channel, _T("remote"), Remote),
+            JSON_CONTAINER_FIELD(Channel, _T("state"), JSONState),
+            JSON_CONTAINER_FIELD(Channel, _T("activity"), Activity),
+            JSON_CONTAINER_FIELD(Channel, _T("id"), ID),
+            JSON_CONTAINER_FIELD(Channel, _T("name"), Name),
+            JSON_CONTAINER_FIELD(Channel, _T("compression"), Compression),
+            JSON_CONTAINER_FIELD(Channel, _T("compressiontime"), CompressionTime) });
+
+        return (fields);
+    }
+
     MetaData::Channel::Channel()
-        : Core::JSON::Container()
+        : Core::JSON::Container(Fields())
     {
-        Core::JSON::Container::Add(_T("remote"), &Remote);
-        Core::JSON::Container::Add(_T("state"), &JSONState);
-        Core::JSON::Container::Add(_T("activity"), &Activity);
-        Core::JSON::Container::Add(_T("id"), &ID);
-        Core::JSON::Container::Add(_T("name"), &Name);
     }
     MetaData::Channel::Channel(const MetaData::Channel& copy)
-        : Core::JSON::Container()
+        : Core::JSON::Container(Fields())
         , Remote(copy.Remote)
         , JSONState(copy.JSONState)
         , Activity(copy.Activity)
         , ID(copy.ID)
         , Name(copy.Name)
+        , Compression(copy.Compression)
+        , CompressionTime(copy.CompressionTime)
     {
-        Core::JSON::Container::Add(_T("remote"), &Remote);
-        Core::JSON::Container::Add(_T("state"), &JSONState);
-        Core::JSON::Container::Add(_T("activity"), &Activity);
-        Core::JSON::Container::Add(_T("id"), &ID);
-        Core::JSON::Container::Add(_T("name"), &Name);
     }
     MetaData::Channel::~Channel()
     {
@@ -222,26 +228,30 @@ namespace PluginHost
         Activity = RHS.Activity;
         ID = RHS.ID;
         Name = RHS.Name;
+        Compression = RHS.Compression;
+        CompressionTime = RHS.CompressionTime;
 
         return (*this);
     }
 
+    /* static */ const Core::JSON::Container::FieldTable& MetaData::Bridge::Fields()
+    {
+        static const Core::JSON::Container::FieldTable fields({
+            JSON_CONTAINER_FIELD(Bridge, _T("locator"), Locator),
+            JSON_CONTAINER_FIELD(Bridge, _T("latency"), Latency),
+            JSON_CONTAINER_FIELD(Bridge, _T("model"), Model),
+            JSON_CONTAINER_FIELD(Bridge, _T("secure"), Secure) });
+
+        return (fields);
+    }
+
     MetaData::Bridge::Bridge()
-        : Core::JSON::Container()
+        : Core::JSON::Container(Fields())
     {
-        Add(_T("locator"), &Locator);
-        Add(_T("latency"), &Latency);
-        Add(_T("model"), &Model);
-        Add(_T("secure"), &Secure);
     }
     MetaData::Bridge::Bridge(const string& text, const uint32_t latency, const string& model, const bool secure)
-        : Core::JSON::Container()
+        : Core::JSON::Container(Fields())
     {
-        Add(_T("locator"), &Locator);
-        Add(_T("latency"), &Latency);
-        Add(_T("model"), &Model);
-        Add(_T("secure"), &Secure);
-
         Locator = text;
         Latency = latency;
         Secure = secure;
@@ -250,29 +260,32 @@ namespace PluginHost
         }
     }
     MetaData::Bridge::Bridge(const Bridge& copy)
-        : Core::JSON::Container()
+        : Core::JSON::Container(Fields())
         , Locator(copy.Locator)
         , Latency(copy.Latency)
         , Model(copy.Model)
         , Secure(copy.Secure)
     {
-        Add(_T("locator"), &Locator);
-        Add(_T("latency"), &Latency);
-        Add(_T("model"), &Model);
-        Add(_T("secure"), &Secure);
     }
     MetaData::Bridge::~Bridge()
     {
     }
 
-    MetaData::Server::Minion::Minion() 
-        : Core::JSON::Container()
+    /* static */ const Core::JSON::Container::FieldTable& MetaData::Server::Minion::Fields()
+    {
+        static const Core::JSON::Container::FieldTable fields({
+            JSON_CONTAINER_FIELD(Minion, _T("id"), Id),
+            JSON_CONTAINER_FIELD(Minion, _T("job"), Job),
+            JSON_CONTAINER_FIELD(Minion, _T("runs"), Runs) });
+
+        return (fields);
+    }
+
+    MetaData::Server::Minion::Minion()
+        : Core::JSON::Container(Fields())
         , Id(0)
         , Job()
         , Runs(0) {
-        Add(_T("id"), &Id);
-        Add(_T("job"), &Job);
-        Add(_T("runs"), &Runs);
     }
     MetaData::Server::Minion& MetaData::Server::Minion::operator=(const Core::ThreadPool::Metadata& info) {
         Id = (Core::instance_id) info.WorkerId;
@@ -287,13 +300,10 @@ namespace PluginHost
         return (*this);
     }
     MetaData::Server::Minion::Minion(const Minion& copy)
-        : Core::JSON::Container()
+        : Core::JSON::Container(Fields())
         , Id(copy.Id)
         , Job(copy.Job)
         , Runs(copy.Runs) {
-        Add(_T("id"), &Id);
-        Add(_T("job"), &Job);
-        Add(_T("runs"), &Runs);
     }
     MetaData::Server::Minion::~Minion() {
     }
@@ -35,26 +35,18 @@ namespace PluginHost {
             Version(Version&&) = delete;
 
             Version()
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , Hash()
                 , Major(1)
                 , Minor(0)
                 , Patch(0) {
-                Add(_T("hash"), &Hash);
-                Add(_T("major"), &Major);
-                Add(_T("minor"), &Minor);
-                Add(_T("patch"), &Patch);
             }
             Version(const Version& copy)
-                : Core::JSON::Container() 
+                : Core::JSON::Container(Fields())
                 , Hash(copy.Hash)
                 , Major(copy.Major)
                 , Minor(copy.Minor)
                 , Patch(copy.Patch) {
-                Add(_T("hash"), &Hash);
-                Add(_T("major"), &Major);
-                Add(_T("minor"), &Minor);
-                Add(_T("patch"), &Patch);
             }
 
             Version& operator= (const Version& rhs) {
@@ -68,6 +60,18 @@ namespace PluginHost {
             }
             ~Version() override = default;
 
+        private:
+            static const Core::JSON::Container::FieldTable& Fields()
+            {
+                static const Core::JSON::Container::FieldTable fields({
+                    JSON_CONTAINER_FIELD(Version, _T("hash"), Hash),
+                    JSON_CONTAINER_FIELD(Version, _T("major"), Major),
+                    JSON_CONTAINER_FIELD(Version, _T("minor"), Minor),
+                    JSON_CONTAINER_FIELD(Version, _T("patch"), Patch) });
+
+                return (fields);
+            }
+
         public:
             Core::JSON::String Hash;
             Core::JSON::DecUInt8 Major;
@@ -172,12 +176,19 @@ namespace PluginHost {
 
             Channel& operator=(const Channel& RHS);
 
+        private:
+            static const Core::JSON::Container::FieldTable& Fields();
+
         public:
             Core::JSON::String Remote;
             State JSONState;
             Core::JSON::Boolean Activity;
             Core::JSON::DecUInt32 ID;
             Core::JSON::String Name;
+            // Only if permessage-deflate is in use, the size of the compressed messages in percent of the
+            // original size, and the time it took to compress and decompress, in microseconds.
+            Core::JSON::DecUInt8 Compression;
+            Core::JSON::DecUInt64 CompressionTime;
         };
 
         class EXTERNAL Bridge : public Core::JSON::Container {
@@ -189,6 +200,9 @@ namespace PluginHost {
             Bridge(const Bridge& copy);
             ~Bridge();
 
+        private:
+            static const Core::JSON::Container::FieldTable& Fields();
+
         public:
             Core::JSON::String Locator;
             Core::JSON::DecUInt32 Latency;
@@ -208,6 +222,9 @@ namespace PluginHost {
 
                 Minion& operator= (const Core::ThreadPool::Metadata&);
 
+            private:
+                static const Core::JSON::Container::FieldTable& Fields();
+
             public:
                 Core::JSON::InstanceId Id;
                 Core::JSON::String Job;
@@ -269,25 +286,30 @@ namespace PluginHost {
                 Proxy& operator=(const Proxy&) = delete;
 
                 Proxy()
-                    : Core::JSON::Container()
+                    : Core::JSON::Container(Fields())
                     , InterfaceId()
                     , InstanceId()
                     , RefCount() {
-                    Add(_T("interface"), &InterfaceId);
-                    Add(_T("instance"), &InstanceId);
-                    Add(_T("count"), &RefCount);
                 }
                 Proxy(const Proxy& copy)
-                    : Core::JSON::Container()
+                    : Core::JSON::Container(Fields())
                     , InterfaceId(copy.InterfaceId)
                     , InstanceId(copy.InstanceId)
                     , RefCount(copy.RefCount) {
-                    Add(_T("interface"), &InterfaceId);
-                    Add(_T("instance"), &InstanceId);
-                    Add(_T("count"), &RefCount);
                 }
                 ~Proxy() override = default;
 
+            private:
+                static const Core::JSON::Container::FieldTable& Fields()
+                {
+                    static const Core::JSON::Container::FieldTable fields({
+                        JSON_CONTAINER_FIELD(Proxy, _T("interface"), InterfaceId),
+                        JSON_CONTAINER_FIELD(Proxy, _T("instance"), InstanceId),
+                        JSON_CONTAINER_FIELD(Proxy, _T("count"), RefCount) });
+
+                    return (fields);
+                }
+
             public:
                 Core::JSON::DecUInt32 InterfaceId;
                 Core::JSON::InstanceId InstanceId;
@@ -298,18 +320,14 @@ namespace PluginHost {
             COMRPC& operator= (const COMRPC&) = delete;
 
             COMRPC()
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , Remote()
                 , Proxies() {
-                Add(_T("link"), &Remote);
-                Add(_T("proxies"), &Proxies);
             }
             COMRPC(const COMRPC& copy)
-                : Core::JSON::Container()
+                : Core::JSON::Container(Fields())
                 , Remote(copy.Remote)
                 , Proxies(copy.Proxies) {
-                Add(_T("link"), &Remote);
-                Add(_T("proxies"), &Proxies);
             }
             ~COMRPC() override = default;
 
@@ -318,10 +336,88 @@ namespace PluginHost {
                 Proxies.Clear();
             }
 
+        private:
+            static const Core::JSON::Container::FieldTable& Fields()
+            {
+                static const Core::JSON::Container::FieldTable fields({
+                    JSON_CONTAINER_FIELD(COMRPC, _T("link"), Remote),
+                    JSON_CONTAINER_FIELD(COMRPC, _T("proxies"), Proxies) });
+
+                return (fields);
+            }
+
         public:
             Core::JSON::String Remote;
             Core::JSON::ArrayType<Proxy> Proxies;
         };
+        class EXTERNAL Lock : public Core::JSON::Container {
+        public:
+            Lock& operator=(const Lock&) = delete;
+
+            Lock()
+                : Core::JSON::Container(Fields())
+                , Name()
+                , Instances()
+                , Locks()
+                , Contended()
+                , WaitTime()
+                , MaxWaitTime()
+                , HoldTime()
+                , MaxHoldTime() {
+            }
+            Lock(const Lock& copy)
+                : Core::JSON::Container(Fields())
+                , Name(copy.Name)
+                , Instances(copy.Instances)
+                , Locks(copy.Locks)
+                , Contended(copy.Contended)
+                , WaitTime(copy.WaitTime)
+                , MaxWaitTime(copy.MaxWaitTime)
+                , HoldTime(copy.HoldTime)
+                , MaxHoldTime(copy.MaxHoldTime) {
+            }
+            ~Lock() override = default;
+
+            Lock& operator=(const Core::CriticalSection::Metadata& info) {
+                Name = info.Name;
+                Instances = info.Instances;
+                Locks = info.Locks;
+                Contended = info.Contended;
+                WaitTime = info.WaitTime;
+                MaxWaitTime = info.MaxWaitTime;
+                // The average of the sampled ones.
+                HoldTime = (info.HoldSamples != 0 ? (info.HoldTime / info.HoldSamples) : 0);
+                MaxHoldTime = info.MaxHoldTime;
+                return (*this);
+            }
+
+        private:
+            static const Core::JSON::Container::FieldTable& Fields()
+            {
+                static const Core::JSON::Container::FieldTable fields({
+                    JSON_CONTAINER_FIELD(Lock, _T("name"), Name),
+                    JSON_CONTAINER_FIELD(Lock, _T("instances"), Instances),
+                    JSON_CONTAINER_FIELD(Lock, _T("locks"), Locks),
+                    JSON_CONTAINER_FIELD(Lock, _T("contended"), Contended),
+                    JSON_CONTAINER_FIELD(Lock, _T("waittime"), WaitTime),
+                    JSON_CONTAINER_FIELD(Lock, _T("maxwaittime"), MaxWaitTime),
+                    JSON_CONTAINER_FIELD(Lock, _T("holdtime"), HoldTime),
+                    JSON_CONTAINER_FIELD(Lock, _T("maxholdtime"), MaxHoldTime) });
+
+                return (fields);
+            }
+
+        public:
+            Core::JSON::String Name;
+            Core::JSON::DecUInt32 Instances;
+            Core::JSON::DecUInt64 Locks;
+            Core::JSON::DecUInt64 Contended;
+            // In microseconds.
+            Core::JSON::DecUInt64 WaitTime;
+            Core::JSON::DecUInt64 MaxWaitTime;
+            Core::JSON::DecUInt64 HoldTime;
+            Core::JSON::DecUInt64 MaxHoldTime;
+        };
     public:
         MetaData(MetaData&&) = delete;
         MetaData(const MetaData&) = delete;
@@ -119,6 +119,38 @@ namespace PluginHost {
         }
     }
 
+    void Service::FileToServe(const Web::Request& request, Web::Response& response, bool allowUnsafePath)
+    {
+        FileToServe(request.Path, response, allowUnsafePath);
+
+        if (response.HasBody() == true) {
+            Core::ProxyType<Web::FileBody> fileBody(response.Body<Web::FileBody>());
+
+            if ((fileBody.IsValid() == true) && (fileBody->Exists() == true)) {
+                response.AcceptRange = _T("bytes");
+
+                if (request.Range.IsSet() == true) {
+                    switch (fileBody->Range(request.Range.Value())) {
+                    case Web::FileBody::RANGE_SATISFIABLE:
+                        response.ErrorCode = Web::STATUS_PARTIAL_CONTENT;
+                        response.Message = _T("Partial Content");
+                        response.ContentRange = fileBody->ContentRange();
+                        break;
+                    case Web::FileBody::RANGE_UNSATISFIABLE:
+                        response.ErrorCode = Web::STATUS_REQUEST_RANGE_NOT_SATISFIABLE;
+                        response.Message = _T("Range Not Satisfiable");
+                        response.Body<Web::IBody>(Core::ProxyType<Web::IBody>());
+                        response.ContentRange = fileBody->ContentRange();
+                        break;
+                    default:
+                        // A range we do not understand or support, is ignored. The whole file it is.
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
     bool Service::IsWebServerRequest(const string& segment) const
     {
         // Prefix length, no need to compare, that has already been doen, otherwise
@@ -421,6 +421,8 @@ namespace PluginHost {
         #endif
 
         void FileToServe(const string& webServiceRequest, Web::Response& response, bool allowUnsafePath);
+        // As above, honouring the Range header of the request.
+        void FileToServe(const Web::Request& request, Web::Response& response, bool allowUnsafePath);
 
     private:
         mutable Core::CriticalSection _adminLock;
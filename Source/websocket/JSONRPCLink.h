@@ -69,6 +69,10 @@ namespace WPEFramework {
 						{
 							return (!operator==(rhs));
 						}
+						size_t Hash() const
+						{
+							return (reinterpret_cast<size_t>(_client));
+						}
 
 					public:
 						uint64_t Timed(const uint64_t scheduledTime) {
@@ -131,6 +135,8 @@ namespace WPEFramework {
 						: BaseClass(5, FactoryImpl::Instance(), callsign, _T("JSON"), query, "", false, false, false, remoteNode.AnyInterface(), remoteNode, 256, 256)
 						, _parent(*parent)
 					{
+						BaseClass::Link().Compression(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+						BaseClass::Link().Link().AdaptiveBuffers(1024 * 1024, 1024 * 1024);
 					}
 					~ChannelImpl() override = default;
 
@@ -729,10 +735,11 @@ namespace WPEFramework {
 				string emptyString(EMPTY_STRING);
 				uint32_t result = Send(waitTime, method, emptyString, response);
 				if (result == Core::ERROR_NONE) {
+					string buffer;
 					if (response->Error.IsSet() == true) {
 						result = response->Error.Code.Value();
 					}
-					else if ((response->Result.IsSet() == true) && (response->Result.Value().empty() == false)) {
+					else if ((response->Result.IsSet() == true) && (response->Result.Value(buffer).empty() == false)) {
 						sendObject.Clear();
 						FromMessage((INTERFACE*)&sendObject, *response);
 					}
@@ -810,11 +817,12 @@ namespace WPEFramework {
 				Core::ProxyType<Core::JSONRPC::Message> response;
 				uint32_t result = Send(waitTime, method, parameters, response);
 				if (result == Core::ERROR_NONE) {
+					string buffer;
 					if (response->Error.IsSet() == true) {
 						result = response->Error.Code.Value();
 					}
 					else if ((response->Result.IsSet() == true)
-						&& (response->Result.Value().empty() == false)) {
+						&& (response->Result.Value(buffer).empty() == false)) {
 						FromMessage((INTERFACE*)&inbound, *response);
 					}
 				}
@@ -1083,8 +1091,9 @@ namespace WPEFramework {
 						// Looks like this is an event.
 						ASSERT(inbound->Id.IsSet() == false);
 
+						string buffer;
 						string response;
-						_handler.Invoke(Core::JSONRPC::Context(), inbound->FullMethod(), inbound->Parameters.Value(), response);
+						_handler.Invoke(Core::JSONRPC::Context(), inbound->FullMethod(), inbound->Parameters.Value(buffer), response);
 					}
 				}
 
@@ -1125,7 +1134,8 @@ namespace WPEFramework {
 			}
 			void FromMessage(Core::JSON::IElement* response, const Core::JSONRPC::Message& message)
 			{
-				response->FromString(message.Result.Value());
+				string buffer;
+				response->FromString(message.Result.Value(buffer));
 			}
 			void FromMessage(Core::JSON::IMessagePack* response, const Core::JSONRPC::Message& message)
 			{
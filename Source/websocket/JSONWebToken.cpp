@@ -65,8 +65,11 @@ namespace Web
 
     JSONWebToken::JSONWebToken(const mode type, const uint8_t length, const uint8_t key[])
         : _mode(type)
-        , _key(string(reinterpret_cast<const char*>(key), length))
+        , _key()
     {
+        // The key is hashed into the HMAC state once, every token continues from there.
+        Crypto::SHA256HMAC::Prepare(string(reinterpret_cast<const char*>(key), length), _key);
+
         Core::EnumerateType<mode> modeData(type);
         string sourceBuffer(_T("{\"alg\":\"") + string(modeData.Data()) + _T("\",\"typ\":\"JWT\"}"));
         uint16_t sourceLength = static_cast<uint16_t>(sourceBuffer.length());
@@ -50,7 +50,7 @@ namespace Web {
 	private:
         mode _mode;
         string _header; 
-		string _key;
+        Crypto::SHA256HMAC::KeyContext _key;
     };
 
 } } // namespace WPEFramework::Web
@@ -36,6 +36,14 @@ namespace Web {
         using ThisClass = WebLinkType<LINK, INBOUND, OUTBOUND, ALLOCATOR, TRANSFORM>;
         using AllocatorType = typename std::remove_reference<ALLOCATOR>::type;
 
+        // A body kept in a file is sent straight from the file (see Core::SocketPort::SendFile), if
+        // nothing is transformed on the way and the link is a stream the socket asks for it on.
+        static constexpr bool ZeroCopy = (std::is_same<TRANSFORM, NoTransform>::value) && ((std::is_base_of<Core::SocketStream, LINK>::value)
+#if defined(SECURESOCKETS_ENABLED)
+            || (std::is_base_of<Crypto::SecureSocketPort, LINK>::value)
+#endif
+        );
+
         class SerializerImpl : public BaseSerializer {
         public:
             SerializerImpl() = delete;
@@ -193,16 +201,25 @@ namespace Web {
                 return (*this);
             }
             // Methods to extract and insert data into the socket buffers
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
             {
                 _activity = true;
                 return (_parent.SendData( dataFrame, maxSendSize));
             }
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
             {
                 _activity = true;
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
+            bool SendFile(Core::SocketPort::Region& region) override
+            {
+                return (_parent._serializerImpl.Transfer(region));
+            }
+            void FileSent() override
+            {
+                _activity = true;
+                _parent._serializerImpl.Transferred();
+            }
             // Signal a state change, Opened, Closed or Accepted
             void StateChange() override
             {
@@ -226,6 +243,7 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
             , _deserialiserImpl(*this, queueSize)
             , _channel(*this, std::forward<Args>(args)...)
         {
+            _serializerImpl.ZeroCopy(ZeroCopy);
         }
         template <typename... Args>
         WebLinkType(const uint8_t queueSize, ALLOCATOR responseAllocator, Args&&... args)
@@ -233,6 +251,7 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
             , _deserialiserImpl(*this, responseAllocator)
             , _channel(*this, std::forward<Args>(args)...)
         {
+            _serializerImpl.ZeroCopy(ZeroCopy);
         }
 POP_WARNING()
         virtual ~WebLinkType()
@@ -325,30 +344,31 @@ POP_WARNING()
 
         template <typename CLASSNAME = TRANSFORM>
         inline typename Core::TypeTraits::enable_if<hasTransform<CLASSNAME, uint16_t, BaseDeserializer&, uint8_t*, const uint16_t>::value, uint16_t>::type
-        ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize)
+        ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            return (_transformer.Transform(_deserialiserImpl, dataFrame, receivedSize));
+            return (_transformer.Transform(_deserialiserImpl, dataFrame, static_cast<uint16_t>(std::min(receivedSize, static_cast<uint32_t>(0xFFFF)))));
         }
 
         template <typename CLASSNAME = TRANSFORM>
         inline typename Core::TypeTraits::enable_if<!hasTransform<CLASSNAME, uint16_t, BaseDeserializer&, uint8_t*, const uint16_t>::value, uint16_t>::type
-        ReceiveData( uint8_t* dataFrame, const uint16_t receivedSize)
+        ReceiveData( uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            return (_deserialiserImpl.Deserialize(dataFrame, receivedSize));
+            return (_deserialiserImpl.Deserialize(dataFrame, static_cast<uint16_t>(std::min(receivedSize, static_cast<uint32_t>(0xFFFF)))));
         }
 
         template <typename CLASSNAME = TRANSFORM>
         inline typename Core::TypeTraits::enable_if<hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value, uint16_t>::type
-        SendData(uint8_t* dataFrame, const uint16_t receivedSize)
+        SendData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            return (_transformer.Transform(_serializerImpl, dataFrame, receivedSize));
+            // The serializers work in chunks of at most 64KB, the send buffer can be larger.
+            return (_transformer.Transform(_serializerImpl, dataFrame, static_cast<uint16_t>(std::min(receivedSize, static_cast<uint32_t>(0xFFFF)))));
         }
 
         template <typename CLASSNAME=TRANSFORM>
         inline typename Core::TypeTraits::enable_if<!hasTransform<CLASSNAME, uint16_t, BaseSerializer&, uint8_t*, const uint16_t>::value, uint16_t>::type
-        SendData(uint8_t* dataFrame, const uint16_t receivedSize)
+        SendData(uint8_t* dataFrame, const uint32_t receivedSize)
         {
-            return (_serializerImpl.Serialize(dataFrame, receivedSize));
+            return (_serializerImpl.Serialize(dataFrame, static_cast<uint16_t>(std::min(receivedSize, static_cast<uint32_t>(0xFFFF)))));
         }
 
     private:
@@ -97,6 +97,13 @@ namespace Web {
         // The Serialize and Deserialize methods allow the content to be serialized/deserialized.
         virtual uint16_t Serialize(uint8_t[] /* stream*/, const uint16_t /* maxLength */) const = 0;
         virtual uint16_t Deserialize(const uint8_t[] /* stream*/, const uint16_t /* maxLength */) = 0;
+
+        // A body that is kept in a file can tell where the content still to be serialized is, so a
+        // stream link can send it from the file directly instead of calling Serialize.
+        virtual bool Region(Core::SocketPort::Region& /* region */) const
+        {
+            return (false);
+        }
     };
 
     class EXTERNAL Signature {
@@ -250,7 +257,8 @@ namespace Web {
             MAN,
             M_X,
             S_T,
-			AUTHORIZATION
+			AUTHORIZATION,
+            RANGE
         };
 
         enum type {
@@ -292,7 +300,9 @@ namespace Web {
                 PAIR_KEY = 6,
                 PAIR_VALUE = 7,
                 BODY = 8,
-                REPORT = 9
+                REPORT = 9,
+                FILE = 10,
+                TRANSFER = 11
             };
             const static uint16_t EOL_MARKER = 0x8000;
 
@@ -309,6 +319,7 @@ namespace Web {
                 , _buffer(nullptr)
                 , _lock()
                 , _current()
+                , _zeroCopy(false)
             {
             }
             virtual ~Serializer() = default;
@@ -339,7 +350,16 @@ namespace Web {
                 _lock.Unlock();
             }
 
+            // Set by a link that can send a file region (see Core::SocketPort::SendFile). A body that
+            // has a Region is then not serialized, Transfer hands it out and Transferred completes it.
+            void ZeroCopy(const bool enabled)
+            {
+                _zeroCopy = enabled;
+            }
+
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength);
+            bool Transfer(Core::SocketPort::Region& region);
+            void Transferred();
 
         private:
             uint16_t _state;
@@ -350,6 +370,7 @@ namespace Web {
             const TCHAR* _buffer;
             Core::CriticalSection _lock;
             Request* _current;
+            bool _zeroCopy;
         };
         class EXTERNAL Deserializer {
         private:
@@ -100,7 +100,9 @@ namespace Web {
             U_S_N,
             S_T,
             CACHE_CONTROL,
-            APPLICATION_URL
+            APPLICATION_URL,
+            CONTENT_RANGE,
+            WEBSOCKET_EXTENSIONS
         };
 
         enum upgrade {
@@ -125,7 +127,9 @@ namespace Web {
                 PAIR_KEY = 4,
                 PAIR_VALUE = 5,
                 BODY = 6,
-                REPORT = 7
+                REPORT = 7,
+                FILE = 8,
+                TRANSFER = 9
             };
 
             const static uint16_t EOL_MARKER = 0x8000;
@@ -143,6 +147,7 @@ namespace Web {
                 , _buffer(nullptr)
                 , _lock()
                 , _current()
+                , _zeroCopy(false)
             {
             }
             virtual ~Serializer() = default;
@@ -173,7 +178,16 @@ namespace Web {
                 _lock.Unlock();
             }
 
+            // Set by a link that can send a file region (see Core::SocketPort::SendFile). A body that
+            // has a Region is then not serialized, Transfer hands it out and Transferred completes it.
+            void ZeroCopy(const bool enabled)
+            {
+                _zeroCopy = enabled;
+            }
+
             uint16_t Serialize(uint8_t stream[], const uint16_t maxLength);
+            bool Transfer(Core::SocketPort::Region& region);
+            void Transferred();
 
         private:
             uint16_t _state;
@@ -184,6 +198,7 @@ namespace Web {
             const TCHAR* _buffer;
             Core::CriticalSection _lock;
             Response* _current;
+            bool _zeroCopy;
         };
         class EXTERNAL Deserializer {
         private:
@@ -387,11 +402,13 @@ POP_WARNING()
             Server.Clear();
             Modified.Clear();
             AcceptRange.Clear();
+            ContentRange.Clear();
             ETag.Clear();
             ContentType.Clear();
             ContentLength.Clear();
             ContentEncoding.Clear();
             WebSocketAccept.Clear();
+            WebSocketExtensions.Clear();
             AccessControlOrigin.Clear();
             AccessControlMethod.Clear();
             AccessControlHeaders.Clear();
@@ -433,6 +450,7 @@ POP_WARNING()
         Core::OptionalType<string> AccessControlHeaders;
         Core::OptionalType<uint32_t> AccessControlMaxAge;
         Core::OptionalType<string> AcceptRange;
+        Core::OptionalType<string> ContentRange;
         Core::OptionalType<connection> Connection;
         Core::OptionalType<string> ST;
         Core::OptionalType<string> USN;
@@ -440,6 +458,7 @@ POP_WARNING()
         Core::OptionalType<string> WakeUp;
         Core::OptionalType<string> ETag;
         Core::OptionalType<string> WebSocketProtocol;
+        Core::OptionalType<string> WebSocketExtensions;
         Core::OptionalType<string> CacheControl;
         Core::OptionalType<Core::URL> ApplicationURL;
 
@@ -85,6 +85,7 @@ static const TCHAR __LOCATION[] = _T("LOCATION:");
 static const TCHAR __WAKEUP[] = _T("WAKEUP:");
 static const TCHAR __CACHE_CONTROL[] = _T("CACHE-CONTROL:");
 static const TCHAR __APPLICATION_URL[] = _T("APPLICATION-URL:");
+static const TCHAR __CONTENT_RANGE[] = _T("CONTENT-RANGE:");
 
 static const TCHAR __CHARACTER_SET[] = _T("CHARSET=");
 
@@ -227,11 +228,13 @@ ENUM_CONVERSION_BEGIN(Web::Request::keywords)
     { Web::Request::ACCESS_CONTROL_REQUEST_HEADERS, __TXT(__ACCESS_CONTROL_REQUEST_HEADERS) },
     { Web::Request::WEBSOCKET_KEY, __TXT(__WEBSOCKET_KEY) },
     { Web::Request::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
+    { Web::Request::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Request::WEBSOCKET_VERSION, __TXT(__WEBSOCKET_VERSION) },
     { Web::Request::MAN, __TXT(__MAN) },
     { Web::Request::M_X, __TXT(__MX) },
     { Web::Request::S_T, __TXT(__ST) },
     { Web::Request::AUTHORIZATION, __TXT(__AUTHORIZATION) },
+    { Web::Request::RANGE, __TXT(__RANGE) },
 
 ENUM_CONVERSION_END(Web::Request::keywords)
 
@@ -272,12 +275,14 @@ ENUM_CONVERSION_BEGIN(Web::Response::keywords)
     { Web::Response::ACCESS_CONTROL_MAX_AGE, __TXT(__ACCESS_CONTROL_MAX_AGE) },
     { Web::Response::WEBSOCKET_ACCEPT, __TXT(__WEBSOCKET_ACCEPT) },
     { Web::Response::WEBSOCKET_PROTOCOL, __TXT(__WEBSOCKET_PROTOCOL) },
+    { Web::Response::WEBSOCKET_EXTENSIONS, __TXT(__WEBSOCKET_EXTENSIONS) },
     { Web::Response::LOCATION, __TXT(__LOCATION) },
     { Web::Response::WAKEUP, __TXT(__WAKEUP) },
     { Web::Response::U_S_N, __TXT(__USN) },
     { Web::Response::S_T, __TXT(__ST) },
     { Web::Response::CACHE_CONTROL, __TXT(__CACHE_CONTROL) },
     { Web::Response::APPLICATION_URL, __TXT(__APPLICATION_URL) },
+    { Web::Response::CONTENT_RANGE, __TXT(__CONTENT_RANGE) },
 
 ENUM_CONVERSION_END(Web::Response::keywords)
 
@@ -511,6 +516,85 @@ namespace Web
         }
     }
 
+    static bool RangeValue(const string& text, const size_t start, const size_t end, uint64_t& value)
+    {
+        size_t index = start;
+
+        value = 0;
+
+        while ((index < end) && (isdigit(text[index]) != 0) && (value < (static_cast<uint64_t>(~0) / 10))) {
+            value = (value * 10) + (text[index] - '0');
+            index++;
+        }
+
+        return ((index != start) && (index == end));
+    }
+
+    FileBody::range FileBody::Range(const string& header)
+    {
+        static const TCHAR Unit[] = _T("bytes=");
+
+        // The length of a body is 32 bits, a longer range is cut short. The Content-Range tells what is sent.
+        static constexpr uint64_t MaxRangeSize = (static_cast<uint32_t>(~0) - 1);
+
+        const size_t separator = header.find('-');
+        range result = RANGE_IGNORED;
+
+        LoadFileInfo();
+
+        const uint64_t total = (Core::File::Size() > static_cast<uint64_t>(_startPosition) ? Core::File::Size() - _startPosition : 0);
+
+        if ((header.compare(0, sizeof(Unit) - 1, Unit) == 0) && (separator != string::npos) && (header.find(',') == string::npos)) {
+            uint64_t first = 0;
+            uint64_t last = 0;
+
+            if (separator == (sizeof(Unit) - 1)) {
+                // The last bytes of the file.
+                if (RangeValue(header, separator + 1, header.length(), last) == true) {
+                    if ((last == 0) || (total == 0)) {
+                        result = RANGE_UNSATISFIABLE;
+                    } else {
+                        first = total - std::min(last, total);
+                        last = total - 1;
+                        result = RANGE_SATISFIABLE;
+                    }
+                }
+            } else if (RangeValue(header, sizeof(Unit) - 1, separator, first) == true) {
+                if (separator == (header.length() - 1)) {
+                    last = ~0;
+                    result = RANGE_SATISFIABLE;
+                } else if ((RangeValue(header, separator + 1, header.length(), last) == true) && (last >= first)) {
+                    result = RANGE_SATISFIABLE;
+                }
+
+                if (result == RANGE_SATISFIABLE) {
+                    if (first >= total) {
+                        result = RANGE_UNSATISFIABLE;
+                    } else {
+                        last = std::min(last, total - 1);
+                    }
+                }
+            }
+
+            if (result == RANGE_SATISFIABLE) {
+                _rangeOffset = first;
+                _rangeSize = std::min(last - first + 1, MaxRangeSize);
+            }
+        }
+
+        return (result);
+    }
+
+    string FileBody::ContentRange() const
+    {
+        const uint64_t total = (Core::File::Size() > static_cast<uint64_t>(_startPosition) ? Core::File::Size() - _startPosition : 0);
+
+        // Without a range, this is what goes with a 416 (Range Not Satisfiable).
+        return (_rangeSize == 0 ?
+            _T("bytes */") + std::to_string(total) :
+            _T("bytes ") + std::to_string(_rangeOffset) + '-' + std::to_string(_rangeOffset + _rangeSize - 1) + '/' + std::to_string(total));
+    }
+
     uint16_t Request::Serializer::Serialize(uint8_t stream[], const uint16_t maxLength)
     {
         uint16_t current = 0;
@@ -529,7 +613,7 @@ namespace Web
         }
 
         if (_current != nullptr) {
-            while ((current < maxLength) && (_state != REPORT)) {
+            while ((current < maxLength) && (_state != REPORT) && (_state != FILE) && (_state != TRANSFER)) {
                 while ((current < maxLength) && ((_state & EOL_MARKER) == EOL_MARKER)) {
                     if (_offset == 0) {
                         stream[current++] = '\r';
@@ -874,7 +958,12 @@ namespace Web
                     break;
                 }
                 case BODY: {
-                    if (_bodyLength != 0) {
+                    Core::SocketPort::Region region;
+
+                    if ((_zeroCopy == true) && (_bodyLength != 0) && (_current->_body->Region(region) == true)) {
+                        // The link takes it from here, see Transfer.
+                        _state = FILE;
+                    } else if (_bodyLength != 0) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
 
@@ -887,7 +976,7 @@ namespace Web
                         }
                     }
 
-                    if (_bodyLength == 0) {
+                    if ((_bodyLength == 0) && (_state == BODY)) {
                         _state = REPORT;
                     }
                     break;
@@ -928,7 +1017,7 @@ namespace Web
         }
 
         if (_current != nullptr) {
-            while ((current < maxLength) && (_state != REPORT)) {
+            while ((current < maxLength) && (_state != REPORT) && (_state != FILE) && (_state != TRANSFER)) {
                 while ((current < maxLength) && ((_state & EOL_MARKER) == EOL_MARKER)) {
                     if (_offset == 0) {
                         stream[current++] = '\r';
@@ -1210,6 +1299,16 @@ namespace Web
                             _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_SIGNATURE : _T("Content-HMAC:"));
                             FromSignature(_current->ContentSignature.Value(), _value);
                             _offset = 0;
+                        } else if ((_keyIndex <= 25) && (_current->ContentRange.IsSet() == true)) {
+                            _keyIndex = 26;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __CONTENT_RANGE : _T("Content-Range:"));
+                            _value = _current->ContentRange.Value();
+                            _offset = 0;
+                        } else if ((_keyIndex <= 26) && (_current->WebSocketExtensions.IsSet() == true)) {
+                            _keyIndex = 27;
+                            _buffer = (_current->Mode() == MARSHAL_UPPERCASE ? __WEBSOCKET_EXTENSIONS : _T("Sec-WebSocket-Extensions:"));
+                            _value = _current->WebSocketExtensions.Value();
+                            _offset = 0;
                         }
                     }
 
@@ -1253,7 +1352,12 @@ namespace Web
                     break;
                 }
                 case BODY: {
-                    if (_bodyLength != 0) {
+                    Core::SocketPort::Region region;
+
+                    if ((_zeroCopy == true) && (_bodyLength != 0) && (_current->_body->Region(region) == true)) {
+                        // The link takes it from here, see Transfer.
+                        _state = FILE;
+                    } else if (_bodyLength != 0) {
                         ASSERT(maxLength >= current);
                         uint32_t size = (static_cast<uint32_t>(maxLength - current) <= _bodyLength ? static_cast<uint32_t>(maxLength - current) : _bodyLength);
 
@@ -1266,7 +1370,7 @@ namespace Web
                         }
                     }
 
-                    if (_bodyLength == 0) {
+                    if ((_bodyLength == 0) && (_state == BODY)) {
                         _state = REPORT;
                     }
                     break;
@@ -1289,6 +1393,42 @@ namespace Web
         return (current);
     }
 
+    bool Request::Serializer::Transfer(Core::SocketPort::Region& region)
+    {
+        bool result = false;
+
+        _lock.Lock();
+
+        if (_state == FILE) {
+            ASSERT(_current != nullptr);
+
+            result = _current->_body->Region(region);
+
+            ASSERT(result == true);
+
+            // Only what was announced in the Content-Length.
+            region.Size = std::min(region.Size, static_cast<uint64_t>(_bodyLength));
+            _state = TRANSFER;
+        }
+
+        _lock.Unlock();
+
+        return (result);
+    }
+
+    void Request::Serializer::Transferred()
+    {
+        _lock.Lock();
+
+        // After a Flush, there is nothing to complete anymore.
+        if (_state == TRANSFER) {
+            _bodyLength = 0;
+            _state = REPORT;
+        }
+
+        _lock.Unlock();
+    }
+
     uint16_t Request::Deserializer::Parse(const uint8_t stream[], const uint16_t maxLength)
     {
         ASSERT(_current != nullptr);
@@ -1497,6 +1637,9 @@ namespace Web
             case Request::AUTHORIZATION:
                 _current->WebToken = ToAuthorization(buffer);
                 break;
+            case Request::RANGE:
+                _current->Range = buffer;
+                break;
             case Request::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1685,6 +1828,42 @@ namespace Web
         }
     }
 
+    bool Response::Serializer::Transfer(Core::SocketPort::Region& region)
+    {
+        bool result = false;
+
+        _lock.Lock();
+
+        if (_state == FILE) {
+            ASSERT(_current != nullptr);
+
+            result = _current->_body->Region(region);
+
+            ASSERT(result == true);
+
+            // Only what was announced in the Content-Length.
+            region.Size = std::min(region.Size, static_cast<uint64_t>(_bodyLength));
+            _state = TRANSFER;
+        }
+
+        _lock.Unlock();
+
+        return (result);
+    }
+
+    void Response::Serializer::Transferred()
+    {
+        _lock.Lock();
+
+        // After a Flush, there is nothing to complete anymore.
+        if (_state == TRANSFER) {
+            _bodyLength = 0;
+            _state = REPORT;
+        }
+
+        _lock.Unlock();
+    }
+
     uint16_t Response::Deserializer::Parse(const uint8_t stream[], const uint16_t maxLength)
     {
         ASSERT(_current != nullptr);
@@ -1849,6 +2028,9 @@ namespace Web
             case Response::WEBSOCKET_PROTOCOL:
                 _current->WebSocketProtocol = buffer;
                 break;
+            case Response::WEBSOCKET_EXTENSIONS:
+                _current->WebSocketExtensions = buffer;
+                break;
             case Response::CONTENT_SIGNATURE:
                 _current->ContentSignature = ToSignature(buffer);
                 break;
@@ -1867,6 +2049,9 @@ namespace Web
             case Response::APPLICATION_URL:
                 _current->ApplicationURL = Core::URL(buffer);
                 break;
+            case Response::CONTENT_RANGE:
+                _current->ContentRange = buffer;
+                break;
             case Response::CACHE_CONTROL:
                 _current->CacheControl = buffer;
                 break;
@@ -142,6 +142,13 @@ namespace Web {
     };
 
     class EXTERNAL FileBody : public Core::File, public IBody {
+    public:
+        enum range : uint8_t {
+            RANGE_IGNORED, // Not a (supported) range, serve the whole body.
+            RANGE_SATISFIABLE, // The body is limited to the range.
+            RANGE_UNSATISFIABLE // A valid range, but none of it is in the body.
+        };
+
     public:
         FileBody(const FileBody&) = delete;
         FileBody& operator=(const FileBody&) = delete;
@@ -150,12 +157,16 @@ namespace Web {
             : Core::File()
             , _opened(false)
             , _startPosition(0)
+            , _rangeOffset(0)
+            , _rangeSize(0)
         {
         }
         FileBody(const string& path)
             : Core::File(path)
             , _opened(false)
             , _startPosition(0)
+            , _rangeOffset(0)
+            , _rangeSize(0)
         {
         }
         ~FileBody() override = default;
@@ -165,6 +176,8 @@ namespace Web {
         {
             Core::File::operator=(location);
             _startPosition = 0;
+            _rangeOffset = 0;
+            _rangeSize = 0;
 
             return (*this);
         }
@@ -172,13 +185,24 @@ namespace Web {
         {
             Core::File::operator=(RHS);
             _startPosition = static_cast<int32_t>(Core::File::Position());
+            _rangeOffset = 0;
+            _rangeSize = 0;
 
             return (*this);
         }
 
+        // Limit the body to the range of a Range request header ("bytes=first-last", "bytes=first-" or
+        // "bytes=-suffix"), only a single range is supported. Anything else, including a header that does
+        // not parse, is to be ignored (RFC 7233), only a valid range beyond the end of the body can not be
+        // satisfied. In both cases the body is left as it was. ContentRange describes the range for the response.
+        range Range(const string& header);
+        string ContentRange() const;
+
     protected:
         uint32_t Serialize() const override
         {
+            uint32_t result = 0;
+
             // Are we opening the file ?
             _opened = (Core::File::IsOpen() == false);
 
@@ -186,7 +210,26 @@ namespace Web {
                 const_cast<FileBody*>(this)->LoadFileInfo();
                 const_cast<FileBody*>(this)->Position(false, _startPosition);
             }
-            return (((_opened == false) || (Core::File::Open() == true)) ? static_cast<uint32_t>(Core::File::Size() - _startPosition) : 0);
+            if ((_opened == false) || (Core::File::Open() == true)) {
+                result = static_cast<uint32_t>(Core::File::Size() - _startPosition);
+
+                if (_rangeSize != 0) {
+                    const_cast<FileBody*>(this)->Position(false, _startPosition + _rangeOffset);
+                    result = static_cast<uint32_t>(_rangeSize);
+                }
+            }
+            return (result);
+        }
+        bool Region(Core::SocketPort::Region& region) const override
+        {
+            const int64_t position = Core::File::Position();
+
+            // Read where the content is, the file position is left as is.
+            region.Descriptor = static_cast<Core::File::Handle>(*const_cast<FileBody*>(this));
+            region.Offset = static_cast<uint64_t>(position);
+            region.Size = (Core::File::Size() > region.Offset ? Core::File::Size() - region.Offset : 0);
+
+            return (true);
         }
         uint32_t Deserialize() override
         {
@@ -224,6 +267,8 @@ namespace Web {
     private:
         mutable bool _opened;
         mutable int32_t _startPosition;
+        uint64_t _rangeOffset;
+        uint64_t _rangeSize;
     };
 
     template <typename HASHALGORITHM>
@@ -19,6 +19,18 @@
 
 #include "WebSocketLink.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define __WEBSOCKET_MASK_SSE2__
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define __WEBSOCKET_MASK_AVX2__
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define __WEBSOCKET_MASK_NEON__
+#include <arm_neon.h>
+#endif
+
 namespace WPEFramework {
 namespace Web {
     namespace WebSocket {
@@ -40,8 +52,127 @@ namespace Web {
         static const uint8_t TYPE_FRAME = 0x0F;
         static const uint8_t MASKING_FRAME = 0x80;
         static const uint8_t CONTROL_FRAME = 0x08;
+        static const uint8_t COMPRESSED_FRAME = 0x40;
         static const uint8_t HandShakeKey[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 
+        namespace {
+
+            // The key repeated, starting at the given position in the key, so any block of a multiple of
+            // 4 bytes can be XOR-ed with it as is.
+            struct MaskPattern {
+                MaskPattern(const uint8_t key[4], const uint8_t offset)
+                {
+                    for (uint8_t index = 0; index < sizeof(Bytes); index++) {
+                        Bytes[index] = key[(offset + index) & 0x3];
+                    }
+                }
+
+                uint8_t Bytes[32];
+            };
+
+            // The destination may be the source, or lie before it, the blocks are read before they are
+            // written over.
+            uint32_t MaskWords(uint8_t destination[], const uint8_t source[], const uint32_t length, const MaskPattern& pattern, uint32_t index)
+            {
+                uint64_t key;
+
+                ::memcpy(&key, pattern.Bytes, sizeof(key));
+
+                while ((index + sizeof(key)) <= length) {
+                    uint64_t block;
+
+                    ::memcpy(&block, &(source[index]), sizeof(block));
+                    block ^= key;
+                    ::memcpy(&(destination[index]), &block, sizeof(block));
+                    index += sizeof(key);
+                }
+
+                while (index < length) {
+                    destination[index] = (source[index] ^ pattern.Bytes[index & 0x3]);
+                    index++;
+                }
+
+                return (index);
+            }
+
+#ifdef __WEBSOCKET_MASK_SSE2__
+            uint32_t MaskSSE2(uint8_t destination[], const uint8_t source[], const uint32_t length, const MaskPattern& pattern, uint32_t index)
+            {
+                const __m128i key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.Bytes));
+
+                while ((index + 16) <= length) {
+                    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&(source[index])));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(&(destination[index])), _mm_xor_si128(block, key));
+                    index += 16;
+                }
+
+                return (MaskWords(destination, source, length, pattern, index));
+            }
+#endif
+
+#ifdef __WEBSOCKET_MASK_AVX2__
+            __attribute__((target("avx2"))) uint32_t MaskAVX2(uint8_t destination[], const uint8_t source[], const uint32_t length, const MaskPattern& pattern)
+            {
+                const __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern.Bytes));
+                uint32_t index = 0;
+
+                while ((index + 32) <= length) {
+                    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&(source[index])));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(&(destination[index])), _mm256_xor_si256(block, key));
+                    index += 32;
+                }
+
+                return (MaskSSE2(destination, source, length, pattern, index));
+            }
+#endif
+
+#ifdef __WEBSOCKET_MASK_NEON__
+            uint32_t MaskNEON(uint8_t destination[], const uint8_t source[], const uint32_t length, const MaskPattern& pattern)
+            {
+                const uint8x16_t key = vld1q_u8(pattern.Bytes);
+                uint32_t index = 0;
+
+                while ((index + 16) <= length) {
+                    vst1q_u8(&(destination[index]), veorq_u8(vld1q_u8(&(source[index])), key));
+                    index += 16;
+                }
+
+                return (MaskWords(destination, source, length, pattern, index));
+            }
+#endif
+
+            // XOR-s the data with the key, the first byte with the key byte at offset. Blocks are loaded and
+            // stored unaligned, so the data can start anywhere.
+            void Mask(uint8_t destination[], const uint8_t source[], const uint32_t length, const uint8_t key[4], const uint8_t offset)
+            {
+                const MaskPattern pattern(key, offset);
+
+                if (length < 16) {
+                    MaskWords(destination, source, length, pattern, 0);
+                }
+#ifdef __WEBSOCKET_MASK_AVX2__
+                else if (length >= 64) {
+                    static const bool avx2 = (__builtin_cpu_supports("avx2") != 0);
+
+                    if (avx2 == true) {
+                        MaskAVX2(destination, source, length, pattern);
+                    } else {
+                        MaskSSE2(destination, source, length, pattern, 0);
+                    }
+                }
+#endif
+                else {
+#if defined(__WEBSOCKET_MASK_SSE2__)
+                    MaskSSE2(destination, source, length, pattern, 0);
+#elif defined(__WEBSOCKET_MASK_NEON__)
+                    MaskNEON(destination, source, length, pattern);
+#else
+                    MaskWords(destination, source, length, pattern, 0);
+#endif
+                }
+            }
+        }
+
         std::string Protocol::RequestKey() const
         {
             string baseEncodedKey;
@@ -77,18 +208,20 @@ namespace Web {
  *  %xA denotes a pong
  *  %xB-F are reserved for further control frames
  */
-        uint16_t Protocol::Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize)
+        uint32_t Protocol::Encoder(uint8_t* dataFrame, const uint32_t maxSendSize, const uint32_t usedSize, const bool final, const bool compressed)
         {
             uint32_t result = 0;
 
             if ((usedSize != 0) || (SendInProgress() == true)) {
-                result = (usedSize <= 125 ? 2 : 4);
+                // The payload follows the space for the largest header a frame of this size can have, so only
+                // a frame with a shorter length field needs to move up to its header.
+                const uint8_t reserved = HeaderSpace(maxSendSize);
+
+                result = (usedSize <= 125 ? 2 : (usedSize <= 0xFFFF ? 4 : 10));
 
                 if ((_setFlags & MASKING_FRAME) == 0) {
-                    // Only if this is a smallFrame, we need to "flush" 2 bytes..
-                    if ((result == 2) && (usedSize != 0)) {
-                        // No masking, so just move and insert the header up front..
-                        ::memmove(&dataFrame[2], &(dataFrame[4]), usedSize);
+                    if ((result != reserved) && (usedSize != 0)) {
+                        ::memmove(&dataFrame[result], &(dataFrame[reserved]), usedSize);
                     }
                 } else {
                     uint32_t value;
@@ -100,38 +233,42 @@ namespace Web {
                     maskKey[2] = (value >> 16) & 0xFF;
                     maskKey[3] = (value >> 24) & 0xFF;
 
-                    // Mask and insert the bytes on the right spots
-                    uint8_t* source = &dataFrame[usedSize - 1 + 4];
-                    uint8_t* destination = &dataFrame[usedSize - 1 + 4 + result];
-                    uint32_t bytesToMove = usedSize;
-
-                    while (bytesToMove != 0) {
-                        bytesToMove--;
-                        *destination-- = (*source ^ maskKey[(bytesToMove & 0x3)]);
-                        source--;
-                    }
+                    // Mask the payload where it is, or on its way to the header.
+                    Mask(&dataFrame[result + 4], &dataFrame[reserved], usedSize, maskKey, 0);
 
-                    // Now there is space again, write down the encryption key.
                     ::memcpy(&dataFrame[result], &maskKey, 4);
                     result += 4;
                 }
 
                 if (usedSize <= 125) {
                     dataFrame[1] = ((_setFlags & MASKING_FRAME) | usedSize);
-                } else {
-                    // We only allows uin1t 16 so no need to go beyond two bytes..
+                } else if (usedSize <= 0xFFFF) {
                     dataFrame[1] = ((_setFlags & MASKING_FRAME) | 126);
                     dataFrame[2] = (usedSize >> 8);
                     dataFrame[3] = (usedSize & 0xFF);
+                } else {
+                    // The 64 bits length, in network byte order. We send at most 2^32 bytes in a frame.
+                    dataFrame[1] = ((_setFlags & MASKING_FRAME) | 127);
+                    dataFrame[2] = 0;
+                    dataFrame[3] = 0;
+                    dataFrame[4] = 0;
+                    dataFrame[5] = 0;
+                    dataFrame[6] = (usedSize >> 24);
+                    dataFrame[7] = ((usedSize >> 16) & 0xFF);
+                    dataFrame[8] = ((usedSize >> 8) & 0xFF);
+                    dataFrame[9] = (usedSize & 0xFF);
                 }
 
-                if (usedSize < maxSendSize) {
+                // Only the first frame of a message carries the RSV1 bit.
+                const uint8_t first = ((SendInProgress() == true) ? CONTINUATION_FRAME : ((TYPE_FRAME & _setFlags) | (compressed == true ? COMPRESSED_FRAME : 0)));
+
+                if (final == true) {
                     // Seems like not all available space is used, so I guess we are ready..
-                    dataFrame[0] = FINISHING_FRAME | (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = FINISHING_FRAME | first;
                     _progressInfo &= (~0x40);
                 } else {
                     // There is more to come, this is just part of a bigger picture
-                    dataFrame[0] = (SendInProgress() == true ? CONTINUATION_FRAME : TYPE_FRAME & _setFlags);
+                    dataFrame[0] = first;
                     _progressInfo |= (0x40);
                 }
 
@@ -159,7 +296,7 @@ namespace Web {
             return (result);
         }
 
-        uint16_t Protocol::Decoder(uint8_t* dataFrame, uint16_t& receivedSize)
+        uint16_t Protocol::Decoder(uint8_t* dataFrame, uint32_t& receivedSize)
         {
             uint16_t actualHeader = 0;
 
@@ -168,24 +305,20 @@ namespace Web {
             if (_pendingReceiveBytes > 0) {
                 // Just unscramble, what is left...
                 if ((_progressInfo & 0x20) == 0x20) {
-                    // looks like we need to unscramble..
-                    uint8_t* source = dataFrame;
-
+                    // looks like we need to unscramble, where the previous part left off in the key..
                     if (_pendingReceiveBytes < receivedSize) {
-                        receivedSize = _pendingReceiveBytes;
+                        receivedSize = static_cast<uint32_t>(_pendingReceiveBytes);
                     }
 
-                    for (uint16_t tmp = receivedSize; _pendingReceiveBytes != 0 && tmp != 0; --tmp) {
-                        *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                        source++;
-                        _progressInfo = ((_progressInfo + 1) & 0x03) | (_progressInfo & 0xFC);
-                        _pendingReceiveBytes--;
-                    }
+                    Mask(dataFrame, dataFrame, receivedSize, _scrambleKey, (_progressInfo & 0x3));
+
+                    _progressInfo = ((_progressInfo + receivedSize) & 0x03) | (_progressInfo & 0xFC);
+                    _pendingReceiveBytes -= receivedSize;
                 } else {
                     if (_pendingReceiveBytes > receivedSize) {
                         _pendingReceiveBytes -= receivedSize;
                     } else {
-                        receivedSize = _pendingReceiveBytes;
+                        receivedSize = static_cast<uint32_t>(_pendingReceiveBytes);
                         _pendingReceiveBytes = 0;
                     }
                 }
@@ -206,6 +339,11 @@ namespace Web {
                 } else {
                     _frameType = static_cast<frameType>(dataFrame[0] & TYPE_FRAME);
 
+                    // The first frame of a message tells if the message is compressed.
+                    if ((_frameType != 0) && ((_frameType & CONTROL_FRAME) == 0)) {
+                        _compressed = ((dataFrame[0] & COMPRESSED_FRAME) != 0);
+                    }
+
                     // Continuation frame is only allowed if a receive is in progress...
                     if (ReceiveInProgress() == true) {
                         if (_frameType == 0) {
@@ -236,13 +374,13 @@ namespace Web {
                         if (bytesToMove == 126) {
                             bytesToMove = ((dataFrame[2] << 8) + dataFrame[3]);
                         } else if (bytesToMove == 127) {
-                            bytesToMove = dataFrame[9];
-                            for (int i=8; i>=2; i--) bytesToMove = (bytesToMove << 8) + dataFrame[i];
+                            bytesToMove = dataFrame[2];
+                            for (int i=3; i<=9; i++) bytesToMove = (bytesToMove << 8) + dataFrame[i];
                         }
 
                         // We might not have the full body yet...
                         if ((actualHeader + bytesToMove) > receivedSize) {
-                            _pendingReceiveBytes = static_cast<uint32_t>(actualHeader + bytesToMove - receivedSize);
+                            _pendingReceiveBytes = (actualHeader + bytesToMove - receivedSize);
                             bytesToMove = receivedSize - actualHeader;
                             _progressInfo &= (~0x20);
                         }
@@ -256,25 +394,380 @@ namespace Web {
                             _scrambleKey[2] = dataFrame[actualHeader - 2];
                             _scrambleKey[3] = dataFrame[actualHeader - 1];
 
-                            // The last two bits in the progressInfo are used to select the proper scrambling key.
-                            // We need to clear them if we start., the 0x20 indicates scrambling required
+                            // The last two bits in the progressInfo are used to select the proper scrambling key
+                            // for the next part, the 0x20 indicates scrambling required
+                            Mask(&dataFrame[actualHeader], &dataFrame[actualHeader], static_cast<uint32_t>(bytesToMove), _scrambleKey, 0);
+
                             _progressInfo |= 0x20;
-                            _progressInfo &= (~0x03);
+                            _progressInfo = ((_progressInfo & 0xFC) | (bytesToMove & 0x03));
+                        }
+                    }
+                }
+            }
+
+            return (actualHeader);
+        }
+
+        namespace {
 
-                            uint8_t* source = &dataFrame[actualHeader];
+            // What a sync flush ends with, it is left out of a compressed message.
+            const uint8_t DeflateTail[] = { 0x00, 0x00, 0xFF, 0xFF };
+            const TCHAR DeflateExtension[] = _T("permessage-deflate");
+
+            struct DeflateParameters {
+                bool ServerNoContextTakeover;
+                bool ClientNoContextTakeover;
+                uint8_t ServerMaxWindowBits;
+                uint8_t ClientMaxWindowBits;
+                bool ClientMaxWindowBitsOffered;
+            };
+
+            string Trimmed(const string& text)
+            {
+                const size_t begin = text.find_first_not_of(_T(" \t"));
+
+                return (begin == string::npos ? string() : text.substr(begin, text.find_last_not_of(_T(" \t")) - begin + 1));
+            }
+
+            uint8_t WindowBits(const string& value)
+            {
+                uint8_t result = 0;
+
+                if ((value.length() >= 1) && (value.length() <= 2) && (value.find_first_not_of(_T("0123456789")) == string::npos)) {
+                    result = static_cast<uint8_t>(::atoi(value.c_str()));
+
+                    if ((result < 8) || (result > Deflate::MaxWindowBits)) {
+                        result = 0;
+                    }
+                }
+
+                return (result);
+            }
 
-                            while (bytesToMove != 0) {
-                                *source = (*source ^ _scrambleKey[(_progressInfo & 0x3)]);
-                                source++;
-                                bytesToMove--;
-                                _progressInfo = ((_progressInfo + 1) & 0xF3);
-                            }
+            // One extension out of the header: permessage-deflate followed by its parameters, anything that
+            // is unknown, given twice or out of range makes it unusable.
+            bool Parse(const string& extension, DeflateParameters& parameters)
+            {
+                size_t begin = extension.find(';');
+                bool result = (Trimmed(extension.substr(0, begin)) == DeflateExtension);
+
+                ::memset(&parameters, 0, sizeof(parameters));
+
+                while ((result == true) && (begin != string::npos)) {
+                    const size_t end = extension.find(';', begin + 1);
+                    const string parameter(Trimmed(extension.substr(begin + 1, (end == string::npos ? string::npos : end - begin - 1))));
+                    const size_t assignment = parameter.find('=');
+                    const string name(Trimmed(parameter.substr(0, assignment)));
+                    string value(assignment == string::npos ? string() : Trimmed(parameter.substr(assignment + 1)));
+
+                    if ((value.length() >= 2) && (value[0] == '\"') && (value[value.length() - 1] == '\"')) {
+                        value = value.substr(1, value.length() - 2);
+                    }
+
+                    if (name == _T("server_no_context_takeover")) {
+                        result = ((parameters.ServerNoContextTakeover == false) && (assignment == string::npos));
+                        parameters.ServerNoContextTakeover = true;
+                    } else if (name == _T("client_no_context_takeover")) {
+                        result = ((parameters.ClientNoContextTakeover == false) && (assignment == string::npos));
+                        parameters.ClientNoContextTakeover = true;
+                    } else if (name == _T("server_max_window_bits")) {
+                        result = (parameters.ServerMaxWindowBits == 0);
+                        parameters.ServerMaxWindowBits = WindowBits(value);
+                        result = result && (parameters.ServerMaxWindowBits != 0);
+                    } else if (name == _T("client_max_window_bits")) {
+                        result = (parameters.ClientMaxWindowBitsOffered == false);
+                        parameters.ClientMaxWindowBitsOffered = true;
+                        if (assignment != string::npos) {
+                            parameters.ClientMaxWindowBits = WindowBits(value);
+                            result = result && (parameters.ClientMaxWindowBits != 0);
                         }
+                    } else {
+                        result = false;
                     }
+
+                    begin = end;
                 }
+
+                return (result);
             }
+        }
 
-            return (actualHeader);
+        /* static */ constexpr uint8_t Deflate::MinWindowBits;
+        /* static */ constexpr uint8_t Deflate::MaxWindowBits;
+
+        Deflate::Deflate()
+            : _windowBits(0)
+            , _contextTakeover(true)
+            , _threshold(0)
+            , _active(false)
+            , _failed(false)
+            , _deflateReset(false)
+            , _inflateReset(false)
+            , _sending(false)
+            , _finished(false)
+            , _outbound()
+            , _outboundOffset(0)
+            , _final(false)
+            , _tail(0)
+        {
+            ::memset(&_deflate, 0, sizeof(_deflate));
+            ::memset(&_inflate, 0, sizeof(_inflate));
+            ::memset(&_metadata, 0, sizeof(_metadata));
+        }
+
+        Deflate::~Deflate()
+        {
+            Reset();
+        }
+
+        void Deflate::Enable(const uint8_t windowBits, const bool contextTakeover, const uint16_t threshold)
+        {
+            _windowBits = (windowBits == 0 ? 0 : std::max(MinWindowBits, std::min(MaxWindowBits, windowBits)));
+            _contextTakeover = contextTakeover;
+            _threshold = threshold;
+        }
+
+        string Deflate::Offer() const
+        {
+            string result(DeflateExtension);
+
+            result += _T("; client_max_window_bits");
+
+            if (_contextTakeover == false) {
+                result += _T("; client_no_context_takeover");
+            }
+
+            return (result);
+        }
+
+        bool Deflate::Accept(const string& answer)
+        {
+            DeflateParameters parameters;
+            bool result = false;
+
+            Reset();
+
+            // Only one extension was offered, so only that one can come back. A window of 8 bits is not
+            // something zlib can do for a raw deflate stream.
+            if ((IsEnabled() == true) && (answer.find(',') == string::npos) && (Parse(answer, parameters) == true) && (parameters.ClientMaxWindowBits != 8)) {
+                const uint8_t bits = (parameters.ClientMaxWindowBits == 0 ? _windowBits : std::min(_windowBits, parameters.ClientMaxWindowBits));
+
+                result = Activate(bits, ((parameters.ClientNoContextTakeover == true) || (_contextTakeover == false)), parameters.ServerNoContextTakeover);
+            }
+
+            return (result);
+        }
+
+        bool Deflate::Negotiate(const string& offers, string& answer)
+        {
+            bool result = false;
+            size_t begin = 0;
+
+            Reset();
+
+            while ((IsEnabled() == true) && (result == false) && (begin != string::npos)) {
+                const size_t end = offers.find(',', begin);
+                DeflateParameters parameters;
+
+                if ((Parse(offers.substr(begin, (end == string::npos ? string::npos : end - begin)), parameters) == true) && (parameters.ServerMaxWindowBits != 8)) {
+                    const bool serverNoContextTakeover = ((parameters.ServerNoContextTakeover == true) || (_contextTakeover == false));
+                    const uint8_t bits = (parameters.ServerMaxWindowBits == 0 ? _windowBits : std::min(_windowBits, parameters.ServerMaxWindowBits));
+
+                    answer = DeflateExtension;
+
+                    if (serverNoContextTakeover == true) {
+                        answer += _T("; server_no_context_takeover");
+                    }
+                    if (parameters.ClientNoContextTakeover == true) {
+                        answer += _T("; client_no_context_takeover");
+                    }
+                    if (parameters.ServerMaxWindowBits != 0) {
+                        answer += _T("; server_max_window_bits=") + Core::NumberType<uint8_t>(bits).Text();
+                    }
+
+                    result = Activate(bits, serverNoContextTakeover, parameters.ClientNoContextTakeover);
+                }
+
+                begin = (end == string::npos ? end : end + 1);
+            }
+
+            return (result);
+        }
+
+        bool Deflate::Activate(const uint8_t deflateBits, const bool deflateReset, const bool inflateReset)
+        {
+            // Negative window bits give a raw deflate stream, the memory level follows the window size.
+            if (deflateInit2(&_deflate, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -deflateBits, std::min(8, deflateBits - 7), Z_DEFAULT_STRATEGY) != Z_OK) {
+                TRACE_L1("Could not initialize the deflate stream for %d window bits", deflateBits);
+            } else if (inflateInit2(&_inflate, -MaxWindowBits) != Z_OK) {
+                TRACE_L1("Could not initialize the inflate stream");
+                (void)deflateEnd(&_deflate);
+            } else {
+                _active = true;
+                _deflateReset = deflateReset;
+                _inflateReset = inflateReset;
+            }
+
+            return (_active);
+        }
+
+        void Deflate::Reset()
+        {
+            if (_active == true) {
+                (void)deflateEnd(&_deflate);
+                (void)inflateEnd(&_inflate);
+                _active = false;
+            }
+
+            _failed = false;
+            _sending = false;
+            _finished = false;
+            _outbound.clear();
+            _outboundOffset = 0;
+            _final = false;
+            _tail = 0;
+
+            ::memset(&_metadata, 0, sizeof(_metadata));
+        }
+
+        void Deflate::Input(const uint8_t data[], const uint32_t length, const bool final)
+        {
+            ASSERT(_active == true);
+            ASSERT(IsPending() == false || _finished == false);
+
+            const uint64_t start = Core::Time::Now().Ticks();
+
+            if (_outboundOffset == _outbound.size()) {
+                _outbound.clear();
+                _outboundOffset = 0;
+            }
+
+            _sending = true;
+            _deflate.next_in = const_cast<uint8_t*>(data);
+            _deflate.avail_in = length;
+
+            do {
+                const size_t used = _outbound.size();
+
+                _outbound.resize(used + length + 64);
+                _deflate.next_out = &(_outbound[used]);
+                _deflate.avail_out = static_cast<uInt>(length + 64);
+
+                const int status = deflate(&_deflate, (final == true ? Z_SYNC_FLUSH : Z_NO_FLUSH));
+
+                _outbound.resize(used + length + 64 - _deflate.avail_out);
+
+                if ((status != Z_OK) && (status != Z_BUF_ERROR)) {
+                    TRACE_L1("Could not deflate the message, error: %d", status);
+                    _failed = true;
+                }
+
+            } while ((_deflate.avail_out == 0) && (_failed == false));
+
+            if (_failed == true) {
+                // Nothing of it goes out.
+                _sending = false;
+                _finished = false;
+                _outbound.clear();
+                _outboundOffset = 0;
+            } else if (final == true) {
+                // A sync flush always ends with an empty stored block, the receiver puts it back.
+                ASSERT((_outbound.size() - _outboundOffset) >= sizeof(DeflateTail));
+                ASSERT(::memcmp(&(_outbound[_outbound.size() - sizeof(DeflateTail)]), DeflateTail, sizeof(DeflateTail)) == 0);
+
+                _outbound.resize(_outbound.size() - sizeof(DeflateTail));
+                _finished = true;
+
+                if (_deflateReset == true) {
+                    (void)deflateReset(&_deflate);
+                }
+            }
+
+            _metadata.Plain += length;
+            _metadata.Deflating += (Core::Time::Now().Ticks() - start);
+        }
+
+        uint32_t Deflate::Output(uint8_t data[], const uint32_t maxLength)
+        {
+            const uint32_t result = static_cast<uint32_t>(std::min(static_cast<size_t>(maxLength), (_outbound.size() - _outboundOffset)));
+
+            ::memcpy(data, &(_outbound[_outboundOffset]), result);
+            _outboundOffset += result;
+            _metadata.Deflated += result;
+
+            if ((_finished == true) && (_outboundOffset == _outbound.size())) {
+                _sending = false;
+                _finished = false;
+                _outbound.clear();
+                _outboundOffset = 0;
+                _metadata.Messages++;
+            }
+
+            return (result);
+        }
+
+        void Deflate::Inflate(const uint8_t data[], const uint32_t length, const bool final)
+        {
+            _inflate.next_in = const_cast<uint8_t*>(data);
+            _inflate.avail_in = length;
+            _tail = (final == true ? sizeof(DeflateTail) : 0);
+            _final = final;
+            _metadata.Received += length;
+        }
+
+        uint16_t Deflate::Inflated(const uint8_t*& data)
+        {
+            uint16_t result = 0;
+
+            data = _inbound;
+
+            if ((_active == true) && (_failed == false)) {
+                const uint64_t start = Core::Time::Now().Ticks();
+                bool more = true;
+
+                _inflate.next_out = _inbound;
+                _inflate.avail_out = sizeof(_inbound);
+
+                while ((more == true) && (_inflate.avail_out != 0)) {
+                    if ((_inflate.avail_in == 0) && (_tail != 0)) {
+                        _inflate.next_in = const_cast<uint8_t*>(&(DeflateTail[sizeof(DeflateTail) - _tail]));
+                        _inflate.avail_in = _tail;
+                        _tail = 0;
+                    }
+
+                    const int status = inflate(&_inflate, Z_SYNC_FLUSH);
+
+                    if (status == Z_BUF_ERROR) {
+                        // Nothing left to work on.
+                        more = false;
+                    } else if (status != Z_OK) {
+                        TRACE_L1("Could not inflate the message, error: %d", status);
+
+                        _inflate.avail_in = 0;
+                        _tail = 0;
+                        _final = false;
+                        _failed = true;
+                        more = false;
+                    } else if ((_inflate.avail_in == 0) && (_tail == 0)) {
+                        more = false;
+                    }
+                }
+
+                result = static_cast<uint16_t>(sizeof(_inbound) - _inflate.avail_out);
+
+                if ((result == 0) && (_final == true)) {
+                    _final = false;
+
+                    if (_inflateReset == true) {
+                        (void)inflateReset(&_inflate);
+                    }
+                }
+
+                _metadata.Inflated += result;
+                _metadata.Inflating += (Core::Time::Now().Ticks() - start);
+            }
+
+            return (result);
         }
     }
 }
@@ -36,7 +36,7 @@ namespace Web {
                 PING = 0x09,
                 PONG = 0x0A,
                 VIOLATION = 0x10, // e.g. a control package without a FIN flag
-                TOO_BIG = 0x20, // Protocol max support for 2^16 message per chunk
+                TOO_BIG = 0x20, // Protocol max support for 2^32 message per chunk
                 INCONSISTENT = 0x30 // e.g. Protocol defined as Text, but received a binary.
             };
 
@@ -59,6 +59,7 @@ namespace Web {
                 , _pendingReceiveBytes(0)
                 , _frameType(TEXT)
                 , _controlStatus(0)
+                , _compressed(false)
             {
                 ::memset(_scrambleKey, 0, sizeof(_scrambleKey));
             }
@@ -118,17 +119,146 @@ namespace Web {
             {
                 return ((_setFlags & 0x80) != 0);
             }
+            // Where the payload goes in the frame buffer: after the space for the largest header a frame with
+            // a payload of at most the given size can have.
+            uint8_t HeaderSpace(const uint32_t maxPayload) const
+            {
+                return ((maxPayload > 0xFFFF ? 10 : 4) + (Masking() == true ? 4 : 0));
+            }
+            // The message being received has the RSV1 bit set, see Deflate.
+            bool Compressed() const
+            {
+                return (_compressed);
+            }
+            bool IsLastFrame() const
+            {
+                return ((ReceiveInProgress() == false) && (IsCompleteMessage() == true));
+            }
 
-            uint16_t Encoder(uint8_t* dataFrame, const uint16_t maxSendSize, const uint16_t usedSize);
-            uint16_t Decoder(uint8_t* dataFrame, uint16_t& receivedSize);
+            uint32_t Encoder(uint8_t* dataFrame, const uint32_t maxSendSize, const uint32_t usedSize)
+            {
+                return (Encoder(dataFrame, maxSendSize, usedSize, (usedSize < maxSendSize), false));
+            }
+            // The payload is expected at HeaderSpace(maxSendSize) in the dataFrame, the frame starts at the beginning.
+            // This one frames a message that does not end where the buffer does not fill up, e.g. a
+            // compressed one, the first frame of a compressed message gets the RSV1 bit.
+            uint32_t Encoder(uint8_t* dataFrame, const uint32_t maxSendSize, const uint32_t usedSize, const bool final, const bool compressed);
+            uint16_t Decoder(uint8_t* dataFrame, uint32_t& receivedSize);
 
         private:
             uint8_t _setFlags;
             uint8_t _progressInfo;
-            uint32_t _pendingReceiveBytes;
+            uint64_t _pendingReceiveBytes;
             frameType _frameType;
             uint8_t _scrambleKey[4];
             uint8_t _controlStatus;
+            bool _compressed;
+        };
+
+        // The permessage-deflate extension (RFC 7692). It is negotiated during the upgrade, after that the
+        // link sends messages of at least the threshold size compressed and inflates the ones that come in
+        // with the RSV1 bit. Both directions have a zlib stream of their own, that is kept from message to
+        // message unless context takeover is off. It is not thread safe, the link uses it (the metadata
+        // included) under its own lock.
+        class EXTERNAL Deflate {
+        public:
+            static constexpr uint8_t MinWindowBits = 9;
+            static constexpr uint8_t MaxWindowBits = 15;
+
+            struct Metadata {
+                uint32_t Messages;
+                uint64_t Plain;
+                uint64_t Deflated;
+                uint64_t Received;
+                uint64_t Inflated;
+                // Time spent in zlib, in microseconds.
+                uint64_t Deflating;
+                uint64_t Inflating;
+            };
+
+        public:
+            Deflate(const Deflate&) = delete;
+            Deflate& operator=(const Deflate&) = delete;
+
+            Deflate();
+            ~Deflate();
+
+        public:
+            // Offer or accept the extension. The window size limits what we compress with, messages that are
+            // smaller than the threshold are sent as is.
+            void Enable(const uint8_t windowBits, const bool contextTakeover, const uint16_t threshold);
+            bool IsEnabled() const
+            {
+                return (_windowBits != 0);
+            }
+            bool IsActive() const
+            {
+                return (_active);
+            }
+            // zlib could not make sense of a message, or failed compressing one. Nothing of it can be trusted
+            // anymore, so the connection is to be failed.
+            bool IsFailed() const
+            {
+                return (_failed);
+            }
+            void Snapshot(Metadata& metadata) const
+            {
+                metadata = _metadata;
+            }
+
+            // Client side: the offer for the upgrade request, and the answer of the server to it.
+            string Offer() const;
+            bool Accept(const string& answer);
+
+            // Server side: pick the first offer we can live with from the upgrade request.
+            bool Negotiate(const string& offers, string& answer);
+
+            void Reset();
+
+            // Sending: the plain message is handed over as it comes, final with the last part of it. The
+            // compressed message is picked up with Output, until nothing is Pending anymore.
+            bool IsPending() const
+            {
+                return ((_sending == true) && ((_finished == false) || (_outboundOffset < _outbound.size())));
+            }
+            bool Available() const
+            {
+                return (_outboundOffset < _outbound.size());
+            }
+            bool Compress(const uint32_t length, const bool final) const
+            {
+                return ((_active == true) && ((final == false) || ((length != 0) && (length >= _threshold))));
+            }
+            void Input(const uint8_t data[], const uint32_t length, const bool final);
+            uint32_t Output(uint8_t data[], const uint32_t maxLength);
+
+            // Receiving: a part of a compressed message, final with the last part of it. The result comes
+            // in pieces, Inflated returns 0 once all of the input was processed. The data is not copied, it
+            // should stay put until then.
+            void Inflate(const uint8_t data[], const uint32_t length, const bool final);
+            uint16_t Inflated(const uint8_t*& data);
+
+        private:
+            bool Activate(const uint8_t deflateBits, const bool deflateReset, const bool inflateReset);
+
+        private:
+            uint8_t _windowBits;
+            bool _contextTakeover;
+            uint16_t _threshold;
+            bool _active;
+            bool _failed;
+            bool _deflateReset;
+            bool _inflateReset;
+            z_stream _deflate;
+            z_stream _inflate;
+            bool _sending;
+            bool _finished;
+            std::vector<uint8_t> _outbound;
+            size_t _outboundOffset;
+            bool _final;
+            uint8_t _tail;
+            uint8_t _inbound[4096];
+            Metadata _metadata;
         };
 
         class EXTERNAL RequestAllocator : public Core::ProxyPoolType<Web::Request> {
@@ -174,7 +304,9 @@ namespace Web {
             UPGRADING = 0x02,
             WEBSOCKET = 0x04,
             SUSPENDED = 0x08,
-            ACTIVITY  = 0x10
+            ACTIVITY  = 0x10,
+            FAILED    = 0x20,
+            CLOSING   = 0x40
         };
 
         typedef WebSocketLinkType<LINK, INBOUND, OUTBOUND, ALLOCATOR> ParentClass;
@@ -185,6 +317,13 @@ namespace Web {
         private:
             typedef HandlerType<ACTUALLINK> ThisClass;
 
+            // Bodies kept in a file are sent straight from the file, if the socket asks for them.
+            static constexpr bool ZeroCopy = ((std::is_base_of<Core::SocketStream, ACTUALLINK>::value)
+#if defined(SECURESOCKETS_ENABLED)
+                || (std::is_base_of<Crypto::SecureSocketPort, ACTUALLINK>::value)
+#endif
+            );
+
             class SerializerImpl : public OUTBOUND::Serializer {
             private:
                 typedef typename OUTBOUND::Serializer BaseClass;
@@ -370,7 +509,9 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
             {
+                _serializerImpl.ZeroCopy(ZeroCopy);
             }
             template <typename... Args>
             HandlerType(ParentClass& parent, const bool binary, const bool masking, const uint8_t queueSize, ALLOCATOR allocator, Args&&... args)
@@ -387,7 +528,9 @@ PUSH_WARNING(DISABLE_WARNING_THIS_IN_MEMBER_INITIALIZER_LIST)
                 , _origin()
                 , _webSocketMessage(Core::ProxyType<typename OUTBOUND::BaseElement>::Create())
                 , _pingFireTime(0)
+                , _deflate()
             {
+                _serializerImpl.ZeroCopy(ZeroCopy);
             }
 POP_WARNING()
             ~HandlerType() override = default;
@@ -469,6 +612,23 @@ POP_WARNING()
             {
                 return (_handler.Masking());
             }
+            // Takes effect on the next upgrade, see WebSocket::Deflate.
+            void Compression(const uint8_t windowBits, const bool contextTakeover, const uint16_t threshold)
+            {
+                _adminLock.Lock();
+
+                _deflate.Enable(windowBits, contextTakeover, threshold);
+
+                _adminLock.Unlock();
+            }
+            bool Compression(WebSocket::Deflate::Metadata& metadata) const
+            {
+                Core::SafeSyncType<Core::CriticalSection> lock(_adminLock);
+
+                _deflate.Snapshot(metadata);
+
+                return (_deflate.IsActive());
+            }
             bool Upgrade(const string& protocol, const string& path)
             {
                 string empty;
@@ -524,22 +684,44 @@ POP_WARNING()
             }
 
             // Methods to extract and insert data into the socket buffers
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSize) override
             {
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 _adminLock.Lock();
 
                 _state |= ACTIVITY;
 
                 if ((_state & WEBSOCKET) != 0) {
-                    if (maxSendSize > 8) {
-                        result = _parent.SendData(&(dataFrame[4]), (maxSendSize - 8));
+                    // A frame takes what the send buffer can hold, the payload goes straight behind the space for
+                    // the header, and leave some room for control frames.
+                    if (maxSize > static_cast<uint32_t>(_handler.HeaderSpace(maxSize) + 4)) {
+                        const uint32_t payloadSize = (maxSize - _handler.HeaderSpace(maxSize) - 4);
+                        const uint8_t headerSpace = _handler.HeaderSpace(payloadSize);
+
+                        if ((_state & FAILED) != 0) {
+                            // Only the close frame is left to send. The round after the one that ended with it,
+                            // finds the send buffer empty, so the link can be closed.
+                            result = _handler.Encoder(dataFrame, payloadSize, 0);
+
+                            if (result != 0) {
+                                _state &= ~CLOSING;
+                            } else if ((_state & CLOSING) == 0) {
+                                _state |= CLOSING;
+                            } else {
+                                _state |= SUSPENDED;
+                            }
+                        } else if (_deflate.IsActive() == true) {
+                            result = Deflated(dataFrame, headerSpace, payloadSize);
+                        } else {
+                            result = _parent.SendData(&(dataFrame[headerSpace]), payloadSize);
 
-                        result = _handler.Encoder(dataFrame, (maxSendSize - 8), result);
+                            result = _handler.Encoder(dataFrame, payloadSize, result);
+                        }
                     }
                 } else {
-                    result = _serializerImpl.Serialize(dataFrame, maxSendSize);
+                    // The web serializers work in chunks of at most 64KB, the send buffer can be larger.
+                    result = _serializerImpl.Serialize(dataFrame, static_cast<uint16_t>(std::min(maxSize, static_cast<uint32_t>(0xFFFF))));
                 }
 
                 _adminLock.Unlock();
@@ -550,20 +732,23 @@ POP_WARNING()
 
                 return (result);
             }
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t availableSize) override
             {
-                uint16_t result = 0;
+                uint32_t result = 0;
 
                 _adminLock.Lock();
 
                 _state |= ACTIVITY;
 
-                if ((_state & WEBSOCKET) != 0) {
+                if ((_state & FAILED) != 0) {
+                    // The connection failed, whatever comes in is dropped.
+                    result = availableSize;
+                } else if ((_state & WEBSOCKET) != 0) {
                     bool tooSmall = false;
 
                     // check for multiple messages if available...
-                    while ((result < receivedSize) && (tooSmall == false)) {
-                        uint16_t actualDataSize = receivedSize - result;
+                    while ((result < availableSize) && (tooSmall == false)) {
+                        uint32_t actualDataSize = availableSize - result;
                         uint16_t headerSize = _handler.Decoder(const_cast<uint8_t*>(&dataFrame[result]), actualDataSize);
                         uint64_t payloadSizeInControlFrame;
 
@@ -578,7 +763,7 @@ POP_WARNING()
                                 // ACTUALLINK::Close(0);
 
                                 // Nothing we can do with this shit..
-                                result = receivedSize;
+                                result = availableSize;
                             } else if ((_handler.FrameType() & 0x08) != 0) {
                                 // Build the associated message with this..
                                 // _commandData += dataFrame
@@ -622,8 +807,8 @@ POP_WARNING()
                                       }
                                    } else if (payloadSizeInControlFrame == 127) {
                                       if (headerSize > 9) {
-                                         payloadSizeInControlFrame = dataFrame[result+9];
-                                         for (int i=8; i>=2; i--) payloadSizeInControlFrame = (payloadSizeInControlFrame << 8) + dataFrame[result+i];
+                                         payloadSizeInControlFrame = dataFrame[result+2];
+                                         for (int i=3; i<=9; i++) payloadSizeInControlFrame = (payloadSizeInControlFrame << 8) + dataFrame[result+i];
                                       } else {
                                          TRACE_L1("Header too small for 64-bit jumbo payload size ");
                                          payloadSizeInControlFrame = 0;
@@ -631,8 +816,29 @@ POP_WARNING()
                                    }
                                 }
 
-                                result += static_cast<uint16_t>(headerSize + payloadSizeInControlFrame); // actualDataSize
+                                result += static_cast<uint32_t>(headerSize + payloadSizeInControlFrame); // actualDataSize
+
+                            } else if ((_handler.Compressed() == true) && (_deflate.IsActive() == false)) {
+                                Fail(_T("RSV1 is set, but no extension was negotiated"));
+
+                                result = availableSize;
+                            } else if (_handler.Compressed() == true) {
+                                const uint8_t* inflated;
+                                uint16_t length;
+
+                                _deflate.Inflate(&(dataFrame[result + headerSize]), actualDataSize, _handler.IsLastFrame());
+
+                                while ((length = _deflate.Inflated(inflated)) != 0) {
+                                    _parent.ReceiveData(const_cast<uint8_t*>(inflated), length);
+                                }
+
+                                if (_deflate.IsFailed() == true) {
+                                    Fail(_T("the message could not be inflated"));
 
+                                    result = availableSize;
+                                } else {
+                                    result += (headerSize + actualDataSize);
+                                }
                             } else {
                                 _parent.ReceiveData(&(dataFrame[result + headerSize]), actualDataSize);
 
@@ -641,7 +847,7 @@ POP_WARNING()
                         }
                     }
                 } else {
-                    result = _deserialiserImpl.Deserialize(dataFrame, receivedSize);
+                    result = _deserialiserImpl.Deserialize(dataFrame, static_cast<uint16_t>(std::min(availableSize, static_cast<uint32_t>(0xFFFF))));
                 }
 
                 _adminLock.Unlock();
@@ -653,6 +859,20 @@ POP_WARNING()
                 return (result);
             }
 
+            // A response of the web server with its body in a file, see Core::SocketPort::SendFile.
+            bool SendFile(Core::SocketPort::Region& region) override
+            {
+                return (((State() & WEBSERVER) != 0) && (_serializerImpl.Transfer(region) == true));
+            }
+            void FileSent() override
+            {
+                _adminLock.Lock();
+                _state |= ACTIVITY;
+                _adminLock.Unlock();
+
+                _serializerImpl.Transferred();
+            }
+
             // Signal a state change, Opened, Closed, Accepted or Error
             void StateChange() override
             {
@@ -695,6 +915,49 @@ POP_WARNING()
             {
                 return (_state.load(Core::memory_order::memory_order_relaxed));
             }
+            // Frames the next part of a message, compressed if it is large enough. The plain message is pulled
+            // from the parent until there is compressed data to send, or the message is complete.
+            uint32_t Deflated(uint8_t* dataFrame, const uint8_t headerSpace, const uint32_t maxSendSize)
+            {
+                uint8_t* payload = &(dataFrame[headerSpace]);
+                uint32_t result = 0;
+
+                if (_deflate.IsPending() == false) {
+                    result = _parent.SendData(payload, maxSendSize);
+
+                    if (_deflate.Compress(result, (result < maxSendSize)) == false) {
+                        return (_handler.Encoder(dataFrame, maxSendSize, result));
+                    }
+
+                    _deflate.Input(payload, result, (result < maxSendSize));
+                }
+
+                while ((_deflate.IsPending() == true) && (_deflate.Available() == false)) {
+                    result = _parent.SendData(payload, maxSendSize);
+
+                    _deflate.Input(payload, result, (result < maxSendSize));
+                }
+
+                if (_deflate.IsFailed() == true) {
+                    // What is underway is ended, the close frame follows.
+                    Fail(_T("the message could not be deflated"));
+                    result = 0;
+                } else {
+                    result = _deflate.Output(payload, maxSendSize);
+                }
+
+                return (_handler.Encoder(dataFrame, maxSendSize, result, (_deflate.IsPending() == false), true));
+            }
+            // Fail the websocket connection (RFC 6455, 7.1.7): nothing is taken in or sent anymore, but the close
+            // frame. The link is closed once that is out. Called with the lock taken.
+            void Fail(const TCHAR reason[])
+            {
+                TRACE_L1("Failing the websocket connection, %s", reason);
+
+                _state |= FAILED;
+                _handler.Close();
+                ACTUALLINK::Trigger();
+            }
             uint32_t CheckForClose(uint32_t waitTime)
             {
                 uint32_t result = 0;
@@ -790,6 +1053,15 @@ POP_WARNING()
                                 ASSERT(_protocol.Size() == 1);
                                 _webSocketMessage->WebSocketProtocol = _protocol.First();
                             }
+
+                            string extension;
+
+                            if ((element->WebSocketExtensions.IsSet() == true) && (_deflate.Negotiate(element->WebSocketExtensions.Value(), extension) == true)) {
+                                _webSocketMessage->WebSocketExtensions = extension;
+                            } else {
+                                _webSocketMessage->WebSocketExtensions.Clear();
+                                _deflate.Reset();
+                            }
                         }
                     }
 
@@ -852,6 +1124,14 @@ POP_WARNING()
                         _webSocketMessage->WebSocketProtocol = Web::ProtocolsArray(protocol);
                     }
 
+                    _deflate.Reset();
+
+                    if (_deflate.IsEnabled() == true) {
+                        _webSocketMessage->WebSocketExtensions = _deflate.Offer();
+                    } else {
+                        _webSocketMessage->WebSocketExtensions.Clear();
+                    }
+
                     _query = query;
                     _path = path;
                     _protocol = Web::ProtocolsArray(protocol);
@@ -876,14 +1156,26 @@ POP_WARNING()
 
                     _adminLock.Lock();
 
-                    // Seems like we succeeded, turn on the link..
-                    _state = (_state & 0xF0) | WEBSOCKET;
+                    if ((element->WebSocketExtensions.IsSet() == true) && (_deflate.Accept(element->WebSocketExtensions.Value()) == false)) {
+                        _adminLock.Unlock();
 
-                    _parent.StateChange();
+                        // The server picked extensions we can not work with, so the link is of no use.
+                        TRACE_L1("Extensions in the answer we did not offer: %s", element->WebSocketExtensions.Value().c_str());
+                        Close(0);
+                    } else {
+                        if (element->WebSocketExtensions.IsSet() == false) {
+                            _deflate.Reset();
+                        }
 
-                    _adminLock.Unlock();
+                        // Seems like we succeeded, turn on the link..
+                        _state = (_state & 0xF0) | WEBSOCKET;
 
-                    ACTUALLINK::Trigger();
+                        _parent.StateChange();
+
+                        _adminLock.Unlock();
+
+                        ACTUALLINK::Trigger();
+                    }
                 } else if ((_webSocketMessage.IsValid() == true) && (element->ErrorCode == Web::STATUS_FORBIDDEN)) {
                     ASSERT((_state & UPGRADING) != 0);
 
@@ -908,6 +1200,7 @@ POP_WARNING()
             string _commandData;
             Core::ProxyType<typename OUTBOUND::BaseElement> _webSocketMessage;
             uint64_t _pingFireTime;
+            WebSocket::Deflate _deflate;
         };
 
     public:
@@ -990,6 +1283,14 @@ POP_WARNING()
         {
             return (_channel.Masking());
         }
+        void Compression(const uint8_t windowBits, const bool contextTakeover, const uint16_t threshold)
+        {
+            _channel.Compression(windowBits, contextTakeover, threshold);
+        }
+        bool Compression(WebSocket::Deflate::Metadata& metadata) const
+        {
+            return (_channel.Compression(metadata));
+        }
         void ResetActivity()
         {
             return (_channel.ResetActivity());
@@ -1075,8 +1376,8 @@ POP_WARNING()
         virtual void LinkBody(Core::ProxyType<INBOUND>& element) = 0;
         virtual void Received(Core::ProxyType<INBOUND>& element) = 0;
         virtual void Send(const Core::ProxyType<OUTBOUND>& element) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
         virtual void StateChange() = 0;
         virtual bool IsIdle() const = 0;
 
@@ -1120,11 +1421,11 @@ POP_WARNING()
             ~Handler() override = default;
 
         public:
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -1235,6 +1536,14 @@ POP_WARNING()
         {
             return (_channel.Masking());
         }
+        void Compression(const uint8_t windowBits, const bool contextTakeover, const uint16_t threshold)
+        {
+            _channel.Compression(windowBits, contextTakeover, threshold);
+        }
+        bool Compression(WebSocket::Deflate::Metadata& metadata) const
+        {
+            return (_channel.Compression(metadata));
+        }
         uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1258,8 +1567,8 @@ POP_WARNING()
 
         virtual bool IsIdle() const = 0;
         virtual void StateChange() = 0;
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
     private:
         Handler<LINK> _channel;
@@ -1289,11 +1598,11 @@ POP_WARNING()
             ~Handler() override = default;
 
         public:
-            uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) override
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
             {
                 return (_parent.SendData(dataFrame, maxSendSize));
             }
-            uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) override
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
             {
                 return (_parent.ReceiveData(dataFrame, receivedSize));
             }
@@ -1393,6 +1702,14 @@ POP_WARNING()
         {
             return (_channel.Masking());
         }
+        void Compression(const uint8_t windowBits, const bool contextTakeover, const uint16_t threshold)
+        {
+            _channel.Compression(windowBits, contextTakeover, threshold);
+        }
+        bool Compression(WebSocket::Deflate::Metadata& metadata) const
+        {
+            return (_channel.Compression(metadata));
+        }
         uint32_t Open(const uint32_t waitTime)
         {
             return (_channel.Open(waitTime));
@@ -1416,8 +1733,8 @@ POP_WARNING()
 
         virtual bool IsIdle() const = 0;
         virtual void StateChange() = 0;
-        virtual uint16_t SendData(uint8_t* dataFrame, const uint16_t maxSendSize) = 0;
-        virtual uint16_t ReceiveData(uint8_t* dataFrame, const uint16_t receivedSize) = 0;
+        virtual uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) = 0;
+        virtual uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) = 0;
 
     private:
         Handler<LINK> _channel;
@@ -0,0 +1,174 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+
+#include "Module.h"
+
+#include <cryptalgo/cryptalgo.h>
+
+using namespace WPEFramework;
+
+// Encrypts with AES-CBC, the way a blob is encrypted in one go today, and with AES_CTR and AES_GCM, with the
+// portable code and with the AES instructions of the CPU (AES-NI and PCLMULQDQ or the ARMv8 AES and PMULL
+// instructions). First messages of different sizes in one piece, then a large message handed over in pieces,
+// the way a file or a stream goes through it. Whatever the CPU lacks is a "-".
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    const uint8_t Key[32] = {
+        0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+        0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+    };
+    const uint8_t Nonce[16] = {
+        0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88, 0x00, 0x00, 0x00, 0x01
+    };
+
+    // Returns the number of times a second the action is done, done for about the given time.
+    template <typename ACTION>
+    double Measure(const uint32_t milliseconds, ACTION&& action)
+    {
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point end = start + std::chrono::milliseconds(milliseconds);
+        uint64_t count = 0;
+
+        while (Clock::now() < end) {
+            action();
+            count++;
+        }
+
+        return (count / std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    void Print(const bool supported, const double value)
+    {
+        if (supported == true) {
+            printf(" %10.0f", value);
+        } else {
+            printf(" %10s", _T("-"));
+        }
+    }
+
+    // MB/s of a message of the given size, encrypted (or decrypted and checked) in pieces of the given size.
+    double Throughput(const Crypto::aesType type, const bool decrypt, const uint8_t acceleration, const uint32_t size, const uint32_t piece, const uint32_t milliseconds)
+    {
+        std::vector<uint8_t> input(size);
+        std::vector<uint8_t> output(size);
+        uint8_t tag[16];
+
+        for (uint32_t index = 0; index < size; index++) {
+            input[index] = static_cast<uint8_t>(index * 7);
+        }
+
+        Crypto::Acceleration(acceleration);
+
+        Crypto::AESEncryption encryption(type);
+        Crypto::AESDecryption decryption(type);
+
+        encryption.Key(sizeof(Key), Key);
+        decryption.Key(sizeof(Key), Key);
+
+        const double messages = Measure(milliseconds, [&]() {
+            const uint8_t length = (type == Crypto::AES_GCM ? 12 : 16);
+
+            if (decrypt == false) {
+                encryption.InitialVector(length, Nonce);
+                encryption.Authenticate(sizeof(Nonce), Nonce);
+                for (uint32_t offset = 0; offset < size; offset += piece) {
+                    encryption.Encrypt(std::min(piece, size - offset), &(input[offset]), &(output[offset]));
+                }
+                encryption.Tag(sizeof(tag), tag);
+            } else {
+                decryption.InitialVector(length, Nonce);
+                decryption.Authenticate(sizeof(Nonce), Nonce);
+                for (uint32_t offset = 0; offset < size; offset += piece) {
+                    decryption.Decrypt(std::min(piece, size - offset), &(input[offset]), &(output[offset]));
+                }
+                decryption.Verify(sizeof(tag), tag);
+            }
+        });
+
+        return ((messages * size) / (1024 * 1024));
+    }
+
+    void Sizes(const bool supported, const uint32_t size, const uint32_t milliseconds)
+    {
+        printf("%8d", size);
+        Print(true, Throughput(Crypto::AES_CBC, false, Crypto::ACCELERATION_NONE, size, size, milliseconds));
+        Print(true, Throughput(Crypto::AES_CTR, false, Crypto::ACCELERATION_NONE, size, size, milliseconds));
+        Print(supported, Throughput(Crypto::AES_CTR, false, Crypto::ACCELERATION_AES, size, size, milliseconds));
+        Print(true, Throughput(Crypto::AES_GCM, false, Crypto::ACCELERATION_NONE, size, size, milliseconds));
+        Print(supported, Throughput(Crypto::AES_GCM, false, Crypto::ACCELERATION_AES, size, size, milliseconds));
+        Print(supported, Throughput(Crypto::AES_GCM, true, Crypto::ACCELERATION_AES, size, size, milliseconds));
+        printf("\n");
+    }
+
+    void Pieces(const bool supported, const uint32_t piece, const uint32_t milliseconds)
+    {
+        const uint32_t size = (1024 * 1024);
+
+        printf("%8d", piece);
+        Print(true, Throughput(Crypto::AES_GCM, false, Crypto::ACCELERATION_NONE, size, piece, milliseconds));
+        Print(supported, Throughput(Crypto::AES_GCM, false, Crypto::ACCELERATION_AES, size, piece, milliseconds));
+        Print(supported, Throughput(Crypto::AES_GCM, true, Crypto::ACCELERATION_AES, size, piece, milliseconds));
+        printf("\n");
+    }
+
+}
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    const uint32_t milliseconds = (argc > 1 ? static_cast<uint32_t>(::atoi(argv[1])) : 500);
+
+    if (milliseconds == 0) {
+        printf("Usage: %s [milliseconds per run]\n", argv[0]);
+    }
+    else {
+        const uint8_t all = Crypto::Acceleration();
+        const bool supported = ((Crypto::Acceleration(Crypto::ACCELERATION_AES) & Crypto::ACCELERATION_AES) != 0);
+
+        printf("CPU support: AES instructions %s, AES-256, %d ms per run\n\n", (supported ? _T("yes") : _T("no")), milliseconds);
+
+        printf("MB/s, the message in one piece\n\n");
+        printf("%8s %10s %21s %32s\n", _T(""), _T("CBC"), _T("CTR"), _T("GCM"));
+        printf("%8s %10s %10s %10s %10s %10s %10s\n", _T("size"), _T("portable"), _T("portable"), _T("AES"), _T("portable"), _T("AES"), _T("AES open"));
+
+        for (const uint32_t size : { 64, 1024, 16384, 1048576 }) {
+            Sizes(supported, size, milliseconds);
+        }
+
+        printf("\nGCM MB/s, a message of 1MB in pieces\n\n");
+        printf("%8s %10s %10s %10s\n", _T("piece"), _T("portable"), _T("AES"), _T("AES open"));
+
+        for (const uint32_t piece : { 100, 1500, 16384 }) {
+            Pieces(supported, piece, milliseconds);
+        }
+
+        Crypto::Acceleration(all);
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,221 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <vector>
+
+#include "Module.h"
+
+#include <com/com.h>
+
+using namespace WPEFramework;
+
+// Measures a COM-RPC round trip of a buffer that the other side echoes back, once with the
+// frames copied through the socket (inline) and once with the frames put in a SharedArena
+// (shared). Both sides do what the Administrator and the generated proxies/stubs do: the
+// frames are shared right before they are sent and resolved right after they came in.
+// Reported are the calls per second and the payload throughput (both directions).
+class Benchmark {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t InterfaceId = 0x00F00001;
+
+    class Echo : public Core::IIPCServer {
+    public:
+        Echo(const Echo&) = delete;
+        Echo& operator=(const Echo&) = delete;
+
+        Echo() = default;
+        ~Echo() override = default;
+
+    public:
+        void Procedure(Core::IPCChannel& source, Core::ProxyType<Core::IIPC>& data) override
+        {
+            Core::ProxyType<RPC::InvokeMessage> message(data);
+            Core::ProxyType<RPC::SharedArena> outbound;
+            Core::ProxyType<RPC::SharedArena> inbound;
+            const bool shared = RPC::Administrator::Instance().Shared(&source, outbound, inbound);
+
+            if ((shared == false) || (message->Parameters().Resolve(inbound) == true)) {
+                RPC::Data::Frame::Reader reader(message->Parameters().Reader());
+                RPC::Data::Frame::Writer writer(message->Response().Writer());
+                const uint8_t* buffer = nullptr;
+
+                uint32_t length = reader.LockBuffer<uint32_t>(buffer);
+                writer.Buffer<uint32_t>(length, buffer);
+                reader.UnlockBuffer(length);
+            }
+
+            if (shared == true) {
+                message->Response().Share(*outbound);
+            }
+
+            source.ReportResponse(data);
+        }
+    };
+
+public:
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    Benchmark(const string& connector)
+        : _connector(connector)
+        , _factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t>>::Create())
+        , _server(Core::NodeId(connector.c_str()), RPC::CommunicationBufferSize, _factory)
+        , _client(Core::NodeId(connector.c_str()), RPC::CommunicationBufferSize, _factory)
+        , _messages(2)
+        , _clientArena()
+        , _serverArena()
+    {
+        _factory->CreateFactory<RPC::InvokeMessage>(2);
+        _server.Register(RPC::InvokeMessage::Id(), Core::ProxyType<Core::IIPCServer>(Core::ProxyType<Echo>::Create()));
+        _server.Source().Open(1000);
+        _client.Source().Open(1000);
+    }
+    ~Benchmark()
+    {
+        Share(false);
+
+        _client.Source().Close(1000);
+        _server.Source().Close(1000);
+        _server.Unregister(RPC::InvokeMessage::Id());
+        _factory->DestroyFactories();
+    }
+
+public:
+    bool IsValid() const
+    {
+        return ((_client.Source().IsOpen() == true) && (_server.Source().IsOpen() == true));
+    }
+    void Share(const bool enabled)
+    {
+        if (enabled == true) {
+            // Normally the Communicator does this during the Announce.
+            _clientArena = Core::ProxyType<RPC::SharedArena>::Create(_connector + _T(".client"), RPC::CommunicationArenaSize);
+            _serverArena = Core::ProxyType<RPC::SharedArena>::Create(_connector + _T(".server"), RPC::CommunicationArenaSize);
+
+            RPC::Administrator::Instance().Share(&_client, _clientArena, Core::ProxyType<RPC::SharedArena>::Create(_serverArena->Name()));
+            RPC::Administrator::Instance().Share(&_server, _serverArena, Core::ProxyType<RPC::SharedArena>::Create(_clientArena->Name()));
+        } else {
+            RPC::Administrator::Instance().Unshare(&_client);
+            RPC::Administrator::Instance().Unshare(&_server);
+
+            if (_clientArena.IsValid() == true) {
+                _clientArena.Release();
+                _serverArena.Release();
+            }
+        }
+    }
+    void Run(const uint32_t size, const bool shared)
+    {
+        // Move roughly the same amount of data for every size.
+        const uint32_t calls = std::max(static_cast<uint32_t>(64), std::min(static_cast<uint32_t>(20000), (256 * 1024 * 1024) / size));
+        std::vector<uint8_t> payload(size, 0xA5);
+        uint32_t failures = 0;
+
+        Share(shared);
+
+        Clock::time_point start = Clock::now();
+
+        for (uint32_t count = 0; count < calls; count++) {
+            if (Call(payload) == false) {
+                failures++;
+            }
+        }
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        Share(false);
+
+        printf("%-8s %9d %12.0f %12.1f %9d\n",
+            (shared == true ? _T("shared") : _T("inline")),
+            size,
+            calls / seconds,
+            (2.0 * calls * size) / (seconds * 1024 * 1024),
+            failures);
+    }
+
+private:
+    bool Call(const std::vector<uint8_t>& payload)
+    {
+        bool result = false;
+        Core::ProxyType<RPC::InvokeMessage> message(_messages.Element());
+        Core::ProxyType<RPC::SharedArena> outbound;
+        Core::ProxyType<RPC::SharedArena> inbound;
+        const bool shared = RPC::Administrator::Instance().Shared(&_client, outbound, inbound);
+
+        message->Parameters().Set(0, InterfaceId, 3);
+        message->Parameters().Writer().Buffer<uint32_t>(static_cast<uint32_t>(payload.size()), payload.data());
+
+        if (shared == true) {
+            message->Parameters().Share(*outbound);
+        }
+
+        if ((_client.Invoke(message, Core::infinite) == Core::ERROR_NONE) && ((shared == false) || (message->Response().Resolve(inbound) == true))) {
+            RPC::Data::Frame::Reader reader(message->Response().Reader());
+            const uint8_t* buffer = nullptr;
+
+            uint32_t length = reader.LockBuffer<uint32_t>(buffer);
+            result = ((length == payload.size()) && (buffer[length - 1] == payload[length - 1]));
+            reader.UnlockBuffer(length);
+        }
+
+        return (result);
+    }
+
+private:
+    const string _connector;
+    Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t>> _factory;
+    Core::IPCChannelClientType<Core::Void, true, false> _server;
+    Core::IPCChannelClientType<Core::Void, false, false> _client;
+    Core::ProxyPoolType<RPC::InvokeMessage> _messages;
+    Core::ProxyType<RPC::SharedArena> _clientArena;
+    Core::ProxyType<RPC::SharedArena> _serverArena;
+};
+
+/* static */ constexpr uint32_t Benchmark::InterfaceId;
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    string connector((argc > 1) ? argv[1] : _T("/tmp/comrpcbenchmark"));
+
+    {
+        Benchmark benchmark(connector);
+
+        if (benchmark.IsValid() == false) {
+            printf("Could not open the channel on %s\n", connector.c_str());
+        } else {
+            printf("%-8s %9s %12s %12s %9s\n", _T("mode"), _T("bytes"), _T("calls/s"), _T("MB/s"), _T("failures"));
+
+            for (uint32_t size : { 1024, 64 * 1024, 1024 * 1024 }) {
+                benchmark.Run(size, false);
+                benchmark.Run(size, true);
+            }
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,234 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "Module.h"
+
+using namespace WPEFramework;
+
+// Sends datagrams over the loopback from one SocketDatagram to another, both handled by the ResourceMonitor
+// thread, like the SSDP discovery does. The sender keeps a window of datagrams in flight, so the socket
+// buffers do not overflow, and the number of datagrams a second that make it through is measured. Each
+// size is run with one datagram per system call and with batches (recvmmsg/sendmmsg). The sockets use the
+// default ReceiveBatch/SendBatch, so this is what an unchanged SendData/ReceiveData handler gets.
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t Window = 512;
+    constexpr uint16_t Slots = 32;
+    constexpr uint32_t SocketBufferSize = (2 * 1024 * 1024);
+
+    class Receiver;
+
+    class Sender : public Core::SocketDatagram {
+    public:
+        Sender() = delete;
+        Sender(const Sender&) = delete;
+        Sender& operator=(const Sender&) = delete;
+
+        Sender(const Core::NodeId& localNode, const Core::NodeId& remoteNode, const uint32_t size)
+            : Core::SocketDatagram(false, localNode, remoteNode, size, 0, SocketBufferSize, 0)
+            , _size(size)
+            , _sent(0)
+            , _acknowledged(0)
+            , _waiting(false)
+        {
+        }
+        ~Sender() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        uint64_t Sent() const
+        {
+            return (_sent);
+        }
+        // Called by the receiver, opens the window again once half of it was received.
+        void Acknowledge(const uint64_t received)
+        {
+            _acknowledged = received;
+
+            if ((_waiting == true) && ((_sent - received) <= (Window / 2))) {
+                _waiting = false;
+                Trigger();
+            }
+        }
+        // Datagrams that got lost would keep the window closed.
+        void Resync(const uint64_t received)
+        {
+            _sent = received;
+            _acknowledged = received;
+            _waiting = false;
+            Trigger();
+        }
+
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
+        {
+            uint32_t result = 0;
+
+            if ((_sent - _acknowledged) < Window) {
+                result = std::min(_size, maxSendSize);
+                ::memcpy(dataFrame, &_sent, sizeof(_sent));
+                _sent++;
+            }
+            else {
+                _waiting = true;
+            }
+
+            return (result);
+        }
+        uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+        {
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        const uint32_t _size;
+        std::atomic<uint64_t> _sent;
+        std::atomic<uint64_t> _acknowledged;
+        std::atomic<bool> _waiting;
+    };
+
+    class Receiver : public Core::SocketDatagram {
+    public:
+        Receiver() = delete;
+        Receiver(const Receiver&) = delete;
+        Receiver& operator=(const Receiver&) = delete;
+
+        Receiver(const Core::NodeId& localNode, const Core::NodeId& remoteNode, const uint32_t size, Sender& sender)
+            : Core::SocketDatagram(false, localNode, remoteNode, 0, size, 0, SocketBufferSize)
+            , _sender(sender)
+            , _received(0)
+        {
+        }
+        ~Receiver() override
+        {
+            Close(Core::infinite);
+        }
+
+    public:
+        uint64_t Received() const
+        {
+            return (_received);
+        }
+
+        uint32_t SendData(uint8_t*, const uint32_t) override
+        {
+            return (0);
+        }
+        uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+        {
+            _received++;
+            _sender.Acknowledge(_received);
+
+            return (receivedSize);
+        }
+        void StateChange() override
+        {
+        }
+
+    private:
+        Sender& _sender;
+        std::atomic<uint64_t> _received;
+    };
+
+    void Run(const uint32_t size, const uint16_t slots, const uint32_t seconds)
+    {
+        const Core::NodeId receiverNode(_T("127.0.0.1"), 12471, Core::NodeId::TYPE_IPV4);
+        const Core::NodeId senderNode(_T("127.0.0.1"), 12472, Core::NodeId::TYPE_IPV4);
+
+        Sender sender(senderNode, receiverNode, size);
+        Receiver receiver(receiverNode, senderNode, size, sender);
+
+        sender.Batch(slots);
+        receiver.Batch(slots);
+
+        if ((receiver.Open(Core::infinite) != Core::ERROR_NONE) || (sender.Open(Core::infinite) != Core::ERROR_NONE)) {
+            printf("Could not open the sockets\n");
+        }
+        else {
+            uint64_t resyncs = 0;
+            uint64_t last = 0;
+
+            sender.Trigger();
+
+            // Warm up..
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+            const uint64_t begin = receiver.Received();
+            const Clock::time_point start = Clock::now();
+            const Clock::time_point end = start + std::chrono::seconds(seconds);
+
+            while (Clock::now() < end) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+                const uint64_t current = receiver.Received();
+
+                if (current == last) {
+                    resyncs++;
+                    sender.Resync(current);
+                }
+
+                last = current;
+            }
+
+            const uint64_t datagrams = receiver.Received() - begin;
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            printf("%6d %8s %14.0f %10.1f %8llu\n", size, (slots > 1 ? _T("batched") : _T("single")), datagrams / elapsed, (datagrams * size) / (elapsed * 1024 * 1024), static_cast<unsigned long long>(resyncs));
+
+            sender.Close(Core::infinite);
+            receiver.Close(Core::infinite);
+        }
+    }
+
+}
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    const uint32_t seconds = (argc > 1 ? static_cast<uint32_t>(::atoi(argv[1])) : 3);
+
+    if (seconds == 0) {
+        printf("Usage: %s [seconds per run]\n", argv[0]);
+    }
+    else {
+        printf("%d datagrams in flight, batches of %d, %d seconds per run\n\n", Window, Slots, seconds);
+        printf("%6s %8s %14s %10s %8s\n", _T("size"), _T("mode"), _T("datagrams/s"), _T("MB/s"), _T("stalls"));
+
+        for (const uint32_t size : { 64, 1400 }) {
+            Run(size, 1, seconds);
+            Run(size, Slots, seconds);
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
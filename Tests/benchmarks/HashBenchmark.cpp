@@ -0,0 +1,202 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+
+#include "Module.h"
+
+#include <cryptalgo/cryptalgo.h>
+
+using namespace WPEFramework;
+
+// Hashes with the portable block functions and with the ones for the CPU: the SHA instructions (x86 SHA-NI or
+// ARMv8) for one message at a time and AVX2 for 8 messages side by side in SHA256::Batch(). First the
+// throughput of single messages, then the number of small messages a second, the way the WebSocket handshake
+// keys and JSON Web Tokens come in, and last HMAC-SHA256 over a token sized message, with the key hashed for
+// every MAC, the way it was done, and continued from the prepared key state. Whatever the CPU lacks is a "-".
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint16_t Messages = 64;
+
+    // Returns the number of times a second the action is done, done for about the given time.
+    template <typename ACTION>
+    double Measure(const uint32_t milliseconds, ACTION&& action)
+    {
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point end = start + std::chrono::milliseconds(milliseconds);
+        uint64_t count = 0;
+
+        while (Clock::now() < end) {
+            for (uint16_t loop = 0; loop < 16; loop++) {
+                action();
+                count++;
+            }
+        }
+
+        return (count / std::chrono::duration<double>(Clock::now() - start).count());
+    }
+
+    void Print(const uint8_t supported, const uint8_t required, const double value)
+    {
+        if ((supported & required) == required) {
+            printf(" %10.0f", value);
+        } else {
+            printf(" %10s", _T("-"));
+        }
+    }
+
+    template <typename HASH>
+    double Throughput(const uint8_t acceleration, const std::vector<uint8_t>& message, const uint32_t milliseconds)
+    {
+        Crypto::Acceleration(acceleration);
+
+        return ((Measure(milliseconds, [&]() {
+            HASH hash(message.data(), static_cast<uint16_t>(message.size()));
+            hash.Result();
+        }) * message.size()) / (1024 * 1024));
+    }
+
+    void Throughputs(const uint8_t supported, const uint16_t size, const uint32_t milliseconds)
+    {
+        std::vector<uint8_t> message(size);
+
+        for (uint16_t index = 0; index < size; index++) {
+            message[index] = static_cast<uint8_t>(index * 7);
+        }
+
+        printf("%7d", size);
+        Print(supported, Crypto::ACCELERATION_NONE, Throughput<Crypto::SHA1>(Crypto::ACCELERATION_NONE, message, milliseconds));
+        Print(supported, Crypto::ACCELERATION_SHA, Throughput<Crypto::SHA1>(Crypto::ACCELERATION_SHA, message, milliseconds));
+        Print(supported, Crypto::ACCELERATION_NONE, Throughput<Crypto::SHA256>(Crypto::ACCELERATION_NONE, message, milliseconds));
+        Print(supported, Crypto::ACCELERATION_SHA, Throughput<Crypto::SHA256>(Crypto::ACCELERATION_SHA, message, milliseconds));
+        printf("\n");
+    }
+
+    void Batches(const uint8_t supported, const uint16_t size, const uint32_t milliseconds)
+    {
+        std::vector<std::vector<uint8_t>> messages(Messages, std::vector<uint8_t>(size));
+        const uint8_t* pointers[Messages];
+        uint16_t lengths[Messages];
+        uint8_t digests[Messages * Crypto::SHA256::Length];
+
+        for (uint16_t index = 0; index < Messages; index++) {
+            for (uint16_t offset = 0; offset < size; offset++) {
+                messages[index][offset] = static_cast<uint8_t>(index + offset);
+            }
+
+            pointers[index] = messages[index].data();
+            lengths[index] = size;
+        }
+
+        printf("%7d", size);
+
+        for (const uint8_t acceleration : { static_cast<uint8_t>(Crypto::ACCELERATION_NONE), static_cast<uint8_t>(Crypto::ACCELERATION_SHA), static_cast<uint8_t>(Crypto::ACCELERATION_MULTIBUFFER), static_cast<uint8_t>(Crypto::ACCELERATION_SHA | Crypto::ACCELERATION_MULTIBUFFER) }) {
+            Crypto::Acceleration(acceleration);
+
+            const double batches = Measure(milliseconds, [&]() {
+                Crypto::SHA256::Batch(Messages, pointers, lengths, digests);
+            });
+
+            Print(supported, acceleration, batches * Messages);
+        }
+
+        printf("\n");
+    }
+
+    void MACs(const uint32_t milliseconds)
+    {
+        const string key(_T("0123456789abcdef0123456789abcdef"));
+        const string token(_T("eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9.eyJ1cmwiOiJodHRwOi8vbG9jYWxob3N0IiwidXNlciI6IldQRUZyYW1ld29yayIsImNhbGxzaWducyI6WyJDb250cm9sbGVyIiwiRGV2aWNlSW5mbyJdfQ"));
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(token.data());
+        const uint16_t length = static_cast<uint16_t>(token.size());
+
+        Crypto::SHA256HMAC::KeyContext prepared;
+        Crypto::SHA256HMAC::Prepare(key, prepared);
+
+        Crypto::SHA256HMAC reused(key);
+
+        const double keyed = Measure(milliseconds, [&]() {
+            Crypto::SHA256HMAC hmac(key);
+            hmac.Input(data, length);
+            hmac.Result();
+        });
+        const double continued = Measure(milliseconds, [&]() {
+            Crypto::SHA256HMAC hmac(prepared);
+            hmac.Input(data, length);
+            hmac.Result();
+        });
+        const double reset = Measure(milliseconds, [&]() {
+            reused.Reset();
+            reused.Input(data, length);
+            reused.Result();
+        });
+
+        printf("%-13s %10.0f %10.0f %10.0f\n", (Crypto::Acceleration() == Crypto::ACCELERATION_NONE ? _T("portable") : _T("accelerated")), keyed, continued, reset);
+    }
+
+}
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    const uint32_t milliseconds = (argc > 1 ? static_cast<uint32_t>(::atoi(argv[1])) : 500);
+
+    if (milliseconds == 0) {
+        printf("Usage: %s [milliseconds per run]\n", argv[0]);
+    }
+    else {
+        const uint8_t supported = Crypto::Acceleration(Crypto::ACCELERATION_SHA | Crypto::ACCELERATION_MULTIBUFFER);
+
+        printf("CPU support: SHA instructions %s, AVX2 multi-buffer %s, %d ms per run\n\n",
+            ((supported & Crypto::ACCELERATION_SHA) != 0 ? _T("yes") : _T("no")),
+            ((supported & Crypto::ACCELERATION_MULTIBUFFER) != 0 ? _T("yes") : _T("no")), milliseconds);
+
+        printf("MB/s, one message at a time\n\n");
+        printf("%7s %21s %21s\n", _T(""), _T("SHA-1"), _T("SHA-256"));
+        printf("%7s %10s %10s %10s %10s\n", _T("size"), _T("portable"), _T("SHA"), _T("portable"), _T("SHA"));
+
+        for (const uint16_t size : { 64, 1024, 16384, 65535 }) {
+            Throughputs(supported, size, milliseconds);
+        }
+
+        printf("\nSHA-256 messages/s, %d at a time through SHA256::Batch()\n\n", Messages);
+        printf("%7s %10s %10s %10s %10s\n", _T("size"), _T("portable"), _T("SHA"), _T("AVX2"), _T("SHA+AVX2"));
+
+        for (const uint16_t size : { 24, 60, 200, 1000 }) {
+            Batches(supported, size, milliseconds);
+        }
+
+        printf("\nHMAC-SHA256 MACs/s of a token of 155 bytes\n\n");
+        printf("%-13s %10s %10s %10s\n", _T(""), _T("keyed"), _T("prepared"), _T("reset"));
+
+        Crypto::Acceleration(Crypto::ACCELERATION_NONE);
+        MACs(milliseconds);
+        Crypto::Acceleration(supported);
+        MACs(milliseconds);
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
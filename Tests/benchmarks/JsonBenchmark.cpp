@@ -0,0 +1,241 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+
+#include "Module.h"
+
+using namespace WPEFramework;
+
+// Measures how fast JSON text is deserialized into the Core::JSON elements, in MB/s of text.
+// The payloads resemble what comes in over a PluginHost::Channel: JSON-RPC requests of which the
+// params are kept opaque, a Controller status list and a plugin configuration, the latter both
+// compact and pretty printed. Every payload is parsed in one go and fed in socket sized chunks.
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    class Plugin : public Core::JSON::Container {
+    public:
+        Plugin& operator=(const Plugin&) = delete;
+
+        Plugin()
+            : Core::JSON::Container()
+            , Callsign()
+            , Locator()
+            , ClassName()
+            , State()
+            , Observers()
+            , Configuration()
+        {
+            Init();
+        }
+        Plugin(const Plugin& copy)
+            : Core::JSON::Container()
+            , Callsign(copy.Callsign)
+            , Locator(copy.Locator)
+            , ClassName(copy.ClassName)
+            , State(copy.State)
+            , Observers(copy.Observers)
+            , Configuration(copy.Configuration)
+        {
+            Init();
+        }
+        ~Plugin() override = default;
+
+    private:
+        void Init()
+        {
+            Add(_T("callsign"), &Callsign);
+            Add(_T("locator"), &Locator);
+            Add(_T("classname"), &ClassName);
+            Add(_T("state"), &State);
+            Add(_T("observers"), &Observers);
+            Add(_T("configuration"), &Configuration);
+        }
+
+    public:
+        Core::JSON::String Callsign;
+        Core::JSON::String Locator;
+        Core::JSON::String ClassName;
+        Core::JSON::String State;
+        Core::JSON::DecUInt32 Observers;
+        Core::JSON::String Configuration;
+    };
+
+    class Status : public Core::JSON::Container {
+    public:
+        Status(const Status&) = delete;
+        Status& operator=(const Status&) = delete;
+
+        Status()
+            : Core::JSON::Container()
+            , Plugins()
+        {
+            Add(_T("plugins"), &Plugins);
+        }
+        ~Status() override = default;
+
+    public:
+        Core::JSON::ArrayType<Plugin> Plugins;
+    };
+
+    class Configuration : public Core::JSON::Container {
+    public:
+        Configuration(const Configuration&) = delete;
+        Configuration& operator=(const Configuration&) = delete;
+
+        Configuration()
+            : Core::JSON::Container()
+            , Url()
+            , UserAgent()
+            , Injectedbundle()
+            , Transparent()
+            , Cookies()
+            , Certificate()
+        {
+            Add(_T("url"), &Url);
+            Add(_T("useragent"), &UserAgent);
+            Add(_T("injectedbundle"), &Injectedbundle);
+            Add(_T("transparent"), &Transparent);
+            Add(_T("cookies"), &Cookies);
+            Add(_T("certificate"), &Certificate);
+        }
+        ~Configuration() override = default;
+
+    public:
+        Core::JSON::String Url;
+        Core::JSON::String UserAgent;
+        Core::JSON::String Injectedbundle;
+        Core::JSON::Boolean Transparent;
+        Core::JSON::ArrayType<Core::JSON::String> Cookies;
+        Core::JSON::String Certificate;
+    };
+
+    string Config(const bool pretty)
+    {
+        const TCHAR* newline = (pretty ? _T("\n    ") : _T(""));
+        const TCHAR* indent = (pretty ? _T("\n        ") : _T(""));
+        string result(_T("{"));
+
+        result += newline + string(_T("\"url\": \"https://www.example.com/apps/launcher/index.html?device=stb&lang=en\","));
+        result += newline + string(_T("\"useragent\": \"Mozilla/5.0 (Linux; x86_64 GNU/Linux) AppleWebKit/601.1 (KHTML, like Gecko) Version/8.0 Safari/601.1 WPE\","));
+        result += newline + string(_T("\"injectedbundle\": \"libWebInjectedBundle.so\","));
+        result += newline + string(_T("\"transparent\": true,"));
+        result += newline + string(_T("\"cookies\": ["));
+        for (uint32_t index = 0; index < 16; index++) {
+            result += indent + string(_T("\"session")) + Core::NumberType<uint32_t>(index).Text() + _T("=a3f1c9e07b2d4f6a8c0e1b3d5f7a9c2e4b6d8f0a1c3e5b7d; Path=/; Secure; HttpOnly\"") + (index != 15 ? _T(",") : _T(""));
+        }
+        result += newline + string(_T("],"));
+        result += newline + string(_T("\"certificate\": \"-----BEGIN CERTIFICATE-----\\n")) + string(1200, 'Q') + _T("\\n-----END CERTIFICATE-----\\n\"");
+        result += (pretty ? _T("\n}") : _T("}"));
+
+        return (result);
+    }
+
+    string Request()
+    {
+        return (string(_T("{\"jsonrpc\":\"2.0\",\"id\":1234,\"method\":\"Controller.1.configuration@WebKitBrowser\",\"params\":")) + Config(false) + _T("}"));
+    }
+
+    string List()
+    {
+        string result(_T("{\"plugins\":["));
+
+        for (uint32_t index = 0; index < 40; index++) {
+            const string name(_T("Plugin") + Core::NumberType<uint32_t>(index).Text());
+
+            result += (index != 0 ? _T(",") : _T(""));
+            result += _T("{\"callsign\":\"") + name + _T("\",\"locator\":\"libWPEFramework") + name + _T(".so\",\"classname\":\"") + name + _T("\",\"state\":\"activated\",\"observers\":") + Core::NumberType<uint32_t>(index).Text();
+            result += _T(",\"configuration\":{\"root\":{\"mode\":\"Local\",\"outofprocess\":true},\"startmode\":\"Activated\",\"list\":[1,2,3,4]}}");
+        }
+        result += _T("]}");
+
+        return (result);
+    }
+
+    // Returns the MB/s for the text, parsed in chunks of the given size (0 is all at once). If fresh, every
+    // round parses into a newly constructed element, like a message that is received.
+    template <typename ELEMENT>
+    double Measure(const string& text, const uint16_t chunk, const bool fresh = false)
+    {
+        // Parse roughly the same amount of text for each payload.
+        const uint32_t rounds = std::max(static_cast<uint32_t>(100), static_cast<uint32_t>((64 * 1024 * 1024) / text.length()));
+        uint32_t failures = 0;
+
+        std::unique_ptr<ELEMENT> element(new ELEMENT());
+
+        Clock::time_point start = Clock::now();
+
+        for (uint32_t round = 0; round < rounds; round++) {
+            Core::OptionalType<Core::JSON::Error> error;
+            uint32_t offset = 0;
+            uint32_t index = 0;
+
+            if (fresh == true) {
+                element.reset(new ELEMENT());
+            }
+            else {
+                element->Clear();
+            }
+
+            while ((index < text.length()) && (error.IsSet() == false)) {
+                const uint16_t size = static_cast<uint16_t>(std::min(static_cast<size_t>(chunk == 0 ? 0xFFFF : chunk), text.length() - index));
+                index += element->Deserialize(&(text[index]), size, offset, error);
+            }
+
+            if (error.IsSet() == true) {
+                failures++;
+            }
+        }
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (failures != 0) {
+            printf("%d rounds failed!\n", failures);
+        }
+
+        return ((static_cast<double>(rounds) * text.length()) / (seconds * 1024 * 1024));
+    }
+
+    template <typename ELEMENT>
+    void Run(const TCHAR name[], const string& text, const bool fresh = false)
+    {
+        printf("%-22s %8d %10.1f %10.1f\n", name, static_cast<uint32_t>(text.length()), Measure<ELEMENT>(text, 0, fresh), Measure<ELEMENT>(text, 1024, fresh));
+    }
+}
+
+#ifdef __WINDOWS__
+int _tmain()
+#else
+int main()
+#endif
+{
+    printf("%-22s %8s %10s %10s\n", _T("payload"), _T("bytes"), _T("MB/s"), _T("MB/s 1K"));
+
+    Run<Core::JSONRPC::Message>(_T("request (opaque)"), Request());
+    Run<Core::JSONRPC::Message>(_T("small request (fresh)"), _T("{\"jsonrpc\":\"2.0\",\"id\":7,\"method\":\"Controller.1.status@WebKitBrowser\"}"), true);
+    Run<Configuration>(_T("configuration"), Config(false));
+    Run<Configuration>(_T("configuration pretty"), Config(true));
+    Run<Status>(_T("status list"), List());
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,168 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Module.h"
+
+#include <messaging/messaging.h>
+
+using namespace WPEFramework;
+
+// Measures how many messages per second a number of threads can push into the message buffer,
+// once with every message going directly into the buffer (a lock and a doorbell ring per message)
+// and once with the messages staged per thread and moved in batches. A reader, like the
+// MessageClient would be, drains the buffer while the producers run.
+class Benchmark {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint16_t DataSize = 60 * 1024;
+    static constexpr uint16_t MetadataSize = 1024;
+    static constexpr uint32_t Messages = 400000;
+    static constexpr uint16_t MessageSize = 64;
+
+    using Buffer = Messaging::MessageDataBufferType<DataSize, MetadataSize>;
+
+public:
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    Benchmark(const string& basePath)
+        : _basePath(basePath)
+        , _instance(0)
+    {
+        if (Core::File(_basePath).IsDirectory() == true) {
+            Core::Directory(_basePath.c_str()).Destroy();
+        }
+        Core::Directory(_basePath.c_str()).CreatePath();
+    }
+    ~Benchmark()
+    {
+        Core::Directory(_basePath.c_str()).Destroy();
+    }
+
+public:
+    void Run(const uint32_t producers, const bool staged)
+    {
+        const uint32_t instance = _instance++;
+        Buffer writer(_T("bench"), instance, _basePath, 0, true, staged);
+        Buffer reader(_T("bench"), instance, _basePath, 0, false, false);
+        std::atomic<bool> running(true);
+        std::atomic<uint32_t> received(0);
+        std::atomic<uint32_t> failures(0);
+
+        std::thread consumer([&]() {
+            uint8_t data[DataSize];
+
+            while (running.load() == true) {
+                if (reader.Wait(10) == Core::ERROR_NONE) {
+                    uint16_t length = sizeof(data);
+
+                    while (reader.PopData(length, data) == Core::ERROR_NONE) {
+                        received++;
+                        length = sizeof(data);
+                    }
+                }
+            }
+        });
+
+        // Make sure the reader is listening before the first ring.
+        SleepMs(50);
+
+        std::vector<std::thread> threads;
+        Clock::time_point start = Clock::now();
+
+        for (uint32_t producer = 0; producer < producers; producer++) {
+            threads.emplace_back([&]() {
+                uint8_t message[MessageSize];
+                ::memset(message, 'm', sizeof(message));
+
+                for (uint32_t count = 0; count < (Messages / producers); count++) {
+                    if (writer.PushData(sizeof(message), message) != Core::ERROR_NONE) {
+                        failures++;
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        writer.Settle();
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        // Let the reader catch up.
+        uint32_t last = ~0;
+        while (received.load() != last) {
+            last = received.load();
+            SleepMs(100);
+        }
+
+        running = false;
+        consumer.join();
+
+        const uint32_t pushed = (Messages / producers) * producers;
+
+        printf("%-8s %9d %14.0f %10d %9d\n",
+            (staged == true ? _T("staged") : _T("direct")),
+            producers,
+            pushed / seconds,
+            received.load(),
+            failures.load());
+    }
+
+private:
+    const string _basePath;
+    uint32_t _instance;
+};
+
+/* static */ constexpr uint16_t Benchmark::DataSize;
+/* static */ constexpr uint16_t Benchmark::MetadataSize;
+/* static */ constexpr uint32_t Benchmark::Messages;
+/* static */ constexpr uint16_t Benchmark::MessageSize;
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    string basePath((argc > 1) ? argv[1] : _T("/tmp/messagingbenchmark/"));
+
+    {
+        Benchmark benchmark(basePath);
+
+        printf("%-8s %9s %14s %10s %9s\n", _T("mode"), _T("producers"), _T("messages/s"), _T("received"), _T("failures"));
+
+        for (uint32_t producers : { 1, 4, 16 }) {
+            benchmark.Run(producers, false);
+            benchmark.Run(producers, true);
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
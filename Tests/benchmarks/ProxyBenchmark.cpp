@@ -0,0 +1,275 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "Module.h"
+
+using namespace WPEFramework;
+
+// Churns ProxyType objects like a long running framework does: every thread keeps a working set of objects of
+// mixed sizes that it keeps replacing, and a smaller set of objects that live a lot longer. The objects come from
+// the heap (or the shared arena, if built with PROXY_SLAB_ALLOCATOR) or from a slab arena of their own, selected
+// by the first argument. The number of allocations is that of the given number of hours (the second argument,
+// default 24) at an assumed rate, the RSS is printed along the way.
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    // 50 requests a second, of 20 ProxyType objects each.
+    constexpr uint32_t PerSecond = 1000;
+    constexpr uint32_t Threads = 4;
+    constexpr uint32_t WorkingSet = 4096;
+    constexpr uint32_t LongLiving = 512;
+
+    class Base {
+    public:
+        Base(const Base&) = delete;
+        Base& operator=(const Base&) = delete;
+
+        Base() = default;
+        virtual ~Base() = default;
+    };
+
+    template <uint16_t SIZE>
+    class Payload : public Base {
+    public:
+        Payload(const Payload<SIZE>&) = delete;
+        Payload<SIZE>& operator=(const Payload<SIZE>&) = delete;
+
+        Payload()
+        {
+            ::memset(_data, (SIZE & 0xFF), sizeof(_data));
+        }
+        ~Payload() override = default;
+
+    private:
+        uint8_t _data[SIZE];
+    };
+
+    template <uint16_t SIZE>
+    class Slabbed : public Payload<SIZE> {
+    public:
+        Slabbed(const Slabbed<SIZE>&) = delete;
+        Slabbed<SIZE>& operator=(const Slabbed<SIZE>&) = delete;
+
+        Slabbed() = default;
+        ~Slabbed() override = default;
+    };
+
+    // All Slabbed types share one arena.
+    struct SlabArena {
+        static Core::SlabAllocator& Arena()
+        {
+            static Core::SlabAllocator& arena = *(new Core::SlabAllocator(_T("benchmark")));
+
+            return (arena);
+        }
+        static void* Allocate(const size_t size)
+        {
+            return (Arena().Allocate(size));
+        }
+        static void Free(void* block, const size_t size)
+        {
+            Arena().Free(block, size);
+        }
+    };
+
+}
+
+namespace WPEFramework {
+namespace Core {
+
+    template <uint16_t SIZE>
+    struct ProxyAllocatorType<Slabbed<SIZE>> : public SlabArena {
+    };
+
+}
+}
+
+namespace {
+
+    template <template <uint16_t> class TYPE>
+    Core::ProxyType<Base> Create(const uint32_t random)
+    {
+        Core::ProxyType<Base> result;
+
+        switch (random % 6) {
+        case 0:
+            result = Core::ProxyType<TYPE<48>>::Create();
+            break;
+        case 1:
+            result = Core::ProxyType<TYPE<128>>::Create();
+            break;
+        case 2:
+            result = Core::ProxyType<TYPE<320>>::Create();
+            break;
+        case 3:
+            result = Core::ProxyType<TYPE<1000>>::Create();
+            break;
+        default:
+            // Like the buffers that are sized at runtime.
+            result = Core::ProxyType<TYPE<64>>::CreateEx((random >> 8) % 2048);
+            break;
+        }
+
+        return (result);
+    }
+
+    template <template <uint16_t> class TYPE>
+    void Churn(const uint32_t seed, const uint64_t rounds, std::atomic<uint64_t>& done, const std::atomic<bool>& measured)
+    {
+        std::vector<Core::ProxyType<Base>> working(WorkingSet);
+        std::vector<Core::ProxyType<Base>> living(LongLiving);
+        uint32_t random = seed;
+
+        for (uint64_t round = 0; round < rounds; round++) {
+            // xorshift
+            random ^= random << 13;
+            random ^= random >> 17;
+            random ^= random << 5;
+
+            if ((random % 1000) == 0) {
+                living[(random >> 10) % LongLiving] = Create<TYPE>(random);
+            }
+            else {
+                working[(random >> 10) % WorkingSet] = Create<TYPE>(random);
+            }
+
+            if ((round & 0x3FF) == 0x3FF) {
+                done.fetch_add(0x400, std::memory_order_relaxed);
+            }
+        }
+
+        done.fetch_add((rounds & 0x3FF), std::memory_order_relaxed);
+
+        // Keep the objects until the last measurement is taken.
+        while (measured.load(std::memory_order_relaxed) == false) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    double Megabytes(const uint64_t bytes)
+    {
+        return (static_cast<double>(bytes) / (1024 * 1024));
+    }
+
+    // The arena is only there to report on, the TYPE decides where the objects come from.
+    template <template <uint16_t> class TYPE>
+    void Run(const uint32_t hours, const Core::SlabAllocator* arena)
+    {
+        const uint64_t total = static_cast<uint64_t>(hours) * 3600 * PerSecond;
+        const uint64_t interval = (static_cast<uint64_t>(2) * 3600 * PerSecond);
+        std::atomic<uint64_t> done(0);
+        std::atomic<bool> measured(false);
+        std::vector<std::thread> threads;
+        Core::ProcessInfo process;
+
+        uint64_t warm = 0;
+        uint64_t resident = 0;
+        uint64_t checkpoint = interval;
+        uint64_t previous = 0;
+
+        printf("%8s %12s %10s %10s %6s\n", _T("hours"), _T("allocs/s"), _T("RSS MB"), _T("slabs MB"), _T("frag%"));
+
+        Clock::time_point start = Clock::now();
+        Clock::time_point last = start;
+
+        for (uint32_t thread = 0; thread < Threads; thread++) {
+            threads.emplace_back(Churn<TYPE>, 0x9E3779B9 * (thread + 1), total / Threads, std::ref(done), std::cref(measured));
+        }
+
+        while (checkpoint <= total) {
+            const uint64_t current = done.load(std::memory_order_relaxed);
+
+            if (current >= checkpoint) {
+                const Clock::time_point now = Clock::now();
+                Core::SlabAllocator::Metadata metadata;
+
+                resident = process.Resident();
+
+                if (checkpoint == interval) {
+                    warm = resident;
+                }
+
+                printf("%8d %12.0f %10.1f", static_cast<uint32_t>(checkpoint / (3600 * PerSecond)), (current - previous) / std::chrono::duration<double>(now - last).count(), Megabytes(resident));
+
+                if (arena != nullptr) {
+                    arena->Snapshot(metadata);
+                    printf(" %10.1f %6d\n", Megabytes(metadata.Reserved), metadata.Fragmentation);
+                }
+                else {
+                    printf(" %10s %6s\n", _T("-"), _T("-"));
+                }
+
+                previous = current;
+                last = now;
+                checkpoint += interval;
+            }
+            else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        }
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        measured = true;
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        printf("\n%llu allocations in %.1f s: %.0f allocs/s\n", static_cast<unsigned long long>(total), seconds, total / seconds);
+        printf("RSS after the first interval %.1f MB, at the end %.1f MB: %+.1f MB\n", Megabytes(warm), Megabytes(resident), Megabytes(resident) - Megabytes(warm));
+    }
+
+}
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    const bool slab = ((argc > 1) && (::strcmp(argv[1], _T("slab")) == 0));
+    const uint32_t hours = (argc > 2 ? static_cast<uint32_t>(::atoi(argv[2])) : 24);
+
+    if ((hours < 2) || ((argc > 1) && (slab == false) && (::strcmp(argv[1], _T("heap")) != 0))) {
+        printf("Usage: %s [heap|slab] [hours, at least 2]\n", argv[0]);
+    }
+    else {
+        printf("%s, %d threads, %d allocations/s for %d hours\n\n", (slab ? _T("slab") : _T("heap")), Threads, PerSecond, hours);
+
+        if (slab == true) {
+            Run<Slabbed>(hours, &(SlabArena::Arena()));
+        }
+        else {
+#ifdef __CORE_PROXY_SLAB_ALLOCATOR__
+            Run<Payload>(hours, &(Core::SlabAllocator::Instance()));
+#else
+            Run<Payload>(hours, nullptr);
+#endif
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
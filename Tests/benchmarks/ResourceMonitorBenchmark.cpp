@@ -0,0 +1,231 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "Module.h"
+
+using namespace WPEFramework;
+
+// Measures the cost of a ResourceMonitor wakeup as a function of the number of monitored
+// descriptors. A set of idle eventfd resources is registered, after which one, randomly
+// picked, resource gets signalled at a time. Reported are the average and p99 latency
+// between the signal and the Handle, and the latency of a Break, which is offered to all
+// resources. Build with and without RESOURCE_MONITOR_EPOLL to compare both backends.
+class Benchmark {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    class Resource : public Core::IResource {
+    public:
+        Resource() = delete;
+        Resource(const Resource&) = delete;
+        Resource& operator=(const Resource&) = delete;
+
+        Resource(Benchmark& parent)
+            : _parent(parent)
+            , _descriptor(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+        {
+            ASSERT(_descriptor != -1);
+        }
+        ~Resource() override
+        {
+            ::close(_descriptor);
+        }
+
+    public:
+        bool IsValid() const
+        {
+            return (_descriptor != -1);
+        }
+        void Signal()
+        {
+            const uint64_t value = 1;
+            ssize_t VARIABLE_IS_NOT_USED length = ::write(_descriptor, &value, sizeof(value));
+        }
+        handle Descriptor() const override
+        {
+            return (_descriptor);
+        }
+        uint16_t Events() override
+        {
+            return (POLLIN);
+        }
+        void Handle(const uint16_t events) override
+        {
+            if ((events & POLLIN) != 0) {
+                uint64_t value;
+                ssize_t VARIABLE_IS_NOT_USED length = ::read(_descriptor, &value, sizeof(value));
+            }
+            _parent.Handled(*this, events);
+        }
+
+    private:
+        Benchmark& _parent;
+        const handle _descriptor;
+    };
+
+public:
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    Benchmark(const uint32_t rounds)
+        : _rounds(rounds)
+        , _resources()
+        , _target(nullptr)
+        , _breaking(false)
+        , _done(false, true)
+    {
+    }
+    ~Benchmark() = default;
+
+public:
+    void Run(const uint32_t count)
+    {
+        Core::ResourceMonitor& monitor = Core::ResourceMonitor::Instance();
+
+        for (uint32_t index = 0; index < count; index++) {
+            _resources.emplace_back(new Resource(*this));
+            ASSERT(_resources.back()->IsValid() == true);
+            monitor.Register(*_resources.back());
+        }
+
+        // Make sure all registrations are picked up before we start measuring.
+        Break();
+
+        std::vector<uint32_t> latencies;
+        latencies.reserve(_rounds);
+
+        uint32_t runs = monitor.Runs();
+
+        for (uint32_t round = 0; round < _rounds; round++) {
+            Resource* target = _resources[::rand() % _resources.size()];
+
+            _target = target;
+            _done.ResetEvent();
+
+            Clock::time_point start = Clock::now();
+            target->Signal();
+            _done.Lock(Core::infinite);
+
+            latencies.push_back(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+        }
+
+        runs = monitor.Runs() - runs;
+
+        uint64_t breaking = 0;
+        for (uint32_t round = 0; round < (_rounds / 10); round++) {
+            breaking += Break();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        uint64_t total = 0;
+        for (uint32_t latency : latencies) {
+            total += latency;
+        }
+
+        printf("%11d %12.2f %12.2f %12.2f %12.2f\n",
+            count,
+            (total / latencies.size()) / 1000.0,
+            latencies[(latencies.size() * 99) / 100] / 1000.0,
+            (_rounds >= 10 ? (breaking / (_rounds / 10)) / 1000.0 : 0.0),
+            static_cast<float>(runs) / _rounds);
+
+        _target = nullptr;
+
+        // Once unregistered, the monitor does not touch the resource anymore.
+        for (Resource* resource : _resources) {
+            monitor.Unregister(*resource);
+            delete resource;
+        }
+        _resources.clear();
+    }
+
+private:
+    uint64_t Break()
+    {
+        _target = _resources.front();
+        _breaking = true;
+        _done.ResetEvent();
+
+        Clock::time_point start = Clock::now();
+        Core::ResourceMonitor::Instance().Break();
+        _done.Lock(Core::infinite);
+
+        return (std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    void Handled(const Resource& resource, const uint16_t events)
+    {
+        if ((&resource == _target) && ((_breaking == true) || (events != 0))) {
+            _breaking = false;
+            _done.SetEvent();
+        }
+    }
+
+private:
+    const uint32_t _rounds;
+    std::vector<Resource*> _resources;
+    std::atomic<Resource*> _target;
+    std::atomic<bool> _breaking;
+    Core::Event _done;
+};
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    uint32_t rounds = ((argc > 1) ? atoi(argv[1]) : 10000);
+    uint8_t reactors = ((argc > 2) ? atoi(argv[2]) : 1);
+
+    // Every resource takes a descriptor, make sure we are allowed to use them all.
+    struct rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0) {
+        limit.rlim_cur = limit.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    Core::ResourceMonitor::Instance().Reactors(reactors);
+
+    {
+        Benchmark benchmark(rounds);
+
+#ifdef __CORE_RESOURCE_MONITOR_EPOLL__
+        printf("ResourceMonitor backend: epoll\n");
+#else
+        printf("ResourceMonitor backend: poll\n");
+#endif
+        printf("ResourceMonitor reactors: %d\n", Core::ResourceMonitor::Instance().Reactors());
+        printf("%11s %12s %12s %12s %12s\n", _T("descriptors"), _T("avg (us)"), _T("p99 (us)"), _T("break (us)"), _T("runs/wakeup"));
+
+        for (uint32_t count : { 16, 64, 256, 1024, 4096 }) {
+            if ((count + 64) <= limit.rlim_cur) {
+                benchmark.Run(count);
+            }
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
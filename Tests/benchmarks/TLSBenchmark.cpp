@@ -0,0 +1,495 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <csignal>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include "Module.h"
+
+#include <cryptalgo/cryptalgo.h>
+
+using namespace WPEFramework;
+
+// Connects a Crypto::SecureSocketPort over the loopback to a plain OpenSSL server, that runs on a thread of its
+// own with a self signed certificate made on the spot. First the handshakes, from the Open until the
+// connection is validated, for a number of connections, with and without resuming the session of the connection
+// before. Only the handshake is timed, the Open and Close of a SocketPort poll for the state change in slices
+// of 100ms. Then the bulk throughput of a single connection: data from the send buffer, a file that passes through the
+// send buffer (SSL_write) and a file that is sent with sendfile, if the kernel does the encryption (kTLS).
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint16_t Port = 12473;
+    constexpr uint16_t Connections = 25;
+    constexpr uint32_t BulkSize = (64 * 1024 * 1024);
+    const TCHAR FileName[] = _T("/tmp/tlsbenchmark.bin");
+
+    // Every message, 8 bytes of length followed by that much data, is acknowledged with a single byte.
+    class Server {
+    public:
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+
+        Server()
+            : _context(nullptr)
+            , _listener(-1)
+            , _thread()
+        {
+        }
+        ~Server()
+        {
+            Stop();
+        }
+
+    public:
+        bool Start(const uint16_t port)
+        {
+            EVP_PKEY* key = Key();
+            X509* certificate = (key != nullptr ? Certificate(key) : nullptr);
+
+            _context = SSL_CTX_new(TLS_server_method());
+
+            bool result = ((_context != nullptr) && (certificate != nullptr) && (SSL_CTX_use_certificate(_context, certificate) == 1) && (SSL_CTX_use_PrivateKey(_context, key) == 1));
+
+            X509_free(certificate);
+            EVP_PKEY_free(key);
+
+            if (result == true) {
+                struct sockaddr_in address;
+                const int reuse = 1;
+
+                ::memset(&address, 0, sizeof(address));
+                address.sin_family = AF_INET;
+                address.sin_port = htons(port);
+                address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+                _listener = ::socket(AF_INET, SOCK_STREAM, 0);
+                ::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+                result = ((::bind(_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) && (::listen(_listener, 16) == 0));
+
+                if (result == true) {
+                    _thread = std::thread(&Server::Serve, this);
+                }
+            }
+
+            return (result);
+        }
+        void Stop()
+        {
+            if (_listener != -1) {
+                ::shutdown(_listener, SHUT_RDWR);
+
+                if (_thread.joinable() == true) {
+                    _thread.join();
+                }
+
+                ::close(_listener);
+                _listener = -1;
+            }
+            if (_context != nullptr) {
+                SSL_CTX_free(_context);
+                _context = nullptr;
+            }
+        }
+
+    private:
+        static EVP_PKEY* Key()
+        {
+            EVP_PKEY* result = nullptr;
+            EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+
+            if (context != nullptr) {
+                if ((EVP_PKEY_keygen_init(context) == 1) && (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(context, NID_X9_62_prime256v1) == 1)) {
+                    EVP_PKEY_keygen(context, &result);
+                }
+
+                EVP_PKEY_CTX_free(context);
+            }
+
+            return (result);
+        }
+        static X509* Certificate(EVP_PKEY* key)
+        {
+            X509* result = X509_new();
+            X509_NAME* name = X509_get_subject_name(result);
+
+            X509_set_version(result, 2);
+            ASN1_INTEGER_set(X509_get_serialNumber(result), 1);
+            X509_gmtime_adj(X509_getm_notBefore(result), 0);
+            X509_gmtime_adj(X509_getm_notAfter(result), 24 * 60 * 60);
+            X509_set_pubkey(result, key);
+            X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+            X509_set_issuer_name(result, name);
+
+            if (X509_sign(result, key, EVP_sha256()) == 0) {
+                X509_free(result);
+                result = nullptr;
+            }
+
+            return (result);
+        }
+        static bool Receive(SSL* ssl, uint8_t buffer[], const uint32_t length)
+        {
+            uint32_t offset = 0;
+
+            while (offset < length) {
+                const int size = SSL_read(ssl, &(buffer[offset]), static_cast<int>(length - offset));
+
+                if (size <= 0) {
+                    break;
+                }
+
+                offset += size;
+            }
+
+            return (offset == length);
+        }
+        void Serve()
+        {
+            int connection;
+
+            while ((connection = ::accept(_listener, nullptr, nullptr)) >= 0) {
+                SSL* ssl = SSL_new(_context);
+
+                SSL_set_fd(ssl, connection);
+
+                if (SSL_accept(ssl) == 1) {
+                    Messages(ssl);
+                    SSL_shutdown(ssl);
+                }
+
+                SSL_free(ssl);
+                ::close(connection);
+            }
+        }
+        void Messages(SSL* ssl)
+        {
+            uint8_t buffer[16 * 1024];
+            const uint8_t acknowledge = 1;
+
+            while (Receive(ssl, buffer, 8) == true) {
+                uint64_t length = 0;
+
+                for (uint8_t index = 0; index < 8; index++) {
+                    length = (length << 8) | buffer[index];
+                }
+
+                while (length != 0) {
+                    const int size = SSL_read(ssl, buffer, static_cast<int>(std::min(length, static_cast<uint64_t>(sizeof(buffer)))));
+
+                    if (size <= 0) {
+                        return;
+                    }
+
+                    length -= size;
+                }
+
+                if (SSL_write(ssl, &acknowledge, 1) != 1) {
+                    break;
+                }
+            }
+        }
+
+    private:
+        SSL_CTX* _context;
+        int _listener;
+        std::thread _thread;
+    };
+
+    // It is our own server, with a self signed certificate.
+    class Trusting : public Crypto::SecureSocketPort::IValidator {
+    public:
+        bool Validate(const Crypto::SecureSocketPort::Certificate&) const override
+        {
+            return (true);
+        }
+    };
+
+    class Client : public Crypto::SecureSocketPort {
+    public:
+        Client() = delete;
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+
+        Client(const Core::NodeId& remoteNode, const uint32_t sendBufferSize)
+            : Crypto::SecureSocketPort(Core::SocketPort::STREAM, remoteNode.AnyInterface(), remoteNode, sendBufferSize, 1024)
+            , _adminLock()
+            , _connected(false, true)
+            , _acknowledged(false, true)
+            , _headerOffset(sizeof(_header))
+            , _length(0)
+            , _file(0)
+            , _fileSize(0)
+        {
+            ::memset(_header, 0, sizeof(_header));
+            Callback(&_validator);
+        }
+        ~Client() override
+        {
+            Close(Core::infinite);
+            Callback(nullptr);
+        }
+
+    public:
+        bool Connect()
+        {
+            _connected.ResetEvent();
+
+            const uint32_t result = Open(0);
+
+            return (((result == Core::ERROR_NONE) || (result == Core::ERROR_INPROGRESS)) && (_connected.Lock(5000) == Core::ERROR_NONE));
+        }
+        // A message with data from the send buffer.
+        bool Transfer(const uint64_t length)
+        {
+            return (Transfer(length, 0, 0));
+        }
+        // A message with the first bytes of a file.
+        bool Transfer(const Core::File::Handle file, const uint64_t length)
+        {
+            return (Transfer(0, file, length));
+        }
+
+        uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
+        {
+            uint32_t result = 0;
+
+            _adminLock.Lock();
+
+            if (_headerOffset < sizeof(_header)) {
+                result = std::min(maxSendSize, static_cast<uint32_t>(sizeof(_header) - _headerOffset));
+                ::memcpy(dataFrame, &(_header[_headerOffset]), result);
+                _headerOffset += result;
+            }
+            if ((_headerOffset == sizeof(_header)) && (_length != 0)) {
+                const uint32_t size = static_cast<uint32_t>(std::min(static_cast<uint64_t>(std::min(maxSendSize - result, static_cast<uint32_t>(sizeof(_payload)))), _length));
+
+                ::memcpy(&(dataFrame[result]), _payload, size);
+                _length -= size;
+                result += size;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+        {
+            _acknowledged.SetEvent();
+
+            return (receivedSize);
+        }
+        bool SendFile(Core::SocketPort::Region& region) override
+        {
+            bool result = false;
+
+            _adminLock.Lock();
+
+            if ((_headerOffset == sizeof(_header)) && (_fileSize != 0)) {
+                region.Descriptor = _file;
+                region.Offset = 0;
+                region.Size = _fileSize;
+                _fileSize = 0;
+                result = true;
+            }
+
+            _adminLock.Unlock();
+
+            return (result);
+        }
+        void StateChange() override
+        {
+            if (IsOpen() == true) {
+                _connected.SetEvent();
+            }
+        }
+
+    private:
+        bool Transfer(const uint64_t length, const Core::File::Handle file, const uint64_t fileSize)
+        {
+            const uint64_t total = length + fileSize;
+
+            _adminLock.Lock();
+
+            for (uint8_t index = 0; index < sizeof(_header); index++) {
+                _header[index] = static_cast<uint8_t>(total >> (56 - (8 * index)));
+            }
+
+            _headerOffset = 0;
+            _length = length;
+            _file = file;
+            _fileSize = fileSize;
+            _acknowledged.ResetEvent();
+
+            _adminLock.Unlock();
+
+            Trigger();
+
+            return (_acknowledged.Lock(60000) == Core::ERROR_NONE);
+        }
+
+    private:
+        Core::CriticalSection _adminLock;
+        Core::Event _connected;
+        Core::Event _acknowledged;
+        uint8_t _header[8];
+        uint8_t _headerOffset;
+        uint64_t _length;
+        Core::File::Handle _file;
+        uint64_t _fileSize;
+        static Trusting _validator;
+        static uint8_t _payload[64 * 1024];
+    };
+
+    /* static */ Trusting Client::_validator;
+    /* static */ uint8_t Client::_payload[64 * 1024];
+
+    void Handshakes(const Core::NodeId& node, const bool resumption)
+    {
+        Clock::duration elapsed(Clock::duration::zero());
+        uint32_t connections = 0;
+        uint32_t resumed = 0;
+        uint32_t failed = 0;
+
+        for (uint16_t index = 0; index < Connections; index++) {
+            Client client(node, 4096);
+
+            client.SessionResumption(resumption);
+
+            const Clock::time_point start = Clock::now();
+
+            if (client.Connect() == true) {
+                elapsed += (Clock::now() - start);
+
+                // The message makes sure the session tickets, that follow the handshake, came in.
+                if (client.Transfer(0) == true) {
+                    connections++;
+                    resumed += (client.IsResumed() == true ? 1 : 0);
+                } else {
+                    failed++;
+                }
+            } else {
+                failed++;
+            }
+
+            client.Close(Core::infinite);
+        }
+
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+
+        printf("%-12s %14.0f %10.2f %10u %8u\n", (resumption == true ? _T("resumed") : _T("full")), connections / seconds, (seconds * 1000) / connections, resumed, failed);
+    }
+
+    void Bulk(const Core::NodeId& node, const TCHAR name[], Core::File* file, const bool offload, const uint32_t seconds)
+    {
+        Client client(node, 64 * 1024);
+
+        client.KernelOffload(offload);
+
+        if (client.Connect() == false) {
+            printf("%-12s %14s\n", name, _T("no connection"));
+        } else {
+            const Clock::time_point start = Clock::now();
+            const Clock::time_point end = start + std::chrono::seconds(seconds);
+            uint64_t bytes = 0;
+
+            while (Clock::now() < end) {
+                if ((file != nullptr ? client.Transfer(*file, BulkSize) : client.Transfer(BulkSize)) == false) {
+                    break;
+                }
+
+                bytes += BulkSize;
+            }
+
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+            printf("%-12s %14.0f %s\n", name, bytes / (elapsed * 1024 * 1024), (offload == false ? _T("user space") : (client.IsOffloaded() == true ? _T("kernel") : _T("user space, kTLS not available"))));
+        }
+
+        client.Close(Core::infinite);
+    }
+
+}
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    const uint32_t seconds = (argc > 1 ? static_cast<uint32_t>(::atoi(argv[1])) : 3);
+
+    // The server writes to connections that the client might have closed already.
+    ::signal(SIGPIPE, SIG_IGN);
+
+    if (seconds == 0) {
+        printf("Usage: %s [seconds per run]\n", argv[0]);
+    }
+    else {
+        Server server;
+
+        if (server.Start(Port) == false) {
+            printf("Could not start the server\n");
+        }
+        else {
+            const Core::NodeId node(_T("127.0.0.1"), Port, Core::NodeId::TYPE_IPV4);
+
+            printf("Handshakes over the loopback, %d connections per run\n\n", Connections);
+            printf("%-12s %14s %10s %10s %8s\n", _T("handshake"), _T("handshakes/s"), _T("ms"), _T("resumed"), _T("failed"));
+
+            Handshakes(node, false);
+            Handshakes(node, true);
+
+            Core::File file((string(FileName)));
+
+            if (file.Create() == true) {
+                std::vector<uint8_t> block(1024 * 1024, 'f');
+
+                for (uint32_t written = 0; written < BulkSize; written += static_cast<uint32_t>(block.size())) {
+                    file.Write(block.data(), static_cast<uint32_t>(block.size()));
+                }
+
+                printf("\nBulk transfer of messages of %d MB, %d seconds per run\n\n", (BulkSize / (1024 * 1024)), seconds);
+                printf("%-12s %14s %s\n", _T("source"), _T("MB/s"), _T("encryption"));
+
+                Bulk(node, _T("buffer"), nullptr, false, seconds);
+                Bulk(node, _T("file"), &file, false, seconds);
+                Bulk(node, _T("file, kTLS"), &file, true, seconds);
+
+                file.Destroy();
+            }
+
+            server.Stop();
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
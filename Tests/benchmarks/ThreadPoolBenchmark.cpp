@@ -0,0 +1,231 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Module.h"
+
+using namespace WPEFramework;
+
+// Compares the shared queue (QUEUED) with the work stealing (STEALING) scheduling of the
+// ThreadPool. Each run, a number of external producers submit jobs into the pool, every job
+// that is dispatched submits a number of follow-up jobs from within the pool. Reported are
+// the number of jobs per second and the p50/p99 latency between the Submit and the Dispatch.
+// Build in release mode, debug builds validate the queues on every Submit.
+class Benchmark {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    class Dispatcher : public Core::ThreadPool::IDispatcher {
+    public:
+        Dispatcher(const Dispatcher&) = delete;
+        Dispatcher& operator=(const Dispatcher&) = delete;
+
+        Dispatcher() = default;
+        ~Dispatcher() override = default;
+
+    private:
+        void Initialize() override { }
+        void Deinitialize() override { }
+        void Dispatch(Core::IDispatch* job) override {
+            job->Dispatch();
+        }
+    };
+
+    class Pool : public Core::WorkerPool {
+    public:
+        Pool() = delete;
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        Pool(const uint8_t threads, const uint32_t queueSize, const Core::ThreadPool::scheduling mode)
+            : Core::WorkerPool(threads, 0, queueSize, &_dispatcher, nullptr, mode)
+            , _dispatcher()
+        {
+            Run();
+        }
+        ~Pool()
+        {
+            Stop();
+        }
+
+    private:
+        Dispatcher _dispatcher;
+    };
+
+    class Job : public Core::IDispatch {
+    public:
+        Job() = delete;
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+
+        Job(Benchmark& parent, const uint32_t index, const uint8_t depth)
+            : _parent(parent)
+            , _index(index)
+            , _depth(depth)
+            , _submitted(Clock::now())
+        {
+        }
+        ~Job() override = default;
+
+    public:
+        void Dispatch() override
+        {
+            _parent.Dispatched(_index, _depth, _submitted);
+        }
+
+    private:
+        Benchmark& _parent;
+        const uint32_t _index;
+        const uint8_t _depth;
+        const Clock::time_point _submitted;
+    };
+
+public:
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    Benchmark(const uint8_t producers, const uint32_t jobs, const uint8_t fanOut, const uint8_t depth)
+        : _producers(producers)
+        , _roots(jobs)
+        , _fanOut(fanOut)
+        , _depth(depth)
+        , _total(0)
+        , _pool(nullptr)
+        , _sequence(0)
+        , _completed(0)
+        , _latencies()
+        , _done(false, true)
+    {
+        uint32_t perRoot = 1;
+        uint32_t level = 1;
+        for (uint8_t index = 0; index < _depth; index++) {
+            level *= _fanOut;
+            perRoot += level;
+        }
+        _total = _roots * perRoot;
+        _latencies.resize(_total);
+    }
+    ~Benchmark() = default;
+
+public:
+    void Run(const uint8_t threads, const Core::ThreadPool::scheduling mode)
+    {
+        // In QUEUED mode, a worker that submits into a full queue blocks, make sure the queue can hold it all.
+        Pool pool(threads, _total, mode);
+
+        _pool = &pool;
+        _sequence = 0;
+        _completed = 0;
+        _done.ResetEvent();
+
+        Clock::time_point start = Clock::now();
+
+        std::vector<std::thread> producers;
+        for (uint8_t index = 0; index < _producers; index++) {
+            producers.emplace_back([this, index]() {
+                for (uint32_t count = index; count < _roots; count += _producers) {
+                    Submit(_depth);
+                }
+            });
+        }
+        for (std::thread& producer : producers) {
+            producer.join();
+        }
+
+        _done.Lock(Core::infinite);
+
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        _pool = nullptr;
+
+        std::sort(_latencies.begin(), _latencies.end());
+
+        printf("%-8s %7d %12.0f %12.2f %12.2f\n",
+            (mode == Core::ThreadPool::QUEUED ? _T("queued") : _T("stealing")),
+            threads,
+            _total / seconds,
+            _latencies[_total / 2] / 1000.0,
+            _latencies[(_total * 99) / 100] / 1000.0);
+    }
+
+private:
+    void Submit(const uint8_t depth)
+    {
+        uint32_t index = _sequence++;
+
+        ASSERT(index < _total);
+
+        _pool->Submit(Core::ProxyType<Core::IDispatch>(Core::ProxyType<Job>::Create(*this, index, depth)));
+    }
+    void Dispatched(const uint32_t index, const uint8_t depth, const Clock::time_point& submitted)
+    {
+        _latencies[index] = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - submitted).count());
+
+        if (depth > 0) {
+            for (uint8_t child = 0; child < _fanOut; child++) {
+                Submit(depth - 1);
+            }
+        }
+
+        if (++_completed == _total) {
+            _done.SetEvent();
+        }
+    }
+
+private:
+    const uint8_t _producers;
+    const uint32_t _roots;
+    const uint8_t _fanOut;
+    const uint8_t _depth;
+    uint32_t _total;
+    Core::WorkerPool* _pool;
+    std::atomic<uint32_t> _sequence;
+    std::atomic<uint32_t> _completed;
+    std::vector<uint32_t> _latencies;
+    Core::Event _done;
+};
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    uint32_t jobs = ((argc > 1) ? atoi(argv[1]) : 20000);
+
+    {
+        // 2 external producers, every root job fans out into 2 + 4 follow-up jobs
+        Benchmark benchmark(2, jobs, 2, 2);
+
+        printf("%-8s %7s %12s %12s %12s\n", _T("mode"), _T("threads"), _T("jobs/s"), _T("p50 (us)"), _T("p99 (us)"));
+
+        for (uint8_t threads : { 2, 4, 8 }) {
+            benchmark.Run(threads, Core::ThreadPool::QUEUED);
+            benchmark.Run(threads, Core::ThreadPool::STEALING);
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,178 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <random>
+
+#include "Module.h"
+
+using namespace WPEFramework;
+
+// Measures the cost of the TimerType administration with a growing number of pending
+// timers. Each run schedules the timers at random moments in the next 10 seconds,
+// revokes half of them and finally schedules a batch that is due at once, to measure
+// how fast expired timers are dispatched. Reported are operations per second.
+class Benchmark {
+private:
+    using Clock = std::chrono::steady_clock;
+
+    class Handler {
+    public:
+        Handler()
+            : _parent(nullptr)
+            , _id(0)
+        {
+        }
+        Handler(Benchmark& parent, const uint32_t id)
+            : _parent(&parent)
+            , _id(id)
+        {
+        }
+        Handler(const Handler&) = default;
+        Handler& operator=(const Handler&) = default;
+        ~Handler() = default;
+
+    public:
+        bool operator==(const Handler& RHS) const
+        {
+            return (_id == RHS._id);
+        }
+        bool operator!=(const Handler& RHS) const
+        {
+            return (!operator==(RHS));
+        }
+        size_t Hash() const
+        {
+            return (_id);
+        }
+        uint64_t Timed(const uint64_t /* scheduledTime */)
+        {
+            _parent->Fired();
+            return (0);
+        }
+
+    private:
+        Benchmark* _parent;
+        uint32_t _id;
+    };
+
+public:
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+
+    Benchmark()
+        : _timer(Core::Thread::DefaultStackSize(), _T("TimerBenchmark"))
+        , _fired(0)
+        , _expected(0)
+        , _done(false, true)
+        , _random(42)
+    {
+    }
+    ~Benchmark() = default;
+
+public:
+    void Run(const uint32_t timers)
+    {
+        std::uniform_int_distribution<uint64_t> spread(1, 10000 * Core::Time::TicksPerMillisecond);
+        uint64_t now = Core::Time::Now().Ticks();
+
+        Clock::time_point start = Clock::now();
+        for (uint32_t index = 0; index < timers; index++) {
+            _timer.Schedule(now + spread(_random), Handler(*this, index));
+        }
+        double schedule = Seconds(start);
+
+        start = Clock::now();
+        for (uint32_t index = 0; index < timers; index += 2) {
+            _timer.Revoke(Handler(*this, index));
+        }
+        double revoke = Seconds(start);
+
+        _timer.Flush();
+
+        // Now a batch that expires at once, the dispatching cost dominates.
+        _fired = 0;
+        _expected = timers;
+        _done.ResetEvent();
+
+        now = Core::Time::Now().Ticks() + (50 * Core::Time::TicksPerMillisecond);
+        for (uint32_t index = 0; index < timers; index++) {
+            _timer.Schedule(now + (index % 16), Handler(*this, index));
+        }
+
+        _done.Lock(Core::infinite);
+        double expire = std::chrono::duration<double>(_last - _first).count();
+
+        printf("%9d %14.0f %14.0f %14.0f\n",
+            timers,
+            timers / schedule,
+            (timers / 2) / revoke,
+            timers / (expire > 0 ? expire : 1e-9));
+    }
+
+private:
+    static double Seconds(const Clock::time_point& start)
+    {
+        return (std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    void Fired()
+    {
+        Clock::time_point now = Clock::now();
+
+        if (_fired == 0) {
+            _first = now;
+        }
+        if (++_fired == _expected) {
+            _last = now;
+            _done.SetEvent();
+        }
+    }
+
+private:
+    Core::TimerType<Handler> _timer;
+    uint32_t _fired;
+    uint32_t _expected;
+    Clock::time_point _first;
+    Clock::time_point _last;
+    Core::Event _done;
+    std::mt19937_64 _random;
+};
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    uint32_t maximum = ((argc > 1) ? atoi(argv[1]) : 100000);
+
+    {
+        Benchmark benchmark;
+
+        printf("%9s %14s %14s %14s\n", _T("timers"), _T("schedule/s"), _T("revoke/s"), _T("expire/s"));
+
+        for (uint32_t timers = 10; timers <= maximum; timers *= 10) {
+            benchmark.Run(timers);
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
@@ -0,0 +1,194 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+
+#include "Module.h"
+
+#include <websocket/websocket.h>
+
+using namespace WPEFramework;
+
+// Encodes frames with Web::WebSocket::Protocol, the way the link does in SendData, and decodes them again, the
+// way the link does in ReceiveData, for masked (client to server) and unmasked (server to client) frames. The
+// decoder gets the frames in one piece and in pieces of 1000 bytes, like a socket that hands over what it
+// has. For comparison, the masked frames are also run through the byte by byte masking the Protocol used to
+// do, with the payload moved to make room for the header. That one only had 16 bits lengths, so it is not
+// run for the frames that are larger than that.
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint16_t Piece = 1000;
+
+    // The masking of old, for comparison.
+    uint16_t EncodeBytewise(uint8_t dataFrame[], const uint16_t usedSize, const uint8_t maskKey[4])
+    {
+        const uint8_t header = (usedSize <= 125 ? 2 : 4);
+        uint8_t* source = &dataFrame[usedSize - 1 + 4];
+        uint8_t* destination = &dataFrame[usedSize - 1 + 4 + header];
+        uint32_t bytesToMove = usedSize;
+
+        while (bytesToMove != 0) {
+            bytesToMove--;
+            *destination-- = (*source ^ maskKey[(bytesToMove & 0x3)]);
+            source--;
+        }
+
+        ::memcpy(&dataFrame[header], maskKey, 4);
+        dataFrame[0] = 0x81;
+        dataFrame[1] = (usedSize <= 125 ? (0x80 | usedSize) : (0x80 | 126));
+
+        if (header == 4) {
+            dataFrame[2] = (usedSize >> 8);
+            dataFrame[3] = (usedSize & 0xFF);
+        }
+
+        return (header + 4 + usedSize);
+    }
+    void DecodeBytewise(uint8_t dataFrame[], const uint16_t length)
+    {
+        const uint8_t header = ((dataFrame[1] & 0x7F) == 126 ? 8 : 6);
+        const uint8_t* key = &(dataFrame[header - 4]);
+
+        for (uint16_t index = 0; index < (length - header); index++) {
+            dataFrame[header + index] ^= key[index & 0x3];
+        }
+    }
+
+    uint32_t Decode(Web::WebSocket::Protocol& decoder, uint8_t frame[], const uint32_t length, const uint32_t piece)
+    {
+        uint32_t result = 0;
+        uint32_t offset = 0;
+
+        while (offset < length) {
+            uint32_t size = std::min(piece, length - offset);
+            const uint16_t header = decoder.Decoder(&(frame[offset]), size);
+
+            result += size;
+            offset += (header + size);
+        }
+
+        return (result);
+    }
+
+    // Returns MB/s of payload, with the given action done for a payload for about the given time.
+    template <typename ACTION>
+    double Measure(const uint32_t size, const uint32_t milliseconds, ACTION&& action)
+    {
+        const Clock::time_point start = Clock::now();
+        const Clock::time_point end = start + std::chrono::milliseconds(milliseconds);
+        uint64_t bytes = 0;
+
+        while (Clock::now() < end) {
+            for (uint16_t loop = 0; loop < 64; loop++) {
+                action();
+                bytes += size;
+            }
+        }
+
+        return (bytes / (std::chrono::duration<double>(Clock::now() - start).count() * 1024 * 1024));
+    }
+
+    void Run(const uint32_t size, const uint32_t milliseconds)
+    {
+        const uint8_t key[4] = { 0x12, 0x34, 0x56, 0x78 };
+        std::vector<uint8_t> payload(size);
+        std::vector<uint8_t> frame(size + 16);
+        std::vector<uint8_t> copy(size + 16);
+        uint32_t length = 0;
+
+        for (uint32_t index = 0; index < size; index++) {
+            payload[index] = static_cast<uint8_t>('a' + (index % 26));
+        }
+
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+
+        const double maskedEncode = Measure(size, milliseconds, [&]() {
+            ::memcpy(&(frame[client.HeaderSpace(size + 1)]), payload.data(), size);
+            length = client.Encoder(frame.data(), size + 1, size);
+        });
+        copy = frame;
+        const double maskedDecode = Measure(size, milliseconds, [&]() {
+            ::memcpy(frame.data(), copy.data(), length);
+            Decode(server, frame.data(), length, length);
+        });
+        const double maskedPieces = Measure(size, milliseconds, [&]() {
+            ::memcpy(frame.data(), copy.data(), length);
+            Decode(server, frame.data(), length, Piece);
+        });
+
+        const double unmaskedEncode = Measure(size, milliseconds, [&]() {
+            ::memcpy(&(frame[server.HeaderSpace(size + 1)]), payload.data(), size);
+            length = server.Encoder(frame.data(), size + 1, size);
+        });
+        copy = frame;
+        const double unmaskedDecode = Measure(size, milliseconds, [&]() {
+            ::memcpy(frame.data(), copy.data(), length);
+            Decode(client, frame.data(), length, length);
+        });
+
+        printf("%7d %10.0f %10.0f %10.0f %10.0f %10.0f", size, maskedEncode, maskedDecode, maskedPieces, unmaskedEncode, unmaskedDecode);
+
+        if (size > 0xFFFF) {
+            printf(" %10s %10s\n", _T("-"), _T("-"));
+        }
+        else {
+            const double bytewiseEncode = Measure(size, milliseconds, [&]() {
+                ::memcpy(&(frame[4]), payload.data(), size);
+                length = EncodeBytewise(frame.data(), static_cast<uint16_t>(size), key);
+            });
+            copy = frame;
+            const double bytewiseDecode = Measure(size, milliseconds, [&]() {
+                ::memcpy(frame.data(), copy.data(), length);
+                DecodeBytewise(frame.data(), static_cast<uint16_t>(length));
+            });
+
+            printf(" %10.0f %10.0f\n", bytewiseEncode, bytewiseDecode);
+        }
+    }
+
+}
+
+#ifdef __WINDOWS__
+int _tmain(int argc, _TCHAR* argv[])
+#else
+int main(int argc, char** argv)
+#endif
+{
+    const uint32_t milliseconds = (argc > 1 ? static_cast<uint32_t>(::atoi(argv[1])) : 500);
+
+    if (milliseconds == 0) {
+        printf("Usage: %s [milliseconds per run]\n", argv[0]);
+    }
+    else {
+        printf("MB/s of payload, the copy of the payload into the frame included, %d ms per run\n\n", milliseconds);
+        printf("%7s %21s %10s %21s %21s\n", _T(""), _T("masked"), _T(""), _T("unmasked"), _T("masked bytewise"));
+        printf("%7s %10s %10s %10s %10s %10s %10s %10s\n", _T("size"), _T("encode"), _T("decode"), _T("pieces"), _T("encode"), _T("decode"), _T("encode"), _T("decode"));
+
+        for (const uint32_t size : { 64, 125, 1024, 16384, 65000, 1048576 }) {
+            Run(size, milliseconds);
+        }
+    }
+
+    Core::Singleton::Dispose();
+
+    return (0);
+}
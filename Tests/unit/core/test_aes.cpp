@@ -0,0 +1,267 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        const uint8_t AllAcceleration = (Crypto::ACCELERATION_SHA | Crypto::ACCELERATION_MULTIBUFFER | Crypto::ACCELERATION_AES);
+
+        std::vector<uint8_t> Bytes(const string& hex)
+        {
+            std::vector<uint8_t> result;
+
+            for (uint32_t index = 0; (index + 1) < hex.size(); index += 2) {
+                result.push_back(static_cast<uint8_t>(std::stoul(hex.substr(index, 2), nullptr, 16)));
+            }
+
+            return (result);
+        }
+
+        string Hex(const uint8_t data[], const uint32_t length)
+        {
+            static const TCHAR Digits[] = _T("0123456789abcdef");
+            string result;
+
+            for (uint32_t index = 0; index < length; index++) {
+                result += Digits[data[index] >> 4];
+                result += Digits[data[index] & 0xF];
+            }
+
+            return (result);
+        }
+
+        string Hex(const std::vector<uint8_t>& data)
+        {
+            return (Hex(data.data(), static_cast<uint32_t>(data.size())));
+        }
+
+        std::vector<uint8_t> Message(const uint32_t size, const uint32_t seed)
+        {
+            std::vector<uint8_t> result(size);
+
+            for (uint32_t index = 0; index < size; index++) {
+                result[index] = static_cast<uint8_t>((index * 31) + (seed * 7) + (index >> 5));
+            }
+
+            return (result);
+        }
+
+        // Encrypts with AES_GCM, the message handed over in pieces of the given size, and returns the
+        // ciphertext with the tag behind it.
+        std::vector<uint8_t> Seal(const std::vector<uint8_t>& key, const std::vector<uint8_t>& nonce, const std::vector<uint8_t>& data, const std::vector<uint8_t>& message, const uint32_t piece = ~0)
+        {
+            Crypto::AESEncryption cipher(Crypto::AES_GCM);
+            std::vector<uint8_t> result(message.size() + 16);
+
+            EXPECT_EQ(cipher.Key(static_cast<uint8_t>(key.size()), key.data()), Core::ERROR_NONE);
+            EXPECT_EQ(cipher.InitialVector(static_cast<uint8_t>(nonce.size()), nonce.data()), Core::ERROR_NONE);
+            EXPECT_EQ(cipher.Authenticate(static_cast<uint32_t>(data.size()), data.data()), Core::ERROR_NONE);
+
+            for (uint32_t offset = 0; offset < message.size(); offset += piece) {
+                const uint32_t size = std::min(piece, static_cast<uint32_t>(message.size()) - offset);
+
+                EXPECT_EQ(cipher.Encrypt(size, &(message[offset]), &(result[offset])), Core::ERROR_NONE);
+            }
+
+            EXPECT_EQ(cipher.Tag(16, &(result[message.size()])), Core::ERROR_NONE);
+
+            return (result);
+        }
+
+        // Decrypts what Seal() gives, in place, and returns the outcome of checking the tag.
+        uint32_t Open(const std::vector<uint8_t>& key, const std::vector<uint8_t>& nonce, const std::vector<uint8_t>& data, std::vector<uint8_t>& sealed, const uint32_t piece = ~0)
+        {
+            Crypto::AESDecryption cipher(Crypto::AES_GCM);
+            const uint32_t length = static_cast<uint32_t>(sealed.size() - 16);
+
+            EXPECT_EQ(cipher.Key(static_cast<uint8_t>(key.size()), key.data()), Core::ERROR_NONE);
+            EXPECT_EQ(cipher.InitialVector(static_cast<uint8_t>(nonce.size()), nonce.data()), Core::ERROR_NONE);
+            EXPECT_EQ(cipher.Authenticate(static_cast<uint32_t>(data.size()), data.data()), Core::ERROR_NONE);
+
+            for (uint32_t offset = 0; offset < length; offset += piece) {
+                const uint32_t size = std::min(piece, length - offset);
+
+                EXPECT_EQ(cipher.Decrypt(size, &(sealed[offset]), &(sealed[offset])), Core::ERROR_NONE);
+            }
+
+            const uint32_t result = cipher.Verify(16, &(sealed[length]));
+
+            sealed.resize(length);
+
+            return (result);
+        }
+
+        std::vector<uint8_t> Counter(const std::vector<uint8_t>& key, const std::vector<uint8_t>& counter, const std::vector<uint8_t>& message, const uint32_t piece = ~0)
+        {
+            Crypto::AESEncryption cipher(Crypto::AES_CTR);
+            std::vector<uint8_t> result(message.size());
+
+            EXPECT_EQ(cipher.Key(static_cast<uint8_t>(key.size()), key.data()), Core::ERROR_NONE);
+            cipher.InitialVector(counter.data());
+
+            for (uint32_t offset = 0; offset < message.size(); offset += piece) {
+                const uint32_t size = std::min(piece, static_cast<uint32_t>(message.size()) - offset);
+
+                EXPECT_EQ(cipher.Encrypt(size, &(message[offset]), &(result[offset])), Core::ERROR_NONE);
+            }
+
+            return (result);
+        }
+
+    }
+
+    TEST(Crypto_AES, CounterKnownAnswers)
+    {
+        const uint8_t supported = Crypto::Acceleration(AllAcceleration);
+
+        // NIST SP 800-38A, F.5.1 and F.5.5
+        const std::vector<uint8_t> counter(Bytes(_T("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff")));
+        const std::vector<uint8_t> plain(Bytes(_T("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e5130c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710")));
+
+        for (const uint8_t acceleration : { static_cast<uint8_t>(Crypto::ACCELERATION_NONE), supported }) {
+            Crypto::Acceleration(acceleration);
+
+            for (const uint32_t piece : { 64u, 16u, 7u }) {
+                EXPECT_EQ(Hex(Counter(Bytes(_T("2b7e151628aed2a6abf7158809cf4f3c")), counter, plain, piece)), _T("874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee"));
+                EXPECT_EQ(Hex(Counter(Bytes(_T("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4")), counter, plain, piece)), _T("601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c52b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"));
+            }
+        }
+
+        Crypto::Acceleration(AllAcceleration);
+    }
+
+    TEST(Crypto_AES, CounterCarry)
+    {
+        const std::vector<uint8_t> key(Bytes(_T("2b7e151628aed2a6abf7158809cf4f3c")));
+        const std::vector<uint8_t> zeroes(64, 0);
+
+        // The counter runs over all 16 bytes: the block after ...00ffffffffffff is ...0100000000000000.
+        const std::vector<uint8_t> stream(Counter(key, Bytes(_T("000000000000000000ffffffffffffff")), zeroes));
+        const std::vector<uint8_t> following(Counter(key, Bytes(_T("00000000000000000100000000000000")), zeroes));
+
+        EXPECT_EQ(Hex(&(stream[16]), 48), Hex(following.data(), 48));
+    }
+
+    TEST(Crypto_AES, GCMKnownAnswers)
+    {
+        const uint8_t supported = Crypto::Acceleration(AllAcceleration);
+
+        // The GCM specification, test cases 1, 2, 4, 6 and 16
+        const std::vector<uint8_t> none;
+        const std::vector<uint8_t> key(Bytes(_T("feffe9928665731c6d6a8f9467308308")));
+        const std::vector<uint8_t> nonce(Bytes(_T("cafebabefacedbaddecaf888")));
+        const std::vector<uint8_t> data(Bytes(_T("feedfacedeadbeeffeedfacedeadbeefabaddad2")));
+        const std::vector<uint8_t> plain(Bytes(_T("d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39")));
+
+        for (const uint8_t acceleration : { static_cast<uint8_t>(Crypto::ACCELERATION_NONE), supported }) {
+            Crypto::Acceleration(acceleration);
+
+            EXPECT_EQ(Hex(Seal(std::vector<uint8_t>(16, 0), std::vector<uint8_t>(12, 0), none, none)), _T("58e2fccefa7e3061367f1d57a4e7455a"));
+            EXPECT_EQ(Hex(Seal(std::vector<uint8_t>(16, 0), std::vector<uint8_t>(12, 0), none, std::vector<uint8_t>(16, 0))), _T("0388dace60b6a392f328c2b971b2fe78ab6e47d42cec13bdf53a67b21257bddf"));
+
+            for (const uint32_t piece : { 60u, 16u, 5u }) {
+                EXPECT_EQ(Hex(Seal(key, nonce, data, plain, piece)), _T("42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091" "5bc94fbc3221a5db94fae95ae7121a47"));
+                EXPECT_EQ(Hex(Seal(key, Bytes(_T("9313225df88406e555909c5aff5269aa6a7a9538534f7da1e4c303d2a318a728c3c0c95156809539fcf0e2429a6b525416aedbf5a0de6a57a637b39b")), data, plain, piece)), _T("8ce24998625615b603a033aca13fb894be9112a5c3a211a8ba262a3cca7e2ca701e4a9a4fba43c90ccdcb281d48c7c6fd62875d2aca417034c34aee5" "619cc5aefffe0bfa462af43c1699d050"));
+                EXPECT_EQ(Hex(Seal(Bytes(_T("feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308")), nonce, data, plain, piece)), _T("522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662" "76fc6ece0f4e1768cddf8853bb2d551b"));
+            }
+        }
+
+        Crypto::Acceleration(AllAcceleration);
+    }
+
+    TEST(Crypto_AES, GCMSameResults)
+    {
+        const uint8_t supported = Crypto::Acceleration(AllAcceleration);
+        const std::vector<uint8_t> key(Message(32, 1));
+        const std::vector<uint8_t> nonce(Message(12, 2));
+
+        // Every length around the block and pipeline boundaries, in one piece and in odd pieces.
+        for (uint32_t size = 0; size <= 300; size += 3) {
+            const std::vector<uint8_t> message(Message(size, size));
+            const std::vector<uint8_t> data(Message(size % 37, size + 1));
+
+            Crypto::Acceleration(Crypto::ACCELERATION_NONE);
+            const std::vector<uint8_t> sealed(Seal(key, nonce, data, message));
+
+            Crypto::Acceleration(supported);
+            EXPECT_EQ(Hex(Seal(key, nonce, data, message, 13)), Hex(sealed));
+
+            std::vector<uint8_t> opened(sealed);
+            EXPECT_EQ(Open(key, nonce, data, opened, 29), Core::ERROR_NONE);
+            EXPECT_EQ(Hex(opened), Hex(message));
+        }
+
+        // A long message goes through more than one chunk.
+        const std::vector<uint8_t> message(Message(10000, 3));
+
+        Crypto::Acceleration(Crypto::ACCELERATION_NONE);
+        const std::vector<uint8_t> sealed(Seal(key, nonce, nonce, message, 1000));
+
+        Crypto::Acceleration(supported);
+        EXPECT_EQ(Hex(Seal(key, nonce, nonce, message)), Hex(sealed));
+
+        Crypto::Acceleration(AllAcceleration);
+    }
+
+    TEST(Crypto_AES, GCMVerify)
+    {
+        const std::vector<uint8_t> key(Bytes(_T("feffe9928665731c6d6a8f9467308308")));
+        const std::vector<uint8_t> nonce(Bytes(_T("cafebabefacedbaddecaf888")));
+        const std::vector<uint8_t> data(Bytes(_T("feedfacedeadbeeffeedfacedeadbeefabaddad2")));
+        const std::vector<uint8_t> message(Message(100, 4));
+        const std::vector<uint8_t> sealed(Seal(key, nonce, data, message));
+
+        std::vector<uint8_t> opened(sealed);
+        EXPECT_EQ(Open(key, nonce, data, opened), Core::ERROR_NONE);
+        EXPECT_EQ(Hex(opened), Hex(message));
+
+        // A changed ciphertext, tag or additional data is caught.
+        std::vector<uint8_t> changed(sealed);
+        changed[10] ^= 0x01;
+        EXPECT_EQ(Open(key, nonce, data, changed), Core::ERROR_INCORRECT_HASH);
+
+        changed = sealed;
+        changed[sealed.size() - 1] ^= 0x80;
+        EXPECT_EQ(Open(key, nonce, data, changed), Core::ERROR_INCORRECT_HASH);
+
+        changed = sealed;
+        EXPECT_EQ(Open(key, nonce, message, changed), Core::ERROR_INCORRECT_HASH);
+
+        // Additional data can not come in after the message.
+        Crypto::AESEncryption cipher(Crypto::AES_GCM);
+        uint8_t output[16];
+
+        cipher.Key(static_cast<uint8_t>(key.size()), key.data());
+        cipher.InitialVector(static_cast<uint8_t>(nonce.size()), nonce.data());
+        cipher.Encrypt(sizeof(output), message.data(), output);
+        EXPECT_EQ(cipher.Authenticate(static_cast<uint32_t>(data.size()), data.data()), Core::ERROR_ILLEGAL_STATE);
+        EXPECT_EQ(cipher.Tag(3, output), Core::ERROR_INVALID_INPUT_LENGTH);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,206 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <messaging/messaging.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Formats its own text, so it must not be deferred.
+    class Prefixed : public Messaging::BaseCategoryType<Core::Messaging::Metadata::type::TRACING> {
+    public:
+        Prefixed() = delete;
+        Prefixed(const Prefixed&) = delete;
+        Prefixed& operator=(const Prefixed&) = delete;
+
+        template <typename... Args>
+        Prefixed(const string& formatter, Args... args)
+            : BaseCategory()
+        {
+            string message;
+            Core::Format(message, (string(_T("Prefixed: ")) + formatter).c_str(), args...);
+            Set(message);
+        }
+    };
+
+    // Serializes the message like the MessageUnit does and formats it like the MessageClient does.
+    static string Consume(const Messaging::DeferredMessage& message)
+    {
+        uint8_t buffer[512];
+        uint16_t length = message.Serialize(buffer, sizeof(buffer));
+        uint32_t id;
+        string result;
+
+        if (Messaging::DeferredMessage::Identify(buffer, length, id) == false) {
+            Messaging::TextMessage text;
+            text.Deserialize(buffer, length);
+            result = text.Data();
+        } else {
+            string format;
+            EXPECT_TRUE(Messaging::DeferredMessage::Lookup(id, format));
+            EXPECT_TRUE(Messaging::DeferredMessage::Format(format, buffer, length, result));
+        }
+
+        return (result);
+    }
+
+    TEST(Core_DeferredMessage, FormattedByConsumer)
+    {
+        static Messaging::DeferredMessage::Site site;
+        Messaging::DeferredMessageType<Trace::Information> message(site);
+        const string name(_T("world"));
+
+        message.Set(_T("Hello %s, %d/%u %5.2f %x %hhx %c [%-6s] %lld %%"), name.c_str(), -12, 34u, 3.14159, -1, 0x1FF, 'Z', "ab", static_cast<long long>(-9000000000));
+        EXPECT_TRUE(message.IsDeferred());
+
+        const string expected(Core::Format(_T("Hello %s, %d/%u %5.2f %x %hhx %c [%-6s] %lld %%"), name.c_str(), -12, 34u, 3.14159, -1, 0x1FF, 'Z', "ab", static_cast<long long>(-9000000000)));
+        EXPECT_EQ(Consume(message), expected);
+        EXPECT_EQ(message.Data(), expected);
+
+        // The site keeps the format, the next message only carries the values.
+        message.Set(_T("Hello %s, %d/%u %5.2f %x %hhx %c [%-6s] %lld %%"), "again", 1, 2u, 0.5, 16, 1, 'a', "", static_cast<long long>(7));
+        EXPECT_EQ(Consume(message), Core::Format(_T("Hello %s, %d/%u %5.2f %x %hhx %c [%-6s] %lld %%"), "again", 1, 2u, 0.5, 16, 1, 'a', "", static_cast<long long>(7)));
+    }
+
+    TEST(Core_DeferredMessage, FallsBackToText)
+    {
+        static Messaging::DeferredMessage::Site plain;
+        static Messaging::DeferredMessage::Site mismatch;
+        static Messaging::DeferredMessage::Site custom;
+
+        // A lone text is not formatted at all.
+        Messaging::DeferredMessageType<Trace::Information> first(plain);
+        first.Set(_T("100% sure"));
+        EXPECT_FALSE(first.IsDeferred());
+        EXPECT_EQ(Consume(first), _T("100% sure"));
+
+        // What does not match the format, or can not be deferred, is formatted right away.
+        Messaging::DeferredMessageType<Trace::Information> second(mismatch);
+        second.Set(_T("%*d"), 5, 3);
+        EXPECT_FALSE(second.IsDeferred());
+        EXPECT_EQ(Consume(second), _T("    3"));
+
+        // Categories that do their own formatting, keep doing so.
+        Messaging::DeferredMessageType<Prefixed> third(custom);
+        third.Set(_T("%d"), 42);
+        EXPECT_FALSE(third.IsDeferred());
+        EXPECT_EQ(Consume(third), _T("Prefixed: 42"));
+
+        // A buffer can hold another text next time, only a literal is deferred.
+        static Messaging::DeferredMessage::Site buffered;
+        TCHAR buffer[] = _T("Buffer %d");
+        Messaging::DeferredMessageType<Trace::Information> fourth(buffered);
+        fourth.Set(buffer, 4);
+        EXPECT_FALSE(fourth.IsDeferred());
+        EXPECT_EQ(Consume(fourth), _T("Buffer 4"));
+    }
+
+    TEST(Core_DeferredMessage, TooLargeForTheBuffer)
+    {
+        static Messaging::DeferredMessage::Site site;
+        Messaging::DeferredMessageType<Trace::Information> message(site);
+        const string text(Messaging::DeferredMessage::BufferSize, 'x');
+
+        message.Set(_T("[%s]"), text.c_str());
+        EXPECT_FALSE(message.IsDeferred());
+        EXPECT_EQ(Consume(message), _T("[") + text + _T("]"));
+    }
+
+    TEST(Core_DeferredMessage, PublishedFormats)
+    {
+        static Messaging::DeferredMessage::Site before;
+        static Messaging::DeferredMessage::Site after;
+        const string fileName(_T("/tmp/deferredmessage.formats"));
+
+        // Registered before publishing started.
+        Messaging::DeferredMessageType<Trace::Information> first(before);
+        first.Set(_T("Before %d"), 1);
+        ASSERT_TRUE(first.IsDeferred());
+
+        Messaging::DeferredMessage::Publish(fileName);
+
+        // Registered while publishing.
+        Messaging::DeferredMessageType<Trace::Information> second(after);
+        second.Set(_T("After %d"), 2);
+        ASSERT_TRUE(second.IsDeferred());
+
+        uint8_t buffer[512];
+        uint32_t firstId, secondId;
+        ASSERT_TRUE(Messaging::DeferredMessage::Identify(buffer, first.Serialize(buffer, sizeof(buffer)), firstId));
+        ASSERT_TRUE(Messaging::DeferredMessage::Identify(buffer, second.Serialize(buffer, sizeof(buffer)), secondId));
+
+        Core::File file(fileName);
+        ASSERT_TRUE(file.Open(true));
+
+        std::unordered_map<uint32_t, string> formats;
+        uint64_t offset = 0;
+
+        Messaging::DeferredMessage::Published(file, offset, formats);
+        EXPECT_EQ(formats[firstId], _T("Before %d"));
+        EXPECT_EQ(formats[secondId], _T("After %d"));
+
+        // An entry that is only partly written, is left for the next time. There is no limit on its length.
+        Core::File writer(fileName);
+        ASSERT_TRUE(writer.Append());
+
+        const string late(string(8192, '-') + _T("%d"));
+        const uint32_t id = 0xFFFF;
+        const uint32_t length = static_cast<uint32_t>(late.length());
+        ASSERT_EQ(writer.Write(reinterpret_cast<const uint8_t*>(&id), sizeof(id)), sizeof(id));
+
+        const uint64_t complete = offset;
+        Messaging::DeferredMessage::Published(file, offset, formats);
+        EXPECT_EQ(offset, complete);
+        EXPECT_EQ(formats.find(id), formats.end());
+
+        ASSERT_EQ(writer.Write(reinterpret_cast<const uint8_t*>(&length), sizeof(length)), sizeof(length));
+        ASSERT_EQ(writer.Write(reinterpret_cast<const uint8_t*>(late.c_str()), length), length);
+        writer.Close();
+
+        Messaging::DeferredMessage::Published(file, offset, formats);
+        EXPECT_EQ(offset, complete + (2 * sizeof(uint32_t)) + length);
+        EXPECT_EQ(formats[id], late);
+
+        EXPECT_FALSE(Messaging::DeferredMessage::Replaced(file, offset));
+
+        // Stopping removes the file, the reader can still use what it opened.
+        Messaging::DeferredMessage::Publish(string());
+        EXPECT_FALSE(Core::File(fileName).Exists());
+        EXPECT_TRUE(file.Position(false, 0));
+        EXPECT_FALSE(Messaging::DeferredMessage::Replaced(file, offset));
+
+        // Publishing anew is another file, what was read from the previous one does not apply.
+        Messaging::DeferredMessage::Publish(fileName);
+        EXPECT_TRUE(Messaging::DeferredMessage::Replaced(file, offset));
+
+        Core::File restarted(fileName);
+        ASSERT_TRUE(restarted.Open(true));
+        EXPECT_TRUE(Messaging::DeferredMessage::Replaced(restarted, offset));
+        EXPECT_FALSE(Messaging::DeferredMessage::Replaced(restarted, 0));
+
+        Messaging::DeferredMessage::Publish(string());
+    }
+
+} // Tests
+} // WPEFramework
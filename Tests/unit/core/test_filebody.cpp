@@ -0,0 +1,254 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        const TCHAR FileName[] = _T("/tmp/wpefilebody.bin");
+
+        string CreateFile(const uint32_t size)
+        {
+            string content(size, ' ');
+
+            for (uint32_t index = 0; index < size; index++) {
+                content[index] = static_cast<char>((index * 13) ^ (index >> 8));
+            }
+
+            Core::File file((string(FileName)));
+            file.Create();
+            file.Write(reinterpret_cast<const uint8_t*>(content.data()), static_cast<uint32_t>(content.size()));
+            file.Close();
+
+            return (content);
+        }
+
+        // Serves the file for every request, honouring the Range header.
+        class FileServer : public Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> {
+        private:
+            typedef Web::WebLinkType<Core::SocketStream, Web::Request, Web::Response, Core::ProxyPoolType<Web::Request>> BaseClass;
+
+        public:
+            FileServer() = delete;
+            FileServer(const FileServer&) = delete;
+            FileServer& operator=(const FileServer&) = delete;
+
+            FileServer(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<FileServer>*)
+                : BaseClass(5, false, connector, remoteId, 8192, 2048)
+            {
+            }
+            ~FileServer() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            void LinkBody(Core::ProxyType<Web::Request>&) override
+            {
+            }
+            void Received(Core::ProxyType<Web::Request>& request) override
+            {
+                Core::ProxyType<Web::Response> response(Core::ProxyType<Web::Response>::Create());
+                Core::ProxyType<Web::FileBody> body(Core::ProxyType<Web::FileBody>::Create());
+
+                *body = string(FileName);
+
+                response->ErrorCode = Web::STATUS_OK;
+                response->Message = _T("OK");
+
+                if (request->Range.IsSet() == true) {
+                    EXPECT_EQ(body->Range(request->Range.Value()), Web::FileBody::RANGE_SATISFIABLE);
+                    response->ErrorCode = Web::STATUS_PARTIAL_CONTENT;
+                    response->Message = _T("Partial Content");
+                    response->ContentRange = body->ContentRange();
+                }
+
+                response->Body<Web::FileBody>(body);
+                Submit(response);
+            }
+            void Send(const Core::ProxyType<Web::Response>&) override
+            {
+            }
+            void StateChange() override
+            {
+            }
+        };
+
+        class FileClient : public Web::WebLinkType<Core::SocketStream, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> {
+        private:
+            typedef Web::WebLinkType<Core::SocketStream, Web::Response, Web::Request, Core::ProxyPoolType<Web::Response>&> BaseClass;
+
+        public:
+            FileClient() = delete;
+            FileClient(const FileClient&) = delete;
+            FileClient& operator=(const FileClient&) = delete;
+
+            FileClient(const Core::NodeId& remoteNode)
+                : BaseClass(5, _responseFactory, false, remoteNode.AnyInterface(), remoteNode, 2048, 8192)
+                , _received(false, true)
+                , _errorCode(0)
+                , _contentRange()
+                , _body()
+            {
+            }
+            ~FileClient() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            bool Wait(uint32_t& errorCode, string& contentRange, string& body)
+            {
+                const bool result = (_received.Lock(10000) == Core::ERROR_NONE);
+
+                _received.ResetEvent();
+                errorCode = _errorCode;
+                contentRange = _contentRange;
+                body = _body;
+
+                return (result);
+            }
+
+            void LinkBody(Core::ProxyType<Web::Response>& element) override
+            {
+                element->Body(_textBodyFactory.Element());
+            }
+            void Received(Core::ProxyType<Web::Response>& response) override
+            {
+                _errorCode = response->ErrorCode;
+                _contentRange = (response->ContentRange.IsSet() == true ? response->ContentRange.Value() : string());
+                _body = (response->HasBody() == true ? static_cast<const string&>(*(response->Body<Web::TextBody>())) : string());
+                _received.SetEvent();
+            }
+            void Send(const Core::ProxyType<Web::Request>&) override
+            {
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            Core::Event _received;
+            uint32_t _errorCode;
+            string _contentRange;
+            string _body;
+            static Core::ProxyPoolType<Web::Response> _responseFactory;
+            static Core::ProxyPoolType<Web::TextBody> _textBodyFactory;
+        };
+
+        /* static */ Core::ProxyPoolType<Web::Response> FileClient::_responseFactory(2);
+        /* static */ Core::ProxyPoolType<Web::TextBody> FileClient::_textBodyFactory(2);
+
+    }
+
+    TEST(Web_FileBody, Range)
+    {
+        CreateFile(1000);
+
+        {
+            Web::FileBody body(FileName);
+
+            EXPECT_EQ(body.ContentRange(), _T("bytes */1000"));
+
+            EXPECT_EQ(body.Range(_T("bytes=0-99")), Web::FileBody::RANGE_SATISFIABLE);
+            EXPECT_EQ(body.ContentRange(), _T("bytes 0-99/1000"));
+            EXPECT_EQ(body.Range(_T("bytes=990-")), Web::FileBody::RANGE_SATISFIABLE);
+            EXPECT_EQ(body.ContentRange(), _T("bytes 990-999/1000"));
+            EXPECT_EQ(body.Range(_T("bytes=-10")), Web::FileBody::RANGE_SATISFIABLE);
+            EXPECT_EQ(body.ContentRange(), _T("bytes 990-999/1000"));
+            EXPECT_EQ(body.Range(_T("bytes=-5000")), Web::FileBody::RANGE_SATISFIABLE);
+            EXPECT_EQ(body.ContentRange(), _T("bytes 0-999/1000"));
+            EXPECT_EQ(body.Range(_T("bytes=500-5000")), Web::FileBody::RANGE_SATISFIABLE);
+            EXPECT_EQ(body.ContentRange(), _T("bytes 500-999/1000"));
+
+            // Valid ranges, but none of it is in the file.
+            EXPECT_EQ(body.Range(_T("bytes=1000-")), Web::FileBody::RANGE_UNSATISFIABLE);
+            EXPECT_EQ(body.Range(_T("bytes=1000-2000")), Web::FileBody::RANGE_UNSATISFIABLE);
+            EXPECT_EQ(body.Range(_T("bytes=-0")), Web::FileBody::RANGE_UNSATISFIABLE);
+
+            // Not a valid (or supported) range, so the whole file is served.
+            EXPECT_EQ(body.Range(_T("bytes=5-2")), Web::FileBody::RANGE_IGNORED);
+            EXPECT_EQ(body.Range(_T("bytes=0-1,5-6")), Web::FileBody::RANGE_IGNORED);
+            EXPECT_EQ(body.Range(_T("items=0-1")), Web::FileBody::RANGE_IGNORED);
+            EXPECT_EQ(body.Range(_T("bytes=a-b")), Web::FileBody::RANGE_IGNORED);
+            EXPECT_EQ(body.Range(_T("bytes=-")), Web::FileBody::RANGE_IGNORED);
+            EXPECT_EQ(body.Range(_T("bytes=99999999999999999999999-")), Web::FileBody::RANGE_IGNORED);
+
+            // A range that is not taken, leaves the last one.
+            EXPECT_EQ(body.ContentRange(), _T("bytes 500-999/1000"));
+        }
+
+        Core::File(string(FileName)).Destroy();
+    }
+
+    TEST(Web_FileBody, SentFromTheFile)
+    {
+        // Larger than the send buffer, so it takes several rounds.
+        const string content(CreateFile(300 * 1024));
+        const Core::NodeId node(_T("/tmp/wpefilebody0"));
+
+        Core::SocketServerType<FileServer> server(node);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        FileClient client(node);
+        ASSERT_EQ(client.Open(Core::infinite), Core::ERROR_NONE);
+
+        uint32_t errorCode;
+        string contentRange;
+        string body;
+
+        Core::ProxyType<Web::Request> request(Core::ProxyType<Web::Request>::Create());
+        request->Verb = Web::Request::HTTP_GET;
+        client.Submit(request);
+
+        EXPECT_TRUE(client.Wait(errorCode, contentRange, body));
+        EXPECT_EQ(errorCode, static_cast<uint32_t>(Web::STATUS_OK));
+        EXPECT_TRUE(contentRange.empty());
+        EXPECT_EQ(body.size(), content.size());
+        EXPECT_TRUE(body == content);
+
+        // The next response on the same link picks up where the file left off.
+        request = Core::ProxyType<Web::Request>::Create();
+        request->Verb = Web::Request::HTTP_GET;
+        request->Range = _T("bytes=1000-200999");
+        client.Submit(request);
+
+        EXPECT_TRUE(client.Wait(errorCode, contentRange, body));
+        EXPECT_EQ(errorCode, static_cast<uint32_t>(Web::STATUS_PARTIAL_CONTENT));
+        EXPECT_EQ(contentRange, _T("bytes 1000-200999/307200"));
+        EXPECT_EQ(body.size(), 200000u);
+        EXPECT_TRUE(body == content.substr(1000, 200000));
+
+        client.Close(Core::infinite);
+        server.Close(Core::infinite);
+
+        Core::File(string(FileName)).Destroy();
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
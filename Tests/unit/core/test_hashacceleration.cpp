@@ -0,0 +1,209 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        const uint8_t AllAcceleration = (Crypto::ACCELERATION_SHA | Crypto::ACCELERATION_MULTIBUFFER);
+
+        const string TwoBlocks(_T("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+
+        string Hex(const uint8_t digest[], const uint8_t length)
+        {
+            static const TCHAR Digits[] = _T("0123456789abcdef");
+            string result;
+
+            for (uint8_t index = 0; index < length; index++) {
+                result += Digits[digest[index] >> 4];
+                result += Digits[digest[index] & 0xF];
+            }
+
+            return (result);
+        }
+
+        template <typename HASH>
+        string Digest(const string& message, const uint16_t piece = 0xFFFF)
+        {
+            HASH hash;
+            size_t offset = 0;
+
+            while (offset < message.size()) {
+                const uint16_t size = static_cast<uint16_t>(std::min(static_cast<size_t>(piece), message.size() - offset));
+
+                hash.Input(reinterpret_cast<const uint8_t*>(&(message[offset])), size);
+                offset += size;
+            }
+
+            return (Hex(hash.Result(), HASH::Length));
+        }
+
+        template <typename HASH>
+        string MillionA()
+        {
+            const string thousand(1000, 'a');
+            HASH hash;
+
+            for (uint16_t index = 0; index < 1000; index++) {
+                hash.Input(reinterpret_cast<const uint8_t*>(thousand.data()), static_cast<uint16_t>(thousand.size()));
+            }
+
+            return (Hex(hash.Result(), HASH::Length));
+        }
+
+        template <typename HMAC>
+        string MAC(const string& key, const string& message)
+        {
+            HMAC hmac(key);
+
+            hmac.Input(reinterpret_cast<const uint8_t*>(message.data()), static_cast<uint16_t>(message.size()));
+
+            return (Hex(hmac.Result(), HMAC::Length));
+        }
+
+        string Message(const uint32_t size, const uint32_t seed)
+        {
+            string result(size, ' ');
+
+            for (uint32_t index = 0; index < size; index++) {
+                result[index] = static_cast<char>((index * 31) + (seed * 7) + (index >> 5));
+            }
+
+            return (result);
+        }
+
+    }
+
+    TEST(Crypto_HashAcceleration, KnownAnswers)
+    {
+        const uint8_t supported = Crypto::Acceleration(AllAcceleration);
+
+        for (const uint8_t acceleration : { static_cast<uint8_t>(Crypto::ACCELERATION_NONE), supported }) {
+            EXPECT_EQ(Crypto::Acceleration(acceleration), acceleration);
+
+            EXPECT_EQ(Digest<Crypto::SHA1>(_T("")), _T("da39a3ee5e6b4b0d3255bfef95601890afd80709"));
+            EXPECT_EQ(Digest<Crypto::SHA1>(_T("abc")), _T("a9993e364706816aba3e25717850c26c9cd0d89d"));
+            EXPECT_EQ(Digest<Crypto::SHA1>(TwoBlocks), _T("84983e441c3bd26ebaae4aa1f95129e5e54670f1"));
+            EXPECT_EQ(MillionA<Crypto::SHA1>(), _T("34aa973cd4c4daa4f61eeb2bdbad27316534016f"));
+
+            EXPECT_EQ(Digest<Crypto::SHA224>(_T("")), _T("d14a028c2a3a2bc9476102bb288234c415a2b01f828ea62ac5b3e42f"));
+            EXPECT_EQ(Digest<Crypto::SHA224>(_T("abc")), _T("23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7"));
+            EXPECT_EQ(Digest<Crypto::SHA224>(TwoBlocks), _T("75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525"));
+
+            EXPECT_EQ(Digest<Crypto::SHA256>(_T("")), _T("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"));
+            EXPECT_EQ(Digest<Crypto::SHA256>(_T("abc")), _T("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+            EXPECT_EQ(Digest<Crypto::SHA256>(TwoBlocks), _T("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+            EXPECT_EQ(MillionA<Crypto::SHA256>(), _T("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+        }
+
+        Crypto::Acceleration(AllAcceleration);
+    }
+
+    TEST(Crypto_HashAcceleration, SameDigests)
+    {
+        const uint8_t supported = Crypto::Acceleration(AllAcceleration);
+
+        // Every length around the padding boundaries, handed over in one piece and in odd pieces.
+        for (uint32_t size = 0; size <= 300; size++) {
+            const string message(Message(size, size));
+
+            Crypto::Acceleration(Crypto::ACCELERATION_NONE);
+            const string sha1(Digest<Crypto::SHA1>(message));
+            const string sha224(Digest<Crypto::SHA224>(message));
+            const string sha256(Digest<Crypto::SHA256>(message));
+
+            Crypto::Acceleration(supported);
+            EXPECT_EQ(Digest<Crypto::SHA1>(message, 7), sha1);
+            EXPECT_EQ(Digest<Crypto::SHA224>(message, 65), sha224);
+            EXPECT_EQ(Digest<Crypto::SHA256>(message, 13), sha256);
+            EXPECT_EQ(Digest<Crypto::SHA256>(message), sha256);
+        }
+
+        Crypto::Acceleration(AllAcceleration);
+    }
+
+    TEST(Crypto_HashAcceleration, Batch)
+    {
+        const uint8_t supported = Crypto::Acceleration(AllAcceleration);
+
+        std::vector<string> messages;
+        std::vector<const uint8_t*> pointers;
+        std::vector<uint16_t> lengths;
+
+        for (uint32_t index = 0; index < 21; index++) {
+            messages.push_back(Message((index * 37) % 200, index));
+        }
+        for (const string& message : messages) {
+            pointers.push_back(reinterpret_cast<const uint8_t*>(message.data()));
+            lengths.push_back(static_cast<uint16_t>(message.size()));
+        }
+
+        for (const uint8_t acceleration : { static_cast<uint8_t>(Crypto::ACCELERATION_NONE), supported }) {
+            Crypto::Acceleration(acceleration);
+
+            // Full groups, a partial group and a few left over that go one by one.
+            for (const uint16_t count : { 1, 3, 4, 8, 13, 21 }) {
+                std::vector<uint8_t> digests(count * Crypto::SHA256::Length);
+
+                Crypto::SHA256::Batch(count, pointers.data(), lengths.data(), digests.data());
+
+                for (uint16_t index = 0; index < count; index++) {
+                    EXPECT_EQ(Hex(&(digests[index * Crypto::SHA256::Length]), Crypto::SHA256::Length), Digest<Crypto::SHA256>(messages[index]));
+                }
+            }
+        }
+
+        Crypto::Acceleration(AllAcceleration);
+    }
+
+    TEST(Crypto_HashAcceleration, HMAC)
+    {
+        // RFC 2202 and RFC 4231
+        EXPECT_EQ(MAC<Crypto::SHA1HMAC>(_T("Jefe"), _T("what do ya want for nothing?")), _T("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79"));
+        EXPECT_EQ(MAC<Crypto::SHA256HMAC>(_T("Jefe"), _T("what do ya want for nothing?")), _T("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"));
+        EXPECT_EQ(MAC<Crypto::SHA256HMAC>(string(131, '\xaa'), _T("Test Using Larger Than Block-Size Key - Hash Key First")), _T("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"));
+
+        // The key is hashed once, a Reset and a prepared key give the same MAC.
+        const string message(_T("what do ya want for nothing?"));
+        Crypto::SHA256HMAC::KeyContext key;
+        Crypto::SHA256HMAC::Prepare(_T("Jefe"), key);
+
+        Crypto::SHA256HMAC hmac(key);
+
+        hmac.Input(reinterpret_cast<const uint8_t*>(message.data()), static_cast<uint16_t>(message.size()));
+        const string first(Hex(hmac.Result(), Crypto::SHA256HMAC::Length));
+
+        hmac.Reset();
+        hmac.Input(reinterpret_cast<const uint8_t*>(message.data()), static_cast<uint16_t>(message.size()));
+        const string second(Hex(hmac.Result(), Crypto::SHA256HMAC::Length));
+
+        EXPECT_EQ(first, _T("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"));
+        EXPECT_EQ(second, first);
+    }
+
+} // Tests
+} // WPEFramework
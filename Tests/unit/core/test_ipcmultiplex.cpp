@@ -0,0 +1,154 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Parameters is the time (ms) the other side takes to respond, the response echoes it.
+    typedef Core::IPCMessageType<10, uint32_t, uint32_t> DelayedEcho;
+
+    class HandleDelayedEcho : public Core::IIPCServer {
+    public:
+        HandleDelayedEcho(const HandleDelayedEcho&) = delete;
+        HandleDelayedEcho& operator=(const HandleDelayedEcho&) = delete;
+
+        HandleDelayedEcho()
+            : _lock()
+            , _responders()
+        {
+        }
+        ~HandleDelayedEcho() override
+        {
+            Join();
+        }
+
+    public:
+        // Respond from another thread, like a COM-RPC server does, so responses can overtake each other.
+        void Procedure(Core::IPCChannel& source, Core::ProxyType<Core::IIPC>& data) override
+        {
+            Core::ProxyType<Core::IIPC> message(data);
+
+            _lock.Lock();
+            _responders.emplace_back([&source, message]() mutable {
+                Core::ProxyType<DelayedEcho> echo(message);
+
+                SleepMs(echo->Parameters());
+                echo->Response() = echo->Parameters();
+                source.ReportResponse(message);
+            });
+            _lock.Unlock();
+        }
+        void Join()
+        {
+            _lock.Lock();
+            for (std::thread& responder : _responders) {
+                responder.join();
+            }
+            _responders.clear();
+            _lock.Unlock();
+        }
+
+    private:
+        Core::CriticalSection _lock;
+        std::vector<std::thread> _responders;
+    };
+
+    static void ConcurrentCalls(const bool multiplexed, uint32_t& first)
+    {
+        Core::NodeId node(_T("/tmp/testipcmultiplex"));
+
+        Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t>> factory(Core::ProxyType<Core::FactoryType<Core::IIPC, uint32_t>>::Create());
+        factory->CreateFactory<DelayedEcho>(2);
+
+        Core::ProxyType<HandleDelayedEcho> handler(Core::ProxyType<HandleDelayedEcho>::Create());
+
+        Core::IPCChannelClientType<Core::Void, true, false> server(node, 1024, factory);
+        server.Register(DelayedEcho::Id(), Core::ProxyType<Core::IIPCServer>(handler));
+        EXPECT_EQ(server.Source().Open(1000), Core::ERROR_NONE);
+
+        Core::IPCChannelClientType<Core::Void, false, false> client(node, 1024, factory);
+        EXPECT_EQ(client.Source().Open(1000), Core::ERROR_NONE);
+
+        client.Multiplexed(multiplexed);
+
+        Core::ProxyType<DelayedEcho> slow(Core::ProxyType<DelayedEcho>::Create(300));
+        Core::ProxyType<DelayedEcho> fast(Core::ProxyType<DelayedEcho>::Create(10));
+        std::atomic<uint32_t> completed(0);
+
+        std::thread slowCaller([&]() {
+            EXPECT_EQ(client.Invoke(slow, 2000), Core::ERROR_NONE);
+            uint32_t expected = 0;
+            completed.compare_exchange_strong(expected, slow->Response());
+        });
+
+        // Make sure the slow one goes out first.
+        SleepMs(50);
+
+        std::thread fastCaller([&]() {
+            EXPECT_EQ(client.Invoke(fast, 2000), Core::ERROR_NONE);
+            uint32_t expected = 0;
+            completed.compare_exchange_strong(expected, fast->Response());
+        });
+
+        slowCaller.join();
+        fastCaller.join();
+
+        EXPECT_EQ(slow->Response(), 300u);
+        EXPECT_EQ(fast->Response(), 10u);
+
+        first = completed;
+
+        handler->Join();
+
+        client.Source().Close(1000);
+        server.Source().Close(1000);
+        server.Unregister(DelayedEcho::Id());
+
+        factory->DestroyFactories();
+    }
+
+    TEST(Core_IPC, MultiplexedCallsOvertake)
+    {
+        uint32_t first = 0;
+
+        ConcurrentCalls(true, first);
+
+        // The fast call should not wait for the slow one.
+        EXPECT_EQ(first, 10u);
+    }
+
+    TEST(Core_IPC, SerializedCallsByDefault)
+    {
+        uint32_t first = 0;
+
+        ConcurrentCalls(false, first);
+
+        // Without multiplexing, the second call waits for the first to complete.
+        EXPECT_EQ(first, 300u);
+    }
+
+} // Tests
+} // WPEFramework
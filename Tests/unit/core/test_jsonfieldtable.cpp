@@ -0,0 +1,240 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        class Added : public Core::JSON::Container {
+        public:
+            Added(const Added&) = delete;
+            Added& operator=(const Added&) = delete;
+
+            Added()
+                : Core::JSON::Container()
+                , Name()
+                , Count()
+                , Enabled()
+                , Tags()
+            {
+                Add(_T("name"), &Name);
+                Add(_T("count"), &Count);
+                Add(_T("enabled"), &Enabled);
+                Add(_T("tags"), &Tags);
+            }
+            ~Added() override = default;
+
+        public:
+            Core::JSON::String Name;
+            Core::JSON::DecUInt32 Count;
+            Core::JSON::Boolean Enabled;
+            Core::JSON::ArrayType<Core::JSON::String> Tags;
+        };
+
+        class Declared : public Core::JSON::Container {
+        public:
+            Declared(const Declared&) = delete;
+            Declared& operator=(const Declared&) = delete;
+
+            Declared()
+                : Core::JSON::Container(Fields())
+                , Name()
+                , Count()
+                , Enabled()
+                , Tags()
+            {
+            }
+            ~Declared() override = default;
+
+        private:
+            static const Core::JSON::Container::FieldTable& Fields()
+            {
+                static const Core::JSON::Container::FieldTable fields({
+                    JSON_CONTAINER_FIELD(Declared, _T("name"), Name),
+                    JSON_CONTAINER_FIELD(Declared, _T("count"), Count),
+                    JSON_CONTAINER_FIELD(Declared, _T("enabled"), Enabled),
+                    JSON_CONTAINER_FIELD(Declared, _T("tags"), Tags) });
+
+                return (fields);
+            }
+
+        public:
+            Core::JSON::String Name;
+            Core::JSON::DecUInt32 Count;
+            Core::JSON::Boolean Enabled;
+            Core::JSON::ArrayType<Core::JSON::String> Tags;
+        };
+
+        // A declared container can still Add fields of its own.
+        class Extended : public Declared {
+        public:
+            Extended(const Extended&) = delete;
+            Extended& operator=(const Extended&) = delete;
+
+            Extended()
+                : Declared()
+                , Extra()
+            {
+                Add(_T("extra"), &Extra);
+            }
+            ~Extended() override = default;
+
+        public:
+            void Empty()
+            {
+                Reset();
+            }
+
+        public:
+            Core::JSON::String Extra;
+        };
+    }
+
+    TEST(Core_JSONFieldTable, BehavesLikeAdded)
+    {
+        const string text(_T("{\"name\":\"Thunder\",\"count\":42,\"unknown\":{\"a\":[1,2]},\"enabled\":true,\"tags\":[\"one\",\"two\"]}"));
+        Added added;
+        Declared declared;
+
+        EXPECT_FALSE(declared.IsSet());
+        ASSERT_TRUE(added.FromString(text));
+        ASSERT_TRUE(declared.FromString(text));
+        EXPECT_TRUE(declared.IsSet());
+
+        EXPECT_EQ(declared.Name.Value(), _T("Thunder"));
+        EXPECT_EQ(declared.Count.Value(), 42u);
+        EXPECT_TRUE(declared.Enabled.Value());
+        ASSERT_EQ(declared.Tags.Length(), 2);
+        EXPECT_EQ(declared.Tags[1].Value(), _T("two"));
+        EXPECT_TRUE(declared.HasLabel(_T("count")));
+        EXPECT_FALSE(declared.HasLabel(_T("unknown")));
+
+        string fromAdded, fromDeclared;
+        added.ToString(fromAdded);
+        declared.ToString(fromDeclared);
+        EXPECT_EQ(fromDeclared, fromAdded);
+
+        // Only what is set is serialized, in the order of the table.
+        declared.Clear();
+        EXPECT_FALSE(declared.IsSet());
+        declared.Tags.Add() = _T("three");
+        declared.Name = _T("WPE");
+        declared.ToString(fromDeclared);
+        EXPECT_EQ(fromDeclared, _T("{\"name\":\"WPE\",\"tags\":[\"three\"]}"));
+
+        added.Clear();
+        added.Tags.Add() = _T("three");
+        added.Name = _T("WPE");
+
+        std::vector<uint8_t> packedAdded, packedDeclared;
+        EXPECT_TRUE(added.ToBuffer(packedAdded));
+        EXPECT_TRUE(declared.ToBuffer(packedDeclared));
+        EXPECT_EQ(packedDeclared, packedAdded);
+    }
+
+    TEST(Core_JSONFieldTable, AddedAfterTheTable)
+    {
+        Extended extended;
+
+        ASSERT_TRUE(extended.FromString(_T("{\"extra\":\"more\",\"count\":7}")));
+        EXPECT_EQ(extended.Extra.Value(), _T("more"));
+        EXPECT_EQ(extended.Count.Value(), 7u);
+
+        string text;
+        extended.ToString(text);
+        EXPECT_EQ(text, _T("{\"count\":7,\"extra\":\"more\"}"));
+
+        Core::JSONRPC::Message message;
+        ASSERT_TRUE(message.FromString(_T("{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"Controller.1.status\",\"error\":{\"code\":-32601,\"message\":\"Unknown method.\"}}")));
+        EXPECT_EQ(message.Id.Value(), 3u);
+        EXPECT_EQ(message.Designator.Value(), _T("Controller.1.status"));
+        EXPECT_EQ(message.Error.Code.Value(), -32601);
+        EXPECT_EQ(message.Error.Text.Value(), _T("Unknown method."));
+    }
+
+    TEST(Core_JSONFieldTable, RemovedFromTheTable)
+    {
+        Extended extended;
+        const string count(_T("count"));
+
+        extended.Name = _T("WPE");
+        extended.Count = 7;
+        extended.Extra = _T("more");
+
+        // Not the label pointer of the table, it is still found.
+        extended.Remove(count.c_str());
+        EXPECT_FALSE(extended.HasLabel(count));
+        EXPECT_TRUE(extended.HasLabel(_T("name")));
+
+        string text;
+        extended.ToString(text);
+        EXPECT_EQ(text, _T("{\"name\":\"WPE\",\"extra\":\"more\"}"));
+
+        extended.Clear();
+        ASSERT_TRUE(extended.FromString(_T("{\"count\":8,\"enabled\":true,\"extra\":\"again\"}")));
+        // Not a field anymore, so it is neither cleared nor parsed.
+        EXPECT_EQ(extended.Count.Value(), 7u);
+        EXPECT_TRUE(extended.Enabled.Value());
+        EXPECT_EQ(extended.Extra.Value(), _T("again"));
+
+        extended.Empty();
+        EXPECT_FALSE(extended.HasLabel(_T("name")));
+        EXPECT_FALSE(extended.HasLabel(_T("extra")));
+        extended.ToString(text);
+        EXPECT_EQ(text, _T("{}"));
+    }
+
+    TEST(Core_JSONFieldTable, EveryLabelHasASlot)
+    {
+        using Field = Core::JSON::Container::FieldTable::Field;
+
+        const Core::JSON::Container::FieldTable table({
+            Field{ _T("a"), nullptr }, Field{ _T("b"), nullptr }, Field{ _T("ab"), nullptr }, Field{ _T("ba"), nullptr },
+            Field{ _T("id"), nullptr }, Field{ _T("di"), nullptr }, Field{ _T("callsign"), nullptr }, Field{ _T("locator"), nullptr },
+            Field{ _T("classname"), nullptr }, Field{ _T("startmode"), nullptr }, Field{ _T("state"), nullptr }, Field{ _T("observers"), nullptr },
+            Field{ _T("module"), nullptr }, Field{ _T("hash"), nullptr }, Field{ _T("major"), nullptr }, Field{ _T("minor"), nullptr },
+            Field{ _T("patch"), nullptr }, Field{ _T("configuration"), nullptr }, Field{ _T("precondition"), nullptr }, Field{ _T("termination"), nullptr },
+            Field{ _T("control"), nullptr }, Field{ _T("versions"), nullptr }, Field{ _T("processedrequests"), nullptr }, Field{ _T("processedobjects"), nullptr },
+            Field{ _T("communicator"), nullptr }, Field{ _T("persistentpath"), nullptr }, Field{ _T("volatilepath"), nullptr }, Field{ _T("datapath"), nullptr },
+            Field{ _T("systempath"), nullptr }, Field{ _T("proxystubpath"), nullptr }, Field{ _T("postmortempath"), nullptr }, Field{ _T("webprefix"), nullptr },
+            Field{ _T("jsonrpcprefix"), nullptr }, Field{ _T("idletime"), nullptr }, Field{ _T("softkillcheckwaittime"), nullptr }, Field{ _T("hardkillcheckwaittime"), nullptr },
+            Field{ _T("legacyinitialize"), nullptr }, Field{ _T("exitreasons"), nullptr }, Field{ _T("latencymonitor"), nullptr }, Field{ _T("process"), nullptr } });
+
+        ASSERT_EQ(table.Count(), 40);
+        for (uint16_t index = 0; index < table.Count(); index++) {
+            EXPECT_EQ(table.Index(table.Label(index)), index);
+            EXPECT_EQ(table.Index(string(table.Label(index)).c_str()), index);
+        }
+        EXPECT_EQ(table.Index(_T("missing")), table.Count());
+        EXPECT_EQ(table.Index(_T("")), table.Count());
+
+        const Core::JSON::Container::FieldTable single({ Field{ _T("only"), nullptr } });
+        EXPECT_EQ(single.Index(_T("only")), 0);
+        EXPECT_EQ(single.Index(_T("other")), 1);
+    }
+
+} // Tests
+} // WPEFramework
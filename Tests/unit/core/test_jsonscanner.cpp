@@ -0,0 +1,154 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        uint16_t Reference(const char stream[], const uint16_t length, bool (*stop)(const char))
+        {
+            uint16_t index = 0;
+            while ((index < length) && (stop(stream[index]) == false)) {
+                index++;
+            }
+            return (index);
+        }
+
+        bool IsSpace(const char character)
+        {
+            return ((character == ' ') || ((character >= '\t') && (character <= '\r')));
+        }
+
+        class Message : public Core::JSON::Container {
+        public:
+            Message(const Message&) = delete;
+            Message& operator=(const Message&) = delete;
+
+            Message()
+                : Core::JSON::Container()
+                , Method()
+                , Params()
+                , Names()
+            {
+                Add(_T("method"), &Method);
+                Add(_T("params"), &Params);
+                Add(_T("names"), &Names);
+            }
+            ~Message() override = default;
+
+        public:
+            Core::JSON::String Method;
+            Core::JSON::String Params;
+            Core::JSON::ArrayType<Core::JSON::String> Names;
+        };
+
+        // Feeds the text in chunks of the given size, like a socket would.
+        bool Chunked(Core::JSON::IElement& element, const string& text, const uint16_t chunk)
+        {
+            Core::OptionalType<Core::JSON::Error> error;
+            uint32_t offset = 0;
+            uint32_t index = 0;
+
+            element.Clear();
+
+            while ((index < text.length()) && (error.IsSet() == false)) {
+                const uint16_t size = static_cast<uint16_t>(std::min(static_cast<size_t>(chunk), text.length() - index));
+                index += element.Deserialize(&(text[index]), size, offset, error);
+            }
+
+            return (error.IsSet() == false);
+        }
+    }
+
+    TEST(Core_JSONScanner, MatchesCharacterByCharacter)
+    {
+        const char alphabet[] = "abcXYZ019:._-{}[],\" \t\r\n\\\x01\x7F\xC3\xA9";
+        std::string stream(300, 'a');
+
+        for (uint32_t round = 0; round < 200; round++) {
+            for (char& character : stream) {
+                // Mostly plain, so the runs get long enough to take blocks.
+                character = ((::rand() % 20) == 0 ? alphabet[::rand() % (sizeof(alphabet) - 1)] : 'a' + (::rand() % 26));
+            }
+
+            for (uint16_t start = 0; start < 40; start++) {
+                const char* data = &(stream[start]);
+                const uint16_t length = static_cast<uint16_t>(stream.length() - start - (round % 7));
+
+                EXPECT_EQ(Core::JSON::Scanner::Text(data, length), Reference(data, length, [](const char c) { return ((c == '"') || (c == '\\') || (static_cast<signed char>(c) < 0x20)); }));
+                EXPECT_EQ(Core::JSON::Scanner::Quoted(data, length), Reference(data, length, [](const char c) { return (c == '"'); }));
+                EXPECT_EQ(Core::JSON::Scanner::Opaque(data, length), Reference(data, length, [](const char c) { return ((::strchr("{}[],\"", c) != nullptr) || (c == '\0') || (IsSpace(c) == true)); }));
+            }
+        }
+
+        const std::string spaces(std::string(45, ' ') + "\t\r\n  x  ");
+        EXPECT_EQ(Core::JSON::Scanner::Whitespace(spaces.c_str(), static_cast<uint16_t>(spaces.length())), 50);
+        EXPECT_EQ(Core::JSON::Scanner::Whitespace(spaces.c_str(), 20), 20);
+        EXPECT_EQ(Core::JSON::Scanner::Whitespace("x", 1), 0);
+        EXPECT_EQ(Core::JSON::Scanner::Text("", 0), 0);
+    }
+
+    TEST(Core_JSONScanner, ChunkedDeserializeKeepsResult)
+    {
+        const string params(_T("{\"callsign\":\"WebKitBrowser\",\"configuration\":{\"url\":\"http://example.com/\\\"quoted\\\"/\",\"list\":[1, 2, 3],\"text\":\"a [ b } c\"},\"padding\":\"") + string(200, 'p') + _T("\"}"));
+        const string text(_T("{ \"method\" : \"Controller.1.activate\",\n    \"params\": ") + params + _T(",\n    \"names\": [ \"first\\tone\", \"") + string(100, 'n') + _T("\", \"\\u00e9\" ] }"));
+
+        Message whole;
+        ASSERT_TRUE(whole.FromString(text));
+        EXPECT_EQ(whole.Method.Value(), _T("Controller.1.activate"));
+        // Outside the quotes, the whitespace in an opaque object is dropped.
+        string opaque(params);
+        opaque.replace(opaque.find(_T("[1, 2, 3]")), 9, _T("[1,2,3]"));
+        EXPECT_EQ(whole.Params.Value(), opaque);
+        ASSERT_EQ(whole.Names.Length(), 3);
+        EXPECT_EQ(whole.Names[0].Value(), _T("first\tone"));
+        EXPECT_EQ(whole.Names[1].Value(), string(100, 'n'));
+
+        for (uint16_t chunk : { 1, 2, 3, 7, 15, 16, 17, 31, 32, 33, 64, 1000 }) {
+            Message parts;
+
+            EXPECT_TRUE(Chunked(parts, text, chunk));
+            EXPECT_EQ(parts.Method.Value(), whole.Method.Value());
+            EXPECT_EQ(parts.Params.Value(), whole.Params.Value());
+            ASSERT_EQ(parts.Names.Length(), whole.Names.Length());
+            for (uint16_t index = 0; index < whole.Names.Length(); index++) {
+                EXPECT_EQ(parts.Names[index].Value(), whole.Names[index].Value());
+            }
+        }
+    }
+
+    TEST(Core_JSONScanner, ControlCharacterStillRejected)
+    {
+        Message message;
+        Core::OptionalType<Core::JSON::Error> error;
+
+        const string text(_T("{\"method\":\"") + string(40, 'm') + _T("\x01\"}"));
+        message.FromString(text, error);
+        EXPECT_TRUE(error.IsSet());
+    }
+
+} // Tests
+} // WPEFramework
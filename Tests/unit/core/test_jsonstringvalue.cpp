@@ -0,0 +1,85 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    TEST(Core_JSONStringValue, OpaqueParametersAreNotCopied)
+    {
+        const string params(_T("{\"callsign\":\"WebKitBrowser\",\"data\":\"") + string(4096, 'd') + _T("\"}"));
+        Core::JSONRPC::Message message;
+        string buffer;
+
+        ASSERT_TRUE(message.FromString(_T("{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"Controller.1.activate\",\"params\":") + params + _T("}")));
+
+        const string& first(message.Parameters.Value(buffer));
+        const string& second(message.Parameters.Value(buffer));
+
+        EXPECT_EQ(first, params);
+        EXPECT_EQ(first, message.Parameters.Value());
+        EXPECT_EQ(&first, &second);
+        EXPECT_NE(&first, &buffer);
+        EXPECT_TRUE(buffer.empty());
+    }
+
+    TEST(Core_JSONStringValue, ConvertedWhenNeeded)
+    {
+        string buffer;
+
+        // An opaque string that was quoted, is handed out quoted again.
+        Core::JSON::String opaque(false);
+        ASSERT_TRUE(opaque.FromString(_T("\"text\"")));
+        EXPECT_EQ(opaque.Value(buffer), opaque.Value());
+        EXPECT_EQ(&(opaque.Value(buffer)), &buffer);
+
+        Core::JSON::String defaulted(_T("fallback"));
+        EXPECT_EQ(defaulted.Value(buffer), _T("fallback"));
+
+        Core::JSON::String quoted;
+        ASSERT_TRUE(quoted.FromString(_T("\"a \\\"b\\\" c\"")));
+        buffer.clear();
+        EXPECT_EQ(quoted.Value(buffer), _T("a \"b\" c"));
+        EXPECT_TRUE(buffer.empty());
+    }
+
+    TEST(Core_JSONStringValue, ResultIsTakenOver)
+    {
+        Core::JSONRPC::Message message;
+        string output(_T("{\"state\":\"activated\",\"list\":[1,2,3]}"));
+        const string expected(output);
+
+        message.Result = std::move(output);
+
+        EXPECT_TRUE(message.Result.IsSet());
+        EXPECT_EQ(message.Result.Value(), expected);
+
+        string text;
+        message.Id = 4;
+        message.ToString(text);
+        EXPECT_EQ(text, _T("{\"jsonrpc\":\"2.0\",\"id\":4,\"result\":") + expected + _T("}"));
+    }
+
+} // Tests
+} // WPEFramework
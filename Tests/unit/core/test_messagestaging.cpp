@@ -0,0 +1,156 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <messaging/MessageDispatcher.h>
+
+#include <thread>
+#include <vector>
+
+namespace WPEFramework {
+namespace Tests {
+
+    class Core_MessageStaging : public testing::Test {
+    protected:
+        static constexpr uint16_t METADATA_SIZE = 1 * 1024;
+        static constexpr uint16_t DATA_SIZE = 60 * 1024;
+
+        using Buffer = Messaging::MessageDataBufferType<DATA_SIZE, METADATA_SIZE>;
+
+        Core_MessageStaging()
+            : _basePath(_T("/tmp/TestMessageStaging"))
+        {
+            if (Core::File(_basePath).IsDirectory()) {
+                Core::Directory(_basePath.c_str()).Destroy();
+            }
+            Core::Directory(_basePath.c_str()).CreatePath();
+        }
+        ~Core_MessageStaging() override
+        {
+            if (Core::File(_basePath).IsDirectory()) {
+                Core::Directory(_basePath.c_str()).Destroy();
+            }
+        }
+
+        struct Entry {
+            uint32_t Producer;
+            uint32_t Sequence;
+        };
+
+        string _basePath;
+    };
+
+    TEST_F(Core_MessageStaging, OrderPerThreadIsKept)
+    {
+        const uint32_t producers = 4;
+        const uint32_t messages = 1000;
+
+        Buffer buffer(_T("stage"), 0, _basePath, 0, true, true);
+        ASSERT_TRUE(buffer.IsValid());
+
+        std::vector<std::thread> threads;
+        for (uint32_t producer = 0; producer < producers; producer++) {
+            threads.emplace_back([&buffer, producer, messages]() {
+                for (uint32_t sequence = 0; sequence < messages; sequence++) {
+                    Entry entry { producer, sequence };
+                    EXPECT_EQ(buffer.PushData(sizeof(entry), reinterpret_cast<const uint8_t*>(&entry)), Core::ERROR_NONE);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        buffer.Settle();
+
+        std::vector<uint32_t> expected(producers, 0);
+        uint32_t received = 0;
+        Entry entry;
+        uint16_t length = sizeof(entry);
+
+        while (buffer.PopData(length, reinterpret_cast<uint8_t*>(&entry)) == Core::ERROR_NONE) {
+            ASSERT_EQ(length, sizeof(entry));
+            ASSERT_LT(entry.Producer, producers);
+            EXPECT_EQ(entry.Sequence, expected[entry.Producer]);
+            expected[entry.Producer] = entry.Sequence + 1;
+            received++;
+            length = sizeof(entry);
+        }
+
+        EXPECT_EQ(received, producers * messages);
+    }
+
+    TEST_F(Core_MessageStaging, LargeMessageDoesNotOvertakeStaged)
+    {
+        Buffer buffer(_T("stage"), 1, _basePath, 0, true, true);
+        ASSERT_TRUE(buffer.IsValid());
+
+        uint8_t small[16];
+        uint8_t large[6 * 1024];
+        ::memset(small, 0x11, sizeof(small));
+        ::memset(large, 0x22, sizeof(large));
+
+        // The large one does not fit in a staging ring, so it goes directly, but only after the small one.
+        EXPECT_EQ(buffer.PushData(sizeof(small), small), Core::ERROR_NONE);
+        EXPECT_EQ(buffer.PushData(sizeof(large), large), Core::ERROR_NONE);
+        buffer.Settle();
+
+        uint8_t read[sizeof(large)];
+        uint16_t length = sizeof(read);
+
+        ASSERT_EQ(buffer.PopData(length, read), Core::ERROR_NONE);
+        EXPECT_EQ(length, sizeof(small));
+        EXPECT_EQ(read[0], 0x11);
+
+        length = sizeof(read);
+        ASSERT_EQ(buffer.PopData(length, read), Core::ERROR_NONE);
+        EXPECT_EQ(length, sizeof(large));
+        EXPECT_EQ(read[0], 0x22);
+    }
+
+    TEST_F(Core_MessageStaging, FlushedWithoutSettle)
+    {
+        Buffer buffer(_T("stage"), 2, _basePath, 0, true, true);
+        ASSERT_TRUE(buffer.IsValid());
+
+        uint8_t data[4] = { 1, 2, 3, 4 };
+        EXPECT_EQ(buffer.PushData(sizeof(data), data), Core::ERROR_NONE);
+
+        // The flusher moves it on its own, within its latency.
+        uint8_t read[8];
+        uint16_t length = sizeof(read);
+        uint32_t waited = 0;
+
+        while ((buffer.PopData(length, read) != Core::ERROR_NONE) && (waited < 1000)) {
+            SleepMs(1);
+            waited++;
+            length = sizeof(read);
+        }
+
+        EXPECT_EQ(length, sizeof(data));
+        EXPECT_EQ(read[3], 4);
+        EXPECT_LT(waited, 100u);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,153 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+#include <mutex>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        class Element {
+        public:
+            Element(const Element&) = delete;
+            Element& operator=(const Element&) = delete;
+
+            Element()
+                : Value(0)
+            {
+            }
+            ~Element() = default;
+
+        public:
+            void Clear()
+            {
+                Value = 0;
+            }
+
+        public:
+            uint32_t Value;
+        };
+
+    }
+
+    TEST(Core_ProxyPool, ReusesReturnedElements)
+    {
+        Core::ProxyPoolType<Element> pool(2);
+
+        const Element* first;
+        {
+            Core::ProxyType<Element> element(pool.Element());
+            first = &(*element);
+            element->Value = 42;
+        }
+
+        // Cleared on its way back, and the same one is handed out again.
+        Core::ProxyType<Element> element(pool.Element());
+        EXPECT_EQ(&(*element), first);
+        EXPECT_EQ(element->Value, 0u);
+        element.Release();
+
+        Core::ProxyPoolType<Element>::Metadata metadata(pool.Snapshot());
+        EXPECT_EQ(metadata.Created, 2u);
+        EXPECT_EQ(metadata.Queued, 2u);
+        // The first one comes from the depot, the second one from the magazine it was returned to.
+        EXPECT_EQ(metadata.Misses, 1u);
+        EXPECT_EQ(metadata.Hits, 1u);
+    }
+
+    TEST(Core_ProxyPool, KeepsTheHighWater)
+    {
+        Core::ProxyPoolType<Element> pool(1);
+
+        for (uint32_t round = 0; round < 3; round++) {
+            std::vector<Core::ProxyType<Element>> elements;
+
+            for (uint32_t index = 0; index < 20; index++) {
+                elements.push_back(pool.Element());
+            }
+        }
+
+        Core::ProxyPoolType<Element>::Metadata metadata(pool.Snapshot());
+        EXPECT_EQ(metadata.Created, 20u);
+        EXPECT_EQ(metadata.Queued, 20u);
+        EXPECT_EQ(metadata.HighWater, 20u);
+        EXPECT_EQ(metadata.Hits + metadata.Misses, 60u);
+        EXPECT_EQ(pool.CreatedElements(), 20u);
+        EXPECT_EQ(pool.QueuedElements(), 20u);
+    }
+
+    TEST(Core_ProxyPool, HandsOverBetweenThreads)
+    {
+        constexpr uint32_t Threads = 4;
+        constexpr uint32_t Rounds = 20000;
+
+        Core::ProxyPoolType<Element> pool(4);
+        Core::ProxyType<Element> handover[Threads];
+        std::mutex locks[Threads];
+        std::vector<std::thread> threads;
+
+        for (uint32_t thread = 0; thread < Threads; thread++) {
+            threads.emplace_back([&pool, &handover, &locks, thread]() {
+                for (uint32_t round = 0; round < Rounds; round++) {
+                    Core::ProxyType<Element> element(pool.Element());
+
+                    EXPECT_EQ(element->Value, 0u);
+                    element->Value = round + 1;
+
+                    // Every now and then, leave it to the next thread to return it.
+                    if ((round % 7) == 0) {
+                        std::lock_guard<std::mutex> guard(locks[(thread + 1) % Threads]);
+                        handover[(thread + 1) % Threads] = element;
+                    }
+                    if ((round % 11) == 0) {
+                        std::lock_guard<std::mutex> guard(locks[thread]);
+                        if (handover[thread].IsValid() == true) {
+                            handover[thread].Release();
+                        }
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (Core::ProxyType<Element>& element : handover) {
+            if (element.IsValid() == true) {
+                element.Release();
+            }
+        }
+
+        Core::ProxyPoolType<Element>::Metadata metadata(pool.Snapshot());
+        EXPECT_EQ(metadata.Queued, metadata.Created);
+        EXPECT_EQ(metadata.Hits + metadata.Misses, Threads * Rounds);
+        EXPECT_LE(metadata.HighWater, metadata.Created);
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,279 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        // A pipe, readable as soon as something is written into it. When handled for the
+        // first time, it waits for its partner to be handled as well and then acts.
+        class Pipe : public Core::IResource {
+        public:
+            Pipe(const Pipe&) = delete;
+            Pipe& operator=(const Pipe&) = delete;
+
+            Pipe(std::atomic<uint8_t>& arrived)
+                : _arrived(arrived)
+                , _action()
+                , _done(false)
+                , _handled(false)
+            {
+                int result = ::pipe(_descriptors);
+                ASSERT(result == 0); DEBUG_VARIABLE(result);
+            }
+            ~Pipe() override
+            {
+                ::close(_descriptors[0]);
+                ::close(_descriptors[1]);
+            }
+
+        public:
+            void Action(const std::function<void()>& action)
+            {
+                _action = action;
+            }
+            void Trigger()
+            {
+                const char value = 'x';
+                ssize_t VARIABLE_IS_NOT_USED length = ::write(_descriptors[1], &value, sizeof(value));
+            }
+            bool Done() const
+            {
+                return (_done.load());
+            }
+
+            handle Descriptor() const override
+            {
+                return (_descriptors[0]);
+            }
+            uint16_t Events() override
+            {
+                return (POLLIN);
+            }
+            void Handle(const uint16_t events) override
+            {
+                if ((events & POLLIN) != 0) {
+                    char buffer[16];
+                    ssize_t VARIABLE_IS_NOT_USED length = ::read(_descriptors[0], buffer, sizeof(buffer));
+
+                    if (_handled == false) {
+                        _handled = true;
+
+                        // Make sure both reactors are handling a resource before we act.
+                        _arrived++;
+                        uint32_t spins = 0;
+                        while ((_arrived.load() < 2) && (spins++ < 1000)) {
+                            SleepMs(1);
+                        }
+
+                        if (_action) {
+                            _action();
+                        }
+                        _done = true;
+                    }
+                }
+            }
+
+        private:
+            int _descriptors[2];
+            std::atomic<uint8_t>& _arrived;
+            std::function<void()> _action;
+            std::atomic<bool> _done;
+            bool _handled;
+        };
+
+        // Only counts how often it is handled, nothing is ever reported for it.
+        class Idle : public Core::IResource {
+        public:
+            Idle(const Idle&) = delete;
+            Idle& operator=(const Idle&) = delete;
+
+            Idle()
+                : _handled(0)
+            {
+                int result = ::pipe(_descriptors);
+                ASSERT(result == 0); DEBUG_VARIABLE(result);
+            }
+            ~Idle() override
+            {
+                ::close(_descriptors[0]);
+                ::close(_descriptors[1]);
+            }
+
+        public:
+            uint32_t Handled() const
+            {
+                return (_handled.load());
+            }
+
+            handle Descriptor() const override
+            {
+                return (_descriptors[0]);
+            }
+            uint16_t Events() override
+            {
+                return (POLLIN);
+            }
+            void Handle(const uint16_t) override
+            {
+                _handled++;
+            }
+
+        private:
+            int _descriptors[2];
+            std::atomic<uint32_t> _handled;
+        };
+
+        bool WaitFor(const Pipe& pipe)
+        {
+            uint32_t spins = 0;
+            while ((pipe.Done() == false) && (spins++ < 5000)) {
+                SleepMs(1);
+            }
+            return (pipe.Done());
+        }
+    }
+
+    TEST(Core_ResourceMonitor, CrossReactorRegistration)
+    {
+        {
+            Core::ResourceMonitor& monitor = Core::ResourceMonitor::Instance();
+            monitor.Reactors(2);
+
+            std::atomic<uint8_t> arrived(0);
+            Pipe idle(arrived), kept(arrived), spare(arrived), first(arrived), second(arrived), accepted(arrived);
+
+            // Resources go to the least loaded reactor. Get idle, kept and first on reactor 0 and only second
+            // on reactor 1, so the next one goes to reactor 1, also once idle is gone.
+            monitor.Register(idle);
+            monitor.Register(second);
+            monitor.Register(kept);
+            monitor.Register(spare);
+            monitor.Register(first);
+            monitor.Unregister(spare);
+
+            Core::ResourceMonitor::Metadata info;
+            uint8_t reactor[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+            for (uint32_t index = 0; monitor.Info(index, info) == true; index++) {
+                if (info.descriptor == idle.Descriptor()) { reactor[0] = info.reactor; }
+                else if (info.descriptor == kept.Descriptor()) { reactor[1] = info.reactor; }
+                else if (info.descriptor == first.Descriptor()) { reactor[2] = info.reactor; }
+                else if (info.descriptor == second.Descriptor()) { reactor[3] = info.reactor; }
+            }
+            EXPECT_EQ(reactor[0], 0);
+            EXPECT_EQ(reactor[1], 0);
+            EXPECT_EQ(reactor[2], 0);
+            EXPECT_EQ(reactor[3], 1);
+
+            // While both reactors hold their own lock, each one (un)registers on the other reactor.
+            first.Action([&monitor, &accepted]() { monitor.Register(accepted); });
+            second.Action([&monitor, &idle]() { monitor.Unregister(idle); });
+
+            first.Trigger();
+            second.Trigger();
+
+            EXPECT_TRUE(WaitFor(first));
+            EXPECT_TRUE(WaitFor(second));
+
+            // A reactor drops the unregistered entries from its list on its next run.
+            uint32_t spins = 0;
+            while (((monitor.Count(0) != 2) || (monitor.Count(1) != 2)) && (spins++ < 5000)) {
+                SleepMs(1);
+            }
+            EXPECT_EQ(monitor.Count(0), 2u);
+            EXPECT_EQ(monitor.Count(1), 2u);
+
+            bool found = false;
+            for (uint32_t index = 0; monitor.Info(index, info) == true; index++) {
+                if (info.descriptor == accepted.Descriptor()) {
+                    found = true;
+                    EXPECT_EQ(info.reactor, 1);
+                }
+            }
+            EXPECT_TRUE(found);
+
+            monitor.Unregister(accepted);
+            monitor.Unregister(first);
+            monitor.Unregister(second);
+            monitor.Unregister(kept);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_ResourceMonitor, BreakResource)
+    {
+        {
+            Core::ResourceMonitor& monitor = Core::ResourceMonitor::Instance();
+
+            Idle first, second;
+
+            monitor.Register(first);
+            monitor.Register(second);
+
+            // Let the reactor settle on both registrations.
+            SleepMs(100);
+
+            uint32_t handled = second.Handled();
+            uint32_t count = first.Handled();
+
+            monitor.Break(first);
+
+            uint32_t spins = 0;
+            while ((first.Handled() == count) && (spins++ < 5000)) {
+                SleepMs(1);
+            }
+            SleepMs(100);
+
+            EXPECT_EQ(first.Handled(), count + 1);
+
+#ifdef __RESOURCE_MONITOR_EPOLL__
+            // The epoll reactor knows who to handle, the poll reactor offers all resources a chance.
+            EXPECT_EQ(second.Handled(), handled);
+#endif
+
+            // A plain break offers all of them a chance.
+            handled = second.Handled();
+            count = first.Handled();
+            monitor.Break();
+
+            spins = 0;
+            while (((first.Handled() == count) || (second.Handled() == handled)) && (spins++ < 5000)) {
+                SleepMs(1);
+            }
+
+            EXPECT_EQ(first.Handled(), count + 1);
+            EXPECT_EQ(second.Handled(), handled + 1);
+
+            monitor.Unregister(first);
+            monitor.Unregister(second);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
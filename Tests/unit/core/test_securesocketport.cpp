@@ -0,0 +1,417 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <csignal>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+#include <core/core.h>
+#include <cryptalgo/cryptalgo.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        constexpr uint16_t Port = 12483;
+
+        // A plain OpenSSL server on the loopback, with a self signed certificate made on the spot. Every
+        // message, 8 bytes of length followed by that much data, is acknowledged with a single byte.
+        class Server {
+        public:
+            Server(const Server&) = delete;
+            Server& operator=(const Server&) = delete;
+
+            Server()
+                : _context(nullptr)
+                , _listener(-1)
+                , _thread()
+            {
+            }
+            ~Server()
+            {
+                if (_listener != -1) {
+                    ::shutdown(_listener, SHUT_RDWR);
+
+                    if (_thread.joinable() == true) {
+                        _thread.join();
+                    }
+
+                    ::close(_listener);
+                }
+                if (_context != nullptr) {
+                    SSL_CTX_free(_context);
+                }
+            }
+
+        public:
+            bool Start(const uint16_t port)
+            {
+                EVP_PKEY* key = Key();
+                X509* certificate = (key != nullptr ? Certificate(key) : nullptr);
+
+                _context = SSL_CTX_new(TLS_server_method());
+
+                bool result = ((_context != nullptr) && (certificate != nullptr) && (SSL_CTX_use_certificate(_context, certificate) == 1) && (SSL_CTX_use_PrivateKey(_context, key) == 1));
+
+                X509_free(certificate);
+                EVP_PKEY_free(key);
+
+                if (result == true) {
+                    struct sockaddr_in address;
+                    const int reuse = 1;
+
+                    ::memset(&address, 0, sizeof(address));
+                    address.sin_family = AF_INET;
+                    address.sin_port = htons(port);
+                    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+                    _listener = ::socket(AF_INET, SOCK_STREAM, 0);
+                    ::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+                    result = ((::bind(_listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == 0) && (::listen(_listener, 4) == 0));
+
+                    if (result == true) {
+                        _thread = std::thread(&Server::Serve, this);
+                    }
+                }
+
+                return (result);
+            }
+
+        private:
+            static EVP_PKEY* Key()
+            {
+                EVP_PKEY* result = nullptr;
+                EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+
+                if (context != nullptr) {
+                    if ((EVP_PKEY_keygen_init(context) == 1) && (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(context, NID_X9_62_prime256v1) == 1)) {
+                        EVP_PKEY_keygen(context, &result);
+                    }
+
+                    EVP_PKEY_CTX_free(context);
+                }
+
+                return (result);
+            }
+            static X509* Certificate(EVP_PKEY* key)
+            {
+                X509* result = X509_new();
+                X509_NAME* name = X509_get_subject_name(result);
+
+                X509_set_version(result, 2);
+                ASN1_INTEGER_set(X509_get_serialNumber(result), 1);
+                X509_gmtime_adj(X509_getm_notBefore(result), 0);
+                X509_gmtime_adj(X509_getm_notAfter(result), 24 * 60 * 60);
+                X509_set_pubkey(result, key);
+                X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+                X509_set_issuer_name(result, name);
+
+                if (X509_sign(result, key, EVP_sha256()) == 0) {
+                    X509_free(result);
+                    result = nullptr;
+                }
+
+                return (result);
+            }
+            void Serve()
+            {
+                // A client that is gone, should give an error on this thread, not end the process.
+                sigset_t signals;
+                sigemptyset(&signals);
+                sigaddset(&signals, SIGPIPE);
+                pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+                int connection;
+
+                while ((connection = ::accept(_listener, nullptr, nullptr)) >= 0) {
+                    SSL* ssl = SSL_new(_context);
+
+                    SSL_set_fd(ssl, connection);
+
+                    if (SSL_accept(ssl) == 1) {
+                        Messages(ssl);
+                        SSL_shutdown(ssl);
+                    }
+
+                    SSL_free(ssl);
+                    ::close(connection);
+                }
+            }
+            void Messages(SSL* ssl)
+            {
+                uint8_t buffer[16 * 1024];
+                const uint8_t acknowledge = 1;
+                uint8_t header[8];
+                int size = 0;
+
+                while ((size = SSL_read(ssl, header, sizeof(header))) == static_cast<int>(sizeof(header))) {
+                    uint64_t length = 0;
+
+                    for (uint8_t index = 0; index < sizeof(header); index++) {
+                        length = (length << 8) | header[index];
+                    }
+
+                    while (length != 0) {
+                        size = SSL_read(ssl, buffer, static_cast<int>(std::min(length, static_cast<uint64_t>(sizeof(buffer)))));
+
+                        if (size <= 0) {
+                            return;
+                        }
+
+                        length -= size;
+                    }
+
+                    if (SSL_write(ssl, &acknowledge, 1) != 1) {
+                        break;
+                    }
+                }
+            }
+
+        private:
+            SSL_CTX* _context;
+            int _listener;
+            std::thread _thread;
+        };
+
+        // It is our own server, with a self signed certificate.
+        class Trusting : public Crypto::SecureSocketPort::IValidator {
+        public:
+            bool Validate(const Crypto::SecureSocketPort::Certificate&) const override
+            {
+                return (true);
+            }
+        };
+
+        // Sends a message from the send buffer, or a file, and waits for it to be acknowledged.
+        class Client : public Crypto::SecureSocketPort {
+        public:
+            Client() = delete;
+            Client(const Client&) = delete;
+            Client& operator=(const Client&) = delete;
+
+            Client(const Core::NodeId& remoteNode)
+                : Crypto::SecureSocketPort(Core::SocketPort::STREAM, remoteNode.AnyInterface(), remoteNode, 4096, 1024)
+                , _adminLock()
+                , _connected(false, true)
+                , _acknowledged(false, true)
+                , _message()
+                , _offset(0)
+                , _file(0)
+                , _fileSize(0)
+            {
+                Callback(&_validator);
+            }
+            ~Client() override
+            {
+                Close(Core::infinite);
+                Callback(nullptr);
+            }
+
+        public:
+            bool Connect()
+            {
+                const uint32_t result = Open(0);
+
+                return (((result == Core::ERROR_NONE) || (result == Core::ERROR_INPROGRESS)) && (_connected.Lock(5000) == Core::ERROR_NONE));
+            }
+            bool Transfer(const string& message)
+            {
+                return (Transfer(message, 0, 0));
+            }
+            bool Transfer(const Core::File::Handle file, const uint32_t size)
+            {
+                return (Transfer(string(), file, size));
+            }
+
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
+            {
+                _adminLock.Lock();
+
+                const uint32_t result = std::min(maxSendSize, static_cast<uint32_t>(_message.length() - _offset));
+                ::memcpy(dataFrame, &(_message[_offset]), result);
+                _offset += result;
+
+                _adminLock.Unlock();
+
+                return (result);
+            }
+            uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+            {
+                _acknowledged.SetEvent();
+
+                return (receivedSize);
+            }
+            bool SendFile(Core::SocketPort::Region& region) override
+            {
+                bool result = false;
+
+                _adminLock.Lock();
+
+                if ((_offset == _message.length()) && (_fileSize != 0)) {
+                    region.Descriptor = _file;
+                    region.Offset = 0;
+                    region.Size = _fileSize;
+                    _fileSize = 0;
+                    result = true;
+                }
+
+                _adminLock.Unlock();
+
+                return (result);
+            }
+            void StateChange() override
+            {
+                if (IsOpen() == true) {
+                    _connected.SetEvent();
+                }
+            }
+
+        private:
+            bool Transfer(const string& payload, const Core::File::Handle file, const uint32_t fileSize)
+            {
+                const uint64_t total = payload.length() + fileSize;
+
+                _adminLock.Lock();
+
+                _message.clear();
+                for (uint8_t index = 0; index < 8; index++) {
+                    _message.push_back(static_cast<char>(total >> (56 - (8 * index))));
+                }
+                _message += payload;
+                _offset = 0;
+                _file = file;
+                _fileSize = fileSize;
+                _acknowledged.ResetEvent();
+
+                _adminLock.Unlock();
+
+                Trigger();
+
+                return (_acknowledged.Lock(5000) == Core::ERROR_NONE);
+            }
+
+        private:
+            Core::CriticalSection _adminLock;
+            Core::Event _connected;
+            Core::Event _acknowledged;
+            std::string _message;
+            uint32_t _offset;
+            Core::File::Handle _file;
+            uint32_t _fileSize;
+            static Trusting _validator;
+        };
+
+        /* static */ Trusting Client::_validator;
+    }
+
+    TEST(Core_SecureSocketPort, SessionResumed)
+    {
+        {
+            Server server;
+            ASSERT_TRUE(server.Start(Port));
+
+            const Core::NodeId node(_T("127.0.0.1"), Port);
+
+            for (uint8_t index = 0; index < 2; index++) {
+                Client client(node);
+                client.SessionResumption(true);
+
+                ASSERT_TRUE(client.Connect());
+
+                // The session tickets follow the handshake, the answer to a message makes sure they are in.
+                EXPECT_TRUE(client.Transfer(_T("Hello")));
+
+                // The second connection picks up the session of the first one.
+                EXPECT_EQ(client.IsResumed(), (index != 0));
+
+                client.Close(Core::infinite);
+            }
+
+            // Without resumption, a connection to the same server does not offer the session.
+            Client client(node);
+            client.SessionResumption(false);
+
+            ASSERT_TRUE(client.Connect());
+            EXPECT_TRUE(client.Transfer(_T("Hello")));
+            EXPECT_FALSE(client.IsResumed());
+
+            client.Close(Core::infinite);
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SecureSocketPort, KernelOffload)
+    {
+        {
+            Server server;
+            ASSERT_TRUE(server.Start(Port + 1));
+
+            const string fileName(_T("/tmp/securesocketport.bin"));
+            const uint32_t fileSize = (256 * 1024);
+            {
+                Core::File file(fileName);
+                ASSERT_TRUE(file.Create());
+
+                uint8_t block[4096];
+                for (uint32_t offset = 0; offset < fileSize; offset += sizeof(block)) {
+                    ::memset(block, static_cast<uint8_t>(offset / sizeof(block)), sizeof(block));
+                    ASSERT_EQ(file.Write(block, sizeof(block)), sizeof(block));
+                }
+            }
+
+            Core::File file(fileName);
+            ASSERT_TRUE(file.Open(true));
+
+            Client client(Core::NodeId(_T("127.0.0.1"), Port + 1));
+            client.KernelOffload(true);
+
+            ASSERT_TRUE(client.Connect());
+
+            // With or without the kernel doing the encryption (the tls module might not be there), a file and
+            // data from the send buffer, before and after it, end up at the other side.
+            EXPECT_TRUE(client.Transfer(_T("Before")));
+            EXPECT_TRUE(client.Transfer(file, fileSize));
+            EXPECT_TRUE(client.Transfer(_T("After")));
+
+            if (client.IsOffloaded() == false) {
+                printf("kTLS is not available, the file went through the send buffer.\n");
+            }
+
+            client.Close(Core::infinite);
+            file.Destroy();
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
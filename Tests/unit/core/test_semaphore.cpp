@@ -79,6 +79,88 @@ TEST(test_criticalsection, simple_criticalsection)
     EXPECT_EQ(g_shared,2);
 }
 
+TEST(test_criticalsection, recursive_criticalsection)
+{
+    Core::CriticalSection lock;
+    std::vector<std::thread> threads;
+    uint32_t counter = 0;
+
+    for (uint8_t index = 0; index < 4; index++) {
+        threads.emplace_back([&lock, &counter]() {
+            for (uint32_t round = 0; round < 100000; round++) {
+                lock.Lock();
+                lock.Lock();
+                counter++;
+                lock.Unlock();
+                counter++;
+                lock.Unlock();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(counter, 800000u);
+}
+
+#ifdef __CORE_CRITICAL_SECTION_FUTEX__
+TEST(test_criticalsection, named_criticalsection)
+{
+    std::list<Core::CriticalSection::Metadata> locks;
+
+    {
+        Core::CriticalSection first(_T("test::named"));
+        Core::CriticalSection second(_T("test::named"));
+        std::atomic<bool> holding(false);
+
+        for (uint16_t round = 0; round < Core::CriticalSection::HoldSampling; round++) {
+            first.Lock();
+            first.Unlock();
+        }
+
+        // Keep it long enough for the other thread to give up spinning.
+        std::thread thread([&second, &holding]() {
+            second.Lock();
+            holding = true;
+            ::SleepMs(50);
+            second.Unlock();
+        });
+
+        while (holding == false) {
+            std::this_thread::yield();
+        }
+
+        second.Lock();
+        second.Unlock();
+        thread.join();
+
+        Core::CriticalSection::Snapshot(locks);
+    }
+
+    std::list<Core::CriticalSection::Metadata>::const_iterator index(locks.begin());
+    while ((index != locks.end()) && (index->Name != _T("test::named"))) {
+        index++;
+    }
+
+    ASSERT_NE(index, locks.end());
+    EXPECT_EQ(index->Instances, 2u);
+    EXPECT_EQ(index->Locks, Core::CriticalSection::HoldSampling + 2u);
+    EXPECT_EQ(index->Contended, 1u);
+    EXPECT_GE(index->MaxWaitTime, 10000u);
+    EXPECT_LE(index->MaxWaitTime, index->WaitTime);
+    EXPECT_EQ(index->HoldSamples, 1u);
+
+    // Gone with the locks.
+    locks.clear();
+    Core::CriticalSection::Snapshot(locks);
+    for (const Core::CriticalSection::Metadata& entry : locks) {
+        EXPECT_NE(entry.Name, _T("test::named"));
+    }
+}
+#endif
+
 TEST(test_binairysemaphore, simple_binairysemaphore_timeout)
 {
     BinairySemaphore bsem(true);
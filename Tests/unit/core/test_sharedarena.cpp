@@ -0,0 +1,232 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <com/com.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    // Moves the output frame through a buffer, the way the socket would.
+    static void Transfer(const RPC::Data::Output& source, RPC::Data::Output& destination)
+    {
+        uint8_t buffer[512];
+        uint32_t offset = 0;
+
+        while (offset < source.Length()) {
+            uint16_t length = source.Serialize(buffer, sizeof(buffer), offset);
+            destination.Deserialize(buffer, length, offset);
+            offset += length;
+        }
+    }
+
+    TEST(Core_SharedArena, AllocateAndRelease)
+    {
+        const string name(_T("/tmp/testsharedarena.allocate"));
+        const uint32_t pages = 16;
+
+        Core::ProxyType<RPC::SharedArena> owner(Core::ProxyType<RPC::SharedArena>::Create(name, pages * RPC::SharedArena::PageSize));
+        ASSERT_TRUE(owner->IsValid());
+
+        Core::ProxyType<RPC::SharedArena> other(Core::ProxyType<RPC::SharedArena>::Create(name));
+        ASSERT_TRUE(other->IsValid());
+        EXPECT_EQ(other->Size(), owner->Size());
+
+        uint32_t first = 0;
+        uint32_t second = 0;
+        uint32_t third = 0;
+
+        uint8_t* block = owner->Allocate(10 * RPC::SharedArena::PageSize, first);
+        ASSERT_NE(block, nullptr);
+        ::memset(block, 0x5A, 10 * RPC::SharedArena::PageSize);
+
+        EXPECT_NE(owner->Allocate(5 * RPC::SharedArena::PageSize, second), nullptr);
+
+        // No room for another 2 pages, until the first block is handed back.
+        EXPECT_EQ(owner->Allocate(2 * RPC::SharedArena::PageSize, third), nullptr);
+
+        const uint8_t* shared = other->Block(first, 10 * RPC::SharedArena::PageSize);
+        ASSERT_NE(shared, nullptr);
+        EXPECT_EQ(shared[0], 0x5A);
+        EXPECT_EQ(shared[(10 * RPC::SharedArena::PageSize) - 1], 0x5A);
+
+        // Only what was allocated, can be found.
+        EXPECT_EQ(other->Block(first + RPC::SharedArena::PageSize, RPC::SharedArena::PageSize), nullptr);
+        EXPECT_EQ(other->Block(first, 11 * RPC::SharedArena::PageSize), nullptr);
+
+        other->Release(first, 10 * RPC::SharedArena::PageSize);
+
+        EXPECT_NE(owner->Allocate(2 * RPC::SharedArena::PageSize, third), nullptr);
+        EXPECT_EQ(third, first);
+
+        other.Release();
+        owner.Release();
+
+        EXPECT_FALSE(Core::File(name).Exists());
+    }
+
+    TEST(Core_SharedArena, OfferedName)
+    {
+        const string connector(_T("/tmp/communicator"));
+        const string offer(RPC::SharedArena::Offer(connector, 1234, 7));
+
+        EXPECT_EQ(offer, _T("/tmp/communicator.1234.7.client"));
+        EXPECT_EQ(RPC::SharedArena::Offered(connector, offer), offer);
+
+        // Anything that is not a process and sequence number of a client of this connector, is refused.
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/communicator./../../etc/passwd")).empty());
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/communicator.1234.7.client/../../etc/passwd")).empty());
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/communicator.1234.7.server")).empty());
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/communicator.1234..client")).empty());
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/communicator.01234.7.client")).empty());
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/communicator.99999999999.7.client")).empty());
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/other.1234.7.client")).empty());
+        EXPECT_TRUE(RPC::SharedArena::Offered(connector, _T("/tmp/communicator")).empty());
+    }
+
+    TEST(Core_SharedArena, FrameTravelsThroughArena)
+    {
+        const string name(_T("/tmp/testsharedarena.frame"));
+
+        Core::ProxyType<RPC::SharedArena> owner(Core::ProxyType<RPC::SharedArena>::Create(name, 256 * 1024));
+        Core::ProxyType<RPC::SharedArena> other(Core::ProxyType<RPC::SharedArena>::Create(name));
+        ASSERT_TRUE(owner->IsValid());
+        ASSERT_TRUE(other->IsValid());
+
+        std::vector<uint8_t> payload(100 * 1024);
+        for (uint32_t index = 0; index < payload.size(); index++) {
+            payload[index] = static_cast<uint8_t>(index * 7);
+        }
+
+        RPC::Data::Output sent;
+        RPC::Data::Output received;
+
+        RPC::Data::Frame::Writer writer(sent.Writer());
+        writer.Number<uint32_t>(42);
+        writer.Buffer<uint32_t>(static_cast<uint32_t>(payload.size()), payload.data());
+        const uint32_t length = sent.Length();
+
+        sent.Share(*owner);
+
+        // Only the handle goes over the socket.
+        EXPECT_LT(sent.Length(), 16u);
+
+        Transfer(sent, received);
+        EXPECT_TRUE(received.Resolve(other));
+        EXPECT_EQ(received.Length(), length);
+
+        RPC::Data::Frame::Reader reader(received.Reader());
+        EXPECT_EQ(reader.Number<uint32_t>(), 42u);
+
+        const uint8_t* data = nullptr;
+        uint32_t size = reader.LockBuffer<uint32_t>(data);
+        ASSERT_EQ(size, payload.size());
+        EXPECT_EQ(::memcmp(data, payload.data(), size), 0);
+
+        // Read in place, straight from the arena.
+        EXPECT_GE(data, other->Block(0, length));
+        reader.UnlockBuffer(size);
+
+        // Once the frame is cleared, the owner can reuse the room.
+        uint32_t offset = 0;
+        EXPECT_EQ(owner->Allocate(200 * 1024, offset), nullptr);
+        received.Clear();
+        EXPECT_NE(owner->Allocate(200 * 1024, offset), nullptr);
+    }
+
+    TEST(Core_SharedArena, AttachedFrameIsNotTrusted)
+    {
+        const string name(_T("/tmp/testsharedarena.attached"));
+
+        Core::ProxyType<RPC::SharedArena> owner(Core::ProxyType<RPC::SharedArena>::Create(name, 256 * 1024));
+        Core::ProxyType<RPC::SharedArena> other(Core::ProxyType<RPC::SharedArena>::Create(name));
+        ASSERT_TRUE(owner->IsValid());
+        ASSERT_TRUE(other->IsValid());
+
+        std::vector<uint8_t> payload(20 * 1024, 0x33);
+
+        RPC::Data::Output sent;
+        RPC::Data::Output received;
+
+        RPC::Data::Frame::Writer writer(sent.Writer());
+        writer.Number<uint32_t>(42);
+        writer.Buffer<uint32_t>(static_cast<uint32_t>(payload.size()), payload.data());
+        const uint32_t length = sent.Length();
+
+        sent.Share(*owner);
+        Transfer(sent, received);
+        ASSERT_TRUE(received.Resolve(other));
+
+        const uint8_t* block = other->Block(0, length);
+        ASSERT_NE(block, nullptr);
+        uint8_t* shared = const_cast<uint8_t*>(block);
+
+        // The other side makes the length of the buffer larger than the frame, after it was sent.
+        shared[4] = 0xFF;
+        shared[5] = 0xFF;
+        shared[6] = 0xFF;
+        shared[7] = 0xFF;
+
+        RPC::Data::Frame::Reader reader(received.Reader());
+        EXPECT_EQ(reader.Number<uint32_t>(), 42u);
+
+        const uint8_t* data = nullptr;
+        EXPECT_EQ(reader.LockBuffer<uint32_t>(data), payload.size());
+        reader.UnlockBuffer(static_cast<uint32_t>(payload.size()));
+
+        // Writing, also within the size of the frame, never goes into the shared pages.
+        uint8_t before[4];
+        ::memcpy(before, block, sizeof(before));
+
+        RPC::Data::Frame::Writer overwrite(received.Writer());
+        overwrite.Number<uint32_t>(7);
+
+        EXPECT_EQ(received.Reader().Number<uint32_t>(), 7u);
+        EXPECT_EQ(::memcmp(before, block, sizeof(before)), 0);
+        EXPECT_EQ(block[8], 0x33);
+    }
+
+    TEST(Core_SharedArena, SmallFrameStaysInline)
+    {
+        const string name(_T("/tmp/testsharedarena.inline"));
+
+        Core::ProxyType<RPC::SharedArena> owner(Core::ProxyType<RPC::SharedArena>::Create(name, 64 * 1024));
+        Core::ProxyType<RPC::SharedArena> other(Core::ProxyType<RPC::SharedArena>::Create(name));
+
+        RPC::Data::Output sent;
+        RPC::Data::Output received;
+
+        sent.Writer().Text(_T("Hello World"));
+        const uint32_t length = sent.Length();
+
+        sent.Share(*owner);
+        EXPECT_EQ(sent.Length(), length + 1);
+
+        Transfer(sent, received);
+        EXPECT_TRUE(received.Resolve(other));
+        EXPECT_EQ(received.Length(), length);
+        EXPECT_EQ(received.Reader().Text(), _T("Hello World"));
+    }
+
+} // Tests
+} // WPEFramework
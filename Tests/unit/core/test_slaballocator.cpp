@@ -0,0 +1,223 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+#include <mutex>
+#include <thread>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        class Arena {
+        public:
+            Arena(const Arena&) = delete;
+            Arena& operator=(const Arena&) = delete;
+
+            Arena()
+                : Value(0)
+            {
+            }
+            ~Arena() = default;
+
+        public:
+            uint64_t Value;
+        };
+
+    }
+
+} // Tests
+
+namespace Core {
+
+    template <>
+    struct ProxyAllocatorType<Tests::Arena> : public ProxyArenaType<Tests::Arena> {
+    };
+
+} // Core
+
+namespace Tests {
+
+    TEST(Core_SlabAllocator, SizeClasses)
+    {
+        for (uint16_t size = 1; size <= Core::SlabAllocator::Largest; size++) {
+            const uint8_t index = Core::SlabAllocator::Class(size);
+
+            ASSERT_LT(index, Core::SlabAllocator::Classes);
+            EXPECT_GE(Core::SlabAllocator::Size(index), size);
+            if (index != 0) {
+                EXPECT_LT(Core::SlabAllocator::Size(index - 1), size);
+            }
+            EXPECT_EQ(Core::SlabAllocator::Size(index) % 16, 0);
+        }
+
+        EXPECT_EQ(Core::SlabAllocator::Size(Core::SlabAllocator::Classes - 1), Core::SlabAllocator::Largest);
+    }
+
+    TEST(Core_SlabAllocator, AllocateAndFree)
+    {
+        Core::SlabAllocator arena(_T("test"));
+        Core::SlabAllocator::Metadata metadata;
+        std::vector<uint8_t*> blocks;
+
+        for (uint32_t index = 0; index < 2000; index++) {
+            uint8_t* block = static_cast<uint8_t*>(arena.Allocate(100));
+            ASSERT_NE(block, nullptr);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % 16, 0u);
+            ::memset(block, static_cast<int>(index), 100);
+            blocks.push_back(block);
+        }
+        for (uint32_t index = 0; index < blocks.size(); index++) {
+            EXPECT_EQ(blocks[index][0], static_cast<uint8_t>(index));
+            EXPECT_EQ(blocks[index][99], static_cast<uint8_t>(index));
+        }
+
+        arena.Snapshot(metadata);
+        const Core::SlabAllocator::Metadata::Class& entry(metadata.Classes[Core::SlabAllocator::Class(100)]);
+        EXPECT_EQ(metadata.Name, _T("test"));
+        EXPECT_EQ(entry.Size, 112u);
+        EXPECT_EQ(entry.Objects, 2000u);
+        EXPECT_EQ(entry.Slabs, 4u);
+        EXPECT_EQ(metadata.Used, 2000u * 112u);
+        EXPECT_EQ(metadata.Reserved, 4u * Core::SlabAllocator::SlabSize);
+        EXPECT_LT(metadata.Fragmentation, 20);
+
+        for (uint8_t* block : blocks) {
+            arena.Free(block, 100);
+        }
+
+        // The empty slabs are given back, but for a spare one and the one of the blocks this thread keeps.
+        arena.Snapshot(metadata);
+        EXPECT_EQ(metadata.Classes[Core::SlabAllocator::Class(100)].Objects, 0u);
+        EXPECT_LE(metadata.Classes[Core::SlabAllocator::Class(100)].Slabs, 2u);
+        EXPECT_EQ(metadata.Used, 0u);
+    }
+
+    TEST(Core_SlabAllocator, LargeBlocksGoToTheHeap)
+    {
+        Core::SlabAllocator arena(_T("large"));
+        Core::SlabAllocator::Metadata metadata;
+
+        void* block = arena.Allocate(Core::SlabAllocator::Largest + 1);
+        ASSERT_NE(block, nullptr);
+
+        arena.Snapshot(metadata);
+        EXPECT_EQ(metadata.Large, 1u);
+        EXPECT_EQ(metadata.LargeBytes, Core::SlabAllocator::Largest + 1u);
+        EXPECT_EQ(metadata.Reserved, 0u);
+
+        arena.Free(block, Core::SlabAllocator::Largest + 1);
+
+        arena.Snapshot(metadata);
+        EXPECT_EQ(metadata.Large, 0u);
+        EXPECT_EQ(metadata.LargeBytes, 0u);
+    }
+
+    TEST(Core_SlabAllocator, ProxyTypeInArenaOfItsOwn)
+    {
+        Core::SlabAllocator::Metadata metadata;
+
+        {
+            Core::ProxyType<Arena> plain(Core::ProxyType<Arena>::Create());
+            Core::ProxyType<Arena> extended(Core::ProxyType<Arena>::CreateEx(200));
+
+            plain->Value = 1;
+            extended->Value = 2;
+            EXPECT_EQ(plain.Origin()->Size(), 0u);
+            EXPECT_EQ(extended.Origin()->Size(), 200u);
+
+            Core::ProxyAllocatorType<Arena>::Arena().Snapshot(metadata);
+
+            uint32_t objects = 0;
+            for (const Core::SlabAllocator::Metadata::Class& entry : metadata.Classes) {
+                objects += entry.Objects;
+            }
+            EXPECT_EQ(objects, 2u);
+        }
+
+        Core::ProxyAllocatorType<Arena>::Arena().Snapshot(metadata);
+        EXPECT_EQ(metadata.Used, 0u);
+    }
+
+    TEST(Core_SlabAllocator, FreedOnOtherThreads)
+    {
+        Core::SlabAllocator arena(_T("threads"));
+        constexpr uint32_t Threads = 4;
+        constexpr uint32_t Rounds = 50000;
+
+        std::vector<std::thread> threads;
+        std::mutex lock;
+        std::vector<std::pair<void*, uint16_t>> shared;
+
+        for (uint32_t thread = 0; thread < Threads; thread++) {
+            threads.emplace_back([&arena, &lock, &shared, thread]() {
+                for (uint32_t round = 0; round < Rounds; round++) {
+                    const uint16_t size = static_cast<uint16_t>(16 + (((round * 7919) + thread) % 1000));
+                    void* block = arena.Allocate(size);
+
+                    ASSERT_NE(block, nullptr);
+                    ::memset(block, 0xA5, size);
+
+                    std::pair<void*, uint16_t> other(nullptr, 0);
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        shared.emplace_back(block, size);
+                        if (shared.size() > 64) {
+                            const size_t index = (round % shared.size());
+                            other = shared[index];
+                            shared[index] = shared.back();
+                            shared.pop_back();
+                        }
+                    }
+
+                    if (other.first != nullptr) {
+                        arena.Free(other.first, other.second);
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (const std::pair<void*, uint16_t>& entry : shared) {
+            arena.Free(entry.first, entry.second);
+        }
+
+        // Only this thread still keeps blocks, the others returned theirs when they exited.
+        Core::SlabAllocator::Metadata metadata;
+        arena.Snapshot(metadata);
+        EXPECT_EQ(metadata.Used, 0u);
+
+        uint32_t cached = 0;
+        for (const Core::SlabAllocator::Metadata::Class& entry : metadata.Classes) {
+            cached += entry.Cached;
+        }
+        EXPECT_LE(cached, shared.size());
+    }
+
+} // Tests
+} // WPEFramework
@@ -0,0 +1,164 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+#include <thread>
+
+using namespace WPEFramework;
+using namespace WPEFramework::Core;
+
+namespace {
+
+    class Tracked {
+    public:
+        Tracked(const Tracked&) = delete;
+        Tracked& operator=(const Tracked&) = delete;
+
+        Tracked(std::atomic<bool>& released)
+            : _released(released)
+        {
+        }
+        ~Tracked()
+        {
+            _released = true;
+        }
+
+    private:
+        std::atomic<bool>& _released;
+    };
+
+    using Services = std::map<string, ProxyType<Tracked>>;
+
+    ProxyType<Tracked> Lookup(const SnapshotType<Services>& snapshot, const string& callsign)
+    {
+        ProxyType<Tracked> result;
+        SnapshotType<Services>::Reader services(snapshot);
+
+        Services::const_iterator index(services->find(callsign));
+
+        if (index != services->end()) {
+            result = index->second;
+        }
+
+        return (result);
+    }
+
+}
+
+TEST(Core_Snapshot, ReplaceWithoutReaders)
+{
+    std::atomic<bool> released(false);
+    ProxyType<Tracked> service(ProxyType<Tracked>::Create(released));
+
+    SnapshotType<Services> snapshot(new Services({ { _T("Service"), service } }));
+
+    EXPECT_TRUE(Lookup(snapshot, _T("Service")).IsValid());
+
+    snapshot.Replace(new Services());
+    service.Release();
+
+    EXPECT_EQ(snapshot.Retired(), 0u);
+    EXPECT_TRUE(released);
+    EXPECT_FALSE(Lookup(snapshot, _T("Service")).IsValid());
+}
+
+TEST(Core_Snapshot, NestedReaderKeepsReplacedCopy)
+{
+    std::atomic<bool> released(false);
+    ProxyType<Tracked> service(ProxyType<Tracked>::Create(released));
+
+    SnapshotType<Services> snapshot(new Services({ { _T("Service"), service } }));
+    service.Release();
+
+    {
+        SnapshotType<Services>::Reader outer(snapshot);
+
+        snapshot.Replace(new Services());
+
+        EXPECT_EQ(snapshot.Retired(), 1u);
+        EXPECT_FALSE(released);
+        EXPECT_EQ(outer->size(), 1u);
+
+        {
+            // A nested read keeps the epoch of the outer one, so it does not release what the outer one reads.
+            SnapshotType<Services>::Reader inner(snapshot);
+            EXPECT_EQ(inner->size(), 0u);
+        }
+
+        EXPECT_FALSE(released);
+        EXPECT_EQ(outer->begin()->first, _T("Service"));
+    }
+
+    EXPECT_EQ(snapshot.Retired(), 0u);
+    EXPECT_TRUE(released);
+}
+
+TEST(Core_Snapshot, RemoveWhileReading)
+{
+    constexpr uint8_t Readers = 4;
+
+    std::atomic<bool> released(false);
+    std::atomic<bool> running(true);
+    std::atomic<uint32_t> lookups(0);
+    ProxyType<Tracked> removed(ProxyType<Tracked>::Create(released));
+    std::atomic<bool> other(false);
+    ProxyType<Tracked> remaining(ProxyType<Tracked>::Create(other));
+
+    SnapshotType<Services> snapshot(new Services({ { _T("Removed"), removed }, { _T("Remaining"), remaining } }));
+
+    std::vector<std::thread> readers;
+
+    for (uint8_t index = 0; index < Readers; index++) {
+        readers.emplace_back([&snapshot, &running, &lookups]() {
+            while (running == true) {
+                Lookup(snapshot, _T("Removed"));
+                EXPECT_TRUE(Lookup(snapshot, _T("Remaining")).IsValid());
+                lookups++;
+            }
+        });
+    }
+
+    while (lookups < 1000) {
+        std::this_thread::yield();
+    }
+
+    snapshot.Replace(new Services({ { _T("Remaining"), remaining } }));
+    removed.Release();
+
+    // The readers keep on going, the last one that could have seen the removed service releases it.
+    uint16_t waited = 0;
+    while ((released == false) && (waited < 5000)) {
+        SleepMs(1);
+        waited++;
+    }
+
+    EXPECT_TRUE(released);
+    EXPECT_EQ(snapshot.Retired(), 0u);
+    EXPECT_FALSE(other);
+
+    running = false;
+
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+}
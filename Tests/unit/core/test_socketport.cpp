@@ -0,0 +1,501 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        class Sink : public Core::SocketStream {
+        public:
+            Sink() = delete;
+            Sink(const Sink&) = delete;
+            Sink& operator=(const Sink&) = delete;
+
+            Sink(const SOCKET& connector, const Core::NodeId& remoteId, Core::SocketServerType<Sink>*)
+                : Core::SocketStream(false, connector, remoteId, 1024, 4096)
+            {
+                AdaptiveBuffers(0, _limit);
+            }
+            ~Sink() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            // The receive buffer of the next connections grows up to the limit, 0 keeps it as is.
+            static void Adaptive(const uint32_t limit)
+            {
+                _limit = limit;
+            }
+            static uint32_t Largest()
+            {
+                return (_largest);
+            }
+            static void Expect(const size_t size)
+            {
+                _adminLock.Lock();
+                _received.clear();
+                _expected = size;
+                _largest = 0;
+                _adminLock.Unlock();
+                _complete.ResetEvent();
+            }
+            static bool Wait(string& received)
+            {
+                const bool result = (_complete.Lock(10000) == Core::ERROR_NONE);
+
+                _adminLock.Lock();
+                received = _received;
+                _adminLock.Unlock();
+
+                return (result);
+            }
+
+            uint32_t SendData(uint8_t*, const uint32_t) override
+            {
+                return (0);
+            }
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
+            {
+                _adminLock.Lock();
+                _received.append(reinterpret_cast<const char*>(dataFrame), receivedSize);
+                _largest = std::max(_largest.load(), receivedSize);
+                if (_received.size() >= _expected) {
+                    _complete.SetEvent();
+                }
+                _adminLock.Unlock();
+
+                return (receivedSize);
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            static Core::CriticalSection _adminLock;
+            static Core::Event _complete;
+            static string _received;
+            static size_t _expected;
+            static uint32_t _limit;
+            static std::atomic<uint32_t> _largest;
+        };
+
+        /* static */ Core::CriticalSection Sink::_adminLock;
+        /* static */ Core::Event Sink::_complete(false, true);
+        /* static */ string Sink::_received;
+        /* static */ size_t Sink::_expected = 0;
+        /* static */ uint32_t Sink::_limit = 0;
+        /* static */ std::atomic<uint32_t> Sink::_largest(0);
+
+        // Copies a prefix into the send buffer, and hands over the parts as segments.
+        class Source : public Core::SocketStream {
+        public:
+            Source() = delete;
+            Source(const Source&) = delete;
+            Source& operator=(const Source&) = delete;
+
+            Source(const Core::NodeId& remoteNode, const uint32_t sendBufferSize)
+                : Core::SocketStream(false, remoteNode.AnyInterface(), remoteNode, sendBufferSize, 1024)
+                , _prefix()
+                , _offset(0)
+                , _parts()
+                , _handed(0)
+                , _released(0)
+                , _calls(0)
+                , _largest(0)
+            {
+            }
+            ~Source() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            void Submit(const string& prefix, const std::vector<string>& parts)
+            {
+                Lock();
+                _prefix = prefix;
+                _offset = 0;
+                _parts = parts;
+                _handed = 0;
+                _released = 0;
+                _calls = 0;
+                Unlock();
+
+                Trigger();
+            }
+            uint32_t Released() const
+            {
+                return (_released);
+            }
+            uint32_t Calls() const
+            {
+                return (_calls);
+            }
+            uint32_t Largest() const
+            {
+                return (_largest);
+            }
+
+            // Hands out the prefix in pieces of at most 100 bytes, so it takes several calls to fill the buffer.
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
+            {
+                const uint32_t result = std::min(std::min(maxSendSize, static_cast<uint32_t>(_prefix.size() - _offset)), 100u);
+
+                ::memcpy(dataFrame, &(_prefix[_offset]), result);
+                _offset += result;
+
+                if (result != 0) {
+                    _calls++;
+                    _largest = std::max(_largest.load(), maxSendSize);
+                }
+
+                return (result);
+            }
+            uint8_t SendSegments(Segment segments[], const uint8_t maxSegments) override
+            {
+                uint8_t count = 0;
+
+                while ((count < maxSegments) && (_handed < _parts.size())) {
+                    segments[count].Data = reinterpret_cast<const uint8_t*>(_parts[_handed].data());
+                    segments[count].Size = static_cast<uint32_t>(_parts[_handed].size());
+                    count++;
+                    _handed++;
+                }
+
+                return (count);
+            }
+            void SegmentsSent(const uint8_t count) override
+            {
+                _released += count;
+
+                EXPECT_LE(_released, _handed);
+            }
+            uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+            {
+                return (receivedSize);
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            string _prefix;
+            uint32_t _offset;
+            std::vector<string> _parts;
+            uint32_t _handed;
+            std::atomic<uint32_t> _released;
+            std::atomic<uint32_t> _calls;
+            std::atomic<uint32_t> _largest;
+        };
+
+        // Sends the given number of numbered datagrams in batches, and counts the batches it receives.
+        class Batched : public Core::SocketDatagram {
+        public:
+            Batched() = delete;
+            Batched(const Batched&) = delete;
+            Batched& operator=(const Batched&) = delete;
+
+            Batched(const Core::NodeId& localNode, const Core::NodeId& remoteNode)
+                : Core::SocketDatagram(false, localNode, remoteNode, 1500, 1500, 256 * 1024, 256 * 1024)
+                , _toSend(0)
+                , _sent(0)
+                , _received(0)
+                , _batches(0)
+                , _largest(0)
+                , _inOrder(true)
+                , _expected(~0)
+                , _complete(false, true)
+            {
+                Batch(16);
+            }
+            ~Batched() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            void Submit(const uint32_t count)
+            {
+                Lock();
+                _toSend = count;
+                _sent = 0;
+                Unlock();
+
+                Trigger();
+            }
+            bool Wait(const uint32_t count)
+            {
+                _expected = count;
+
+                return ((_received >= count) || (_complete.Lock(10000) == Core::ERROR_NONE));
+            }
+            uint32_t Received() const
+            {
+                return (_received);
+            }
+            uint32_t Batches() const
+            {
+                return (_batches);
+            }
+            uint16_t Largest() const
+            {
+                return (_largest);
+            }
+            bool InOrder() const
+            {
+                return (_inOrder);
+            }
+
+            uint16_t SendBatch(Datagram datagrams[], const uint16_t slots) override
+            {
+                uint16_t count = 0;
+
+                while ((count < slots) && (_sent < _toSend)) {
+                    ::memcpy(datagrams[count].Data, &_sent, sizeof(_sent));
+                    ::memset(&(datagrams[count].Data[sizeof(_sent)]), 0x5A, 60);
+                    datagrams[count].Size = sizeof(_sent) + 60;
+                    datagrams[count].Remote = RemoteNode();
+                    count++;
+                    _sent++;
+                }
+
+                return (count);
+            }
+            void ReceiveBatch(const Datagram datagrams[], const uint16_t count) override
+            {
+                for (uint16_t index = 0; index < count; index++) {
+                    uint32_t sequence;
+
+                    ::memcpy(&sequence, datagrams[index].Data, sizeof(sequence));
+
+                    if ((datagrams[index].Size != (sizeof(sequence) + 60)) || (sequence != (_received + index))) {
+                        _inOrder = false;
+                    }
+                }
+
+                _received += count;
+                _batches++;
+                _largest = std::max(_largest, count);
+
+                if (_received >= _expected) {
+                    _complete.SetEvent();
+                }
+            }
+            uint32_t SendData(uint8_t*, const uint32_t) override
+            {
+                return (0);
+            }
+            uint32_t ReceiveData(uint8_t*, const uint32_t receivedSize) override
+            {
+                return (receivedSize);
+            }
+            void StateChange() override
+            {
+            }
+
+        private:
+            uint32_t _toSend;
+            uint32_t _sent;
+            std::atomic<uint32_t> _received;
+            std::atomic<uint32_t> _batches;
+            uint16_t _largest;
+            bool _inOrder;
+            std::atomic<uint32_t> _expected;
+            Core::Event _complete;
+        };
+
+    }
+
+    TEST(Core_SocketPort, GathersBufferAndSegments)
+    {
+        const Core::NodeId node(_T("/tmp/wpesocketport0"));
+        Core::SocketServerType<Sink> server(node);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        Source source(node, 1024);
+        ASSERT_EQ(source.Open(Core::infinite), Core::ERROR_NONE);
+
+        const string prefix(350, 'p');
+        const string shared(2000, 's');
+        std::vector<string> parts;
+        string expected(prefix);
+
+        // More segments than go into one call, some of them empty.
+        for (uint8_t index = 0; index < 40; index++) {
+            parts.push_back(string(1, static_cast<char>('A' + (index % 26))));
+            parts.push_back((index % 5) == 0 ? string() : shared);
+            expected += parts[parts.size() - 2] + parts.back();
+        }
+
+        Sink::Expect(expected.size());
+        source.Submit(prefix, parts);
+
+        string received;
+        EXPECT_TRUE(Sink::Wait(received));
+        EXPECT_EQ(received.size(), expected.size());
+        EXPECT_TRUE(received == expected);
+
+        // The prefix was handed out in four pieces.
+        EXPECT_EQ(source.Calls(), 4u);
+        EXPECT_EQ(source.Released(), parts.size());
+
+        source.Close(Core::infinite);
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SocketPort, SendBufferBeyond64KB)
+    {
+        const Core::NodeId node(_T("/tmp/wpesocketport1"));
+        Core::SocketServerType<Sink> server(node);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        Source source(node, 256 * 1024);
+        ASSERT_EQ(source.Open(Core::infinite), Core::ERROR_NONE);
+        EXPECT_EQ(source.SendBufferSize(), 256u * 1024u);
+
+        string prefix(200 * 1024, ' ');
+        for (uint32_t index = 0; index < prefix.size(); index++) {
+            prefix[index] = static_cast<char>(index * 7);
+        }
+
+        Sink::Expect(prefix.size());
+        source.Submit(prefix, std::vector<string>());
+
+        string received;
+        EXPECT_TRUE(Sink::Wait(received));
+        EXPECT_TRUE(received == prefix);
+
+        source.Close(Core::infinite);
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SocketPort, AdaptiveBuffers)
+    {
+        const Core::NodeId node(_T("/tmp/wpesocketport2"));
+        Core::SocketServerType<Sink> server(node);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        Sink::Adaptive(64 * 1024);
+
+        Source source(node, 1024);
+        source.AdaptiveBuffers(32 * 1024, 0);
+        ASSERT_EQ(source.Open(Core::infinite), Core::ERROR_NONE);
+
+        const string prefix(1024 * 1024, 'b');
+
+        Sink::Expect(prefix.size());
+        source.Submit(prefix, std::vector<string>());
+
+        string received;
+        EXPECT_TRUE(Sink::Wait(received));
+        EXPECT_TRUE(received == prefix);
+
+        // The buffers grew while the transfer was going on, but not beyond their limit.
+        EXPECT_EQ(source.Largest(), 32u * 1024u);
+        EXPECT_GT(Sink::Largest(), 4096u);
+        EXPECT_LE(Sink::Largest(), 64u * 1024u);
+
+        // And once there is nothing left to transfer, they are back to where they started.
+        Core::ProxyType<Sink> sink(server.Client(1));
+        ASSERT_TRUE(sink.IsValid());
+
+        for (uint8_t retry = 0; (retry < 100) && ((source.SendBufferSize() != 1024) || (sink->ReceiveBufferSize() != 4096)); retry++) {
+            SleepMs(10);
+        }
+
+        EXPECT_EQ(source.SendBufferSize(), 1024u);
+        EXPECT_EQ(sink->ReceiveBufferSize(), 4096u);
+
+        sink.Release();
+        Sink::Adaptive(0);
+
+        source.Close(Core::infinite);
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SocketPort, AdaptiveBuffersAfterReopen)
+    {
+        const Core::NodeId node(_T("/tmp/wpesocketport3"));
+        Core::SocketServerType<Sink> server(node);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        Source source(node, 1024);
+        source.AdaptiveBuffers(32 * 1024, 0);
+        ASSERT_EQ(source.Open(Core::infinite), Core::ERROR_NONE);
+
+        Sink::Expect(~0);
+        source.Submit(string(16 * 1024 * 1024, 'c'), std::vector<string>());
+
+        for (uint16_t retry = 0; (retry < 1000) && (source.SendBufferSize() == 1024); retry++) {
+            SleepMs(1);
+        }
+
+        // Closed in the middle of the transfer, while the send buffer has grown.
+        EXPECT_GT(source.SendBufferSize(), 1024u);
+        source.Close(Core::infinite);
+
+        source.Submit(string(), std::vector<string>());
+        ASSERT_EQ(source.Open(Core::infinite), Core::ERROR_NONE);
+
+        // The new connection starts out with the buffer it was set up with, not the one the previous one grew to.
+        EXPECT_EQ(source.SendBufferSize(), 1024u);
+
+        source.Close(Core::infinite);
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(Core_SocketPort, DatagramsInBatches)
+    {
+        const Core::NodeId receiverNode(_T("127.0.0.1"), 12461, Core::NodeId::TYPE_IPV4);
+        const Core::NodeId senderNode(_T("127.0.0.1"), 12462, Core::NodeId::TYPE_IPV4);
+        constexpr uint32_t Count = 200;
+
+        Batched receiver(receiverNode, senderNode);
+        Batched sender(senderNode, receiverNode);
+
+        ASSERT_EQ(receiver.Open(Core::infinite), Core::ERROR_NONE);
+        ASSERT_EQ(sender.Open(Core::infinite), Core::ERROR_NONE);
+
+        sender.Submit(Count);
+
+        EXPECT_TRUE(receiver.Wait(Count));
+        EXPECT_EQ(receiver.Received(), Count);
+        EXPECT_TRUE(receiver.InOrder());
+        EXPECT_LE(receiver.Largest(), 16);
+        EXPECT_GE(receiver.Batches(), Count / 16);
+
+        sender.Close(Core::infinite);
+        receiver.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
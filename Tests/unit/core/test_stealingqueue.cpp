@@ -0,0 +1,340 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+#include <core/core.h>
+
+using namespace WPEFramework;
+using namespace WPEFramework::Core;
+
+TEST(test_stealingqueue, push_pop)
+{
+    StealingQueueType<int, 4> queue;
+    int result = 0;
+
+    EXPECT_TRUE(queue.IsEmpty());
+    EXPECT_FALSE(queue.Pop(result));
+
+    EXPECT_TRUE(queue.Push(1));
+    EXPECT_TRUE(queue.Push(2));
+    EXPECT_TRUE(queue.Push(3));
+    EXPECT_TRUE(queue.Push(4));
+    EXPECT_FALSE(queue.Push(5));
+    EXPECT_EQ(queue.Length(), 4u);
+
+    EXPECT_TRUE(queue.Pop(result));
+    EXPECT_EQ(result, 1);
+    EXPECT_TRUE(queue.Push(5));
+
+    EXPECT_TRUE(queue.HasEntry(3));
+    EXPECT_TRUE(queue.Revoke(3));
+    EXPECT_FALSE(queue.Revoke(3));
+    EXPECT_FALSE(queue.HasEntry(3));
+    EXPECT_EQ(queue.Length(), 3u);
+
+    EXPECT_TRUE(queue.Pop(result));
+    EXPECT_EQ(result, 2);
+    EXPECT_TRUE(queue.Pop(result));
+    EXPECT_EQ(result, 4);
+    EXPECT_TRUE(queue.Pop(result));
+    EXPECT_EQ(result, 5);
+    EXPECT_FALSE(queue.Pop(result));
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(test_stealingqueue, concurrent_steal)
+{
+    constexpr uint32_t entries = 100000;
+
+    StealingQueueType<uint32_t, 64> queue;
+    std::atomic<uint32_t> popped(0);
+    std::atomic<uint64_t> sum(0);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (uint8_t index = 0; index < 3; index++) {
+        thieves.emplace_back([&]() {
+            uint32_t value;
+            while ((done == false) || (queue.IsEmpty() == false)) {
+                if (queue.Pop(value) == true) {
+                    sum += value;
+                    popped++;
+                }
+            }
+        });
+    }
+
+    for (uint32_t value = 1; value <= entries; value++) {
+        while (queue.Push(value) == false) {
+            std::this_thread::yield();
+        }
+    }
+    done = true;
+
+    for (std::thread& thief : thieves) {
+        thief.join();
+    }
+
+    EXPECT_EQ(popped.load(), entries);
+    EXPECT_EQ(sum.load(), (static_cast<uint64_t>(entries) * (entries + 1)) / 2);
+}
+
+namespace {
+
+    class Dispatcher : public ThreadPool::IDispatcher {
+    public:
+        Dispatcher(const Dispatcher&) = delete;
+        Dispatcher& operator=(const Dispatcher&) = delete;
+
+        Dispatcher() = default;
+        ~Dispatcher() override = default;
+
+    private:
+        void Initialize() override
+        {
+        }
+        void Deinitialize() override
+        {
+        }
+        void Dispatch(IDispatch* job) override
+        {
+            job->Dispatch();
+        }
+    };
+
+    class Job : public IDispatch {
+    public:
+        Job() = delete;
+        Job(const Job&) = delete;
+        Job& operator=(const Job&) = delete;
+
+        Job(const std::function<void()>& action)
+            : _action(action)
+            , _done(false, true)
+        {
+        }
+        ~Job() override = default;
+
+    public:
+        bool Done(const uint32_t waitTime)
+        {
+            return (_done.Lock(waitTime) == ERROR_NONE);
+        }
+        void Dispatch() override
+        {
+            if (_action) {
+                _action();
+            }
+            _done.SetEvent();
+        }
+
+    private:
+        std::function<void()> _action;
+        Event _done;
+    };
+
+    ProxyType<Job> Create(const std::function<void()>& action = nullptr)
+    {
+        return (ProxyType<Job>::Create(action));
+    }
+
+    constexpr uint32_t MaxWait = 5000;
+}
+
+TEST(test_stealingqueue, threadpool_submit_from_worker)
+{
+    Dispatcher dispatcher;
+    ThreadPool pool(1, Thread::DefaultStackSize(), 8, &dispatcher, nullptr, nullptr, nullptr, ThreadPool::STEALING);
+    ProxyType<Job> children[4] = { Create(), Create(), Create(), Create() };
+    uint32_t pending = 0;
+
+    // With a single worker, what it submits waits on its own queue until it is done.
+    ProxyType<Job> parent = Create([&]() {
+        for (ProxyType<Job>& child : children) {
+            pool.Submit(ProxyType<IDispatch>(child), 0);
+        }
+        pending = pool.Pending();
+    });
+
+    pool.Run();
+    pool.Submit(ProxyType<IDispatch>(parent), infinite);
+
+    EXPECT_TRUE(parent->Done(MaxWait));
+    for (ProxyType<Job>& child : children) {
+        EXPECT_TRUE(child->Done(MaxWait));
+    }
+    EXPECT_EQ(pending, 4u);
+    EXPECT_EQ(pool.Pending(), 0u);
+
+    pool.Stop();
+}
+
+TEST(test_stealingqueue, threadpool_revoke_local)
+{
+    Dispatcher dispatcher;
+    ThreadPool pool(1, Thread::DefaultStackSize(), 8, &dispatcher, nullptr, nullptr, nullptr, ThreadPool::STEALING);
+    Event submitted(false, true);
+    Event gate(false, true);
+    ProxyType<Job> child = Create();
+
+    ProxyType<Job> parent = Create([&]() {
+        pool.Submit(ProxyType<IDispatch>(child), 0);
+        submitted.SetEvent();
+        gate.Lock(MaxWait);
+    });
+
+    pool.Run();
+    pool.Submit(ProxyType<IDispatch>(parent), infinite);
+
+    ASSERT_EQ(submitted.Lock(MaxWait), ERROR_NONE);
+
+    // The child is not in the shared queue, but on the local queue of the (busy) worker.
+    EXPECT_EQ(pool.Pending(), 1u);
+    EXPECT_EQ(pool.Revoke(ProxyType<IDispatch>(child), 0), ERROR_NONE);
+    EXPECT_EQ(pool.Pending(), 0u);
+    EXPECT_EQ(pool.Revoke(ProxyType<IDispatch>(child), 0), static_cast<uint32_t>(ERROR_UNKNOWN_KEY));
+
+    gate.SetEvent();
+
+    EXPECT_TRUE(parent->Done(MaxWait));
+    EXPECT_FALSE(child->Done(200));
+
+    pool.Stop();
+}
+
+TEST(test_stealingqueue, threadpool_snapshot)
+{
+    Dispatcher dispatcher;
+    ThreadPool pool(1, Thread::DefaultStackSize(), 8, &dispatcher, nullptr, nullptr, nullptr, ThreadPool::STEALING);
+    Event submitted(false, true);
+    Event gate(false, true);
+    ProxyType<Job> local[3] = { Create(), Create(), Create() };
+    ProxyType<Job> injected[2] = { Create(), Create() };
+
+    ProxyType<Job> parent = Create([&]() {
+        for (ProxyType<Job>& job : local) {
+            pool.Submit(ProxyType<IDispatch>(job), 0);
+        }
+        submitted.SetEvent();
+        gate.Lock(MaxWait);
+    });
+
+    pool.Run();
+    pool.Submit(ProxyType<IDispatch>(parent), infinite);
+
+    ASSERT_EQ(submitted.Lock(MaxWait), ERROR_NONE);
+
+    for (ProxyType<Job>& job : injected) {
+        pool.Submit(ProxyType<IDispatch>(job), infinite);
+    }
+
+    // Both the shared queue and the local queues are in the snapshot.
+    ThreadPool::Metadata entries[1];
+    std::vector<string> jobs;
+
+    pool.Snapshot(1, entries, jobs);
+
+    EXPECT_EQ(jobs.size(), 5u);
+    EXPECT_EQ(pool.Pending(), 5u);
+    EXPECT_TRUE(entries[0].Job.IsSet());
+    EXPECT_EQ(entries[0].Runs, 1u);
+
+    gate.SetEvent();
+
+    EXPECT_TRUE(parent->Done(MaxWait));
+    for (ProxyType<Job>& job : local) {
+        EXPECT_TRUE(job->Done(MaxWait));
+    }
+    for (ProxyType<Job>& job : injected) {
+        EXPECT_TRUE(job->Done(MaxWait));
+    }
+
+    pool.Snapshot(1, entries, jobs);
+
+    EXPECT_EQ(entries[0].Runs, 6u);
+
+    pool.Stop();
+}
+
+TEST(test_stealingqueue, threadpool_idle_wakeup)
+{
+    Dispatcher dispatcher;
+    ThreadPool pool(2, Thread::DefaultStackSize(), 8, &dispatcher, nullptr, nullptr, nullptr, ThreadPool::STEALING);
+    ProxyType<Job> child = Create();
+    bool stolen = false;
+
+    // The parent only finishes once its child ran, so a parked worker must wake up and steal it.
+    ProxyType<Job> parent = Create([&]() {
+        pool.Submit(ProxyType<IDispatch>(child), 0);
+        stolen = child->Done(MaxWait);
+    });
+
+    pool.Run();
+
+    // Give both workers the time to park.
+    SleepMs(100);
+
+    ProxyType<Job> first = Create();
+    pool.Submit(ProxyType<IDispatch>(first), infinite);
+    EXPECT_TRUE(first->Done(MaxWait));
+
+    SleepMs(100);
+
+    pool.Submit(ProxyType<IDispatch>(parent), infinite);
+
+    EXPECT_TRUE(parent->Done(MaxWait));
+    EXPECT_TRUE(stolen);
+
+    pool.Stop();
+}
+
+TEST(test_stealingqueue, workerpool_submit_from_job)
+{
+    Dispatcher dispatcher;
+    WorkerPool pool(2, Thread::DefaultStackSize(), 8, &dispatcher, nullptr, ThreadPool::STEALING);
+    ProxyType<Job> children[8] = { Create(), Create(), Create(), Create(), Create(), Create(), Create(), Create() };
+
+    ProxyType<Job> parent = Create([&]() {
+        for (ProxyType<Job>& child : children) {
+            pool.Submit(ProxyType<IDispatch>(child));
+        }
+    });
+
+    pool.Run();
+    pool.Submit(ProxyType<IDispatch>(parent));
+
+    EXPECT_TRUE(parent->Done(MaxWait));
+    for (ProxyType<Job>& child : children) {
+        EXPECT_TRUE(child->Done(MaxWait));
+    }
+
+    // The first two slots are the timer and the joined thread.
+    const IWorkerPool::Metadata& snapshot = pool.Snapshot();
+    uint32_t runs = 0;
+    for (uint8_t index = 2; index < snapshot.Slots; index++) {
+        runs += snapshot.Slot[index].Runs;
+    }
+
+    EXPECT_EQ(runs, 9u);
+    EXPECT_TRUE(snapshot.Pending.empty());
+
+    pool.Stop();
+}
@@ -59,6 +59,11 @@ namespace Tests {
         {
             return _timerDone;
         }
+        static void Reset()
+        {
+            std::unique_lock<std::mutex> lk(_mutex);
+            _timerDone = 0;
+        }
 
     private:
         static int _timerDone;
@@ -72,6 +77,85 @@ namespace Tests {
     std::mutex TimeHandler::_mutex;
     std::condition_variable TimeHandler::_cv;
 
+    class CountingHandler {
+    public:
+        CountingHandler()
+            : _id(~0)
+        {
+        }
+        CountingHandler(const uint32_t id)
+            : _id(id)
+        {
+        }
+        CountingHandler(const CountingHandler&) = default;
+        CountingHandler& operator=(const CountingHandler&) = default;
+        ~CountingHandler() = default;
+
+    public:
+        bool operator==(const CountingHandler& RHS) const
+        {
+            return (_id == RHS._id);
+        }
+        bool operator!=(const CountingHandler& RHS) const
+        {
+            return (!operator==(RHS));
+        }
+        size_t Hash() const
+        {
+            return (_id);
+        }
+        uint64_t Timed(const uint64_t scheduledTime)
+        {
+            uint64_t reschedule = 0;
+
+            // Not under our lock, the action might wait for the timer, which might be revoking us.
+            if (_action) {
+                reschedule = _action(_id);
+            }
+
+            std::unique_lock<std::mutex> lk(_mutex);
+            if (Core::Time::Now().Ticks() < scheduledTime) {
+                _early++;
+            }
+            _fired++;
+            _order.push_back(_id);
+            _cv.notify_one();
+            return reschedule;
+        }
+
+        static void Reset()
+        {
+            std::unique_lock<std::mutex> lk(_mutex);
+            _fired = 0;
+            _early = 0;
+            _order.clear();
+            _action = nullptr;
+        }
+        static bool WaitFor(const uint32_t fired)
+        {
+            std::unique_lock<std::mutex> lk(_mutex);
+            return (_cv.wait_for(lk, std::chrono::seconds(5), [fired]() { return (_fired >= fired); }));
+        }
+
+    private:
+        uint32_t _id;
+
+    public:
+        static uint32_t _fired;
+        static uint32_t _early;
+        static std::vector<uint32_t> _order;
+        static std::function<uint64_t(const uint32_t)> _action;
+        static std::mutex _mutex;
+        static std::condition_variable _cv;
+    };
+
+    uint32_t CountingHandler::_fired = 0;
+    uint32_t CountingHandler::_early = 0;
+    std::vector<uint32_t> CountingHandler::_order;
+    std::function<uint64_t(const uint32_t)> CountingHandler::_action;
+    std::mutex CountingHandler::_mutex;
+    std::condition_variable CountingHandler::_cv;
+
     class WatchDogHandler : Core::WatchDogType<WatchDogHandler&> {
     private:
         typedef Core::WatchDogType<WatchDogHandler&> BaseClass;
@@ -124,6 +208,8 @@ namespace Tests {
 
     TEST(Core_Timer, QueuedTimer)
     {
+        TimeHandler::Reset();
+
         Core::TimerType<TimeHandler> timer(Core::Thread::DefaultStackSize(), _T("QueuedTimer"));
         uint32_t time = 100;
 
@@ -137,13 +223,16 @@ namespace Tests {
         nextTick.Add(3 * time);
         timer.Schedule(nextTick.Ticks(), TimeHandler());
         std::unique_lock<std::mutex> lk(TimeHandler::_mutex);
-        while (!(TimeHandler::GetCount() == 5)) {
+        // The first one to fire reschedules itself once.
+        while (!(TimeHandler::GetCount() == 4)) {
             TimeHandler::_cv.wait(lk);
         }
     }
 
     TEST(Core_Timer, PastTime)
     {
+        TimeHandler::Reset();
+
         Core::TimerType<TimeHandler> timer(Core::Thread::DefaultStackSize(), _T("PastTime"));
         uint32_t time = 100; // 0.1 second
 
@@ -151,11 +240,161 @@ namespace Tests {
         pastTime.Sub(time);
         timer.Schedule(pastTime.Ticks(), TimeHandler());
         std::unique_lock<std::mutex> lk(TimeHandler::_mutex);
-        while (!(TimeHandler::GetCount() == 6)) {
+        while (!(TimeHandler::GetCount() == 2)) {
             TimeHandler::_cv.wait(lk);
         }
     }
 
+    TEST(Core_Timer, ManyTimersRevoked)
+    {
+        CountingHandler::Reset();
+
+        Core::TimerType<CountingHandler> timer(Core::Thread::DefaultStackSize(), _T("ManyTimers"));
+        const uint32_t count = 600;
+        const uint64_t start = Core::Time::Now().Ticks();
+        uint32_t expected = 0;
+
+        // Spread beyond the first level of the wheel, these timers need to be cascaded.
+        for (uint32_t index = 0; index < count; index++) {
+            timer.Schedule(start + ((index + 1) * Core::Time::TicksPerMillisecond), CountingHandler(index));
+        }
+
+        EXPECT_EQ(timer.Pending(), count);
+
+        for (uint32_t index = 0; index < count; index++) {
+            if ((index % 3) == 0) {
+                if (timer.Revoke(CountingHandler(index)) == true) {
+                    EXPECT_FALSE(timer.HasEntry(CountingHandler(index)));
+                    continue;
+                }
+            }
+            expected++;
+        }
+
+        std::unique_lock<std::mutex> lk(CountingHandler::_mutex);
+        while (CountingHandler::_fired != expected) {
+            CountingHandler::_cv.wait(lk);
+        }
+        lk.unlock();
+
+        EXPECT_EQ(CountingHandler::_early, 0u);
+        EXPECT_EQ(timer.Pending(), 0u);
+    }
+
+    TEST(Core_Timer, CascadeAcrossLevels)
+    {
+        CountingHandler::Reset();
+
+        Core::TimerType<CountingHandler> timer(Core::Thread::DefaultStackSize(), _T("Cascade"));
+        const uint64_t start = Core::Time::Now().Ticks();
+        const uint64_t second = 1000 * Core::Time::TicksPerMillisecond;
+
+        // Out of order, on the lowest level and spread over several slots of the level above it.
+        const uint32_t delays[] = { 800, 5, 1100, 250, 520, 300 };
+        for (const uint32_t delay : delays) {
+            timer.Schedule(start + (delay * Core::Time::TicksPerMillisecond), CountingHandler(delay));
+        }
+
+        // Beyond the first two levels (> 65s), the third level (> 4.6h) and the highest one (> 49 days).
+        timer.Schedule(start + (70 * second), CountingHandler(1));
+        timer.Schedule(start + (20 * 3600 * second), CountingHandler(2));
+        timer.Schedule(start + (60 * 24 * 3600 * second), CountingHandler(3));
+
+        EXPECT_EQ(timer.Pending(), 9u);
+        EXPECT_TRUE(CountingHandler::WaitFor(6));
+
+        {
+            std::unique_lock<std::mutex> lk(CountingHandler::_mutex);
+            const std::vector<uint32_t> expected = { 5, 250, 300, 520, 800, 1100 };
+            EXPECT_EQ(CountingHandler::_order, expected);
+            EXPECT_EQ(CountingHandler::_early, 0u);
+        }
+
+        // The far ones wait for a higher level to turn over, they are not due, but can be found.
+        EXPECT_EQ(timer.Pending(), 3u);
+        EXPECT_GT(timer.NextTrigger(), start + second);
+        EXPECT_LE(timer.NextTrigger(), start + (70 * second));
+
+        for (uint32_t id = 1; id <= 3; id++) {
+            EXPECT_TRUE(timer.HasEntry(CountingHandler(id)));
+            EXPECT_TRUE(timer.Revoke(CountingHandler(id)));
+            EXPECT_FALSE(timer.HasEntry(CountingHandler(id)));
+        }
+
+        EXPECT_EQ(timer.Pending(), 0u);
+        EXPECT_EQ(CountingHandler::_fired, 6u);
+    }
+
+    TEST(Core_Timer, RevokeWhileFiring)
+    {
+        CountingHandler::Reset();
+
+        Core::TimerType<CountingHandler> timer(Core::Thread::DefaultStackSize(), _T("RevokeFiring"));
+        Core::Event entered(false, true);
+
+        // Keeps on rescheduling itself, and takes its time doing so.
+        CountingHandler::_action = [&entered](const uint32_t) -> uint64_t {
+            entered.SetEvent();
+            SleepMs(100);
+            return (Core::Time::Now().Add(10).Ticks());
+        };
+
+        timer.Schedule(Core::Time::Now().Add(10).Ticks(), CountingHandler(1));
+
+        EXPECT_EQ(entered.Lock(5000), Core::ERROR_NONE);
+
+        // Waits for the running one, which may no longer reschedule.
+        timer.Revoke(CountingHandler(1));
+
+        EXPECT_EQ(CountingHandler::_fired, 1u);
+        EXPECT_FALSE(timer.HasEntry(CountingHandler(1)));
+        EXPECT_EQ(timer.Pending(), 0u);
+
+        SleepMs(100);
+        EXPECT_EQ(CountingHandler::_fired, 1u);
+    }
+
+    TEST(Core_Timer, RescheduleFromCallback)
+    {
+        CountingHandler::Reset();
+
+        Core::TimerType<CountingHandler> timer(Core::Thread::DefaultStackSize(), _T("Reschedule"));
+        uint32_t runs = 0;
+
+        // The first one reschedules itself through its result, and schedules a second one next to it.
+        // On its third run it revokes itself, its result is then ignored.
+        CountingHandler::_action = [&timer, &runs](const uint32_t id) -> uint64_t {
+            uint64_t result = 0;
+
+            if (id == 1) {
+                runs++;
+                timer.Schedule(Core::Time::Now().Add(5).Ticks(), CountingHandler(100 + runs));
+
+                if (runs == 3) {
+                    EXPECT_FALSE(timer.Revoke(CountingHandler(1)));
+                }
+                result = Core::Time::Now().Add(20).Ticks();
+            }
+            return (result);
+        };
+
+        timer.Schedule(Core::Time::Now().Add(10).Ticks(), CountingHandler(1));
+
+        EXPECT_TRUE(CountingHandler::WaitFor(6));
+
+        SleepMs(100);
+
+        std::unique_lock<std::mutex> lk(CountingHandler::_mutex);
+        EXPECT_EQ(runs, 3u);
+        EXPECT_EQ(CountingHandler::_fired, 6u);
+        EXPECT_EQ(CountingHandler::_early, 0u);
+        EXPECT_EQ(std::count(CountingHandler::_order.begin(), CountingHandler::_order.end(), 1u), 3);
+        EXPECT_EQ(std::count(CountingHandler::_order.begin(), CountingHandler::_order.end(), 103u), 1);
+        lk.unlock();
+
+        EXPECT_EQ(timer.Pending(), 0u);
+    }
+
     TEST(Core_Timer, WatchDogType)
     {
         WatchDogHandler timer;
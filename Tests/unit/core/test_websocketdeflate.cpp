@@ -0,0 +1,461 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        string Notifications(const uint32_t count)
+        {
+            string result;
+
+            for (uint32_t index = 0; index < count; index++) {
+                result += _T("{\"jsonrpc\":\"2.0\",\"method\":\"client.events.statechange\",\"params\":{\"callsign\":\"Plugin") + Core::NumberType<uint32_t>(index % 7).Text() + _T("\",\"state\":\"activated\",\"reason\":\"requested\"}}");
+            }
+
+            return (result + '\n');
+        }
+
+        // Sends what it got back, per line.
+        class EchoServer : public Web::WebSocketServerType<Core::SocketStream> {
+        private:
+            typedef Web::WebSocketServerType<Core::SocketStream> BaseClass;
+
+        public:
+            EchoServer() = delete;
+            EchoServer(const EchoServer&) = delete;
+            EchoServer& operator=(const EchoServer&) = delete;
+
+            EchoServer(const SOCKET& socket, const Core::NodeId& remoteNode, Core::SocketServerType<EchoServer>*)
+                : BaseClass(false, false, false, socket, remoteNode, 1024, 1024)
+                , _received()
+                , _sending()
+                , _offset(0)
+            {
+                Compression(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+            }
+            ~EchoServer() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            bool IsIdle() const override
+            {
+                return (true);
+            }
+            void StateChange() override
+            {
+            }
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
+            {
+                const uint32_t result = std::min(maxSendSize, static_cast<uint32_t>(_sending.size() - _offset));
+
+                ::memcpy(dataFrame, &(_sending[_offset]), result);
+                _offset += result;
+
+                if ((result < maxSendSize) && (_offset == _sending.size())) {
+                    _sending.clear();
+                    _offset = 0;
+                }
+
+                return (result);
+            }
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
+            {
+                _received.append(reinterpret_cast<const char*>(dataFrame), receivedSize);
+
+                if ((_received.empty() == false) && (_received.back() == '\n')) {
+                    _sending = _received;
+                    _offset = 0;
+                    _received.clear();
+                    Trigger();
+                }
+
+                return (receivedSize);
+            }
+
+        private:
+            string _received;
+            string _sending;
+            uint32_t _offset;
+        };
+
+        class Client : public Web::WebSocketClientType<Core::SocketStream> {
+        private:
+            typedef Web::WebSocketClientType<Core::SocketStream> BaseClass;
+
+        public:
+            Client() = delete;
+            Client(const Client&) = delete;
+            Client& operator=(const Client&) = delete;
+
+            Client(const Core::NodeId& remoteNode, const bool compression)
+                : BaseClass(_T("/"), _T("echo"), _T(""), _T(""), false, true, false, remoteNode.AnyInterface(), remoteNode, 1024, 1024)
+                , _adminLock()
+                , _received()
+                , _sending()
+                , _offset(0)
+                , _complete(false, true)
+            {
+                if (compression == true) {
+                    Compression(12, true, 64);
+                }
+            }
+            ~Client() override
+            {
+                Close(Core::infinite);
+            }
+
+        public:
+            bool Echo(const string& message, string& answer)
+            {
+                _adminLock.Lock();
+                _sending = message;
+                _offset = 0;
+                _received.clear();
+                _complete.ResetEvent();
+                _adminLock.Unlock();
+
+                Trigger();
+
+                const bool result = (_complete.Lock(10000) == Core::ERROR_NONE);
+
+                _adminLock.Lock();
+                answer = _received;
+                _adminLock.Unlock();
+
+                return (result);
+            }
+
+            bool IsIdle() const override
+            {
+                return (true);
+            }
+            void StateChange() override
+            {
+            }
+            uint32_t SendData(uint8_t* dataFrame, const uint32_t maxSendSize) override
+            {
+                _adminLock.Lock();
+
+                const uint32_t result = std::min(maxSendSize, static_cast<uint32_t>(_sending.size() - _offset));
+
+                ::memcpy(dataFrame, &(_sending[_offset]), result);
+                _offset += result;
+
+                if ((result < maxSendSize) && (_offset == _sending.size())) {
+                    _sending.clear();
+                    _offset = 0;
+                }
+
+                _adminLock.Unlock();
+
+                return (result);
+            }
+            uint32_t ReceiveData(uint8_t* dataFrame, const uint32_t receivedSize) override
+            {
+                _adminLock.Lock();
+
+                _received.append(reinterpret_cast<const char*>(dataFrame), receivedSize);
+
+                if ((_received.empty() == false) && (_received.back() == '\n')) {
+                    _complete.SetEvent();
+                }
+
+                _adminLock.Unlock();
+
+                return (receivedSize);
+            }
+
+        private:
+            Core::CriticalSection _adminLock;
+            string _received;
+            string _sending;
+            uint32_t _offset;
+            Core::Event _complete;
+        };
+
+        void Transfer(Web::WebSocket::Deflate& sender, Web::WebSocket::Deflate& receiver, const string& message, string& result)
+        {
+            uint8_t buffer[100];
+
+            sender.Input(reinterpret_cast<const uint8_t*>(message.data()), static_cast<uint16_t>(message.size()), true);
+
+            result.clear();
+
+            while (sender.IsPending() == true) {
+                const uint16_t length = sender.Output(buffer, sizeof(buffer));
+                const uint8_t* inflated;
+                uint16_t size;
+
+                receiver.Inflate(buffer, length, (sender.IsPending() == false));
+
+                while ((size = receiver.Inflated(inflated)) != 0) {
+                    result.append(reinterpret_cast<const char*>(inflated), size);
+                }
+            }
+        }
+
+    }
+
+    TEST(WebSocket_Deflate, Negotiation)
+    {
+        Web::WebSocket::Deflate server;
+        Web::WebSocket::Deflate client;
+        string answer;
+
+        // Not enabled, nothing to negotiate.
+        EXPECT_FALSE(server.Negotiate(_T("permessage-deflate"), answer));
+        EXPECT_FALSE(server.IsActive());
+
+        server.Enable(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+        client.Enable(12, false, 64);
+
+        EXPECT_EQ(client.Offer(), _T("permessage-deflate; client_max_window_bits; client_no_context_takeover"));
+
+        // The first offer that is usable is picked.
+        EXPECT_TRUE(server.Negotiate(_T("x-webkit-deflate-frame, permessage-deflate; server_max_window_bits=8, permessage-deflate; server_max_window_bits=10; client_max_window_bits"), answer));
+        EXPECT_EQ(answer, _T("permessage-deflate; server_max_window_bits=10"));
+        EXPECT_TRUE(server.IsActive());
+
+        EXPECT_TRUE(server.Negotiate(client.Offer(), answer));
+        EXPECT_EQ(answer, _T("permessage-deflate; client_no_context_takeover"));
+        EXPECT_TRUE(client.Accept(answer));
+        EXPECT_TRUE(client.IsActive());
+
+        EXPECT_TRUE(server.Negotiate(_T("permessage-deflate; server_no_context_takeover ; server_max_window_bits=\"15\""), answer));
+        EXPECT_EQ(answer, _T("permessage-deflate; server_no_context_takeover; server_max_window_bits=15"));
+
+        EXPECT_FALSE(server.Negotiate(_T("permessage-deflate; server_max_window_bits"), answer));
+        EXPECT_FALSE(server.Negotiate(_T("permessage-deflate; server_max_window_bits=16"), answer));
+        EXPECT_FALSE(server.Negotiate(_T("permessage-deflate; client_no_context_takeover; client_no_context_takeover"), answer));
+        EXPECT_FALSE(server.Negotiate(_T("permessage-deflate; unknown"), answer));
+        EXPECT_FALSE(server.IsActive());
+
+        EXPECT_TRUE(client.Accept(_T("permessage-deflate; client_max_window_bits=10; server_no_context_takeover")));
+        EXPECT_FALSE(client.Accept(_T("permessage-deflate; client_max_window_bits=8")));
+        EXPECT_FALSE(client.Accept(_T("permessage-deflate, permessage-deflate")));
+        EXPECT_FALSE(client.Accept(_T("x-webkit-deflate-frame")));
+        EXPECT_FALSE(client.IsActive());
+    }
+
+    TEST(WebSocket_Deflate, Messages)
+    {
+        Web::WebSocket::Deflate sender;
+        Web::WebSocket::Deflate receiver;
+        string answer;
+        string result;
+
+        sender.Enable(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+        receiver.Enable(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+
+        ASSERT_TRUE(sender.Negotiate(receiver.Offer(), answer));
+        ASSERT_TRUE(receiver.Accept(answer));
+
+        EXPECT_FALSE(sender.Compress(10, true));
+        EXPECT_TRUE(sender.Compress(10, false));
+        EXPECT_TRUE(sender.Compress(64, true));
+
+        const string message(Notifications(100));
+
+        Transfer(sender, receiver, message, result);
+        EXPECT_TRUE(result == message);
+
+        Web::WebSocket::Deflate::Metadata first;
+        sender.Snapshot(first);
+        EXPECT_EQ(first.Messages, 1u);
+        EXPECT_EQ(first.Plain, message.size());
+        EXPECT_LT(first.Deflated * 10, first.Plain);
+
+        // With the context of the first message, the second one is smaller.
+        Transfer(sender, receiver, message, result);
+        EXPECT_TRUE(result == message);
+
+        Web::WebSocket::Deflate::Metadata second;
+        sender.Snapshot(second);
+        EXPECT_EQ(second.Messages, 2u);
+        EXPECT_LT((second.Deflated - first.Deflated), first.Deflated);
+
+        receiver.Snapshot(second);
+        EXPECT_EQ(second.Inflated, 2 * message.size());
+    }
+
+    TEST(WebSocket_Deflate, Corrupted)
+    {
+        Web::WebSocket::Deflate sender;
+        Web::WebSocket::Deflate receiver;
+        string answer;
+        string result;
+
+        sender.Enable(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+        receiver.Enable(Web::WebSocket::Deflate::MaxWindowBits, true, 64);
+
+        ASSERT_TRUE(sender.Negotiate(receiver.Offer(), answer));
+        ASSERT_TRUE(receiver.Accept(answer));
+
+        // A block of the reserved type, zlib gives up on it.
+        const uint8_t garbage[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+        const uint8_t* inflated;
+
+        receiver.Inflate(garbage, sizeof(garbage), true);
+        while (receiver.Inflated(inflated) != 0) {
+        }
+
+        EXPECT_TRUE(receiver.IsFailed());
+        EXPECT_TRUE(receiver.IsActive());
+
+        // Nothing is inflated anymore, until it is negotiated again.
+        const string message(Notifications(10));
+
+        Transfer(sender, receiver, message, result);
+        EXPECT_TRUE(result.empty());
+
+        ASSERT_TRUE(sender.Negotiate(receiver.Offer(), answer));
+        ASSERT_TRUE(receiver.Accept(answer));
+        EXPECT_FALSE(receiver.IsFailed());
+
+        Transfer(sender, receiver, message, result);
+        EXPECT_TRUE(result == message);
+    }
+
+    TEST(WebSocket_Deflate, CompressedWithoutExtension)
+    {
+        const Core::NodeId node(_T("/tmp/wpewebsocketdeflate1"));
+        Core::SocketServerType<EchoServer> server(node);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        struct sockaddr_un address;
+        ::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        ::strncpy(address.sun_path, node.HostName().c_str(), sizeof(address.sun_path) - 1);
+
+        const int connection = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        ASSERT_EQ(::connect(connection, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+
+        const struct timeval timeout = { 5, 0 };
+        ::setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        // An upgrade without Sec-WebSocket-Extensions, so no compression.
+        const string request(_T("GET / HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                                "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\nSec-WebSocket-Protocol: echo\r\nSec-WebSocket-Version: 13\r\n\r\n"));
+        ASSERT_EQ(::send(connection, request.data(), request.size(), MSG_NOSIGNAL), static_cast<ssize_t>(request.size()));
+
+        string response;
+        char buffer[1024];
+        ssize_t size;
+
+        while ((response.find(_T("\r\n\r\n")) == string::npos) && ((size = ::recv(connection, buffer, sizeof(buffer), 0)) > 0)) {
+            response.append(buffer, size);
+        }
+        ASSERT_EQ(response.compare(0, 12, _T("HTTP/1.1 101")), 0);
+        EXPECT_EQ(response.find(_T("Sec-WebSocket-Extensions")), string::npos);
+
+        // A masked text frame, with the RSV1 bit.
+        const uint8_t frame[] = { 0xC1, 0x82, 0x00, 0x00, 0x00, 0x00, 'h', 'i' };
+        ASSERT_EQ(::send(connection, frame, sizeof(frame), MSG_NOSIGNAL), static_cast<ssize_t>(sizeof(frame)));
+
+        // The server fails the connection: a close frame, and then it is gone.
+        string answer(response.substr(response.find(_T("\r\n\r\n")) + 4));
+
+        while ((size = ::recv(connection, buffer, sizeof(buffer), 0)) > 0) {
+            answer.append(buffer, size);
+        }
+
+        EXPECT_EQ(size, 0);
+        ASSERT_EQ(answer.size(), 2u);
+        EXPECT_EQ(static_cast<uint8_t>(answer[0]), 0x88);
+
+        ::close(connection);
+
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+    TEST(WebSocket_Deflate, Link)
+    {
+        const Core::NodeId node(_T("/tmp/wpewebsocketdeflate0"));
+        Core::SocketServerType<EchoServer> server(node);
+        ASSERT_EQ(server.Open(Core::infinite), Core::ERROR_NONE);
+
+        {
+            Client client(node, true);
+            ASSERT_EQ(client.Open(Core::infinite), Core::ERROR_NONE);
+
+            // Larger than the buffers, so it takes several frames both ways.
+            const string message(Notifications(500));
+            string answer;
+
+            EXPECT_TRUE(client.Echo(message, answer));
+            EXPECT_EQ(answer.size(), message.size());
+            EXPECT_TRUE(answer == message);
+
+            Web::WebSocket::Deflate::Metadata metadata;
+            EXPECT_TRUE(client.Compression(metadata));
+            EXPECT_EQ(metadata.Messages, 1u);
+            EXPECT_EQ(metadata.Plain, message.size());
+            EXPECT_LT(metadata.Deflated * 10, metadata.Plain);
+            EXPECT_EQ(metadata.Inflated, message.size());
+
+            // Too small to compress.
+            const string small(_T("{\"id\":1}\n"));
+
+            EXPECT_TRUE(client.Echo(small, answer));
+            EXPECT_TRUE(answer == small);
+
+            EXPECT_TRUE(client.Compression(metadata));
+            EXPECT_EQ(metadata.Messages, 1u);
+            EXPECT_EQ(metadata.Plain, message.size());
+
+            client.Close(Core::infinite);
+        }
+        {
+            // A client that does not offer it, gets it plain.
+            Client client(node, false);
+            ASSERT_EQ(client.Open(Core::infinite), Core::ERROR_NONE);
+
+            const string message(Notifications(50));
+            string answer;
+
+            EXPECT_TRUE(client.Echo(message, answer));
+            EXPECT_TRUE(answer == message);
+
+            Web::WebSocket::Deflate::Metadata metadata;
+            EXPECT_FALSE(client.Compression(metadata));
+
+            client.Close(Core::infinite);
+        }
+
+        server.Close(Core::infinite);
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework
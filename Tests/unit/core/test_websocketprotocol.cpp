@@ -0,0 +1,157 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        string Payload(const uint32_t size)
+        {
+            string result(size, ' ');
+
+            for (uint32_t index = 0; index < size; index++) {
+                result[index] = static_cast<char>('a' + ((index * 7) % 26));
+            }
+
+            return (result);
+        }
+
+        // One complete frame with the given payload.
+        std::vector<uint8_t> Encode(Web::WebSocket::Protocol& encoder, const string& payload)
+        {
+            std::vector<uint8_t> frame(payload.size() + 32);
+
+            ::memcpy(&(frame[encoder.HeaderSpace(static_cast<uint32_t>(payload.size() + 1))]), payload.data(), payload.size());
+            frame.resize(encoder.Encoder(frame.data(), static_cast<uint32_t>(payload.size() + 1), static_cast<uint32_t>(payload.size())));
+
+            return (frame);
+        }
+
+        // Decodes the frame, handed over in pieces of the given size after the first one.
+        string Decode(Web::WebSocket::Protocol& decoder, std::vector<uint8_t>& frame, const uint32_t first, const uint32_t step)
+        {
+            string result;
+            uint32_t offset = 0;
+            uint32_t chunk = first;
+
+            while (offset < frame.size()) {
+                uint32_t size = static_cast<uint32_t>(std::min(static_cast<size_t>(chunk), frame.size() - offset));
+                const uint16_t header = decoder.Decoder(&(frame[offset]), size);
+
+                EXPECT_FALSE((header == 0) && (size == 0));
+
+                result.append(reinterpret_cast<const char*>(&(frame[offset + header])), size);
+                offset += (header + size);
+                chunk = step;
+            }
+
+            return (result);
+        }
+
+    }
+
+    TEST(WebSocket_Protocol, Masking)
+    {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+
+        EXPECT_EQ(client.HeaderSpace(0xFFFF), 8);
+        EXPECT_EQ(server.HeaderSpace(0xFFFF), 4);
+
+        for (const uint16_t size : { 1, 3, 15, 16, 17, 63, 64, 100, 125, 126, 127, 200, 1000, 4097, 60000 }) {
+            const string payload(Payload(size));
+
+            std::vector<uint8_t> frame(Encode(client, payload));
+
+            ASSERT_EQ(frame.size(), size + (size <= 125 ? 6u : 8u));
+            EXPECT_EQ(frame[0], 0x81);
+            EXPECT_EQ((frame[1] & 0x80), 0x80);
+
+            // Masked on the wire, in one piece and in pieces that end at any position in the key.
+            std::vector<uint8_t> copy(frame);
+            EXPECT_TRUE(Decode(server, copy, static_cast<uint32_t>(frame.size()), 0) == payload);
+
+            for (const uint16_t step : { 1, 3, 5, 13, 100 }) {
+                copy = frame;
+                EXPECT_TRUE(Decode(server, copy, 9, step) == payload);
+            }
+
+            // Not masked the other way around.
+            frame = Encode(server, payload);
+
+            ASSERT_EQ(frame.size(), size + (size <= 125 ? 2u : 4u));
+            EXPECT_EQ((frame[1] & 0x80), 0x00);
+            EXPECT_EQ(::memcmp(&(frame[frame.size() - size]), payload.data(), size), 0);
+            EXPECT_TRUE(Decode(client, frame, 5, 7) == payload);
+        }
+    }
+
+    TEST(WebSocket_Protocol, LargeFrames)
+    {
+        Web::WebSocket::Protocol client(false, true);
+        Web::WebSocket::Protocol server(false, false);
+
+        EXPECT_EQ(client.HeaderSpace(0x10000), 14);
+        EXPECT_EQ(server.HeaderSpace(0x10000), 10);
+
+        for (const uint32_t size : { 65535, 65536, 200000, 1048576 }) {
+            const string payload(Payload(size));
+
+            // One frame, with a 64 bits length once it does not fit in 16 bits.
+            std::vector<uint8_t> frame(Encode(client, payload));
+
+            ASSERT_EQ(frame.size(), size + (size <= 0xFFFF ? 8u : 14u));
+            EXPECT_EQ(frame[0], 0x81);
+            EXPECT_EQ((frame[1] & 0x7F), (size <= 0xFFFF ? 126 : 127));
+
+            if (size > 0xFFFF) {
+                EXPECT_EQ(frame[5], 0x00);
+                EXPECT_EQ(frame[6], static_cast<uint8_t>(size >> 24));
+                EXPECT_EQ(frame[7], static_cast<uint8_t>(size >> 16));
+                EXPECT_EQ(frame[8], static_cast<uint8_t>(size >> 8));
+                EXPECT_EQ(frame[9], static_cast<uint8_t>(size));
+            }
+
+            std::vector<uint8_t> copy(frame);
+            EXPECT_TRUE(Decode(server, copy, static_cast<uint32_t>(frame.size()), 0) == payload);
+            EXPECT_TRUE(server.IsCompleteMessage());
+
+            // Handed over in socket sized pieces, that do not line up with the key.
+            copy = frame;
+            EXPECT_TRUE(Decode(server, copy, 14, 65533) == payload);
+            EXPECT_TRUE(server.IsCompleteMessage());
+
+            frame = Encode(server, payload);
+
+            ASSERT_EQ(frame.size(), size + (size <= 0xFFFF ? 4u : 10u));
+            EXPECT_EQ(::memcmp(&(frame[frame.size() - size]), payload.data(), size), 0);
+            EXPECT_TRUE(Decode(client, frame, 10, 4096) == payload);
+        }
+    }
+
+} // Tests
+} // WPEFramework
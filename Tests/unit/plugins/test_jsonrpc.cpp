@@ -0,0 +1,285 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2023 Metrological
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../IPTestAdministrator.h"
+
+#include <gtest/gtest.h>
+
+#include <core/core.h>
+#include <plugins/plugins.h>
+
+namespace WPEFramework {
+namespace Tests {
+
+    namespace {
+
+        const string Designator(_T("client.events.12"));
+        const string Event(_T("statechange"));
+
+        class Factories : public PluginHost::IFactories {
+        public:
+            Factories(const Factories&) = delete;
+            Factories& operator=(const Factories&) = delete;
+
+            Factories()
+                : _requestFactory(1)
+                , _responseFactory(1)
+                , _fileBodyFactory(1)
+                , _jsonRPCFactory(2)
+            {
+                PluginHost::IFactories::Assign(this);
+            }
+            ~Factories() override
+            {
+                PluginHost::IFactories::Assign(nullptr);
+            }
+
+        public:
+            Core::ProxyType<Web::Request> Request() override
+            {
+                return (_requestFactory.Element());
+            }
+            Core::ProxyType<Web::Response> Response() override
+            {
+                return (_responseFactory.Element());
+            }
+            Core::ProxyType<Web::FileBody> FileBody() override
+            {
+                return (_fileBodyFactory.Element());
+            }
+            Core::ProxyType<Web::JSONRPC::Body> JSONRPC() override
+            {
+                return (_jsonRPCFactory.Element());
+            }
+
+        private:
+            Core::ProxyPoolType<Web::Request> _requestFactory;
+            Core::ProxyPoolType<Web::Response> _responseFactory;
+            Core::ProxyPoolType<Web::FileBody> _fileBodyFactory;
+            Core::ProxyPoolType<Web::JSONRPC::Body> _jsonRPCFactory;
+        };
+
+        // Only Submit is of interest, it keeps what the dispatcher sends, serialized in chunks of the given
+        // size, the way a channel does it.
+        class Shell : public PluginHost::IShell {
+        public:
+            Shell(const Shell&) = delete;
+            Shell& operator=(const Shell&) = delete;
+
+            Shell(const uint16_t chunk)
+                : _chunk(chunk)
+                , _submitted()
+            {
+            }
+            ~Shell() override = default;
+
+        public:
+            const std::vector<std::pair<uint32_t, string>>& Submitted() const
+            {
+                return (_submitted);
+            }
+            void Clear()
+            {
+                _submitted.clear();
+            }
+
+            uint32_t Submit(const uint32_t id, const Core::ProxyType<Core::JSON::IElement>& response) override
+            {
+                string text;
+                char buffer[1024];
+                uint32_t offset = 0;
+                uint16_t size;
+
+                do {
+                    size = response->Serialize(buffer, _chunk, offset);
+                    text.append(buffer, size);
+                } while ((offset != 0) && (size != 0));
+
+                _submitted.emplace_back(id, text);
+
+                return (Core::ERROR_NONE);
+            }
+
+            // Core::IUnknown iface:
+            void AddRef() const override
+            {
+            }
+            uint32_t Release() const override
+            {
+                return (Core::ERROR_NONE);
+            }
+            void* QueryInterface(const uint32_t) override
+            {
+                return (nullptr);
+            }
+
+            // PluginHost::IShell iface, not used:
+            void EnableWebServer(const string&, const string&) override {}
+            void DisableWebServer() override {}
+            string Model() const override { return (string()); }
+            bool Background() const override { return (false); }
+            string Accessor() const override { return (string()); }
+            string WebPrefix() const override { return (string()); }
+            string Locator() const override { return (string()); }
+            string ClassName() const override { return (string()); }
+            string Versions() const override { return (string()); }
+            string Callsign() const override { return (_T("Test")); }
+            string PersistentPath() const override { return (string()); }
+            string VolatilePath() const override { return (string()); }
+            string DataPath() const override { return (string()); }
+            string ProxyStubPath() const override { return (string()); }
+            string SystemPath() const override { return (string()); }
+            string PluginPath() const override { return (string()); }
+            string SystemRootPath() const override { return (string()); }
+            Core::hresult SystemRootPath(const string&) override { return (Core::ERROR_NONE); }
+            startup Startup() const override { return (startup::DEACTIVATED); }
+            Core::hresult Startup(const startup) override { return (Core::ERROR_NONE); }
+            string Substitute(const string& input) const override { return (input); }
+            bool Resumed() const override { return (false); }
+            Core::hresult Resumed(const bool) override { return (Core::ERROR_NONE); }
+            string HashKey() const override { return (string()); }
+            string ConfigLine() const override { return (string()); }
+            Core::hresult ConfigLine(const string&) override { return (Core::ERROR_NONE); }
+            Core::hresult Metadata(string&) const override { return (Core::ERROR_NONE); }
+            bool IsSupported(const uint8_t) const override { return (true); }
+            PluginHost::ISubSystem* SubSystems() override { return (nullptr); }
+            void Notify(const string&) override {}
+            void Register(PluginHost::IPlugin::INotification*) override {}
+            void Unregister(PluginHost::IPlugin::INotification*) override {}
+            state State() const override { return (state::ACTIVATED); }
+            void* QueryInterfaceByCallsign(const uint32_t, const string&) override { return (nullptr); }
+            Core::hresult Activate(const reason) override { return (Core::ERROR_NONE); }
+            Core::hresult Deactivate(const reason) override { return (Core::ERROR_NONE); }
+            Core::hresult Unavailable(const reason) override { return (Core::ERROR_NONE); }
+            Core::hresult Hibernate(const uint32_t) override { return (Core::ERROR_NONE); }
+            reason Reason() const override { return (reason::REQUESTED); }
+            ICOMLink* COMLink() override { return (nullptr); }
+
+        private:
+            const uint16_t _chunk;
+            std::vector<std::pair<uint32_t, string>> _submitted;
+        };
+
+        class Dispatcher : public PluginHost::JSONRPC {
+        public:
+            Dispatcher(const Dispatcher&) = delete;
+            Dispatcher& operator=(const Dispatcher&) = delete;
+
+            Dispatcher() = default;
+            ~Dispatcher() override = default;
+
+        public:
+            // Core::IUnknown iface:
+            void AddRef() const override
+            {
+            }
+            uint32_t Release() const override
+            {
+                return (Core::ERROR_NONE);
+            }
+            void* QueryInterface(const uint32_t) override
+            {
+                return (nullptr);
+            }
+        };
+
+        // What every subscriber got before the body was shared: a message of its own.
+        string Message(const string& designator, const string& parameters)
+        {
+            Core::JSONRPC::Message message;
+            string result;
+
+            if (!parameters.empty()) {
+                message.Parameters = parameters;
+            }
+
+            message.Designator = designator + '.' + Event;
+            message.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+
+            message.ToString(result);
+
+            return (result);
+        }
+    }
+
+    TEST(PluginHost_JSONRPC, NotifySplicesTheDesignator)
+    {
+        Factories factories;
+        Core::JSON::String text;
+        Core::JSON::VariantContainer object;
+        JsonArray array;
+
+        text = _T("activated");
+        object.FromString(_T("{\"callsign\":\"Controller\",\"state\":\"activated\",\"reason\":\"requested\"}"));
+        array.FromString(_T("[1,2,{\"three\":[4,5]},\"six\"]"));
+
+        // Chunks that end in the middle of the head, the designator and the tail.
+        for (const uint16_t chunk : { 1024, 1, 7 }) {
+            Shell shell(chunk);
+            Dispatcher dispatcher;
+
+            dispatcher.Activate(&shell);
+            EXPECT_EQ(dispatcher.Subscribe(1, Event, Designator), Core::ERROR_NONE);
+            // A designator that a JSON string escapes, gets a message of its own.
+            EXPECT_EQ(dispatcher.Subscribe(2, Event, _T("client/events")), Core::ERROR_NONE);
+
+            dispatcher.Notify(Event);
+            dispatcher.Notify(Event, text);
+            dispatcher.Notify(Event, object);
+            dispatcher.Notify(Event, array);
+
+            string expected[4];
+            text.ToString(expected[1]);
+            object.ToString(expected[2]);
+            array.ToString(expected[3]);
+
+            ASSERT_EQ(shell.Submitted().size(), 8u);
+
+            for (uint8_t index = 0; index < 4; index++) {
+                EXPECT_EQ(shell.Submitted()[index * 2].first, 1u);
+                EXPECT_EQ(shell.Submitted()[index * 2].second, Message(Designator, expected[index]));
+                EXPECT_EQ(shell.Submitted()[(index * 2) + 1].first, 2u);
+                EXPECT_EQ(shell.Submitted()[(index * 2) + 1].second, Message(_T("client/events"), expected[index]));
+            }
+
+            shell.Clear();
+
+            // A response goes out as it did, through the same shell.
+            dispatcher.Response(Core::JSONRPC::Context(3, 42, string()), object);
+
+            Core::JSONRPC::Message response;
+            string expectedResponse;
+            response.Id = 42;
+            response.Result = expected[2];
+            response.JSONRPC = Core::JSONRPC::Message::DefaultVersion;
+            response.ToString(expectedResponse);
+
+            ASSERT_EQ(shell.Submitted().size(), 1u);
+            EXPECT_EQ(shell.Submitted()[0].first, 3u);
+            EXPECT_EQ(shell.Submitted()[0].second, expectedResponse);
+
+            dispatcher.Deactivate();
+        }
+
+        Core::Singleton::Dispose();
+    }
+
+} // Tests
+} // WPEFramework